@@ -54,6 +54,7 @@
 #include "NetworkBufferManagement.h"
 #include "NetworkInterface.h"
 #include "FreeRTOS_Routing.h"
+#include "FreeRTOS_LRU_Hash.h"
 
 #if ( ipconfigUSE_IPv4 != 0 )
 
@@ -112,6 +113,14 @@
 /** @brief The ARP cache. */
     _static ARPCacheRow_t xARPCache[ ipconfigARP_CACHE_ENTRIES ];
 
+    #if ( ipconfigARP_HASH_BUCKETS > 0 )
+
+/** @brief The hash index on the IP-address, and the LRU list of the ARP cache. */
+        static LRUHashLink_t xARPHashHeads[ ipconfigARP_HASH_BUCKETS ];
+        static LRUHashLinks_t xARPHashLinks[ ipconfigARP_CACHE_ENTRIES ];
+        static LRUHashTable_t xARPHashTable = lruHASH_TABLE_INIT( xARPHashHeads, xARPHashLinks );
+    #endif /* ipconfigARP_HASH_BUCKETS > 0 */
+
 
 /*
  * IP-clash detection is currently only used internally. When DHCP doesn't respond, the
@@ -433,6 +442,20 @@
             vARPRefreshCacheEntry( &( pxARPHeader->xSenderHardwareAddress ), ulSenderProtocolAddress, pxTargetEndPoint );
         }
 
+        #if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+        {
+            IP_Address_t xAddress;
+
+            ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+            xAddress.ulIP_IPv4 = ulSenderProtocolAddress;
+
+            /* Process the packets that were waiting for this address. */
+            if( xPendingResolutionFlush( &( xAddress ), pdFALSE ) != pdFALSE )
+            {
+                iptrace_DELAYED_ARP_REQUEST_REPLIED();
+            }
+        }
+        #else /* if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 ) */
         if( ( pxARPWaitingNetworkBuffer != NULL ) &&
             ( uxIPHeaderSizePacket( pxARPWaitingNetworkBuffer ) == ipSIZE_OF_IPv4_HEADER ) )
         {
@@ -465,6 +488,124 @@
                 iptrace_DELAYED_ARP_REQUEST_REPLIED();
             }
         }
+        #endif /* if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 ) */
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the entry in the ARP cache that holds a given IP-address.
+ *
+ * @param[in] ulIPAddress The IP-address to look for.
+ *
+ * @return The entry number, or -1 when the IP-address is not in the cache.
+ */
+    static BaseType_t prvARPFindIPEntry( uint32_t ulIPAddress )
+    {
+        BaseType_t xEntry = -1;
+        BaseType_t x;
+
+        #if ( ipconfigARP_HASH_BUCKETS > 0 )
+            if( ulIPAddress != 0U )
+            {
+                for( x = xLRUHashFirst( &( xARPHashTable ), ulIPAddress );
+                     x >= 0;
+                     x = xLRUHashNext( &( xARPHashTable ), x ) )
+                {
+                    if( xARPCache[ x ].ulIPAddress == ulIPAddress )
+                    {
+                        xEntry = x;
+                        break;
+                    }
+                }
+            }
+            else
+        #endif /* if ( ipconfigARP_HASH_BUCKETS > 0 ) */
+        {
+            /* Free entries have IP-address zero and are not in the hash index.
+             * Looking up zero finds the first free entry, as it always did. */
+
+            /* Loop through each entry in the ARP cache. */
+            for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+            {
+                if( xARPCache[ x ].ulIPAddress == ulIPAddress )
+                {
+                    xEntry = x;
+                    break;
+                }
+            }
+        }
+
+        return xEntry;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Mark an entry in the ARP cache as the most recently used one.
+ *
+ * @param[in] xEntry The entry number.
+ */
+    static void prvARPTouchEntry( BaseType_t xEntry )
+    {
+        #if ( ipconfigARP_HASH_BUCKETS > 0 )
+        {
+            vLRUHashTouch( &( xARPHashTable ), xEntry );
+        }
+        #else
+        {
+            /* The oldest entry is found by its age. */
+            ( void ) xEntry;
+        }
+        #endif /* if ( ipconfigARP_HASH_BUCKETS > 0 ) */
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store an IP-address in an entry of the ARP cache, and keep the hash
+ *        index up-to-date.
+ *
+ * @param[in] xEntry The entry number.
+ * @param[in] ulIPAddress The new IP-address, or zero to release the entry.
+ */
+    static void prvARPSetIPAddress( BaseType_t xEntry,
+                                    uint32_t ulIPAddress )
+    {
+        #if ( ipconfigARP_HASH_BUCKETS > 0 )
+        {
+            if( xARPCache[ xEntry ].ulIPAddress != 0U )
+            {
+                vLRUHashRemove( &( xARPHashTable ), xARPCache[ xEntry ].ulIPAddress, xEntry );
+            }
+
+            xARPCache[ xEntry ].ulIPAddress = ulIPAddress;
+
+            if( ulIPAddress != 0U )
+            {
+                vLRUHashInsert( &( xARPHashTable ), ulIPAddress, xEntry );
+                vLRUHashTouch( &( xARPHashTable ), xEntry );
+            }
+            else
+            {
+                /* A released entry will be re-used first. */
+                vLRUHashRelease( &( xARPHashTable ), xEntry );
+            }
+        }
+        #else
+        {
+            xARPCache[ xEntry ].ulIPAddress = ulIPAddress;
+        }
+        #endif /* if ( ipconfigARP_HASH_BUCKETS > 0 ) */
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Clear an entry of the ARP cache.
+ *
+ * @param[in] xEntry The entry number.
+ */
+    static void prvARPClearEntry( BaseType_t xEntry )
+    {
+        prvARPSetIPAddress( xEntry, 0U );
+        ( void ) memset( &( xARPCache[ xEntry ] ), 0, sizeof( ARPCacheRow_t ) );
     }
 /*-----------------------------------------------------------*/
 
@@ -478,25 +619,20 @@
  */
     BaseType_t xIsIPInARPCache( uint32_t ulAddressToLookup )
     {
-        BaseType_t x, xReturn = pdFALSE;
+        BaseType_t xReturn = pdFALSE;
+        BaseType_t x = prvARPFindIPEntry( ulAddressToLookup );
 
-        /* Loop through each entry in the ARP cache. */
-        for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+        /* Does a row in the ARP cache table hold an entry for the IP address
+         * being queried? */
+        if( x >= 0 )
         {
-            /* Does this row in the ARP cache table hold an entry for the IP address
-             * being queried? */
-            if( xARPCache[ x ].ulIPAddress == ulAddressToLookup )
-            {
-                xReturn = pdTRUE;
-
-                /* A matching valid entry was found. */
-                if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
-                {
-                    /* This entry is waiting an ARP reply, so is not valid. */
-                    xReturn = pdFALSE;
-                }
+            xReturn = pdTRUE;
 
-                break;
+            /* A matching valid entry was found. */
+            if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+            {
+                /* This entry is waiting an ARP reply, so is not valid. */
+                xReturn = pdFALSE;
             }
         }
 
@@ -562,7 +698,7 @@
                 if( ( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
                 {
                     lResult = xARPCache[ x ].ulIPAddress;
-                    ( void ) memset( &xARPCache[ x ], 0, sizeof( xARPCache[ x ] ) );
+                    prvARPClearEntry( x );
                     break;
                 }
             }
@@ -587,20 +723,18 @@
 
         if( pxMACAddress != NULL )
         {
-            /* Loop through each entry in the ARP cache. */
-            for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+            /* Does a line in the cache table hold an entry for the IP
+             * address being queried? */
+            x = prvARPFindIPEntry( ulIPAddress );
+
+            if( x >= 0 )
             {
-                /* Does this line in the cache table hold an entry for the IP
-                 * address being queried? */
-                if( xARPCache[ x ].ulIPAddress == ulIPAddress )
+                /* Does this cache entry have the same MAC address? */
+                if( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 )
                 {
-                    /* Does this cache entry have the same MAC address? */
-                    if( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 )
-                    {
-                        /* The IP address and the MAC matched, update this entry age. */
-                        xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
-                        break;
-                    }
+                    /* The IP address and the MAC matched, update this entry age. */
+                    xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
+                    prvARPTouchEntry( x );
                 }
             }
         }
@@ -654,7 +788,7 @@
                         /* Both the MAC address as well as the IP address were found in
                          * different locations: clear the entry which matches the
                          * IP-address */
-                        ( void ) memset( &( xARPCache[ xLocation.xIpEntry ] ), 0, sizeof( ARPCacheRow_t ) );
+                        prvARPClearEntry( xLocation.xIpEntry );
                     }
                 }
                 else if( xLocation.xIpEntry >= 0 )
@@ -668,7 +802,7 @@
                 }
 
                 /* If the entry was not found, we use the oldest entry and set the IPaddress */
-                xARPCache[ xLocation.xUseEntry ].ulIPAddress = ulIPAddress;
+                prvARPSetIPAddress( xLocation.xUseEntry, ulIPAddress );
 
                 if( pxMACAddress != NULL )
                 {
@@ -702,6 +836,83 @@
  * @param[in] pxEndPoint The end-point that will stored in the table.
  * @param[out] pxLocation The results of this search are written in this struct.
  */
+    #if ( ipconfigARP_HASH_BUCKETS > 0 )
+        static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
+                                             const uint32_t ulIPAddress,
+                                             struct xNetworkEndPoint * pxEndPoint,
+                                             CacheLocation_t * pxLocation )
+        {
+            BaseType_t x;
+            BaseType_t xReturn = pdFALSE;
+
+            #if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 )
+                BaseType_t xAddressIsLocal = ( FreeRTOS_FindEndPointOnNetMask( ulIPAddress ) != NULL ) ? 1 : 0; /* ARP remote address. */
+            #endif
+
+            pxLocation->xIpEntry = prvARPFindIPEntry( ulIPAddress );
+            pxLocation->xMacEntry = -1;
+            pxLocation->xUseEntry = 0;
+
+            if( pxMACAddress == NULL )
+            {
+                /* In case the parameter pxMACAddress is NULL, an entry will be reserved to
+                 * indicate that there is an outstanding ARP request, This entry will have
+                 * "ucValid == pdFALSE". */
+            }
+            else if( ( pxLocation->xIpEntry >= 0 ) &&
+                     ( memcmp( xARPCache[ pxLocation->xIpEntry ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
+            {
+                /* This function will be called for each received packet
+                 * This is by far the most common path. */
+                x = pxLocation->xIpEntry;
+                xARPCache[ x ].ucAge = ( uint8_t ) ipconfigMAX_ARP_AGE;
+                xARPCache[ x ].ucValid = ( uint8_t ) pdTRUE;
+                xARPCache[ x ].pxEndPoint = pxEndPoint;
+                prvARPTouchEntry( x );
+                /* Indicate to the caller that the entry is updated. */
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                /* A new IP-MAC couple.  See if the MAC-address is stored with
+                 * another IP-address.  This search is only done when the
+                 * contents of the cache change. */
+                for( x = 0; x < ( BaseType_t ) xARPHashTable.uxEntriesUsed; x++ )
+                {
+                    if( ( x != pxLocation->xIpEntry ) &&
+                        ( memcmp( xARPCache[ x ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( pxMACAddress->ucBytes ) ) == 0 ) )
+                    {
+                        #if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 )
+                        {
+                            /* If ARP stores the MAC address of IP addresses outside the
+                             * network, than the MAC address of the gateway should not be
+                             * overwritten. */
+                            BaseType_t xOtherIsLocal = ( FreeRTOS_FindEndPointOnNetMask( xARPCache[ x ].ulIPAddress ) != NULL ) ? 1 : 0; /* ARP remote address. */
+
+                            if( xAddressIsLocal == xOtherIsLocal )
+                            {
+                                pxLocation->xMacEntry = x;
+                            }
+                        }
+                        #else /* if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 ) */
+                        {
+                            pxLocation->xMacEntry = x;
+                        }
+                        #endif /* if ( ipconfigARP_STORES_REMOTE_ADDRESSES != 0 ) */
+                    }
+                }
+            }
+
+            if( ( xReturn == pdFALSE ) && ( pxLocation->xIpEntry < 0 ) && ( pxLocation->xMacEntry < 0 ) )
+            {
+                /* The IP-address will be stored in a new or in the least recently
+                 * used entry. */
+                pxLocation->xUseEntry = xLRUHashTake( &( xARPHashTable ) );
+            }
+
+            return xReturn;
+        }
+    #else /* if ( ipconfigARP_HASH_BUCKETS > 0 ) */
     static BaseType_t prvFindCacheEntry( const MACAddress_t * pxMACAddress,
                                          const uint32_t ulIPAddress,
                                          struct xNetworkEndPoint * pxEndPoint,
@@ -811,6 +1022,7 @@
 
         return xReturn;
     }
+    #endif /* if ( ipconfigARP_HASH_BUCKETS > 0 ) */
 /*-----------------------------------------------------------*/
 
     #if ( ipconfigUSE_ARP_REVERSED_LOOKUP == 1 )
@@ -985,16 +1197,28 @@
             {
                 /* The IP address is off the local network, so look up the
                  * hardware address of the router, if any. */
-                *( ppxEndPoint ) = FreeRTOS_FindGateWay( ( BaseType_t ) ipTYPE_IPv4 );
+                *( ppxEndPoint ) = NULL;
 
-                if( *( ppxEndPoint ) != NULL )
+                #if ( ipconfigIS_ENABLED( ipconfigUSE_ROUTE_TABLE ) )
                 {
-                    /* 'ipv4_settings' can be accessed safely, because 'ipTYPE_IPv4' was provided. */
-                    ulAddressToLookup = ( *ppxEndPoint )->ipv4_settings.ulGatewayAddress;
+                    /* A static route takes precedence over the default gateway. */
+                    *( ppxEndPoint ) = FreeRTOS_FindRoute_IPv4( ulOriginal, &( ulAddressToLookup ) );
                 }
-                else
+                #endif
+
+                if( *( ppxEndPoint ) == NULL )
                 {
-                    ulAddressToLookup = 0U;
+                    *( ppxEndPoint ) = FreeRTOS_FindGateWay( ( BaseType_t ) ipTYPE_IPv4 );
+
+                    if( *( ppxEndPoint ) != NULL )
+                    {
+                        /* 'ipv4_settings' can be accessed safely, because 'ipTYPE_IPv4' was provided. */
+                        ulAddressToLookup = ( *ppxEndPoint )->ipv4_settings.ulGatewayAddress;
+                    }
+                    else
+                    {
+                        ulAddressToLookup = 0U;
+                    }
                 }
             }
         }
@@ -1054,32 +1278,27 @@
                                                      MACAddress_t * const pxMACAddress,
                                                      NetworkEndPoint_t ** ppxEndPoint )
     {
-        BaseType_t x;
         eResolutionLookupResult_t eReturn = eResolutionCacheMiss;
+        BaseType_t x = prvARPFindIPEntry( ulAddressToLookup );
 
-        /* Loop through each entry in the ARP cache. */
-        for( x = 0; x < ipconfigARP_CACHE_ENTRIES; x++ )
+        /* Does a row in the ARP cache table hold an entry for the IP address
+         * being queried? */
+        if( x >= 0 )
         {
-            /* Does this row in the ARP cache table hold an entry for the IP address
-             * being queried? */
-            if( xARPCache[ x ].ulIPAddress == ulAddressToLookup )
+            /* A matching valid entry was found. */
+            if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
             {
-                /* A matching valid entry was found. */
-                if( xARPCache[ x ].ucValid == ( uint8_t ) pdFALSE )
-                {
-                    /* This entry is waiting an ARP reply, so is not valid. */
-                    eReturn = eResolutionFailed;
-                }
-                else
-                {
-                    /* A valid entry was found. */
-                    ( void ) memcpy( pxMACAddress->ucBytes, xARPCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
-                    /* ppxEndPoint != NULL was tested in the only caller eARPGetCacheEntry(). */
-                    *( ppxEndPoint ) = xARPCache[ x ].pxEndPoint;
-                    eReturn = eResolutionCacheHit;
-                }
-
-                break;
+                /* This entry is waiting an ARP reply, so is not valid. */
+                eReturn = eResolutionFailed;
+            }
+            else
+            {
+                /* A valid entry was found. */
+                ( void ) memcpy( pxMACAddress->ucBytes, xARPCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                /* ppxEndPoint != NULL was tested in the only caller eARPGetCacheEntry(). */
+                *( ppxEndPoint ) = xARPCache[ x ].pxEndPoint;
+                prvARPTouchEntry( x );
+                eReturn = eResolutionCacheHit;
             }
         }
 
@@ -1132,7 +1351,7 @@
                 {
                     /* The entry is no longer valid.  Wipe it out. */
                     iptraceARP_TABLE_ENTRY_EXPIRED( xARPCache[ x ].ulIPAddress );
-                    xARPCache[ x ].ulIPAddress = 0U;
+                    prvARPSetIPAddress( x, 0U );
                 }
             }
         }
@@ -1430,13 +1649,20 @@
             {
                 if( xARPCache[ x ].pxEndPoint == pxEndPoint )
                 {
-                    ( void ) memset( &( xARPCache[ x ] ), 0, sizeof( ARPCacheRow_t ) );
+                    prvARPClearEntry( x );
                 }
             }
         }
         else
         {
             ( void ) memset( xARPCache, 0, sizeof( xARPCache ) );
+
+            #if ( ipconfigARP_HASH_BUCKETS > 0 )
+            {
+                /* Also clear the hash index and the LRU list. */
+                vLRUHashClear( &( xARPHashTable ) );
+            }
+            #endif
         }
     }
 /*-----------------------------------------------------------*/
@@ -135,6 +135,8 @@
     static void vHandleWaitingAcknowledge( NetworkEndPoint_t * pxEndPoint,
                                            BaseType_t xDoCheck );
 
+    static void prvHandleLeaseAcknowledged( NetworkEndPoint_t * pxEndPoint );
+
     static BaseType_t xHandleWaitingFirstDiscover( NetworkEndPoint_t * pxEndPoint );
 
     static void prvHandleWaitingeLeasedAddress( NetworkEndPoint_t * pxEndPoint );
@@ -350,47 +352,58 @@
         {
             if( prvProcessDHCPReplies( dhcpMESSAGE_TYPE_OFFER, pxEndPoint ) == pdPASS )
             {
-                #if ( ipconfigUSE_DHCP_HOOK != 0 )
-                    /* Ask the user if a DHCP request is required. */
-                    #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
-                        eAnswer = xApplicationDHCPHook( eDHCPPhasePreRequest, EP_DHCPData.ulOfferedIPAddress );
-                    #else /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
-                        xIPAddress.ulIP_IPv4 = EP_DHCPData.ulOfferedIPAddress;
-                        eAnswer = xApplicationDHCPHook_Multi( eDHCPPhasePreRequest, pxEndPoint, &xIPAddress );
-                    #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
-
-                    if( eAnswer == eDHCPContinue )
-                #endif /* ipconfigUSE_DHCP_HOOK */
-                {
-                    /* An offer has been made, the user wants to continue,
-                     * generate the request. */
-                    if( prvSendDHCPRequest( pxEndPoint ) == pdPASS )
+                #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_RAPID_COMMIT ) )
+                    if( EP_DHCPData.xRapidCommitAck != pdFALSE )
                     {
-                        EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
-                        EP_DHCPData.xDHCPTxPeriod = dhcpINITIAL_DHCP_TX_PERIOD;
-                        EP_DHCPData.eDHCPState = eWaitingAcknowledge;
+                        /* The server answered the DISCOVER with an ACK, the
+                         * address is leased without a REQUEST. */
+                        prvHandleLeaseAcknowledged( pxEndPoint );
                     }
                     else
+                #endif /* ipconfigDHCP_USE_RAPID_COMMIT */
+                {
+                    #if ( ipconfigUSE_DHCP_HOOK != 0 )
+                        /* Ask the user if a DHCP request is required. */
+                        #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
+                            eAnswer = xApplicationDHCPHook( eDHCPPhasePreRequest, EP_DHCPData.ulOfferedIPAddress );
+                        #else /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+                            xIPAddress.ulIP_IPv4 = EP_DHCPData.ulOfferedIPAddress;
+                            eAnswer = xApplicationDHCPHook_Multi( eDHCPPhasePreRequest, pxEndPoint, &xIPAddress );
+                        #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+
+                        if( eAnswer == eDHCPContinue )
+                    #endif /* ipconfigUSE_DHCP_HOOK */
                     {
-                        /* Either the creation of a message buffer failed, or sendto().
-                         * Try again in the next cycle. */
-                        FreeRTOS_debug_printf( ( "Send failed during eWaitingOffer/1.\n" ) );
-                        EP_DHCPData.eDHCPState = eSendDHCPRequest;
+                        /* An offer has been made, the user wants to continue,
+                         * generate the request. */
+                        if( prvSendDHCPRequest( pxEndPoint ) == pdPASS )
+                        {
+                            EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
+                            EP_DHCPData.xDHCPTxPeriod = dhcpINITIAL_DHCP_TX_PERIOD;
+                            EP_DHCPData.eDHCPState = eWaitingAcknowledge;
+                        }
+                        else
+                        {
+                            /* Either the creation of a message buffer failed, or sendto().
+                             * Try again in the next cycle. */
+                            FreeRTOS_debug_printf( ( "Send failed during eWaitingOffer/1.\n" ) );
+                            EP_DHCPData.eDHCPState = eSendDHCPRequest;
+                        }
                     }
-                }
 
-                #if ( ipconfigUSE_DHCP_HOOK != 0 )
-                    else
-                    {
-                        if( eAnswer == eDHCPUseDefaults )
+                    #if ( ipconfigUSE_DHCP_HOOK != 0 )
+                        else
                         {
-                            ( void ) memcpy( &( pxEndPoint->ipv4_settings ), &( pxEndPoint->ipv4_defaults ), sizeof( pxEndPoint->ipv4_settings ) );
-                        }
+                            if( eAnswer == eDHCPUseDefaults )
+                            {
+                                ( void ) memcpy( &( pxEndPoint->ipv4_settings ), &( pxEndPoint->ipv4_defaults ), sizeof( pxEndPoint->ipv4_settings ) );
+                            }
 
-                        /* The user indicates that the DHCP process does not continue. */
-                        xGivingUp = pdTRUE;
-                    }
-                #endif /* ipconfigUSE_DHCP_HOOK */
+                            /* The user indicates that the DHCP process does not continue. */
+                            xGivingUp = pdTRUE;
+                        }
+                    #endif /* ipconfigUSE_DHCP_HOOK */
+                }
             }
         }
 
@@ -482,81 +495,134 @@
             /* Is it time to send another Discover? */
             if( ( xTaskGetTickCount() - EP_DHCPData.xDHCPTxTime ) > EP_DHCPData.xDHCPTxPeriod )
             {
-                /* Increase the time period, and if it has not got to the
-                 * point of giving up - send another request. */
-                EP_DHCPData.xDHCPTxPeriod <<= 1;
+                #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_INIT_REBOOT ) )
+                    if( EP_DHCPData.xInitReboot != pdFALSE )
+                    {
+                        /* The last leased address was not confirmed, fall
+                         * back to the normal DISCOVER process. */
+                        EP_DHCPData.xInitReboot = pdFALSE;
+                        EP_DHCPData.ulOfferedIPAddress = 0U;
+                        EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
+                        EP_DHCPData.xDHCPTxPeriod = dhcpINITIAL_DHCP_TX_PERIOD;
 
-                if( EP_DHCPData.xDHCPTxPeriod <= ( TickType_t ) ipconfigMAXIMUM_DISCOVER_TX_PERIOD )
+                        if( prvSendDHCPDiscover( pxEndPoint ) == pdPASS )
+                        {
+                            EP_DHCPData.eDHCPState = eWaitingOffer;
+                        }
+                        else
+                        {
+                            /* Try again in the next cycle. */
+                            EP_DHCPData.eDHCPState = eWaitingSendFirstDiscover;
+                        }
+                    }
+                    else
+                #endif /* ipconfigDHCP_USE_INIT_REBOOT */
                 {
-                    EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
+                    /* Increase the time period, and if it has not got to the
+                     * point of giving up - send another request. */
+                    EP_DHCPData.xDHCPTxPeriod <<= 1;
 
-                    if( prvSendDHCPRequest( pxEndPoint ) == pdPASS )
+                    if( EP_DHCPData.xDHCPTxPeriod <= ( TickType_t ) ipconfigMAXIMUM_DISCOVER_TX_PERIOD )
                     {
-                        /* The message is sent. Stay in state 'eWaitingAcknowledge'. */
+                        EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
+
+                        if( prvSendDHCPRequest( pxEndPoint ) == pdPASS )
+                        {
+                            /* The message is sent. Stay in state 'eWaitingAcknowledge'. */
+                        }
+                        else
+                        {
+                            /* Either the creation of a message buffer failed, or sendto().
+                             * Try again in the next cycle. */
+                            FreeRTOS_debug_printf( ( "Send failed during eWaitingAcknowledge.\n" ) );
+                            EP_DHCPData.eDHCPState = eSendDHCPRequest;
+                        }
                     }
                     else
                     {
-                        /* Either the creation of a message buffer failed, or sendto().
-                         * Try again in the next cycle. */
-                        FreeRTOS_debug_printf( ( "Send failed during eWaitingAcknowledge.\n" ) );
-                        EP_DHCPData.eDHCPState = eSendDHCPRequest;
-                    }
-                }
-                else
-                {
-                    /* Give up, start again. */
-                    EP_DHCPData.eDHCPState = eInitialWait;
+                        /* Give up, start again. */
+                        EP_DHCPData.eDHCPState = eInitialWait;
 
-                    /* Reset expected state so that DHCP packets from
-                     * different DHCP servers if available already in the DHCP socket can
-                     * be processed */
-                    EP_DHCPData.eExpectedState = eInitialWait;
+                        /* Reset expected state so that DHCP packets from
+                         * different DHCP servers if available already in the DHCP socket can
+                         * be processed */
+                        EP_DHCPData.eExpectedState = eInitialWait;
+                    }
                 }
             }
         }
         else if( prvProcessDHCPReplies( dhcpMESSAGE_TYPE_ACK, pxEndPoint ) == pdPASS )
         {
-            FreeRTOS_debug_printf( ( "vDHCPProcess: acked %xip\n", ( unsigned int ) FreeRTOS_ntohl( EP_DHCPData.ulOfferedIPAddress ) ) );
+            prvHandleLeaseAcknowledged( pxEndPoint );
+        }
+        else
+        {
+            /* There are no replies yet. */
+        }
+    }
+/*-----------------------------------------------------------*/
 
-            /* DHCP completed.  The IP address can now be used, and the
-             * timer set to the lease timeout time. */
-            EP_IPv4_SETTINGS.ulIPAddress = EP_DHCPData.ulOfferedIPAddress;
+/**
+ * @brief Called when a DHCP server acknowledged the lease of an IP-address,
+ *        either in reply to a REQUEST, or to a DISCOVER with the Rapid Commit
+ *        option.  The address will be used from now on.
+ * @param[in] pxEndPoint The end-point that got an IP-address from a DHCP server
+ */
+    static void prvHandleLeaseAcknowledged( NetworkEndPoint_t * pxEndPoint )
+    {
+        FreeRTOS_debug_printf( ( "vDHCPProcess: acked %xip\n", ( unsigned int ) FreeRTOS_ntohl( EP_DHCPData.ulOfferedIPAddress ) ) );
 
-            /* Setting the 'local' broadcast address, something like
-             * '192.168.1.255'. */
-            EP_IPv4_SETTINGS.ulBroadcastAddress = EP_DHCPData.ulOfferedIPAddress | ~( EP_IPv4_SETTINGS.ulNetMask );
-            EP_DHCPData.eDHCPState = eLeasedAddress;
+        /* DHCP completed.  The IP address can now be used, and the
+         * timer set to the lease timeout time. */
+        EP_IPv4_SETTINGS.ulIPAddress = EP_DHCPData.ulOfferedIPAddress;
 
-            iptraceDHCP_SUCCEEDED( EP_DHCPData.ulOfferedIPAddress );
+        /* Setting the 'local' broadcast address, something like
+         * '192.168.1.255'. */
+        EP_IPv4_SETTINGS.ulBroadcastAddress = EP_DHCPData.ulOfferedIPAddress | ~( EP_IPv4_SETTINGS.ulNetMask );
+        EP_DHCPData.eDHCPState = eLeasedAddress;
 
-            /* DHCP failed, the default configured IP-address will be used
-             * Now call vIPNetworkUpCalls() to send the network-up event and
-             * start the ARP timer. */
-            vIPNetworkUpCalls( pxEndPoint );
-            /* Close socket to ensure packets don't queue on it. */
-            prvCloseDHCPSocket( pxEndPoint );
+        iptraceDHCP_SUCCEEDED( EP_DHCPData.ulOfferedIPAddress );
 
-            if( EP_DHCPData.ulLeaseTime == 0U )
-            {
-                EP_DHCPData.ulLeaseTime = dhcpDEFAULT_LEASE_TIME;
-            }
-            else if( EP_DHCPData.ulLeaseTime < dhcpMINIMUM_LEASE_TIME )
-            {
-                EP_DHCPData.ulLeaseTime = dhcpMINIMUM_LEASE_TIME;
-            }
-            else
-            {
-                /* The lease time is already valid. */
-            }
+        /* DHCP failed, the default configured IP-address will be used
+         * Now call vIPNetworkUpCalls() to send the network-up event and
+         * start the ARP timer. */
+        vIPNetworkUpCalls( pxEndPoint );
+        /* Close socket to ensure packets don't queue on it. */
+        prvCloseDHCPSocket( pxEndPoint );
 
-            /* Check for clashes. */
-            vARPSendGratuitous();
-            vDHCP_RATimerReload( ( struct xNetworkEndPoint * ) pxEndPoint, EP_DHCPData.ulLeaseTime );
+        if( EP_DHCPData.ulLeaseTime == 0U )
+        {
+            EP_DHCPData.ulLeaseTime = dhcpDEFAULT_LEASE_TIME;
+        }
+        else if( EP_DHCPData.ulLeaseTime < dhcpMINIMUM_LEASE_TIME )
+        {
+            EP_DHCPData.ulLeaseTime = dhcpMINIMUM_LEASE_TIME;
         }
         else
         {
-            /* There are no replies yet. */
+            /* The lease time is already valid. */
         }
+
+        /* Check for clashes. */
+        vARPSendGratuitous();
+        vDHCP_RATimerReload( ( struct xNetworkEndPoint * ) pxEndPoint, EP_DHCPData.ulLeaseTime );
+
+        #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_INIT_REBOOT ) )
+        {
+            EP_DHCPData.xInitReboot = pdFALSE;
+
+            /* Remember the address, it will be requested directly when DHCP
+             * starts over. */
+            if( EP_DHCPData.ulLastLeasedAddress != EP_DHCPData.ulOfferedIPAddress )
+            {
+                EP_DHCPData.ulLastLeasedAddress = EP_DHCPData.ulOfferedIPAddress;
+
+                #if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP_LEASE_HOOK ) )
+                    vApplicationDHCPStoreLease( pxEndPoint, EP_DHCPData.ulLastLeasedAddress );
+                #endif
+            }
+        }
+        #endif /* ipconfigDHCP_USE_INIT_REBOOT */
     }
 
 /**
@@ -597,15 +663,36 @@
                 /* Send the first discover request. */
                 EP_DHCPData.xDHCPTxTime = xTaskGetTickCount();
 
-                if( prvSendDHCPDiscover( pxEndPoint ) == pdPASS )
-                {
-                    EP_DHCPData.eDHCPState = eWaitingOffer;
-                }
-                else
+                #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_INIT_REBOOT ) )
+                    if( EP_DHCPData.xInitReboot != pdFALSE )
+                    {
+                        /* INIT-REBOOT: request the last leased address directly. */
+                        EP_DHCPData.ulOfferedIPAddress = EP_DHCPData.ulLastLeasedAddress;
+
+                        if( prvSendDHCPRequest( pxEndPoint ) == pdPASS )
+                        {
+                            EP_DHCPData.eDHCPState = eWaitingAcknowledge;
+                        }
+                        else
+                        {
+                            /* Either the creation of a message buffer failed, or sendto().
+                             * Try again in the next cycle. */
+                            FreeRTOS_debug_printf( ( "Send failed during INIT-REBOOT\n" ) );
+                        }
+                    }
+                    else
+                #endif /* ipconfigDHCP_USE_INIT_REBOOT */
                 {
-                    /* Either the creation of a message buffer failed, or sendto().
-                     * Try again in the next cycle. */
-                    FreeRTOS_debug_printf( ( "Send failed during eWaitingSendFirstDiscover\n" ) );
+                    if( prvSendDHCPDiscover( pxEndPoint ) == pdPASS )
+                    {
+                        EP_DHCPData.eDHCPState = eWaitingOffer;
+                    }
+                    else
+                    {
+                        /* Either the creation of a message buffer failed, or sendto().
+                         * Try again in the next cycle. */
+                        FreeRTOS_debug_printf( ( "Send failed during eWaitingSendFirstDiscover\n" ) );
+                    }
                 }
             }
         }
@@ -970,6 +1057,33 @@
             EP_DHCPData.ulDHCPServerAddress = 0U;
             EP_DHCPData.xDHCPTxPeriod = dhcpINITIAL_DHCP_TX_PERIOD;
 
+            #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_INIT_REBOOT ) )
+            {
+                #if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP_LEASE_HOOK ) )
+                    if( EP_DHCPData.ulLastLeasedAddress == 0U )
+                    {
+                        uint32_t ulIPAddress = 0U;
+
+                        /* After a reset, the lease may be found in non-volatile memory. */
+                        if( xApplicationDHCPLoadLease( pxEndPoint, &( ulIPAddress ) ) != pdFALSE )
+                        {
+                            EP_DHCPData.ulLastLeasedAddress = ulIPAddress;
+                        }
+                    }
+                #endif /* ipconfigUSE_DHCP_LEASE_HOOK */
+
+                /* A known lease will be requested in the INIT-REBOOT state. */
+                if( EP_DHCPData.ulLastLeasedAddress != 0U )
+                {
+                    EP_DHCPData.xInitReboot = pdTRUE;
+                }
+                else
+                {
+                    EP_DHCPData.xInitReboot = pdFALSE;
+                }
+            }
+            #endif /* ipconfigDHCP_USE_INIT_REBOOT */
+
             /* Create the DHCP socket if it has not already been created. */
             prvCreateDHCPSocket( pxEndPoint );
             FreeRTOS_debug_printf( ( "prvInitialiseDHCP: start after %lu ticks\n", ( unsigned long ) dhcpINITIAL_TIMER_PERIOD ) );
@@ -1006,12 +1120,37 @@
                      * state machine is expecting. */
                     pxSet->ulProcessed++;
                 }
+
+                #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_RAPID_COMMIT ) )
+                    else if( ( xExpectedMessageType == ( BaseType_t ) dhcpMESSAGE_TYPE_OFFER ) &&
+                             ( pxSet->pucByte[ pxSet->uxIndex ] == ( uint8_t ) dhcpMESSAGE_TYPE_ACK ) )
+                    {
+                        /* The DISCOVER might be answered with an ACK, which is
+                         * only valid when it has the Rapid Commit option. */
+                        pxSet->xRapidAck = pdTRUE;
+                        pxSet->ulProcessed++;
+                    }
+                #endif /* ipconfigDHCP_USE_RAPID_COMMIT */
                 else
                 {
                     if( pxSet->pucByte[ pxSet->uxIndex ] == ( uint8_t ) dhcpMESSAGE_TYPE_NACK )
                     {
                         if( xExpectedMessageType == ( BaseType_t ) dhcpMESSAGE_TYPE_ACK )
                         {
+                            #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_INIT_REBOOT ) )
+                            {
+                                /* The last leased address may not be used anymore. */
+                                if( EP_DHCPData.ulLastLeasedAddress != 0U )
+                                {
+                                    EP_DHCPData.ulLastLeasedAddress = 0U;
+
+                                    #if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP_LEASE_HOOK ) )
+                                        vApplicationDHCPStoreLease( pxEndPoint, 0U );
+                                    #endif
+                                }
+                            }
+                            #endif /* ipconfigDHCP_USE_INIT_REBOOT */
+
                             /* Start again. */
                             EP_DHCPData.eDHCPState = eInitialWait;
 
@@ -1109,6 +1248,16 @@
                     }
                     else
                     {
+                        #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_INIT_REBOOT ) )
+                        {
+                            if( ( EP_DHCPData.xInitReboot != pdFALSE ) && ( EP_DHCPData.ulDHCPServerAddress == 0U ) )
+                            {
+                                /* In the INIT-REBOOT state, the server is not known yet. */
+                                EP_DHCPData.ulDHCPServerAddress = pxSet->ulParameter;
+                            }
+                        }
+                        #endif
+
                         /* The ack must come from the expected server. */
                         if( EP_DHCPData.ulDHCPServerAddress == pxSet->ulParameter )
                         {
@@ -1140,6 +1289,16 @@
 
                 break;
 
+                #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_RAPID_COMMIT ) )
+                    case dhcpIPv4_RAPID_COMMIT_OPTION_CODE:
+
+                        /* ulProcessed is not incremented in this case
+                         * because the option is only required in an ACK
+                         * that answers a DISCOVER. */
+                        pxSet->xRapidCommit = pdTRUE;
+                        break;
+                #endif /* ipconfigDHCP_USE_RAPID_COMMIT */
+
             default:
 
                 /* Not interested in this field. */
@@ -1344,6 +1503,13 @@
 
                         if( xResult != 0 )
                         {
+                            #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_RAPID_COMMIT ) )
+                                if( ( xResult > 0 ) && ( xSet.ucOptionCode == ( uint8_t ) dhcpIPv4_RAPID_COMMIT_OPTION_CODE ) )
+                                {
+                                    /* The Rapid Commit option has no data, continue parsing. */
+                                }
+                                else
+                            #endif
                             if( ( xSet.uxLength == 0U ) || ( xResult < 0 ) )
                             {
                                 break;
@@ -1353,9 +1519,21 @@
                         }
                     }
 
+                    #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_RAPID_COMMIT ) )
+                        if( ( xSet.xRapidAck != pdFALSE ) && ( xSet.xRapidCommit == pdFALSE ) )
+                        {
+                            /* An ACK without the Rapid Commit option can not answer a DISCOVER. */
+                            xSet.ulProcessed = 0U;
+                        }
+                    #endif
+
                     /* Were all the mandatory options received? */
                     if( xSet.ulProcessed >= ulMandatoryOptions )
                     {
+                        #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_RAPID_COMMIT ) )
+                            EP_DHCPData.xRapidCommitAck = xSet.xRapidAck;
+                        #endif
+
                         /* HT:endian: used to be network order */
                         EP_DHCPData.ulOfferedIPAddress = pxDHCPMessage->ulYourIPAddress_yiaddr;
                         FreeRTOS_printf( ( "vDHCPProcess: offer %xip for MAC address %02x-%02x\n",
@@ -1558,6 +1736,20 @@
             pvCopyDest = &pucUDPPayloadBuffer[ dhcpFIRST_OPTION_BYTE_OFFSET + dhcpDHCP_SERVER_IP_ADDRESS_OFFSET ];
             ( void ) memcpy( pvCopyDest, pvCopySource, sizeof( EP_DHCPData.ulDHCPServerAddress ) );
 
+            #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_INIT_REBOOT ) )
+                if( EP_DHCPData.xInitReboot != pdFALSE )
+                {
+                    /* A REQUEST in the INIT-REBOOT state must not contain
+                     * the server identifier, remove option-54. */
+                    size_t uxCopyLength = uxOptionsLength - ( dhcpOPTION_54_OFFSET + dhcpOPTION_54_SIZE );
+
+                    pvCopySource = &( pucUDPPayloadBuffer[ dhcpFIRST_OPTION_BYTE_OFFSET + dhcpOPTION_54_OFFSET + dhcpOPTION_54_SIZE ] );
+                    pvCopyDest = &( pucUDPPayloadBuffer[ dhcpFIRST_OPTION_BYTE_OFFSET + dhcpOPTION_54_OFFSET ] );
+                    ( void ) memmove( pvCopyDest, pvCopySource, uxCopyLength );
+                    uxOptionsLength -= dhcpOPTION_54_SIZE;
+                }
+            #endif /* ipconfigDHCP_USE_INIT_REBOOT */
+
             FreeRTOS_debug_printf( ( "vDHCPProcess: reply %xip\n", ( unsigned ) FreeRTOS_ntohl( EP_DHCPData.ulOfferedIPAddress ) ) );
             iptraceSENDING_DHCP_REQUEST();
 
@@ -1598,6 +1790,9 @@
             dhcpIPv4_CLIENT_IDENTIFIER_OPTION_CODE,  7, 1,                                0,                            0, 0, 0, 0, 0,                    /* Client identifier. */
             dhcpIPv4_REQUEST_IP_ADDRESS_OPTION_CODE, 4, 0,                                0,                            0, 0,                             /* The IP address being requested. */
             dhcpIPv4_PARAMETER_REQUEST_OPTION_CODE,  3, dhcpIPv4_SUBNET_MASK_OPTION_CODE, dhcpIPv4_GATEWAY_OPTION_CODE, dhcpIPv4_DNS_SERVER_OPTIONS_CODE, /* Parameter request option. */
+            #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_RAPID_COMMIT ) )
+                dhcpIPv4_RAPID_COMMIT_OPTION_CODE,   0,                                                                                                   /* Rapid Commit option. */
+            #endif
             dhcpOPTION_END_BYTE
         };
         size_t uxOptionsLength = sizeof( ucDHCPDiscoverOptions );
@@ -196,6 +196,12 @@ const MACAddress_t xMDNS_MacAddressIPv6 = { { 0x33, 0x33, 0x00, 0x00, 0x00, 0xFB
         void vDNSInitialise( void )
         {
             vDNSCallbackInitialise();
+
+            #if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+            {
+                vDNSResolverInitialise();
+            }
+            #endif
         }
     #endif /* ipconfigDNS_USE_CALLBACKS == 1 */
 /*-----------------------------------------------------------*/
@@ -1064,13 +1070,16 @@ const MACAddress_t xMDNS_MacAddressIPv6 = { { 0x33, 0x33, 0x00, 0x00, 0x00, 0xFB
  *                will be stored.
  * @param [in] uxIdentifier matches sent and received packets
  * @param [in] usPort Port from which DNS reply was read
+ * @param [in] pcHostName The name that was looked up by a blocking look-up, or
+ *                        NULL when the reply may be meant for a callback.
  * @returns ip address or zero on error
  *
  */
     static uint32_t prvDNSReply( const struct xDNSBuffer * pxReceiveBuffer,
                                  struct freertos_addrinfo ** ppxAddressInfo,
                                  TickType_t uxIdentifier,
-                                 uint16_t usPort )
+                                 uint16_t usPort,
+                                 const char * pcHostName )
     {
         uint32_t ulIPAddress = 0U;
         BaseType_t xExpected;
@@ -1100,6 +1109,50 @@ const MACAddress_t xMDNS_MacAddressIPv6 = { { 0x33, 0x33, 0x00, 0x00, 0x00, 0xFB
             xExpected = pdFALSE;
         }
 
+        if( ( xExpected != pdFALSE ) && ( pcHostName != NULL ) && ( usPort == dnsDNS_PORT ) )
+        {
+            DNSAddressRecord_t xRecords[ ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY ];
+            BaseType_t xCount;
+            BaseType_t xIndex;
+
+            /* The answer of a DNS server to a blocking look-up is parsed in a
+             * single pass, like the replies to the resolver. The answers must
+             * belong to the name that was asked. */
+            xCount = DNS_ParseAddressRecords( pxReceiveBuffer->pucPayloadBuffer,
+                                              pxReceiveBuffer->uxPayloadLength,
+                                              pcHostName,
+                                              xRecords,
+                                              ( size_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY );
+
+            if( xCount > 0 )
+            {
+                #if ( ipconfigUSE_DNS_CACHE == 1 )
+                {
+                    DNS_StoreAddressRecords( pcHostName, xRecords, ( size_t ) xCount );
+                }
+                #endif
+
+                if( ppxAddressInfo != NULL )
+                {
+                    *ppxAddressInfo = DNS_AddressRecordsToList( pcHostName, xRecords, ( size_t ) xCount );
+                }
+
+                /* Like DNS_ParseDNSReply(), return the first IPv4 address, or
+                 * a non-zero value when only IPv6 addresses were found. */
+                ulIPAddress = 1U;
+
+                for( xIndex = 0; xIndex < xCount; xIndex++ )
+                {
+                    if( xRecords[ xIndex ].xAddress.xIs_IPv6 == pdFALSE )
+                    {
+                        ulIPAddress = xRecords[ xIndex ].xAddress.xIPAddress.ulIP_IPv4;
+                        break;
+                    }
+                }
+            }
+        }
+        else
+
         /* The reply was received.  Process it. */
         #if ( ipconfigDNS_USE_CALLBACKS == 0 )
 
@@ -1223,6 +1276,74 @@ const MACAddress_t xMDNS_MacAddressIPv6 = { { 0x33, 0x33, 0x00, 0x00, 0x00, 0xFB
         return xReturn;
     }
 
+    #if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+
+/*!
+ * @brief Send a single DNS query on behalf of the asynchronous resolver.
+ *        This function is called from the IP-task and does not wait for a reply.
+ * @param [in] pcHostName hostname to be looked up
+ * @param [in] uxIdentifier matches sent and received packets
+ * @param [in] xDNSSocket the bound socket of the resolver
+ * @param [in] xFamily Either FREERTOS_AF_INET4 or FREERTOS_AF_INET6.
+ * @param [in] xNextServer pdTRUE when the previous query timed out, and the
+ *                         next DNS server of the end-point must be used.
+ * @returns pdPASS if the query was sent, pdFAIL otherwise.
+ */
+        BaseType_t xDNSSendQuery( const char * pcHostName,
+                                  TickType_t uxIdentifier,
+                                  Socket_t xDNSSocket,
+                                  BaseType_t xFamily,
+                                  BaseType_t xNextServer )
+        {
+            BaseType_t xReturn = pdFAIL;
+            struct freertos_sockaddr xAddress;
+            NetworkEndPoint_t * pxEndPoint;
+
+            pxEndPoint = prvFillSockAddress( &xAddress, pcHostName );
+
+            if( ( pxEndPoint != NULL ) && ( xNextServer != pdFALSE ) )
+            {
+                switch( xAddress.sin_family )
+                {
+                    #if ( ipconfigUSE_IPv4 != 0 )
+                        case FREERTOS_AF_INET:
+                            prvIncreaseDNS4Index( pxEndPoint );
+                            break;
+                    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                    #if ( ipconfigUSE_IPv6 != 0 )
+                        case FREERTOS_AF_INET6:
+                            prvIncreaseDNS6Index( pxEndPoint );
+                            break;
+                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                    default:
+                        /* MISRA 16.4 Compliance */
+                        break;
+                }
+
+                /* Fill in the address of the next DNS server. */
+                pxEndPoint = prvFillSockAddress( &xAddress, pcHostName );
+            }
+
+            if( pxEndPoint != NULL )
+            {
+                xReturn = prvSendBuffer( pcHostName,
+                                         uxIdentifier,
+                                         xDNSSocket,
+                                         xFamily,
+                                         &xAddress );
+            }
+            else
+            {
+                FreeRTOS_printf( ( "Can not find a DNS address, along with an end-point.\n" ) );
+            }
+
+            return xReturn;
+        }
+
+    #endif /* if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) ) */
+
 /*!
  * @brief main dns operation description function
  * @param [in] pcHostName hostname to get its ip address
@@ -1331,7 +1452,11 @@ const MACAddress_t xMDNS_MacAddressIPv6 = { { 0x33, 0x33, 0x00, 0x00, 0x00, 0xFB
                         /* MISRA Ref 4.14.2 [The validity of values received from external sources]. */
                         /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-414. */
                         /* coverity[misra_c_2012_directive_4_14_violation] */
-                        ulIPAddress = prvDNSReply( &xReceiveBuffer, ppxAddressInfo, uxIdentifier, xRecvAddress.sin_port );
+                        ulIPAddress = prvDNSReply( &xReceiveBuffer,
+                                                   ppxAddressInfo,
+                                                   uxIdentifier,
+                                                   xRecvAddress.sin_port,
+                                                   ( uxReadTimeOut_ticks != 0U ) ? pcHostName : NULL );
                     }
 
                     /* Finished with the buffer.  The zero copy interface
@@ -1445,6 +1570,15 @@ const MACAddress_t xMDNS_MacAddressIPv6 = { { 0x33, 0x33, 0x00, 0x00, 0x00, 0xFB
             DNS_CloseSocket( xDNSSocket );
         }
 
+        #if ( ( ipconfigUSE_DNS_CACHE == 1 ) && ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 ) )
+            if( ( ulIPAddress == 0U ) && ( uxReadTimeOut_ticks != 0U ) )
+            {
+                /* None of the DNS servers gave an answer, an expired entry
+                 * of the DNS cache is better than nothing. */
+                ulIPAddress = Prepare_StaleCacheLookup( pcHostName, xFamily, ppxAddressInfo );
+            }
+        #endif
+
         return ulIPAddress;
     }
     /*-----------------------------------------------------------*/
@@ -1588,14 +1722,26 @@ const MACAddress_t xMDNS_MacAddressIPv6 = { { 0x33, 0x33, 0x00, 0x00, 0x00, 0xFB
             if( uxPayloadSize >= sizeof( DNSMessage_t ) )
             {
                 struct freertos_addrinfo * pxAddressInfo = NULL;
+                BaseType_t xHandled = pdFALSE;
                 pucPayLoadBuffer = &( pxNetworkBuffer->pucEthernetBuffer[ uxUDPPacketSize ] );
 
-                /* The parameter pdFALSE indicates that the reply was not expected. */
-                ( void ) DNS_ParseDNSReply( pucPayLoadBuffer,
-                                            uxPayloadSize,
-                                            &( pxAddressInfo ),
-                                            pdFALSE,
-                                            FreeRTOS_ntohs( pxNetworkBuffer->usPort ) );
+                #if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+                {
+                    /* Let the mDNS browser store the answers. It may also decide
+                     * that a query does not need an answer from us. */
+                    xHandled = xMDNSProcessPacket( pxNetworkBuffer, pucPayLoadBuffer, uxPayloadSize );
+                }
+                #endif
+
+                if( xHandled == pdFALSE )
+                {
+                    /* The parameter pdFALSE indicates that the reply was not expected. */
+                    ( void ) DNS_ParseDNSReply( pucPayLoadBuffer,
+                                                uxPayloadSize,
+                                                &( pxAddressInfo ),
+                                                pdFALSE,
+                                                FreeRTOS_ntohs( pxNetworkBuffer->usPort ) );
+                }
 
                 if( pxAddressInfo != NULL )
                 {
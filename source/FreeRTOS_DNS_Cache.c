@@ -40,6 +40,9 @@
 
 #include "FreeRTOS_DNS_Cache.h"
 #include "FreeRTOS_DNS_Globals.h"
+#include "FreeRTOS_DNS.h"
+#include "FreeRTOS_DNS_Parser.h"
+#include "FreeRTOS_LRU_Hash.h"
 
 /* Standard includes. */
 #include <stdint.h>
@@ -53,14 +56,58 @@
  */
     static DNSCacheRow_t xDNSCache[ ipconfigDNS_CACHE_ENTRIES ];
 
+    #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+
+/** @brief The offset basis and the prime of the 32-bit FNV-1a hash. */
+        #define dnsFNV_OFFSET_BASIS    ( 2166136261U )
+        #define dnsFNV_PRIME           ( 16777619U )
+
+/** @brief The first entry in each hash bucket of the DNS cache. */
+        static LRUHashLink_t xDNSHashHeads[ ipconfigDNS_CACHE_HASH_BUCKETS ];
+
+/** @brief The hash and LRU links of each entry in the DNS cache. */
+        static LRUHashLinks_t xDNSHashLinks[ ipconfigDNS_CACHE_ENTRIES ];
+
+/** @brief The hash index and the LRU list of the DNS cache. */
+        static LRUHashTable_t xDNSHashTable = lruHASH_TABLE_INIT( xDNSHashHeads, xDNSHashLinks );
+
+/** @brief The host names of the cache entries, stored as consecutive
+ * nul-terminated strings. */
+        static char pcDNSNameArena[ ipconfigDNS_CACHE_NAME_ARENA_SIZE ];
+
+/** @brief The number of bytes in use in pcDNSNameArena[]. */
+        static size_t uxDNSNamesUsed = 0U;
+
+/** @brief The number of bytes in pcDNSNameArena[] taken by names that are no
+ * longer referred to. They are reclaimed when the arena is compacted. */
+        static size_t uxDNSNamesGarbage = 0U;
+    #else /* if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) */
+
 /*!
  * @brief indicates the index of a free entry in the cache structure
  *        \a  DNSCacheRow_t
  */
-    static UBaseType_t uxFreeEntry = 0U;
+        static UBaseType_t uxFreeEntry = 0U;
+    #endif /* if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) */
+
+    #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+
+/** @brief DNSCacheRow_t::ucRefresh: a look-up asks the IP-task to refresh the entry. */
+        #define dnsCACHE_REFRESH_WANTED    ( 1U )
+
+/** @brief DNSCacheRow_t::ucRefresh: the resolver is refreshing the entry. */
+        #define dnsCACHE_REFRESH_ACTIVE    ( 2U )
+
+/** @brief pdTRUE when at least one entry has a refresh that was not started yet. */
+        static BaseType_t xDNSRefreshWanted = pdFALSE;
+    #endif
+
+/** returns the host name of an entry in the dns cache. */
+    static const char * prvEntryName( UBaseType_t uxIndex );
 
 /** returns the index of the hostname entry in the dns cache. */
     static BaseType_t prvFindEntryIndex( const char * pcName,
+                                         uint32_t ulNameHash,
                                          const IPv46_Address_t * pxIP,
                                          UBaseType_t * uxResult );
 
@@ -68,7 +115,8 @@
     static BaseType_t prvGetCacheIPEntry( UBaseType_t uxIndex,
                                           IPv46_Address_t * pxIP,
                                           uint32_t ulCurrentTimeSeconds,
-                                          struct freertos_addrinfo ** ppxAddressInfo );
+                                          struct freertos_addrinfo ** ppxAddressInfo,
+                                          BaseType_t xAllowStale );
 
 /** update entry at \p index in the cache. */
     static void prvUpdateCacheEntry( UBaseType_t uxIndex,
@@ -78,6 +126,7 @@
 
 /** insert entry in the cache. */
     static void prvInsertCacheEntry( const char * pcName,
+                                     uint32_t ulNameHash,
                                      uint32_t ulTTL,
                                      const IPv46_Address_t * pxIP,
                                      uint32_t ulCurrentTimeSeconds );
@@ -88,6 +137,225 @@
 
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+
+/**
+ * @brief Calculate a case-insensitive FNV-1a hash of a host name.
+ *
+ * @param[in] pcName The host name.
+ *
+ * @return The 32-bit hash value.
+ */
+        static uint32_t prvDNSNameHash( const char * pcName )
+        {
+            uint32_t ulHash = dnsFNV_OFFSET_BASIS;
+            const char * pcChar;
+
+            for( pcChar = pcName; *pcChar != ( char ) 0; pcChar++ )
+            {
+                ulHash ^= ( uint32_t ) DNS_LowerCase( ( uint8_t ) *pcChar );
+                ulHash *= dnsFNV_PRIME;
+            }
+
+            return ulHash;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find another entry that shares the stored name of an entry.
+ *
+ * @param[in] uxIndex The entry number, which must have a name.
+ *
+ * @return pdTRUE when another entry refers to the same name in the arena.
+ */
+        static BaseType_t prvDNSNameIsShared( UBaseType_t uxIndex )
+        {
+            BaseType_t xShared = pdFALSE;
+            BaseType_t xEntry;
+
+            /* Entries that share a name have the same hash, they are in the same bucket. */
+            for( xEntry = xLRUHashFirst( &( xDNSHashTable ), xDNSCache[ uxIndex ].ulNameHash );
+                 xEntry >= 0;
+                 xEntry = xLRUHashNext( &( xDNSHashTable ), xEntry ) )
+            {
+                if( ( ( UBaseType_t ) xEntry != uxIndex ) &&
+                    ( xDNSCache[ xEntry ].usNameOffset == xDNSCache[ uxIndex ].usNameOffset ) )
+                {
+                    xShared = pdTRUE;
+                    break;
+                }
+            }
+
+            return xShared;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release an entry of the DNS cache, it will be the first one to be
+ *        re-used. Its name stays in the arena until the arena is compacted.
+ *
+ * @param[in] uxIndex The entry number.
+ */
+        static void prvDNSClearEntry( UBaseType_t uxIndex )
+        {
+            if( xDNSCache[ uxIndex ].usNameOffset != 0U )
+            {
+                if( prvDNSNameIsShared( uxIndex ) == pdFALSE )
+                {
+                    uxDNSNamesGarbage += strlen( prvEntryName( uxIndex ) ) + 1U;
+                }
+
+                vLRUHashRemove( &( xDNSHashTable ), xDNSCache[ uxIndex ].ulNameHash, ( BaseType_t ) uxIndex );
+                xDNSCache[ uxIndex ].usNameOffset = 0U;
+                vLRUHashRelease( &( xDNSHashTable ), ( BaseType_t ) uxIndex );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Move all names that are still referred to, to the start of the name
+ *        arena. Entries that share a name are all updated.
+ */
+        static void prvDNSCompactNames( void )
+        {
+            size_t uxRead = 0U;
+            size_t uxWrite = 0U;
+
+            while( uxRead < uxDNSNamesUsed )
+            {
+                size_t uxLength = strlen( &( pcDNSNameArena[ uxRead ] ) ) + 1U;
+                BaseType_t xReferred = pdFALSE;
+                UBaseType_t uxIndex;
+
+                for( uxIndex = 0U; uxIndex < ( UBaseType_t ) xDNSHashTable.uxEntriesUsed; uxIndex++ )
+                {
+                    if( xDNSCache[ uxIndex ].usNameOffset == ( uint16_t ) ( uxRead + 1U ) )
+                    {
+                        xDNSCache[ uxIndex ].usNameOffset = ( uint16_t ) ( uxWrite + 1U );
+                        xReferred = pdTRUE;
+                    }
+                }
+
+                if( xReferred != pdFALSE )
+                {
+                    if( uxWrite != uxRead )
+                    {
+                        ( void ) memmove( &( pcDNSNameArena[ uxWrite ] ), &( pcDNSNameArena[ uxRead ] ), uxLength );
+                    }
+
+                    uxWrite += uxLength;
+                }
+
+                uxRead += uxLength;
+            }
+
+            uxDNSNamesUsed = uxWrite;
+            uxDNSNamesGarbage = 0U;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find storage for a host name in the name arena. When another entry
+ *        has the same name, its copy is shared. Otherwise the name is added to
+ *        the arena. When the arena is full, the least recently used entries
+ *        are evicted until enough names can be reclaimed, and then the arena
+ *        is compacted once.
+ *
+ * @param[in] pcName The host name.
+ * @param[in] ulNameHash The hash of the host name.
+ *
+ * @return The offset plus one of the name in the arena, or zero when the name
+ *         could not be stored.
+ */
+        static uint16_t prvDNSStoreName( const char * pcName,
+                                         uint32_t ulNameHash )
+        {
+            uint16_t usOffset = 0U;
+            size_t uxLength = strlen( pcName ) + 1U;
+            BaseType_t xEntry;
+
+            /* See if the name is already interned by an entry of another IP type. */
+            for( xEntry = xLRUHashFirst( &( xDNSHashTable ), ulNameHash );
+                 xEntry >= 0;
+                 xEntry = xLRUHashNext( &( xDNSHashTable ), xEntry ) )
+            {
+                if( ( xDNSCache[ xEntry ].ulNameHash == ulNameHash ) &&
+                    ( strcasecmp( prvEntryName( ( UBaseType_t ) xEntry ), pcName ) == 0 ) )
+                {
+                    usOffset = xDNSCache[ xEntry ].usNameOffset;
+                    break;
+                }
+            }
+
+            if( ( usOffset == 0U ) && ( uxLength <= sizeof( pcDNSNameArena ) ) )
+            {
+                if( ( uxDNSNamesUsed + uxLength ) > sizeof( pcDNSNameArena ) )
+                {
+                    /* Evict the least recently used entries that have a name,
+                     * until compacting the arena will make enough room. */
+                    xEntry = xLRUHashOldest( &( xDNSHashTable ) );
+
+                    while( ( ( uxDNSNamesUsed - uxDNSNamesGarbage + uxLength ) > sizeof( pcDNSNameArena ) ) && ( xEntry >= 0 ) )
+                    {
+                        BaseType_t xNewer = xLRUHashNewer( &( xDNSHashTable ), xEntry );
+
+                        prvDNSClearEntry( ( UBaseType_t ) xEntry );
+                        xEntry = xNewer;
+                    }
+
+                    if( ( uxDNSNamesUsed - uxDNSNamesGarbage + uxLength ) <= sizeof( pcDNSNameArena ) )
+                    {
+                        prvDNSCompactNames();
+                    }
+                }
+
+                if( ( uxDNSNamesUsed + uxLength ) <= sizeof( pcDNSNameArena ) )
+                {
+                    ( void ) memcpy( &( pcDNSNameArena[ uxDNSNamesUsed ] ), pcName, uxLength );
+                    usOffset = ( uint16_t ) ( uxDNSNamesUsed + 1U );
+                    uxDNSNamesUsed += uxLength;
+                }
+            }
+
+            return usOffset;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ipconfigDNS_CACHE_HASH_BUCKETS > 0 */
+
+/**
+ * @brief Get the host name of an entry in the DNS cache.
+ *
+ * @param[in] uxIndex The entry number.
+ *
+ * @return The host name, an empty string for a free entry.
+ */
+    static const char * prvEntryName( UBaseType_t uxIndex )
+    {
+        const char * pcName;
+
+        #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+        {
+            if( xDNSCache[ uxIndex ].usNameOffset != 0U )
+            {
+                pcName = &( pcDNSNameArena[ xDNSCache[ uxIndex ].usNameOffset - 1U ] );
+            }
+            else
+            {
+                pcName = "";
+            }
+        }
+        #else
+        {
+            pcName = xDNSCache[ uxIndex ].pcName;
+        }
+        #endif /* if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) */
+
+        return pcName;
+    }
+/*-----------------------------------------------------------*/
+
+
     #if ( ipconfigUSE_IPv4 != 0 )
 
 /**
@@ -183,7 +451,17 @@
     void FreeRTOS_dnsclear( void )
     {
         ( void ) memset( xDNSCache, 0x0, sizeof( xDNSCache ) );
-        uxFreeEntry = 0U;
+        #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+        {
+            vLRUHashClear( &( xDNSHashTable ) );
+            uxDNSNamesUsed = 0U;
+            uxDNSNamesGarbage = 0U;
+        }
+        #else
+        {
+            uxFreeEntry = 0U;
+        }
+        #endif /* if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) */
     }
 
 /**
@@ -212,16 +490,24 @@
         TickType_t xCurrentTickCount = xTaskGetTickCount();
         /* In milliseconds. */
         uint32_t ulCurrentTimeSeconds;
+        uint32_t ulNameHash = 0U;
 
         configASSERT( ( pcName != NULL ) );
 
+        #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+        {
+            /* The hash is calculated once, for both the look-up and the insertion. */
+            ulNameHash = prvDNSNameHash( pcName );
+        }
+        #endif
+
         if( xLookUp != pdFALSE )
         {
             pxIP->xIPAddress.ulIP_IPv4 = 0U;
         }
 
         ulCurrentTimeSeconds = ( uint32_t ) ( ( xCurrentTickCount / configTICK_RATE_HZ ) );
-        xResult = prvFindEntryIndex( pcName, pxIP, &uxIndex );
+        xResult = prvFindEntryIndex( pcName, ulNameHash, pxIP, &uxIndex );
 
         if( xResult == pdTRUE )
         { /* Element found */
@@ -235,7 +521,8 @@
                 ( void ) prvGetCacheIPEntry( uxIndex,
                                              pxIP,
                                              ulCurrentTimeSeconds,
-                                             ppxAddressInfo );
+                                             ppxAddressInfo,
+                                             pdFALSE );
             }
             else
             {
@@ -254,6 +541,7 @@
             else
             {
                 prvInsertCacheEntry( pcName,
+                                     ulNameHash,
                                      ulTTL,
                                      pxIP,
                                      ulCurrentTimeSeconds );
@@ -306,29 +594,32 @@
 /**
  * @brief returns the index of the hostname entry in the dns cache.
  * @param[in] pcName find it in the cache
+ * @param[in] ulNameHash the hash of pcName, only used when ipconfigDNS_CACHE_HASH_BUCKETS > 0
  * @param[in] pxIP ip address
  * @param [out] uxResult index number
  * @returns res pdTRUE if index in found else pdFALSE
  */
     static BaseType_t prvFindEntryIndex( const char * pcName,
+                                         uint32_t ulNameHash,
                                          const IPv46_Address_t * pxIP,
                                          UBaseType_t * uxResult )
     {
         BaseType_t xReturn = pdFALSE;
-        UBaseType_t uxIndex;
 
-        /* For each entry in the DNS cache table. */
-        for( uxIndex = 0; uxIndex < ipconfigDNS_CACHE_ENTRIES; uxIndex++ )
+        #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
         {
-            if( xDNSCache[ uxIndex ].pcName[ 0 ] == ( char ) 0 )
-            { /* empty slot */
-                continue;
-            }
+            BaseType_t xEntry;
+
+            for( xEntry = xLRUHashFirst( &( xDNSHashTable ), ulNameHash );
+                 xEntry >= 0;
+                 xEntry = xLRUHashNext( &( xDNSHashTable ), xEntry ) )
+            {
+                UBaseType_t uxIndex = ( UBaseType_t ) xEntry;
 
-            if( strcmp( xDNSCache[ uxIndex ].pcName, pcName ) == 0 )
-            { /* hostname found */
-                /* IPv6 is enabled, See if the cache entry has the correct type. */
-                if( pxIP->xIs_IPv6 == xDNSCache[ uxIndex ].xAddresses[ 0 ].xIs_IPv6 )
+                /* Host names are compared case-insensitive, like the hash. */
+                if( ( xDNSCache[ uxIndex ].ulNameHash == ulNameHash ) &&
+                    ( pxIP->xIs_IPv6 == xDNSCache[ uxIndex ].xAddresses[ 0 ].xIs_IPv6 ) &&
+                    ( strcasecmp( prvEntryName( uxIndex ), pcName ) == 0 ) )
                 {
                     xReturn = pdTRUE;
                     *uxResult = uxIndex;
@@ -336,6 +627,33 @@
                 }
             }
         }
+        #else /* if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) */
+        {
+            UBaseType_t uxIndex;
+
+            ( void ) ulNameHash;
+
+            /* For each entry in the DNS cache table. */
+            for( uxIndex = 0; uxIndex < ipconfigDNS_CACHE_ENTRIES; uxIndex++ )
+            {
+                if( xDNSCache[ uxIndex ].pcName[ 0 ] == ( char ) 0 )
+                { /* empty slot */
+                    continue;
+                }
+
+                if( strcasecmp( xDNSCache[ uxIndex ].pcName, pcName ) == 0 )
+                { /* hostname found */
+                    /* IPv6 is enabled, See if the cache entry has the correct type. */
+                    if( pxIP->xIs_IPv6 == xDNSCache[ uxIndex ].xAddresses[ 0 ].xIs_IPv6 )
+                    {
+                        xReturn = pdTRUE;
+                        *uxResult = uxIndex;
+                        break;
+                    }
+                }
+            }
+        }
+        #endif /* if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) */
 
         return xReturn;
     }
@@ -347,6 +665,8 @@
  * @param[out] pxIP fill it with the result
  * @param[in]  ulCurrentTimeSeconds current time
  * @param[out] ppxAddressInfo Target to store the DNS entries.
+ * @param[in]  xAllowStale pdTRUE when an entry whose TTL expired less than
+ *                         ipconfigDNS_CACHE_SERVE_STALE_SECONDS ago may be read.
  * @returns    \c pdTRUE if the value is valid \c pdFALSE otherwise
  * @post the global structure \a xDNSCache might be modified
  *
@@ -355,15 +675,63 @@
     static BaseType_t prvGetCacheIPEntry( UBaseType_t uxIndex,
                                           IPv46_Address_t * pxIP,
                                           uint32_t ulCurrentTimeSeconds,
-                                          struct freertos_addrinfo ** ppxAddressInfo )
+                                          struct freertos_addrinfo ** ppxAddressInfo,
+                                          BaseType_t xAllowStale )
     {
-        BaseType_t isRead;
+        BaseType_t isRead = pdFALSE;
+        BaseType_t xKeep = pdFALSE;
         uint32_t ulIPAddressIndex = 0;
         uint32_t ulAge = ulCurrentTimeSeconds - xDNSCache[ uxIndex ].ulTimeWhenAddedInSeconds;
+        /* The field ulTTL was stored as network-endian. */
+        uint32_t ulTTL = FreeRTOS_ntohl( xDNSCache[ uxIndex ].ulTTL );
 
-        /* Confirm that the record is still fresh.
-         * The field ulTTL was stored as network-endian. */
-        if( ulAge < FreeRTOS_ntohl( xDNSCache[ uxIndex ].ulTTL ) )
+        /* Confirm that the record is still fresh. */
+        if( ulAge < ulTTL )
+        {
+            isRead = pdTRUE;
+
+            #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+            {
+                if( xDNSCache[ uxIndex ].ucHits < 0xFFU )
+                {
+                    xDNSCache[ uxIndex ].ucHits++;
+                }
+
+                /* A popular entry is refreshed during the last 10% of its TTL,
+                 * so that it does not expire while it is being used. The
+                 * refresh is started by the IP-task, this function may be
+                 * called from any task. */
+                if( ( xDNSCache[ uxIndex ].ucRefresh == 0U ) &&
+                    ( xDNSCache[ uxIndex ].ucHits >= ( uint8_t ) ipconfigDNS_CACHE_PREFETCH_HITS ) &&
+                    ( ( ulTTL - ulAge ) <= ( ulTTL / 10U ) ) )
+                {
+                    xDNSCache[ uxIndex ].ucRefresh = dnsCACHE_REFRESH_WANTED;
+                    xDNSRefreshWanted = pdTRUE;
+
+                    /* When the event can not be sent, the refresh is started
+                     * at the next event of the resolver. */
+                    ( void ) xSendEventToIPTask( eDNSResolverEvent );
+                }
+            }
+            #endif /* if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 ) */
+        }
+
+        #if ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 )
+            else if( ( ulAge - ulTTL ) < ( uint32_t ) ipconfigDNS_CACHE_SERVE_STALE_SECONDS )
+            {
+                /* The entry is kept, but it is only served when no DNS server
+                 * could be reached. */
+                xKeep = pdTRUE;
+                isRead = xAllowStale;
+            }
+        #else
+            else
+            {
+                ( void ) xAllowStale;
+            }
+        #endif /* if ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 ) */
+
+        if( isRead != pdFALSE )
         {
             #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
                 uint8_t ucIndex;
@@ -382,7 +750,10 @@
             #endif /* if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 ) */
 
             ( void ) memcpy( pxIP, &( xDNSCache[ uxIndex ].xAddresses[ ulIPAddressIndex ] ), sizeof( *pxIP ) );
-            isRead = pdTRUE;
+
+            #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+                vLRUHashTouch( &( xDNSHashTable ), ( BaseType_t ) uxIndex );
+            #endif
 
             if( ppxAddressInfo != NULL )
             {
@@ -390,11 +761,18 @@
                 prvReadDNSCache( ( BaseType_t ) uxIndex, ppxAddressInfo );
             }
         }
-        else
+        else if( xKeep == pdFALSE )
         {
             /* Age out the old cached record. */
-            xDNSCache[ uxIndex ].pcName[ 0 ] = ( char ) 0;
-            isRead = pdFALSE;
+            #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+                prvDNSClearEntry( uxIndex );
+            #else
+                xDNSCache[ uxIndex ].pcName[ 0 ] = ( char ) 0;
+            #endif
+        }
+        else
+        {
+            /* An expired entry that may be served later. */
         }
 
         return isRead;
@@ -416,6 +794,43 @@
     {
         uint32_t ulIPAddressIndex = 0;
 
+        #if ( ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 ) || ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 ) )
+        {
+            /* An expired or refreshed entry gets a new set of addresses, the
+             * old ones must not be mixed with the new answer. */
+            BaseType_t xRenew = pdFALSE;
+
+            if( ( ulCurrentTimeSeconds - xDNSCache[ uxIndex ].ulTimeWhenAddedInSeconds ) >= FreeRTOS_ntohl( xDNSCache[ uxIndex ].ulTTL ) )
+            {
+                xRenew = pdTRUE;
+            }
+
+            #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+            {
+                if( xDNSCache[ uxIndex ].ucRefresh != 0U )
+                {
+                    xRenew = pdTRUE;
+                }
+
+                if( xRenew != pdFALSE )
+                {
+                    xDNSCache[ uxIndex ].ucRefresh = 0U;
+                    xDNSCache[ uxIndex ].ucHits = 0U;
+                }
+            }
+            #endif
+
+            #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
+                if( xRenew != pdFALSE )
+                {
+                    xDNSCache[ uxIndex ].ucNumIPAddresses = 0U;
+                }
+            #else
+                ( void ) xRenew;
+            #endif
+        }
+        #endif /* if ( ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 ) || ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 ) ) */
+
         #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
             if( xDNSCache[ uxIndex ].ucNumIPAddresses <
                 ( uint8_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY )
@@ -429,46 +844,100 @@
         ( void ) memcpy( &( xDNSCache[ uxIndex ].xAddresses[ ulIPAddressIndex ] ), pxIP, sizeof( *pxIP ) );
         xDNSCache[ uxIndex ].ulTTL = ulTTL;
         xDNSCache[ uxIndex ].ulTimeWhenAddedInSeconds = ulCurrentTimeSeconds;
+
+        #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+            vLRUHashTouch( &( xDNSHashTable ), ( BaseType_t ) uxIndex );
+        #endif
     }
 /*-----------------------------------------------------------*/
 
 /**
  * @brief insert entry in the cache
  * @param[in] pcName cache entry key
+ * @param[in] ulNameHash the hash of pcName, only used when ipconfigDNS_CACHE_HASH_BUCKETS > 0
  * @param[in] ulTTL time to live (in seconds)
  * @param[in] pxIP ip address
  * @param[in] ulCurrentTimeSeconds current time
  * @post the global structure \a xDNSCache is modified
  */
     static void prvInsertCacheEntry( const char * pcName,
+                                     uint32_t ulNameHash,
                                      uint32_t ulTTL,
                                      const IPv46_Address_t * pxIP,
                                      uint32_t ulCurrentTimeSeconds )
     {
+        UBaseType_t uxIndex = 0U;
+        BaseType_t xStored = pdFALSE;
+
         /* Add or update the item. */
         if( strlen( pcName ) < ( size_t ) ipconfigDNS_CACHE_NAME_LENGTH )
         {
-            ( void ) strncpy( xDNSCache[ uxFreeEntry ].pcName, pcName, ipconfigDNS_CACHE_NAME_LENGTH );
-            ( void ) memcpy( &( xDNSCache[ uxFreeEntry ].xAddresses[ 0 ] ), pxIP, sizeof( *pxIP ) );
+            #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+            {
+                uint16_t usNameOffset;
+
+                /* Use an entry that was never used, or else the least recently
+                 * used entry. It is kept out of the LRU list while its name is
+                 * stored, so that it will not be evicted. */
+                uxIndex = ( UBaseType_t ) xLRUHashTake( &( xDNSHashTable ) );
+                prvDNSClearEntry( uxIndex );
+                vLRUHashUnlink( &( xDNSHashTable ), ( BaseType_t ) uxIndex );
+
+                usNameOffset = prvDNSStoreName( pcName, ulNameHash );
+
+                if( usNameOffset != 0U )
+                {
+                    xDNSCache[ uxIndex ].usNameOffset = usNameOffset;
+                    xDNSCache[ uxIndex ].ulNameHash = ulNameHash;
+                    vLRUHashInsert( &( xDNSHashTable ), ulNameHash, ( BaseType_t ) uxIndex );
+                    vLRUHashTouch( &( xDNSHashTable ), ( BaseType_t ) uxIndex );
+                    xStored = pdTRUE;
+                }
+                else
+                {
+                    /* The name arena is too small for this name. */
+                    vLRUHashRelease( &( xDNSHashTable ), ( BaseType_t ) uxIndex );
+                }
+            }
+            #else /* if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) */
+            {
+                ( void ) ulNameHash;
+
+                uxIndex = uxFreeEntry;
+                ( void ) strncpy( xDNSCache[ uxIndex ].pcName, pcName, ipconfigDNS_CACHE_NAME_LENGTH );
 
-            xDNSCache[ uxFreeEntry ].ulTTL = ulTTL;
-            xDNSCache[ uxFreeEntry ].ulTimeWhenAddedInSeconds = ulCurrentTimeSeconds;
+                uxFreeEntry++;
+
+                if( uxFreeEntry == ipconfigDNS_CACHE_ENTRIES )
+                {
+                    uxFreeEntry = 0;
+                }
+
+                xStored = pdTRUE;
+            }
+            #endif /* if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) */
+        }
+
+        if( xStored != pdFALSE )
+        {
+            ( void ) memcpy( &( xDNSCache[ uxIndex ].xAddresses[ 0 ] ), pxIP, sizeof( *pxIP ) );
+
+            xDNSCache[ uxIndex ].ulTTL = ulTTL;
+            xDNSCache[ uxIndex ].ulTimeWhenAddedInSeconds = ulCurrentTimeSeconds;
+            #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+                xDNSCache[ uxIndex ].ucHits = 0U;
+                xDNSCache[ uxIndex ].ucRefresh = 0U;
+            #endif
             #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
-                xDNSCache[ uxFreeEntry ].ucNumIPAddresses = 1;
-                xDNSCache[ uxFreeEntry ].ucCurrentIPAddress = 0;
+                xDNSCache[ uxIndex ].ucNumIPAddresses = 1;
+                xDNSCache[ uxIndex ].ucCurrentIPAddress = 0;
 
                 /* Initialize all remaining IP addresses in this entry to 0 */
-                ( void ) memset( &xDNSCache[ uxFreeEntry ].xAddresses[ 1 ],
+                ( void ) memset( &xDNSCache[ uxIndex ].xAddresses[ 1 ],
                                  0,
-                                 sizeof( xDNSCache[ uxFreeEntry ].xAddresses[ 1 ] ) *
+                                 sizeof( xDNSCache[ uxIndex ].xAddresses[ 1 ] ) *
                                  ( ( uint32_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY - 1U ) );
             #endif
-            uxFreeEntry++;
-
-            if( uxFreeEntry == ipconfigDNS_CACHE_ENTRIES )
-            {
-                uxFreeEntry = 0;
-            }
         }
     }
 /*-----------------------------------------------------------*/
@@ -507,14 +976,14 @@
                     case pdFALSE:
                        {
                            const uint8_t * ucBytes = ( const uint8_t * ) &( pxAddresses->xIPAddress.ulIP_IPv4 );
-                           pxNewAddress = pxNew_AddrInfo( xDNSCache[ uxIndex ].pcName, FREERTOS_AF_INET4, ucBytes );
+                           pxNewAddress = pxNew_AddrInfo( prvEntryName( ( UBaseType_t ) uxIndex ), FREERTOS_AF_INET4, ucBytes );
                        }
                        break;
                 #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
                 #if ( ipconfigUSE_IPv6 != 0 )
                     case pdTRUE:
-                        pxNewAddress = pxNew_AddrInfo( xDNSCache[ uxIndex ].pcName, FREERTOS_AF_INET6, pxAddresses->xIPAddress.xIP_IPv6.ucBytes );
+                        pxNewAddress = pxNew_AddrInfo( prvEntryName( ( UBaseType_t ) uxIndex ), FREERTOS_AF_INET6, pxAddresses->xIPAddress.xIP_IPv6.ucBytes );
                         break;
                 #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
@@ -615,6 +1084,185 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 )
+
+/**
+ * @brief Lookup the given hostname in the DNS cache, also accepting an entry
+ *        whose TTL expired less than ipconfigDNS_CACHE_SERVE_STALE_SECONDS ago.
+ *        To be used only when no DNS server answered a query for the name.
+ * @param[in] pcHostName The host name to lookup
+ * @param[in] xFamily IP type FREERTOS_AF_INET6 / FREERTOS_AF_INET4
+ * @param[out] ppxAddressInfo Target to store the DNS entries.
+ * @returns This function returns either a valid IPv4 address, or
+ *                          in case of an IPv6 lookup, it will return a non-zero.
+ */
+        uint32_t Prepare_StaleCacheLookup( const char * pcHostName,
+                                           BaseType_t xFamily,
+                                           struct freertos_addrinfo ** ppxAddressInfo )
+        {
+            uint32_t ulIPAddress = 0U;
+            IPv46_Address_t xIPv46_Address;
+            UBaseType_t uxIndex = 0U;
+            uint32_t ulNameHash = 0U;
+            uint32_t ulCurrentTimeSeconds = ( uint32_t ) ( xTaskGetTickCount() / configTICK_RATE_HZ );
+
+            ( void ) memset( &( xIPv46_Address ), 0, sizeof( xIPv46_Address ) );
+            xIPv46_Address.xIs_IPv6 = ( xFamily == FREERTOS_AF_INET6 ) ? pdTRUE : pdFALSE;
+
+            #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+            {
+                ulNameHash = prvDNSNameHash( pcHostName );
+            }
+            #endif
+
+            if( ( prvFindEntryIndex( pcHostName, ulNameHash, &( xIPv46_Address ), &( uxIndex ) ) == pdTRUE ) &&
+                ( prvGetCacheIPEntry( uxIndex, &( xIPv46_Address ), ulCurrentTimeSeconds, ppxAddressInfo, pdTRUE ) == pdTRUE ) )
+            {
+                if( xIPv46_Address.xIs_IPv6 != pdFALSE )
+                {
+                    ulIPAddress = 1U;
+                }
+                else
+                {
+                    ulIPAddress = xIPv46_Address.xIPAddress.ulIP_IPv4;
+                }
+
+                FreeRTOS_debug_printf( ( "Prepare_StaleCacheLookup: serving an expired entry of '%s'\n", pcHostName ) );
+            }
+
+            return ulIPAddress;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Read all addresses of a host name from the DNS cache, also accepting
+ *        an entry whose TTL expired less than ipconfigDNS_CACHE_SERVE_STALE_SECONDS
+ *        ago. Used by the resolver when no DNS server answered a query for the
+ *        name, no memory is allocated.
+ * @param[in] pcHostName The host name to lookup
+ * @param[in] xFamily IP type FREERTOS_AF_INET6 / FREERTOS_AF_INET4
+ * @param[out] pxRecords Array that receives the addresses, with a TTL of zero.
+ * @param[in] uxMaxRecords The number of elements in pxRecords.
+ * @returns The number of addresses stored in pxRecords.
+ */
+        size_t uxDNSCacheReadStale( const char * pcHostName,
+                                    BaseType_t xFamily,
+                                    DNSAddressRecord_t * pxRecords,
+                                    size_t uxMaxRecords )
+        {
+            size_t uxCount = 0U;
+            IPv46_Address_t xIPv46_Address;
+            UBaseType_t uxIndex = 0U;
+            uint32_t ulNameHash = 0U;
+            uint32_t ulCurrentTimeSeconds = ( uint32_t ) ( xTaskGetTickCount() / configTICK_RATE_HZ );
+
+            ( void ) memset( &( xIPv46_Address ), 0, sizeof( xIPv46_Address ) );
+            xIPv46_Address.xIs_IPv6 = ( xFamily == FREERTOS_AF_INET6 ) ? pdTRUE : pdFALSE;
+
+            #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+            {
+                ulNameHash = prvDNSNameHash( pcHostName );
+            }
+            #endif
+
+            if( ( prvFindEntryIndex( pcHostName, ulNameHash, &( xIPv46_Address ), &( uxIndex ) ) == pdTRUE ) &&
+                ( prvGetCacheIPEntry( uxIndex, &( xIPv46_Address ), ulCurrentTimeSeconds, NULL, pdTRUE ) == pdTRUE ) )
+            {
+                size_t uxNumIPAddresses = 1U;
+
+                #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
+                    uxNumIPAddresses = ( size_t ) xDNSCache[ uxIndex ].ucNumIPAddresses;
+                #endif
+
+                while( ( uxCount < uxNumIPAddresses ) &&
+                       ( uxCount < uxMaxRecords ) &&
+                       ( uxCount < ( size_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY ) )
+                {
+                    pxRecords[ uxCount ].xAddress = xDNSCache[ uxIndex ].xAddresses[ uxCount ];
+                    pxRecords[ uxCount ].ulTTL = 0U;
+                    uxCount++;
+                }
+
+                FreeRTOS_debug_printf( ( "uxDNSCacheReadStale: serving an expired entry of '%s'\n", pcHostName ) );
+            }
+
+            return uxCount;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* if ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 ) */
+
+    #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+
+/**
+ * @brief Start the refreshes that were asked for by look-ups in the DNS cache.
+ *        Called by the IP-task.
+ */
+        void vDNSCacheStartRefreshes( void )
+        {
+            UBaseType_t uxIndex;
+
+            if( xDNSRefreshWanted != pdFALSE )
+            {
+                xDNSRefreshWanted = pdFALSE;
+
+                for( uxIndex = 0U; uxIndex < ( UBaseType_t ) ipconfigDNS_CACHE_ENTRIES; uxIndex++ )
+                {
+                    if( xDNSCache[ uxIndex ].ucRefresh == dnsCACHE_REFRESH_WANTED )
+                    {
+                        BaseType_t xFamily = ( xDNSCache[ uxIndex ].xAddresses[ 0 ].xIs_IPv6 != pdFALSE ) ? FREERTOS_AF_INET6 : FREERTOS_AF_INET4;
+
+                        /* Set before the refresh starts, because a refresh that
+                         * fails immediately calls vDNSCacheRefreshDone(). */
+                        xDNSCache[ uxIndex ].ucRefresh = dnsCACHE_REFRESH_ACTIVE;
+
+                        if( xDNSResolverPrefetch( prvEntryName( uxIndex ), xFamily ) != pdPASS )
+                        {
+                            xDNSCache[ uxIndex ].ucRefresh = 0U;
+                        }
+                    }
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A refresh of the DNS cache has finished. When no answer has updated
+ *        the entry, it is still marked as being refreshed: clear the mark so
+ *        that a later look-up can try again.
+ *
+ * @param[in] pcName The host name of the entry.
+ */
+        void vDNSCacheRefreshDone( const char * pcName )
+        {
+            IPv46_Address_t xIPv46_Address;
+            UBaseType_t uxIndex = 0U;
+            uint32_t ulNameHash = 0U;
+            BaseType_t xIsIPv6;
+
+            #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+            {
+                ulNameHash = prvDNSNameHash( pcName );
+            }
+            #endif
+
+            ( void ) memset( &( xIPv46_Address ), 0, sizeof( xIPv46_Address ) );
+
+            for( xIsIPv6 = pdFALSE; xIsIPv6 <= pdTRUE; xIsIPv6++ )
+            {
+                xIPv46_Address.xIs_IPv6 = xIsIPv6;
+
+                if( ( prvFindEntryIndex( pcName, ulNameHash, &( xIPv46_Address ), &( uxIndex ) ) == pdTRUE ) &&
+                    ( xDNSCache[ uxIndex ].ucRefresh == dnsCACHE_REFRESH_ACTIVE ) )
+                {
+                    xDNSCache[ uxIndex ].ucRefresh = 0U;
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 ) */
+
     #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
 
 /**
@@ -629,11 +1277,11 @@
             {
                 const DNSCacheRow_t * pxRow = &( xDNSCache[ xEntry ] );
 
-                if( pxRow->pcName[ 0 ] != ( char ) 0 )
+                if( prvEntryName( xEntry )[ 0 ] != ( char ) 0 )
                 {
                     FreeRTOS_printf( ( "Entry %2u: %s use %u/%u\n",
                                        ( unsigned ) xEntry,
-                                       pxRow->pcName,
+                                       prvEntryName( xEntry ),
                                        ( unsigned ) pxRow->ucCurrentIPAddress,
                                        ( unsigned ) pxRow->ucNumIPAddresses ) );
 
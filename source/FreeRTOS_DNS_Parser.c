@@ -47,6 +47,279 @@
 
 #if ( ipconfigUSE_DNS != 0 )
 
+/**
+ * @brief Walk over a name field in a DNS message. Depending on the parameters,
+ *        the name is only skipped, converted to the dotted notation, or compared
+ *        with a name in dotted notation. This is the only function that reads
+ *        the labels of a name.
+ *
+ *        When the name is converted or compared, compression pointers are
+ *        followed. Every pointer must point before the previous one, so a
+ *        hostile message can not make the walk loop. When the name is only
+ *        skipped, a pointer just ends the name field, and the label types
+ *        are not checked.
+ *
+ * @param[in] pucMessage The DNS message.
+ * @param[in] uxLength The length of the DNS message.
+ * @param[in] uxOffset The offset of the name field in the message.
+ * @param[out] pcName Where the name is stored, or NULL.
+ * @param[in] uxNameSize The size of pcName, including the terminating zero.
+ * @param[in] pcCompare A name in dotted notation to compare with, ignoring
+ *                      case, or NULL.
+ * @param[out] pxMatch Receives pdTRUE when the name is equal to pcCompare.
+ *
+ * @return The offset of the first byte after the name field, or zero when the
+ *         name is malformed or does not fit in pcName.
+ */
+    static size_t prvDNSNameWalk( const uint8_t * pucMessage,
+                                  size_t uxLength,
+                                  size_t uxOffset,
+                                  char * pcName,
+                                  size_t uxNameSize,
+                                  const char * pcCompare,
+                                  BaseType_t * pxMatch )
+    {
+        size_t uxIndex = uxOffset;
+        size_t uxLimit = uxOffset;
+        size_t uxNext = 0U;
+        size_t uxOutput = 0U;
+        size_t uxReturn = 0U;
+        BaseType_t xFollow = ( ( pcName != NULL ) || ( pcCompare != NULL ) ) ? pdTRUE : pdFALSE;
+        BaseType_t xMatch = ( pcCompare != NULL ) ? pdTRUE : pdFALSE;
+
+        while( uxIndex < uxLength )
+        {
+            size_t uxLabelLength = ( size_t ) pucMessage[ uxIndex ];
+
+            if( uxLabelLength == 0U )
+            {
+                /* The root label ends the name. */
+                if( uxNext == 0U )
+                {
+                    uxNext = uxIndex + 1U;
+                }
+
+                if( pcName != NULL )
+                {
+                    pcName[ uxOutput ] = '\0';
+                }
+
+                if( ( xMatch != pdFALSE ) && ( pcCompare[ uxOutput ] != ( char ) 0 ) )
+                {
+                    xMatch = pdFALSE;
+                }
+
+                uxReturn = uxNext;
+                break;
+            }
+            else if( ( pucMessage[ uxIndex ] & dnsNAME_IS_OFFSET ) == dnsNAME_IS_OFFSET )
+            {
+                size_t uxTarget;
+
+                if( ( uxIndex + 1U ) >= uxLength )
+                {
+                    break;
+                }
+
+                if( uxNext == 0U )
+                {
+                    uxNext = uxIndex + 2U;
+                }
+
+                if( xFollow == pdFALSE )
+                {
+                    uxReturn = uxNext;
+                    break;
+                }
+
+                uxTarget = ( ( uxLabelLength & 0x3FU ) << 8 ) | ( size_t ) pucMessage[ uxIndex + 1U ];
+
+                if( uxTarget >= uxLimit )
+                {
+                    break;
+                }
+
+                uxLimit = uxTarget;
+                uxIndex = uxTarget;
+            }
+            else if( ( xFollow != pdFALSE ) && ( ( pucMessage[ uxIndex ] & dnsNAME_IS_OFFSET ) != 0U ) )
+            {
+                /* The label types 0x40 and 0x80 can not be decoded. */
+                break;
+            }
+            else
+            {
+                size_t uxChar;
+
+                /* The output always has room for the separator, because the
+                 * previous label left room for the terminating zero. */
+                if( ( xFollow != pdFALSE ) && ( uxOutput != 0U ) )
+                {
+                    if( pcName != NULL )
+                    {
+                        pcName[ uxOutput ] = '.';
+                    }
+
+                    if( ( xMatch != pdFALSE ) && ( pcCompare[ uxOutput ] != '.' ) )
+                    {
+                        xMatch = pdFALSE;
+                    }
+
+                    uxOutput++;
+                }
+
+                if( ( uxIndex + 1U + uxLabelLength ) > uxLength )
+                {
+                    break;
+                }
+
+                if( xFollow != pdFALSE )
+                {
+                    /* Room is needed for the label and the terminating zero. */
+                    if( ( pcName != NULL ) && ( ( uxOutput + uxLabelLength ) >= uxNameSize ) )
+                    {
+                        break;
+                    }
+
+                    for( uxChar = 0U; uxChar < uxLabelLength; uxChar++ )
+                    {
+                        uint8_t ucChar = pucMessage[ uxIndex + 1U + uxChar ];
+
+                        if( pcName != NULL )
+                        {
+                            pcName[ uxOutput ] = ( char ) ucChar;
+                        }
+
+                        /* A mismatch stops the comparison, so pcCompare is never
+                         * read beyond its terminating zero. */
+                        if( ( xMatch != pdFALSE ) &&
+                            ( ( pcCompare[ uxOutput ] == ( char ) 0 ) ||
+                              ( DNS_LowerCase( ucChar ) != DNS_LowerCase( ( uint8_t ) pcCompare[ uxOutput ] ) ) ) )
+                        {
+                            xMatch = pdFALSE;
+                        }
+
+                        uxOutput++;
+                    }
+                }
+
+                uxIndex += uxLabelLength + 1U;
+            }
+        }
+
+        if( pxMatch != NULL )
+        {
+            *pxMatch = ( uxReturn != 0U ) ? xMatch : pdFALSE;
+        }
+
+        return uxReturn;
+    }
+
+
+/**
+ * @brief Convert an upper-case ASCII letter to lower-case. Host names are
+ *        compared and hashed without regard to case.
+ *
+ * @param[in] ucChar The character.
+ *
+ * @return The lower-case character, other characters are returned unchanged.
+ */
+    uint8_t DNS_LowerCase( uint8_t ucChar )
+    {
+        uint8_t ucResult = ucChar;
+
+        if( ( ucChar >= ( uint8_t ) 'A' ) && ( ucChar <= ( uint8_t ) 'Z' ) )
+        {
+            ucResult = ( uint8_t ) ( ucChar + ( ( uint8_t ) 'a' - ( uint8_t ) 'A' ) );
+        }
+
+        return ucResult;
+    }
+
+
+/**
+ * @brief Compare two names in dotted notation, without regard to case.
+ *
+ * @param[in] pcName1 The first name.
+ * @param[in] pcName2 The second name.
+ *
+ * @return pdTRUE when the names are equal.
+ */
+    BaseType_t DNS_NameEqual( const char * pcName1,
+                              const char * pcName2 )
+    {
+        BaseType_t xReturn = pdTRUE;
+        size_t uxIndex = 0U;
+
+        for( ; ; )
+        {
+            uint8_t ucChar1 = DNS_LowerCase( ( uint8_t ) pcName1[ uxIndex ] );
+
+            if( ucChar1 != DNS_LowerCase( ( uint8_t ) pcName2[ uxIndex ] ) )
+            {
+                xReturn = pdFALSE;
+                break;
+            }
+
+            if( ucChar1 == 0U )
+            {
+                break;
+            }
+
+            uxIndex++;
+        }
+
+        return xReturn;
+    }
+
+
+/**
+ * @brief Read a name from a DNS message, following compression pointers, and
+ *        convert it to the dotted notation.
+ *
+ * @param[in] pucMessage The DNS message.
+ * @param[in] uxLength The length of the message.
+ * @param[in] uxOffset The offset of the name field in the message.
+ * @param[out] pcName Where the name will be stored. When NULL, the name field
+ *                    is only checked and skipped.
+ * @param[in] uxNameSize The size of pcName.
+ *
+ * @return The offset of the first byte after the name field, or zero when the
+ *         name is malformed or too long.
+ */
+    size_t DNS_ReadName( const uint8_t * pucMessage,
+                         size_t uxLength,
+                         size_t uxOffset,
+                         char * pcName,
+                         size_t uxNameSize )
+    {
+        return prvDNSNameWalk( pucMessage, uxLength, uxOffset, pcName, uxNameSize, NULL, NULL );
+    }
+
+
+/**
+ * @brief Compare a name in a DNS message with a name in dotted notation,
+ *        without regard to case and without copying the name.
+ *
+ * @param[in] pucMessage The DNS message.
+ * @param[in] uxLength The length of the message.
+ * @param[in] uxOffset The offset of the name field in the message.
+ * @param[in] pcCompare The name in dotted notation.
+ * @param[out] pxMatch Receives pdTRUE when the names are equal.
+ *
+ * @return The offset of the first byte after the name field, or zero when the
+ *         name is malformed.
+ */
+    size_t DNS_MatchName( const uint8_t * pucMessage,
+                          size_t uxLength,
+                          size_t uxOffset,
+                          const char * pcCompare,
+                          BaseType_t * pxMatch )
+    {
+        return prvDNSNameWalk( pucMessage, uxLength, uxOffset, NULL, 0U, pcCompare, pxMatch );
+    }
+
+
     #if ( ( ipconfigUSE_DNS_CACHE != 0 ) || ( ipconfigDNS_USE_CALLBACKS != 0 ) || ( ipconfigUSE_MDNS != 0 ) || ( ipconfigUSE_LLMNR != 0 ) )
 
 /**
@@ -60,15 +333,10 @@
         size_t DNS_ReadNameField( ParseSet_t * pxSet,
                                   size_t uxDestLen )
         {
-            size_t uxNameLen = 0U;
             size_t uxIndex = 0U;
             size_t uxSourceLen = pxSet->uxSourceBytesRemaining;
             const uint8_t * pucByte = pxSet->pucByte;
 
-            /* uxCount gets the values from pucByte and counts down to 0.
-             * No need to have a different type than that of pucByte */
-            size_t uxCount;
-
             if( uxSourceLen == ( size_t ) 0U )
             {
                 /* Return 0 value in case of error. */
@@ -79,7 +347,7 @@
              * elsewhere in the message. */
             else if( ( pucByte[ uxIndex ] & dnsNAME_IS_OFFSET ) == dnsNAME_IS_OFFSET )
             {
-                /* Jump over the two byte offset. */
+                /* Jump over the two byte offset, the name is not read. */
                 if( uxSourceLen > sizeof( uint16_t ) )
                 {
                     uxIndex += sizeof( uint16_t );
@@ -89,80 +357,33 @@
                     uxIndex = 0U;
                 }
             }
-            else
+            else if( pucByte[ uxIndex ] == 0U )
             {
-                /* 'uxIndex' points to the full name. Walk over the string. */
-                while( ( uxIndex < uxSourceLen ) && ( pucByte[ uxIndex ] != ( uint8_t ) 0x00U ) )
-                {
-                    /* If this is not the first time through the loop, then add a
-                     * separator in the output. */
-                    if( ( uxNameLen > 0U ) )
-                    {
-                        /*
-                         * uxNameLen can never be greater than uxDestLen, since there are checks
-                         * outside this condition, so the check is removed.
-                         */
-                        pxSet->pcName[ uxNameLen ] = '.';
-                        uxNameLen++;
-                    }
-
-                    /* Process the first/next sub-string. */
-                    uxCount = ( size_t ) pucByte[ uxIndex ];
-
-                    /* uxIndex should point to the first character now, unless uxCount
-                     * is an offset field. */
-                    uxIndex++;
-
-                    if( ( uxIndex + uxCount ) > uxSourceLen )
-                    {
-                        uxIndex = 0U;
-                        break;
-                    }
-
-                    if( ( uxNameLen + uxCount ) >= uxDestLen )
-                    {
-                        uxIndex = 0U;
-                        break;
-                    }
-
-                    while( uxCount-- != 0U )
-                    {
-                        /*
-                         * uxNameLen can never be greater than uxDestLen, since there are checks
-                         * outside this condition, so the check is removed.
-                         */
-                        pxSet->pcName[ uxNameLen ] = ( char ) pucByte[ uxIndex ];
-                        uxNameLen++;
-                        uxIndex++;
-                    }
-                }
+                /* An empty name is not accepted. */
+                uxIndex = 0U;
+            }
+            else if( pxSet->pucUDPPayloadBuffer != NULL )
+            {
+                /* Read the name within the whole message, so that a compressed
+                 * suffix can be followed. */
+                size_t uxOffset = ( size_t ) ( pucByte - pxSet->pucUDPPayloadBuffer );
+                size_t uxResult = DNS_ReadName( pxSet->pucUDPPayloadBuffer, uxOffset + uxSourceLen, uxOffset, pxSet->pcName, uxDestLen );
 
-                /* Confirm that a fully formed name was found. */
-                if( uxIndex > 0U )
+                if( uxResult != 0U )
                 {
-                    /* Here, there is no need to check for pucByte[ uxindex ] == 0 because:
-                     * When we break out of the above while loop, uxIndex is made 0 thereby
-                     * failing above check. Whenever we exit the loop otherwise, either
-                     * pucByte[ uxIndex ] == 0 (which makes the check here unnecessary) or
-                     * uxIndex >= uxSourceLen (which makes sure that we do not go in the 'if'
-                     * case).
-                     */
-                    if( uxIndex < uxSourceLen )
-                    {
-                        pxSet->pcName[ uxNameLen ] = '\0';
-                        uxIndex++;
-                    }
-                    else
-                    {
-                        uxIndex = 0U;
-                    }
+                    uxIndex = uxResult - uxOffset;
                 }
             }
+            else
+            {
+                uxIndex = DNS_ReadName( pucByte, uxSourceLen, 0U, pxSet->pcName, uxDestLen );
+            }
 
             return uxIndex;
         }
     #endif /* ipconfigUSE_DNS_CACHE || ipconfigDNS_USE_CALLBACKS || ipconfigUSE_MDNS || ipconfigUSE_LLMNR */
 
+
 /**
  * @brief Simple routine that jumps over the NAME field of a resource record.
  *
@@ -174,11 +395,9 @@
     size_t DNS_SkipNameField( const uint8_t * pucByte,
                               size_t uxLength )
     {
-        size_t uxChunkLength;
-        size_t uxSourceLenCpy = uxLength;
         size_t uxIndex = 0U;
 
-        if( uxSourceLenCpy == 0U )
+        if( uxLength == 0U )
         {
             uxIndex = 0U;
         }
@@ -188,7 +407,7 @@
         else if( ( pucByte[ uxIndex ] & dnsNAME_IS_OFFSET ) == dnsNAME_IS_OFFSET )
         {
             /* Jump over the two byte offset. */
-            if( uxSourceLenCpy > sizeof( uint16_t ) )
+            if( uxLength > sizeof( uint16_t ) )
             {
                 uxIndex += sizeof( uint16_t );
             }
@@ -197,44 +416,277 @@
                 uxIndex = 0U;
             }
         }
+        else if( pucByte[ uxIndex ] == 0U )
+        {
+            /* An empty name is not accepted. */
+            uxIndex = 0U;
+        }
         else
         {
-            /* pucByte points to the full name. Walk over the string. */
-            while( ( pucByte[ uxIndex ] != 0U ) && ( uxSourceLenCpy > 1U ) )
+            uxIndex = DNS_ReadName( pucByte, uxLength, 0U, NULL, 0U );
+        }
+
+        return uxIndex;
+    }
+
+/**
+ * @brief Parse the reply of a DNS server in a single pass over the message,
+ *        without allocating memory. The header and all questions and answers
+ *        are validated while the A and AAAA records are extracted.
+ *
+ *        Only the answers that belong to the name that was asked are used.
+ *        A CNAME record of that name changes the name that is expected in the
+ *        following answers, so a chain of aliases is followed in the order in
+ *        which the server lists it. Other answers are skipped.
+ *
+ * @param[in] pucUDPPayloadBuffer The DNS message received as a UDP payload.
+ * @param[in] uxBufferLength Length of the UDP payload.
+ * @param[in] pcExpectedName The name that was looked up, which must be equal to
+ *                           the first question and the owner of the answers.
+ *                           Or NULL when the names do not have to be checked.
+ * @param[out] pxRecords Array that receives the addresses that are found.
+ * @param[in] uxMaxRecords The number of elements in pxRecords. Addresses that
+ *                         do not fit are skipped.
+ *
+ * @return The number of addresses stored in pxRecords, which is zero for a
+ *         response that indicates an error, like a non-existing domain. Or
+ *         -pdFREERTOS_ERRNO_EINVAL when the message is malformed, is not a
+ *         response, or does not answer pcExpectedName.
+ */
+    BaseType_t DNS_ParseAddressRecords( const uint8_t * pucUDPPayloadBuffer,
+                                        size_t uxBufferLength,
+                                        const char * pcExpectedName,
+                                        DNSAddressRecord_t * pxRecords,
+                                        size_t uxMaxRecords )
+    {
+        BaseType_t xReturn = 0;
+        BaseType_t xValid = pdFALSE;
+        size_t uxOffset = sizeof( DNSMessage_t );
+        size_t uxCount = 0U;
+        char pcAlias[ ipconfigDNS_CACHE_NAME_LENGTH ];
+        const char * pcOwner = pcExpectedName;
+
+        if( uxBufferLength >= sizeof( DNSMessage_t ) )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const DNSMessage_t * pxDNSMessageHeader = ( ( const DNSMessage_t * ) pucUDPPayloadBuffer );
+            uint16_t usFlags = FreeRTOS_ntohs( pxDNSMessageHeader->usFlags );
+            uint16_t usQuestions = FreeRTOS_ntohs( pxDNSMessageHeader->usQuestions );
+            uint16_t usAnswers = FreeRTOS_ntohs( pxDNSMessageHeader->usAnswers );
+            uint16_t x;
+
+            if( ( ( usFlags & dnsFLAGS_RESPONSE ) != 0U ) &&
+                ( ( pcExpectedName == NULL ) || ( usQuestions != 0U ) ) )
+            {
+                xValid = pdTRUE;
+            }
+
+            for( x = 0U; ( x < usQuestions ) && ( xValid != pdFALSE ); x++ )
             {
-                /* Conversion to size_t causes addition to be done
-                 * in size_t */
-                uxChunkLength = ( ( size_t ) pucByte[ uxIndex ] ) + 1U;
+                BaseType_t xMatch = pdFALSE;
 
-                if( uxSourceLenCpy > uxChunkLength )
+                if( ( x == 0U ) && ( pcExpectedName != NULL ) )
                 {
-                    uxSourceLenCpy -= uxChunkLength;
-                    uxIndex += uxChunkLength;
+                    uxOffset = DNS_MatchName( pucUDPPayloadBuffer, uxBufferLength, uxOffset, pcExpectedName, &( xMatch ) );
                 }
                 else
                 {
-                    uxIndex = 0U;
-                    break;
+                    uxOffset = DNS_ReadName( pucUDPPayloadBuffer, uxBufferLength, uxOffset, NULL, 0U );
+                    xMatch = pdTRUE;
+                }
+
+                /* Jump over the type and class fields. */
+                if( ( uxOffset == 0U ) || ( xMatch == pdFALSE ) || ( ( uxOffset + sizeof( uint32_t ) ) > uxBufferLength ) )
+                {
+                    xValid = pdFALSE;
+                }
+                else
+                {
+                    uxOffset += sizeof( uint32_t );
                 }
             }
 
-            /* Confirm that a fully formed name was found. */
-            if( uxIndex > 0U )
+            if( ( usFlags & dnsFLAGS_RCODE_MASK ) != 0U )
             {
-                if( pucByte[ uxIndex ] == 0U )
+                /* The server has answered, but without addresses. */
+                usAnswers = 0U;
+            }
+
+            for( x = 0U; ( x < usAnswers ) && ( xValid != pdFALSE ); x++ )
+            {
+                uint16_t usType;
+                uint16_t usClass;
+                uint16_t usDataLength;
+                uint32_t ulTTL;
+                BaseType_t xMatch = pdTRUE;
+
+                if( pcOwner != NULL )
                 {
-                    uxIndex++;
+                    uxOffset = DNS_MatchName( pucUDPPayloadBuffer, uxBufferLength, uxOffset, pcOwner, &( xMatch ) );
                 }
                 else
                 {
-                    uxIndex = 0U;
+                    uxOffset = DNS_ReadName( pucUDPPayloadBuffer, uxBufferLength, uxOffset, NULL, 0U );
                 }
+
+                if( ( uxOffset == 0U ) || ( ( uxOffset + sizeof( DNSAnswerRecord_t ) ) > uxBufferLength ) )
+                {
+                    xValid = pdFALSE;
+                    break;
+                }
+
+                /* The fields of the record header are read byte by byte, as
+                 * they may not be aligned. */
+                usType = usChar2u16( &( pucUDPPayloadBuffer[ uxOffset ] ) );
+                usClass = usChar2u16( &( pucUDPPayloadBuffer[ uxOffset + 2U ] ) );
+                ulTTL = ulChar2u32( &( pucUDPPayloadBuffer[ uxOffset + 4U ] ) );
+                usDataLength = usChar2u16( &( pucUDPPayloadBuffer[ uxOffset + 8U ] ) );
+                uxOffset += sizeof( DNSAnswerRecord_t );
+
+                if( ( uxOffset + ( size_t ) usDataLength ) > uxBufferLength )
+                {
+                    xValid = pdFALSE;
+                    break;
+                }
+
+                if( ( xMatch == pdFALSE ) || ( usClass != ( uint16_t ) dnsCLASS_IN ) )
+                {
+                    /* An answer for another name, or of another class. */
+                }
+                else if( usType == ( uint16_t ) dnsTYPE_CNAME )
+                {
+                    /* The target of the alias is read within the record data,
+                     * compressed suffixes may point before it. An alias that
+                     * can not be read is ignored. */
+                    if( ( pcOwner != NULL ) &&
+                        ( DNS_ReadName( pucUDPPayloadBuffer, uxOffset + ( size_t ) usDataLength, uxOffset, pcAlias, sizeof( pcAlias ) ) != 0U ) )
+                    {
+                        pcOwner = pcAlias;
+                    }
+                }
+                else if( uxCount < uxMaxRecords )
+                {
+                    DNSAddressRecord_t * pxRecord = &( pxRecords[ uxCount ] );
+
+                    if( ( usType == ( uint16_t ) dnsTYPE_A_HOST ) && ( usDataLength == ( uint16_t ) ipSIZE_OF_IPv4_ADDRESS ) )
+                    {
+                        ( void ) memcpy( &( pxRecord->xAddress.xIPAddress.ulIP_IPv4 ), &( pucUDPPayloadBuffer[ uxOffset ] ), ipSIZE_OF_IPv4_ADDRESS );
+
+                        /* Responses containing an IP of 0.0.0.0 are ignored. */
+                        if( pxRecord->xAddress.xIPAddress.ulIP_IPv4 != 0U )
+                        {
+                            pxRecord->xAddress.xIs_IPv6 = pdFALSE;
+                            pxRecord->ulTTL = ulTTL;
+                            uxCount++;
+                        }
+                    }
+                    else if( ( usType == ( uint16_t ) dnsTYPE_AAAA_HOST ) && ( usDataLength == ( uint16_t ) ipSIZE_OF_IPv6_ADDRESS ) )
+                    {
+                        ( void ) memcpy( pxRecord->xAddress.xIPAddress.xIP_IPv6.ucBytes, &( pucUDPPayloadBuffer[ uxOffset ] ), ipSIZE_OF_IPv6_ADDRESS );
+                        pxRecord->xAddress.xIs_IPv6 = pdTRUE;
+                        pxRecord->ulTTL = ulTTL;
+                        uxCount++;
+                    }
+                    else
+                    {
+                        /* Other records are skipped. */
+                    }
+                }
+                else
+                {
+                    /* pxRecords is full. */
+                }
+
+                uxOffset += ( size_t ) usDataLength;
             }
         }
 
-        return uxIndex;
+        if( xValid != pdFALSE )
+        {
+            xReturn = ( BaseType_t ) uxCount;
+        }
+        else
+        {
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+
+        return xReturn;
+    }
+
+/**
+ * @brief Create a list of addresses, as returned by FreeRTOS_getaddrinfo(), from
+ *        the addresses found by DNS_ParseAddressRecords().
+ *
+ * @param[in] pcName The host name to be stored in the list.
+ * @param[in] pxRecords The addresses found.
+ * @param[in] uxCount The number of addresses in pxRecords.
+ *
+ * @return The list, which may be incomplete when running out of memory.
+ */
+    struct freertos_addrinfo * DNS_AddressRecordsToList( const char * pcName,
+                                                         const DNSAddressRecord_t * pxRecords,
+                                                         size_t uxCount )
+    {
+        struct freertos_addrinfo * pxFirst = NULL;
+        struct freertos_addrinfo ** ppxLast = &( pxFirst );
+        size_t uxIndex;
+
+        for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+        {
+            const IPv46_Address_t * pxAddress = &( pxRecords[ uxIndex ].xAddress );
+
+            if( pxAddress->xIs_IPv6 != pdFALSE )
+            {
+                *ppxLast = pxNew_AddrInfo( pcName, FREERTOS_AF_INET6, pxAddress->xIPAddress.xIP_IPv6.ucBytes );
+            }
+            else
+            {
+                *ppxLast = pxNew_AddrInfo( pcName, FREERTOS_AF_INET4, ( const uint8_t * ) &( pxAddress->xIPAddress.ulIP_IPv4 ) );
+            }
+
+            if( *ppxLast == NULL )
+            {
+                break;
+            }
+
+            ppxLast = &( ( *ppxLast )->ai_next );
+        }
+
+        return pxFirst;
     }
 
+    #if ( ipconfigUSE_DNS_CACHE == 1 )
+
+/**
+ * @brief Store the addresses found by DNS_ParseAddressRecords() in the DNS
+ *        cache. Only to be used for a reply that was expected.
+ *
+ * @param[in] pcName The host name that was looked up.
+ * @param[in] pxRecords The addresses found.
+ * @param[in] uxCount The number of addresses in pxRecords.
+ */
+        void DNS_StoreAddressRecords( const char * pcName,
+                                      const DNSAddressRecord_t * pxRecords,
+                                      size_t uxCount )
+        {
+            size_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+            {
+                IPv46_Address_t xAddress = pxRecords[ uxIndex ].xAddress;
+
+                /* The cache keeps the TTL as network-endian. */
+                ( void ) FreeRTOS_dns_update( pcName,
+                                              &( xAddress ),
+                                              FreeRTOS_htonl( pxRecords[ uxIndex ].ulTTL ),
+                                              pdFALSE,
+                                              NULL );
+            }
+        }
+    #endif /* ipconfigUSE_DNS_CACHE == 1 */
+
 /**
  * @brief Process a response packet from a DNS server, or an LLMNR reply.
  *
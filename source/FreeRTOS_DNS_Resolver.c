@@ -0,0 +1,1040 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_DNS_Resolver.c
+ * @brief Implements an asynchronous DNS resolver that runs in the IP-task.
+ *
+ * All look-ups share a single UDP socket. A look-up needs a query for each
+ * address family that is requested. Look-ups of the same name and family
+ * share a single query, which is retransmitted by the resolver timer.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Timers.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_DNS.h"
+#include "FreeRTOS_DNS_Globals.h"
+#include "FreeRTOS_DNS_Cache.h"
+#include "FreeRTOS_DNS_Parser.h"
+
+#if ( ( ipconfigUSE_DNS != 0 ) && ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+
+/** @brief The period of the resolver timer, which retransmits queries and checks
+ *         the time-outs of look-ups. */
+    #define dnsRESOLVER_CHECK_PERIOD_MS    ( 100U )
+
+/** @brief The query number of an address family that still needs a query. */
+    #define dnsRESOLVER_UNSENT             ( 0xFFU )
+
+/** @brief The index in DNSResolveRequest_t::ucQuery[] of the A query. */
+    #define dnsRESOLVER_IPv4               ( 0U )
+
+/** @brief The index in DNSResolveRequest_t::ucQuery[] of the AAAA query. */
+    #define dnsRESOLVER_IPv6               ( 1U )
+
+/** @brief The number of address families that can be looked up. */
+    #define dnsRESOLVER_FAMILIES           ( 2U )
+
+/** @brief The look-up is being processed by the IP-task. */
+    #define dnsRESOLVE_PENDING             ( 0U )
+
+/** @brief The look-up has finished, the IP-task does not access it anymore. */
+    #define dnsRESOLVE_DONE                ( 1U )
+
+/** @brief The look-up was cancelled by the user, the IP-task will release it. */
+    #define dnsRESOLVE_CANCELLED           ( 2U )
+
+/** @brief A query that was sent by the resolver. It may be shared by several look-ups. */
+    typedef struct xDNS_RESOLVER_QUERY
+    {
+        char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ]; /**< The host name that is looked up. */
+        TickType_t xSendTime;                         /**< The time at which the query was last sent. */
+        uint16_t usIdentifier;                        /**< The identifier of the DNS message. */
+        uint8_t ucFamily;                             /**< Either dnsRESOLVER_IPv4 or dnsRESOLVER_IPv6. */
+        uint8_t ucAttempts;                           /**< The number of times that the query was sent. */
+        uint8_t ucWaiters;                            /**< The number of look-ups using this query, zero for a free query. */
+    } DNSResolverQuery_t;
+
+/** @brief A look-up, which is passed to the user as a DNSResolveHandle_t. */
+    struct xDNS_RESOLVE_REQUEST
+    {
+        ListItem_t xListItem;                          /**< Item in the list of active look-ups. */
+        FOnDNSEvent pCallbackFunction;                 /**< The function to be called with the result, or NULL. */
+        void * pvSearchID;                             /**< The search ID passed to the callback function. */
+        SemaphoreHandle_t xDoneSemaphore;              /**< Given when a look-up without callback has finished. */
+        struct freertos_addrinfo * pxResult;           /**< The addresses found so far. */
+        TimeOut_t xTimeOut;                            /**< The time at which the look-up was started. */
+        TickType_t uxRemainingTime;                    /**< The time-out of the look-up in clock ticks. */
+        uint8_t ucQuery[ dnsRESOLVER_FAMILIES ];       /**< For each family: the query number plus one, dnsRESOLVER_UNSENT, or zero when done. */
+        uint8_t ucState;                               /**< dnsRESOLVE_PENDING, dnsRESOLVE_DONE, or dnsRESOLVE_CANCELLED. */
+        uint8_t ucPrefetch;                            /**< Non-zero for a refresh of the DNS cache, which has no handle. */
+        uint8_t ucReferences;                          /**< Held by the IP-task and by the handle, released when it drops to zero. */
+        char pcName[ 1 ];                              /**< The host name, allocated along with the struct. */
+    };
+
+    typedef struct xDNS_RESOLVE_REQUEST DNSResolveRequest_t;
+
+/** @brief The queries that are outstanding, only accessed by the IP-task. */
+    static DNSResolverQuery_t xResolverQueries[ ipconfigDNS_RESOLVER_MAX_QUERIES ];
+
+/** @brief The list of active look-ups, only accessed by the IP-task. */
+    static List_t xResolverRequests;
+
+/** @brief The socket that is used to send all queries. */
+    static Socket_t xResolverSocket = NULL;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release a look-up along with its result and semaphore.
+ *
+ * @param[in] pxRequest The look-up to release.
+ */
+    static void prvResolverFree( DNSResolveRequest_t * pxRequest )
+    {
+        if( pxRequest->xDoneSemaphore != NULL )
+        {
+            vSemaphoreDelete( pxRequest->xDoneSemaphore );
+        }
+
+        if( pxRequest->pxResult != NULL )
+        {
+            FreeRTOS_freeaddrinfo( pxRequest->pxResult );
+        }
+
+        vPortFree( pxRequest );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Drop one reference to a look-up. The IP-task and the user both hold
+ *        a reference, the one that drops the last reference releases it.
+ *
+ * @param[in] pxRequest The look-up.
+ */
+    static void prvResolverUnref( DNSResolveRequest_t * pxRequest )
+    {
+        BaseType_t xFree;
+
+        vTaskSuspendAll();
+        {
+            pxRequest->ucReferences--;
+            xFree = ( pxRequest->ucReferences == 0U ) ? pdTRUE : pdFALSE;
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xFree != pdFALSE )
+        {
+            prvResolverFree( pxRequest );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create and bind the socket of the resolver, if it does not exist yet.
+ *        The socket is used by the IP-task only, so it does not block.
+ *
+ * @return pdTRUE when the socket is available.
+ */
+    static BaseType_t prvResolverOpenSocket( void )
+    {
+        if( xResolverSocket == NULL )
+        {
+            Socket_t xSocket = FreeRTOS_socket( FREERTOS_AF_INET, FREERTOS_SOCK_DGRAM, FREERTOS_IPPROTO_UDP );
+
+            /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
+            /* coverity[misra_c_2012_rule_11_4_violation] */
+            if( xSocketValid( xSocket ) == pdTRUE )
+            {
+                struct freertos_sockaddr xAddress;
+                TickType_t xTimeoutTime = ( TickType_t ) 0;
+
+                ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &( xTimeoutTime ), sizeof( TickType_t ) );
+                ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_SNDTIMEO, &( xTimeoutTime ), sizeof( TickType_t ) );
+
+                /* Bind to a random port number. */
+                ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+                xAddress.sin_family = FREERTOS_AF_INET4;
+                xAddress.sin_len = ( uint8_t ) sizeof( xAddress );
+
+                if( vSocketBind( xSocket, &( xAddress ), sizeof( xAddress ), pdFALSE ) == 0 )
+                {
+                    xResolverSocket = xSocket;
+                }
+                else
+                {
+                    ( void ) vSocketClose( xSocket );
+                }
+            }
+        }
+
+        return ( xResolverSocket != NULL ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a list of addresses to the result of a look-up.
+ *
+ * @param[in] pxRequest The look-up.
+ * @param[in] pxList The addresses, which will be owned by the look-up.
+ */
+    static void prvResolverAppend( DNSResolveRequest_t * pxRequest,
+                                   struct freertos_addrinfo * pxList )
+    {
+        struct freertos_addrinfo ** ppxLast = &( pxRequest->pxResult );
+
+        while( *ppxLast != NULL )
+        {
+            ppxLast = &( ( *ppxLast )->ai_next );
+        }
+
+        *ppxLast = pxList;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send a query, either for the first time or as a retransmission.
+ *
+ * @param[in] uxQuery The query number.
+ * @param[in] xNextServer pdTRUE when the next DNS server should be used.
+ */
+    static void prvResolverSend( size_t uxQuery,
+                                 BaseType_t xNextServer )
+    {
+        DNSResolverQuery_t * pxQuery = &( xResolverQueries[ uxQuery ] );
+        BaseType_t xFamily = ( pxQuery->ucFamily == dnsRESOLVER_IPv6 ) ? FREERTOS_AF_INET6 : FREERTOS_AF_INET4;
+
+        /* A query that could not be sent, will be retransmitted later. */
+        pxQuery->ucAttempts++;
+        pxQuery->xSendTime = xTaskGetTickCount();
+
+        ( void ) xDNSSendQuery( pxQuery->pcName,
+                                ( TickType_t ) pxQuery->usIdentifier,
+                                xResolverSocket,
+                                xFamily,
+                                xNextServer );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find a query for each address family that a look-up still needs. When
+ *        an outstanding query has the same name and family, the look-up will
+ *        share it. Otherwise a new query is sent, when a free query is
+ *        available.
+ *
+ * @param[in] pxRequest The look-up.
+ */
+    static void prvResolverAttach( DNSResolveRequest_t * pxRequest )
+    {
+        uint8_t ucFamily;
+
+        for( ucFamily = 0U; ucFamily < dnsRESOLVER_FAMILIES; ucFamily++ )
+        {
+            if( pxRequest->ucQuery[ ucFamily ] == dnsRESOLVER_UNSENT )
+            {
+                size_t uxFree = ipconfigDNS_RESOLVER_MAX_QUERIES;
+                size_t uxQuery;
+
+                for( uxQuery = 0U; uxQuery < ipconfigDNS_RESOLVER_MAX_QUERIES; uxQuery++ )
+                {
+                    DNSResolverQuery_t * pxQuery = &( xResolverQueries[ uxQuery ] );
+
+                    if( pxQuery->ucWaiters == 0U )
+                    {
+                        if( uxFree == ipconfigDNS_RESOLVER_MAX_QUERIES )
+                        {
+                            uxFree = uxQuery;
+                        }
+                    }
+                    else if( ( pxQuery->ucFamily == ucFamily ) &&
+                             ( pxQuery->ucWaiters < 0xFFU ) &&
+                             ( strcasecmp( pxQuery->pcName, pxRequest->pcName ) == 0 ) )
+                    {
+                        /* The same query is outstanding already, share it. */
+                        pxQuery->ucWaiters++;
+                        pxRequest->ucQuery[ ucFamily ] = ( uint8_t ) ( uxQuery + 1U );
+                        break;
+                    }
+                    else
+                    {
+                        /* A query for another name or family. */
+                    }
+                }
+
+                if( ( pxRequest->ucQuery[ ucFamily ] == dnsRESOLVER_UNSENT ) && ( uxFree < ipconfigDNS_RESOLVER_MAX_QUERIES ) )
+                {
+                    DNSResolverQuery_t * pxQuery = &( xResolverQueries[ uxFree ] );
+                    uint32_t ulNumber = 0U;
+                    BaseType_t xUnique;
+
+                    if( xApplicationGetRandomNumber( &( ulNumber ) ) == pdFALSE )
+                    {
+                        ulNumber = ( uint32_t ) xTaskGetTickCount();
+                    }
+
+                    /* Make sure that the identifier is not used by another query. */
+                    do
+                    {
+                        xUnique = pdTRUE;
+
+                        for( uxQuery = 0U; uxQuery < ipconfigDNS_RESOLVER_MAX_QUERIES; uxQuery++ )
+                        {
+                            if( ( xResolverQueries[ uxQuery ].ucWaiters != 0U ) &&
+                                ( xResolverQueries[ uxQuery ].usIdentifier == ( uint16_t ) ulNumber ) )
+                            {
+                                xUnique = pdFALSE;
+                                ulNumber++;
+                                break;
+                            }
+                        }
+                    } while( xUnique == pdFALSE );
+
+                    ( void ) strcpy( pxQuery->pcName, pxRequest->pcName );
+                    pxQuery->usIdentifier = ( uint16_t ) ulNumber;
+                    pxQuery->ucFamily = ucFamily;
+                    pxQuery->ucAttempts = 0U;
+                    pxQuery->ucWaiters = 1U;
+                    pxRequest->ucQuery[ ucFamily ] = ( uint8_t ) ( uxFree + 1U );
+
+                    prvResolverSend( uxFree, pdFALSE );
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Stop using the queries of a look-up. A query that is not used anymore
+ *        becomes free, a late reply to it will be ignored.
+ *
+ * @param[in] pxRequest The look-up.
+ */
+    static void prvResolverDetach( DNSResolveRequest_t * pxRequest )
+    {
+        uint8_t ucFamily;
+
+        for( ucFamily = 0U; ucFamily < dnsRESOLVER_FAMILIES; ucFamily++ )
+        {
+            uint8_t ucQuery = pxRequest->ucQuery[ ucFamily ];
+
+            if( ( ucQuery != 0U ) && ( ucQuery != dnsRESOLVER_UNSENT ) )
+            {
+                xResolverQueries[ ucQuery - 1U ].ucWaiters--;
+            }
+
+            pxRequest->ucQuery[ ucFamily ] = 0U;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A look-up has finished. Its result is passed to the callback, or
+ *        its waiting task is woken up. The IP-task drops its reference.
+ *
+ * @param[in] pxRequest The look-up.
+ */
+    static void prvResolverFinish( DNSResolveRequest_t * pxRequest )
+    {
+        BaseType_t xCancelled;
+
+        if( listLIST_ITEM_CONTAINER( &( pxRequest->xListItem ) ) != NULL )
+        {
+            ( void ) uxListRemove( &( pxRequest->xListItem ) );
+        }
+
+        vTaskSuspendAll();
+        {
+            xCancelled = ( pxRequest->ucState == dnsRESOLVE_CANCELLED ) ? pdTRUE : pdFALSE;
+
+            if( xCancelled == pdFALSE )
+            {
+                if( pxRequest->xDoneSemaphore != NULL )
+                {
+                    /* Wake up the waiting task before the look-up is seen
+                     * as done. */
+                    ( void ) xSemaphoreGive( pxRequest->xDoneSemaphore );
+                }
+
+                pxRequest->ucState = dnsRESOLVE_DONE;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+        {
+            if( pxRequest->ucPrefetch != 0U )
+            {
+                vDNSCacheRefreshDone( pxRequest->pcName );
+            }
+        }
+        #endif
+
+        if( ( xCancelled == pdFALSE ) && ( pxRequest->pCallbackFunction != NULL ) )
+        {
+            /* The handle still holds a reference, the result stays valid. */
+            pxRequest->pCallbackFunction( pxRequest->pcName, pxRequest->pvSearchID, pxRequest->pxResult );
+        }
+
+        /* A refresh of the DNS cache has updated the cache already, it has
+         * no handle, so it is released here. */
+        prvResolverUnref( pxRequest );
+
+        if( listLIST_IS_EMPTY( &( xResolverRequests ) ) != pdFALSE )
+        {
+            /* No more look-ups, no need for periodic checks. */
+            vIPSetDNSResolverTimerEnableState( pdFALSE );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Let look-ups that are still waiting for a free query, try again.
+ */
+    static void prvResolverAttachWaiting( void )
+    {
+        const ListItem_t * pxIterator;
+        const ListItem_t * pxEnd = listGET_END_MARKER( &( xResolverRequests ) );
+
+        for( pxIterator = listGET_HEAD_ENTRY( &( xResolverRequests ) );
+             pxIterator != pxEnd;
+             pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            DNSResolveRequest_t * pxRequest = ( ( DNSResolveRequest_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+            if( ( pxRequest->ucQuery[ dnsRESOLVER_IPv4 ] == dnsRESOLVER_UNSENT ) ||
+                ( pxRequest->ucQuery[ dnsRESOLVER_IPv6 ] == dnsRESOLVER_UNSENT ) )
+            {
+                prvResolverAttach( pxRequest );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A query has been answered, or all its attempts have failed. All
+ *        look-ups that share the query get a copy of the addresses found.
+ *
+ * @param[in] uxQuery The query number.
+ * @param[in] pxRecords The addresses found.
+ * @param[in] uxCount The number of addresses in pxRecords, may be zero.
+ */
+    static void prvResolverQueryDone( size_t uxQuery,
+                                      const DNSAddressRecord_t * pxRecords,
+                                      size_t uxCount )
+    {
+        const ListItem_t * pxIterator;
+        const ListItem_t * pxEnd = listGET_END_MARKER( &( xResolverRequests ) );
+        DNSResolverQuery_t * pxQuery = &( xResolverQueries[ uxQuery ] );
+
+        for( pxIterator = listGET_HEAD_ENTRY( &( xResolverRequests ) );
+             pxIterator != pxEnd; )
+        {
+            DNSResolveRequest_t * pxRequest = ( ( DNSResolveRequest_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+            /* Move to the next item because this item might be removed. */
+            pxIterator = listGET_NEXT( pxIterator );
+
+            if( pxRequest->ucQuery[ pxQuery->ucFamily ] == ( uint8_t ) ( uxQuery + 1U ) )
+            {
+                pxRequest->ucQuery[ pxQuery->ucFamily ] = 0U;
+
+                if( ( uxCount > 0U ) && ( pxRequest->ucPrefetch == 0U ) )
+                {
+                    prvResolverAppend( pxRequest, DNS_AddressRecordsToList( pxRequest->pcName, pxRecords, uxCount ) );
+                }
+
+                if( ( pxRequest->ucQuery[ dnsRESOLVER_IPv4 ] == 0U ) &&
+                    ( pxRequest->ucQuery[ dnsRESOLVER_IPv6 ] == 0U ) )
+                {
+                    prvResolverFinish( pxRequest );
+                }
+            }
+        }
+
+        /* The query is free now. */
+        pxQuery->ucWaiters = 0U;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Read all replies that were received by the socket of the resolver.
+ */
+    static void prvResolverReceive( void )
+    {
+        BaseType_t xHasFreed = pdFALSE;
+
+        for( ; ; )
+        {
+            uint8_t * pucPayload = NULL;
+            struct freertos_sockaddr xAddress;
+            socklen_t xAddressLength = sizeof( xAddress );
+            int32_t lBytes;
+            size_t uxQuery;
+
+            lBytes = FreeRTOS_recvfrom( xResolverSocket, &( pucPayload ), 0U, FREERTOS_ZERO_COPY, &( xAddress ), &( xAddressLength ) );
+
+            if( lBytes <= 0 )
+            {
+                break;
+            }
+
+            if( ( size_t ) lBytes >= sizeof( DNSMessage_t ) )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                const DNSMessage_t * pxDNSMessageHeader = ( ( const DNSMessage_t * ) pucPayload );
+
+                for( uxQuery = 0U; uxQuery < ipconfigDNS_RESOLVER_MAX_QUERIES; uxQuery++ )
+                {
+                    const DNSResolverQuery_t * pxQuery = &( xResolverQueries[ uxQuery ] );
+
+                    if( ( pxQuery->ucWaiters != 0U ) &&
+                        ( pxQuery->usIdentifier == pxDNSMessageHeader->usIdentifier ) )
+                    {
+                        DNSAddressRecord_t xRecords[ ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY ];
+                        BaseType_t xCount;
+
+                        /* The reply is parsed in a single pass, into an array on
+                         * the stack. It must answer the name that was asked,
+                         * otherwise it is dropped and the query stays pending. */
+
+                        /* MISRA Ref 4.14.2 [The validity of values received from external sources]. */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-414. */
+                        /* coverity[misra_c_2012_directive_4_14_violation] */
+                        xCount = DNS_ParseAddressRecords( pucPayload,
+                                                          ( size_t ) lBytes,
+                                                          pxQuery->pcName,
+                                                          xRecords,
+                                                          ( size_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY );
+
+                        if( xCount >= 0 )
+                        {
+                            #if ( ipconfigUSE_DNS_CACHE == 1 )
+                            {
+                                /* The reply is expected, so the addresses are
+                                 * stored in the DNS cache. */
+                                DNS_StoreAddressRecords( pxQuery->pcName, xRecords, ( size_t ) xCount );
+                            }
+                            #endif /* if ( ipconfigUSE_DNS_CACHE == 1 ) */
+
+                            /* A reply without answers finishes the query as well. */
+                            prvResolverQueryDone( uxQuery, xRecords, ( size_t ) xCount );
+                            xHasFreed = pdTRUE;
+                        }
+
+                        break;
+                    }
+                }
+            }
+
+            FreeRTOS_ReleaseUDPPayloadBuffer( pucPayload );
+        }
+
+        if( xHasFreed != pdFALSE )
+        {
+            prvResolverAttachWaiting();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start processing a new look-up. Addresses found in the DNS cache are
+ *        used immediately, for the other families a query is sent or shared.
+ *
+ * @param[in] pxRequest The new look-up.
+ */
+    static void prvResolverAdd( DNSResolveRequest_t * pxRequest )
+    {
+        if( pxRequest->ucState == dnsRESOLVE_CANCELLED )
+        {
+            /* Cancelled before the IP-task saw it. */
+            prvResolverUnref( pxRequest );
+        }
+        else if( prvResolverOpenSocket() == pdFALSE )
+        {
+            FreeRTOS_printf( ( "DNS resolver: can not create a socket\n" ) );
+            pxRequest->ucQuery[ dnsRESOLVER_IPv4 ] = 0U;
+            pxRequest->ucQuery[ dnsRESOLVER_IPv6 ] = 0U;
+            prvResolverFinish( pxRequest );
+        }
+        else
+        {
+            #if ( ipconfigUSE_DNS_CACHE == 1 )
+            {
+                uint8_t ucFamily;
+
+                for( ucFamily = 0U; ( ucFamily < dnsRESOLVER_FAMILIES ) && ( pxRequest->ucPrefetch == 0U ); ucFamily++ )
+                {
+                    if( pxRequest->ucQuery[ ucFamily ] == dnsRESOLVER_UNSENT )
+                    {
+                        struct freertos_addrinfo * pxAddressInfo = NULL;
+                        BaseType_t xFamily = ( ucFamily == dnsRESOLVER_IPv6 ) ? FREERTOS_AF_INET6 : FREERTOS_AF_INET4;
+
+                        if( Prepare_CacheLookup( pxRequest->pcName, xFamily, &( pxAddressInfo ) ) != 0U )
+                        {
+                            pxRequest->ucQuery[ ucFamily ] = 0U;
+                        }
+
+                        if( pxAddressInfo != NULL )
+                        {
+                            prvResolverAppend( pxRequest, pxAddressInfo );
+                        }
+                    }
+                }
+            }
+            #endif /* ( ipconfigUSE_DNS_CACHE == 1 ) */
+
+            if( listLIST_IS_EMPTY( &( xResolverRequests ) ) != pdFALSE )
+            {
+                /* This is the first look-up, start the timer. */
+                vDNSResolverTimerReload( pdMS_TO_TICKS( dnsRESOLVER_CHECK_PERIOD_MS ) );
+            }
+
+            vListInsertEnd( &( xResolverRequests ), &( pxRequest->xListItem ) );
+
+            prvResolverAttach( pxRequest );
+
+            if( ( pxRequest->ucQuery[ dnsRESOLVER_IPv4 ] == 0U ) &&
+                ( pxRequest->ucQuery[ dnsRESOLVER_IPv6 ] == 0U ) )
+            {
+                /* Everything was found in the DNS cache. */
+                prvResolverFinish( pxRequest );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Initialise the resolver, called by the IP-task.
+ */
+    void vDNSResolverInitialise( void )
+    {
+        vListInitialise( &( xResolverRequests ) );
+        ( void ) memset( xResolverQueries, 0, sizeof( xResolverQueries ) );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check whether a given socket is the socket of the resolver.
+ *
+ * @param[in] xSocket The socket to be checked.
+ *
+ * @return pdTRUE if it is the socket of the resolver, else pdFALSE.
+ */
+    BaseType_t xIsDNSResolverSocket( ConstSocket_t xSocket )
+    {
+        BaseType_t xReturn;
+
+        if( ( xResolverSocket != NULL ) && ( xResolverSocket == xSocket ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send an eDNSResolverEvent to the IP-task.
+ *
+ * @param[in] xHandle A new look-up, or NULL when the socket of the resolver
+ *                    has received a reply.
+ *
+ * @return pdPASS if the event was sent.
+ */
+    BaseType_t xSendDNSResolverEvent( DNSResolveHandle_t xHandle )
+    {
+        IPStackEvent_t xEventMessage;
+
+        xEventMessage.eEventType = eDNSResolverEvent;
+        xEventMessage.pvData = ( void * ) xHandle;
+
+        return xSendEventStructToIPTask( &( xEventMessage ), ipconfigDNS_SEND_BLOCK_TIME_TICKS );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Handle an eDNSResolverEvent in the IP-task.
+ *
+ * @param[in] pvData A new look-up, or NULL.
+ */
+    void vDNSResolverHandleEvent( void * pvData )
+    {
+        if( pvData != NULL )
+        {
+            prvResolverAdd( ( DNSResolveRequest_t * ) pvData );
+        }
+
+        if( xResolverSocket != NULL )
+        {
+            prvResolverReceive();
+        }
+
+        #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+        {
+            /* A look-up in the DNS cache may have asked for a refresh. */
+            vDNSCacheStartRefreshes();
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called periodically by the IP-task. Cancelled look-ups are released,
+ *        look-ups that timed out are finished, and queries that did not get
+ *        a reply are retransmitted through the next DNS server. A query that
+ *        has used all its attempts finishes without addresses.
+ */
+    void vDNSResolverCheck( void )
+    {
+        const ListItem_t * pxIterator;
+        const ListItem_t * pxEnd = listGET_END_MARKER( &( xResolverRequests ) );
+        TickType_t xNow;
+        size_t uxQuery;
+
+        if( xResolverSocket != NULL )
+        {
+            /* Handle the replies that have been received, before deciding
+             * that a query has timed out. */
+            prvResolverReceive();
+        }
+
+        xNow = xTaskGetTickCount();
+
+        for( pxIterator = listGET_HEAD_ENTRY( &( xResolverRequests ) );
+             pxIterator != pxEnd; )
+        {
+            DNSResolveRequest_t * pxRequest = ( ( DNSResolveRequest_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+            /* Move to the next item because this item might be removed. */
+            pxIterator = listGET_NEXT( pxIterator );
+
+            if( ( pxRequest->ucState == dnsRESOLVE_CANCELLED ) ||
+                ( xTaskCheckForTimeOut( &( pxRequest->xTimeOut ), &( pxRequest->uxRemainingTime ) ) != pdFALSE ) )
+            {
+                prvResolverDetach( pxRequest );
+                prvResolverFinish( pxRequest );
+            }
+        }
+
+        for( uxQuery = 0U; uxQuery < ipconfigDNS_RESOLVER_MAX_QUERIES; uxQuery++ )
+        {
+            DNSResolverQuery_t * pxQuery = &( xResolverQueries[ uxQuery ] );
+
+            if( ( pxQuery->ucWaiters != 0U ) &&
+                ( ( xNow - pxQuery->xSendTime ) >= ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS ) )
+            {
+                if( pxQuery->ucAttempts < ( uint8_t ) ipconfigDNS_REQUEST_ATTEMPTS )
+                {
+                    prvResolverSend( uxQuery, pdTRUE );
+                }
+                else
+                {
+                    DNSAddressRecord_t xRecords[ ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY ];
+                    size_t uxCount = 0U;
+
+                    #if ( ( ipconfigUSE_DNS_CACHE == 1 ) && ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 ) )
+                    {
+                        /* No DNS server could be reached, serve an expired
+                         * answer from the DNS cache (RFC 8767). */
+                        BaseType_t xFamily = ( pxQuery->ucFamily == dnsRESOLVER_IPv6 ) ? FREERTOS_AF_INET6 : FREERTOS_AF_INET4;
+
+                        uxCount = uxDNSCacheReadStale( pxQuery->pcName, xFamily, xRecords, ( size_t ) ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY );
+                    }
+                    #endif /* if ( ( ipconfigUSE_DNS_CACHE == 1 ) && ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 ) ) */
+
+                    prvResolverQueryDone( uxQuery, xRecords, uxCount );
+                }
+            }
+        }
+
+        prvResolverAttachWaiting();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create a look-up and pass it to the IP-task.
+ *
+ * @param[in] pcHostName The host name to look up.
+ * @param[in] xFamily FREERTOS_AF_INET4, FREERTOS_AF_INET6, or 0 for both.
+ * @param[in] pCallback The function to be called with the result, or NULL.
+ * @param[in] pvSearchID The search ID passed to the callback function.
+ * @param[in] uxTimeout The time-out of the look-up in ms, or 0.
+ * @param[in] ucPrefetch Non-zero for a refresh of the DNS cache.
+ *
+ * @return The look-up, or NULL when it could not be started.
+ */
+    static DNSResolveRequest_t * prvResolverCreate( const char * pcHostName,
+                                                    BaseType_t xFamily,
+                                                    FOnDNSEvent pCallback,
+                                                    void * pvSearchID,
+                                                    TickType_t uxTimeout,
+                                                    uint8_t ucPrefetch )
+    {
+        DNSResolveRequest_t * pxRequest = NULL;
+        uint8_t ucIPv4 = 0U;
+        uint8_t ucIPv6 = 0U;
+        size_t uxLength = 0U;
+        BaseType_t xValid = pdFALSE;
+
+        if( pcHostName != NULL )
+        {
+            uxLength = strlen( pcHostName );
+
+            if( ( uxLength > 0U ) && ( uxLength < ( size_t ) ipconfigDNS_CACHE_NAME_LENGTH ) )
+            {
+                xValid = pdTRUE;
+            }
+
+            #if ( ipconfigUSE_MDNS == 1 )
+            {
+                const char * pcDot = strchr( pcHostName, ( int32_t ) '.' );
+
+                if( ( pcDot != NULL ) && ( strcmp( pcDot, ".local" ) == 0 ) )
+                {
+                    /* The replies to mDNS queries are sent to port 5353. */
+                    xValid = pdFALSE;
+                }
+            }
+            #endif
+        }
+
+        #if ( ipconfigUSE_IPv4 != 0 )
+            if( ( xFamily == 0 ) || ( xFamily == FREERTOS_AF_INET4 ) )
+            {
+                ucIPv4 = dnsRESOLVER_UNSENT;
+            }
+        #endif
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            if( ( xFamily == 0 ) || ( xFamily == FREERTOS_AF_INET6 ) )
+            {
+                ucIPv6 = dnsRESOLVER_UNSENT;
+            }
+        #endif
+
+        if( ( ucIPv4 == 0U ) && ( ucIPv6 == 0U ) )
+        {
+            xValid = pdFALSE;
+        }
+
+        if( xValid != pdFALSE )
+        {
+            /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
+            /* coverity[misra_c_2012_directive_4_12_violation] */
+            pxRequest = ( ( DNSResolveRequest_t * ) pvPortMalloc( sizeof( *pxRequest ) + uxLength ) );
+        }
+
+        if( pxRequest != NULL )
+        {
+            ( void ) memset( pxRequest, 0, sizeof( *pxRequest ) );
+            ( void ) memcpy( pxRequest->pcName, pcHostName, uxLength + 1U );
+            pxRequest->pCallbackFunction = pCallback;
+            pxRequest->pvSearchID = pvSearchID;
+            pxRequest->ucQuery[ dnsRESOLVER_IPv4 ] = ucIPv4;
+            pxRequest->ucQuery[ dnsRESOLVER_IPv6 ] = ucIPv6;
+            pxRequest->ucState = dnsRESOLVE_PENDING;
+            pxRequest->ucPrefetch = ucPrefetch;
+            /* A refresh of the DNS cache is only referred to by the IP-task. */
+            pxRequest->ucReferences = ( ucPrefetch != 0U ) ? 1U : 2U;
+
+            if( uxTimeout == 0U )
+            {
+                pxRequest->uxRemainingTime = portMAX_DELAY;
+            }
+            else
+            {
+                pxRequest->uxRemainingTime = pdMS_TO_TICKS( uxTimeout );
+            }
+
+            vTaskSetTimeOutState( &( pxRequest->xTimeOut ) );
+            vListInitialiseItem( &( pxRequest->xListItem ) );
+            listSET_LIST_ITEM_OWNER( &( pxRequest->xListItem ), ( void * ) pxRequest );
+
+            if( ( pCallback == NULL ) && ( ucPrefetch == 0U ) )
+            {
+                pxRequest->xDoneSemaphore = xSemaphoreCreateBinary();
+
+                if( pxRequest->xDoneSemaphore == NULL )
+                {
+                    prvResolverFree( pxRequest );
+                    pxRequest = NULL;
+                }
+            }
+        }
+
+        return pxRequest;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start an asynchronous look-up of a host name.
+ *
+ * @param[in] pcHostName The host name to look up.
+ * @param[in] xFamily FREERTOS_AF_INET4, FREERTOS_AF_INET6, or 0 to look up
+ *                    both families in parallel.
+ * @param[in] pCallback The function to be called with the result, or NULL when
+ *                      the result will be collected with FreeRTOS_DNSResolveWait().
+ * @param[in] pvSearchID The search ID passed to the callback function.
+ * @param[in] uxTimeout The time-out of the look-up in ms, 0 to wait until
+ *                      all queries have finished.
+ *
+ * @return The handle of the look-up, or NULL when it could not be started.
+ */
+    DNSResolveHandle_t FreeRTOS_DNSResolveStart( const char * pcHostName,
+                                                 BaseType_t xFamily,
+                                                 FOnDNSEvent pCallback,
+                                                 void * pvSearchID,
+                                                 TickType_t uxTimeout )
+    {
+        DNSResolveRequest_t * pxRequest = prvResolverCreate( pcHostName, xFamily, pCallback, pvSearchID, uxTimeout, 0U );
+
+        if( ( pxRequest != NULL ) && ( xSendDNSResolverEvent( pxRequest ) != pdPASS ) )
+        {
+            prvResolverFree( pxRequest );
+            pxRequest = NULL;
+        }
+
+        return pxRequest;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+
+/**
+ * @brief Refresh an entry of the DNS cache in the background. The query does
+ *        not use the DNS cache, its reply updates the entry. Called by the
+ *        IP-task, so the look-up is added directly.
+ *
+ * @param[in] pcHostName The host name of the entry.
+ * @param[in] xFamily Either FREERTOS_AF_INET4 or FREERTOS_AF_INET6.
+ *
+ * @return pdPASS when the refresh was started.
+ */
+        BaseType_t xDNSResolverPrefetch( const char * pcHostName,
+                                         BaseType_t xFamily )
+        {
+            BaseType_t xReturn = pdFAIL;
+            DNSResolveRequest_t * pxRequest = prvResolverCreate( pcHostName, xFamily, NULL, NULL, 0U, 1U );
+
+            if( pxRequest != NULL )
+            {
+                prvResolverAdd( pxRequest );
+                xReturn = pdPASS;
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 ) */
+
+/**
+ * @brief Wait for a look-up without callback to finish.
+ *
+ * @param[in] xHandle The handle of the look-up.
+ * @param[in] uxBlockTime The maximum time to wait in clock ticks.
+ * @param[out] ppxResult The addresses found, or NULL. The list must be released
+ *                       with FreeRTOS_freeaddrinfo(). It is only passed once.
+ *
+ * @return 0 when the look-up has finished, -pdFREERTOS_ERRNO_EWOULDBLOCK when it
+ *         has not finished yet, or -pdFREERTOS_ERRNO_EINVAL.
+ */
+    BaseType_t FreeRTOS_DNSResolveWait( DNSResolveHandle_t xHandle,
+                                        TickType_t uxBlockTime,
+                                        struct freertos_addrinfo ** ppxResult )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+
+        if( ( xHandle != NULL ) && ( xHandle->xDoneSemaphore != NULL ) && ( ppxResult != NULL ) )
+        {
+            if( xSemaphoreTake( xHandle->xDoneSemaphore, uxBlockTime ) == pdPASS )
+            {
+                /* The IP-task does not access a finished look-up anymore. */
+                *ppxResult = xHandle->pxResult;
+                xHandle->pxResult = NULL;
+
+                /* Let a next call return immediately as well. */
+                ( void ) xSemaphoreGive( xHandle->xDoneSemaphore );
+                xReturn = 0;
+            }
+            else
+            {
+                xReturn = -pdFREERTOS_ERRNO_EWOULDBLOCK;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release the handle of a look-up. A look-up that has not finished is
+ *        cancelled. The look-up is freed by whoever drops the last reference:
+ *        this function, or the IP-task when it finishes the look-up.
+ *
+ * @param[in] xHandle The handle of the look-up.
+ */
+    void FreeRTOS_DNSResolveRelease( DNSResolveHandle_t xHandle )
+    {
+        if( xHandle != NULL )
+        {
+            vTaskSuspendAll();
+            {
+                if( xHandle->ucState != dnsRESOLVE_DONE )
+                {
+                    xHandle->ucState = dnsRESOLVE_CANCELLED;
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            prvResolverUnref( xHandle );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ( ipconfigUSE_DNS != 0 ) && ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) ) */
@@ -0,0 +1,534 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_Happy_Eyeballs.c
+ * @brief Connects a TCP socket to a dual-stack host, racing the connection
+ *        attempts to its IPv6 and IPv4 addresses (RFC 8305).
+ *
+ * The attempts are started one after the other, with a delay in between, but
+ * an attempt is not cancelled when the next one starts. A single socket set
+ * is used to wait for the first attempt that succeeds or fails.
+ * FreeRTOS_connect_by_name() sends the AAAA and A queries in parallel, and
+ * starts connecting as soon as the first of them is answered.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_DNS.h"
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_HAPPY_EYEBALLS ) )
+
+/** @brief The index of the IPv6 addresses in the arrays of HappyEyeballs_t. */
+    #define heINDEX_IPv6           ( 0U )
+
+/** @brief The index of the IPv4 addresses in the arrays of HappyEyeballs_t. */
+    #define heINDEX_IPv4           ( 1U )
+
+/** @brief The number of address families that take part in a race. */
+    #define heFAMILIES             ( 2U )
+
+/** @brief How often a look-up is checked while there is no connection attempt
+ *         in progress that can wake up the task. */
+    #define heLOOK_UP_POLL_MS      ( 10U )
+
+/** @brief The state of a race between connection attempts. */
+    typedef struct xHAPPY_EYEBALLS
+    {
+        const struct freertos_addrinfo * pxNext[ heFAMILIES ]; /**< The next address of each family that will be tried. */
+        DNSResolveHandle_t xLookUps[ heFAMILIES ];             /**< The look-ups of each family that have not finished yet. */
+        struct freertos_addrinfo * pxAnswers[ heFAMILIES ];    /**< The addresses found by the look-ups, owned by the race. */
+        BaseType_t xWantIPv6;                                  /**< pdTRUE when the next attempt should use IPv6. */
+    } HappyEyeballs_t;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the first address of a given family in a list of addresses.
+ *
+ * @param[in] pxAddress The address to start with, may be NULL.
+ * @param[in] xFamily Either FREERTOS_AF_INET4 or FREERTOS_AF_INET6.
+ *
+ * @return The address found, or NULL.
+ */
+    static const struct freertos_addrinfo * prvNextOfFamily( const struct freertos_addrinfo * pxAddress,
+                                                             BaseType_t xFamily )
+    {
+        const struct freertos_addrinfo * pxIterator = pxAddress;
+
+        while( ( pxIterator != NULL ) && ( pxIterator->ai_family != xFamily ) )
+        {
+            pxIterator = pxIterator->ai_next;
+        }
+
+        return pxIterator;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take the address for the next attempt: the families alternate,
+ *        starting with IPv6 (RFC 8305 section 4). Within a family, the order
+ *        of the DNS reply is kept.
+ *
+ * @param[in] pxRace The race.
+ *
+ * @return The address, or NULL when no address is known at this moment.
+ */
+    static const struct freertos_addrinfo * prvNextAddress( HappyEyeballs_t * pxRace )
+    {
+        const struct freertos_addrinfo * pxAddress;
+        size_t uxFamily = heINDEX_IPv4;
+
+        if( ( pxRace->pxNext[ heINDEX_IPv4 ] == NULL ) ||
+            ( ( pxRace->xWantIPv6 != pdFALSE ) && ( pxRace->pxNext[ heINDEX_IPv6 ] != NULL ) ) )
+        {
+            uxFamily = heINDEX_IPv6;
+        }
+
+        pxAddress = pxRace->pxNext[ uxFamily ];
+
+        if( pxAddress != NULL )
+        {
+            pxRace->pxNext[ uxFamily ] = prvNextOfFamily( pxAddress->ai_next, pxAddress->ai_family );
+            pxRace->xWantIPv6 = ( uxFamily == heINDEX_IPv4 ) ? pdTRUE : pdFALSE;
+        }
+
+        return pxAddress;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Collect the answers of the look-ups that have finished. The first
+ *        look-up that is still in progress is waited for at most xBlockTime
+ *        clock ticks.
+ *
+ * @param[in] pxRace The race.
+ * @param[in] xBlockTime The maximum time to wait.
+ *
+ * @return pdTRUE when a look-up is still in progress.
+ */
+    static BaseType_t prvCollectAnswers( HappyEyeballs_t * pxRace,
+                                         TickType_t xBlockTime )
+    {
+        const BaseType_t xFamilies[ heFAMILIES ] = { FREERTOS_AF_INET6, FREERTOS_AF_INET4 };
+        TickType_t xWaitTime = xBlockTime;
+        BaseType_t xLookingUp = pdFALSE;
+        size_t uxFamily;
+
+        for( uxFamily = 0U; uxFamily < heFAMILIES; uxFamily++ )
+        {
+            if( pxRace->xLookUps[ uxFamily ] != NULL )
+            {
+                struct freertos_addrinfo * pxAnswer = NULL;
+
+                if( FreeRTOS_DNSResolveWait( pxRace->xLookUps[ uxFamily ], xWaitTime, &( pxAnswer ) ) == 0 )
+                {
+                    FreeRTOS_DNSResolveRelease( pxRace->xLookUps[ uxFamily ] );
+                    pxRace->xLookUps[ uxFamily ] = NULL;
+                    pxRace->pxAnswers[ uxFamily ] = pxAnswer;
+                    pxRace->pxNext[ uxFamily ] = prvNextOfFamily( pxAnswer, xFamilies[ uxFamily ] );
+                }
+                else
+                {
+                    xLookingUp = pdTRUE;
+                }
+
+                xWaitTime = 0U;
+            }
+        }
+
+        return xLookingUp;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create a socket and start a non-blocking connect to an address.
+ *
+ * @param[in] pxAddress The address to connect to.
+ * @param[in] usPort The port number to connect to, host-endian.
+ * @param[in] xSocketSet The set in which the socket will wait for the result.
+ *
+ * @return The socket, or NULL when the attempt could not be started.
+ */
+    static Socket_t prvStartAttempt( const struct freertos_addrinfo * pxAddress,
+                                     uint16_t usPort,
+                                     SocketSet_t xSocketSet )
+    {
+        Socket_t xSocket = FreeRTOS_socket( pxAddress->ai_family, FREERTOS_SOCK_STREAM, FREERTOS_IPPROTO_TCP );
+
+        /* MISRA Ref 11.4.1 [Socket error and integer to pointer conversion] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-114 */
+        /* coverity[misra_c_2012_rule_11_4_violation] */
+        if( xSocketValid( xSocket ) == pdTRUE )
+        {
+            struct freertos_sockaddr xAddress;
+            TickType_t xNoBlock = ( TickType_t ) 0;
+            BaseType_t xResult;
+
+            ( void ) memcpy( &( xAddress ), pxAddress->ai_addr, sizeof( xAddress ) );
+            xAddress.sin_port = FreeRTOS_htons( usPort );
+
+            /* With a receive time-out of zero, FreeRTOS_connect() returns
+             * immediately. */
+            ( void ) FreeRTOS_setsockopt( xSocket, 0, FREERTOS_SO_RCVTIMEO, &( xNoBlock ), sizeof( xNoBlock ) );
+
+            xResult = FreeRTOS_connect( xSocket, &( xAddress ), ( socklen_t ) sizeof( xAddress ) );
+
+            if( ( xResult == 0 ) || ( xResult == -pdFREERTOS_ERRNO_EWOULDBLOCK ) )
+            {
+                FreeRTOS_FD_SET( xSocket, xSocketSet, ( EventBits_t ) eSELECT_WRITE | ( EventBits_t ) eSELECT_EXCEPT );
+            }
+            else
+            {
+                ( void ) FreeRTOS_closesocket( xSocket );
+                xSocket = NULL;
+            }
+        }
+        else
+        {
+            xSocket = NULL;
+        }
+
+        return xSocket;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take a socket out of the socket set and close it.
+ *
+ * @param[in] xSocket The socket.
+ * @param[in] xSocketSet The socket set.
+ */
+    static void prvStopAttempt( Socket_t xSocket,
+                                SocketSet_t xSocketSet )
+    {
+        FreeRTOS_FD_CLR( xSocket, xSocketSet, ( EventBits_t ) eSELECT_ALL );
+        ( void ) FreeRTOS_closesocket( xSocket );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run a race between connection attempts, as described in RFC 8305.
+ *        Addresses that are found by a look-up while the race is running, take
+ *        part in it as well.
+ *
+ * @param[in] pxRace The race, with the addresses known so far and the look-ups
+ *                   that are still in progress.
+ * @param[in] usPort The port number to connect to, host-endian.
+ * @param[in] xBlockTimeTicks The maximum time to wait for a connection.
+ *
+ * @return A connected socket, which uses the default time-outs, or
+ *         FREERTOS_INVALID_SOCKET when no attempt succeeded in time.
+ */
+    static Socket_t prvRace( HappyEyeballs_t * pxRace,
+                             uint16_t usPort,
+                             TickType_t xBlockTimeTicks )
+    {
+        Socket_t xAttempts[ ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS ];
+        const TickType_t xAttemptDelay = pdMS_TO_TICKS( ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS );
+        TickType_t xPollTime = pdMS_TO_TICKS( heLOOK_UP_POLL_MS );
+        Socket_t xConnected = FREERTOS_INVALID_SOCKET;
+        SocketSet_t xSocketSet = NULL;
+        BaseType_t xLookingUp = prvCollectAnswers( pxRace, 0U );
+        size_t uxStarted = 0U;
+        size_t uxActive = 0U;
+        size_t uxIndex;
+
+        if( xPollTime == 0U )
+        {
+            xPollTime = 1U;
+        }
+
+        if( ( xLookingUp != pdFALSE ) || ( pxRace->pxNext[ heINDEX_IPv6 ] != NULL ) || ( pxRace->pxNext[ heINDEX_IPv4 ] != NULL ) )
+        {
+            xSocketSet = FreeRTOS_CreateSocketSet();
+        }
+
+        if( xSocketSet != NULL )
+        {
+            TimeOut_t xTimeOut;
+            TickType_t xRemainingTime = xBlockTimeTicks;
+            TickType_t xLastStart = xTaskGetTickCount();
+
+            vTaskSetTimeOutState( &( xTimeOut ) );
+
+            for( ; ; )
+            {
+                TickType_t xNow = xTaskGetTickCount();
+                TickType_t xWaitTime;
+                const struct freertos_addrinfo * pxAddress = NULL;
+
+                if( ( uxStarted < ( size_t ) ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS ) &&
+                    ( ( uxActive == 0U ) || ( ( xNow - xLastStart ) >= xAttemptDelay ) ) )
+                {
+                    pxAddress = prvNextAddress( pxRace );
+                }
+
+                if( pxAddress != NULL )
+                {
+                    /* Start the next attempt. When it can not be started, the
+                     * one after it will be started in the next loop. */
+                    xAttempts[ uxStarted ] = prvStartAttempt( pxAddress, usPort, xSocketSet );
+
+                    if( xAttempts[ uxStarted ] != NULL )
+                    {
+                        uxActive++;
+                        xLastStart = xNow;
+                    }
+
+                    uxStarted++;
+                    continue;
+                }
+
+                if( ( ( uxActive == 0U ) && ( ( xLookingUp == pdFALSE ) || ( uxStarted >= ( size_t ) ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS ) ) ) ||
+                    ( xTaskCheckForTimeOut( &( xTimeOut ), &( xRemainingTime ) ) != pdFALSE ) )
+                {
+                    /* All attempts have failed, or the time is up. */
+                    break;
+                }
+
+                xWaitTime = xRemainingTime;
+
+                if( uxActive == 0U )
+                {
+                    /* Nothing to connect to yet, wait for the first answer. */
+                    if( xPollTime < xWaitTime )
+                    {
+                        xWaitTime = xPollTime;
+                    }
+
+                    xLookingUp = prvCollectAnswers( pxRace, xWaitTime );
+                    continue;
+                }
+
+                if( uxStarted < ( size_t ) ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS )
+                {
+                    TickType_t xElapsed = xNow - xLastStart;
+
+                    if( ( xElapsed < xAttemptDelay ) && ( ( xAttemptDelay - xElapsed ) < xWaitTime ) )
+                    {
+                        /* Wake up when the next attempt is due. */
+                        xWaitTime = xAttemptDelay - xElapsed;
+                    }
+                    else if( ( xElapsed >= xAttemptDelay ) && ( xPollTime < xWaitTime ) )
+                    {
+                        /* An attempt is due, but its address is still being
+                         * looked up. */
+                        xWaitTime = xPollTime;
+                    }
+                    else
+                    {
+                        /* Wait for the result of the attempts in progress. */
+                    }
+                }
+
+                ( void ) FreeRTOS_select( xSocketSet, xWaitTime );
+
+                for( uxIndex = 0U; uxIndex < uxStarted; uxIndex++ )
+                {
+                    Socket_t xSocket = xAttempts[ uxIndex ];
+
+                    if( xSocket != NULL )
+                    {
+                        BaseType_t xStatus = FreeRTOS_connstatus( xSocket );
+
+                        if( FreeRTOS_issocketconnected( xSocket ) > 0 )
+                        {
+                            xConnected = xSocket;
+                            xAttempts[ uxIndex ] = NULL;
+                            break;
+                        }
+
+                        if( ( xStatus == ( BaseType_t ) eCLOSED ) || ( xStatus == ( BaseType_t ) eCLOSE_WAIT ) )
+                        {
+                            /* The attempt was refused or timed out, start the
+                             * next one without waiting. */
+                            prvStopAttempt( xSocket, xSocketSet );
+                            xAttempts[ uxIndex ] = NULL;
+                            uxActive--;
+                            xLastStart = xTaskGetTickCount() - xAttemptDelay;
+                        }
+                    }
+                }
+
+                if( xConnected != FREERTOS_INVALID_SOCKET )
+                {
+                    break;
+                }
+
+                xLookingUp = prvCollectAnswers( pxRace, 0U );
+            }
+
+            for( uxIndex = 0U; uxIndex < uxStarted; uxIndex++ )
+            {
+                if( xAttempts[ uxIndex ] != NULL )
+                {
+                    prvStopAttempt( xAttempts[ uxIndex ], xSocketSet );
+                }
+            }
+
+            if( xConnected != FREERTOS_INVALID_SOCKET )
+            {
+                TickType_t xReceiveBlockTime = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
+
+                FreeRTOS_FD_CLR( xConnected, xSocketSet, ( EventBits_t ) eSELECT_ALL );
+                ( void ) FreeRTOS_setsockopt( xConnected, 0, FREERTOS_SO_RCVTIMEO, &( xReceiveBlockTime ), sizeof( xReceiveBlockTime ) );
+            }
+
+            FreeRTOS_DeleteSocketSet( xSocketSet );
+        }
+
+        return xConnected;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Connect a TCP socket to one of the addresses in a list, racing the
+ *        connection attempts as described in RFC 8305.
+ *
+ * @param[in] pxAddresses The addresses of the host, for instance as returned
+ *                        by FreeRTOS_getaddrinfo().
+ * @param[in] usPort The port number to connect to, host-endian.
+ * @param[in] xBlockTimeTicks The maximum time to wait for a connection.
+ *
+ * @return A connected socket, which uses the default time-outs, or
+ *         FREERTOS_INVALID_SOCKET when no attempt succeeded in time.
+ */
+    Socket_t FreeRTOS_connect_addrinfo( const struct freertos_addrinfo * pxAddresses,
+                                        uint16_t usPort,
+                                        TickType_t xBlockTimeTicks )
+    {
+        HappyEyeballs_t xRace;
+
+        ( void ) memset( &( xRace ), 0, sizeof( xRace ) );
+        xRace.pxNext[ heINDEX_IPv6 ] = prvNextOfFamily( pxAddresses, FREERTOS_AF_INET6 );
+        xRace.pxNext[ heINDEX_IPv4 ] = prvNextOfFamily( pxAddresses, FREERTOS_AF_INET4 );
+        xRace.xWantIPv6 = pdTRUE;
+
+        return prvRace( &( xRace ), usPort, xBlockTimeTicks );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start the look-up of the addresses of one family. When the
+ *        asynchronous resolver can not take the look-up, for instance for a
+ *        ".local" name, the addresses are looked up with FreeRTOS_getaddrinfo().
+ *
+ * @param[in] pxRace The race.
+ * @param[in] pcHostName The name of the host.
+ * @param[in] uxFamily Either heINDEX_IPv6 or heINDEX_IPv4.
+ */
+    static void prvStartLookUp( HappyEyeballs_t * pxRace,
+                                const char * pcHostName,
+                                size_t uxFamily )
+    {
+        BaseType_t xFamily = ( uxFamily == heINDEX_IPv6 ) ? FREERTOS_AF_INET6 : FREERTOS_AF_INET4;
+
+        pxRace->xLookUps[ uxFamily ] = FreeRTOS_DNSResolveStart( pcHostName, xFamily, NULL, NULL, 0U );
+
+        if( pxRace->xLookUps[ uxFamily ] == NULL )
+        {
+            struct freertos_addrinfo xHints;
+
+            ( void ) memset( &( xHints ), 0, sizeof( xHints ) );
+            xHints.ai_family = xFamily;
+
+            if( FreeRTOS_getaddrinfo( pcHostName, NULL, &( xHints ), &( pxRace->pxAnswers[ uxFamily ] ) ) != 0 )
+            {
+                pxRace->pxAnswers[ uxFamily ] = NULL;
+            }
+
+            pxRace->pxNext[ uxFamily ] = prvNextOfFamily( pxRace->pxAnswers[ uxFamily ], xFamily );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Look up the IPv6 and IPv4 addresses of a host and connect a TCP
+ *        socket to one of them. The AAAA and A queries are sent in parallel
+ *        by the asynchronous resolver, which uses the DNS cache when possible.
+ *        The first connection attempt is started as soon as either look-up
+ *        has found an address; the addresses of the other family join the
+ *        race when they arrive.
+ *
+ * @param[in] pcHostName The name of the host.
+ * @param[in] usPort The port number to connect to, host-endian.
+ * @param[in] xBlockTimeTicks The maximum time to wait for a connection,
+ *                            including the DNS look-ups.
+ *
+ * @return A connected socket, or FREERTOS_INVALID_SOCKET.
+ */
+    Socket_t FreeRTOS_connect_by_name( const char * pcHostName,
+                                       uint16_t usPort,
+                                       TickType_t xBlockTimeTicks )
+    {
+        HappyEyeballs_t xRace;
+        Socket_t xSocket;
+        size_t uxFamily;
+
+        ( void ) memset( &( xRace ), 0, sizeof( xRace ) );
+        xRace.xWantIPv6 = pdTRUE;
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            prvStartLookUp( &( xRace ), pcHostName, heINDEX_IPv6 );
+        #endif
+
+        #if ( ipconfigUSE_IPv4 != 0 )
+            prvStartLookUp( &( xRace ), pcHostName, heINDEX_IPv4 );
+        #endif
+
+        xSocket = prvRace( &( xRace ), usPort, xBlockTimeTicks );
+
+        for( uxFamily = 0U; uxFamily < heFAMILIES; uxFamily++ )
+        {
+            if( xRace.xLookUps[ uxFamily ] != NULL )
+            {
+                /* The race is over, cancel the look-up. */
+                FreeRTOS_DNSResolveRelease( xRace.xLookUps[ uxFamily ] );
+            }
+
+            if( xRace.pxAnswers[ uxFamily ] != NULL )
+            {
+                FreeRTOS_freeaddrinfo( xRace.pxAnswers[ uxFamily ] );
+            }
+        }
+
+        return xSocket;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigIS_ENABLED( ipconfigUSE_HAPPY_EYEBALLS ) */
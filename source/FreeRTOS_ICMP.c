@@ -176,8 +176,21 @@
             pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderSizePacket( pxNetworkBuffer ) );
             pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
 
-            /* calculate the ICMP checksum for an outgoing packet. */
-            ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxICMPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+            #if ( ipconfigUSE_INCREMENTAL_CHECKSUM != 0 )
+                /* ICMP has no pseudo header, only the type of the message has
+                 * changed.  It is the first byte of a 16-bit word. */
+                pxICMPHeader->usChecksum = usAdjustChecksum( pxICMPHeader->usChecksum,
+                                                             ( uint16_t ) ( ( uint16_t ) ipICMP_ECHO_REQUEST << 8 ),
+                                                             ( uint16_t ) ( ( uint16_t ) ipICMP_ECHO_REPLY << 8 ) );
+
+                /* An echo reply without identifier, sequence number and data
+                 * is all zero, its checksum must be calculated. */
+                if( pxICMPHeader->usChecksum == 0U )
+            #endif /* ipconfigUSE_INCREMENTAL_CHECKSUM != 0 */
+            {
+                /* calculate the ICMP checksum for an outgoing packet. */
+                ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxICMPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+            }
         }
         #else
         {
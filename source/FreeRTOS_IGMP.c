@@ -0,0 +1,1420 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_IGMP.c
+ * @brief Implements multicast group membership: IGMPv3 (RFC 3376) with IGMPv2
+ *        (RFC 2236) compatibility for IPv4, and MLDv2 (RFC 3810) with MLDv1
+ *        (RFC 2710) compatibility for IPv6.
+ *
+ * UDP sockets join and leave groups with FreeRTOS_setsockopt().  The groups are
+ * kept in a table, one entry per group and interface, with the number of sockets
+ * that joined it.  The sockets change that number with the scheduler suspended.
+ * Everything else is done by the IP-task: it programs the MAC filter of the
+ * interface when the first socket joins and when the last socket leaves, and it
+ * sends the reports and leave messages.  Only "exclude nothing" memberships
+ * (any-source multicast) are supported, so every group has a single record.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Timers.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_IGMP.h"
+#include "FreeRTOS_IP_Utils.h"
+#include "FreeRTOS_ND.h"
+#include "NetworkBufferManagement.h"
+#include "NetworkInterface.h"
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+
+/** @brief IGMP message types. */
+    #define igmpMEMBERSHIP_QUERY          ( 0x11U )
+    #define igmpV1_MEMBERSHIP_REPORT      ( 0x12U )
+    #define igmpV2_MEMBERSHIP_REPORT      ( 0x16U )
+    #define igmpV2_LEAVE_GROUP            ( 0x17U )
+    #define igmpV3_MEMBERSHIP_REPORT      ( 0x22U )
+
+/** @brief The length of an IGMPv1/v2 message, and the minimum length of an
+ *         IGMPv3 query. */
+    #define igmpV2_MESSAGE_LENGTH         ( 8U )
+    #define igmpV3_QUERY_MIN_LENGTH       ( 12U )
+
+/** @brief The length of an IGMPv3 report with one group record without sources. */
+    #define igmpV3_REPORT_LENGTH          ( 16U )
+
+/** @brief The length of an IPv4 header with a Router Alert option, RFC 2113. */
+    #define igmpIP_HEADER_LENGTH          ( ipSIZE_OF_IPv4_HEADER + 4U )
+
+/** @brief The length of an MLDv1 message, and of an MLDv2 report with one
+ *         multicast address record without sources. */
+    #define mldV1_MESSAGE_LENGTH          ( 24U )
+    #define mldV2_REPORT_LENGTH           ( 28U )
+
+/** @brief The minimum length of an MLDv2 query. */
+    #define mldV2_QUERY_MIN_LENGTH        ( 28U )
+
+/** @brief The length of the Hop-by-Hop options header with a Router Alert
+ *         option that precedes an MLD message, RFC 2711. */
+    #define mldHOP_BY_HOP_LENGTH          ( 8U )
+
+/** @brief Group record types of IGMPv3 and MLDv2 reports. */
+    #define multicastMODE_IS_EXCLUDE      ( 2U )
+    #define multicastCHANGE_TO_INCLUDE    ( 3U )
+    #define multicastCHANGE_TO_EXCLUDE    ( 4U )
+
+/** @brief The Robustness Variable: the number of times that a state-change
+ *         message is sent. */
+    #define multicastROBUSTNESS           ( 2U )
+
+/** @brief The Unsolicited Report Interval of IGMPv3 and MLDv2, and of the older
+ *         versions. */
+    #define multicastUNSOLICITED_MS       ( 1000U )
+    #define multicastUNSOLICITED_OLD_MS   ( 10000U )
+
+/** @brief The Older Version Querier Present Timeout: robustness times the query
+ *         interval of 125 seconds plus the query response interval of 10 seconds. */
+    #define multicastOLDER_QUERIER_MS     ( ( multicastROBUSTNESS * 125000U ) + 10000U )
+
+/** @brief The maximum response time that is used for an IGMPv1 query, which
+ *         has no such field. */
+    #define igmpV1_MAX_RESPONSE_MS        ( 10000U )
+
+/** @brief Convert milliseconds to periods of the multicast timer, rounding up. */
+    #define multicastPERIODS( ulMS )      ( ( ( ulMS ) + ( ipMULTICAST_TIMER_PERIOD_MS - 1U ) ) / ipMULTICAST_TIMER_PERIOD_MS )
+
+/** @brief Index of the IP family in ulOlderQuerierTimer[]. */
+    #define multicastFAMILY( xIsIPv6 )    ( ( ( xIsIPv6 ) != pdFALSE ) ? 1 : 0 )
+
+/** @brief The messages that can be sent for a group. */
+    typedef enum
+    {
+        eMulticastCurrentState, /**< A report in answer to a query. */
+        eMulticastJoin,         /**< A state-change report after joining. */
+        eMulticastLeave         /**< A leave message: IGMPv2 leave, MLDv1 done, or a change to "include nothing". */
+    } eMulticastMessage_t;
+
+/** @brief What the IP-task must do for a group after its entry was updated. */
+    typedef enum
+    {
+        eGroupNothing,     /**< Nothing to be done. */
+        eGroupAddFilter,   /**< Program the MAC filter, and send a state-change report. */
+        eGroupRemoveFilter,/**< Remove the group from the MAC filter, and send a leave message. */
+        eGroupSendJoin,    /**< Repeat the state-change report. */
+        eGroupSendCurrent, /**< Answer a query. */
+        eGroupSendLeave    /**< Repeat the leave message. */
+    } eGroupAction_t;
+
+/** @brief An entry of the multicast group table. */
+    typedef struct xMULTICAST_GROUP
+    {
+        IP_Address_t xGroupAddress;       /**< The group, an IPv4 address in network byte order or an IPv6 address. */
+        NetworkInterface_t * pxInterface; /**< The interface on which the group is joined, NULL when the entry is free. */
+        uint32_t ulReportTimer;           /**< Periods of the multicast timer until the next message, zero when none is scheduled. */
+        uint16_t usSocketCount;           /**< The number of sockets that have joined the group. */
+        uint8_t ucIsIPv6;                 /**< Non-zero for an IPv6 group. */
+        uint8_t ucJoined;                 /**< Non-zero when the group was added to the MAC filter. */
+        uint8_t ucChangesToSend;          /**< The number of state-change reports, or leave messages when not joined, still to be sent. */
+    } MulticastGroup_t;
+
+/** @brief The multicast group table.  The socket count is changed by the users
+ *         with the scheduler suspended.  The IP-task suspends the scheduler when
+ *         it updates or frees an entry. */
+    static MulticastGroup_t xMulticastGroups[ ipconfigMULTICAST_MAX_GROUPS ];
+
+/** @brief For IPv4 and IPv6, the number of timer periods during which an older
+ *         version querier is present, only accessed by the IP-task. */
+    static uint32_t ulOlderQuerierTimer[ 2 ];
+
+/** @brief pdTRUE while the multicast timer is running, only accessed by the IP-task. */
+    static BaseType_t xMulticastTimerRunning = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a group must be reported.  Membership of the all-systems
+ *        group 224.0.0.1 and of the link-local all-nodes group ff02::1 is
+ *        never reported.
+ *
+ * @param[in] pxGroup The entry of the group.
+ *
+ * @return pdTRUE when messages must be sent for the group.
+ */
+    static BaseType_t prvIsReported( const MulticastGroup_t * pxGroup )
+    {
+        BaseType_t xReturn = pdTRUE;
+
+        #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+            if( pxGroup->ucIsIPv6 != 0U )
+            {
+                if( memcmp( pxGroup->xGroupAddress.xIP_IPv6.ucBytes, pcLOCAL_ALL_NODES_MULTICAST_IP, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                {
+                    xReturn = pdFALSE;
+                }
+            }
+            else
+        #endif /* ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) ) */
+        {
+            if( pxGroup->xGroupAddress.ulIP_IPv4 == FreeRTOS_inet_addr_quick( 224, 0, 0, 1 ) )
+            {
+                xReturn = pdFALSE;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get a random delay of at least one period of the multicast timer.
+ *
+ * @param[in] ulMaxPeriods The maximum delay, in periods of the multicast timer.
+ *
+ * @return The delay, between 1 and ulMaxPeriods.
+ */
+    static uint32_t prvRandomDelay( uint32_t ulMaxPeriods )
+    {
+        uint32_t ulRandom = 0U;
+        uint32_t ulDelay = 1U;
+
+        if( ulMaxPeriods > 1U )
+        {
+            if( xApplicationGetRandomNumber( &( ulRandom ) ) == pdFALSE )
+            {
+                ulRandom = 0U;
+            }
+
+            ulDelay += ulRandom % ulMaxPeriods;
+        }
+
+        return ulDelay;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if an older version of the protocol must be used.
+ *
+ * @param[in] xIsIPv6 pdTRUE for MLD, pdFALSE for IGMP.
+ *
+ * @return pdTRUE when IGMPv2 or MLDv1 must be used.
+ */
+    static BaseType_t prvUseOlderVersion( BaseType_t xIsIPv6 )
+    {
+        return ( ulOlderQuerierTimer[ multicastFAMILY( xIsIPv6 ) ] != 0U ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start the multicast timer when a report or leave message is scheduled,
+ *        or when an older version querier is present.  Otherwise stop it.
+ */
+    static void prvUpdateTimer( void )
+    {
+        BaseType_t xNeeded = pdFALSE;
+        BaseType_t xIndex;
+
+        if( ( ulOlderQuerierTimer[ 0 ] != 0U ) || ( ulOlderQuerierTimer[ 1 ] != 0U ) )
+        {
+            xNeeded = pdTRUE;
+        }
+
+        for( xIndex = 0; ( xIndex < ( BaseType_t ) ipconfigMULTICAST_MAX_GROUPS ) && ( xNeeded == pdFALSE ); xIndex++ )
+        {
+            if( ( xMulticastGroups[ xIndex ].pxInterface != NULL ) && ( xMulticastGroups[ xIndex ].ulReportTimer != 0U ) )
+            {
+                xNeeded = pdTRUE;
+            }
+        }
+
+        if( xNeeded == pdFALSE )
+        {
+            vIPSetMulticastTimerEnableState( pdFALSE );
+            xMulticastTimerRunning = pdFALSE;
+        }
+        else if( xMulticastTimerRunning == pdFALSE )
+        {
+            vMulticastTimerReload( pdMS_TO_TICKS( ipMULTICAST_TIMER_PERIOD_MS ) );
+            xMulticastTimerRunning = pdTRUE;
+        }
+        else
+        {
+            /* The timer is already running. */
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the multicast MAC-address of a group, see RFC 1112 section
+ *        6.4 and RFC 2464 section 7.
+ *
+ * @param[in] pxGroup The entry of the group.
+ * @param[out] pxMACAddress Where to store the MAC-address.
+ */
+    static void prvGroupMACAddress( const MulticastGroup_t * pxGroup,
+                                    MACAddress_t * pxMACAddress )
+    {
+        #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+            if( pxGroup->ucIsIPv6 != 0U )
+            {
+                vSetMultiCastIPv6MacAddress( &( pxGroup->xGroupAddress.xIP_IPv6 ), pxMACAddress );
+            }
+            else
+        #endif /* ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) ) */
+        {
+            vSetMultiCastIPv4MacAddress( pxGroup->xGroupAddress.ulIP_IPv4, pxMACAddress );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a group to the MAC filter of its interface, or remove it.  The
+ *        driver keeps count of the calls for each MAC-address.
+ *
+ * @param[in] pxGroup The entry of the group.
+ * @param[in] xAdd pdTRUE to add the group, pdFALSE to remove it.
+ */
+    static void prvSetMACFilter( const MulticastGroup_t * pxGroup,
+                                 BaseType_t xAdd )
+    {
+        NetworkInterface_t * pxInterface = pxGroup->pxInterface;
+        MACAddress_t xMACAddress;
+
+        prvGroupMACAddress( pxGroup, &( xMACAddress ) );
+
+        if( xAdd != pdFALSE )
+        {
+            if( pxInterface->pfAddAllowedMAC != NULL )
+            {
+                pxInterface->pfAddAllowedMAC( pxInterface, xMACAddress.ucBytes );
+            }
+        }
+        else
+        {
+            if( pxInterface->pfRemoveAllowedMAC != NULL )
+            {
+                pxInterface->pfRemoveAllowedMAC( pxInterface, xMACAddress.ucBytes );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the checksums of a generated message and pass it to the
+ *        interface.  The network buffer is released.
+ *
+ * @param[in] pxNetworkBuffer The message, with all fields filled in.
+ */
+    static void prvOutputMessage( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkInterface_t * pxInterface = pxNetworkBuffer->pxInterface;
+
+        #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+        {
+            ( void ) usGenerateProtocolChecksum( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, pdTRUE );
+        }
+        #endif
+
+        #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+        {
+            vPrepareTxChecksums( pxInterface, pxNetworkBuffer );
+        }
+        #endif
+
+        #if ( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 )
+        {
+            if( pxNetworkBuffer->xDataLength < ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES )
+            {
+                ( void ) memset( &( pxNetworkBuffer->pucEthernetBuffer[ pxNetworkBuffer->xDataLength ] ), 0, ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES - pxNetworkBuffer->xDataLength );
+                pxNetworkBuffer->xDataLength = ( size_t ) ipconfigETHERNET_MINIMUM_PACKET_BYTES;
+            }
+        }
+        #endif
+
+        if( pxInterface->bits.bInterfaceUp != pdFALSE_UNSIGNED )
+        {
+            iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+            ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, pdTRUE );
+        }
+        else
+        {
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) )
+
+/**
+ * @brief Send an IGMP report or leave message for a group.  The first IPv4
+ *        end-point of the interface that has an address is used as the source.
+ *
+ * @param[in] pxGroup The entry of the group.
+ * @param[in] eMessage The kind of message.
+ */
+        static void prvSendIGMP( const MulticastGroup_t * pxGroup,
+                                 eMulticastMessage_t eMessage )
+        {
+            NetworkEndPoint_t * pxEndPoint;
+            NetworkBufferDescriptor_t * pxNetworkBuffer = NULL;
+            BaseType_t xOlder = prvUseOlderVersion( pdFALSE );
+            size_t uxIGMPLength = ( xOlder != pdFALSE ) ? igmpV2_MESSAGE_LENGTH : igmpV3_REPORT_LENGTH;
+            size_t uxPacketSize = ipSIZE_OF_ETH_HEADER + igmpIP_HEADER_LENGTH + uxIGMPLength;
+
+            for( pxEndPoint = FreeRTOS_FirstEndPoint( pxGroup->pxInterface );
+                 pxEndPoint != NULL;
+                 pxEndPoint = FreeRTOS_NextEndPoint( pxGroup->pxInterface, pxEndPoint ) )
+            {
+                if( ( pxEndPoint->bits.bIPv6 == pdFALSE_UNSIGNED ) && ( pxEndPoint->ipv4_settings.ulIPAddress != 0U ) )
+                {
+                    break;
+                }
+            }
+
+            if( pxEndPoint != NULL )
+            {
+                pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxPacketSize, 0U );
+            }
+
+            if( pxNetworkBuffer != NULL )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                EthernetHeader_t * pxEthernetHeader = ( ( EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                IPHeader_t * pxIPHeader = ( ( IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+                uint8_t * pucOption = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER ] );
+                uint8_t * pucIGMP = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + igmpIP_HEADER_LENGTH ] );
+                uint32_t ulDestination = pxGroup->xGroupAddress.ulIP_IPv4;
+                MACAddress_t xMACAddress;
+
+                ( void ) memset( pucIGMP, 0, uxIGMPLength );
+
+                if( xOlder != pdFALSE )
+                {
+                    /* IGMPv2: a report is sent to the group, a leave to all routers. */
+                    if( eMessage == eMulticastLeave )
+                    {
+                        pucIGMP[ 0 ] = ( uint8_t ) igmpV2_LEAVE_GROUP;
+                        ulDestination = FreeRTOS_inet_addr_quick( 224, 0, 0, 2 );
+                    }
+                    else
+                    {
+                        pucIGMP[ 0 ] = ( uint8_t ) igmpV2_MEMBERSHIP_REPORT;
+                    }
+
+                    ( void ) memcpy( &( pucIGMP[ 4 ] ), &( pxGroup->xGroupAddress.ulIP_IPv4 ), sizeof( uint32_t ) );
+                }
+                else
+                {
+                    /* IGMPv3: a report with one group record is sent to 224.0.0.22. */
+                    pucIGMP[ 0 ] = ( uint8_t ) igmpV3_MEMBERSHIP_REPORT;
+                    pucIGMP[ 7 ] = 1U;
+
+                    if( eMessage == eMulticastLeave )
+                    {
+                        pucIGMP[ 8 ] = ( uint8_t ) multicastCHANGE_TO_INCLUDE;
+                    }
+                    else if( eMessage == eMulticastJoin )
+                    {
+                        pucIGMP[ 8 ] = ( uint8_t ) multicastCHANGE_TO_EXCLUDE;
+                    }
+                    else
+                    {
+                        pucIGMP[ 8 ] = ( uint8_t ) multicastMODE_IS_EXCLUDE;
+                    }
+
+                    ( void ) memcpy( &( pucIGMP[ 12 ] ), &( pxGroup->xGroupAddress.ulIP_IPv4 ), sizeof( uint32_t ) );
+                    ulDestination = FreeRTOS_inet_addr_quick( 224, 0, 0, 22 );
+                }
+
+                vSetMultiCastIPv4MacAddress( ulDestination, &( xMACAddress ) );
+                ( void ) memcpy( pxEthernetHeader->xDestinationAddress.ucBytes, xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                ( void ) memcpy( pxEthernetHeader->xSourceAddress.ucBytes, pxEndPoint->xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                pxEthernetHeader->usFrameType = ipIPv4_FRAME_TYPE;
+
+                /* Internetwork control, a TTL of 1, and a Router Alert option. */
+                pxIPHeader->ucVersionHeaderLength = ( uint8_t ) ( 0x40U | ( igmpIP_HEADER_LENGTH >> 2 ) );
+                pxIPHeader->ucDifferentiatedServicesCode = 0xC0U;
+                pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( igmpIP_HEADER_LENGTH + uxIGMPLength ) );
+                pxIPHeader->usIdentification = FreeRTOS_htons( usPacketIdentifier );
+                usPacketIdentifier++;
+                pxIPHeader->usFragmentOffset = 0U;
+                pxIPHeader->ucTimeToLive = 1U;
+                pxIPHeader->ucProtocol = ( uint8_t ) ipPROTOCOL_IGMP;
+                pxIPHeader->ulSourceIPAddress = pxEndPoint->ipv4_settings.ulIPAddress;
+                pxIPHeader->ulDestinationIPAddress = ulDestination;
+                pucOption[ 0 ] = 0x94U;
+                pucOption[ 1 ] = 0x04U;
+                pucOption[ 2 ] = 0x00U;
+                pucOption[ 3 ] = 0x00U;
+
+                pxIPHeader->usHeaderChecksum = 0U;
+                #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
+                {
+                    pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), igmpIP_HEADER_LENGTH );
+                    pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+                }
+                #endif
+
+                pxNetworkBuffer->pxInterface = pxGroup->pxInterface;
+                pxNetworkBuffer->pxEndPoint = pxEndPoint;
+                pxNetworkBuffer->xDataLength = uxPacketSize;
+
+                prvOutputMessage( pxNetworkBuffer );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) ) */
+
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+
+/**
+ * @brief Send an MLD report or done message for a group.  The link-local
+ *        address of an IPv6 end-point of the interface is used as the source,
+ *        or the unspecified address when there is none yet.
+ *
+ * @param[in] pxGroup The entry of the group.
+ * @param[in] eMessage The kind of message.
+ */
+        static void prvSendMLD( const MulticastGroup_t * pxGroup,
+                                eMulticastMessage_t eMessage )
+        {
+            NetworkEndPoint_t * pxEndPoint;
+            NetworkEndPoint_t * pxFirstIPv6 = NULL;
+            NetworkBufferDescriptor_t * pxNetworkBuffer = NULL;
+            BaseType_t xOlder = prvUseOlderVersion( pdTRUE );
+            size_t uxMLDLength = ( xOlder != pdFALSE ) ? mldV1_MESSAGE_LENGTH : mldV2_REPORT_LENGTH;
+            size_t uxPacketSize = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + mldHOP_BY_HOP_LENGTH + uxMLDLength;
+
+            for( pxEndPoint = FreeRTOS_FirstEndPoint( pxGroup->pxInterface );
+                 pxEndPoint != NULL;
+                 pxEndPoint = FreeRTOS_NextEndPoint( pxGroup->pxInterface, pxEndPoint ) )
+            {
+                if( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED )
+                {
+                    if( pxFirstIPv6 == NULL )
+                    {
+                        pxFirstIPv6 = pxEndPoint;
+                    }
+
+                    if( xIPv6_GetIPType( &( pxEndPoint->ipv6_settings.xIPAddress ) ) == eIPv6_LinkLocal )
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if( pxEndPoint == NULL )
+            {
+                pxEndPoint = pxFirstIPv6;
+            }
+
+            if( pxEndPoint != NULL )
+            {
+                pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxPacketSize, 0U );
+            }
+
+            if( pxNetworkBuffer != NULL )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                EthernetHeader_t * pxEthernetHeader = ( ( EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                IPHeader_IPv6_t * pxIPHeader = ( ( IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+                uint8_t * pucHopByHop = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ] );
+                uint8_t * pucMLD = &( pucHopByHop[ mldHOP_BY_HOP_LENGTH ] );
+                IPv6_Address_t xDestination;
+                MACAddress_t xMACAddress;
+
+                ( void ) memset( pucMLD, 0, uxMLDLength );
+                ( void ) memset( xDestination.ucBytes, 0, sizeof( xDestination.ucBytes ) );
+                xDestination.ucBytes[ 0 ] = 0xffU;
+                xDestination.ucBytes[ 1 ] = 0x02U;
+
+                if( xOlder != pdFALSE )
+                {
+                    /* MLDv1: a report is sent to the group, a done to all routers. */
+                    if( eMessage == eMulticastLeave )
+                    {
+                        pucMLD[ 0 ] = ipICMP_MLD_DONE_IPv6;
+                        xDestination.ucBytes[ 15 ] = 0x02U;
+                    }
+                    else
+                    {
+                        pucMLD[ 0 ] = ipICMP_MLD_REPORT_IPv6;
+                        ( void ) memcpy( xDestination.ucBytes, pxGroup->xGroupAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                    }
+
+                    ( void ) memcpy( &( pucMLD[ 8 ] ), pxGroup->xGroupAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                }
+                else
+                {
+                    /* MLDv2: a report with one address record is sent to ff02::16. */
+                    pucMLD[ 0 ] = ipICMP_MLDv2_REPORT_IPv6;
+                    pucMLD[ 7 ] = 1U;
+
+                    if( eMessage == eMulticastLeave )
+                    {
+                        pucMLD[ 8 ] = ( uint8_t ) multicastCHANGE_TO_INCLUDE;
+                    }
+                    else if( eMessage == eMulticastJoin )
+                    {
+                        pucMLD[ 8 ] = ( uint8_t ) multicastCHANGE_TO_EXCLUDE;
+                    }
+                    else
+                    {
+                        pucMLD[ 8 ] = ( uint8_t ) multicastMODE_IS_EXCLUDE;
+                    }
+
+                    ( void ) memcpy( &( pucMLD[ 12 ] ), pxGroup->xGroupAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                    xDestination.ucBytes[ 15 ] = 0x16U;
+                }
+
+                vSetMultiCastIPv6MacAddress( &( xDestination ), &( xMACAddress ) );
+                ( void ) memcpy( pxEthernetHeader->xDestinationAddress.ucBytes, xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                ( void ) memcpy( pxEthernetHeader->xSourceAddress.ucBytes, pxEndPoint->xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+                pxEthernetHeader->usFrameType = ipIPv6_FRAME_TYPE;
+
+                pxIPHeader->ucVersionTrafficClass = 0x60U;
+                pxIPHeader->ucTrafficClassFlow = 0U;
+                pxIPHeader->usFlowLabel = 0U;
+                pxIPHeader->usPayloadLength = FreeRTOS_htons( ( uint16_t ) ( mldHOP_BY_HOP_LENGTH + uxMLDLength ) );
+                pxIPHeader->ucNextHeader = ( uint8_t ) ipIPv6_EXT_HEADER_HOP_BY_HOP;
+                pxIPHeader->ucHopLimit = 1U;
+
+                if( xIPv6_GetIPType( &( pxEndPoint->ipv6_settings.xIPAddress ) ) == eIPv6_LinkLocal )
+                {
+                    ( void ) memcpy( pxIPHeader->xSourceAddress.ucBytes, pxEndPoint->ipv6_settings.xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                }
+                else
+                {
+                    ( void ) memset( pxIPHeader->xSourceAddress.ucBytes, 0, ipSIZE_OF_IPv6_ADDRESS );
+                }
+
+                ( void ) memcpy( pxIPHeader->xDestinationAddress.ucBytes, xDestination.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+                /* Hop-by-Hop options: a Router Alert for MLD, and a PadN option. */
+                pucHopByHop[ 0 ] = ipPROTOCOL_ICMP_IPv6;
+                pucHopByHop[ 1 ] = 0U;
+                pucHopByHop[ 2 ] = 0x05U;
+                pucHopByHop[ 3 ] = 0x02U;
+                pucHopByHop[ 4 ] = 0x00U;
+                pucHopByHop[ 5 ] = 0x00U;
+                pucHopByHop[ 6 ] = 0x01U;
+                pucHopByHop[ 7 ] = 0x00U;
+
+                pxNetworkBuffer->pxInterface = pxGroup->pxInterface;
+                pxNetworkBuffer->pxEndPoint = pxEndPoint;
+                pxNetworkBuffer->xDataLength = uxPacketSize;
+
+                prvOutputMessage( pxNetworkBuffer );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) ) */
+
+/**
+ * @brief Send a report or leave message for a group, unless it is a group that
+ *        is never reported.
+ *
+ * @param[in] pxGroup A copy of the entry of the group.
+ * @param[in] eMessage The kind of message.
+ */
+    static void prvSendMessage( const MulticastGroup_t * pxGroup,
+                                eMulticastMessage_t eMessage )
+    {
+        if( prvIsReported( pxGroup ) != pdFALSE )
+        {
+            #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+                if( pxGroup->ucIsIPv6 != 0U )
+                {
+                    prvSendMLD( pxGroup, eMessage );
+                }
+            #endif
+
+            #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) )
+                if( pxGroup->ucIsIPv6 == 0U )
+                {
+                    prvSendIGMP( pxGroup, eMessage );
+                }
+            #endif
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Schedule the next state-change message of a group, or free its entry
+ *        when it has left and all leave messages were sent.  Called with the
+ *        scheduler suspended.
+ *
+ * @param[in] pxGroup The entry of the group.
+ */
+    static void prvScheduleChange( MulticastGroup_t * pxGroup )
+    {
+        uint32_t ulInterval;
+
+        if( pxGroup->ucChangesToSend != 0U )
+        {
+            if( prvUseOlderVersion( ( pxGroup->ucIsIPv6 != 0U ) ? pdTRUE : pdFALSE ) != pdFALSE )
+            {
+                ulInterval = multicastPERIODS( multicastUNSOLICITED_OLD_MS );
+            }
+            else
+            {
+                ulInterval = multicastPERIODS( multicastUNSOLICITED_MS );
+            }
+
+            pxGroup->ulReportTimer = prvRandomDelay( ulInterval );
+        }
+        else
+        {
+            pxGroup->ulReportTimer = 0U;
+
+            if( ( pxGroup->ucJoined == 0U ) && ( pxGroup->usSocketCount == 0U ) )
+            {
+                pxGroup->pxInterface = NULL;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Perform an action for a group, after its entry was updated.
+ *
+ * @param[in] pxGroup A copy of the entry of the group.
+ * @param[in] eAction The action.
+ */
+    static void prvGroupAction( const MulticastGroup_t * pxGroup,
+                                eGroupAction_t eAction )
+    {
+        switch( eAction )
+        {
+            case eGroupAddFilter:
+                prvSetMACFilter( pxGroup, pdTRUE );
+                prvSendMessage( pxGroup, eMulticastJoin );
+                break;
+
+            case eGroupRemoveFilter:
+                prvSetMACFilter( pxGroup, pdFALSE );
+                prvSendMessage( pxGroup, eMulticastLeave );
+                break;
+
+            case eGroupSendJoin:
+                prvSendMessage( pxGroup, eMulticastJoin );
+                break;
+
+            case eGroupSendCurrent:
+                prvSendMessage( pxGroup, eMulticastCurrentState );
+                break;
+
+            case eGroupSendLeave:
+                prvSendMessage( pxGroup, eMulticastLeave );
+                break;
+
+            case eGroupNothing:
+            default:
+                /* Nothing to do. */
+                break;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find a group in the table.  Called with the scheduler suspended.
+ *
+ * @param[in] pxGroupAddress The address of the group.
+ * @param[in] xIsIPv6 pdTRUE for an IPv6 group.
+ * @param[in] pxInterface The interface.
+ *
+ * @return The index of the entry, or -1 when the group is not in the table.
+ */
+    static BaseType_t prvFindGroup( const IP_Address_t * pxGroupAddress,
+                                    BaseType_t xIsIPv6,
+                                    const NetworkInterface_t * pxInterface )
+    {
+        BaseType_t xIndex;
+        BaseType_t xFound = -1;
+
+        for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_MAX_GROUPS; xIndex++ )
+        {
+            const MulticastGroup_t * pxGroup = &( xMulticastGroups[ xIndex ] );
+
+            if( ( pxGroup->pxInterface == pxInterface ) &&
+                ( ( ( pxGroup->ucIsIPv6 != 0U ) ? pdTRUE : pdFALSE ) == xIsIPv6 ) )
+            {
+                #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+                    if( xIsIPv6 != pdFALSE )
+                    {
+                        if( memcmp( pxGroup->xGroupAddress.xIP_IPv6.ucBytes, pxGroupAddress->xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                        {
+                            xFound = xIndex;
+                            break;
+                        }
+                    }
+                    else
+                #endif /* ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) ) */
+                {
+                    if( pxGroup->xGroupAddress.ulIP_IPv4 == pxGroupAddress->ulIP_IPv4 )
+                    {
+                        xFound = xIndex;
+                        break;
+                    }
+                }
+            }
+        }
+
+        return xFound;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take a socket out of a group.  Called with the scheduler suspended.
+ *
+ * @param[in] pxSocket The socket.
+ * @param[in] xIndex The index of the entry of the group.
+ *
+ * @return pdTRUE when the socket was a member of the group.
+ */
+    static BaseType_t prvDropMembership( FreeRTOS_Socket_t * pxSocket,
+                                         BaseType_t xIndex )
+    {
+        uint32_t ulMask = ( ( uint32_t ) 1U ) << xIndex;
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pxSocket->u.xUDP.ulMulticastGroups & ulMask ) != 0U )
+        {
+            pxSocket->u.xUDP.ulMulticastGroups &= ~ulMask;
+            xMulticastGroups[ xIndex ].usSocketCount--;
+
+            if( ( xMulticastGroups[ xIndex ].usSocketCount == 0U ) &&
+                ( xMulticastGroups[ xIndex ].ucJoined == 0U ) &&
+                ( xMulticastGroups[ xIndex ].ucChangesToSend == 0U ) )
+            {
+                /* The IP-task has not joined the group yet. */
+                xMulticastGroups[ xIndex ].pxInterface = NULL;
+            }
+
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Let a UDP socket join a multicast group on an interface.  The socket
+ *        is counted at once, the IP-task programs the MAC filter and sends the
+ *        reports.
+ *
+ * @param[in] pxSocket The UDP socket.
+ * @param[in] pxGroupAddress The address of the group, which must be multicast.
+ * @param[in] xIsIPv6 pdTRUE for an IPv6 group.
+ * @param[in] pxInterface The interface on which the group is joined.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EADDRINUSE when the socket already
+ *         joined the group, or -pdFREERTOS_ERRNO_ENOBUFS when the group table
+ *         is full or the IP-task could not be informed.
+ */
+    BaseType_t xMulticastJoinGroup( FreeRTOS_Socket_t * pxSocket,
+                                    const IP_Address_t * pxGroupAddress,
+                                    BaseType_t xIsIPv6,
+                                    NetworkInterface_t * pxInterface )
+    {
+        BaseType_t xReturn = 0;
+        BaseType_t xIndex;
+
+        vTaskSuspendAll();
+        {
+            xIndex = prvFindGroup( pxGroupAddress, xIsIPv6, pxInterface );
+
+            if( xIndex < 0 )
+            {
+                for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_MAX_GROUPS; xIndex++ )
+                {
+                    if( xMulticastGroups[ xIndex ].pxInterface == NULL )
+                    {
+                        ( void ) memset( &( xMulticastGroups[ xIndex ] ), 0, sizeof( xMulticastGroups[ xIndex ] ) );
+                        ( void ) memcpy( &( xMulticastGroups[ xIndex ].xGroupAddress ), pxGroupAddress, sizeof( IP_Address_t ) );
+                        xMulticastGroups[ xIndex ].ucIsIPv6 = ( xIsIPv6 != pdFALSE ) ? 1U : 0U;
+                        xMulticastGroups[ xIndex ].pxInterface = pxInterface;
+                        break;
+                    }
+                }
+            }
+
+            if( xIndex >= ( BaseType_t ) ipconfigMULTICAST_MAX_GROUPS )
+            {
+                xReturn = -pdFREERTOS_ERRNO_ENOBUFS;
+            }
+            else if( ( pxSocket->u.xUDP.ulMulticastGroups & ( ( ( uint32_t ) 1U ) << xIndex ) ) != 0U )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EADDRINUSE;
+            }
+            else
+            {
+                pxSocket->u.xUDP.ulMulticastGroups |= ( ( uint32_t ) 1U ) << xIndex;
+                xMulticastGroups[ xIndex ].usSocketCount++;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xReturn == 0 )
+        {
+            if( xSendEventToIPTask( eMulticastEvent ) != pdPASS )
+            {
+                vTaskSuspendAll();
+                {
+                    ( void ) prvDropMembership( pxSocket, xIndex );
+                }
+                ( void ) xTaskResumeAll();
+
+                xReturn = -pdFREERTOS_ERRNO_ENOBUFS;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Let a UDP socket leave a multicast group.  When it was the last
+ *        member, the IP-task removes the group from the MAC filter and sends
+ *        the leave messages.
+ *
+ * @param[in] pxSocket The UDP socket.
+ * @param[in] pxGroupAddress The address of the group.
+ * @param[in] xIsIPv6 pdTRUE for an IPv6 group.
+ * @param[in] pxInterface The interface on which the group was joined.
+ *
+ * @return 0 on success, or -pdFREERTOS_ERRNO_EADDRNOTAVAIL when the socket is
+ *         not a member of the group.
+ */
+    BaseType_t xMulticastLeaveGroup( FreeRTOS_Socket_t * pxSocket,
+                                     const IP_Address_t * pxGroupAddress,
+                                     BaseType_t xIsIPv6,
+                                     const NetworkInterface_t * pxInterface )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EADDRNOTAVAIL;
+        BaseType_t xIndex;
+
+        vTaskSuspendAll();
+        {
+            xIndex = prvFindGroup( pxGroupAddress, xIsIPv6, pxInterface );
+
+            if( ( xIndex >= 0 ) && ( prvDropMembership( pxSocket, xIndex ) != pdFALSE ) )
+            {
+                xReturn = 0;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        if( xReturn == 0 )
+        {
+            /* When the event can not be sent, the group will be left at the
+             * next event. */
+            ( void ) xSendEventToIPTask( eMulticastEvent );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Drop all the memberships of a UDP socket that is being closed.
+ *        Called by the IP-task.
+ *
+ * @param[in] pxSocket The socket.
+ */
+    void vMulticastSocketClosed( FreeRTOS_Socket_t * pxSocket )
+    {
+        BaseType_t xIndex;
+
+        if( pxSocket->u.xUDP.ulMulticastGroups != 0U )
+        {
+            vTaskSuspendAll();
+            {
+                for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_MAX_GROUPS; xIndex++ )
+                {
+                    ( void ) prvDropMembership( pxSocket, xIndex );
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            vMulticastHandleEvent();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Bring the MAC filters in line with the socket counts of the groups:
+ *        a group that got its first member is added to the filter and reported,
+ *        a group that lost its last member is removed and left.
+ */
+    void vMulticastHandleEvent( void )
+    {
+        BaseType_t xIndex;
+
+        for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_MAX_GROUPS; xIndex++ )
+        {
+            MulticastGroup_t * pxGroup = &( xMulticastGroups[ xIndex ] );
+            MulticastGroup_t xCopy;
+            eGroupAction_t eAction = eGroupNothing;
+
+            vTaskSuspendAll();
+            {
+                if( pxGroup->pxInterface != NULL )
+                {
+                    if( ( pxGroup->usSocketCount != 0U ) && ( pxGroup->ucJoined == 0U ) )
+                    {
+                        /* Send the first report now, and repeat it later. */
+                        eAction = eGroupAddFilter;
+                        pxGroup->ucJoined = 1U;
+                        pxGroup->ucChangesToSend = ( uint8_t ) ( multicastROBUSTNESS - 1U );
+                    }
+                    else if( ( pxGroup->usSocketCount == 0U ) && ( pxGroup->ucJoined != 0U ) )
+                    {
+                        /* IGMPv2 and MLDv1 send a single leave message. */
+                        eAction = eGroupRemoveFilter;
+                        pxGroup->ucJoined = 0U;
+
+                        if( prvUseOlderVersion( ( pxGroup->ucIsIPv6 != 0U ) ? pdTRUE : pdFALSE ) != pdFALSE )
+                        {
+                            pxGroup->ucChangesToSend = 0U;
+                        }
+                        else
+                        {
+                            pxGroup->ucChangesToSend = ( uint8_t ) ( multicastROBUSTNESS - 1U );
+                        }
+                    }
+                    else
+                    {
+                        /* The group did not change. */
+                    }
+
+                    if( eAction != eGroupNothing )
+                    {
+                        ( void ) memcpy( &( xCopy ), pxGroup, sizeof( xCopy ) );
+                        prvScheduleChange( pxGroup );
+                    }
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( eAction != eGroupNothing )
+            {
+                prvGroupAction( &( xCopy ), eAction );
+            }
+        }
+
+        prvUpdateTimer();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called every ipMULTICAST_TIMER_PERIOD_MS while messages are scheduled:
+ *        send the messages that are due.
+ */
+    void vMulticastCheck( void )
+    {
+        BaseType_t xIndex;
+
+        for( xIndex = 0; xIndex < 2; xIndex++ )
+        {
+            if( ulOlderQuerierTimer[ xIndex ] != 0U )
+            {
+                ulOlderQuerierTimer[ xIndex ]--;
+            }
+        }
+
+        for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_MAX_GROUPS; xIndex++ )
+        {
+            MulticastGroup_t * pxGroup = &( xMulticastGroups[ xIndex ] );
+            MulticastGroup_t xCopy;
+            eGroupAction_t eAction = eGroupNothing;
+
+            vTaskSuspendAll();
+            {
+                if( ( pxGroup->pxInterface != NULL ) && ( pxGroup->ulReportTimer != 0U ) )
+                {
+                    pxGroup->ulReportTimer--;
+
+                    if( pxGroup->ulReportTimer == 0U )
+                    {
+                        if( pxGroup->ucJoined != 0U )
+                        {
+                            if( pxGroup->ucChangesToSend != 0U )
+                            {
+                                pxGroup->ucChangesToSend--;
+                                eAction = eGroupSendJoin;
+                            }
+                            else
+                            {
+                                eAction = eGroupSendCurrent;
+                            }
+                        }
+                        else if( pxGroup->ucChangesToSend != 0U )
+                        {
+                            pxGroup->ucChangesToSend--;
+                            eAction = eGroupSendLeave;
+                        }
+                        else
+                        {
+                            /* Nothing left to send. */
+                        }
+
+                        ( void ) memcpy( &( xCopy ), pxGroup, sizeof( xCopy ) );
+                        prvScheduleChange( pxGroup );
+                    }
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( eAction != eGroupNothing )
+            {
+                prvGroupAction( &( xCopy ), eAction );
+            }
+        }
+
+        prvUpdateTimer();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief An end-point went up: its address may be new, so report the groups
+ *        of its IP family on its interface again.
+ *
+ * @param[in] pxEndPoint The end-point that went up.
+ */
+    void vMulticastNetworkUp( const NetworkEndPoint_t * pxEndPoint )
+    {
+        BaseType_t xIndex;
+        uint8_t ucIsIPv6 = ( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED ) ? 1U : 0U;
+
+        vTaskSuspendAll();
+        {
+            for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_MAX_GROUPS; xIndex++ )
+            {
+                MulticastGroup_t * pxGroup = &( xMulticastGroups[ xIndex ] );
+
+                if( ( pxGroup->pxInterface == pxEndPoint->pxNetworkInterface ) &&
+                    ( pxGroup->ucIsIPv6 == ucIsIPv6 ) &&
+                    ( pxGroup->ucJoined != 0U ) )
+                {
+                    pxGroup->ucChangesToSend = ( uint8_t ) multicastROBUSTNESS;
+                    pxGroup->ulReportTimer = 1U;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        prvUpdateTimer();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A query was received: schedule a report for every group that is asked
+ *        for, at a random moment within the maximum response time.  A report
+ *        that is already scheduled earlier is kept.
+ *
+ * @param[in] pxInterface The interface on which the query was received.
+ * @param[in] xIsIPv6 pdTRUE for an MLD query.
+ * @param[in] pxGroupAddress The group that is asked for, or NULL for a general query.
+ * @param[in] ulMaxResponseMS The maximum response time in milliseconds.
+ */
+    static void prvScheduleQueryReports( const NetworkInterface_t * pxInterface,
+                                         BaseType_t xIsIPv6,
+                                         const IP_Address_t * pxGroupAddress,
+                                         uint32_t ulMaxResponseMS )
+    {
+        BaseType_t xIndex;
+        BaseType_t xFound = -1;
+        uint32_t ulDelay;
+
+        vTaskSuspendAll();
+        {
+            if( pxGroupAddress != NULL )
+            {
+                xFound = prvFindGroup( pxGroupAddress, xIsIPv6, pxInterface );
+            }
+
+            for( xIndex = 0; xIndex < ( BaseType_t ) ipconfigMULTICAST_MAX_GROUPS; xIndex++ )
+            {
+                MulticastGroup_t * pxGroup = &( xMulticastGroups[ xIndex ] );
+
+                if( ( ( pxGroupAddress == NULL ) || ( xIndex == xFound ) ) &&
+                    ( pxGroup->pxInterface == pxInterface ) &&
+                    ( ( ( pxGroup->ucIsIPv6 != 0U ) ? pdTRUE : pdFALSE ) == xIsIPv6 ) &&
+                    ( pxGroup->ucJoined != 0U ) &&
+                    ( prvIsReported( pxGroup ) != pdFALSE ) )
+                {
+                    ulDelay = prvRandomDelay( multicastPERIODS( ulMaxResponseMS ) );
+
+                    if( ( pxGroup->ulReportTimer == 0U ) || ( pxGroup->ulReportTimer > ulDelay ) )
+                    {
+                        pxGroup->ulReportTimer = ulDelay;
+                    }
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        prvUpdateTimer();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Another host on the link reported a group, which makes a pending
+ *        answer to a query unnecessary.  Only the older versions of the protocols
+ *        suppress reports.
+ *
+ * @param[in] pxInterface The interface on which the report was received.
+ * @param[in] xIsIPv6 pdTRUE for an MLDv1 report.
+ * @param[in] pxGroupAddress The group that was reported.
+ */
+    static void prvSuppressReport( const NetworkInterface_t * pxInterface,
+                                   BaseType_t xIsIPv6,
+                                   const IP_Address_t * pxGroupAddress )
+    {
+        BaseType_t xIndex;
+
+        if( prvUseOlderVersion( xIsIPv6 ) != pdFALSE )
+        {
+            vTaskSuspendAll();
+            {
+                xIndex = prvFindGroup( pxGroupAddress, xIsIPv6, pxInterface );
+
+                if( ( xIndex >= 0 ) &&
+                    ( xMulticastGroups[ xIndex ].ucJoined != 0U ) &&
+                    ( xMulticastGroups[ xIndex ].ucChangesToSend == 0U ) )
+                {
+                    xMulticastGroups[ xIndex ].ulReportTimer = 0U;
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) )
+
+/**
+ * @brief Process a received IGMP message: answer queries, and suppress our
+ *        report when an IGMPv1/v2 host reported the same group.
+ *
+ * @param[in] pxNetworkBuffer The received IGMP packet.
+ *
+ * @return eReleaseBuffer, the message is never passed on.
+ */
+        eFrameProcessingResult_t eProcessIGMPPacket( const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+            size_t uxIPHeaderLength = ( size_t ) ( ( ( size_t ) pxIPHeader->ucVersionHeaderLength & 0x0FU ) << 2 );
+            size_t uxTotalLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usLength );
+            size_t uxLength;
+            const uint8_t * pucIGMP;
+            IP_Address_t xGroup;
+            uint32_t ulMaxResponseMS;
+
+            if( ( uxTotalLength >= ( uxIPHeaderLength + igmpV2_MESSAGE_LENGTH ) ) &&
+                ( pxNetworkBuffer->xDataLength >= ( ipSIZE_OF_ETH_HEADER + uxTotalLength ) ) &&
+                ( pxNetworkBuffer->pxInterface != NULL ) )
+            {
+                uxLength = uxTotalLength - uxIPHeaderLength;
+                pucIGMP = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderLength ] );
+                ( void ) memset( &( xGroup ), 0, sizeof( xGroup ) );
+                ( void ) memcpy( &( xGroup.ulIP_IPv4 ), &( pucIGMP[ 4 ] ), sizeof( uint32_t ) );
+
+                switch( pucIGMP[ 0 ] )
+                {
+                    case igmpMEMBERSHIP_QUERY:
+
+                        if( uxLength == igmpV2_MESSAGE_LENGTH )
+                        {
+                            /* An IGMPv1 query has a zero maximum response time. */
+                            ulOlderQuerierTimer[ multicastFAMILY( pdFALSE ) ] = multicastPERIODS( multicastOLDER_QUERIER_MS );
+                            ulMaxResponseMS = ( pucIGMP[ 1 ] != 0U ) ? ( ( uint32_t ) pucIGMP[ 1 ] * 100U ) : igmpV1_MAX_RESPONSE_MS;
+                        }
+                        else if( uxLength >= igmpV3_QUERY_MIN_LENGTH )
+                        {
+                            /* RFC 3376 section 4.1.1: the code is in units of 1/10 s,
+                             * with a floating point format from 128 upwards. */
+                            ulMaxResponseMS = ( uint32_t ) pucIGMP[ 1 ];
+
+                            if( ulMaxResponseMS >= 128U )
+                            {
+                                ulMaxResponseMS = ( ( ulMaxResponseMS & 0x0FU ) | 0x10U ) << ( ( ( ulMaxResponseMS >> 4 ) & 0x07U ) + 3U );
+                            }
+
+                            ulMaxResponseMS *= 100U;
+                        }
+                        else
+                        {
+                            break;
+                        }
+
+                        if( xGroup.ulIP_IPv4 == 0U )
+                        {
+                            prvScheduleQueryReports( pxNetworkBuffer->pxInterface, pdFALSE, NULL, ulMaxResponseMS );
+                        }
+                        else if( xIsIPv4Multicast( xGroup.ulIP_IPv4 ) != pdFALSE )
+                        {
+                            prvScheduleQueryReports( pxNetworkBuffer->pxInterface, pdFALSE, &( xGroup ), ulMaxResponseMS );
+                        }
+                        else
+                        {
+                            /* Not a valid group. */
+                        }
+
+                        break;
+
+                    case igmpV1_MEMBERSHIP_REPORT:
+                    case igmpV2_MEMBERSHIP_REPORT:
+                        prvSuppressReport( pxNetworkBuffer->pxInterface, pdFALSE, &( xGroup ) );
+                        break;
+
+                    default:
+                        /* Other messages are not handled by hosts. */
+                        break;
+                }
+            }
+
+            return eReleaseBuffer;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) ) */
+
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+
+/**
+ * @brief Process a received MLD query or MLDv1 report.  The extension headers
+ *        were already removed.  Messages that do not come from a link-local
+ *        address are ignored, see RFC 3810 section 5.1.14.
+ *
+ * @param[in] pxNetworkBuffer The received ICMPv6 packet.
+ */
+        void vProcessMLDPacket( const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const IPHeader_IPv6_t * pxIPHeader = ( ( const IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+            size_t uxLength = ( size_t ) FreeRTOS_ntohs( pxIPHeader->usPayloadLength );
+            const uint8_t * pucMLD = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER ] );
+            IP_Address_t xGroup;
+            uint32_t ulMaxResponseMS;
+            BaseType_t xGeneral;
+            BaseType_t xIndex;
+
+            if( ( uxLength >= mldV1_MESSAGE_LENGTH ) &&
+                ( pxNetworkBuffer->xDataLength >= ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + uxLength ) ) &&
+                ( pxNetworkBuffer->pxInterface != NULL ) &&
+                ( xIPv6_GetIPType( &( pxIPHeader->xSourceAddress ) ) == eIPv6_LinkLocal ) )
+            {
+                ( void ) memset( &( xGroup ), 0, sizeof( xGroup ) );
+                ( void ) memcpy( xGroup.xIP_IPv6.ucBytes, &( pucMLD[ 8 ] ), ipSIZE_OF_IPv6_ADDRESS );
+
+                xGeneral = pdTRUE;
+
+                for( xIndex = 0; xIndex < ( BaseType_t ) ipSIZE_OF_IPv6_ADDRESS; xIndex++ )
+                {
+                    if( xGroup.xIP_IPv6.ucBytes[ xIndex ] != 0U )
+                    {
+                        xGeneral = pdFALSE;
+                        break;
+                    }
+                }
+
+                /* The maximum response delay or code, in network byte order. */
+                ulMaxResponseMS = ( ( ( uint32_t ) pucMLD[ 4 ] ) << 8 ) | ( ( uint32_t ) pucMLD[ 5 ] );
+
+                if( pucMLD[ 0 ] == ipICMP_MLD_QUERY_IPv6 )
+                {
+                    if( uxLength == mldV1_MESSAGE_LENGTH )
+                    {
+                        ulOlderQuerierTimer[ multicastFAMILY( pdTRUE ) ] = multicastPERIODS( multicastOLDER_QUERIER_MS );
+                    }
+                    else if( ( uxLength >= mldV2_QUERY_MIN_LENGTH ) && ( ulMaxResponseMS >= 32768U ) )
+                    {
+                        /* RFC 3810 section 5.1.3: a floating point format from 32768 upwards. */
+                        ulMaxResponseMS = ( ( ulMaxResponseMS & 0x0FFFU ) | 0x1000U ) << ( ( ( ulMaxResponseMS >> 12 ) & 0x07U ) + 3U );
+                    }
+                    else
+                    {
+                        /* The code is the delay in milliseconds. */
+                    }
+
+                    if( xGeneral != pdFALSE )
+                    {
+                        prvScheduleQueryReports( pxNetworkBuffer->pxInterface, pdTRUE, NULL, ulMaxResponseMS );
+                    }
+                    else if( xGroup.xIP_IPv6.ucBytes[ 0 ] == 0xffU )
+                    {
+                        prvScheduleQueryReports( pxNetworkBuffer->pxInterface, pdTRUE, &( xGroup ), ulMaxResponseMS );
+                    }
+                    else
+                    {
+                        /* Not a valid group. */
+                    }
+                }
+                else if( pucMLD[ 0 ] == ipICMP_MLD_REPORT_IPv6 )
+                {
+                    prvSuppressReport( pxNetworkBuffer->pxInterface, pdTRUE, &( xGroup ) );
+                }
+                else
+                {
+                    /* Other messages are not handled by hosts. */
+                }
+            }
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) ) */
+
+#endif /* ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) ) */
@@ -52,6 +52,7 @@
 #include "FreeRTOS_ND.h"
 #include "FreeRTOS_UDP_IP.h"
 #include "FreeRTOS_DHCP.h"
+#include "FreeRTOS_IGMP.h"
 #if ( ipconfigUSE_DHCPv6 == 1 )
     #include "FreeRTOS_DHCPv6.h"
 #endif
@@ -89,16 +90,6 @@
     #endif
 #endif
 
-/** @brief Defines how often the ND resolution timer callback function is executed.  The time is
- * shorter in the Windows simulator as simulated time is not real time. */
-#ifndef ipND_TIMER_PERIOD_MS
-    #ifdef _WINDOWS_
-        #define ipND_TIMER_PERIOD_MS    ( 500U ) /* For windows simulator builds. */
-    #else
-        #define ipND_TIMER_PERIOD_MS    ( 10000U )
-    #endif
-#endif
-
 #if ( ( ipconfigUSE_TCP == 1 ) && !defined( ipTCP_TIMER_PERIOD_MS ) )
     /** @brief When initialising the TCP timer, give it an initial time-out of 1 second. */
     #define ipTCP_TIMER_PERIOD_MS    ( 1000U )
@@ -132,6 +123,339 @@ static void prvIPTask_CheckPendingEvents( void );
     NetworkBufferDescriptor_t * pxNDWaitingNetworkBuffer = NULL;
 #endif
 
+#if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+
+/** @brief Packets that are waiting for the resolution of one address. */
+    typedef struct xPENDING_RESOLUTION
+    {
+        IP_Address_t xAddress; /**< The address being resolved. */
+        TickType_t xStartTime; /**< The time at which the first packet was stored. */
+        BaseType_t xIsIPv6;    /**< pdTRUE when xAddress is an IPv6 address. */
+        UBaseType_t uxCount;   /**< The number of packets stored, zero when the slot is free. */
+        NetworkBufferDescriptor_t * pxBuffers[ ipconfigPENDING_RESOLUTION_PACKETS ]; /**< The packets in order of arrival. */
+        eIPEvent_t eEventTypes[ ipconfigPENDING_RESOLUTION_PACKETS ];                /**< eNetworkRxEvent for a received packet, eStackTxEvent for a generated packet. */
+    } PendingResolution_t;
+
+/** @brief The packets that are waiting for an ARP or ND resolution, per address. */
+    static PendingResolution_t xPendingResolutions[ ipconfigPENDING_RESOLUTION_ADDRESSES ];
+
+/**
+ * @brief Find the slot that holds packets for a given address.
+ *
+ * @param[in] pxAddress The address being resolved.
+ * @param[in] xIsIPv6 pdTRUE for an IPv6 address, pdFALSE for an IPv4 address.
+ *
+ * @return The slot, or NULL when no packets are waiting for this address.
+ */
+    static PendingResolution_t * prvPendingResolutionFind( const IP_Address_t * pxAddress,
+                                                           BaseType_t xIsIPv6 )
+    {
+        PendingResolution_t * pxReturn = NULL;
+        BaseType_t x;
+
+        for( x = 0; x < ipconfigPENDING_RESOLUTION_ADDRESSES; x++ )
+        {
+            PendingResolution_t * pxSlot = &( xPendingResolutions[ x ] );
+
+            if( ( pxSlot->uxCount == 0U ) || ( pxSlot->xIsIPv6 != xIsIPv6 ) )
+            {
+                continue;
+            }
+
+            if( ( ( xIsIPv6 == pdFALSE ) && ( pxSlot->xAddress.ulIP_IPv4 == pxAddress->ulIP_IPv4 ) ) ||
+                ( ( xIsIPv6 != pdFALSE ) && ( memcmp( pxSlot->xAddress.xIP_IPv6.ucBytes, pxAddress->xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) ) )
+            {
+                pxReturn = pxSlot;
+                break;
+            }
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start, restart or stop the resolution timer of either ARP or ND.
+ *
+ * @param[in] xIsIPv6 pdTRUE for the ND timer, pdFALSE for the ARP timer.
+ * @param[in] xTime The time until the next expiry, or zero to stop the timer.
+ */
+    static void prvPendingResolutionTimer( BaseType_t xIsIPv6,
+                                           TickType_t xTime )
+    {
+        if( xIsIPv6 == pdFALSE )
+        {
+            #if ipconfigIS_ENABLED( ipconfigUSE_IPv4 )
+                if( xTime != 0U )
+                {
+                    vIPTimerStartARPResolution( xTime );
+                }
+                else
+                {
+                    vIPSetARPResolutionTimerEnableState( pdFALSE );
+                }
+            #endif
+        }
+        else
+        {
+            #if ipconfigIS_ENABLED( ipconfigUSE_IPv6 )
+                if( xTime != 0U )
+                {
+                    vIPTimerStartNDResolution( xTime );
+                }
+                else
+                {
+                    vIPSetNDResolutionTimerEnableState( pdFALSE );
+                }
+            #endif
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Restart the resolution timer so that it expires when the oldest slot
+ *        of the given family expires, or stop it when no slot is in use.
+ *
+ * @param[in] xIsIPv6 pdTRUE for the ND timer, pdFALSE for the ARP timer.
+ */
+    static void prvPendingResolutionUpdateTimer( BaseType_t xIsIPv6 )
+    {
+        const TickType_t xMaxDelay = ( xIsIPv6 != pdFALSE ) ? ipND_RESOLUTION_MAX_DELAY : ipARP_RESOLUTION_MAX_DELAY;
+        TickType_t xNow = xTaskGetTickCount();
+        TickType_t xNextExpiry = 0U;
+        TickType_t xAge;
+        BaseType_t x;
+
+        for( x = 0; x < ipconfigPENDING_RESOLUTION_ADDRESSES; x++ )
+        {
+            const PendingResolution_t * pxSlot = &( xPendingResolutions[ x ] );
+
+            if( ( pxSlot->uxCount != 0U ) && ( pxSlot->xIsIPv6 == xIsIPv6 ) )
+            {
+                xAge = xNow - pxSlot->xStartTime;
+
+                /* Expired slots are handled by the next timer event. */
+                xAge = ( xAge < xMaxDelay ) ? ( xMaxDelay - xAge ) : 1U;
+
+                if( ( xNextExpiry == 0U ) || ( xAge < xNextExpiry ) )
+                {
+                    xNextExpiry = xAge;
+                }
+            }
+        }
+
+        prvPendingResolutionTimer( xIsIPv6, xNextExpiry );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a packet until an address has been resolved.
+ *
+ * @param[in] pxNetworkBuffer The packet that must wait.
+ * @param[in] pxAddress The address being resolved.
+ * @param[in] xIsIPv6 pdTRUE for an IPv6 address (ND), pdFALSE for IPv4 (ARP).
+ * @param[in] eEventType The event with which the packet will be passed to the
+ *                       IP-task once the address has been resolved.
+ *
+ * @return pdPASS when the packet is stored, pdFAIL when there is no space.
+ */
+    static BaseType_t prvPendingResolutionStore( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                 const IP_Address_t * pxAddress,
+                                                 BaseType_t xIsIPv6,
+                                                 eIPEvent_t eEventType )
+    {
+        PendingResolution_t * pxSlot;
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t x;
+
+        pxSlot = prvPendingResolutionFind( pxAddress, xIsIPv6 );
+
+        if( pxSlot == NULL )
+        {
+            /* The first packet for this address: look for a free slot. */
+            for( x = 0; x < ipconfigPENDING_RESOLUTION_ADDRESSES; x++ )
+            {
+                if( xPendingResolutions[ x ].uxCount == 0U )
+                {
+                    pxSlot = &( xPendingResolutions[ x ] );
+                    ( void ) memcpy( &( pxSlot->xAddress ), pxAddress, sizeof( pxSlot->xAddress ) );
+                    pxSlot->xIsIPv6 = xIsIPv6;
+                    pxSlot->xStartTime = xTaskGetTickCount();
+                    break;
+                }
+            }
+        }
+
+        if( ( pxSlot != NULL ) && ( pxSlot->uxCount < ( UBaseType_t ) ipconfigPENDING_RESOLUTION_PACKETS ) )
+        {
+            pxSlot->pxBuffers[ pxSlot->uxCount ] = pxNetworkBuffer;
+            pxSlot->eEventTypes[ pxSlot->uxCount ] = eEventType;
+            pxSlot->uxCount++;
+
+            if( pxSlot->uxCount == 1U )
+            {
+                prvPendingResolutionUpdateTimer( xIsIPv6 );
+            }
+
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a received packet until the source address of it has been resolved.
+ *
+ * @param[in] pxNetworkBuffer The packet that must wait.
+ * @param[in] xIsIPv6 pdTRUE for an IPv6 packet (ND), pdFALSE for IPv4 (ARP).
+ *
+ * @return pdPASS when the packet is stored, pdFAIL when there is no space,
+ *         in which case the caller must release the buffer.
+ */
+    BaseType_t xPendingResolutionAdd( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                      BaseType_t xIsIPv6 )
+    {
+        IP_Address_t xAddress;
+
+        ( void ) memset( &( xAddress ), 0, sizeof( xAddress ) );
+
+        if( xIsIPv6 != pdFALSE )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const IPPacket_IPv6_t * pxIPPacket = ( ( const IPPacket_IPv6_t * ) pxNetworkBuffer->pucEthernetBuffer );
+
+            ( void ) memcpy( xAddress.xIP_IPv6.ucBytes, pxIPPacket->xIPHeader.xSourceAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+        }
+        else
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const IPPacket_t * pxIPPacket = ( ( const IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+
+            xAddress.ulIP_IPv4 = pxIPPacket->xIPHeader.ulSourceIPAddress;
+        }
+
+        return prvPendingResolutionStore( pxNetworkBuffer, &( xAddress ), xIsIPv6, eNetworkRxEvent );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a packet that was generated by the stack until the address of
+ *        its next hop has been resolved. It will then be passed to the IP-task
+ *        with an eStackTxEvent, to be sent.
+ *
+ * @param[in] pxNetworkBuffer The packet that must wait.
+ * @param[in] pxNextHop The address of the next hop: the destination, or a gateway.
+ * @param[in] xIsIPv6 pdTRUE for an IPv6 address (ND), pdFALSE for IPv4 (ARP).
+ *
+ * @return pdPASS when the packet is stored, pdFAIL when there is no space,
+ *         in which case the caller still owns the buffer.
+ */
+    BaseType_t xPendingResolutionAddOutgoing( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                              const IP_Address_t * pxNextHop,
+                                              BaseType_t xIsIPv6 )
+    {
+        return prvPendingResolutionStore( pxNetworkBuffer, pxNextHop, xIsIPv6, eStackTxEvent );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief An address has been resolved: pass all packets that were waiting for
+ *        it to the IP-task again, as if they were just received or generated.
+ *
+ * @param[in] pxAddress The address that has been resolved.
+ * @param[in] xIsIPv6 pdTRUE for an IPv6 address, pdFALSE for an IPv4 address.
+ *
+ * @return pdTRUE when packets were waiting for this address.
+ */
+    BaseType_t xPendingResolutionFlush( const IP_Address_t * pxAddress,
+                                        BaseType_t xIsIPv6 )
+    {
+        PendingResolution_t * pxSlot = prvPendingResolutionFind( pxAddress, xIsIPv6 );
+        IPStackEvent_t xEventMessage;
+        const TickType_t xDontBlock = ( TickType_t ) 0;
+        UBaseType_t uxIndex;
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxSlot != NULL )
+        {
+            for( uxIndex = 0U; uxIndex < pxSlot->uxCount; uxIndex++ )
+            {
+                xEventMessage.eEventType = pxSlot->eEventTypes[ uxIndex ];
+                xEventMessage.pvData = ( void * ) pxSlot->pxBuffers[ uxIndex ];
+
+                if( xSendEventStructToIPTask( &xEventMessage, xDontBlock ) != pdPASS )
+                {
+                    /* The event queue is full. Blocking is not an option because
+                     * this function runs in the IP-task, which empties the queue. */
+                    iptracePENDING_RESOLUTION_PACKET_LOST( xEventMessage.eEventType );
+                    vReleaseNetworkBufferAndDescriptor( pxSlot->pxBuffers[ uxIndex ] );
+                }
+
+                pxSlot->pxBuffers[ uxIndex ] = NULL;
+            }
+
+            pxSlot->uxCount = 0U;
+            prvPendingResolutionUpdateTimer( xIsIPv6 );
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called when the ARP or ND resolution timer expires. Releases the
+ *        packets of the addresses that could not be resolved in time.
+ *
+ * @param[in] xIsIPv6 pdTRUE for the ND timer, pdFALSE for the ARP timer.
+ */
+    void vPendingResolutionTimeout( BaseType_t xIsIPv6 )
+    {
+        const TickType_t xMaxDelay = ( xIsIPv6 != pdFALSE ) ? ipND_RESOLUTION_MAX_DELAY : ipARP_RESOLUTION_MAX_DELAY;
+        TickType_t xNow = xTaskGetTickCount();
+        UBaseType_t uxIndex;
+        BaseType_t x;
+
+        for( x = 0; x < ipconfigPENDING_RESOLUTION_ADDRESSES; x++ )
+        {
+            PendingResolution_t * pxSlot = &( xPendingResolutions[ x ] );
+
+            if( ( pxSlot->uxCount != 0U ) &&
+                ( pxSlot->xIsIPv6 == xIsIPv6 ) &&
+                ( ( xNow - pxSlot->xStartTime ) >= xMaxDelay ) )
+            {
+                /* We have waited long enough for the resolution. Now, free the
+                 * network buffers. */
+                for( uxIndex = 0U; uxIndex < pxSlot->uxCount; uxIndex++ )
+                {
+                    vReleaseNetworkBufferAndDescriptor( pxSlot->pxBuffers[ uxIndex ] );
+                    pxSlot->pxBuffers[ uxIndex ] = NULL;
+                }
+
+                pxSlot->uxCount = 0U;
+
+                if( xIsIPv6 != pdFALSE )
+                {
+                    iptraceDELAYED_ND_TIMER_EXPIRED();
+                }
+                else
+                {
+                    iptraceDELAYED_ARP_TIMER_EXPIRED();
+                }
+            }
+        }
+
+        prvPendingResolutionUpdateTimer( xIsIPv6 );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigPENDING_RESOLUTION_ADDRESSES > 0 */
+
 /*-----------------------------------------------------------*/
 
 static void prvProcessIPEventsAndTimers( void );
@@ -143,6 +467,45 @@ static void prvProcessIPEventsAndTimers( void );
  */
 static void prvIPTask( void * pvParameters );
 
+#if ( ipconfigRX_WORKER_TASKS > 0 )
+
+/*
+ * Create the RX worker tasks and their queues.
+ */
+    static void prvCreateRxWorkers( void );
+
+/*
+ * An RX worker task: it checks received frames before they are passed to the IP-task.
+ */
+    static void prvRxWorkerTask( void * pvParameters );
+
+/*
+ * Check if the caller is one of the RX worker tasks.
+ */
+    static BaseType_t prvIsCallingFromRxWorker( void );
+
+/*
+ * Calculate the flow hash of a received frame.
+ */
+    static uint32_t prvRxFlowHash( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Filter the frames of a chain and verify their checksums, returns what is left of the chain.
+ */
+    static NetworkBufferDescriptor_t * prvCheckRxFrames( NetworkBufferDescriptor_t * pxFirstBuffer );
+
+/*
+ * Release a chain of received frames that can not be delivered.
+ */
+    static void prvReleaseRxFrames( NetworkBufferDescriptor_t * pxFirstBuffer );
+
+/*
+ * Steer received frames to the RX worker tasks, based on the hash of their flow.
+ */
+    static BaseType_t prvSendToRxWorkers( NetworkBufferDescriptor_t * pxFirstBuffer,
+                                          TickType_t uxTimeout );
+#endif /* ( ipconfigRX_WORKER_TASKS > 0 ) */
+
 /*
  * Called when new data is available from the network interface.
  */
@@ -169,6 +532,13 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
 static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacket,
                                                     NetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+/*
+ * Process an accepted IP packet: options, extension headers, and the protocol.
+ */
+static eFrameProcessingResult_t prvProcessIPPayload( const IPPacket_t * pxIPPacket,
+                                                     NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     FrameSummary_t * pxSummary );
+
 /*
  * The network card driver has received a packet.  In the case that it is part
  * of a linked packet chain, walk through it to handle every message.
@@ -179,7 +549,8 @@ static void prvHandleEthernetPacket( NetworkBufferDescriptor_t * pxBuffer );
 static void prvForwardTxPacket( NetworkBufferDescriptor_t * pxNetworkBuffer,
                                 BaseType_t xReleaseAfterSend );
 
-static eFrameProcessingResult_t prvProcessUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer );
+static eFrameProcessingResult_t prvProcessUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     const FrameSummary_t * pxSummary );
 
 /*-----------------------------------------------------------*/
 
@@ -213,6 +584,18 @@ static BaseType_t xIPTaskInitialised = pdFALSE;
     static UBaseType_t uxQueueMinimumSpace = ipconfigEVENT_QUEUE_LENGTH;
 #endif
 
+#if ( ipconfigRX_WORKER_TASKS > 0 )
+    /** @brief The queues of the RX worker tasks, they hold chains of network buffers. */
+    static QueueHandle_t xRxWorkerQueues[ ipconfigRX_WORKER_TASKS ];
+
+    /** @brief The handles of the RX worker tasks. */
+    static TaskHandle_t xRxWorkerTasks[ ipconfigRX_WORKER_TASKS ];
+
+    /** @brief The number of RX worker tasks that were created.  When zero, received
+     * frames are passed to the IP-task directly. */
+    static UBaseType_t uxRxWorkerCount = 0U;
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Coverity wants to make pvParameters const, which would make it incompatible. Leave the
@@ -394,6 +777,14 @@ static void prvProcessIPEventsAndTimers( void )
             vProcessGeneratedUDPPacket( ( NetworkBufferDescriptor_t * ) xReceivedEvent.pvData );
             break;
 
+        case eStackTxBatchEvent:
+
+            /* FreeRTOS_sendmmsg() has passed a chain of packets to send. */
+            #if ( ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) )
+                vProcessGeneratedUDPPacketBatch( ( NetworkBufferDescriptor_t * ) xReceivedEvent.pvData );
+            #endif
+            break;
+
         case eDHCPEvent:
             prvCallDHCP_RA_Handler( ( ( NetworkEndPoint_t * ) xReceivedEvent.pvData ) );
             break;
@@ -466,6 +857,12 @@ static void prvProcessIPEventsAndTimers( void )
             {
                 SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) ( xReceivedEvent.pvData );
 
+                #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+                {
+                    vSocketSelectRemoveAll( pxSocketSet );
+                }
+                #endif
+
                 iptraceMEM_STATS_DELETE( pxSocketSet );
                 vEventGroupDelete( pxSocketSet->xSelectGroup );
                 vPortFree( ( void * ) pxSocketSet );
@@ -473,6 +870,47 @@ static void prvProcessIPEventsAndTimers( void )
             #endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
             break;
 
+        case eEPollDeleteEvent:
+            #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+                vSocketEPollDelete( ( SocketEPoll_t * ) ( xReceivedEvent.pvData ) );
+            #endif
+            break;
+
+        case eEPollCtlEvent:
+
+            /* FreeRTOS_epoll_ctl() has added a socket to a set, or changed
+             * its events. Report the events that are already active. */
+            #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+                vSocketEPollCtl( ( FreeRTOS_Socket_t * ) ( xReceivedEvent.pvData ) );
+            #endif
+            break;
+
+        case eDNSResolverEvent:
+
+            /* FreeRTOS_DNSResolveStart() has passed a new look-up, or
+             * the socket of the resolver has received a reply. */
+            #if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+                vDNSResolverHandleEvent( xReceivedEvent.pvData );
+            #endif
+            break;
+
+        case eMDNSEvent:
+
+            /* FreeRTOS_mDNSQuery() has started a new query, which
+             * must be sent now. */
+            #if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+                vMDNSHandleEvent();
+            #endif
+            break;
+
+        case eMulticastEvent:
+
+            /* A socket has joined or left a multicast group. */
+            #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+                vMulticastHandleEvent();
+            #endif
+            break;
+
         case eNoEvent:
             /* xQueueReceive() returned because of a normal time-out. */
             break;
@@ -683,6 +1121,11 @@ void vIPNetworkUpCalls( struct xNetworkEndPoint * pxEndPoint )
             vARPTimerReload( pdMS_TO_TICKS( ipARP_TIMER_PERIOD_MS ) );
         #endif
     }
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+        /* Report the multicast groups, the address of the end-point may be new. */
+        vMulticastNetworkUp( pxEndPoint );
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -724,6 +1167,15 @@ static void prvHandleEthernetPacket( NetworkBufferDescriptor_t * pxBuffer )
             /* Make it NULL to avoid using it later on. */
             pxBuffer->pxNextBuffer = NULL;
 
+            #if ( ipconfigIS_ENABLED( ipconfigUSE_TCP ) && ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) )
+            {
+                /* Generic receive offload: when the next packet continues the
+                 * same TCP flow, the TCP state handling of this packet will be
+                 * done together with the next one. */
+                vTCPGROPrepare( pxBuffer, pxNextBuffer );
+            }
+            #endif
+
             prvProcessEthernetPacket( pxBuffer );
             pxBuffer = pxNextBuffer;
         }
@@ -745,6 +1197,12 @@ static void prvForwardTxPacket( NetworkBufferDescriptor_t * pxNetworkBuffer,
 
     if( pxNetworkBuffer->pxInterface != NULL )
     {
+        #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+        {
+            vPrepareTxChecksums( pxNetworkBuffer->pxInterface, pxNetworkBuffer );
+        }
+        #endif
+
         ( void ) pxNetworkBuffer->pxInterface->pfOutput( pxNetworkBuffer->pxInterface, pxNetworkBuffer, xReleaseAfterSend );
     }
 }
@@ -1011,6 +1469,13 @@ BaseType_t FreeRTOS_IPInit_Multi( void )
             /* Prepare the sockets interface. */
             vNetworkSocketsInit();
 
+            #if ( ipconfigRX_WORKER_TASKS > 0 )
+            {
+                /* The workers must exist before the IP-task accepts received frames. */
+                prvCreateRxWorkers();
+            }
+            #endif
+
             /* Create the task that processes Ethernet and stack events. */
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
@@ -1435,10 +1900,31 @@ BaseType_t xSendEventToIPTask( eIPEvent_t eEvent )
 BaseType_t xSendEventStructToIPTask( const IPStackEvent_t * pxEvent,
                                      TickType_t uxTimeout )
 {
-    BaseType_t xReturn, xSendMessage;
+    BaseType_t xReturn = pdFAIL;
+    BaseType_t xSendMessage;
+    BaseType_t xSteered = pdFALSE;
     TickType_t uxUseTimeout = uxTimeout;
 
-    if( ( xIPIsNetworkTaskReady() == pdFALSE ) && ( pxEvent->eEventType != eNetworkDownEvent ) )
+    #if ( ipconfigRX_WORKER_TASKS > 0 )
+    {
+        /* Received frames are checked by an RX worker task first, unless they
+         * come from a worker that has checked them. */
+        if( ( pxEvent->eEventType == eNetworkRxEvent ) &&
+            ( uxRxWorkerCount > 0U ) &&
+            ( xIPIsNetworkTaskReady() != pdFALSE ) &&
+            ( prvIsCallingFromRxWorker() == pdFALSE ) )
+        {
+            xReturn = prvSendToRxWorkers( ( NetworkBufferDescriptor_t * ) pxEvent->pvData, uxTimeout );
+            xSteered = pdTRUE;
+        }
+    }
+    #endif /* ( ipconfigRX_WORKER_TASKS > 0 ) */
+
+    if( xSteered != pdFALSE )
+    {
+        /* The frames were passed to the RX workers. */
+    }
+    else if( ( xIPIsNetworkTaskReady() == pdFALSE ) && ( pxEvent->eEventType != eNetworkDownEvent ) )
     {
         /* Only allow eNetworkDownEvent events if the IP task is not ready
          * yet.  Not going to attempt to send the message so the send failed. */
@@ -1497,9 +1983,358 @@ BaseType_t xSendEventStructToIPTask( const IPStackEvent_t * pxEvent,
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigRX_WORKER_TASKS > 0 )
+
 /**
- * @brief Decide whether this packet should be processed or not based on the IP address in the packet.
- *
+ * @brief Create the RX worker tasks, each with a queue of ipconfigEVENT_QUEUE_LENGTH
+ *        chains of network buffers.  A worker that can not be created is left
+ *        out, the flows are spread over the workers that do exist.
+ */
+    static void prvCreateRxWorkers( void )
+    {
+        UBaseType_t uxWorker;
+        QueueHandle_t xQueue;
+        TaskHandle_t xTask;
+
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            static StaticQueue_t xRxWorkerStaticQueues[ ipconfigRX_WORKER_TASKS ];
+            static uint8_t ucRxWorkerQueueStorage[ ipconfigRX_WORKER_TASKS ][ ipconfigEVENT_QUEUE_LENGTH * sizeof( NetworkBufferDescriptor_t * ) ];
+            static StaticTask_t xRxWorkerTaskBuffers[ ipconfigRX_WORKER_TASKS ];
+            static StackType_t xRxWorkerTaskStacks[ ipconfigRX_WORKER_TASKS ][ ipconfigRX_WORKER_TASK_STACK_SIZE_WORDS ];
+        #endif
+
+        for( uxWorker = 0U; uxWorker < ( UBaseType_t ) ipconfigRX_WORKER_TASKS; uxWorker++ )
+        {
+            xTask = NULL;
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                xQueue = xQueueCreateStatic( ipconfigEVENT_QUEUE_LENGTH,
+                                             sizeof( NetworkBufferDescriptor_t * ),
+                                             ucRxWorkerQueueStorage[ uxWorker ],
+                                             &( xRxWorkerStaticQueues[ uxWorker ] ) );
+
+                if( xQueue != NULL )
+                {
+                    xTask = xTaskCreateStatic( &prvRxWorkerTask,
+                                               "RX-Worker",
+                                               ipconfigRX_WORKER_TASK_STACK_SIZE_WORDS,
+                                               ( void * ) xQueue,
+                                               ipconfigIP_TASK_PRIORITY,
+                                               xRxWorkerTaskStacks[ uxWorker ],
+                                               &( xRxWorkerTaskBuffers[ uxWorker ] ) );
+                }
+            }
+            #else
+            {
+                xQueue = xQueueCreate( ipconfigEVENT_QUEUE_LENGTH, sizeof( NetworkBufferDescriptor_t * ) );
+
+                if( xQueue != NULL )
+                {
+                    if( xTaskCreate( &prvRxWorkerTask,
+                                     "RX-Worker",
+                                     ipconfigRX_WORKER_TASK_STACK_SIZE_WORDS,
+                                     ( void * ) xQueue,
+                                     ipconfigIP_TASK_PRIORITY,
+                                     &( xTask ) ) != pdPASS )
+                    {
+                        vQueueDelete( xQueue );
+                        xTask = NULL;
+                    }
+                }
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            if( ( xQueue != NULL ) && ( xTask != NULL ) )
+            {
+                xRxWorkerQueues[ uxRxWorkerCount ] = xQueue;
+                xRxWorkerTasks[ uxRxWorkerCount ] = xTask;
+
+                /* A worker does not get frames before it is counted. */
+                uxRxWorkerCount++;
+            }
+            else
+            {
+                FreeRTOS_debug_printf( ( "prvCreateRxWorkers: worker %u not created\n", ( unsigned ) uxWorker ) );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief An RX worker task.  It takes chains of received frames from its queue.
+ *        All frames of a chain belong to the same flow.  The frames are checked
+ *        by prvCheckRxFrames(), and the chain is passed on to the IP-task as one
+ *        event.  The worker blocks while the event queue is full, so its own queue
+ *        fills up and the driver drops new frames before any work is done on them.
+ *
+ * @param[in] pvParameters The queue of this worker.
+ */
+
+/* MISRA Ref 8.13.1 [Not decorating a pointer to const parameter with const] */
+/* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-813 */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+    static void prvRxWorkerTask( void * pvParameters )
+    {
+        QueueHandle_t xQueue = ( QueueHandle_t ) pvParameters;
+        NetworkBufferDescriptor_t * pxChain;
+        IPStackEvent_t xRxEvent;
+
+        while( ipFOREVER() == pdTRUE )
+        {
+            if( xQueueReceive( xQueue, &( pxChain ), portMAX_DELAY ) == pdPASS )
+            {
+                pxChain = prvCheckRxFrames( pxChain );
+
+                if( pxChain != NULL )
+                {
+                    xRxEvent.eEventType = eNetworkRxEvent;
+                    xRxEvent.pvData = ( void * ) pxChain;
+
+                    if( xSendEventStructToIPTask( &( xRxEvent ), portMAX_DELAY ) != pdPASS )
+                    {
+                        /* Only when INCLUDE_vTaskSuspend is 0, portMAX_DELAY can expire. */
+                        prvReleaseRxFrames( pxChain );
+                    }
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if the caller is one of the RX worker tasks, whose frames must
+ *        go to the IP-task, and not to a worker again.
+ *
+ * @return pdTRUE if the caller is an RX worker, else pdFALSE.
+ */
+    static BaseType_t prvIsCallingFromRxWorker( void )
+    {
+        TaskHandle_t xCurrentHandle = xTaskGetCurrentTaskHandle();
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxWorker;
+
+        for( uxWorker = 0U; uxWorker < uxRxWorkerCount; uxWorker++ )
+        {
+            if( xRxWorkerTasks[ uxWorker ] == xCurrentHandle )
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the RSS hash of a received frame, see ulFrameFlowHash().
+ *
+ * @param[in] pxNetworkBuffer The received frame.
+ *
+ * @return The hash of the flow of the frame.
+ */
+    static uint32_t prvRxFlowHash( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        FrameSummary_t xSummary;
+
+        ( void ) eClassifyFrame( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, &( xSummary ) );
+
+        return ulFrameFlowHash( pxNetworkBuffer->pucEthernetBuffer, &( xSummary ) );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Apply eFilterReceivedFrame() to the frames of a chain when
+ *        ipconfigUSE_EARLY_RX_FILTER is enabled, and verify the checksums of
+ *        the frames that are kept.  Dropped frames are released, the others
+ *        stay linked in their order.
+ *
+ * @param[in] pxFirstBuffer The first frame of the chain.
+ *
+ * @return The first frame that is kept, or NULL when all frames were dropped.
+ */
+    static NetworkBufferDescriptor_t * prvCheckRxFrames( NetworkBufferDescriptor_t * pxFirstBuffer )
+    {
+        NetworkBufferDescriptor_t * pxNetworkBuffer = pxFirstBuffer;
+        NetworkBufferDescriptor_t * pxNextBuffer = NULL;
+        NetworkBufferDescriptor_t * pxKeptFirst = NULL;
+        NetworkBufferDescriptor_t * pxKeptLast = NULL;
+        FrameSummary_t xSummary;
+        eFrameProcessingResult_t eResult;
+
+        while( pxNetworkBuffer != NULL )
+        {
+            #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+            {
+                pxNextBuffer = pxNetworkBuffer->pxNextBuffer;
+                pxNetworkBuffer->pxNextBuffer = NULL;
+            }
+            #endif
+
+            eResult = eProcessBuffer;
+
+            #if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+            {
+                eResult = eFilterReceivedFrame( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+            }
+            #endif
+
+            if( eResult == eProcessBuffer )
+            {
+                if( xIsRxChecksumOffloaded( pxNetworkBuffer ) == pdFALSE )
+                {
+                    ( void ) eClassifyFrame( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, &( xSummary ) );
+                    vVerifyRxChecksums( pxNetworkBuffer, &( xSummary ) );
+                }
+
+                if( pxKeptFirst == NULL )
+                {
+                    pxKeptFirst = pxNetworkBuffer;
+                }
+
+                #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+                {
+                    if( pxKeptLast != NULL )
+                    {
+                        pxKeptLast->pxNextBuffer = pxNetworkBuffer;
+                    }
+                }
+                #endif
+
+                pxKeptLast = pxNetworkBuffer;
+            }
+            else
+            {
+                vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+            }
+
+            pxNetworkBuffer = pxNextBuffer;
+        }
+
+        return pxKeptFirst;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release a chain of received frames that can not be delivered.
+ *
+ * @param[in] pxFirstBuffer The first frame of the chain.
+ */
+    static void prvReleaseRxFrames( NetworkBufferDescriptor_t * pxFirstBuffer )
+    {
+        NetworkBufferDescriptor_t * pxNetworkBuffer = pxFirstBuffer;
+        NetworkBufferDescriptor_t * pxNextBuffer = NULL;
+
+        while( pxNetworkBuffer != NULL )
+        {
+            #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+            {
+                pxNextBuffer = pxNetworkBuffer->pxNextBuffer;
+            }
+            #endif
+
+            iptraceETHERNET_RX_EVENT_LOST();
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+            pxNetworkBuffer = pxNextBuffer;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Pass received frames to the RX worker tasks.  The worker is chosen by
+ *        the RSS hash of the frame, so the frames of a flow stay in order.  When
+ *        frames are linked, the frames of the same flow that follow each other
+ *        stay linked and are queued as one item, so they also reach the IP-task
+ *        as one chain, see ipconfigUSE_TCP_GRO.
+ *
+ * @param[in] pxFirstBuffer The received frame, or the first of a chain of frames.
+ * @param[in] uxTimeout Timeout for waiting in case a queue is full.
+ *
+ * @return pdFAIL when the first frame could not be queued, in which case the
+ *         caller must release the frame and the frames linked to it.
+ */
+    static BaseType_t prvSendToRxWorkers( NetworkBufferDescriptor_t * pxFirstBuffer,
+                                          TickType_t uxTimeout )
+    {
+        BaseType_t xReturn = pdPASS;
+        NetworkBufferDescriptor_t * pxChain = pxFirstBuffer;
+        NetworkBufferDescriptor_t * pxLast;
+        NetworkBufferDescriptor_t * pxNextChain;
+        TickType_t uxUseTimeout = uxTimeout;
+        uint32_t ulHash = 0U;
+        uint32_t ulNextHash = 0U;
+
+        /* The IP task cannot block itself, e.g. when called from the loopback interface. */
+        if( xIsCallingFromIPTask() == pdTRUE )
+        {
+            uxUseTimeout = ( TickType_t ) 0;
+        }
+
+        if( pxChain != NULL )
+        {
+            ulHash = prvRxFlowHash( pxChain );
+        }
+
+        while( pxChain != NULL )
+        {
+            pxLast = pxChain;
+            pxNextChain = NULL;
+
+            #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+            {
+                /* Find the end of the frames of this flow. */
+                pxNextChain = pxLast->pxNextBuffer;
+
+                while( pxNextChain != NULL )
+                {
+                    ulNextHash = prvRxFlowHash( pxNextChain );
+
+                    if( ulNextHash != ulHash )
+                    {
+                        break;
+                    }
+
+                    pxLast = pxNextChain;
+                    pxNextChain = pxLast->pxNextBuffer;
+                }
+
+                pxLast->pxNextBuffer = NULL;
+            }
+            #endif /* ( ipconfigUSE_LINKED_RX_MESSAGES != 0 ) */
+
+            if( xQueueSendToBack( xRxWorkerQueues[ ulHash % ( uint32_t ) uxRxWorkerCount ], &( pxChain ), uxUseTimeout ) != pdPASS )
+            {
+                if( pxChain == pxFirstBuffer )
+                {
+                    /* Give the whole chain back to the caller. */
+                    #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+                    {
+                        pxLast->pxNextBuffer = pxNextChain;
+                    }
+                    #endif
+
+                    FreeRTOS_debug_printf( ( "prvSendToRxWorkers: CAN NOT ADD frame\n" ) );
+                    xReturn = pdFAIL;
+                    break;
+                }
+
+                prvReleaseRxFrames( pxChain );
+            }
+
+            pxChain = pxNextChain;
+            ulHash = ulNextHash;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigRX_WORKER_TASKS > 0 ) */
+
+/**
+ * @brief Decide whether this packet should be processed or not based on the IP address in the packet.
+ *
  * @param[in] pucEthernetBuffer The ethernet packet under consideration.
  *
  * @return Enum saying whether to release or to process the packet.
@@ -1671,6 +2506,235 @@ eFrameProcessingResult_t eConsiderFrameForProcessing( const uint8_t * const pucE
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+
+/**
+ * @brief Check if the destination of an IP packet is an address of one of the
+ *        end-points, or a broadcast or multicast address.  While an end-point
+ *        is not up yet, e.g. during DHCP, all addresses are accepted for it.
+ *
+ * @param[in] pucEthernetBuffer The received frame, with a valid IP-header.
+ * @param[in] eClass Either eFrameClassIPv4 or eFrameClassIPv6.
+ *
+ * @return pdTRUE when the packet may be for this host.
+ */
+    static BaseType_t prvIsForLocalEndPoint( const uint8_t * const pucEthernetBuffer,
+                                             eFrameClass_t eClass )
+    {
+        BaseType_t xReturn = pdFALSE;
+        NetworkEndPoint_t * pxEndPoint;
+
+        switch( eClass )
+        {
+            #if ( ipconfigUSE_IPv4 != 0 )
+                case eFrameClassIPv4:
+                   {
+                       uint32_t ulDestinationIPAddress;
+
+                       /* The driver's buffer may not have the alignment of a network buffer. */
+                       ( void ) memcpy( &( ulDestinationIPAddress ),
+                                        &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + offsetof( IPHeader_t, ulDestinationIPAddress ) ] ),
+                                        sizeof( ulDestinationIPAddress ) );
+
+                       if( ( ulDestinationIPAddress == FREERTOS_INADDR_BROADCAST ) ||
+                           ( xIsIPv4Multicast( ulDestinationIPAddress ) != pdFALSE ) ||
+                           ( xIsIPv4Loopback( ulDestinationIPAddress ) != pdFALSE ) )
+                       {
+                           xReturn = pdTRUE;
+                       }
+                       else
+                       {
+                           for( pxEndPoint = FreeRTOS_FirstEndPoint( NULL );
+                                pxEndPoint != NULL;
+                                pxEndPoint = FreeRTOS_NextEndPoint( NULL, pxEndPoint ) )
+                           {
+                               if( ( ENDPOINT_IS_IPv4( pxEndPoint ) ) &&
+                                   ( ( FreeRTOS_IsEndPointUp( pxEndPoint ) == pdFALSE ) ||
+                                     ( ulDestinationIPAddress == pxEndPoint->ipv4_settings.ulIPAddress ) ||
+                                     ( ulDestinationIPAddress == pxEndPoint->ipv4_settings.ulBroadcastAddress ) ) )
+                               {
+                                   xReturn = pdTRUE;
+                                   break;
+                               }
+                           }
+                       }
+                   }
+                   break;
+            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                case eFrameClassIPv6:
+                   {
+                       IPv6_Address_t xDestinationAddress;
+
+                       ( void ) memcpy( xDestinationAddress.ucBytes,
+                                        &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + offsetof( IPHeader_IPv6_t, xDestinationAddress ) ] ),
+                                        sizeof( xDestinationAddress.ucBytes ) );
+
+                       if( xDestinationAddress.ucBytes[ 0 ] == 0xffU )
+                       {
+                           /* A multicast address. */
+                           xReturn = pdTRUE;
+                       }
+                       else
+                       {
+                           for( pxEndPoint = FreeRTOS_FirstEndPoint( NULL );
+                                pxEndPoint != NULL;
+                                pxEndPoint = FreeRTOS_NextEndPoint( NULL, pxEndPoint ) )
+                           {
+                               if( ( ENDPOINT_IS_IPv6( pxEndPoint ) ) &&
+                                   ( ( FreeRTOS_IsEndPointUp( pxEndPoint ) == pdFALSE ) ||
+                                     ( memcmp( xDestinationAddress.ucBytes, pxEndPoint->ipv6_settings.xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) ) )
+                               {
+                                   xReturn = pdTRUE;
+                                   break;
+                               }
+                           }
+                       }
+                   }
+                   break;
+            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+            default:
+                /* Not an IP packet. */
+                break;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a UDP packet to a port without a socket is still handled by
+ *        the stack, like in xProcessReceivedUDPPacket_IPv4().
+ *
+ * @param[in] pxSummary The parsed headers of the UDP packet.
+ *
+ * @return pdTRUE when the packet is a DNS reply, or an LLMNR, mDNS or NBNS message.
+ */
+    static BaseType_t prvIsUDPServicePort( const FrameSummary_t * pxSummary )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        #if ( ipconfigUSE_DNS == 1 ) && ( ipconfigDNS_USE_CALLBACKS == 1 )
+            if( pxSummary->usSourcePort == FreeRTOS_htons( ipDNS_PORT ) )
+            {
+                xReturn = pdTRUE;
+            }
+        #endif
+
+        #if ( ipconfigUSE_DNS == 1 ) && ( ipconfigUSE_LLMNR == 1 )
+            if( ( pxSummary->usDestinationPort == FreeRTOS_htons( ipLLMNR_PORT ) ) ||
+                ( pxSummary->usSourcePort == FreeRTOS_htons( ipLLMNR_PORT ) ) )
+            {
+                xReturn = pdTRUE;
+            }
+        #endif
+
+        #if ( ipconfigUSE_DNS == 1 ) && ( ipconfigUSE_MDNS == 1 )
+            if( ( pxSummary->usDestinationPort == FreeRTOS_htons( ipMDNS_PORT ) ) ||
+                ( pxSummary->usSourcePort == FreeRTOS_htons( ipMDNS_PORT ) ) )
+            {
+                xReturn = pdTRUE;
+            }
+        #endif
+
+        #if ( ipconfigUSE_NBNS == 1 )
+            if( ( pxSummary->usDestinationPort == FreeRTOS_htons( ipNBNS_PORT ) ) ||
+                ( pxSummary->usSourcePort == FreeRTOS_htons( ipNBNS_PORT ) ) )
+            {
+                xReturn = pdTRUE;
+            }
+        #endif
+
+        ( void ) pxSummary;
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Decide whether a received frame should be passed to the IP-task.  On
+ *        top of the checks of eConsiderFrameForProcessing(), IP packets must be
+ *        addressed to an end-point, and UDP (and, when ipconfigIGNORE_UNKNOWN_PACKETS
+ *        is set, TCP) packets must be sent to a port that may have a socket.
+ *        Packets of which the ports are not known, e.g. IP fragments, are passed.
+ *
+ *        This function only reads the frame, so a network driver can call it
+ *        before it allocates a network buffer, also from an interrupt.
+ *
+ * @param[in] pucEthernetBuffer The received frame.
+ * @param[in] uxBufferLength The number of bytes in the frame.
+ *
+ * @return eProcessBuffer when the frame should be passed to the IP-task,
+ *         otherwise eReleaseBuffer.
+ */
+    eFrameProcessingResult_t eFilterReceivedFrame( const uint8_t * const pucEthernetBuffer,
+                                                   size_t uxBufferLength )
+    {
+        eFrameProcessingResult_t eReturn = eConsiderFrameForProcessing( pucEthernetBuffer );
+        FrameSummary_t xSummary;
+
+        if( eReturn == eProcessBuffer )
+        {
+            switch( eClassifyFrame( pucEthernetBuffer, uxBufferLength, &( xSummary ) ) )
+            {
+                case eFrameClassInvalid:
+                    /* Too short, or an invalid IP-header. */
+                    eReturn = eReleaseBuffer;
+                    break;
+
+                case eFrameClassIPv4:
+                case eFrameClassIPv6:
+
+                    if( prvIsForLocalEndPoint( pucEthernetBuffer, xSummary.eClass ) == pdFALSE )
+                    {
+                        eReturn = eReleaseBuffer;
+                    }
+                    else if( xSummary.usDestinationPort == 0U )
+                    {
+                        /* Not UDP or TCP, or the ports are not known. */
+                    }
+                    else if( xSummary.ucProtocol == ( uint8_t ) ipPROTOCOL_UDP )
+                    {
+                        if( ( xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_UDP, xSummary.usDestinationPort ) == pdFALSE ) &&
+                            ( prvIsUDPServicePort( &( xSummary ) ) == pdFALSE ) )
+                        {
+                            eReturn = eReleaseBuffer;
+                        }
+                    }
+
+                    #if ( ipconfigUSE_TCP == 1 ) && ( ipconfigIGNORE_UNKNOWN_PACKETS == 1 )
+                        else if( xSummary.ucProtocol == ( uint8_t ) ipPROTOCOL_TCP )
+                        {
+                            /* Without ipconfigIGNORE_UNKNOWN_PACKETS, the stack would
+                             * answer with a RST packet, so it must see the packet. */
+                            if( xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_TCP, xSummary.usDestinationPort ) == pdFALSE )
+                            {
+                                eReturn = eReleaseBuffer;
+                            }
+                        }
+                    #endif
+                    else
+                    {
+                        /* Another protocol, or TCP that is answered with a RST. */
+                    }
+                    break;
+
+                case eFrameClassARP:
+                case eFrameClassOther:
+                default:
+                    /* Already checked by eConsiderFrameForProcessing(). */
+                    break;
+            }
+        }
+
+        return eReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigUSE_EARLY_RX_FILTER != 0 ) */
+
 /**
  * @brief Process the Ethernet packet.
  *
@@ -1799,7 +2863,13 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
 
             if( ( pxEthernetHeader->usFrameType == ipIPv4_FRAME_TYPE ) || ( pxEthernetHeader->usFrameType == ipARP_FRAME_TYPE ) )
             {
-                #if ipconfigIS_ENABLED( ipconfigUSE_IPv4 )
+                #if ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) && ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+                    if( xPendingResolutionAdd( pxNetworkBuffer, pdFALSE ) == pdPASS )
+                    {
+                        iptraceDELAYED_ARP_REQUEST_STARTED();
+                    }
+                    else
+                #elif ipconfigIS_ENABLED( ipconfigUSE_IPv4 )
                     if( pxARPWaitingNetworkBuffer == NULL )
                     {
                         pxARPWaitingNetworkBuffer = pxNetworkBuffer;
@@ -1810,7 +2880,7 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
                     else
                 #endif /* if ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) */
                 {
-                    /* We are already waiting on one resolution. This frame will be dropped. */
+                    /* There is no space to hold this frame. This frame will be dropped. */
                     vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
 
                     iptraceDELAYED_ARP_BUFFER_FULL();
@@ -1820,7 +2890,13 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
             }
             else if( pxEthernetHeader->usFrameType == ipIPv6_FRAME_TYPE )
             {
-                #if ipconfigIS_ENABLED( ipconfigUSE_IPv6 )
+                #if ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) && ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+                    if( xPendingResolutionAdd( pxNetworkBuffer, pdTRUE ) == pdPASS )
+                    {
+                        iptraceDELAYED_ND_REQUEST_STARTED();
+                    }
+                    else
+                #elif ipconfigIS_ENABLED( ipconfigUSE_IPv6 )
                     if( pxNDWaitingNetworkBuffer == NULL )
                     {
                         pxNDWaitingNetworkBuffer = pxNetworkBuffer;
@@ -1831,7 +2907,7 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
                     else
                 #endif /* if ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) */
                 {
-                    /* We are already waiting on one resolution. This frame will be dropped. */
+                    /* There is no space to hold this frame. This frame will be dropped. */
                     vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
 
                     iptraceDELAYED_ND_BUFFER_FULL();
@@ -1864,11 +2940,13 @@ static void prvProcessEthernetPacket( NetworkBufferDescriptor_t * const pxNetwor
  * @brief Check the sizes of the UDP packet and forward it to the UDP module
  *        ( xProcessReceivedUDPPacket() )
  * @param[in] pxNetworkBuffer The network buffer containing the UDP packet.
+ * @param[in] pxSummary The IP-header length of the packet.
  * @return eReleaseBuffer ( please release the buffer ).
  *         eFrameConsumed ( the buffer has now been released ).
  */
 
-static eFrameProcessingResult_t prvProcessUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+static eFrameProcessingResult_t prvProcessUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     const FrameSummary_t * pxSummary )
 {
     eFrameProcessingResult_t eReturn = eReleaseBuffer;
     BaseType_t xIsWaitingResolution = pdFALSE;
@@ -1879,7 +2957,7 @@ static eFrameProcessingResult_t prvProcessUDPPacket( NetworkBufferDescriptor_t *
     const UDPPacket_t * pxUDPPacket = ( ( UDPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
     const UDPHeader_t * pxUDPHeader = &( pxUDPPacket->xUDPHeader );
 
-    size_t uxMinSize = ipSIZE_OF_ETH_HEADER + ( size_t ) uxIPHeaderSizePacket( pxNetworkBuffer ) + ipSIZE_OF_UDP_HEADER;
+    size_t uxMinSize = ipSIZE_OF_ETH_HEADER + pxSummary->uxIPHeaderLength + ipSIZE_OF_UDP_HEADER;
     size_t uxLength;
     uint16_t usLength;
 
@@ -1904,7 +2982,7 @@ static eFrameProcessingResult_t prvProcessUDPPacket( NetworkBufferDescriptor_t *
      * these values. */
     #if ( ipconfigUSE_IPv4 != 0 )
         if( ( pxUDPPacket->xEthernetHeader.usFrameType == ipIPv4_FRAME_TYPE ) &&
-            ( usLength > ( FreeRTOS_ntohs( pxUDPPacket->xIPHeader.usLength ) - uxIPHeaderSizePacket( pxNetworkBuffer ) ) ) )
+            ( usLength > ( FreeRTOS_ntohs( pxUDPPacket->xIPHeader.usLength ) - pxSummary->uxIPHeaderLength ) ) )
         {
             eReturn = eReleaseBuffer;
         }
@@ -1977,8 +3055,7 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
                                                     NetworkBufferDescriptor_t * const pxNetworkBuffer )
 {
     eFrameProcessingResult_t eReturn;
-    UBaseType_t uxHeaderLength = ipSIZE_OF_IPv4_HEADER;
-    uint8_t ucProtocol = 0U;
+    FrameSummary_t xSummary;
 
     #if ( ipconfigUSE_IPv6 != 0 )
         const IPHeader_IPv6_t * pxIPHeader_IPv6 = NULL;
@@ -1988,6 +3065,10 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
         const IPHeader_t * pxIPHeader = &( pxIPPacket->xIPHeader );
     #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
+    /* The header length and the protocol are stored in a summary, which is
+     * passed on to the protocol handlers. */
+    ( void ) memset( &( xSummary ), 0, sizeof( xSummary ) );
+
     switch( pxIPPacket->xEthernetHeader.usFrameType )
     {
         #if ( ipconfigUSE_IPv6 != 0 )
@@ -2005,12 +3086,13 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
                     /* coverity[misra_c_2012_rule_11_3_violation] */
                     pxIPHeader_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
 
-                    uxHeaderLength = ipSIZE_OF_IPv6_HEADER;
-                    ucProtocol = pxIPHeader_IPv6->ucNextHeader;
+                    xSummary.eClass = eFrameClassIPv6;
+                    xSummary.uxIPHeaderLength = ipSIZE_OF_IPv6_HEADER;
+                    xSummary.ucProtocol = pxIPHeader_IPv6->ucNextHeader;
                     /* MISRA Ref 11.3.1 [Misaligned access] */
                     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
                     /* coverity[misra_c_2012_rule_11_3_violation] */
-                    eReturn = prvAllowIPPacketIPv6( ( ( const IPHeader_IPv6_t * ) &( pxIPPacket->xIPHeader ) ), pxNetworkBuffer, uxHeaderLength );
+                    eReturn = prvAllowIPPacketIPv6( ( ( const IPHeader_IPv6_t * ) &( pxIPPacket->xIPHeader ) ), pxNetworkBuffer, xSummary.uxIPHeaderLength );
 
                     /* The IP-header type is copied to a special reserved location a few bytes before the message
                      * starts. In the case of IPv6, this value is never actually used and the line below can safely be removed
@@ -2028,18 +3110,19 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
                    /* Check if the IP headers are acceptable and if it has our destination.
                     * The lowest four bits of 'ucVersionHeaderLength' indicate the IP-header
                     * length in multiples of 4. */
-                   uxHeaderLength = ( size_t ) ( ( uxLength & 0x0FU ) << 2 );
+                   xSummary.uxIPHeaderLength = ( size_t ) ( ( uxLength & 0x0FU ) << 2 );
 
-                   if( ( uxHeaderLength > ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) ) ||
-                       ( uxHeaderLength < ipSIZE_OF_IPv4_HEADER ) )
+                   if( ( xSummary.uxIPHeaderLength > ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) ) ||
+                       ( xSummary.uxIPHeaderLength < ipSIZE_OF_IPv4_HEADER ) )
                    {
                        eReturn = eReleaseBuffer;
                    }
                    else
                    {
-                       ucProtocol = pxIPPacket->xIPHeader.ucProtocol;
+                       xSummary.eClass = eFrameClassIPv4;
+                       xSummary.ucProtocol = pxIPPacket->xIPHeader.ucProtocol;
                        /* Check if the IP headers are acceptable and if it has our destination. */
-                       eReturn = prvAllowIPPacketIPv4( pxIPPacket, pxNetworkBuffer, uxHeaderLength );
+                       eReturn = prvAllowIPPacketIPv4( pxIPPacket, pxNetworkBuffer, xSummary.uxIPHeaderLength );
 
                        {
                            /* The IP-header type is copied to a special reserved location a few bytes before the
@@ -2066,143 +3149,186 @@ static eFrameProcessingResult_t prvProcessIPPacket( const IPPacket_t * pxIPPacke
     /* coverity[cond_const] */
     if( eReturn == eProcessBuffer )
     {
-        /* Are there IP-options. */
-        /* Case default is never toggled because eReturn is not eProcessBuffer in previous step. */
-        switch( pxIPPacket->xEthernetHeader.usFrameType ) /* LCOV_EXCL_BR_LINE */
-        {
-            #if ( ipconfigUSE_IPv4 != 0 )
-                case ipIPv4_FRAME_TYPE:
+        eReturn = prvProcessIPPayload( pxIPPacket, pxNetworkBuffer, &( xSummary ) );
+    }
 
-                    if( uxHeaderLength > ipSIZE_OF_IPv4_HEADER )
-                    {
-                        /* The size of the IP-header is larger than 20 bytes.
-                         * The extra space is used for IP-options. */
-                        eReturn = prvCheckIP4HeaderOptions( pxNetworkBuffer );
-                    }
-                    break;
-            #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+    return eReturn;
+}
+/*-----------------------------------------------------------*/
 
-            #if ( ipconfigUSE_IPv6 != 0 )
-                case ipIPv6_FRAME_TYPE:
+/**
+ * @brief Process an IP-packet that has been accepted: handle IPv4 options or IPv6
+ *        extension headers, refresh the ARP or ND cache, and pass the packet to
+ *        the protocol.
+ *
+ * @param[in] pxIPPacket The IP packet to be processed.
+ * @param[in] pxNetworkBuffer The networkbuffer descriptor having the IP packet.
+ * @param[in,out] pxSummary The IP-header length and the protocol.  They are
+ *                          updated when IP-options or extension headers are removed.
+ *
+ * @return An enum to show whether the packet should be released/kept/processed etc.
+ */
+static eFrameProcessingResult_t prvProcessIPPayload( const IPPacket_t * pxIPPacket,
+                                                     NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     FrameSummary_t * pxSummary )
+{
+    eFrameProcessingResult_t eReturn = eProcessBuffer;
 
-                    if( xGetExtensionOrder( ucProtocol, 0U ) > 0 )
-                    {
-                        eReturn = eHandleIPv6ExtensionHeaders( pxNetworkBuffer, pdTRUE );
+    #if ( ipconfigUSE_IPv6 != 0 )
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
-                        if( eReturn != eReleaseBuffer )
-                        {
-                            /* Ignore warning for `pxIPHeader_IPv6`. */
-                            ucProtocol = pxIPHeader_IPv6->ucNextHeader;
-                        }
-                    }
-                    break;
-            #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+    #if ( ipconfigUSE_IPv4 != 0 )
+        const IPHeader_t * pxIPHeader = &( pxIPPacket->xIPHeader );
+    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
-            /* Case default is never toggled because eReturn is not eProcessBuffer in previous step. */
-            default:   /* LCOV_EXCL_LINE */
-                /* MISRA 16.4 Compliance */
-                break; /* LCOV_EXCL_LINE */
-        }
+    /* Are there IP-options. */
+    /* Case default is never toggled because eReturn is not eProcessBuffer in previous step. */
+    switch( pxIPPacket->xEthernetHeader.usFrameType ) /* LCOV_EXCL_BR_LINE */
+    {
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case ipIPv4_FRAME_TYPE:
 
-        /* MISRA Ref 14.3.1 [Configuration dependent invariant] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-143 */
-        /* coverity[misra_c_2012_rule_14_3_violation] */
-        /* coverity[const] */
-        if( eReturn != eReleaseBuffer )
-        {
-            /* Add the IP and MAC addresses to the cache if they are not
-             * already there - otherwise refresh the age of the existing
-             * entry. */
-            if( ucProtocol != ( uint8_t ) ipPROTOCOL_UDP )
-            {
-                if( xCheckRequiresResolution( pxNetworkBuffer ) == pdTRUE )
+                if( pxSummary->uxIPHeaderLength > ipSIZE_OF_IPv4_HEADER )
                 {
-                    eReturn = eWaitingResolution;
+                    /* The size of the IP-header is larger than 20 bytes.
+                     * The extra space is used for IP-options. */
+                    eReturn = prvCheckIP4HeaderOptions( pxNetworkBuffer );
+
+                    /* The options have been removed, if the packet is kept. */
+                    pxSummary->uxIPHeaderLength = ipSIZE_OF_IPv4_HEADER;
                 }
-                else
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case ipIPv6_FRAME_TYPE:
+
+                if( xGetExtensionOrder( pxSummary->ucProtocol, 0U ) > 0 )
                 {
-                    /* Refresh the cache with the IP/MAC-address of the received
-                     * packet.  For UDP packets, this will be done later in
-                     * xProcessReceivedUDPPacket(), as soon as it's know that the message
-                     * will be handled.  This will prevent the cache getting
-                     * overwritten with the IP address of useless broadcast packets. */
-                    /* Case default is never toggled because eReturn is not eProcessBuffer in previous step. */
-                    switch( pxIPPacket->xEthernetHeader.usFrameType ) /* LCOV_EXCL_BR_LINE */
+                    eReturn = eHandleIPv6ExtensionHeaders( pxNetworkBuffer, pdTRUE );
+
+                    if( eReturn != eReleaseBuffer )
                     {
-                        #if ( ipconfigUSE_IPv6 != 0 )
-                            case ipIPv6_FRAME_TYPE:
-                                vNDRefreshCacheEntry( &( pxIPPacket->xEthernetHeader.xSourceAddress ), &( pxIPHeader_IPv6->xSourceAddress ), pxNetworkBuffer->pxEndPoint );
-                                break;
-                        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
-
-                        #if ( ipconfigUSE_IPv4 != 0 )
-                            case ipIPv4_FRAME_TYPE:
-                                /* Refresh the age of this cache entry since a packet was received. */
-                                vARPRefreshCacheEntryAge( &( pxIPPacket->xEthernetHeader.xSourceAddress ), pxIPHeader->ulSourceIPAddress );
-                                break;
-                        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
-
-                        /* Case default is never toggled because eReturn is not eProcessBuffer in previous step. */
-                        default:   /* LCOV_EXCL_LINE */
-                            /* MISRA 16.4 Compliance */
-                            break; /* LCOV_EXCL_LINE */
+                        /* Ignore warning for `pxIPHeader_IPv6`. */
+                        pxSummary->ucProtocol = pxIPHeader_IPv6->ucNextHeader;
                     }
                 }
-            }
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
-            if( eReturn != eWaitingResolution )
+        /* Case default is never toggled because eReturn is not eProcessBuffer in previous step. */
+        default:   /* LCOV_EXCL_LINE */
+            /* MISRA 16.4 Compliance */
+            break; /* LCOV_EXCL_LINE */
+    }
+
+    /* MISRA Ref 14.3.1 [Configuration dependent invariant] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-143 */
+    /* coverity[misra_c_2012_rule_14_3_violation] */
+    /* coverity[const] */
+    if( eReturn != eReleaseBuffer )
+    {
+        /* Add the IP and MAC addresses to the cache if they are not
+         * already there - otherwise refresh the age of the existing
+         * entry. */
+        if( pxSummary->ucProtocol != ( uint8_t ) ipPROTOCOL_UDP )
+        {
+            if( xCheckRequiresResolution( pxNetworkBuffer ) == pdTRUE )
             {
-                switch( ucProtocol )
+                eReturn = eWaitingResolution;
+            }
+            else
+            {
+                /* Refresh the cache with the IP/MAC-address of the received
+                 * packet.  For UDP packets, this will be done later in
+                 * xProcessReceivedUDPPacket(), as soon as it's know that the message
+                 * will be handled.  This will prevent the cache getting
+                 * overwritten with the IP address of useless broadcast packets. */
+                /* Case default is never toggled because eReturn is not eProcessBuffer in previous step. */
+                switch( pxIPPacket->xEthernetHeader.usFrameType ) /* LCOV_EXCL_BR_LINE */
                 {
+                    #if ( ipconfigUSE_IPv6 != 0 )
+                        case ipIPv6_FRAME_TYPE:
+                            vNDRefreshCacheEntry( &( pxIPPacket->xEthernetHeader.xSourceAddress ), &( pxIPHeader_IPv6->xSourceAddress ), pxNetworkBuffer->pxEndPoint );
+                            break;
+                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
                     #if ( ipconfigUSE_IPv4 != 0 )
-                        case ipPROTOCOL_ICMP:
-
-                            /* The IP packet contained an ICMP frame.  Don't bother checking
-                             * the ICMP checksum, as if it is wrong then the wrong data will
-                             * also be returned, and the source of the ping will know something
-                             * went wrong because it will not be able to validate what it
-                             * receives. */
-                            #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 )
-                            {
-                                eReturn = ProcessICMPPacket( pxNetworkBuffer );
-                            }
-                            #endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) */
+                        case ipIPv4_FRAME_TYPE:
+                            /* Refresh the age of this cache entry since a packet was received. */
+                            vARPRefreshCacheEntryAge( &( pxIPPacket->xEthernetHeader.xSourceAddress ), pxIPHeader->ulSourceIPAddress );
                             break;
                     #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
-                    #if ( ipconfigUSE_IPv6 != 0 )
-                        case ipPROTOCOL_ICMP_IPv6:
-                            eReturn = prvProcessICMPMessage_IPv6( pxNetworkBuffer );
-                            break;
-                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+                    /* Case default is never toggled because eReturn is not eProcessBuffer in previous step. */
+                    default:   /* LCOV_EXCL_LINE */
+                        /* MISRA 16.4 Compliance */
+                        break; /* LCOV_EXCL_LINE */
+                }
+            }
+        }
 
-                    case ipPROTOCOL_UDP:
-                        /* The IP packet contained a UDP frame. */
+        if( eReturn != eWaitingResolution )
+        {
+            switch( pxSummary->ucProtocol )
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    case ipPROTOCOL_ICMP:
+
+                        /* The IP packet contained an ICMP frame.  Don't bother checking
+                         * the ICMP checksum, as if it is wrong then the wrong data will
+                         * also be returned, and the source of the ping will know something
+                         * went wrong because it will not be able to validate what it
+                         * receives. */
+                        #if ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 )
+                        {
+                            eReturn = ProcessICMPPacket( pxNetworkBuffer );
+                        }
+                        #endif /* ( ipconfigREPLY_TO_INCOMING_PINGS == 1 ) || ( ipconfigSUPPORT_OUTGOING_PINGS == 1 ) */
+                        break;
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
 
-                        eReturn = prvProcessUDPPacket( pxNetworkBuffer );
+                #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) && ( ipconfigUSE_IPv4 != 0 ) )
+                    case ipPROTOCOL_IGMP:
+                        eReturn = eProcessIGMPPacket( pxNetworkBuffer );
                         break;
+                #endif
 
-                        #if ipconfigUSE_TCP == 1
-                            case ipPROTOCOL_TCP:
-
-                                if( xProcessReceivedTCPPacket( pxNetworkBuffer ) == pdPASS )
-                                {
-                                    eReturn = eFrameConsumed;
-                                }
-                                break;
-                        #endif /* if ipconfigUSE_TCP == 1 */
-                    default:
-                        /* Not a supported frame type. */
-                        eReturn = eReleaseBuffer;
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    case ipPROTOCOL_ICMP_IPv6:
+                        eReturn = prvProcessICMPMessage_IPv6( pxNetworkBuffer );
                         break;
-                }
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                case ipPROTOCOL_UDP:
+                    /* The IP packet contained a UDP frame. */
+
+                    eReturn = prvProcessUDPPacket( pxNetworkBuffer, pxSummary );
+                    break;
+
+                    #if ipconfigUSE_TCP == 1
+                        case ipPROTOCOL_TCP:
+
+                            if( xProcessReceivedTCPPacket( pxNetworkBuffer ) == pdPASS )
+                            {
+                                eReturn = eFrameConsumed;
+                            }
+                            break;
+                    #endif /* if ipconfigUSE_TCP == 1 */
+                default:
+                    /* Not a supported frame type. */
+                    eReturn = eReleaseBuffer;
+                    break;
             }
         }
     }
 
     return eReturn;
 }
-
 /*-----------------------------------------------------------*/
 
 /* This function is used in other files, has external linkage e.g. in
@@ -2352,6 +3478,13 @@ void vReturnEthernetFrame( NetworkBufferDescriptor_t * pxNetworkBuffer,
             if( xIsCallingFromIPTask() == pdTRUE )
             {
                 iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+
+                #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+                {
+                    vPrepareTxChecksums( pxInterface, pxNetworkBuffer );
+                }
+                #endif
+
                 ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, xReleaseAfterSend );
             }
             else if( xReleaseAfterSend != pdFALSE )
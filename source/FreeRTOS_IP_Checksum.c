@@ -0,0 +1,461 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_IP_Checksum.c
+ * @brief Checksum kernels for 64-bit and SIMD capable CPUs.
+ *
+ * The portable usGenerateChecksum() in FreeRTOS_IP_Utils.c is written for
+ * 32-bit MCUs: it counts the carries of 32-bit additions with a branch per
+ * word.  The kernels in this file add 32-bit words to 64-bit accumulators,
+ * which can not overflow for any packet size, so the carries are only folded
+ * once at the end.  A one's complement sum does not depend on the byte order
+ * nor on the grouping of the words, so the words are summed in the byte order
+ * of the CPU and the result is swapped once, like the portable version does.
+ *
+ * ipconfigCHECKSUM_KERNEL selects the kernel that implements
+ * usGenerateChecksum(). The other kernels that the compiler can build for
+ * the target are also available, so that they can be tested side by side.
+ *
+ * usGenerateChecksumCopy() is used when ipconfigUSE_COPY_CHECKSUM is enabled:
+ * it sums the payload of an outgoing packet while copying it.
+ *
+ * usAdjustChecksum() is used when ipconfigUSE_INCREMENTAL_CHECKSUM is enabled:
+ * it updates the checksum of a packet when a few fields are rewritten.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+#if ( ( ipconfigCHECKSUM_KERNEL != ipconfigCHECKSUM_KERNEL_PORTABLE ) || ( ipconfigUSE_COPY_CHECKSUM != 0 ) )
+
+    #if defined( __SSE2__ )
+        #include <emmintrin.h>
+    #endif
+
+    #if defined( __AVX2__ )
+        #include <immintrin.h>
+    #endif
+
+    #if defined( __ARM_NEON )
+        #include <arm_neon.h>
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add the bytes of a block as 32-bit words to a 64-bit accumulator.
+ *        Words that are left over are added as 16-bit words, and an odd byte
+ *        at the end is padded with a zero byte.  The block doesn't need to be
+ *        aligned.
+ *
+ * @param[in] ullSum The accumulator.
+ * @param[in] pucData The block of bytes.
+ * @param[in] uxByteCount The number of bytes in the block.
+ *
+ * @return The accumulator with the words of the block added.
+ */
+    static uint64_t prvChecksumAdd64( uint64_t ullSum,
+                                      const uint8_t * pucData,
+                                      size_t uxByteCount )
+    {
+        uint64_t ullSum1 = ullSum;
+        uint64_t ullSum2 = 0U;
+        const uint8_t * pucSource = pucData;
+        size_t uxLeft = uxByteCount;
+
+        /* Two accumulators let the additions of a 16-byte block run in
+         * parallel.  memcpy() makes the compiler use unaligned loads. */
+        while( uxLeft >= 16U )
+        {
+            uint64_t ullWords[ 2 ];
+
+            ( void ) memcpy( ullWords, pucSource, sizeof( ullWords ) );
+            ullSum1 += ( ullWords[ 0 ] & 0xFFFFFFFFU ) + ( ullWords[ 0 ] >> 32 );
+            ullSum2 += ( ullWords[ 1 ] & 0xFFFFFFFFU ) + ( ullWords[ 1 ] >> 32 );
+            pucSource = &( pucSource[ 16 ] );
+            uxLeft -= 16U;
+        }
+
+        while( uxLeft >= 4U )
+        {
+            uint32_t ulWord;
+
+            ( void ) memcpy( &( ulWord ), pucSource, sizeof( ulWord ) );
+            ullSum1 += ulWord;
+            pucSource = &( pucSource[ 4 ] );
+            uxLeft -= 4U;
+        }
+
+        if( uxLeft >= 2U )
+        {
+            uint16_t usWord;
+
+            ( void ) memcpy( &( usWord ), pucSource, sizeof( usWord ) );
+            ullSum1 += usWord;
+            pucSource = &( pucSource[ 2 ] );
+            uxLeft -= 2U;
+        }
+
+        if( uxLeft != 0U )
+        {
+            uint8_t ucBytes[ 2 ] = { 0U, 0U };
+            uint16_t usWord;
+
+            /* The last byte is the first byte of a 16-bit word. */
+            ucBytes[ 0 ] = pucSource[ 0 ];
+            ( void ) memcpy( &( usWord ), ucBytes, sizeof( usWord ) );
+            ullSum1 += usWord;
+        }
+
+        return ullSum1 + ullSum2;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Fold a 64-bit accumulator to a 16-bit one's complement sum, add the
+ *        initial sum, and swap the result to the format of usGenerateChecksum().
+ *
+ * @param[in] usSum The initial sum, as passed to usGenerateChecksum().
+ * @param[in] ullSum The accumulator with all words added.
+ *
+ * @return The same value as the portable usGenerateChecksum() would return.
+ */
+    static uint16_t prvChecksumFold( uint16_t usSum,
+                                     uint64_t ullSum )
+    {
+        uint64_t ullTotal = ullSum;
+
+        /* Swap the input (little endian platform only). */
+        ullTotal += ( uint64_t ) FreeRTOS_ntohs( usSum );
+
+        /* Fold the carries back in, until 16 bits are left. */
+        ullTotal = ( ullTotal & 0xFFFFFFFFU ) + ( ullTotal >> 32 );
+        ullTotal = ( ullTotal & 0xFFFFFFFFU ) + ( ullTotal >> 32 );
+        ullTotal = ( ullTotal & 0xFFFFU ) + ( ullTotal >> 16 );
+        ullTotal = ( ullTotal & 0xFFFFU ) + ( ullTotal >> 16 );
+
+        /* Swap the output (little endian platform only). */
+        return FreeRTOS_htons( ( uint16_t ) ullTotal );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigCHECKSUM_KERNEL != ipconfigCHECKSUM_KERNEL_PORTABLE ) || ( ipconfigUSE_COPY_CHECKSUM != 0 ) */
+
+#if ( ipconfigCHECKSUM_KERNEL != ipconfigCHECKSUM_KERNEL_PORTABLE )
+
+/**
+ * @brief Calculate the checksum of an array of bytes using 64-bit
+ *        accumulators.  The result is the same as the result of
+ *        usGenerateChecksum().
+ *
+ * @param[in] usSum The initial sum, obtained from earlier data.
+ * @param[in] pucNextData The actual data.
+ * @param[in] uxByteCount The number of bytes.
+ *
+ * @return The 16-bit one's complement sum of all 16-bit words in the data.
+ */
+    uint16_t usGenerateChecksum64( uint16_t usSum,
+                                   const uint8_t * pucNextData,
+                                   size_t uxByteCount )
+    {
+        return prvChecksumFold( usSum, prvChecksumAdd64( 0U, pucNextData, uxByteCount ) );
+    }
+/*-----------------------------------------------------------*/
+
+    #if defined( __SSE2__ )
+
+/**
+ * @brief Calculate the checksum of an array of bytes with SSE2, 64 bytes per
+ *        iteration.  Each 32-bit word is widened and added to one of the 64-bit
+ *        lanes of the accumulators.
+ *
+ * @param[in] usSum The initial sum, obtained from earlier data.
+ * @param[in] pucNextData The actual data.
+ * @param[in] uxByteCount The number of bytes.
+ *
+ * @return The 16-bit one's complement sum of all 16-bit words in the data.
+ */
+        uint16_t usGenerateChecksumSSE2( uint16_t usSum,
+                                         const uint8_t * pucNextData,
+                                         size_t uxByteCount )
+        {
+            const __m128i xZero = _mm_setzero_si128();
+            __m128i xSum1 = _mm_setzero_si128();
+            __m128i xSum2 = _mm_setzero_si128();
+            const uint8_t * pucSource = pucNextData;
+            size_t uxLeft = uxByteCount;
+            uint64_t ullLanes[ 4 ];
+
+            while( uxLeft >= 64U )
+            {
+                __m128i xData1 = _mm_loadu_si128( ( const __m128i * ) &( pucSource[ 0 ] ) );
+                __m128i xData2 = _mm_loadu_si128( ( const __m128i * ) &( pucSource[ 16 ] ) );
+                __m128i xData3 = _mm_loadu_si128( ( const __m128i * ) &( pucSource[ 32 ] ) );
+                __m128i xData4 = _mm_loadu_si128( ( const __m128i * ) &( pucSource[ 48 ] ) );
+
+                xSum1 = _mm_add_epi64( xSum1, _mm_unpacklo_epi32( xData1, xZero ) );
+                xSum2 = _mm_add_epi64( xSum2, _mm_unpackhi_epi32( xData1, xZero ) );
+                xSum1 = _mm_add_epi64( xSum1, _mm_unpacklo_epi32( xData2, xZero ) );
+                xSum2 = _mm_add_epi64( xSum2, _mm_unpackhi_epi32( xData2, xZero ) );
+                xSum1 = _mm_add_epi64( xSum1, _mm_unpacklo_epi32( xData3, xZero ) );
+                xSum2 = _mm_add_epi64( xSum2, _mm_unpackhi_epi32( xData3, xZero ) );
+                xSum1 = _mm_add_epi64( xSum1, _mm_unpacklo_epi32( xData4, xZero ) );
+                xSum2 = _mm_add_epi64( xSum2, _mm_unpackhi_epi32( xData4, xZero ) );
+
+                pucSource = &( pucSource[ 64 ] );
+                uxLeft -= 64U;
+            }
+
+            _mm_storeu_si128( ( __m128i * ) &( ullLanes[ 0 ] ), xSum1 );
+            _mm_storeu_si128( ( __m128i * ) &( ullLanes[ 2 ] ), xSum2 );
+
+            /* Each lane holds less than 2^58, the sum of the lanes can not overflow. */
+            return prvChecksumFold( usSum,
+                                    prvChecksumAdd64( ullLanes[ 0 ] + ullLanes[ 1 ] + ullLanes[ 2 ] + ullLanes[ 3 ],
+                                                      pucSource,
+                                                      uxLeft ) );
+        }
+    #endif /* defined( __SSE2__ ) */
+/*-----------------------------------------------------------*/
+
+    #if defined( __AVX2__ )
+
+/**
+ * @brief Calculate the checksum of an array of bytes with AVX2, 64 bytes per
+ *        iteration.  Each 32-bit word is widened and added to one of the 64-bit
+ *        lanes of the accumulators.
+ *
+ * @param[in] usSum The initial sum, obtained from earlier data.
+ * @param[in] pucNextData The actual data.
+ * @param[in] uxByteCount The number of bytes.
+ *
+ * @return The 16-bit one's complement sum of all 16-bit words in the data.
+ */
+        uint16_t usGenerateChecksumAVX2( uint16_t usSum,
+                                         const uint8_t * pucNextData,
+                                         size_t uxByteCount )
+        {
+            const __m256i xZero = _mm256_setzero_si256();
+            __m256i xSum1 = _mm256_setzero_si256();
+            __m256i xSum2 = _mm256_setzero_si256();
+            const uint8_t * pucSource = pucNextData;
+            size_t uxLeft = uxByteCount;
+            uint64_t ullLanes[ 8 ];
+            uint64_t ullTotal = 0U;
+            size_t uxLane;
+
+            while( uxLeft >= 64U )
+            {
+                __m256i xData1 = _mm256_loadu_si256( ( const __m256i * ) &( pucSource[ 0 ] ) );
+                __m256i xData2 = _mm256_loadu_si256( ( const __m256i * ) &( pucSource[ 32 ] ) );
+
+                xSum1 = _mm256_add_epi64( xSum1, _mm256_unpacklo_epi32( xData1, xZero ) );
+                xSum2 = _mm256_add_epi64( xSum2, _mm256_unpackhi_epi32( xData1, xZero ) );
+                xSum1 = _mm256_add_epi64( xSum1, _mm256_unpacklo_epi32( xData2, xZero ) );
+                xSum2 = _mm256_add_epi64( xSum2, _mm256_unpackhi_epi32( xData2, xZero ) );
+
+                pucSource = &( pucSource[ 64 ] );
+                uxLeft -= 64U;
+            }
+
+            _mm256_storeu_si256( ( __m256i * ) &( ullLanes[ 0 ] ), xSum1 );
+            _mm256_storeu_si256( ( __m256i * ) &( ullLanes[ 4 ] ), xSum2 );
+
+            for( uxLane = 0U; uxLane < 8U; uxLane++ )
+            {
+                ullTotal += ullLanes[ uxLane ];
+            }
+
+            return prvChecksumFold( usSum, prvChecksumAdd64( ullTotal, pucSource, uxLeft ) );
+        }
+    #endif /* defined( __AVX2__ ) */
+/*-----------------------------------------------------------*/
+
+    #if defined( __ARM_NEON )
+
+/**
+ * @brief Calculate the checksum of an array of bytes with NEON, 64 bytes per
+ *        iteration.  vpadalq_u32() adds pairs of 32-bit words to the 64-bit
+ *        lanes of the accumulators.
+ *
+ * @param[in] usSum The initial sum, obtained from earlier data.
+ * @param[in] pucNextData The actual data.
+ * @param[in] uxByteCount The number of bytes.
+ *
+ * @return The 16-bit one's complement sum of all 16-bit words in the data.
+ */
+        uint16_t usGenerateChecksumNEON( uint16_t usSum,
+                                         const uint8_t * pucNextData,
+                                         size_t uxByteCount )
+        {
+            uint64x2_t xSum1 = vdupq_n_u64( 0U );
+            uint64x2_t xSum2 = vdupq_n_u64( 0U );
+            const uint8_t * pucSource = pucNextData;
+            size_t uxLeft = uxByteCount;
+            uint64_t ullTotal;
+
+            while( uxLeft >= 64U )
+            {
+                xSum1 = vpadalq_u32( xSum1, vreinterpretq_u32_u8( vld1q_u8( &( pucSource[ 0 ] ) ) ) );
+                xSum2 = vpadalq_u32( xSum2, vreinterpretq_u32_u8( vld1q_u8( &( pucSource[ 16 ] ) ) ) );
+                xSum1 = vpadalq_u32( xSum1, vreinterpretq_u32_u8( vld1q_u8( &( pucSource[ 32 ] ) ) ) );
+                xSum2 = vpadalq_u32( xSum2, vreinterpretq_u32_u8( vld1q_u8( &( pucSource[ 48 ] ) ) ) );
+
+                pucSource = &( pucSource[ 64 ] );
+                uxLeft -= 64U;
+            }
+
+            xSum1 = vaddq_u64( xSum1, xSum2 );
+            ullTotal = vgetq_lane_u64( xSum1, 0 ) + vgetq_lane_u64( xSum1, 1 );
+
+            return prvChecksumFold( usSum, prvChecksumAdd64( ullTotal, pucSource, uxLeft ) );
+        }
+    #endif /* defined( __ARM_NEON ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculates the 16-bit checksum of an array of bytes, using the kernel
+ *        selected with ipconfigCHECKSUM_KERNEL.
+ *
+ * @param[in] usSum The initial sum, obtained from earlier data.
+ * @param[in] pucNextData The actual data.
+ * @param[in] uxByteCount The number of bytes.
+ *
+ * @return The 16-bit one's complement of the one's complement sum of all 16-bit
+ *         words in the header
+ */
+    uint16_t usGenerateChecksum( uint16_t usSum,
+                                 const uint8_t * pucNextData,
+                                 size_t uxByteCount )
+    {
+        #if ( ipconfigCHECKSUM_KERNEL == ipconfigCHECKSUM_KERNEL_SSE2 )
+            return usGenerateChecksumSSE2( usSum, pucNextData, uxByteCount );
+        #elif ( ipconfigCHECKSUM_KERNEL == ipconfigCHECKSUM_KERNEL_AVX2 )
+            return usGenerateChecksumAVX2( usSum, pucNextData, uxByteCount );
+        #elif ( ipconfigCHECKSUM_KERNEL == ipconfigCHECKSUM_KERNEL_NEON )
+            return usGenerateChecksumNEON( usSum, pucNextData, uxByteCount );
+        #else
+            return usGenerateChecksum64( usSum, pucNextData, uxByteCount );
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigCHECKSUM_KERNEL != ipconfigCHECKSUM_KERNEL_PORTABLE */
+
+#if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+
+/**
+ * @brief Copy an array of bytes and calculate its checksum in the same pass,
+ *        so that the source is only read once.  The result is the same as
+ *        the result of usGenerateChecksum() for the copied bytes.
+ *
+ * @param[in] usSum The initial sum, obtained from earlier data.
+ * @param[out] pucDestination Where the bytes are copied to.
+ * @param[in] pucSource The bytes to be copied, they may not overlap with
+ *                       pucDestination.
+ * @param[in] uxByteCount The number of bytes.
+ *
+ * @return The 16-bit one's complement sum of all 16-bit words in the data.
+ */
+    uint16_t usGenerateChecksumCopy( uint16_t usSum,
+                                     uint8_t * pucDestination,
+                                     const uint8_t * pucSource,
+                                     size_t uxByteCount )
+    {
+        uint64_t ullSum1 = 0U;
+        uint64_t ullSum2 = 0U;
+        size_t uxDone = 0U;
+
+        /* Each 16-byte block is loaded once, stored, and added from registers. */
+        while( ( uxByteCount - uxDone ) >= 16U )
+        {
+            uint64_t ullWords[ 2 ];
+
+            ( void ) memcpy( ullWords, &( pucSource[ uxDone ] ), sizeof( ullWords ) );
+            ( void ) memcpy( &( pucDestination[ uxDone ] ), ullWords, sizeof( ullWords ) );
+            ullSum1 += ( ullWords[ 0 ] & 0xFFFFFFFFU ) + ( ullWords[ 0 ] >> 32 );
+            ullSum2 += ( ullWords[ 1 ] & 0xFFFFFFFFU ) + ( ullWords[ 1 ] >> 32 );
+            uxDone += 16U;
+        }
+
+        /* Less than 16 bytes are left, they are summed from the copy. */
+        ( void ) memcpy( &( pucDestination[ uxDone ] ), &( pucSource[ uxDone ] ), uxByteCount - uxDone );
+
+        return prvChecksumFold( usSum, prvChecksumAdd64( ullSum1 + ullSum2, &( pucDestination[ uxDone ] ), uxByteCount - uxDone ) );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_COPY_CHECKSUM != 0 */
+
+#if ( ipconfigUSE_INCREMENTAL_CHECKSUM != 0 )
+
+/**
+ * @brief Adjust a checksum for a change of some fields in the data that it
+ *        covers, without reading the other data.  This is equation 3 of
+ *        RFC 1624: HC' = ~( ~HC + ~m + m' ), which never results in -0.
+ *
+ * @param[in] usChecksum The checksum field as it is stored in the packet,
+ *                        i.e. in network byte order.
+ * @param[in] usOldSum The sum of the old contents of the fields, as returned
+ *                      by usGenerateChecksum().  The fields must start at an
+ *                      even offset in the data.
+ * @param[in] usNewSum The sum of the new contents of the fields.
+ *
+ * @return The new checksum, in network byte order.  It is zero when the new
+ *         data sums to 0xFFFF, but also when all the new data is zero, where
+ *         a full calculation gives 0xFFFF.  A caller for which all-zero data
+ *         is possible must calculate the checksum again when zero is returned.
+ */
+    uint16_t usAdjustChecksum( uint16_t usChecksum,
+                               uint16_t usOldSum,
+                               uint16_t usNewSum )
+    {
+        uint32_t ulSum;
+
+        ulSum = ( uint32_t ) ( uint16_t ) ~FreeRTOS_ntohs( usChecksum );
+        ulSum += ( uint32_t ) ( uint16_t ) ~usOldSum;
+        ulSum += ( uint32_t ) usNewSum;
+
+        /* Fold the carries back in. */
+        ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+        ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+
+        return FreeRTOS_htons( ( uint16_t ) ~ulSum );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_INCREMENTAL_CHECKSUM != 0 */
@@ -55,6 +55,7 @@
 #include "NetworkBufferManagement.h"
 #include "FreeRTOS_Routing.h"
 #include "FreeRTOS_DNS.h"
+#include "FreeRTOS_IGMP.h"
 /*-----------------------------------------------------------*/
 
 /** @brief 'xAllNetworksUp' becomes pdTRUE when all network interfaces are initialised
@@ -120,6 +121,18 @@ static void prvIPTimerReload( IPTimer_t * pxTimer,
     /** @brief DNS timer, to check for timeouts when looking-up a domain. */
     static IPTimer_t xDNSTimer;
 #endif
+#if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+    /** @brief Timer of the asynchronous DNS resolver, to retransmit queries and check for timeouts. */
+    static IPTimer_t xDNSResolverTimer;
+#endif
+#if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+    /** @brief Timer of the mDNS browser, to send continuous queries. */
+    static IPTimer_t xMDNSTimer;
+#endif
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+    /** @brief Timer to send IGMP and MLD reports. */
+    static IPTimer_t xMulticastTimer;
+#endif
 
 /** @brief As long as not all networks are up, repeat initialisation by calling the
  * xNetworkInterfaceInitialise() function of the interfaces that are not ready. */
@@ -211,6 +224,42 @@ TickType_t xCalculateSleepTime( void )
     }
     #endif
 
+    #if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+    {
+        if( xDNSResolverTimer.bActive != pdFALSE_UNSIGNED )
+        {
+            if( xDNSResolverTimer.ulRemainingTime < uxMaximumSleepTime )
+            {
+                uxMaximumSleepTime = xDNSResolverTimer.ulRemainingTime;
+            }
+        }
+    }
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+    {
+        if( xMDNSTimer.bActive != pdFALSE_UNSIGNED )
+        {
+            if( xMDNSTimer.ulRemainingTime < uxMaximumSleepTime )
+            {
+                uxMaximumSleepTime = xMDNSTimer.ulRemainingTime;
+            }
+        }
+    }
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+    {
+        if( xMulticastTimer.bActive != pdFALSE_UNSIGNED )
+        {
+            if( xMulticastTimer.ulRemainingTime < uxMaximumSleepTime )
+            {
+                uxMaximumSleepTime = xMulticastTimer.ulRemainingTime;
+            }
+        }
+    }
+    #endif
+
     return uxMaximumSleepTime;
 }
 /*-----------------------------------------------------------*/
@@ -237,6 +286,13 @@ void vCheckNetworkTimers( void )
         /* Is the ARP resolution timer expired? */
         if( prvIPTimerCheck( &xARPResolutionTimer ) != pdFALSE )
         {
+            #if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+            {
+                /* Release the packets that have waited too long, and restart
+                 * the timer for the remaining ones. */
+                vPendingResolutionTimeout( pdFALSE );
+            }
+            #else
             if( pxARPWaitingNetworkBuffer != NULL )
             {
                 /* Disable the ARP resolution timer. */
@@ -251,6 +307,7 @@ void vCheckNetworkTimers( void )
 
                 iptraceDELAYED_ARP_TIMER_EXPIRED();
             }
+            #endif /* if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 ) */
         }
     #endif /* if ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) */
 
@@ -264,6 +321,13 @@ void vCheckNetworkTimers( void )
         /* Is the ND resolution timer expired? */
         if( prvIPTimerCheck( &xNDResolutionTimer ) != pdFALSE )
         {
+            #if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+            {
+                /* Release the packets that have waited too long, and restart
+                 * the timer for the remaining ones. */
+                vPendingResolutionTimeout( pdTRUE );
+            }
+            #else
             if( pxNDWaitingNetworkBuffer != NULL )
             {
                 /* Disable the ND resolution timer. */
@@ -278,6 +342,7 @@ void vCheckNetworkTimers( void )
 
                 iptraceDELAYED_ND_TIMER_EXPIRED();
             }
+            #endif /* if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 ) */
         }
     #endif /* if ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) */
 
@@ -320,6 +385,33 @@ void vCheckNetworkTimers( void )
     }
     #endif /* ipconfigDNS_USE_CALLBACKS */
 
+    #if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+    {
+        if( prvIPTimerCheck( &xDNSResolverTimer ) != pdFALSE )
+        {
+            vDNSResolverCheck();
+        }
+    }
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+    {
+        if( prvIPTimerCheck( &xMDNSTimer ) != pdFALSE )
+        {
+            vMDNSCheck();
+        }
+    }
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+    {
+        if( prvIPTimerCheck( &xMulticastTimer ) != pdFALSE )
+        {
+            vMulticastCheck();
+        }
+    }
+    #endif
+
     #if ( ipconfigUSE_TCP == 1 )
     {
         BaseType_t xWillSleep;
@@ -493,6 +585,18 @@ static void prvIPTimerReload( IPTimer_t * pxTimer,
     {
         prvIPTimerReload( &xNDTimer, xTime );
     }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Let the ND timer expire once after a given time, after which it
+ *        continues with its reload time.
+ *
+ * @param[in] xTime Time after which the ND timer shall expire.
+ */
+    void vNDTimerStart( TickType_t xTime )
+    {
+        prvIPTimerStart( &xNDTimer, xTime );
+    }
 #endif
 /*-----------------------------------------------------------*/
 
@@ -510,6 +614,48 @@ static void prvIPTimerReload( IPTimer_t * pxTimer,
 #endif /* ipconfigDNS_USE_CALLBACKS != 0 */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+
+/**
+ * @brief Reload the timer of the asynchronous DNS resolver.
+ *
+ * @param[in] xTime The reload value.
+ */
+    void vDNSResolverTimerReload( TickType_t xTime )
+    {
+        prvIPTimerReload( &xDNSResolverTimer, xTime );
+    }
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+
+/**
+ * @brief Reload the timer of the mDNS browser.
+ *
+ * @param[in] xTime The reload value.
+ */
+    void vMDNSTimerReload( TickType_t xTime )
+    {
+        prvIPTimerReload( &xMDNSTimer, xTime );
+    }
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+
+/**
+ * @brief Reload the timer of the IGMP and MLD reports.
+ *
+ * @param[in] xTime The reload value.
+ */
+    void vMulticastTimerReload( TickType_t xTime )
+    {
+        prvIPTimerReload( &xMulticastTimer, xTime );
+    }
+#endif
+/*-----------------------------------------------------------*/
+
 #if ( ipconfigUSE_DHCP == 1 ) || ( ipconfigUSE_RA == 1 )
 
 /**
@@ -731,6 +877,72 @@ static BaseType_t prvIPTimerCheck( IPTimer_t * pxTimer )
 #endif /* ipconfigDNS_USE_CALLBACKS == 1 */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+
+/**
+ * @brief Enable/disable the timer of the asynchronous DNS resolver.
+ *
+ * @param[in] xEnableState pdTRUE - enable timer; pdFALSE - disable timer.
+ */
+    void vIPSetDNSResolverTimerEnableState( BaseType_t xEnableState )
+    {
+        if( xEnableState != 0 )
+        {
+            xDNSResolverTimer.bActive = pdTRUE_UNSIGNED;
+        }
+        else
+        {
+            xDNSResolverTimer.bActive = pdFALSE_UNSIGNED;
+        }
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+
+/**
+ * @brief Enable/disable the timer of the mDNS browser.
+ *
+ * @param[in] xEnableState pdTRUE - enable timer; pdFALSE - disable timer.
+ */
+    void vIPSetMDNSTimerEnableState( BaseType_t xEnableState )
+    {
+        if( xEnableState != 0 )
+        {
+            xMDNSTimer.bActive = pdTRUE_UNSIGNED;
+        }
+        else
+        {
+            xMDNSTimer.bActive = pdFALSE_UNSIGNED;
+        }
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+
+/**
+ * @brief Enable/disable the timer of the IGMP and MLD reports.
+ *
+ * @param[in] xEnableState pdTRUE - enable timer; pdFALSE - disable timer.
+ */
+    void vIPSetMulticastTimerEnableState( BaseType_t xEnableState )
+    {
+        if( xEnableState != 0 )
+        {
+            xMulticastTimer.bActive = pdTRUE_UNSIGNED;
+        }
+        else
+        {
+            xMulticastTimer.bActive = pdFALSE_UNSIGNED;
+        }
+    }
+
+#endif
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Mark whether all interfaces are up or at least one interface is down.
  *        If all interfaces are up, the 'xNetworkTimer' will not be checked.
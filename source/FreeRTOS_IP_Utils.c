@@ -297,6 +297,210 @@ NetworkBufferDescriptor_t * pxDuplicateNetworkBufferWithDescriptor( const Networ
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+
+/**
+ * @brief Get a new descriptor that refers to the Ethernet buffer of a received
+ *        packet, so that the packet can be passed to another socket without
+ *        copying it.  The Ethernet buffer is released together with the last
+ *        descriptor that refers to it.
+ *
+ * @param[in] pxNetworkBuffer The network buffer to be shared.
+ *
+ * @return The shared copy, or NULL when no descriptor is available.
+ */
+    NetworkBufferDescriptor_t * pxShareNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkBufferDescriptor_t * pxOwner = pxNetworkBuffer;
+        NetworkBufferDescriptor_t * pxNewBuffer;
+
+        if( pxOwner->pxSharedOwner != NULL )
+        {
+            pxOwner = pxOwner->pxSharedOwner;
+        }
+
+        /* The descriptor comes with an Ethernet buffer of its own, which stays
+         * unused until the shared copy is released.  With BufferAllocation_2 it
+         * is the smallest possible buffer, but with BufferAllocation_1 all
+         * buffers have the same size, so every extra socket costs a whole
+         * network buffer. */
+        pxNewBuffer = pxGetNetworkBufferWithDescriptor( 0U, ( TickType_t ) 0 );
+
+        if( pxNewBuffer != NULL )
+        {
+            pxNewBuffer->pucOwnBuffer = pxNewBuffer->pucEthernetBuffer;
+            pxNewBuffer->pucEthernetBuffer = pxOwner->pucEthernetBuffer;
+            pxNewBuffer->xDataLength = pxNetworkBuffer->xDataLength;
+            ( void ) memcpy( &( pxNewBuffer->xIPAddress ), &( pxNetworkBuffer->xIPAddress ), sizeof( pxNewBuffer->xIPAddress ) );
+            pxNewBuffer->usPort = pxNetworkBuffer->usPort;
+            pxNewBuffer->usBoundPort = pxNetworkBuffer->usBoundPort;
+            pxNewBuffer->pxInterface = pxNetworkBuffer->pxInterface;
+            pxNewBuffer->pxEndPoint = pxNetworkBuffer->pxEndPoint;
+            pxNewBuffer->pxSharedOwner = pxOwner;
+
+            taskENTER_CRITICAL();
+            {
+                /* Zero means that the owner is the only reference. */
+                if( pxOwner->usShareCount == 0U )
+                {
+                    pxOwner->usShareCount = 1U;
+                }
+
+                pxOwner->usShareCount++;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        return pxNewBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Drop a reference to a shared Ethernet buffer.  Called with interrupts
+ *        masked, from a task or from an ISR.
+ *
+ * @param[in] pxNetworkBuffer The network buffer that is being released.
+ * @param[out] ppxOwner Set to the owner of the Ethernet buffer when
+ *                      pxNetworkBuffer is a shared copy, otherwise NULL.  The
+ *                      caller must release the owner.
+ *
+ * @return pdTRUE when the descriptor must be returned to the pool now, pdFALSE
+ *         when other descriptors still refer to its Ethernet buffer.
+ */
+    static BaseType_t prvDropSharedReference( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                              NetworkBufferDescriptor_t ** ppxOwner )
+    {
+        BaseType_t xReleaseNow = pdTRUE;
+
+        *ppxOwner = NULL;
+
+        if( pxNetworkBuffer->pxSharedOwner != NULL )
+        {
+            /* A shared copy gets its own buffer back, and drops its
+             * reference on the owner. */
+            *ppxOwner = pxNetworkBuffer->pxSharedOwner;
+            pxNetworkBuffer->pxSharedOwner = NULL;
+            pxNetworkBuffer->pucEthernetBuffer = pxNetworkBuffer->pucOwnBuffer;
+            pxNetworkBuffer->pucOwnBuffer = NULL;
+        }
+        else if( pxNetworkBuffer->usShareCount > 1U )
+        {
+            pxNetworkBuffer->usShareCount--;
+
+            if( pxNetworkBuffer->usShareCount == 1U )
+            {
+                /* Zero means that a single reference is left. */
+                pxNetworkBuffer->usShareCount = 0U;
+            }
+
+            xReleaseNow = pdFALSE;
+        }
+        else
+        {
+            pxNetworkBuffer->usShareCount = 0U;
+        }
+
+        return xReleaseNow;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Drop a reference to a shared Ethernet buffer, called at the start of
+ *        vReleaseNetworkBufferAndDescriptor().  A shared copy gets its own
+ *        buffer back and drops its reference on the owner.  An owner is only
+ *        released when it is the last reference.
+ *
+ * @param[in] pxNetworkBuffer The network buffer that is being released.
+ *
+ * @return pdTRUE when the descriptor must be returned to the pool now, pdFALSE
+ *         when other descriptors still refer to its Ethernet buffer.
+ */
+    BaseType_t xReleaseSharedNetworkBuffer( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xReleaseNow;
+        NetworkBufferDescriptor_t * pxOwner;
+
+        taskENTER_CRITICAL();
+        {
+            xReleaseNow = prvDropSharedReference( pxNetworkBuffer, &( pxOwner ) );
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxOwner != NULL )
+        {
+            vReleaseNetworkBufferAndDescriptor( pxOwner );
+        }
+
+        return xReleaseNow;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The same as xReleaseSharedNetworkBuffer(), called at the start of
+ *        vNetworkBufferReleaseFromISR().
+ *
+ * @param[in] pxNetworkBuffer The network buffer that is being released.
+ * @param[out] ppxOwner Set to the owner of the Ethernet buffer when
+ *                      pxNetworkBuffer is a shared copy.  The caller must
+ *                      release the owner with vNetworkBufferReleaseFromISR().
+ *
+ * @return pdTRUE when the descriptor must be returned to the pool now, pdFALSE
+ *         when other descriptors still refer to its Ethernet buffer.
+ */
+    BaseType_t xReleaseSharedNetworkBufferFromISR( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                   NetworkBufferDescriptor_t ** ppxOwner )
+    {
+        BaseType_t xReleaseNow;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReleaseNow = prvDropSharedReference( pxNetworkBuffer, ppxOwner );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReleaseNow;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release a shared copy, while its reference to the Ethernet buffer is
+ *        handed over to the owner.  Used when a payload is passed to the user
+ *        with FREERTOS_ZERO_COPY: FreeRTOS_ReleaseUDPPayloadBuffer() finds the
+ *        owner from the payload pointer.
+ *
+ * @param[in] pxNetworkBuffer A received network buffer.
+ *
+ * @return The owner of the Ethernet buffer, or pxNetworkBuffer itself when it
+ *         is not a shared copy.
+ */
+    NetworkBufferDescriptor_t * pxUnshareNetworkBuffer( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkBufferDescriptor_t * pxOwner = pxNetworkBuffer->pxSharedOwner;
+
+        if( pxOwner != NULL )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxNetworkBuffer->pxSharedOwner = NULL;
+                pxNetworkBuffer->pucEthernetBuffer = pxNetworkBuffer->pucOwnBuffer;
+                pxNetworkBuffer->pucOwnBuffer = NULL;
+            }
+            taskEXIT_CRITICAL();
+
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+        else
+        {
+            pxOwner = pxNetworkBuffer;
+        }
+
+        return pxOwner;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) ) */
+
 /**
  * @brief Get the network buffer descriptor from the packet buffer.
  *
@@ -578,16 +782,35 @@ static void prvChecksumProtocolCalculate( BaseType_t xOutgoingPacket,
     }
     else
     {
+        /* The number of bytes of the UDP or TCP header and data that must be summed. */
+        size_t uxProtocolBytes = ( size_t ) pxSet->usProtocolBytes;
+
+        #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+        {
+            /* The payload at the end of the packet was summed while it was
+             * copied.  That sum can only be added when the payload starts at
+             * an even offset, which is always true for UDP and TCP. */
+            if( ( pxSet->uxPayloadChecksumLength <= uxProtocolBytes ) &&
+                ( ( ( uxProtocolBytes - pxSet->uxPayloadChecksumLength ) & 1U ) == 0U ) )
+            {
+                uxProtocolBytes -= pxSet->uxPayloadChecksumLength;
+            }
+            else
+            {
+                pxSet->usPayloadChecksum = 0U;
+            }
+        }
+        #endif /* ipconfigUSE_COPY_CHECKSUM != 0 */
+
         /* Default case is impossible to reach because it's checked before calling this function. */
         switch( pxSet->xIsIPv6 ) /* LCOV_EXCL_BR_LINE */
         {
             #if ( ipconfigUSE_IPv6 != 0 )
                 case pdTRUE:
                     /* The CRC of the IPv6 pseudo-header has already been calculated. */
-                    pxSet->usChecksum = ( uint16_t )
-                                        ( ~usGenerateChecksum( pxSet->usChecksum,
-                                                               ( uint8_t * ) &( pxSet->pxProtocolHeaders->xUDPHeader.usSourcePort ),
-                                                               ( size_t ) ( pxSet->usProtocolBytes ) ) );
+                    pxSet->usChecksum = usGenerateChecksum( pxSet->usChecksum,
+                                                            ( uint8_t * ) &( pxSet->pxProtocolHeaders->xUDPHeader.usSourcePort ),
+                                                            uxProtocolBytes );
                     break;
             #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
@@ -595,18 +818,17 @@ static void prvChecksumProtocolCalculate( BaseType_t xOutgoingPacket,
                 case pdFALSE:
                    {
                        /* The IPv4 pseudo header contains 2 IP-addresses, totalling 8 bytes. */
-                       uint32_t ulByteCount = pxSet->usProtocolBytes;
-                       ulByteCount += 2U * ipSIZE_OF_IPv4_ADDRESS;
+                       size_t uxByteCount = uxProtocolBytes;
+                       uxByteCount += 2U * ipSIZE_OF_IPv4_ADDRESS;
 
                        /* For UDP and TCP, sum the pseudo header, i.e. IP protocol + length
                         * fields */
                        pxSet->usChecksum = ( uint16_t ) ( pxSet->usProtocolBytes + ( ( uint16_t ) pxSet->ucProtocol ) );
 
                        /* And then continue at the IPv4 source and destination addresses. */
-                       pxSet->usChecksum = ( uint16_t )
-                                           ( ~usGenerateChecksum( pxSet->usChecksum,
-                                                                  ( const uint8_t * ) &( pxSet->pxIPPacket->xIPHeader.ulSourceIPAddress ),
-                                                                  ulByteCount ) );
+                       pxSet->usChecksum = usGenerateChecksum( pxSet->usChecksum,
+                                                               ( const uint8_t * ) &( pxSet->pxIPPacket->xIPHeader.ulSourceIPAddress ),
+                                                               uxByteCount );
                    }
                    break;
             #endif /* ( ipconfigUSE_IPv4 != 0 ) */
@@ -618,7 +840,19 @@ static void prvChecksumProtocolCalculate( BaseType_t xOutgoingPacket,
                 break; /* LCOV_EXCL_LINE */
         }
 
-        /* Sum TCP header and data. */
+        #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+        {
+            /* Add the sum of the payload, with an end-around carry. */
+            uint32_t ulSum = ( uint32_t ) pxSet->usChecksum + ( uint32_t ) pxSet->usPayloadChecksum;
+
+            ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+            pxSet->usChecksum = ( uint16_t ) ulSum;
+        }
+        #endif /* ipconfigUSE_COPY_CHECKSUM != 0 */
+
+        /* The checksum is the complement of the sum of the pseudo header, the
+         * protocol header and the data. */
+        pxSet->usChecksum = ( uint16_t ) ~pxSet->usChecksum;
     }
 
     if( xOutgoingPacket == pdFALSE )
@@ -1068,36 +1302,28 @@ void vPreCheckConfigs( void )
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Generate or check the protocol checksum of the data sent in the first parameter.
- *        At the same time, the length of the packet and the length of the different layers
- *        will be checked.
+ * @brief Generate or check the protocol checksum of a packet, as described
+ *        by usGenerateProtocolChecksum().
  *
  * @param[in] pucEthernetBuffer The Ethernet buffer for which the checksum is to be calculated
- *                               or checked.  'pucEthernetBuffer' is now non-const because the
- *                               function will set the checksum fields, in case 'xOutgoingPacket'
- *                               is pdTRUE.
+ *                               or checked.
  * @param[in] uxBufferLength the total number of bytes received, or the number of bytes written
  *                            in the packet buffer.
  * @param[in] xOutgoingPacket Whether this is an outgoing packet or not.
+ * @param[in] pxSet A zeroed struct that will describe this packet.
  *
- * @return When xOutgoingPacket is false: the error code can be either: ipINVALID_LENGTH,
- *         ipUNHANDLED_PROTOCOL, ipWRONG_CRC, or ipCORRECT_CRC.
- *         When xOutgoingPacket is true: either ipINVALID_LENGTH, ipUNHANDLED_PROTOCOL,
- *         or ipCORRECT_CRC.
+ * @return See usGenerateProtocolChecksum().
  */
-uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
-                                     size_t uxBufferLength,
-                                     BaseType_t xOutgoingPacket )
+static uint16_t prvGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
+                                             size_t uxBufferLength,
+                                             BaseType_t xOutgoingPacket,
+                                             struct xPacketSummary * pxSet )
 {
-    struct xPacketSummary xSet;
-
     DEBUG_DECLARE_TRACE_VARIABLE( BaseType_t, xLocation, 0 );
 
-    ( void ) memset( &( xSet ), 0, sizeof( xSet ) );
-
     #if ( ipconfigHAS_DEBUG_PRINTF != 0 )
     {
-        xSet.pcType = "???";
+        pxSet->pcType = "???";
     }
     #endif /* ipconfigHAS_DEBUG_PRINTF != 0 */
 
@@ -1114,13 +1340,13 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
         /* MISRA Ref 11.3.1 [Misaligned access] */
         /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
         /* coverity[misra_c_2012_rule_11_3_violation] */
-        xSet.pxIPPacket = ( ( const IPPacket_t * ) pucEthernetBuffer );
+        pxSet->pxIPPacket = ( ( const IPPacket_t * ) pucEthernetBuffer );
 
-        switch( xSet.pxIPPacket->xEthernetHeader.usFrameType ) /* LCOV_EXCL_BR_LINE */
+        switch( pxSet->pxIPPacket->xEthernetHeader.usFrameType ) /* LCOV_EXCL_BR_LINE */
         {
             #if ( ipconfigUSE_IPv4 != 0 )
                 case ipIPv4_FRAME_TYPE:
-                    xResult = prvChecksumIPv4Checks( pucEthernetBuffer, uxBufferLength, &( xSet ) );
+                    xResult = prvChecksumIPv4Checks( pucEthernetBuffer, uxBufferLength, pxSet );
 
                     break;
             #endif /* ( ipconfigUSE_IPv4 != 0 ) */
@@ -1130,17 +1356,17 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
                     /* MISRA Ref 11.3.1 [Misaligned access] */
                     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
                     /* coverity[misra_c_2012_rule_11_3_violation] */
-                    xSet.pxIPPacket_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+                    pxSet->pxIPPacket_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
 
-                    xResult = prvChecksumIPv6Checks( pucEthernetBuffer, uxBufferLength, &( xSet ) );
+                    xResult = prvChecksumIPv6Checks( pucEthernetBuffer, uxBufferLength, pxSet );
                     break;
             #endif /* ( ipconfigUSE_IPv6 != 0 ) */
 
             default:
                 /* MISRA 16.4 Compliance */
-                FreeRTOS_debug_printf( ( "usGenerateProtocolChecksum: Undefined usFrameType %d\n", xSet.pxIPPacket->xEthernetHeader.usFrameType ) );
+                FreeRTOS_debug_printf( ( "usGenerateProtocolChecksum: Undefined usFrameType %d\n", pxSet->pxIPPacket->xEthernetHeader.usFrameType ) );
 
-                xSet.usChecksum = ipINVALID_LENGTH;
+                pxSet->usChecksum = ipINVALID_LENGTH;
                 xResult = 1;
                 break;
         }
@@ -1152,7 +1378,7 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
         }
 
         {
-            xResult = prvChecksumProtocolChecks( uxBufferLength, &( xSet ) );
+            xResult = prvChecksumProtocolChecks( uxBufferLength, pxSet );
 
             if( xResult != 0 )
             {
@@ -1167,20 +1393,20 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
         {
             /* This is an outgoing packet. Before calculating the checksum, set it
              * to zero. */
-            prvSetChecksumInPacket( &( xSet ), 0 );
+            prvSetChecksumInPacket( pxSet, 0 );
         }
-        else if( ( prvGetChecksumFromPacket( &( xSet ) ) == 0U ) && ( xSet.ucProtocol == ( uint8_t ) ipPROTOCOL_UDP ) )
+        else if( ( prvGetChecksumFromPacket( pxSet ) == 0U ) && ( pxSet->ucProtocol == ( uint8_t ) ipPROTOCOL_UDP ) )
         {
             #if ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 )
             {
                 /* Sender hasn't set the checksum, drop the packet because
                  * ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS is not set. */
-                xSet.usChecksum = ipWRONG_CRC;
+                pxSet->usChecksum = ipWRONG_CRC;
             }
             #else /* if ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 ) */
             {
                 /* Sender hasn't set the checksum, no use to calculate it. */
-                xSet.usChecksum = ipCORRECT_CRC;
+                pxSet->usChecksum = ipCORRECT_CRC;
             }
             #endif /* if ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 ) */
             DEBUG_SET_TRACE_VARIABLE( xLocation, 12 );
@@ -1191,7 +1417,7 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
             /* This is an incoming packet, not being an UDP packet without a checksum. */
         }
 
-        xResult = prvChecksumProtocolMTUCheck( &( xSet ) );
+        xResult = prvChecksumProtocolMTUCheck( pxSet );
 
         if( xResult != 0 )
         {
@@ -1200,29 +1426,444 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
         }
 
         /* Do the actual calculations. */
-        prvChecksumProtocolCalculate( xOutgoingPacket, pucEthernetBuffer, &( xSet ) );
+        prvChecksumProtocolCalculate( xOutgoingPacket, pucEthernetBuffer, pxSet );
 
         /* For outgoing packets, set the checksum in the packet,
          * for incoming packets: show logging in case an error occurred. */
-        prvChecksumProtocolSetChecksum( xOutgoingPacket, pucEthernetBuffer, uxBufferLength, &( xSet ) );
+        prvChecksumProtocolSetChecksum( xOutgoingPacket, pucEthernetBuffer, uxBufferLength, pxSet );
 
         if( xOutgoingPacket != pdFALSE )
         {
-            xSet.usChecksum = ( uint16_t ) ipCORRECT_CRC;
+            pxSet->usChecksum = ( uint16_t ) ipCORRECT_CRC;
         }
     } while( ipFALSE_BOOL );
 
     #if ( ipconfigHAS_PRINTF == 1 )
         if( xLocation != 0 )
         {
-            FreeRTOS_printf( ( "CRC error: %04x location %ld\n", xSet.usChecksum, xLocation ) );
+            FreeRTOS_printf( ( "CRC error: %04x location %ld\n", pxSet->usChecksum, xLocation ) );
         }
     #endif /* ( ipconfigHAS_PRINTF == 1 ) */
 
-    return xSet.usChecksum;
+    return pxSet->usChecksum;
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Generate or check the protocol checksum of the data sent in the first parameter.
+ *        At the same time, the length of the packet and the length of the different layers
+ *        will be checked.
+ *
+ * @param[in] pucEthernetBuffer The Ethernet buffer for which the checksum is to be calculated
+ *                               or checked.  'pucEthernetBuffer' is now non-const because the
+ *                               function will set the checksum fields, in case 'xOutgoingPacket'
+ *                               is pdTRUE.
+ * @param[in] uxBufferLength the total number of bytes received, or the number of bytes written
+ *                            in the packet buffer.
+ * @param[in] xOutgoingPacket Whether this is an outgoing packet or not.
+ *
+ * @return When xOutgoingPacket is false: the error code can be either: ipINVALID_LENGTH,
+ *         ipUNHANDLED_PROTOCOL, ipWRONG_CRC, or ipCORRECT_CRC.
+ *         When xOutgoingPacket is true: either ipINVALID_LENGTH, ipUNHANDLED_PROTOCOL,
+ *         or ipCORRECT_CRC.
+ */
+uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
+                                     size_t uxBufferLength,
+                                     BaseType_t xOutgoingPacket )
+{
+    struct xPacketSummary xSet;
+
+    ( void ) memset( &( xSet ), 0, sizeof( xSet ) );
+
+    return prvGenerateProtocolChecksum( pucEthernetBuffer, uxBufferLength, xOutgoingPacket, &( xSet ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+
+/**
+ * @brief Set the protocol checksum of an outgoing packet, like usGenerateProtocolChecksum()
+ *        does.  When the payload was summed while it was copied into the network buffer,
+ *        only the headers are read, and that sum is added.  The sum is consumed, it will
+ *        not be used for a later transmission of the same buffer.
+ *
+ * @param[in] pxNetworkBuffer The network buffer that holds the packet.
+ * @param[in] pucEthernetBuffer The Ethernet buffer for which the checksum is to be calculated.
+ * @param[in] uxBufferLength The number of bytes written in the packet buffer.
+ *
+ * @return Either ipINVALID_LENGTH, ipUNHANDLED_PROTOCOL, or ipCORRECT_CRC.
+ */
+    uint16_t usGenerateProtocolChecksumCopied( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                               uint8_t * pucEthernetBuffer,
+                                               size_t uxBufferLength )
+    {
+        struct xPacketSummary xSet;
+
+        ( void ) memset( &( xSet ), 0, sizeof( xSet ) );
+
+        xSet.usPayloadChecksum = pxNetworkBuffer->usPayloadChecksum;
+        xSet.uxPayloadChecksumLength = ( size_t ) pxNetworkBuffer->usPayloadChecksumLength;
+        pxNetworkBuffer->usPayloadChecksumLength = 0U;
+
+        return prvGenerateProtocolChecksum( pucEthernetBuffer, uxBufferLength, pdTRUE, &( xSet ) );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_COPY_CHECKSUM != 0 */
+
+#if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+
+/**
+ * @brief Check whether the checksums of a received packet still have to be verified.
+ *        That is not needed when the interface that received it has RX checksum
+ *        offloading, or when the driver has verified this packet.
+ *
+ * @param[in] pxNetworkBuffer The network buffer that holds the received packet.
+ *
+ * @return pdTRUE when the checksums have been verified, pdFALSE when the stack must
+ *         verify them.
+ */
+    BaseType_t xIsRxChecksumOffloaded( const NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pxNetworkBuffer->ucChecksumFlags & ipBUFFER_CHECKSUM_VERIFIED ) != 0U )
+        {
+            xReturn = pdTRUE;
+        }
+        else if( ( pxNetworkBuffer->pxInterface != NULL ) &&
+                 ( ( pxNetworkBuffer->pxInterface->ucChecksumOffload & ipINTERFACE_CHECKSUM_OFFLOAD_RX ) != 0U ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            /* The checksums must be verified in software. */
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called just before an outgoing packet is passed to an interface.  When the
+ *        interface has TX checksum offloading, an IP packet is flagged with
+ *        ipBUFFER_CHECKSUM_NEEDED.  Otherwise the IP-header checksum and the protocol
+ *        checksum are calculated here.
+ *
+ * @param[in] pxInterface The interface that will send the packet.
+ * @param[in] pxNetworkBuffer The network buffer that holds the outgoing packet.
+ */
+    void vPrepareTxChecksums( const struct xNetworkInterface * pxInterface,
+                              NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const EthernetHeader_t * pxEthernetHeader = ( ( const EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+        uint16_t usFrameType = pxEthernetHeader->usFrameType;
+
+        pxNetworkBuffer->ucChecksumFlags &= ( uint8_t ) ~ipBUFFER_CHECKSUM_NEEDED;
+
+        if( ( usFrameType == ipIPv4_FRAME_TYPE ) || ( usFrameType == ipIPv6_FRAME_TYPE ) )
+        {
+            if( ( pxInterface->ucChecksumOffload & ipINTERFACE_CHECKSUM_OFFLOAD_TX ) != 0U )
+            {
+                pxNetworkBuffer->ucChecksumFlags |= ( uint8_t ) ipBUFFER_CHECKSUM_NEEDED;
+
+                #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+                {
+                    /* The sum of the payload is not needed, drop it. */
+                    pxNetworkBuffer->usPayloadChecksumLength = 0U;
+                }
+                #endif
+            }
+            else
+            {
+                if( usFrameType == ipIPv4_FRAME_TYPE )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    IPHeader_t * pxIPHeader = ( ( IPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+                    size_t uxIPHeaderLength = ( size_t ) ( ( pxIPHeader->ucVersionHeaderLength & 0x0FU ) << 2 );
+
+                    pxIPHeader->usHeaderChecksum = 0U;
+                    pxIPHeader->usHeaderChecksum = usGenerateChecksum( 0U, ( uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), uxIPHeaderLength );
+                    pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
+                }
+
+                #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+                {
+                    ( void ) usGenerateProtocolChecksumCopied( pxNetworkBuffer, pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength );
+                }
+                #else
+                {
+                    ( void ) usGenerateProtocolChecksum( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, pdTRUE );
+                }
+                #endif
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 */
+
+/**
+ * @brief Classify a received frame, checking the lengths that are needed to
+ *        access its headers.  The IP-header length and the protocol are stored
+ *        in the summary.  So are the ports of a TCP or UDP packet that is not a
+ *        fragment and that does not have IPv6 extension headers.  The frame is
+ *        only read, so this function can also be called from a network driver.
+ *
+ * @param[in] pucEthernetBuffer The received Ethernet frame.
+ * @param[in] uxBufferLength The number of bytes received.
+ * @param[out] pxSummary Where to store the results.
+ *
+ * @return The class of the frame, also stored in pxSummary->eClass.
+ */
+eFrameClass_t eClassifyFrame( const uint8_t * pucEthernetBuffer,
+                              size_t uxBufferLength,
+                              FrameSummary_t * pxSummary )
+{
+    eFrameClass_t eClass = eFrameClassInvalid;
+    size_t uxPortsOffset = 0U;
+
+    ( void ) memset( pxSummary, 0, sizeof( *pxSummary ) );
+
+    if( uxBufferLength >= sizeof( EthernetHeader_t ) )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const EthernetHeader_t * pxEthernetHeader = ( ( const EthernetHeader_t * ) pucEthernetBuffer );
+
+        switch( pxEthernetHeader->usFrameType )
+        {
+            case ipARP_FRAME_TYPE:
+
+                if( uxBufferLength >= sizeof( ARPPacket_t ) )
+                {
+                    eClass = eFrameClassARP;
+                }
+
+                break;
+
+            case ipIPv4_FRAME_TYPE:
+
+                if( uxBufferLength >= sizeof( IPPacket_t ) )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                    /* The lowest four bits of 'ucVersionHeaderLength' indicate the
+                     * IP-header length in multiples of 4. */
+                    pxSummary->uxIPHeaderLength = ( size_t ) ( ( ( size_t ) pxIPHeader->ucVersionHeaderLength & 0x0FU ) << 2 );
+                    pxSummary->ucProtocol = pxIPHeader->ucProtocol;
+
+                    if( ( pxSummary->uxIPHeaderLength >= ipSIZE_OF_IPv4_HEADER ) &&
+                        ( pxSummary->uxIPHeaderLength <= ( uxBufferLength - ipSIZE_OF_ETH_HEADER ) ) )
+                    {
+                        eClass = eFrameClassIPv4;
+
+                        if( ( pxIPHeader->usFragmentOffset & ipFRAGMENT_OFFSET_BIT_MASK ) == 0U )
+                        {
+                            uxPortsOffset = ipSIZE_OF_ETH_HEADER + pxSummary->uxIPHeaderLength;
+                        }
+                    }
+                }
+
+                break;
+
+            case ipIPv6_FRAME_TYPE:
+
+                if( uxBufferLength >= sizeof( IPPacket_IPv6_t ) )
+                {
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    const IPHeader_IPv6_t * pxIPHeader_IPv6 = ( ( const IPHeader_IPv6_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                    eClass = eFrameClassIPv6;
+                    pxSummary->uxIPHeaderLength = ipSIZE_OF_IPv6_HEADER;
+                    pxSummary->ucProtocol = pxIPHeader_IPv6->ucNextHeader;
+                    uxPortsOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER;
+                }
+
+                break;
+
+            default:
+                eClass = eFrameClassOther;
+                break;
+        }
+    }
+
+    if( ( uxPortsOffset != 0U ) &&
+        ( ( pxSummary->ucProtocol == ( uint8_t ) ipPROTOCOL_UDP ) || ( pxSummary->ucProtocol == ( uint8_t ) ipPROTOCOL_TCP ) ) &&
+        ( uxBufferLength >= ( uxPortsOffset + ( 2U * sizeof( uint16_t ) ) ) ) )
+    {
+        /* UDP and TCP both start with the source and the destination port. */
+        ( void ) memcpy( &( pxSummary->usSourcePort ), &( pucEthernetBuffer[ uxPortsOffset ] ), sizeof( uint16_t ) );
+        ( void ) memcpy( &( pxSummary->usDestinationPort ), &( pucEthernetBuffer[ uxPortsOffset + sizeof( uint16_t ) ] ), sizeof( uint16_t ) );
+    }
+
+    pxSummary->eClass = eClass;
+
+    return eClass;
+}
+/*-----------------------------------------------------------*/
+
+/** @brief The length of the Toeplitz key, enough for the IPv6 addresses and ports. */
+#define ipRSS_HASH_KEY_LENGTH    40U
+
+/** @brief The default Toeplitz key of the Microsoft RSS specification, which is
+ *         also the default of most NICs. */
+static const uint8_t ucRSSHashKey[ ipRSS_HASH_KEY_LENGTH ] =
+{
+    0x6dU, 0x5aU, 0x56U, 0xdaU, 0x25U, 0x5bU, 0x0eU, 0xc2U,
+    0x41U, 0x67U, 0x25U, 0x3dU, 0x43U, 0xa3U, 0x8fU, 0xb0U,
+    0xd0U, 0xcaU, 0x2bU, 0xcbU, 0xaeU, 0x7bU, 0x30U, 0xb4U,
+    0x77U, 0xcbU, 0x2dU, 0xa3U, 0x80U, 0x30U, 0xf2U, 0x0cU,
+    0x6aU, 0x42U, 0xb7U, 0x3bU, 0xbeU, 0xacU, 0x01U, 0xfaU
+};
+
+/**
+ * @brief Calculate the Toeplitz hash of some bytes: for every bit of the input
+ *        that is set, the 32 bits of the key that start at that bit position
+ *        are XOR'd into the result.
+ *
+ * @param[in] pucInput The bytes to be hashed.
+ * @param[in] uxLength The number of bytes, at most ipRSS_HASH_KEY_LENGTH - 4.
+ *
+ * @return The 32-bit hash.
+ */
+static uint32_t prvToeplitzHash( const uint8_t * pucInput,
+                                 size_t uxLength )
+{
+    uint32_t ulResult = 0U;
+    uint32_t ulKey = ( ( ( uint32_t ) ucRSSHashKey[ 0 ] ) << 24 ) |
+                     ( ( ( uint32_t ) ucRSSHashKey[ 1 ] ) << 16 ) |
+                     ( ( ( uint32_t ) ucRSSHashKey[ 2 ] ) << 8 ) |
+                     ( ( uint32_t ) ucRSSHashKey[ 3 ] );
+    size_t uxIndex;
+    BaseType_t xBit;
+
+    for( uxIndex = 0U; uxIndex < uxLength; uxIndex++ )
+    {
+        uint8_t ucNextKeyByte = ucRSSHashKey[ uxIndex + 4U ];
+
+        for( xBit = 7; xBit >= 0; xBit-- )
+        {
+            if( ( pucInput[ uxIndex ] & ( uint8_t ) ( 1U << xBit ) ) != 0U )
+            {
+                ulResult ^= ulKey;
+            }
+
+            /* Shift the next bit of the key in. */
+            ulKey = ( ulKey << 1 ) | ( ( uint32_t ) ( ucNextKeyByte >> xBit ) & 1U );
+        }
+    }
+
+    return ulResult;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the RSS hash of a received frame, over the source and
+ *        destination IP addresses and, when known, the TCP/UDP ports.  It is
+ *        used to steer frames to the RX worker tasks, and a network driver may
+ *        use it to choose a queue for a frame.
+ *
+ * @param[in] pucEthernetBuffer The received frame.
+ * @param[in] pxSummary The headers of the frame, as parsed by eClassifyFrame().
+ *
+ * @return The hash, or zero when the frame is not an IP packet.
+ */
+uint32_t ulFrameFlowHash( const uint8_t * pucEthernetBuffer,
+                          const FrameSummary_t * pxSummary )
+{
+    /* The addresses and ports, in network-byte-order. */
+    uint8_t ucTuple[ ( 2U * ipSIZE_OF_IPv6_ADDRESS ) + ( 2U * sizeof( uint16_t ) ) ];
+    size_t uxLength = 0U;
+    uint32_t ulHash = 0U;
+
+    if( pxSummary->eClass == eFrameClassIPv4 )
+    {
+        uxLength = 2U * ipSIZE_OF_IPv4_ADDRESS;
+        ( void ) memcpy( ucTuple, &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + offsetof( IPHeader_t, ulSourceIPAddress ) ] ), uxLength );
+    }
+    else if( pxSummary->eClass == eFrameClassIPv6 )
+    {
+        uxLength = 2U * ipSIZE_OF_IPv6_ADDRESS;
+        ( void ) memcpy( ucTuple, &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + offsetof( IPHeader_IPv6_t, xSourceAddress ) ] ), uxLength );
+    }
+    else
+    {
+        /* Not an IP packet. */
+    }
+
+    if( uxLength != 0U )
+    {
+        if( pxSummary->usDestinationPort != 0U )
+        {
+            ( void ) memcpy( &( ucTuple[ uxLength ] ), &( pxSummary->usSourcePort ), sizeof( uint16_t ) );
+            ( void ) memcpy( &( ucTuple[ uxLength + sizeof( uint16_t ) ] ), &( pxSummary->usDestinationPort ), sizeof( uint16_t ) );
+            uxLength += 2U * sizeof( uint16_t );
+        }
+
+        ulHash = prvToeplitzHash( ucTuple, uxLength );
+    }
+
+    return ulHash;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigRX_WORKER_TASKS > 0 )
+
+/**
+ * @brief Verify the IP-header checksum and the protocol checksum of a received
+ *        IP packet.  When both are correct, the network buffer is marked with
+ *        ipBUFFER_CHECKSUM_VERIFIED, so that the IP-task does not check them
+ *        again.  Otherwise nothing changes and the IP-task will check, and drop,
+ *        the packet.
+ *
+ * @param[in] pxNetworkBuffer The network buffer holding the packet.
+ * @param[in] pxSummary The headers of the packet, as parsed by eClassifyFrame().
+ */
+    void vVerifyRxChecksums( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                             const FrameSummary_t * pxSummary )
+    {
+        BaseType_t xCorrect = pdFALSE;
+
+        if( pxSummary->eClass == eFrameClassIPv4 )
+        {
+            if( usGenerateChecksum( 0U, &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ), pxSummary->uxIPHeaderLength ) == ipCORRECT_CRC )
+            {
+                xCorrect = pdTRUE;
+            }
+        }
+        else if( pxSummary->eClass == eFrameClassIPv6 )
+        {
+            /* IPv6 has no header checksum. */
+            xCorrect = pdTRUE;
+        }
+        else
+        {
+            /* Not an IP packet. */
+        }
+
+        if( ( xCorrect != pdFALSE ) &&
+            ( usGenerateProtocolChecksum( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, pdFALSE ) == ipCORRECT_CRC ) )
+        {
+            pxNetworkBuffer->ucChecksumFlags |= ipBUFFER_CHECKSUM_VERIFIED;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigRX_WORKER_TASKS > 0 ) */
+
 /**
  * This method generates a checksum for a given IPv4 header, per RFC791 (page 14).
  * The checksum algorithm is described as:
@@ -1257,6 +1898,10 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
  *   should process.
  */
 
+#if ( ipconfigCHECKSUM_KERNEL == ipconfigCHECKSUM_KERNEL_PORTABLE )
+
+/* Other kernels are implemented in FreeRTOS_IP_Checksum.c. */
+
 /**
  * @brief Calculates the 16-bit checksum of an array of bytes
  *
@@ -1436,6 +2081,8 @@ uint16_t usGenerateChecksum( uint16_t usSum,
 }
 /*-----------------------------------------------------------*/
 
+#endif /* ipconfigCHECKSUM_KERNEL == ipconfigCHECKSUM_KERNEL_PORTABLE */
+
 #if ( ipconfigHAS_PRINTF != 0 )
 
     #ifndef ipMONITOR_MAX_HEAP
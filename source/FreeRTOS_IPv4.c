@@ -185,6 +185,60 @@
 #endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 ) || ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 ) )
+
+/**
+ * @brief Verify the IP-header checksum and the protocol checksum of a received
+ *        IPv4 packet.
+ *
+ * @param[in] pxIPPacket The IP packet under consideration.
+ * @param[in] pxNetworkBuffer The whole network buffer.
+ * @param[in] uxHeaderLength The length of the header.
+ *
+ * @return eProcessBuffer when the checksums are correct, otherwise eReleaseBuffer.
+ */
+    static eFrameProcessingResult_t prvCheckIPv4Checksums( const IPPacket_t * const pxIPPacket,
+                                                           const NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                           UBaseType_t uxHeaderLength )
+    {
+        eFrameProcessingResult_t eReturn = eProcessBuffer;
+        const IPHeader_t * pxIPHeader = &( pxIPPacket->xIPHeader );
+        const NetworkEndPoint_t * pxEndPoint = FreeRTOS_FindEndPointOnMAC( &( pxIPPacket->xEthernetHeader.xSourceAddress ), NULL );
+
+        /* Do not check the checksum of loop-back messages. */
+        if( pxEndPoint == NULL )
+        {
+            /* Is the IP header checksum correct?
+             *
+             * NOTE: When the checksum of IP header is calculated while not omitting
+             * the checksum field, the resulting value of the checksum always is 0xffff
+             * which is denoted by ipCORRECT_CRC. See this wiki for more information:
+             * https://en.wikipedia.org/wiki/IPv4_header_checksum#Verifying_the_IPv4_header_checksum
+             * and this RFC: https://tools.ietf.org/html/rfc1624#page-4
+             */
+            if( usGenerateChecksum( 0U, ( const uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ( size_t ) uxHeaderLength ) != ipCORRECT_CRC )
+            {
+                /* Check sum in IP-header not correct. */
+                eReturn = eReleaseBuffer;
+            }
+            /* Is the upper-layer checksum (TCP/UDP/ICMP) correct? */
+            else if( usGenerateProtocolChecksum( ( uint8_t * ) ( pxNetworkBuffer->pucEthernetBuffer ), pxNetworkBuffer->xDataLength, pdFALSE ) != ipCORRECT_CRC )
+            {
+                /* Protocol checksum not accepted. */
+                eReturn = eReleaseBuffer;
+            }
+            else
+            {
+                /* The checksum of the received packet is OK. */
+            }
+        }
+
+        return eReturn;
+    }
+
+#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 ) || ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 ) */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Is the IP address an IPv4 multicast address.
  *
@@ -334,13 +388,8 @@ enum eFrameProcessingResult prvAllowIPPacketIPv4( const struct xIP_PACKET * cons
 {
     eFrameProcessingResult_t eReturn = eProcessBuffer;
 
-    #if ( ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 0 ) || ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 ) )
+    #if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 0 )
         const IPHeader_t * pxIPHeader = &( pxIPPacket->xIPHeader );
-    #else
-
-        /* or else, the parameter won't be used and the function will be optimised
-         * away */
-        ( void ) pxIPPacket;
     #endif
 
     #if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 0 )
@@ -487,39 +536,21 @@ enum eFrameProcessingResult prvAllowIPPacketIPv4( const struct xIP_PACKET * cons
          * define, so that the checksum won't be checked again here */
         if( eReturn == eProcessBuffer )
         {
-            const NetworkEndPoint_t * pxEndPoint = FreeRTOS_FindEndPointOnMAC( &( pxIPPacket->xEthernetHeader.xSourceAddress ), NULL );
-
-            /* Do not check the checksum of loop-back messages. */
-            if( pxEndPoint == NULL )
-            {
-                /* Is the IP header checksum correct?
-                 *
-                 * NOTE: When the checksum of IP header is calculated while not omitting
-                 * the checksum field, the resulting value of the checksum always is 0xffff
-                 * which is denoted by ipCORRECT_CRC. See this wiki for more information:
-                 * https://en.wikipedia.org/wiki/IPv4_header_checksum#Verifying_the_IPv4_header_checksum
-                 * and this RFC: https://tools.ietf.org/html/rfc1624#page-4
-                 */
-                if( usGenerateChecksum( 0U, ( const uint8_t * ) &( pxIPHeader->ucVersionHeaderLength ), ( size_t ) uxHeaderLength ) != ipCORRECT_CRC )
-                {
-                    /* Check sum in IP-header not correct. */
-                    eReturn = eReleaseBuffer;
-                }
-                /* Is the upper-layer checksum (TCP/UDP/ICMP) correct? */
-                else if( usGenerateProtocolChecksum( ( uint8_t * ) ( pxNetworkBuffer->pucEthernetBuffer ), pxNetworkBuffer->xDataLength, pdFALSE ) != ipCORRECT_CRC )
-                {
-                    /* Protocol checksum not accepted. */
-                    eReturn = eReleaseBuffer;
-                }
-                else
-                {
-                    /* The checksum of the received packet is OK. */
-                }
-            }
+            eReturn = prvCheckIPv4Checksums( pxIPPacket, pxNetworkBuffer, uxHeaderLength );
         }
     }
     #else /* if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 ) */
     {
+        #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+        {
+            /* The interface that received this packet may not check checksums. */
+            if( ( eReturn == eProcessBuffer ) && ( xIsRxChecksumOffloaded( pxNetworkBuffer ) == pdFALSE ) )
+            {
+                eReturn = prvCheckIPv4Checksums( pxIPPacket, pxNetworkBuffer, uxHeaderLength );
+            }
+        }
+        #endif
+
         if( eReturn == eProcessBuffer )
         {
             if( xCheckIPv4SizeFields( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength ) != pdPASS )
@@ -574,6 +605,7 @@ enum eFrameProcessingResult prvAllowIPPacketIPv4( const struct xIP_PACKET * cons
         #endif /* ( ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS == 0 ) */
 
         /* to avoid warning unused parameters */
+        ( void ) pxIPPacket;
         ( void ) pxNetworkBuffer;
         ( void ) uxHeaderLength;
     }
@@ -262,6 +262,43 @@ const struct xIPv6_Address FreeRTOS_in6addr_loopback = { { 0U, 0U, 0U, 0U, 0U, 0
 #endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 1 ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 ) || ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 ) )
+
+/**
+ * @brief Verify the protocol checksum of a received IPv6 packet.  IPv6 does not
+ *        have a separate checksum in the IP-header.
+ *
+ * @param[in] pxNetworkBuffer The whole network buffer.
+ *
+ * @return eProcessBuffer when the checksum is correct, otherwise eReleaseBuffer.
+ */
+    static eFrameProcessingResult_t prvCheckIPv6Checksum( const NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        eFrameProcessingResult_t eReturn = eProcessBuffer;
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const IPPacket_t * pxIPPacket = ( ( const IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+        const NetworkEndPoint_t * pxEndPoint = FreeRTOS_FindEndPointOnMAC( &( pxIPPacket->xEthernetHeader.xSourceAddress ), NULL );
+
+        /* Is the upper-layer checksum (TCP/UDP/ICMP) correct? */
+        /* Do not check the checksum of loop-back messages. */
+        if( pxEndPoint == NULL )
+        {
+            if( usGenerateProtocolChecksum( ( uint8_t * ) ( pxNetworkBuffer->pucEthernetBuffer ), pxNetworkBuffer->xDataLength, pdFALSE ) != ipCORRECT_CRC )
+            {
+                /* Protocol checksum not accepted. */
+                eReturn = eReleaseBuffer;
+            }
+        }
+
+        return eReturn;
+    }
+
+#endif /* ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 ) || ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 ) */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Get the group ID and stored into IPv6_Address_t.
  *
@@ -544,27 +581,21 @@ eFrameProcessingResult_t prvAllowIPPacketIPv6( const IPHeader_IPv6_t * const pxI
          * define, so that the checksum won't be checked again here */
         if( eReturn == eProcessBuffer )
         {
-            /* MISRA Ref 11.3.1 [Misaligned access] */
-            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-            /* coverity[misra_c_2012_rule_11_3_violation] */
-            const IPPacket_t * pxIPPacket = ( ( const IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
-            const NetworkEndPoint_t * pxEndPoint = FreeRTOS_FindEndPointOnMAC( &( pxIPPacket->xEthernetHeader.xSourceAddress ), NULL );
-
-            /* IPv6 does not have a separate checksum in the IP-header */
-            /* Is the upper-layer checksum (TCP/UDP/ICMP) correct? */
-            /* Do not check the checksum of loop-back messages. */
-            if( pxEndPoint == NULL )
-            {
-                if( usGenerateProtocolChecksum( ( uint8_t * ) ( pxNetworkBuffer->pucEthernetBuffer ), pxNetworkBuffer->xDataLength, pdFALSE ) != ipCORRECT_CRC )
-                {
-                    /* Protocol checksum not accepted. */
-                    eReturn = eReleaseBuffer;
-                }
-            }
+            eReturn = prvCheckIPv6Checksum( pxNetworkBuffer );
         }
     }
     #else /* if ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 ) */
     {
+        #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+        {
+            /* The interface that received this packet may not check checksums. */
+            if( ( eReturn == eProcessBuffer ) && ( xIsRxChecksumOffloaded( pxNetworkBuffer ) == pdFALSE ) )
+            {
+                eReturn = prvCheckIPv6Checksum( pxNetworkBuffer );
+            }
+        }
+        #endif
+
         if( eReturn == eProcessBuffer )
         {
             if( xCheckIPv6SizeFields( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength ) != pdPASS )
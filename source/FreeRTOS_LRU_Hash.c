@@ -0,0 +1,357 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_LRU_Hash.c
+ * @brief A hash index and an LRU list over the entries of a fixed-size cache, as
+ *        used by the ARP, ND and DNS caches.
+ *
+ * The entries are referred to by their index.  Each entry has a link to the next
+ * entry in its hash bucket, and two links in a doubly-linked LRU list.  A new
+ * entry is taken from the entries that have never been used, and when there are
+ * none left, the least recently used entry is re-used.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_LRU_Hash.h"
+
+#if ( lruHASH_IS_USED )
+
+/** @brief Convert an entry number to a link. */
+    #define lruLINK( xEntry )     ( ( LRUHashLink_t ) ( ( xEntry ) + 1 ) )
+
+/** @brief Convert a link to an entry number, -1 for "no entry". */
+    #define lruENTRY( xLink )     ( ( BaseType_t ) ( xLink ) - 1 )
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Calculate the hash bucket of a hash value.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] ulHash The hash of a key.
+ *
+ * @return The bucket number.
+ */
+    static size_t prvLRUHashBucket( const LRUHashTable_t * pxTable,
+                                    uint32_t ulHash )
+    {
+        /* Fold the higher bits into the lowest bits. */
+        uint32_t ulValue = ulHash ^ ( ulHash >> 16 );
+
+        ulValue ^= ulValue >> 8;
+
+        return ( size_t ) ( ulValue & ( ( uint32_t ) pxTable->uxBucketCount - 1U ) );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check whether an entry is in the LRU list.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] xEntry The entry number.
+ *
+ * @return pdTRUE when the entry is in the list.
+ */
+    static BaseType_t prvLRUInList( const LRUHashTable_t * pxTable,
+                                    BaseType_t xEntry )
+    {
+        return ( ( pxTable->pxLinks[ xEntry ].xLRUPrev != 0U ) ||
+                 ( pxTable->xLRUHead == lruLINK( xEntry ) ) ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add an entry to the tail of the LRU list.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] xEntry The entry number, which must not be in the list.
+ */
+    static void prvLRUAppend( LRUHashTable_t * pxTable,
+                              BaseType_t xEntry )
+    {
+        LRUHashLinks_t * pxLinks = &( pxTable->pxLinks[ xEntry ] );
+
+        pxLinks->xLRUPrev = pxTable->xLRUTail;
+        pxLinks->xLRUNext = 0U;
+
+        if( pxTable->xLRUTail != 0U )
+        {
+            pxTable->pxLinks[ lruENTRY( pxTable->xLRUTail ) ].xLRUNext = lruLINK( xEntry );
+        }
+        else
+        {
+            pxTable->xLRUHead = lruLINK( xEntry );
+        }
+
+        pxTable->xLRUTail = lruLINK( xEntry );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the first entry in the hash bucket of a hash value.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] ulHash The hash of the key that is looked up.
+ *
+ * @return The entry number, or -1 when the bucket is empty.
+ */
+    BaseType_t xLRUHashFirst( const LRUHashTable_t * pxTable,
+                              uint32_t ulHash )
+    {
+        return lruENTRY( pxTable->pxHeads[ prvLRUHashBucket( pxTable, ulHash ) ] );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the next entry in the same hash bucket.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] xEntry The current entry number.
+ *
+ * @return The entry number, or -1 at the end of the bucket.
+ */
+    BaseType_t xLRUHashNext( const LRUHashTable_t * pxTable,
+                             BaseType_t xEntry )
+    {
+        return lruENTRY( pxTable->pxLinks[ xEntry ].xHashNext );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add an entry to the hash bucket of its key.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] ulHash The hash of the key of the entry.
+ * @param[in] xEntry The entry number, which must not be in a bucket.
+ */
+    void vLRUHashInsert( LRUHashTable_t * pxTable,
+                         uint32_t ulHash,
+                         BaseType_t xEntry )
+    {
+        size_t uxBucket = prvLRUHashBucket( pxTable, ulHash );
+
+        pxTable->pxLinks[ xEntry ].xHashNext = pxTable->pxHeads[ uxBucket ];
+        pxTable->pxHeads[ uxBucket ] = lruLINK( xEntry );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove an entry from the hash bucket of its key.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] ulHash The hash of the key with which the entry was inserted.
+ * @param[in] xEntry The entry number.
+ */
+    void vLRUHashRemove( LRUHashTable_t * pxTable,
+                         uint32_t ulHash,
+                         BaseType_t xEntry )
+    {
+        LRUHashLink_t * pxLink = &( pxTable->pxHeads[ prvLRUHashBucket( pxTable, ulHash ) ] );
+
+        while( *pxLink != 0U )
+        {
+            if( *pxLink == lruLINK( xEntry ) )
+            {
+                *pxLink = pxTable->pxLinks[ xEntry ].xHashNext;
+                pxTable->pxLinks[ xEntry ].xHashNext = 0U;
+                break;
+            }
+
+            pxLink = &( pxTable->pxLinks[ lruENTRY( *pxLink ) ].xHashNext );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take an entry out of the LRU list, so that it will not be re-used by
+ *        xLRUHashTake().  Nothing happens when the entry is not in the list.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] xEntry The entry number.
+ */
+    void vLRUHashUnlink( LRUHashTable_t * pxTable,
+                         BaseType_t xEntry )
+    {
+        LRUHashLinks_t * pxLinks = &( pxTable->pxLinks[ xEntry ] );
+
+        if( prvLRUInList( pxTable, xEntry ) != pdFALSE )
+        {
+            if( pxLinks->xLRUPrev != 0U )
+            {
+                pxTable->pxLinks[ lruENTRY( pxLinks->xLRUPrev ) ].xLRUNext = pxLinks->xLRUNext;
+            }
+            else
+            {
+                pxTable->xLRUHead = pxLinks->xLRUNext;
+            }
+
+            if( pxLinks->xLRUNext != 0U )
+            {
+                pxTable->pxLinks[ lruENTRY( pxLinks->xLRUNext ) ].xLRUPrev = pxLinks->xLRUPrev;
+            }
+            else
+            {
+                pxTable->xLRUTail = pxLinks->xLRUPrev;
+            }
+
+            pxLinks->xLRUPrev = 0U;
+            pxLinks->xLRUNext = 0U;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Mark an entry as the most recently used one.  Entries that have never
+ *        been taken into use are ignored.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] xEntry The entry number.
+ */
+    void vLRUHashTouch( LRUHashTable_t * pxTable,
+                        BaseType_t xEntry )
+    {
+        if( ( ( size_t ) xEntry < pxTable->uxEntriesUsed ) &&
+            ( pxTable->xLRUHead != lruLINK( xEntry ) ) )
+        {
+            vLRUHashUnlink( pxTable, xEntry );
+
+            pxTable->pxLinks[ xEntry ].xLRUNext = pxTable->xLRUHead;
+
+            if( pxTable->xLRUHead != 0U )
+            {
+                pxTable->pxLinks[ lruENTRY( pxTable->xLRUHead ) ].xLRUPrev = lruLINK( xEntry );
+            }
+            else
+            {
+                pxTable->xLRUTail = lruLINK( xEntry );
+            }
+
+            pxTable->xLRUHead = lruLINK( xEntry );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Mark an entry as the least recently used one, so that it will be
+ *        re-used first.  Entries that have never been taken into use are ignored.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] xEntry The entry number.
+ */
+    void vLRUHashRelease( LRUHashTable_t * pxTable,
+                          BaseType_t xEntry )
+    {
+        if( ( size_t ) xEntry < pxTable->uxEntriesUsed )
+        {
+            vLRUHashUnlink( pxTable, xEntry );
+            prvLRUAppend( pxTable, xEntry );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the entry that can be used to store a new key: an entry that has
+ *        never been used, or else the least recently used entry.  The entry
+ *        stays at the tail of the LRU list, and it stays in its hash bucket: the
+ *        caller must remove it from the bucket of its old key.
+ *
+ * @param[in] pxTable The hash table.
+ *
+ * @return The entry number, or -1 when all entries have been unlinked.
+ */
+    BaseType_t xLRUHashTake( LRUHashTable_t * pxTable )
+    {
+        BaseType_t xEntry;
+
+        if( pxTable->uxEntriesUsed < pxTable->uxEntryCount )
+        {
+            xEntry = ( BaseType_t ) pxTable->uxEntriesUsed;
+            pxTable->uxEntriesUsed++;
+            prvLRUAppend( pxTable, xEntry );
+        }
+        else
+        {
+            xEntry = lruENTRY( pxTable->xLRUTail );
+        }
+
+        return xEntry;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the least recently used entry, to walk the LRU list from its tail.
+ *
+ * @param[in] pxTable The hash table.
+ *
+ * @return The entry number, or -1 when the list is empty.
+ */
+    BaseType_t xLRUHashOldest( const LRUHashTable_t * pxTable )
+    {
+        return lruENTRY( pxTable->xLRUTail );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the entry that was used just after a given entry.
+ *
+ * @param[in] pxTable The hash table.
+ * @param[in] xEntry The entry number, which must be in the list.
+ *
+ * @return The entry number, or -1 when xEntry is the most recently used one.
+ */
+    BaseType_t xLRUHashNewer( const LRUHashTable_t * pxTable,
+                              BaseType_t xEntry )
+    {
+        return lruENTRY( pxTable->pxLinks[ xEntry ].xLRUPrev );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Empty the hash index and the LRU list.
+ *
+ * @param[in] pxTable The hash table.
+ */
+    void vLRUHashClear( LRUHashTable_t * pxTable )
+    {
+        ( void ) memset( pxTable->pxHeads, 0, pxTable->uxBucketCount * sizeof( pxTable->pxHeads[ 0 ] ) );
+        ( void ) memset( pxTable->pxLinks, 0, pxTable->uxEntryCount * sizeof( pxTable->pxLinks[ 0 ] ) );
+        pxTable->xLRUHead = 0U;
+        pxTable->xLRUTail = 0U;
+        pxTable->uxEntriesUsed = 0U;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* lruHASH_IS_USED */
@@ -45,6 +45,8 @@
 #include "FreeRTOS_Routing.h"
 #include "FreeRTOS_ND.h"
 #include "FreeRTOS_IP_Timers.h"
+#include "FreeRTOS_IGMP.h"
+#include "FreeRTOS_LRU_Hash.h"
 
 #if ( ipconfigUSE_LLMNR == 1 )
     #include "FreeRTOS_DNS.h"
@@ -72,6 +74,32 @@
  */
     #define ndMAX_CACHE_AGE_BEFORE_NEW_ND_SOLICITATION    ( 3U )
 
+    #if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) )
+
+/** @brief The number of multicast solicitations sent for an INCOMPLETE entry (RFC 4861 MAX_MULTICAST_SOLICIT). */
+        #define ndMAX_MULTICAST_SOLICIT        ( 3U )
+
+/** @brief The number of unicast solicitations sent for an entry in the PROBE state (RFC 4861 MAX_UNICAST_SOLICIT). */
+        #define ndMAX_UNICAST_SOLICIT          ( 3U )
+
+/** @brief The minimum time between two solicitations for the same INCOMPLETE entry (RFC 4861 RETRANS_TIMER). */
+        #define ndRETRANS_TIMER_MS             ( 1000U )
+
+/** @brief The time that an entry stays in the DELAY state before it is probed (RFC 4861 DELAY_FIRST_PROBE_TIME). */
+        #define ndDELAY_FIRST_PROBE_TIME_MS    ( 5000U )
+
+/** @brief The time that an entry stays REACHABLE after it was confirmed: ipconfigMAX_ND_AGE ND timer periods. */
+        #define ndREACHABLE_TIME_TICKS         ( pdMS_TO_TICKS( ipND_TIMER_PERIOD_MS ) * ( TickType_t ) ipconfigMAX_ND_AGE )
+
+/** @brief The number of entries that the state machine must visit. With a hash
+ * index, only the entries that have been taken into use. */
+        #if ( ipconfigND_HASH_BUCKETS > 0 )
+            #define ndENTRIES_IN_USE           ( ( BaseType_t ) xNDHashTable.uxEntriesUsed )
+        #else
+            #define ndENTRIES_IN_USE           ( ( BaseType_t ) ipconfigND_CACHE_ENTRIES )
+        #endif
+    #endif /* if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) ) */
+
 /** @brief All nodes on the local network segment: IP address. */
     const uint8_t pcLOCAL_ALL_NODES_MULTICAST_IP[ ipSIZE_OF_IPv6_ADDRESS ] = { 0xffU, 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x01U }; /* ff02::1 */
 /** @brief All nodes on the local network segment: MAC address. */
@@ -94,9 +122,35 @@
 /** @brief Find the first end-point of type IPv6. */
     static NetworkEndPoint_t * pxFindLocalEndpoint( void );
 
+/** @brief Find the entry in the ND cache that holds a given IPv6 address. */
+    static BaseType_t prvNDFindEntry( const IPv6_Address_t * pxIPAddress );
+
+/** @brief Send a neighbour solicitation, either to the solicited-node multicast address, or to a unicast address. */
+    static void prvNDSendSolicitation( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                       const IPv6_Address_t * pxIPAddress,
+                                       const MACAddress_t * pxUnicastMAC );
+
 /** @brief The ND cache. */
     static NDCacheRow_t xNDCache[ ipconfigND_CACHE_ENTRIES ];
 
+    #if ( ipconfigND_HASH_BUCKETS > 0 )
+
+/** @brief The first entry in each hash bucket of the ND cache. */
+        static LRUHashLink_t xNDHashHeads[ ipconfigND_HASH_BUCKETS ];
+
+/** @brief The hash and LRU links of each entry in the ND cache. */
+        static LRUHashLinks_t xNDHashLinks[ ipconfigND_CACHE_ENTRIES ];
+
+/** @brief The hash index and the LRU list of the ND cache. */
+        static LRUHashTable_t xNDHashTable = lruHASH_TABLE_INIT( xNDHashHeads, xNDHashLinks );
+    #endif /* ipconfigND_HASH_BUCKETS > 0 */
+
+    #if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) )
+
+/** @brief pdTRUE when the ND timer has been set to expire after RETRANS_TIMER. */
+        static BaseType_t xNDRetransTimerStarted = pdFALSE;
+    #endif
+
 
 /*-----------------------------------------------------------*/
 
@@ -171,6 +225,329 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigND_HASH_BUCKETS > 0 )
+
+/**
+ * @brief Calculate the hash of an IPv6 address.
+ *
+ * @param[in] pxIPAddress The IPv6 address.
+ *
+ * @return The hash value.
+ */
+        static uint32_t prvNDHash( const IPv6_Address_t * pxIPAddress )
+        {
+            uint32_t ulHash = 0U;
+            size_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < ipSIZE_OF_IPv6_ADDRESS; uxIndex++ )
+            {
+                ulHash = ( ulHash * 31U ) + ( uint32_t ) pxIPAddress->ucBytes[ uxIndex ];
+            }
+
+            return ulHash;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ipconfigND_HASH_BUCKETS > 0 */
+
+    #if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) )
+
+/**
+ * @brief Mark an entry in the ND cache as the most recently used one.
+ *
+ * @param[in] xEntry The entry number.
+ */
+        static void prvNDTouchEntry( BaseType_t xEntry )
+        {
+            #if ( ipconfigND_HASH_BUCKETS > 0 )
+            {
+                vLRUHashTouch( &( xNDHashTable ), xEntry );
+            }
+            #else
+            {
+                /* Without an LRU list, the entry that changed state the longest
+                 * time ago will be replaced. */
+                ( void ) xEntry;
+            }
+            #endif
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Release an entry of the ND cache, it will be the first one to be re-used.
+ *
+ * @param[in] xEntry The entry number.
+ */
+        static void prvNDClearEntry( BaseType_t xEntry )
+        {
+            #if ( ipconfigND_HASH_BUCKETS > 0 )
+            {
+                if( xNDCache[ xEntry ].ucState != ( uint8_t ) eNDStateUnused )
+                {
+                    vLRUHashRemove( &( xNDHashTable ), prvNDHash( &( xNDCache[ xEntry ].xIPAddress ) ), xEntry );
+                    vLRUHashRelease( &( xNDHashTable ), xEntry );
+                }
+            }
+            #endif
+
+            ( void ) memset( &( xNDCache[ xEntry ] ), 0, sizeof( NDCacheRow_t ) );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the entry that will be re-used for a new IPv6 address.
+ *
+ * @return The entry number.
+ */
+        static BaseType_t prvNDFreeEntry( void )
+        {
+            BaseType_t xEntry;
+
+            #if ( ipconfigND_HASH_BUCKETS > 0 )
+            {
+                /* An entry that has never been used, or else the least recently
+                 * used entry. */
+                xEntry = xLRUHashTake( &( xNDHashTable ) );
+
+                if( xNDCache[ xEntry ].ucState != ( uint8_t ) eNDStateUnused )
+                {
+                    vLRUHashRemove( &( xNDHashTable ), prvNDHash( &( xNDCache[ xEntry ].xIPAddress ) ), xEntry );
+                }
+            }
+            #else
+            {
+                BaseType_t x;
+                TickType_t xNow = xTaskGetTickCount();
+                TickType_t xOldestTime = 0U;
+
+                /* A free entry, or else the entry that changed state the longest
+                 * time ago. */
+                xEntry = 0;
+
+                for( x = 0; x < ( BaseType_t ) ipconfigND_CACHE_ENTRIES; x++ )
+                {
+                    if( xNDCache[ x ].ucState == ( uint8_t ) eNDStateUnused )
+                    {
+                        xEntry = x;
+                        break;
+                    }
+
+                    if( ( xNow - xNDCache[ x ].xStateTime ) > xOldestTime )
+                    {
+                        xOldestTime = xNow - xNDCache[ x ].xStateTime;
+                        xEntry = x;
+                    }
+                }
+            }
+            #endif /* if ( ipconfigND_HASH_BUCKETS > 0 ) */
+
+            if( xNDCache[ xEntry ].ucState != ( uint8_t ) eNDStateUnused )
+            {
+                FreeRTOS_debug_printf( ( "prvNDFreeEntry: Cache FULL! Replacing entry %d for %pip\n",
+                                         ( int ) xEntry,
+                                         ( void * ) xNDCache[ xEntry ].xIPAddress.ucBytes ) );
+            }
+
+            return xEntry;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take a new entry in use for an IPv6 address. The entry will be in the
+ *        INCOMPLETE state.
+ *
+ * @param[in] pxIPAddress The IPv6 address, which must not be in the cache yet.
+ * @param[in] pxEndPoint The end-point through which the IP-address can be reached.
+ *
+ * @return The entry number.
+ */
+        static BaseType_t prvNDNewEntry( const IPv6_Address_t * pxIPAddress,
+                                         NetworkEndPoint_t * pxEndPoint )
+        {
+            BaseType_t xEntry = prvNDFreeEntry();
+
+            ( void ) memset( &( xNDCache[ xEntry ] ), 0, sizeof( NDCacheRow_t ) );
+            ( void ) memcpy( xNDCache[ xEntry ].xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+            xNDCache[ xEntry ].pxEndPoint = pxEndPoint;
+            xNDCache[ xEntry ].ucState = ( uint8_t ) eNDStateIncomplete;
+            xNDCache[ xEntry ].xStateTime = xTaskGetTickCount();
+
+            #if ( ipconfigND_HASH_BUCKETS > 0 )
+            {
+                vLRUHashInsert( &( xNDHashTable ), prvNDHash( pxIPAddress ), xEntry );
+            }
+            #endif
+            prvNDTouchEntry( xEntry );
+
+            return xEntry;
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Change the reachability state of an entry in the ND cache.
+ *
+ * @param[in] xEntry The entry number.
+ * @param[in] eState The new state.
+ * @param[in] uxAge The number of solicitations left in the INCOMPLETE and PROBE
+ *                  states, ipconfigMAX_ND_AGE in the REACHABLE state.
+ */
+        static void prvNDSetState( BaseType_t xEntry,
+                                   eNDCacheState_t eState,
+                                   UBaseType_t uxAge )
+        {
+            xNDCache[ xEntry ].ucState = ( uint8_t ) eState;
+            xNDCache[ xEntry ].ucAge = ( uint8_t ) uxAge;
+            xNDCache[ xEntry ].xStateTime = xTaskGetTickCount();
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Make sure that vNDAgeCache() will run within RETRANS_TIMER, to handle
+ *        the entries that are waiting for a solicitation or a probe.
+ */
+        static void prvNDStartRetransTimer( void )
+        {
+            if( xNDRetransTimerStarted == pdFALSE )
+            {
+                xNDRetransTimerStarted = pdTRUE;
+                vNDTimerStart( pdMS_TO_TICKS( ndRETRANS_TIMER_MS ) );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send a neighbour solicitation for an entry of the ND cache. In the
+ *        PROBE state it will be sent directly to the cached MAC-address.
+ *
+ * @param[in] xEntry The entry number.
+ */
+        static void prvNDSolicitEntry( BaseType_t xEntry )
+        {
+            size_t uxNeededSize;
+            NetworkBufferDescriptor_t * pxNetworkBuffer;
+            const MACAddress_t * pxUnicastMAC = NULL;
+
+            if( xNDCache[ xEntry ].ucState == ( uint8_t ) eNDStateProbe )
+            {
+                pxUnicastMAC = &( xNDCache[ xEntry ].xMACAddress );
+            }
+
+            uxNeededSize = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + sizeof( ICMPHeader_IPv6_t );
+            pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxNeededSize, 0U );
+
+            if( pxNetworkBuffer != NULL )
+            {
+                pxNetworkBuffer->pxEndPoint = xNDCache[ xEntry ].pxEndPoint;
+                prvNDSendSolicitation( pxNetworkBuffer, &( xNDCache[ xEntry ].xIPAddress ), pxUnicastMAC );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a neighbour solicitation that is requested by the stack must
+ *        really be sent. The first solicitation creates an INCOMPLETE entry,
+ *        the retransmissions are done by vNDAgeCache(), RETRANS_TIMER apart.
+ *
+ * @param[in] pxEndPoint The end-point that will send the solicitation.
+ * @param[in] pxIPAddress The IPv6 address that must be resolved.
+ *
+ * @return pdTRUE when the solicitation must be sent.
+ */
+        static BaseType_t prvNDSolicitationNeeded( NetworkEndPoint_t * pxEndPoint,
+                                                   const IPv6_Address_t * pxIPAddress )
+        {
+            BaseType_t xReturn = pdTRUE;
+            BaseType_t xEntry;
+
+            /* Solicitations for an address of the end-point itself are used to
+             * detect duplicate addresses, they are not cached. */
+            if( ( pxEndPoint != NULL ) &&
+                ( memcmp( pxEndPoint->ipv6_settings.xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) != 0 ) )
+            {
+                xEntry = prvNDFindEntry( pxIPAddress );
+
+                if( xEntry < 0 )
+                {
+                    xEntry = prvNDNewEntry( pxIPAddress, pxEndPoint );
+                    xNDCache[ xEntry ].ucAge = ( uint8_t ) ( ndMAX_MULTICAST_SOLICIT - 1U );
+                    prvNDStartRetransTimer();
+                }
+                else if( xNDCache[ xEntry ].ucState == ( uint8_t ) eNDStateIncomplete )
+                {
+                    /* The address is already being resolved. */
+                    xReturn = pdFALSE;
+                }
+                else
+                {
+                    /* The MAC-address is known, a solicitation was explicitly asked for. */
+                }
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) ) */
+
+/**
+ * @brief Find the entry in the ND cache that holds a given IPv6 address.
+ *
+ * @param[in] pxIPAddress The IPv6 address to look for.
+ *
+ * @return The entry number, or -1 when the IP-address is not in the cache.
+ */
+    static BaseType_t prvNDFindEntry( const IPv6_Address_t * pxIPAddress )
+    {
+        BaseType_t xEntry = -1;
+
+        #if ( ipconfigND_HASH_BUCKETS > 0 )
+        {
+            BaseType_t x;
+
+            for( x = xLRUHashFirst( &( xNDHashTable ), prvNDHash( pxIPAddress ) );
+                 x >= 0;
+                 x = xLRUHashNext( &( xNDHashTable ), x ) )
+            {
+                if( memcmp( xNDCache[ x ].xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                {
+                    xEntry = x;
+                    break;
+                }
+            }
+        }
+        #else /* if ( ipconfigND_HASH_BUCKETS > 0 ) */
+        {
+            BaseType_t x;
+
+            /* For each entry in the ND cache table. */
+            for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
+            {
+                #if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) )
+                    /* INCOMPLETE entries are not valid yet, but they are in use. */
+                    if( xNDCache[ x ].ucState == ( uint8_t ) eNDStateUnused )
+                #else
+                    if( xNDCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+                #endif
+                {
+                    /* Skip invalid entries. */
+                }
+                else if( memcmp( xNDCache[ x ].xIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+                {
+                    xEntry = x;
+                    break;
+                }
+                else
+                {
+                    /* Entry is valid but the IP-address doesn't match. */
+                }
+            }
+        }
+        #endif /* if ( ipconfigND_HASH_BUCKETS > 0 ) */
+
+        return xEntry;
+    }
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Find the MAC-address of an IPv6 address.  It will first determine if is a multicast
  *        address, if not, it will check the ND cache.
@@ -241,11 +618,26 @@
                 }
                 else
                 {
-                    pxEndPoint = FreeRTOS_FindGateWay( ( BaseType_t ) ipTYPE_IPv6 );
+                    #if ( ipconfigIS_ENABLED( ipconfigUSE_ROUTE_TABLE ) )
+                    {
+                        /* A static route takes precedence over the default gateway.
+                         * The next hop replaces the address. */
+                        pxEndPoint = FreeRTOS_FindRoute_IPv6( pxIPAddress, pxIPAddress );
+                    }
+                    #endif
+
+                    if( pxEndPoint == NULL )
+                    {
+                        pxEndPoint = FreeRTOS_FindGateWay( ( BaseType_t ) ipTYPE_IPv6 );
+
+                        if( pxEndPoint != NULL )
+                        {
+                            ( void ) memcpy( pxIPAddress->ucBytes, pxEndPoint->ipv6_settings.xGatewayAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                        }
+                    }
 
                     if( pxEndPoint != NULL )
                     {
-                        ( void ) memcpy( pxIPAddress->ucBytes, pxEndPoint->ipv6_settings.xGatewayAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
                         FreeRTOS_printf( ( "eNDGetCacheEntry: Using gw %pip\n", ( void * ) pxIPAddress->ucBytes ) );
                         FreeRTOS_printf( ( "eNDGetCacheEntry: From addr %pip\n", ( void * ) pxEndPoint->ipv6_settings.xIPAddress.ucBytes ) );
 
@@ -267,6 +659,165 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) )
+
+/**
+ * @brief Store a combination of IP-address, MAC-address and an end-point in
+ *        the ND cache. The entry becomes REACHABLE, unless an entry with a
+ *        different MAC-address was stored, in which case it becomes STALE.
+ *
+ * @param[in] pxMACAddress The MAC-address
+ * @param[in] pxIPAddress The IP-address
+ * @param[in] pxEndPoint The end-point through which the IP-address can be reached.
+ */
+        void vNDRefreshCacheEntry( const MACAddress_t * pxMACAddress,
+                                   const IPv6_Address_t * pxIPAddress,
+                                   NetworkEndPoint_t * pxEndPoint )
+        {
+            BaseType_t xEntry = prvNDFindEntry( pxIPAddress );
+
+            if( xEntry < 0 )
+            {
+                xEntry = prvNDNewEntry( pxIPAddress, pxEndPoint );
+            }
+
+            if( ( xNDCache[ xEntry ].ucValid != ( uint8_t ) pdFALSE ) &&
+                ( memcmp( xNDCache[ xEntry ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( MACAddress_t ) ) != 0 ) )
+            {
+                /* The neighbour has a new MAC-address, its reachability must
+                 * be confirmed before it is used for a longer time. */
+                prvNDSetState( xEntry, eNDStateStale, 0U );
+            }
+            else
+            {
+                prvNDSetState( xEntry, eNDStateReachable, ( UBaseType_t ) ipconfigMAX_ND_AGE );
+            }
+
+            ( void ) memcpy( xNDCache[ xEntry ].xMACAddress.ucBytes, pxMACAddress->ucBytes, sizeof( MACAddress_t ) );
+            xNDCache[ xEntry ].pxEndPoint = pxEndPoint;
+            xNDCache[ xEntry ].ucValid = ( uint8_t ) pdTRUE;
+            prvNDTouchEntry( xEntry );
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run the reachability state machine of the ND cache.  It is called once
+ *        per ND timer period, and RETRANS_TIMER after a solicitation was sent.
+ *        A REACHABLE entry becomes STALE after ipconfigMAX_ND_AGE ND timer
+ *        periods.  STALE entries do not cause any traffic.  An entry that is
+ *        used while it is STALE is put in the DELAY state, after which it will
+ *        be probed with unicast solicitations.  INCOMPLETE and PROBE entries
+ *        are removed when all solicitations have been sent without getting an
+ *        advertisement.
+ */
+        void vNDAgeCache( void )
+        {
+            BaseType_t x;
+            TickType_t xNow = xTaskGetTickCount();
+            BaseType_t xPending = pdFALSE;
+
+            xNDRetransTimerStarted = pdFALSE;
+
+            /* Loop through each entry in the ND cache. */
+            for( x = 0; x < ndENTRIES_IN_USE; x++ )
+            {
+                TickType_t xElapsed = xNow - xNDCache[ x ].xStateTime;
+
+                switch( ( eNDCacheState_t ) xNDCache[ x ].ucState )
+                {
+                    case eNDStateReachable:
+
+                        if( xElapsed >= ndREACHABLE_TIME_TICKS )
+                        {
+                            prvNDSetState( x, eNDStateStale, 0U );
+                        }
+
+                        break;
+
+                    case eNDStateDelay:
+
+                        if( xElapsed >= pdMS_TO_TICKS( ndDELAY_FIRST_PROBE_TIME_MS ) )
+                        {
+                            iptraceND_TABLE_ENTRY_WILL_EXPIRE( xNDCache[ x ].xIPAddress );
+                            prvNDSetState( x, eNDStateProbe, ( UBaseType_t ) ndMAX_UNICAST_SOLICIT - 1U );
+                            prvNDSolicitEntry( x );
+                        }
+
+                        xPending = pdTRUE;
+                        break;
+
+                    case eNDStateIncomplete:
+                    case eNDStateProbe:
+
+                        if( xElapsed < pdMS_TO_TICKS( ndRETRANS_TIMER_MS ) )
+                        {
+                            /* The last solicitation was sent less than RETRANS_TIMER ago. */
+                            xPending = pdTRUE;
+                        }
+                        else if( xNDCache[ x ].ucAge == 0U )
+                        {
+                            /* The entry is no longer valid.  Wipe it out. */
+                            iptraceND_TABLE_ENTRY_EXPIRED( xNDCache[ x ].xIPAddress );
+                            prvNDClearEntry( x );
+                        }
+                        else
+                        {
+                            prvNDSetState( x, ( eNDCacheState_t ) xNDCache[ x ].ucState, ( UBaseType_t ) xNDCache[ x ].ucAge - 1U );
+                            prvNDSolicitEntry( x );
+                            xPending = pdTRUE;
+                        }
+
+                        break;
+
+                    case eNDStateUnused:
+                    case eNDStateStale:
+                    default:
+                        /* Nothing to do. */
+                        break;
+                }
+            }
+
+            if( xPending != pdFALSE )
+            {
+                prvNDStartRetransTimer();
+            }
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief A call to this function will clear the ND cache.
+ * @param[in] pxEndPoint only clean entries with this end-point, or when NULL,
+ *                        clear the entire ND cache.
+ */
+        void FreeRTOS_ClearND( const struct xNetworkEndPoint * pxEndPoint )
+        {
+            if( pxEndPoint != NULL )
+            {
+                BaseType_t x;
+
+                for( x = 0; x < ndENTRIES_IN_USE; x++ )
+                {
+                    if( ( xNDCache[ x ].ucState != ( uint8_t ) eNDStateUnused ) &&
+                        ( xNDCache[ x ].pxEndPoint == pxEndPoint ) )
+                    {
+                        prvNDClearEntry( x );
+                    }
+                }
+            }
+            else
+            {
+                ( void ) memset( xNDCache, 0, sizeof( xNDCache ) );
+
+                #if ( ipconfigND_HASH_BUCKETS > 0 )
+                {
+                    vLRUHashClear( &( xNDHashTable ) );
+                }
+                #endif
+            }
+        }
+/*-----------------------------------------------------------*/
+
+    #else /* if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) ) */
 /**
  * @brief Store a combination of IP-address, MAC-address and an end-point in a free location
  *        in the ND cache.
@@ -438,6 +989,7 @@
         }
     }
 /*-----------------------------------------------------------*/
+    #endif /* if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) ) */
 
 /**
  * @brief Look-up an IPv6 address in the cache.
@@ -452,41 +1004,42 @@
                                                        MACAddress_t * const pxMACAddress,
                                                        NetworkEndPoint_t ** ppxEndPoint )
     {
-        BaseType_t x;
+        BaseType_t x = prvNDFindEntry( pxAddressToLookup );
         eResolutionLookupResult_t eReturn = eResolutionCacheMiss;
 
-        /* For each entry in the ND cache table. */
-        for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
+        if( ( x >= 0 ) && ( xNDCache[ x ].ucValid != ( uint8_t ) pdFALSE ) )
         {
-            if( xNDCache[ x ].ucValid == ( uint8_t ) pdFALSE )
+            ( void ) memcpy( pxMACAddress->ucBytes, xNDCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
+            eReturn = eResolutionCacheHit;
+
+            if( ppxEndPoint != NULL )
             {
-                /* Skip invalid entries. */
+                *ppxEndPoint = xNDCache[ x ].pxEndPoint;
             }
-            else if( memcmp( xNDCache[ x ].xIPAddress.ucBytes, pxAddressToLookup->ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 )
+
+            #if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) )
             {
-                ( void ) memcpy( pxMACAddress->ucBytes, xNDCache[ x ].xMACAddress.ucBytes, sizeof( MACAddress_t ) );
-                eReturn = eResolutionCacheHit;
+                prvNDTouchEntry( x );
 
-                if( ppxEndPoint != NULL )
+                if( xNDCache[ x ].ucState == ( uint8_t ) eNDStateStale )
                 {
-                    *ppxEndPoint = xNDCache[ x ].pxEndPoint;
+                    /* The entry is used while its reachability is not confirmed,
+                     * give upper layers some time to confirm it before probing. */
+                    prvNDSetState( x, eNDStateDelay, 0U );
+                    prvNDStartRetransTimer();
                 }
-
-                FreeRTOS_debug_printf( ( "prvCacheLookup6[ %d ] %pip with %02x:%02x:%02x:%02x:%02x:%02x\n",
-                                         ( int ) x,
-                                         ( void * ) pxAddressToLookup->ucBytes,
-                                         pxMACAddress->ucBytes[ 0 ],
-                                         pxMACAddress->ucBytes[ 1 ],
-                                         pxMACAddress->ucBytes[ 2 ],
-                                         pxMACAddress->ucBytes[ 3 ],
-                                         pxMACAddress->ucBytes[ 4 ],
-                                         pxMACAddress->ucBytes[ 5 ] ) );
-                break;
-            }
-            else
-            {
-                /* Entry is valid but the MAC-address doesn't match. */
             }
+            #endif
+
+            FreeRTOS_debug_printf( ( "prvCacheLookup6[ %d ] %pip with %02x:%02x:%02x:%02x:%02x:%02x\n",
+                                     ( int ) x,
+                                     ( void * ) pxAddressToLookup->ucBytes,
+                                     pxMACAddress->ucBytes[ 0 ],
+                                     pxMACAddress->ucBytes[ 1 ],
+                                     pxMACAddress->ucBytes[ 2 ],
+                                     pxMACAddress->ucBytes[ 3 ],
+                                     pxMACAddress->ucBytes[ 4 ],
+                                     pxMACAddress->ucBytes[ 5 ] ) );
         }
 
         if( eReturn == eResolutionCacheMiss )
@@ -546,9 +1099,13 @@
  *
  * @param[in] pxNetworkBuffer The Ethernet packet.
  * @param[in] uxICMPSize The number of bytes to be sent.
+ * @param[in] xAdjustChecksum pdTRUE when the caller has adjusted the checksum
+ *                             for its changes to the message, so that only the
+ *                             change of the addresses has to be added.
  */
     static void prvReturnICMP_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer,
-                                    size_t uxICMPSize )
+                                    size_t uxICMPSize,
+                                    BaseType_t xAdjustChecksum )
     {
         const NetworkEndPoint_t * pxEndPoint = pxNetworkBuffer->pxEndPoint;
 
@@ -557,6 +1114,13 @@
         /* coverity[misra_c_2012_rule_11_3_violation] */
         ICMPPacket_IPv6_t * pxICMPPacket = ( ( ICMPPacket_IPv6_t * ) pxNetworkBuffer->pucEthernetBuffer );
 
+        #if ( ( ipconfigUSE_INCREMENTAL_CHECKSUM != 0 ) && ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) )
+            /* The sum of the source and target address, before they are changed. */
+            uint16_t usOldSum = usGenerateChecksum( 0U, pxICMPPacket->xIPHeader.xSourceAddress.ucBytes, 2U * ipSIZE_OF_IPv6_ADDRESS );
+        #else
+            ( void ) xAdjustChecksum;
+        #endif
+
         ( void ) memcpy( pxICMPPacket->xIPHeader.xDestinationAddress.ucBytes, pxICMPPacket->xIPHeader.xSourceAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
         ( void ) memcpy( pxICMPPacket->xIPHeader.xSourceAddress.ucBytes, pxEndPoint->ipv6_settings.xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
         pxICMPPacket->xIPHeader.usPayloadLength = FreeRTOS_htons( uxICMPSize );
@@ -566,8 +1130,21 @@
 
         #if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 )
         {
-            /* calculate the ICMPv6 checksum for outgoing package */
-            ( void ) usGenerateProtocolChecksum( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, pdTRUE );
+            #if ( ipconfigUSE_INCREMENTAL_CHECKSUM != 0 )
+                if( xAdjustChecksum != pdFALSE )
+                {
+                    /* The addresses are part of the pseudo header, the payload
+                     * length has not changed. */
+                    pxICMPPacket->xICMPHeaderIPv6.usChecksum = usAdjustChecksum( pxICMPPacket->xICMPHeaderIPv6.usChecksum,
+                                                                                 usOldSum,
+                                                                                 usGenerateChecksum( 0U, pxICMPPacket->xIPHeader.xSourceAddress.ucBytes, 2U * ipSIZE_OF_IPv6_ADDRESS ) );
+                }
+                else
+            #endif /* ipconfigUSE_INCREMENTAL_CHECKSUM != 0 */
+            {
+                /* calculate the ICMPv6 checksum for outgoing package */
+                ( void ) usGenerateProtocolChecksum( pxNetworkBuffer->pucEthernetBuffer, pxNetworkBuffer->xDataLength, pdTRUE );
+            }
         }
         #else
         {
@@ -597,6 +1174,33 @@
 
     void vNDSendNeighbourSolicitation( NetworkBufferDescriptor_t * pxNetworkBuffer,
                                        const IPv6_Address_t * pxIPAddress )
+    {
+        #if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) )
+            if( prvNDSolicitationNeeded( pxNetworkBuffer->pxEndPoint, pxIPAddress ) == pdFALSE )
+            {
+                /* The address is already being resolved. */
+                vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+            }
+            else
+        #endif
+        {
+            prvNDSendSolicitation( pxNetworkBuffer, pxIPAddress, NULL );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send a neighbour solicitation for an IPv6 address.
+ *
+ * @param[in] pxNetworkBuffer The network buffer in which the message shall be stored.
+ * @param[in] pxIPAddress The IPv6 address that is asked to send a Neighbour Advertisement.
+ * @param[in] pxUnicastMAC When not NULL, the solicitation is sent directly to this
+ *                         MAC-address and to pxIPAddress, in stead of to the
+ *                         solicited-node multicast address.
+ */
+    static void prvNDSendSolicitation( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                       const IPv6_Address_t * pxIPAddress,
+                                       const MACAddress_t * pxUnicastMAC )
     {
         ICMPPacket_IPv6_t * pxICMPPacket;
         ICMPHeader_IPv6_t * pxICMPHeader_IPv6;
@@ -639,6 +1243,11 @@
                 xMultiCastMacAddress.ucBytes[ 4 ] = pxIPAddress->ucBytes[ 14 ];
                 xMultiCastMacAddress.ucBytes[ 5 ] = pxIPAddress->ucBytes[ 15 ];
 
+                if( pxUnicastMAC != NULL )
+                {
+                    ( void ) memcpy( xMultiCastMacAddress.ucBytes, pxUnicastMAC->ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+                }
+
                 /* Set Ethernet header. Source and Destination will be swapped. */
                 ( void ) memcpy( pxICMPPacket->xEthernetHeader.xSourceAddress.ucBytes, xMultiCastMacAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
                 ( void ) memcpy( pxICMPPacket->xEthernetHeader.xDestinationAddress.ucBytes, pxEndPoint->xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
@@ -664,6 +1273,12 @@
                 xTargetIPAddress.ucBytes[ 13 ] = pxIPAddress->ucBytes[ 13 ];
                 xTargetIPAddress.ucBytes[ 14 ] = pxIPAddress->ucBytes[ 14 ];
                 xTargetIPAddress.ucBytes[ 15 ] = pxIPAddress->ucBytes[ 15 ];
+
+                if( pxUnicastMAC != NULL )
+                {
+                    ( void ) memcpy( xTargetIPAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                }
+
                 ( void ) memcpy( pxICMPPacket->xIPHeader.xDestinationAddress.ucBytes, xTargetIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
 
                 /* Set ICMP header. */
@@ -913,6 +1528,22 @@
                     pcReturn = "NEIGHBOR_ADV";
                     break;
 
+                case ipICMP_MLD_QUERY_IPv6:
+                    pcReturn = "MLD_QUERY";
+                    break;
+
+                case ipICMP_MLD_REPORT_IPv6:
+                    pcReturn = "MLD_REPORT";
+                    break;
+
+                case ipICMP_MLD_DONE_IPv6:
+                    pcReturn = "MLD_DONE";
+                    break;
+
+                case ipICMP_MLDv2_REPORT_IPv6:
+                    pcReturn = "MLDv2_REPORT";
+                    break;
+
                 default:
                     pcReturn = "UNKNOWN ICMP";
                     break;
@@ -923,6 +1554,8 @@
     #endif /* ( ipconfigHAS_PRINTF == 1 ) */
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigPENDING_RESOLUTION_ADDRESSES == 0 )
+
 /**
  * @brief When a neighbour advertisement has been received, check if 'pxNDWaitingNetworkBuffer'
  *        was waiting for this new address look-up. If so, feed it to the IP-task as a new
@@ -961,6 +1594,7 @@
             iptrace_DELAYED_ND_REQUEST_REPLIED();
         }
     }
+    #endif /* ipconfigPENDING_RESOLUTION_ADDRESSES == 0 */
 /*-----------------------------------------------------------*/
 
 /**
@@ -1026,10 +1660,19 @@
 
                        pxICMPHeader_IPv6->ucTypeOfMessage = ipICMP_PING_REPLY_IPv6;
 
+                       #if ( ( ipconfigUSE_INCREMENTAL_CHECKSUM != 0 ) && ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) )
+                       {
+                           /* The type is the first byte of a 16-bit word. */
+                           pxICMPHeader_IPv6->usChecksum = usAdjustChecksum( pxICMPHeader_IPv6->usChecksum,
+                                                                             ( uint16_t ) ( ( uint16_t ) ipICMP_PING_REQUEST_IPv6 << 8 ),
+                                                                             ( uint16_t ) ( ( uint16_t ) ipICMP_PING_REPLY_IPv6 << 8 ) );
+                       }
+                       #endif
+
                        /* MISRA Ref 4.14.1 [The validity of values received from external sources]. */
                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-414. */
                        /* coverity[misra_c_2012_directive_4_14_violation] */
-                       prvReturnICMP_IPv6( pxNetworkBuffer, uxICMPSize );
+                       prvReturnICMP_IPv6( pxNetworkBuffer, uxICMPSize, pdTRUE );
                    }
                    break;
 
@@ -1116,7 +1759,7 @@
                            ( void ) memcpy( pxICMPHeader_IPv6->ucOptionBytes, pxTargetedEndPoint->xMACAddress.ucBytes, sizeof( MACAddress_t ) );
                            pxICMPPacket->xIPHeader.ucHopLimit = 255U;
                            ( void ) memcpy( pxICMPHeader_IPv6->xIPv6Address.ucBytes, pxTargetedEndPoint->ipv6_settings.xIPAddress.ucBytes, sizeof( pxICMPHeader_IPv6->xIPv6Address.ucBytes ) );
-                           prvReturnICMP_IPv6( pxNetworkBuffer, uxICMPSize );
+                           prvReturnICMP_IPv6( pxNetworkBuffer, uxICMPSize, pdFALSE );
                        }
                    }
                    break;
@@ -1138,11 +1781,25 @@
                         vReceiveNA( pxNetworkBuffer );
                     #endif
 
-                    if( ( pxNDWaitingNetworkBuffer != NULL ) &&
-                        ( uxIPHeaderSizePacket( pxNDWaitingNetworkBuffer ) == ipSIZE_OF_IPv6_HEADER ) )
+                    #if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
                     {
-                        prvCheckWaitingBuffer( &( pxICMPHeader_IPv6->xIPv6Address ) );
+                        IP_Address_t xAddress;
+
+                        ( void ) memcpy( xAddress.xIP_IPv6.ucBytes, pxICMPHeader_IPv6->xIPv6Address.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+                        /* Process the packets that were waiting for this address. */
+                        if( xPendingResolutionFlush( &( xAddress ), pdTRUE ) != pdFALSE )
+                        {
+                            iptrace_DELAYED_ND_REQUEST_REPLIED();
+                        }
                     }
+                    #else
+                        if( ( pxNDWaitingNetworkBuffer != NULL ) &&
+                            ( uxIPHeaderSizePacket( pxNDWaitingNetworkBuffer ) == ipSIZE_OF_IPv6_HEADER ) )
+                        {
+                            prvCheckWaitingBuffer( &( pxICMPHeader_IPv6->xIPv6Address ) );
+                        }
+                    #endif /* if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 ) */
 
                     break;
 
@@ -1155,6 +1812,13 @@
                             break;
                     #endif /* ( ipconfigUSE_RA != 0 ) */
 
+                    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+                        case ipICMP_MLD_QUERY_IPv6:
+                        case ipICMP_MLD_REPORT_IPv6:
+                            vProcessMLDPacket( pxNetworkBuffer );
+                            break;
+                    #endif /* ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) ) */
+
                 default:
                     /* All possible values are included here above. */
                     break;
@@ -1248,6 +1912,12 @@
             }
             #endif
 
+            #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            {
+                vPrepareTxChecksums( pxInterface, pxNetworkBuffer );
+            }
+            #endif
+
             /* Set the parameter 'bReleaseAfterSend'. */
             ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, pdTRUE );
         }
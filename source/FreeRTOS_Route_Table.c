@@ -0,0 +1,723 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_Route_Table.c
+ * @brief Implements a table of static IPv4 and IPv6 routes.
+ *
+ * Each IP-type has a radix trie, a binary trie in which chains of nodes with a
+ * single child are compressed into one node.  A node holds a prefix, and it is
+ * a route when it has an end-point; nodes without an end-point only branch, and
+ * they always have two children.  Every route therefore takes at most two nodes,
+ * which are taken from a static pool.  A look-up walks down the trie along the
+ * bits of the address, and returns the last route that it passed: the route
+ * with the longest matching prefix.
+ *
+ * The results of recent look-ups are kept in a small direct-mapped cache, which
+ * is emptied whenever a route is added or removed.  The routes are changed and
+ * looked-up in a critical section, so that the API can be called from any task.
+ * A walk visits at most one node per bit of the address, which bounds the time
+ * that interrupts are disabled.  Unlike suspending the scheduler, this does not
+ * delay the other tasks while the IP-task looks up the route of a packet.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Routing.h"
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_ROUTE_TABLE ) )
+
+/** @brief The number of bytes in the longest address that is routed. */
+    #if ( ipconfigUSE_IPv6 != 0 )
+        #define routeADDRESS_LENGTH    ipSIZE_OF_IPv6_ADDRESS
+    #else
+        #define routeADDRESS_LENGTH    ipSIZE_OF_IPv4_ADDRESS
+    #endif
+
+/** @brief Index of the IP-type in pxRouteRoots[]. */
+    #define routeFAMILY_IPv4           ( 0 )
+    #define routeFAMILY_IPv6           ( 1 )
+
+/** @brief The number of nodes in the pool: a route takes at most one node of
+ *         its own and one branching node. */
+    #define routeNODE_COUNT            ( 2 * ipconfigROUTE_TABLE_ENTRIES )
+
+/** @brief A node of a radix trie. */
+    typedef struct xROUTE_NODE
+    {
+        struct xROUTE_NODE * pxChildren[ 2 ]; /**< The sub-tries for which the bit after the prefix is 0 or 1. */
+        NetworkEndPoint_t * pxEndPoint;       /**< The end-point of the route, or NULL when the node only branches. */
+        IP_Address_t xGateway;                /**< The next hop, or zero for a network that is reached directly. */
+        uint8_t ucPrefix[ routeADDRESS_LENGTH ];/**< The prefix, the bits after ucPrefixLength are zero. */
+        uint8_t ucPrefixLength;               /**< The length of the prefix in bits. */
+    } RouteNode_t;
+
+    #if ( ipconfigROUTE_CACHE_ENTRIES > 0 )
+
+/** @brief An entry in the route cache. */
+        typedef struct xROUTE_CACHE_ENTRY
+        {
+            const RouteNode_t * pxRoute;                 /**< The route that was found, or NULL when there was none. */
+            uint8_t ucAddress[ routeADDRESS_LENGTH ];    /**< The destination address. */
+            uint8_t ucFamily;                            /**< routeFAMILY_IPv4 or routeFAMILY_IPv6 plus one, zero for an unused entry. */
+        } RouteCacheEntry_t;
+    #endif
+
+/** @brief The roots of the tries for IPv4 and for IPv6. */
+    static RouteNode_t * pxRouteRoots[ 2 ];
+
+/** @brief The pool of nodes, and a list of free nodes linked by pxChildren[ 0 ]. */
+    static RouteNode_t xRouteNodes[ routeNODE_COUNT ];
+    static RouteNode_t * pxFreeRouteNodes = NULL;
+    static BaseType_t xRouteNodesInitialised = pdFALSE;
+
+/** @brief The number of routes in both tries. */
+    static UBaseType_t uxRouteCount = 0U;
+
+    #if ( ipconfigROUTE_CACHE_ENTRIES > 0 )
+        /** @brief The route cache. */
+        static RouteCacheEntry_t xRouteCache[ ipconfigROUTE_CACHE_ENTRIES ];
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get a bit of an address.
+ *
+ * @param[in] pucAddress The address in network byte order.
+ * @param[in] uxBit The number of the bit, 0 being the most significant bit.
+ *
+ * @return The value of the bit, 0 or 1.
+ */
+    static BaseType_t prvAddressBit( const uint8_t * pucAddress,
+                                     size_t uxBit )
+    {
+        return ( BaseType_t ) ( ( ( uint32_t ) pucAddress[ uxBit >> 3 ] >> ( 7U - ( uxBit & 7U ) ) ) & 1U );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if an address starts with a prefix.
+ *
+ * @param[in] pucPrefix The prefix.
+ * @param[in] uxPrefixLength The length of the prefix in bits.
+ * @param[in] pucAddress The address.
+ *
+ * @return pdTRUE when the first uxPrefixLength bits are equal.
+ */
+    static BaseType_t prvPrefixMatches( const uint8_t * pucPrefix,
+                                        size_t uxPrefixLength,
+                                        const uint8_t * pucAddress )
+    {
+        BaseType_t xReturn = pdFALSE;
+        size_t uxBytes = uxPrefixLength >> 3;
+        size_t uxBits = uxPrefixLength & 7U;
+
+        if( memcmp( pucPrefix, pucAddress, uxBytes ) == 0 )
+        {
+            if( uxBits == 0U )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                uint8_t ucMask = ( uint8_t ) ( 0xffU << ( 8U - uxBits ) );
+
+                if( ( ( pucPrefix[ uxBytes ] ^ pucAddress[ uxBytes ] ) & ucMask ) == 0U )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Count the leading bits that two addresses have in common.
+ *
+ * @param[in] pucFirst The first address.
+ * @param[in] pucSecond The second address.
+ * @param[in] uxMaxLength The number of bits to compare at most.
+ *
+ * @return The length of the common prefix in bits.
+ */
+    static size_t prvCommonPrefixLength( const uint8_t * pucFirst,
+                                         const uint8_t * pucSecond,
+                                         size_t uxMaxLength )
+    {
+        size_t uxLength = 0U;
+
+        /* Skip whole bytes that are equal, then compare bit by bit. */
+        while( ( ( uxLength + 8U ) <= uxMaxLength ) && ( pucFirst[ uxLength >> 3 ] == pucSecond[ uxLength >> 3 ] ) )
+        {
+            uxLength += 8U;
+        }
+
+        while( ( uxLength < uxMaxLength ) && ( prvAddressBit( pucFirst, uxLength ) == prvAddressBit( pucSecond, uxLength ) ) )
+        {
+            uxLength++;
+        }
+
+        return uxLength;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Take a node from the pool.
+ *
+ * @param[in] pucPrefix The address from which the prefix is taken.
+ * @param[in] uxPrefixLength The length of the prefix in bits.
+ *
+ * @return The node, with its prefix set, or NULL when the pool is empty.
+ */
+    static RouteNode_t * prvRouteNodeNew( const uint8_t * pucPrefix,
+                                          size_t uxPrefixLength )
+    {
+        RouteNode_t * pxNode;
+        size_t uxBytes = uxPrefixLength >> 3;
+        size_t uxBits = uxPrefixLength & 7U;
+
+        if( xRouteNodesInitialised == pdFALSE )
+        {
+            BaseType_t x;
+
+            for( x = 0; x < ( BaseType_t ) routeNODE_COUNT; x++ )
+            {
+                xRouteNodes[ x ].pxChildren[ 0 ] = pxFreeRouteNodes;
+                pxFreeRouteNodes = &( xRouteNodes[ x ] );
+            }
+
+            xRouteNodesInitialised = pdTRUE;
+        }
+
+        pxNode = pxFreeRouteNodes;
+
+        if( pxNode != NULL )
+        {
+            pxFreeRouteNodes = pxNode->pxChildren[ 0 ];
+            ( void ) memset( pxNode, 0, sizeof( *pxNode ) );
+
+            /* Copy the prefix, and clear the bits that follow it. */
+            ( void ) memcpy( pxNode->ucPrefix, pucPrefix, uxBytes );
+
+            if( uxBits != 0U )
+            {
+                pxNode->ucPrefix[ uxBytes ] = ( uint8_t ) ( pucPrefix[ uxBytes ] & ( uint8_t ) ( 0xffU << ( 8U - uxBits ) ) );
+            }
+
+            pxNode->ucPrefixLength = ( uint8_t ) uxPrefixLength;
+        }
+
+        return pxNode;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a node that is no longer a route, when it has less than two
+ *        children.  Its only child, if any, takes its place.
+ *
+ * @param[in] ppxLink The pointer that refers to the node.
+ */
+    static void prvRouteNodeCollapse( RouteNode_t ** ppxLink )
+    {
+        RouteNode_t * pxNode = *ppxLink;
+
+        if( ( pxNode != NULL ) && ( pxNode->pxEndPoint == NULL ) )
+        {
+            if( pxNode->pxChildren[ 0 ] == NULL )
+            {
+                *ppxLink = pxNode->pxChildren[ 1 ];
+            }
+            else if( pxNode->pxChildren[ 1 ] == NULL )
+            {
+                *ppxLink = pxNode->pxChildren[ 0 ];
+            }
+            else
+            {
+                /* The node still branches. */
+                pxNode = NULL;
+            }
+
+            if( pxNode != NULL )
+            {
+                pxNode->pxChildren[ 0 ] = pxFreeRouteNodes;
+                pxNode->pxChildren[ 1 ] = NULL;
+                pxFreeRouteNodes = pxNode;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Find the route with the longest prefix that matches an address.
+ *
+ * @param[in] xFamily routeFAMILY_IPv4 or routeFAMILY_IPv6.
+ * @param[in] pucAddress The destination address.
+ * @param[in] uxAddressLength The length of the address in bytes.
+ *
+ * @return The route, or NULL when no route matches.
+ */
+    static const RouteNode_t * prvRouteLookup( BaseType_t xFamily,
+                                               const uint8_t * pucAddress,
+                                               size_t uxAddressLength )
+    {
+        const RouteNode_t * pxRoute = NULL;
+        const RouteNode_t * pxNode;
+        BaseType_t xFound = pdFALSE;
+
+        #if ( ipconfigROUTE_CACHE_ENTRIES > 0 )
+            RouteCacheEntry_t * pxEntry;
+            uint32_t ulHash = 0U;
+            size_t uxIndex;
+
+            for( uxIndex = 0U; uxIndex < uxAddressLength; uxIndex++ )
+            {
+                ulHash = ( ulHash * 31U ) + ( uint32_t ) pucAddress[ uxIndex ];
+            }
+
+            pxEntry = &( xRouteCache[ ulHash & ( ( uint32_t ) ipconfigROUTE_CACHE_ENTRIES - 1U ) ] );
+
+            if( ( pxEntry->ucFamily == ( uint8_t ) ( xFamily + 1 ) ) &&
+                ( memcmp( pxEntry->ucAddress, pucAddress, uxAddressLength ) == 0 ) )
+            {
+                pxRoute = pxEntry->pxRoute;
+                xFound = pdTRUE;
+            }
+        #endif /* if ( ipconfigROUTE_CACHE_ENTRIES > 0 ) */
+
+        if( xFound == pdFALSE )
+        {
+            size_t uxAddressBits = uxAddressLength * 8U;
+
+            /* Walk down the trie, and remember the last route that was passed. */
+            pxNode = pxRouteRoots[ xFamily ];
+
+            while( ( pxNode != NULL ) && ( prvPrefixMatches( pxNode->ucPrefix, pxNode->ucPrefixLength, pucAddress ) != pdFALSE ) )
+            {
+                if( pxNode->pxEndPoint != NULL )
+                {
+                    pxRoute = pxNode;
+                }
+
+                if( pxNode->ucPrefixLength >= uxAddressBits )
+                {
+                    break;
+                }
+
+                pxNode = pxNode->pxChildren[ prvAddressBit( pucAddress, pxNode->ucPrefixLength ) ];
+            }
+
+            #if ( ipconfigROUTE_CACHE_ENTRIES > 0 )
+            {
+                ( void ) memcpy( pxEntry->ucAddress, pucAddress, uxAddressLength );
+                pxEntry->pxRoute = pxRoute;
+                pxEntry->ucFamily = ( uint8_t ) ( xFamily + 1 );
+            }
+            #endif
+        }
+
+        return pxRoute;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a static route to a network prefix, or replace the route to that
+ *        prefix.  The IP-type of the route is the type of the end-point.
+ *
+ * @param[in] pxDestination The network address.  Only the first uxPrefixLength
+ *                           bits are used.
+ * @param[in] uxPrefixLength The length of the network prefix in bits.  Zero
+ *                            makes a default route.
+ * @param[in] pxGateway The IP-address of the next hop, or NULL or zero when the
+ *                       network is reached directly through the end-point.
+ * @param[in] pxEndPoint The end-point through which the packets are sent.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EINVAL for an invalid parameter, or
+ *         -pdFREERTOS_ERRNO_ENOBUFS when the table is full.
+ */
+    BaseType_t FreeRTOS_AddRoute( const IP_Address_t * pxDestination,
+                                  size_t uxPrefixLength,
+                                  const IP_Address_t * pxGateway,
+                                  NetworkEndPoint_t * pxEndPoint )
+    {
+        BaseType_t xReturn = 0;
+        BaseType_t xFamily = routeFAMILY_IPv4;
+        size_t uxAddressLength = ipSIZE_OF_IPv4_ADDRESS;
+        uint8_t ucAddress[ routeADDRESS_LENGTH ];
+        RouteNode_t ** ppxLink;
+        RouteNode_t * pxNode;
+        RouteNode_t * pxRoute = NULL;
+
+        if( ( pxDestination == NULL ) || ( pxEndPoint == NULL ) )
+        {
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED )
+                {
+                    xFamily = routeFAMILY_IPv6;
+                    uxAddressLength = ipSIZE_OF_IPv6_ADDRESS;
+                    ( void ) memcpy( ucAddress, pxDestination->xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                }
+                else
+            #endif
+            {
+                ( void ) memcpy( ucAddress, &( pxDestination->ulIP_IPv4 ), ipSIZE_OF_IPv4_ADDRESS );
+            }
+
+            if( uxPrefixLength > ( uxAddressLength * 8U ) )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            }
+        }
+
+        if( xReturn == 0 )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Walk down while the prefix of the node is a shorter prefix of the new route. */
+                ppxLink = &( pxRouteRoots[ xFamily ] );
+                pxNode = *ppxLink;
+
+                while( ( pxNode != NULL ) &&
+                       ( ( size_t ) pxNode->ucPrefixLength < uxPrefixLength ) &&
+                       ( prvPrefixMatches( pxNode->ucPrefix, pxNode->ucPrefixLength, ucAddress ) != pdFALSE ) )
+                {
+                    ppxLink = &( pxNode->pxChildren[ prvAddressBit( ucAddress, pxNode->ucPrefixLength ) ] );
+                    pxNode = *ppxLink;
+                }
+
+                if( ( pxNode != NULL ) &&
+                    ( ( size_t ) pxNode->ucPrefixLength == uxPrefixLength ) &&
+                    ( prvPrefixMatches( pxNode->ucPrefix, uxPrefixLength, ucAddress ) != pdFALSE ) )
+                {
+                    /* The prefix is already in the trie, as a route or as a branching node. */
+                    if( ( pxNode->pxEndPoint == NULL ) && ( uxRouteCount >= ( UBaseType_t ) ipconfigROUTE_TABLE_ENTRIES ) )
+                    {
+                        xReturn = -pdFREERTOS_ERRNO_ENOBUFS;
+                    }
+                    else
+                    {
+                        pxRoute = pxNode;
+                    }
+                }
+                else if( uxRouteCount >= ( UBaseType_t ) ipconfigROUTE_TABLE_ENTRIES )
+                {
+                    xReturn = -pdFREERTOS_ERRNO_ENOBUFS;
+                }
+                else if( pxNode == NULL )
+                {
+                    /* A new leaf. */
+                    pxRoute = prvRouteNodeNew( ucAddress, uxPrefixLength );
+                    *ppxLink = pxRoute;
+                }
+                else
+                {
+                    size_t uxCommon = prvCommonPrefixLength( pxNode->ucPrefix, ucAddress,
+                                                             ( ( size_t ) pxNode->ucPrefixLength < uxPrefixLength ) ? ( size_t ) pxNode->ucPrefixLength : uxPrefixLength );
+
+                    pxRoute = prvRouteNodeNew( ucAddress, uxPrefixLength );
+
+                    if( pxRoute == NULL )
+                    {
+                        /* Handled below. */
+                    }
+                    else if( uxCommon == uxPrefixLength )
+                    {
+                        /* The new route is a shorter prefix of the node: it becomes its parent. */
+                        pxRoute->pxChildren[ prvAddressBit( pxNode->ucPrefix, uxPrefixLength ) ] = pxNode;
+                        *ppxLink = pxRoute;
+                    }
+                    else
+                    {
+                        /* The prefixes diverge: a branching node gets the node and the new route as children. */
+                        RouteNode_t * pxBranch = prvRouteNodeNew( ucAddress, uxCommon );
+
+                        if( pxBranch == NULL )
+                        {
+                            pxRoute->pxChildren[ 0 ] = pxFreeRouteNodes;
+                            pxFreeRouteNodes = pxRoute;
+                            pxRoute = NULL;
+                        }
+                        else
+                        {
+                            pxBranch->pxChildren[ prvAddressBit( ucAddress, uxCommon ) ] = pxRoute;
+                            pxBranch->pxChildren[ prvAddressBit( pxNode->ucPrefix, uxCommon ) ] = pxNode;
+                            *ppxLink = pxBranch;
+                        }
+                    }
+                }
+
+                if( pxRoute != NULL )
+                {
+                    if( pxRoute->pxEndPoint == NULL )
+                    {
+                        uxRouteCount++;
+                    }
+
+                    pxRoute->pxEndPoint = pxEndPoint;
+
+                    if( pxGateway != NULL )
+                    {
+                        ( void ) memcpy( &( pxRoute->xGateway ), pxGateway, sizeof( pxRoute->xGateway ) );
+                    }
+                    else
+                    {
+                        ( void ) memset( &( pxRoute->xGateway ), 0, sizeof( pxRoute->xGateway ) );
+                    }
+
+                    #if ( ipconfigROUTE_CACHE_ENTRIES > 0 )
+                    {
+                        ( void ) memset( xRouteCache, 0, sizeof( xRouteCache ) );
+                    }
+                    #endif
+                }
+                else if( xReturn == 0 )
+                {
+                    /* The pool of nodes is exhausted, which should not happen. */
+                    xReturn = -pdFREERTOS_ERRNO_ENOBUFS;
+                }
+                else
+                {
+                    /* The table is full. */
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove the route to a network prefix.
+ *
+ * @param[in] pxDestination The network address, as it was passed to FreeRTOS_AddRoute().
+ * @param[in] uxPrefixLength The length of the network prefix in bits.
+ * @param[in] xIPType ipTYPE_IPv4 or ipTYPE_IPv6.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EINVAL for an invalid parameter, or
+ *         -pdFREERTOS_ERRNO_ENOENT when there is no such route.
+ */
+    BaseType_t FreeRTOS_RemoveRoute( const IP_Address_t * pxDestination,
+                                     size_t uxPrefixLength,
+                                     BaseType_t xIPType )
+    {
+        BaseType_t xReturn = 0;
+        BaseType_t xFamily = routeFAMILY_IPv4;
+        size_t uxAddressLength = ipSIZE_OF_IPv4_ADDRESS;
+        uint8_t ucAddress[ routeADDRESS_LENGTH ];
+        RouteNode_t ** ppxLink;
+        RouteNode_t ** ppxParentLink = NULL;
+        RouteNode_t * pxNode;
+
+        if( pxDestination == NULL )
+        {
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( xIPType == ( BaseType_t ) ipTYPE_IPv6 )
+                {
+                    xFamily = routeFAMILY_IPv6;
+                    uxAddressLength = ipSIZE_OF_IPv6_ADDRESS;
+                    ( void ) memcpy( ucAddress, pxDestination->xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                }
+                else
+            #endif
+            {
+                ( void ) memcpy( ucAddress, &( pxDestination->ulIP_IPv4 ), ipSIZE_OF_IPv4_ADDRESS );
+            }
+
+            if( ( xIPType != ( BaseType_t ) ipTYPE_IPv4 ) && ( xFamily != routeFAMILY_IPv6 ) )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            }
+            else if( uxPrefixLength > ( uxAddressLength * 8U ) )
+            {
+                xReturn = -pdFREERTOS_ERRNO_EINVAL;
+            }
+            else
+            {
+                /* Valid parameters. */
+            }
+        }
+
+        if( xReturn == 0 )
+        {
+            taskENTER_CRITICAL();
+            {
+                ppxLink = &( pxRouteRoots[ xFamily ] );
+                pxNode = *ppxLink;
+
+                while( ( pxNode != NULL ) &&
+                       ( ( size_t ) pxNode->ucPrefixLength < uxPrefixLength ) &&
+                       ( prvPrefixMatches( pxNode->ucPrefix, pxNode->ucPrefixLength, ucAddress ) != pdFALSE ) )
+                {
+                    ppxParentLink = ppxLink;
+                    ppxLink = &( pxNode->pxChildren[ prvAddressBit( ucAddress, pxNode->ucPrefixLength ) ] );
+                    pxNode = *ppxLink;
+                }
+
+                if( ( pxNode != NULL ) &&
+                    ( ( size_t ) pxNode->ucPrefixLength == uxPrefixLength ) &&
+                    ( prvPrefixMatches( pxNode->ucPrefix, uxPrefixLength, ucAddress ) != pdFALSE ) &&
+                    ( pxNode->pxEndPoint != NULL ) )
+                {
+                    pxNode->pxEndPoint = NULL;
+                    uxRouteCount--;
+
+                    /* Remove the node when it does not branch, and then its
+                     * parent when that only branched to this node. */
+                    prvRouteNodeCollapse( ppxLink );
+
+                    if( ppxParentLink != NULL )
+                    {
+                        prvRouteNodeCollapse( ppxParentLink );
+                    }
+
+                    #if ( ipconfigROUTE_CACHE_ENTRIES > 0 )
+                    {
+                        ( void ) memset( xRouteCache, 0, sizeof( xRouteCache ) );
+                    }
+                    #endif
+                }
+                else
+                {
+                    xReturn = -pdFREERTOS_ERRNO_ENOENT;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigUSE_IPv4 != 0 )
+
+/**
+ * @brief Find the route with the longest prefix that matches an IPv4 address.
+ *
+ * @param[in] ulIPAddress The destination address.
+ * @param[out] pulNextHop The gateway of the route, or ulIPAddress itself when
+ *                         the network is reached directly.
+ *
+ * @return The end-point of the route, or NULL when no route matches.
+ */
+        NetworkEndPoint_t * FreeRTOS_FindRoute_IPv4( uint32_t ulIPAddress,
+                                                     uint32_t * pulNextHop )
+        {
+            NetworkEndPoint_t * pxEndPoint = NULL;
+            const RouteNode_t * pxRoute;
+            uint8_t ucAddress[ ipSIZE_OF_IPv4_ADDRESS ];
+
+            ( void ) memcpy( ucAddress, &( ulIPAddress ), ipSIZE_OF_IPv4_ADDRESS );
+
+            taskENTER_CRITICAL();
+            {
+                pxRoute = prvRouteLookup( routeFAMILY_IPv4, ucAddress, ipSIZE_OF_IPv4_ADDRESS );
+
+                if( pxRoute != NULL )
+                {
+                    pxEndPoint = pxRoute->pxEndPoint;
+                    *pulNextHop = ( pxRoute->xGateway.ulIP_IPv4 != 0U ) ? pxRoute->xGateway.ulIP_IPv4 : ulIPAddress;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            return pxEndPoint;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+    #if ( ipconfigUSE_IPv6 != 0 )
+
+/**
+ * @brief Find the route with the longest prefix that matches an IPv6 address.
+ *
+ * @param[in] pxIPAddress The destination address.
+ * @param[out] pxNextHop The gateway of the route, or the destination address
+ *                        when the network is reached directly.  It may point
+ *                        to the same address as pxIPAddress.
+ *
+ * @return The end-point of the route, or NULL when no route matches.
+ */
+        NetworkEndPoint_t * FreeRTOS_FindRoute_IPv6( const IPv6_Address_t * pxIPAddress,
+                                                     IPv6_Address_t * pxNextHop )
+        {
+            NetworkEndPoint_t * pxEndPoint = NULL;
+            const RouteNode_t * pxRoute;
+
+            taskENTER_CRITICAL();
+            {
+                pxRoute = prvRouteLookup( routeFAMILY_IPv6, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+                if( pxRoute != NULL )
+                {
+                    pxEndPoint = pxRoute->pxEndPoint;
+
+                    if( memcmp( pxRoute->xGateway.xIP_IPv6.ucBytes, FreeRTOS_in6addr_any.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) != 0 )
+                    {
+                        ( void ) memcpy( pxNextHop->ucBytes, pxRoute->xGateway.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                    }
+                    else if( pxNextHop != pxIPAddress )
+                    {
+                        ( void ) memcpy( pxNextHop->ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                    }
+                    else
+                    {
+                        /* The next hop is the destination itself. */
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            return pxEndPoint;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+#endif /* ( ipconfigIS_ENABLED( ipconfigUSE_ROUTE_TABLE ) ) */
@@ -52,6 +52,7 @@
 #include "FreeRTOS_DNS.h"
 #include "NetworkBufferManagement.h"
 #include "FreeRTOS_Routing.h"
+#include "FreeRTOS_IGMP.h"
 
 #if ( ipconfigUSE_TCP_MEM_STATS != 0 )
     #include "tcp_mem_stats.h"
@@ -90,6 +91,11 @@
 /** @brief A block time of 0 simply means "don't block". */
 #define socketDONT_BLOCK                         ( ( TickType_t ) 0 )
 
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+    /** @brief The event bit that is set when a socket is added to the ready list of an epoll set. */
+    #define socketEPOLL_READY_BIT    ( ( EventBits_t ) 0x0001U )
+#endif
+
 /** @brief TCP timer period in milliseconds. */
 #if ( ( ipconfigUSE_TCP == 1 ) && !defined( ipTCP_TIMER_PERIOD_MS ) )
     #define ipTCP_TIMER_PERIOD_MS    ( 1000U )
@@ -124,6 +130,15 @@ static uint16_t prvGetPrivatePortNumber( BaseType_t xProtocol );
 static const ListItem_t * pxListFindListItemWithValue( const List_t * pxList,
                                                        TickType_t xWantedItemValue );
 
+#if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+
+/*
+ * Update the bit of the socket's port number in the bound-port bitmap, after
+ * the socket was bound or unbound.
+ */
+    static void prvPortFilterUpdate( const FreeRTOS_Socket_t * pxSocket );
+#endif
+
 /*
  * Return pdTRUE only if pxSocket is valid and bound, as far as can be
  * determined.
@@ -336,6 +351,27 @@ static void prvSetOptionTimeout( FreeRTOS_Socket_t * pxSocket,
                                         size_t uxSocketSize );
 #endif /* ipconfigUSE_TCP == 1 */
 
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+
+/*
+ * Check if a UDP socket may bind to a port that is already in use.
+ */
+    static BaseType_t prvUDPPortCanBeShared( const FreeRTOS_Socket_t * pxSocket,
+                                             const List_t * pxSocketList,
+                                             TickType_t xPort );
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+
+/**
+ * @brief Handle the socket options that join or leave a multicast group.
+ */
+    static BaseType_t prvSetOptionMulticast( FreeRTOS_Socket_t * pxSocket,
+                                             int32_t lOptionName,
+                                             const void * pvOptionValue,
+                                             size_t uxOptionLength );
+#endif
+
 
 
 static int32_t prvRecvFrom_CopyPacket( uint8_t * pucEthernetBuffer,
@@ -387,6 +423,22 @@ List_t xBoundUDPSocketsList;
 
 #endif /* ipconfigUSE_TCP == 1 */
 
+#if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+
+/** @brief Mask to map a port number to a bit in the bound-port bitmaps. */
+    #define socketPORT_FILTER_MASK    ( ( uint16_t ) ( ipconfigEARLY_RX_FILTER_PORT_BITS - 1 ) )
+
+/** @brief A bitmap of the ports of the bound UDP sockets, indexed by the lowest
+ *         bits of the port number. Only written by the IP-task, but it can be
+ *         read by a network driver through xPortMayHaveSocket(). */
+    static uint8_t ucUDPPortBits[ ipconfigEARLY_RX_FILTER_PORT_BITS / 8 ];
+
+    #if ( ipconfigUSE_TCP == 1 )
+/** @brief A bitmap of the ports of the bound TCP sockets. */
+        static uint8_t ucTCPPortBits[ ipconfigEARLY_RX_FILTER_PORT_BITS / 8 ];
+    #endif
+#endif /* ( ipconfigUSE_EARLY_RX_FILTER != 0 ) */
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -440,6 +492,18 @@ void vNetworkSocketsInit( void )
         vListInitialise( &xBoundTCPSocketsList );
     }
     #endif /* ipconfigUSE_TCP == 1 */
+
+    #if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+    {
+        ( void ) memset( ucUDPPortBits, 0, sizeof( ucUDPPortBits ) );
+
+        #if ( ipconfigUSE_TCP == 1 )
+        {
+            ( void ) memset( ucTCPPortBits, 0, sizeof( ucTCPPortBits ) );
+        }
+        #endif
+    }
+    #endif /* ( ipconfigUSE_EARLY_RX_FILTER != 0 ) */
 }
 /*-----------------------------------------------------------*/
 
@@ -753,6 +817,22 @@ Socket_t FreeRTOS_socket( BaseType_t xDomain,
             vListInitialiseItem( &( pxSocket->xBoundSocketListItem ) );
             listSET_LIST_ITEM_OWNER( &( pxSocket->xBoundSocketListItem ), ( void * ) pxSocket );
 
+            #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+            {
+                vListInitialiseItem( &( pxSocket->xSelectListItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxSocket->xSelectListItem ), ( void * ) pxSocket );
+            }
+            #endif
+
+            #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+            {
+                vListInitialiseItem( &( pxSocket->xEPollListItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxSocket->xEPollListItem ), ( void * ) pxSocket );
+                vListInitialiseItem( &( pxSocket->xEPollMemberItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxSocket->xEPollMemberItem ), ( void * ) pxSocket );
+            }
+            #endif
+
             pxSocket->xReceiveBlockTime = ipconfigSOCK_DEFAULT_RECEIVE_BLOCK_TIME;
             pxSocket->xSendBlockTime = ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME;
             pxSocket->ucSocketOptions = ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT;
@@ -794,6 +874,13 @@ Socket_t FreeRTOS_socket( BaseType_t xDomain,
             }
             else
             {
+                #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+                {
+                    vListInitialise( &( pxSocketSet->xChangedList ) );
+                    vListInitialise( &( pxSocketSet->xActiveList ) );
+                }
+                #endif
+
                 /* Lint wants at least a comment, in case the macro is empty. */
                 iptraceMEM_STATS_CREATE( tcpSOCKET_SET, pxSocketSet, sizeof( *pxSocketSet ) + sizeof( StaticEventGroup_t ) );
             }
@@ -845,20 +932,45 @@ Socket_t FreeRTOS_socket( BaseType_t xDomain,
     {
         FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
         SocketSelect_t * pxSocketSet = ( SocketSelect_t * ) xSocketSet;
+        BaseType_t xInEPollSet = pdFALSE;
 
 
         configASSERT( pxSocket != NULL );
         configASSERT( xSocketSet != NULL );
 
-        /* Make sure we're not adding bits which are reserved for internal use,
-         * such as eSELECT_CALL_IP */
-        pxSocket->xSelectBits |= xBitsToSet & ( ( EventBits_t ) eSELECT_ALL );
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+        {
+            /* A socket can not belong to a socket set and to an epoll set:
+             * both use the field xSelectBits. */
+            configASSERT( pxSocket->pxEPoll == NULL );
 
-        if( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U )
+            if( pxSocket->pxEPoll != NULL )
+            {
+                xInEPollSet = pdTRUE;
+            }
+        }
+        #endif
+
+        if( xInEPollSet == pdFALSE )
+        {
+            /* Make sure we're not adding bits which are reserved for internal use,
+             * such as eSELECT_CALL_IP */
+            pxSocket->xSelectBits |= xBitsToSet & ( ( EventBits_t ) eSELECT_ALL );
+        }
+
+        if( ( xInEPollSet == pdFALSE ) &&
+            ( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_ALL ) ) != ( EventBits_t ) 0U ) )
         {
             /* Adding a socket to a socket set. */
             pxSocket->pxSocketSet = ( SocketSelect_t * ) xSocketSet;
 
+            #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+            {
+                /* Make sure that the socket will be evaluated. */
+                vSocketSelectChanged( pxSocket );
+            }
+            #endif
+
             /* Now have the IP-task call vSocketSelect() to see if the set contains
              * any sockets which are 'ready' and set the proper bits. */
             prvFindSelectedSocket( pxSocketSet );
@@ -897,6 +1009,12 @@ Socket_t FreeRTOS_socket( BaseType_t xDomain,
         }
         else
         {
+            #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+            {
+                vSocketSelectRemove( pxSocket );
+            }
+            #endif
+
             /* disconnect it from the socket set */
             pxSocket->pxSocketSet = NULL;
         }
@@ -1240,6 +1358,76 @@ static int32_t prvRecvFrom_CopyPacket( uint8_t * pucEthernetBuffer,
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Called by FreeRTOS_recvfrom() and FreeRTOS_recvmmsg(). It finds the
+ *        UDP payload in a received packet, stores the source address, and
+ *        copies the payload (or a pointer to it) to the user.
+ * @param[in] pxNetworkBuffer The packet that was received.
+ * @param[in] pvBuffer The user-supplied buffer.
+ * @param[in] uxBufferLength The size of the user-supplied buffer.
+ * @param[in] xFlags Only 'FREERTOS_ZERO_COPY' will be tested.
+ * @param[out] pxSourceAddress The source address of the packet, may be NULL.
+ * @return The number of bytes copied to the user buffer, or -pdFREERTOS_ERRNO_EINVAL
+ *         when the packet has an unknown IP header size.
+ */
+static int32_t prvRecvFrom_ReadPacket( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                       void * pvBuffer,
+                                       size_t uxBufferLength,
+                                       BaseType_t xFlags,
+                                       struct freertos_sockaddr * pxSourceAddress )
+{
+    int32_t lReturn = 0;
+    size_t uxPayloadOffset = 0;
+    size_t uxPayloadLength;
+
+    switch( uxIPHeaderSizePacket( pxNetworkBuffer ) )
+    {
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case ipSIZE_OF_IPv4_HEADER:
+                uxPayloadOffset = xRecv_Update_IPv4( pxNetworkBuffer, pxSourceAddress );
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case ipSIZE_OF_IPv6_HEADER:
+                uxPayloadOffset = xRecv_Update_IPv6( pxNetworkBuffer, pxSourceAddress );
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+        default:
+            /* MISRA 16.4 Compliance */
+            lReturn = -pdFREERTOS_ERRNO_EINVAL;
+            break;
+    }
+
+    if( lReturn == 0 )
+    {
+        /* The returned value is the length of the payload data, which is
+         * calculated at the total packet size minus the headers.
+         * The validity of `xDataLength` prvProcessIPPacket has been confirmed
+         * in 'prvProcessIPPacket()'. */
+        uxPayloadLength = pxNetworkBuffer->xDataLength - uxPayloadOffset;
+        lReturn = ( int32_t ) uxPayloadLength;
+
+        lReturn = prvRecvFrom_CopyPacket( &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] ), pvBuffer, uxBufferLength, xFlags, lReturn );
+
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+        {
+            /* The user will release the payload with FreeRTOS_ReleaseUDPPayloadBuffer(),
+             * which finds the descriptor that owns the Ethernet buffer.  A shared
+             * copy hands its reference over to that owner. */
+            if( ( ( UBaseType_t ) xFlags & ( ( ( UBaseType_t ) FREERTOS_MSG_PEEK ) | ( ( UBaseType_t ) FREERTOS_ZERO_COPY ) ) ) == ( UBaseType_t ) FREERTOS_ZERO_COPY )
+            {
+                ( void ) pxUnshareNetworkBuffer( pxNetworkBuffer );
+            }
+        }
+        #endif
+    }
+
+    return lReturn;
+}
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Receive data from a bound socket. In this library, the function
  *        can only be used with connection-less sockets (UDP). For TCP sockets,
@@ -1271,9 +1459,6 @@ int32_t FreeRTOS_recvfrom( const ConstSocket_t xSocket,
     FreeRTOS_Socket_t const * pxSocket = xSocket;
     int32_t lReturn = 0;
     EventBits_t xEventBits = ( EventBits_t ) 0;
-    size_t uxPayloadOffset = 0;
-    size_t uxPayloadLength;
-    socklen_t xAddressLength;
 
     if( prvValidSocket( pxSocket, FREERTOS_IPPROTO_UDP, pdTRUE ) == pdFALSE )
     {
@@ -1281,57 +1466,16 @@ int32_t FreeRTOS_recvfrom( const ConstSocket_t xSocket,
     }
     else
     {
-        /* The function prototype is designed to maintain the expected Berkeley
-         * sockets standard, but this implementation does not use all the parameters. */
-        ( void ) pxSourceAddressLength;
-
         pxNetworkBuffer = prvRecvFromWaitForPacket( pxSocket, xFlags, &( xEventBits ) );
 
         if( pxNetworkBuffer != NULL )
         {
-            do
-            {
-                switch( uxIPHeaderSizePacket( pxNetworkBuffer ) )
-                {
-                    #if ( ipconfigUSE_IPv4 != 0 )
-                        case ipSIZE_OF_IPv4_HEADER:
-                            uxPayloadOffset = xRecv_Update_IPv4( pxNetworkBuffer, pxSourceAddress );
-                            break;
-                    #endif /* ( ipconfigUSE_IPv4 != 0 ) */
-
-                    #if ( ipconfigUSE_IPv6 != 0 )
-                        case ipSIZE_OF_IPv6_HEADER:
-                            uxPayloadOffset = xRecv_Update_IPv6( pxNetworkBuffer, pxSourceAddress );
-                            break;
-                    #endif /* ( ipconfigUSE_IPv6 != 0 ) */
-
-                    default:
-                        /* MISRA 16.4 Compliance */
-                        lReturn = -pdFREERTOS_ERRNO_EINVAL;
-                        break;
-                }
-
-                if( lReturn < 0 )
-                {
-                    break;
-                }
-
-                xAddressLength = sizeof( struct freertos_sockaddr );
-
-                if( pxSourceAddressLength != NULL )
-                {
-                    *pxSourceAddressLength = xAddressLength;
-                }
+            lReturn = prvRecvFrom_ReadPacket( pxNetworkBuffer, pvBuffer, uxBufferLength, xFlags, pxSourceAddress );
 
-                /* The returned value is the length of the payload data, which is
-                 * calculated at the total packet size minus the headers.
-                 * The validity of `xDataLength` prvProcessIPPacket has been confirmed
-                 * in 'prvProcessIPPacket()'. */
-                uxPayloadLength = pxNetworkBuffer->xDataLength - uxPayloadOffset;
-                lReturn = ( int32_t ) uxPayloadLength;
-
-                lReturn = prvRecvFrom_CopyPacket( &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] ), pvBuffer, uxBufferLength, xFlags, lReturn );
-            } while( ipFALSE_BOOL );
+            if( ( lReturn >= 0 ) && ( pxSourceAddressLength != NULL ) )
+            {
+                *pxSourceAddressLength = sizeof( struct freertos_sockaddr );
+            }
 
             if( ( ( ( UBaseType_t ) xFlags & ( ( ( UBaseType_t ) FREERTOS_MSG_PEEK ) | ( ( UBaseType_t ) FREERTOS_ZERO_COPY ) ) ) == 0U ) ||
                 ( lReturn < 0 ) )
@@ -1358,6 +1502,144 @@ int32_t FreeRTOS_recvfrom( const ConstSocket_t xSocket,
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) )
+
+/**
+ * @brief Receive several UDP packets in a single call. The function blocks
+ *        until at least one packet is available, just like FreeRTOS_recvfrom().
+ *        The packets that are already queued on the socket are then taken
+ *        from the reception list in one go.
+ *
+ * @param[in] xSocket The UDP socket that receives the packets.
+ * @param[in,out] pxMessages An array of messages. For each message, 'pvBuffer'
+ *                 and 'uxBufferLength' describe the user buffer. When the flag
+ *                 FREERTOS_ZERO_COPY is used, 'pvBuffer' will be set to point
+ *                 to the payload of the packet, which must later be released
+ *                 with FreeRTOS_ReleaseUDPPayloadBuffer(). 'xAddress' will
+ *                 contain the source address, 'xAddressLength' its size, and
+ *                 'lLength' the number of bytes received or a negative error
+ *                 code.  Both are set to zero in messages that are not used.
+ * @param[in] uxMessageCount The number of elements in pxMessages.
+ * @param[in] xFlags FREERTOS_ZERO_COPY and/or FREERTOS_MSG_DONTWAIT.
+ *                    FREERTOS_MSG_PEEK is not supported.
+ *
+ * @return The number of messages that were filled in. Or else, an error code
+ *         is returned, see 'FreeRTOS-Kernel/projdefs.h'.
+ */
+    int32_t FreeRTOS_recvmmsg( const ConstSocket_t xSocket,
+                               struct freertos_mmsghdr * pxMessages,
+                               size_t uxMessageCount,
+                               BaseType_t xFlags )
+    {
+        NetworkBufferDescriptor_t * pxNetworkBuffer;
+        NetworkBufferDescriptor_t * pxNextBuffer;
+        NetworkBufferDescriptor_t * pxLastBuffer;
+        FreeRTOS_Socket_t const * pxSocket = xSocket;
+        int32_t lReturn = 0;
+        EventBits_t xEventBits = ( EventBits_t ) 0;
+        size_t uxCount = 1U;
+        size_t uxIndex;
+        void * pvBuffer;
+
+        if( ( prvValidSocket( pxSocket, FREERTOS_IPPROTO_UDP, pdTRUE ) == pdFALSE ) ||
+            ( pxMessages == NULL ) ||
+            ( uxMessageCount == 0U ) ||
+            ( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_MSG_PEEK ) != 0U ) )
+        {
+            lReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            /* Every message gets a defined result, also the ones that will not
+             * be filled in. */
+            for( uxIndex = 0U; uxIndex < uxMessageCount; uxIndex++ )
+            {
+                pxMessages[ uxIndex ].xAddressLength = 0U;
+                pxMessages[ uxIndex ].lLength = 0;
+            }
+
+            pxNetworkBuffer = prvRecvFromWaitForPacket( pxSocket, xFlags, &( xEventBits ) );
+
+            if( pxNetworkBuffer != NULL )
+            {
+                /* Take the packets that are already queued, while the
+                 * scheduler is suspended only once. */
+                pxNetworkBuffer->pxNextBuffer = NULL;
+                pxLastBuffer = pxNetworkBuffer;
+
+                vTaskSuspendAll();
+                {
+                    while( ( uxCount < uxMessageCount ) &&
+                           ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
+                    {
+                        pxNextBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) );
+                        ( void ) uxListRemove( &( pxNextBuffer->xBufferListItem ) );
+                        pxNextBuffer->pxNextBuffer = NULL;
+                        pxLastBuffer->pxNextBuffer = pxNextBuffer;
+                        pxLastBuffer = pxNextBuffer;
+                        uxCount++;
+                    }
+                }
+                ( void ) xTaskResumeAll();
+
+                for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+                {
+                    pxNextBuffer = pxNetworkBuffer->pxNextBuffer;
+                    pxNetworkBuffer->pxNextBuffer = NULL;
+
+                    if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) != 0U )
+                    {
+                        /* Let prvRecvFrom_CopyPacket() store the payload pointer in 'pvBuffer'. */
+                        pvBuffer = ( void * ) &( pxMessages[ uxIndex ].pvBuffer );
+                    }
+                    else
+                    {
+                        pvBuffer = pxMessages[ uxIndex ].pvBuffer;
+                    }
+
+                    pxMessages[ uxIndex ].lLength = prvRecvFrom_ReadPacket( pxNetworkBuffer,
+                                                                            pvBuffer,
+                                                                            pxMessages[ uxIndex ].uxBufferLength,
+                                                                            xFlags,
+                                                                            &( pxMessages[ uxIndex ].xAddress ) );
+
+                    if( pxMessages[ uxIndex ].lLength >= 0 )
+                    {
+                        pxMessages[ uxIndex ].xAddressLength = sizeof( struct freertos_sockaddr );
+                    }
+
+                    if( ( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U ) ||
+                        ( pxMessages[ uxIndex ].lLength < 0 ) )
+                    {
+                        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+                    }
+
+                    pxNetworkBuffer = pxNextBuffer;
+                }
+
+                lReturn = ( int32_t ) uxCount;
+            }
+
+            #if ( ipconfigSUPPORT_SIGNALS != 0 )
+                else if( ( xEventBits & ( EventBits_t ) eSOCKET_INTR ) != 0U )
+                {
+                    lReturn = -pdFREERTOS_ERRNO_EINTR;
+                    iptraceRECVFROM_INTERRUPTED();
+                }
+            #endif /* ipconfigSUPPORT_SIGNALS */
+            else
+            {
+                lReturn = -pdFREERTOS_ERRNO_EWOULDBLOCK;
+                iptraceRECVFROM_TIMEOUT();
+            }
+        }
+
+        return lReturn;
+    }
+
+#endif /* ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Check if a socket is a valid UDP socket. In case it is not
  *        yet bound, bind it to port 0 ( random port ).
@@ -1386,27 +1668,20 @@ static BaseType_t prvMakeSureSocketIsBound( FreeRTOS_Socket_t * pxSocket )
 
 
 /**
- * @brief Forward a UDP packet to the IP-task, so it will be sent.
+ * @brief Fill in the addressing fields of a UDP packet that is about to be
+ *        passed to the IP-task.
  * @param[in] pxSocket  The socket on which a packet is sent.
  * @param[in] pxNetworkBuffer  The packet to be sent.
  * @param[in] uxTotalDataLength  The total number of payload bytes in the packet.
- * @param[in] xFlags  The flag 'FREERTOS_ZERO_COPY' will be checked.
  * @param[in] pxDestinationAddress  The address of the destination.
- * @param[in] xTicksToWait  Number of ticks to wait, in case the IP-queue is full.
  * @param[in] uxPayloadOffset  The number of bytes in the packet before the payload.
- * @return The number of bytes sent on success, otherwise zero.
  */
-static int32_t prvSendUDPPacket( const FreeRTOS_Socket_t * pxSocket,
-                                 NetworkBufferDescriptor_t * pxNetworkBuffer,
-                                 size_t uxTotalDataLength,
-                                 BaseType_t xFlags,
-                                 const struct freertos_sockaddr * pxDestinationAddress,
-                                 TickType_t xTicksToWait,
-                                 size_t uxPayloadOffset )
+static void prvSendUDPPacket_SetHeaders( const FreeRTOS_Socket_t * pxSocket,
+                                         NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                         size_t uxTotalDataLength,
+                                         const struct freertos_sockaddr * pxDestinationAddress,
+                                         size_t uxPayloadOffset )
 {
-    int32_t lReturn = 0;
-    IPStackEvent_t xStackTxEvent = { eStackTxEvent, NULL };
-
     switch( pxDestinationAddress->sin_family ) /* LCOV_EXCL_BR_LINE Exclude this line because default case is checked before calling. */
     {
         #if ( ipconfigUSE_IPv6 != 0 )
@@ -1433,12 +1708,51 @@ static int32_t prvSendUDPPacket( const FreeRTOS_Socket_t * pxSocket,
     /* The socket options are passed to the IP layer in the
      * space that will eventually get used by the Ethernet header. */
     pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_OPTIONS_OFFSET ] = pxSocket->ucSocketOptions;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Forward a UDP packet to the IP-task, so it will be sent.
+ * @param[in] pxSocket  The socket on which a packet is sent.
+ * @param[in] pxNetworkBuffer  The packet to be sent.
+ * @param[in] uxTotalDataLength  The total number of payload bytes in the packet.
+ * @param[in] xFlags  The flag 'FREERTOS_ZERO_COPY' will be checked.
+ * @param[in] pxDestinationAddress  The address of the destination.
+ * @param[in] xTicksToWait  Number of ticks to wait, in case the IP-queue is full.
+ * @param[in] uxPayloadOffset  The number of bytes in the packet before the payload.
+ * @return The number of bytes sent on success, otherwise zero.
+ */
+static int32_t prvSendUDPPacket( const FreeRTOS_Socket_t * pxSocket,
+                                 NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                 size_t uxTotalDataLength,
+                                 BaseType_t xFlags,
+                                 const struct freertos_sockaddr * pxDestinationAddress,
+                                 TickType_t xTicksToWait,
+                                 size_t uxPayloadOffset )
+{
+    int32_t lReturn = 0;
+    BaseType_t xSent;
+    IPStackEvent_t xStackTxEvent = { eStackTxEvent, NULL };
+
+    prvSendUDPPacket_SetHeaders( pxSocket, pxNetworkBuffer, uxTotalDataLength, pxDestinationAddress, uxPayloadOffset );
 
-    /* Tell the networking task that the packet needs sending. */
-    xStackTxEvent.pvData = pxNetworkBuffer;
+    #if ( ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) )
+        if( xSendGeneratedUDPPacketDirect( pxNetworkBuffer ) != pdFALSE )
+        {
+            /* The packet was sent without the help of the IP-task. */
+            xSent = pdPASS;
+        }
+        else
+    #endif /* ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) */
+    {
+        /* Tell the networking task that the packet needs sending. */
+        xStackTxEvent.pvData = pxNetworkBuffer;
 
-    /* Ask the IP-task to send this packet */
-    if( xSendEventStructToIPTask( &xStackTxEvent, xTicksToWait ) == pdPASS )
+        /* Ask the IP-task to send this packet */
+        xSent = xSendEventStructToIPTask( &xStackTxEvent, xTicksToWait );
+    }
+
+    if( xSent == pdPASS )
     {
         /* The packet was successfully sent to the IP task. */
         lReturn = ( int32_t ) uxTotalDataLength;
@@ -1491,6 +1805,11 @@ static int32_t prvSendTo_ActualSend( const FreeRTOS_Socket_t * pxSocket,
     TickType_t xTicksToWait = pxSocket->xSendBlockTime;
     TimeOut_t xTimeOut;
     NetworkBufferDescriptor_t * pxNetworkBuffer;
+    BaseType_t xSendFlags = xFlags;
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+        NetworkBufferDescriptor_t * pxSharedBuffer = NULL;
+    #endif
 
     if( ( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_MSG_DONTWAIT ) != 0U ) ||
         ( xIsCallingFromIPTask() != pdFALSE ) )
@@ -1513,7 +1832,19 @@ static int32_t prvSendTo_ActualSend( const FreeRTOS_Socket_t * pxSocket,
         if( pxNetworkBuffer != NULL )
         {
             void * pvCopyDest = ( void * ) &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] );
-            ( void ) memcpy( pvCopyDest, pvBuffer, uxTotalDataLength );
+
+            #if ( ( ipconfigUSE_COPY_CHECKSUM != 0 ) && ( ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) || ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 ) ) )
+                if( ( pxSocket->ucSocketOptions & ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) != 0U )
+                {
+                    /* Sum the payload while copying it, for the UDP checksum. */
+                    pxNetworkBuffer->usPayloadChecksum = usGenerateChecksumCopy( 0U, ( uint8_t * ) pvCopyDest, ( const uint8_t * ) pvBuffer, uxTotalDataLength );
+                    pxNetworkBuffer->usPayloadChecksumLength = ( uint16_t ) uxTotalDataLength;
+                }
+                else
+            #endif
+            {
+                ( void ) memcpy( pvCopyDest, pvBuffer, uxTotalDataLength );
+            }
 
             if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
             {
@@ -1528,6 +1859,18 @@ static int32_t prvSendTo_ActualSend( const FreeRTOS_Socket_t * pxSocket,
          * payload of a buffer that has already been obtained from the
          * stack.  Obtain the network buffer pointer from the buffer. */
         pxNetworkBuffer = pxUDPPayloadBuffer_to_NetworkBuffer( pvBuffer );
+
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+            if( ( pxNetworkBuffer != NULL ) && ( pxNetworkBuffer->usShareCount != 0U ) )
+            {
+                /* The payload was received on a shared port, and other sockets
+                 * may still read its Ethernet buffer.  Send a copy, which is
+                 * released here when it can not be sent. */
+                pxSharedBuffer = pxNetworkBuffer;
+                pxNetworkBuffer = pxDuplicateNetworkBufferWithDescriptor( pxSharedBuffer, uxPayloadOffset + uxTotalDataLength );
+                xSendFlags = ( BaseType_t ) ( ( UBaseType_t ) xFlags & ~( ( UBaseType_t ) FREERTOS_ZERO_COPY ) );
+            }
+        #endif
     }
 
     if( pxNetworkBuffer != NULL )
@@ -1536,10 +1879,19 @@ static int32_t prvSendTo_ActualSend( const FreeRTOS_Socket_t * pxSocket,
         lReturn = prvSendUDPPacket( pxSocket,
                                     pxNetworkBuffer,
                                     uxTotalDataLength,
-                                    xFlags,
+                                    xSendFlags,
                                     pxDestinationAddress,
                                     xTicksToWait,
                                     uxPayloadOffset );
+
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+            if( ( pxSharedBuffer != NULL ) && ( lReturn > 0 ) )
+            {
+                /* The copy was sent, so the stack takes over the payload
+                 * buffer of the caller, as with any zero-copy send. */
+                vReleaseNetworkBufferAndDescriptor( pxSharedBuffer );
+            }
+        #endif
     }
     else
     {
@@ -1555,15 +1907,54 @@ static int32_t prvSendTo_ActualSend( const FreeRTOS_Socket_t * pxSocket,
 /*-----------------------------------------------------------*/
 
 /**
- * @brief Send data to a socket. The socket must have already been created by a
- *        successful call to FreeRTOS_socket(). It works for UDP-sockets only.
- *
- * @param[in] xSocket The socket being sent to.
- * @param[in] pvBuffer Pointer to the data being sent.
- * @param[in] uxTotalDataLength Length (in bytes) of the data being sent.
- * @param[in] xFlags Flags used to communicate preferences to the function.
- *                    Possibly FREERTOS_MSG_DONTWAIT and/or FREERTOS_ZERO_COPY.
- * @param[in] pxDestinationAddress The address to which the data is to be sent.
+ * @brief Find the offset of the UDP payload in a packet that is sent to an
+ *        address of the given family.
+ * @param[in] ucFamily Either FREERTOS_AF_INET4 or FREERTOS_AF_INET6.
+ * @param[out] puxMaxPayloadLength The maximum number of payload bytes that
+ *                                  fit in a single packet.
+ * @return The offset of the payload from the start of the Ethernet frame,
+ *         or zero when the family is not supported.
+ */
+static size_t prvSendTo_GetPayloadOffset( uint8_t ucFamily,
+                                          size_t * puxMaxPayloadLength )
+{
+    size_t uxPayloadOffset = 0U;
+
+    switch( ucFamily )
+    {
+        #if ( ipconfigUSE_IPv6 != 0 )
+            case FREERTOS_AF_INET6:
+                *puxMaxPayloadLength = ipconfigNETWORK_MTU - ( ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER );
+                uxPayloadOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER;
+                break;
+        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+        #if ( ipconfigUSE_IPv4 != 0 )
+            case FREERTOS_AF_INET4:
+                *puxMaxPayloadLength = ipconfigNETWORK_MTU - ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER );
+                uxPayloadOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER;
+                break;
+        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+        default:
+            /* MISRA 16.4 Compliance */
+            break;
+    }
+
+    return uxPayloadOffset;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send data to a socket. The socket must have already been created by a
+ *        successful call to FreeRTOS_socket(). It works for UDP-sockets only.
+ *
+ * @param[in] xSocket The socket being sent to.
+ * @param[in] pvBuffer Pointer to the data being sent.
+ * @param[in] uxTotalDataLength Length (in bytes) of the data being sent.
+ * @param[in] xFlags Flags used to communicate preferences to the function.
+ *                    Possibly FREERTOS_MSG_DONTWAIT and/or FREERTOS_ZERO_COPY.
+ * @param[in] pxDestinationAddress The address to which the data is to be sent.
  * @param[in] xDestinationAddressLength This parameter is present to adhere to the
  *                  Berkeley sockets standard. Else, it is not used.
  *
@@ -1603,29 +1994,14 @@ int32_t FreeRTOS_sendto( Socket_t xSocket,
     configASSERT( pxDestinationAddress != NULL );
     configASSERT( pvBuffer != NULL );
 
-    switch( pxDestinationAddress->sin_family )
-    {
-        #if ( ipconfigUSE_IPv6 != 0 )
-            case FREERTOS_AF_INET6:
-                uxMaxPayloadLength = ipconfigNETWORK_MTU - ( ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER );
-                uxPayloadOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER;
-                break;
-        #endif /* ( ipconfigUSE_IPv6 != 0 ) */
-
-        #if ( ipconfigUSE_IPv4 != 0 )
-            case FREERTOS_AF_INET4:
-                uxMaxPayloadLength = ipconfigNETWORK_MTU - ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER );
-                uxPayloadOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER;
-                break;
-        #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+    uxPayloadOffset = prvSendTo_GetPayloadOffset( pxDestinationAddress->sin_family, &( uxMaxPayloadLength ) );
 
-        default:
-            FreeRTOS_debug_printf( ( "FreeRTOS_sendto: Undefined sin_family \n" ) );
-            lReturn = -pdFREERTOS_ERRNO_EINVAL;
-            break;
+    if( uxPayloadOffset == 0U )
+    {
+        FreeRTOS_debug_printf( ( "FreeRTOS_sendto: Undefined sin_family \n" ) );
+        lReturn = -pdFREERTOS_ERRNO_EINVAL;
     }
-
-    if( lReturn == 0 )
+    else
     {
         if( uxTotalDataLength <= ( size_t ) uxMaxPayloadLength )
         {
@@ -1653,6 +2029,236 @@ int32_t FreeRTOS_sendto( Socket_t xSocket,
 } /* Tested */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) )
+
+/**
+ * @brief Called by FreeRTOS_sendmmsg(), it obtains a network buffer for
+ *        a single message and fills in the headers.
+ * @param[in] pxSocket The socket used for sending.
+ * @param[in] pxMessage The message to be sent.
+ * @param[in] xFlags The flags that were passed to FreeRTOS_sendmmsg().
+ * @param[in] xTicksToWait The time to wait for a network buffer.
+ * @return The network buffer, or NULL when the message can not be sent.
+ */
+    static NetworkBufferDescriptor_t * prvSendMMsg_PrepareBuffer( const FreeRTOS_Socket_t * pxSocket,
+                                                                  const struct freertos_mmsghdr * pxMessage,
+                                                                  BaseType_t xFlags,
+                                                                  TickType_t xTicksToWait )
+    {
+        NetworkBufferDescriptor_t * pxNetworkBuffer = NULL;
+        const struct freertos_sockaddr * pxDestinationAddress = &( pxMessage->xAddress );
+        size_t uxMaxPayloadLength = 0U;
+        size_t uxPayloadOffset;
+
+        #if ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 )
+            struct freertos_sockaddr xTempDestinationAddress;
+
+            if( ( pxDestinationAddress->sin_family != FREERTOS_AF_INET6 ) && ( pxDestinationAddress->sin_family != FREERTOS_AF_INET ) )
+            {
+                ( void ) memcpy( &xTempDestinationAddress, pxDestinationAddress, sizeof( struct freertos_sockaddr ) );
+                xTempDestinationAddress.sin_family = FREERTOS_AF_INET;
+                pxDestinationAddress = &xTempDestinationAddress;
+            }
+        #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
+
+        uxPayloadOffset = prvSendTo_GetPayloadOffset( pxDestinationAddress->sin_family, &( uxMaxPayloadLength ) );
+
+        if( uxPayloadOffset == 0U )
+        {
+            FreeRTOS_debug_printf( ( "FreeRTOS_sendmmsg: Undefined sin_family \n" ) );
+        }
+        else if( pxMessage->uxBufferLength > uxMaxPayloadLength )
+        {
+            /* The data is longer than the available buffer space. */
+            iptraceSENDTO_DATA_TOO_LONG();
+        }
+        else if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) != 0U )
+        {
+            /* 'pvBuffer' points to the payload of a buffer that was obtained
+             * with FreeRTOS_GetUDPPayloadBuffer_Multi(). */
+            pxNetworkBuffer = pxUDPPayloadBuffer_to_NetworkBuffer( pxMessage->pvBuffer );
+
+            #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+                if( ( pxNetworkBuffer != NULL ) && ( pxNetworkBuffer->usShareCount != 0U ) )
+                {
+                    /* Other sockets may still read the Ethernet buffer of a payload
+                     * that was received on a shared port.  It is not sent, and it
+                     * remains owned by the caller. */
+                    FreeRTOS_debug_printf( ( "FreeRTOS_sendmmsg: shared zero-copy buffer\n" ) );
+                    pxNetworkBuffer = NULL;
+                }
+            #endif
+        }
+        else
+        {
+            pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxPayloadOffset + pxMessage->uxBufferLength, xTicksToWait );
+
+            if( pxNetworkBuffer != NULL )
+            {
+                void * pvCopyDest = ( void * ) &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] );
+                ( void ) memcpy( pvCopyDest, pxMessage->pvBuffer, pxMessage->uxBufferLength );
+            }
+            else
+            {
+                iptraceNO_BUFFER_FOR_SENDTO();
+            }
+        }
+
+        if( pxNetworkBuffer != NULL )
+        {
+            pxNetworkBuffer->pxEndPoint = pxSocket->pxEndPoint;
+            pxNetworkBuffer->pxNextBuffer = NULL;
+            prvSendUDPPacket_SetHeaders( pxSocket, pxNetworkBuffer, pxMessage->uxBufferLength, pxDestinationAddress, uxPayloadOffset );
+        }
+
+        return pxNetworkBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send several UDP packets with a single call. All packets are passed
+ *        to the IP-task with a single event. When a message can not be sent,
+ *        because it is too long or because no network buffer is available,
+ *        the messages before it will still be sent.
+ *
+ * @param[in] xSocket The UDP socket used for sending.
+ * @param[in,out] pxMessages An array of messages. For each message, 'pvBuffer'
+ *                 and 'uxBufferLength' describe the payload, and 'xAddress'
+ *                 the destination. When the flag FREERTOS_ZERO_COPY is used,
+ *                 'pvBuffer' must point to a payload buffer obtained from
+ *                 FreeRTOS_GetUDPPayloadBuffer_Multi(), and that was not
+ *                 received on a port that is shared with FREERTOS_SO_REUSEADDR.
+ *                 'lLength' will be set to the number of bytes sent, or zero
+ *                 when the message was not sent.
+ * @param[in] uxMessageCount The number of elements in pxMessages.
+ * @param[in] xFlags FREERTOS_ZERO_COPY and/or FREERTOS_MSG_DONTWAIT.
+ *
+ * @return The number of messages that were passed to the IP-task. Or else,
+ *         an error code is returned, see 'FreeRTOS-Kernel/projdefs.h'.
+ */
+    int32_t FreeRTOS_sendmmsg( Socket_t xSocket,
+                               struct freertos_mmsghdr * pxMessages,
+                               size_t uxMessageCount,
+                               BaseType_t xFlags )
+    {
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        NetworkBufferDescriptor_t * pxFirstBuffer = NULL;
+        NetworkBufferDescriptor_t * pxLastBuffer = NULL;
+        NetworkBufferDescriptor_t * pxNetworkBuffer;
+        IPStackEvent_t xStackTxEvent = { eStackTxBatchEvent, NULL };
+        TickType_t xTicksToWait;
+        TimeOut_t xTimeOut;
+        size_t uxCount = 0U;
+        size_t uxIndex;
+        int32_t lReturn = 0;
+
+        if( ( pxMessages == NULL ) || ( uxMessageCount == 0U ) )
+        {
+            lReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else if( prvMakeSureSocketIsBound( pxSocket ) == pdFALSE )
+        {
+            iptraceSENDTO_SOCKET_NOT_BOUND();
+            lReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            xTicksToWait = pxSocket->xSendBlockTime;
+
+            if( ( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_MSG_DONTWAIT ) != 0U ) ||
+                ( xIsCallingFromIPTask() != pdFALSE ) )
+            {
+                /* The caller wants a non-blocking operation. When called by the IP-task,
+                 * the operation should always be non-blocking. */
+                xTicksToWait = ( TickType_t ) 0U;
+            }
+
+            /* Messages that will not be sent report a length of zero. */
+            for( uxIndex = 0U; uxIndex < uxMessageCount; uxIndex++ )
+            {
+                pxMessages[ uxIndex ].lLength = 0;
+            }
+
+            vTaskSetTimeOutState( &xTimeOut );
+
+            for( uxIndex = 0U; uxIndex < uxMessageCount; uxIndex++ )
+            {
+                pxNetworkBuffer = prvSendMMsg_PrepareBuffer( pxSocket, &( pxMessages[ uxIndex ] ), xFlags, xTicksToWait );
+
+                if( pxNetworkBuffer == NULL )
+                {
+                    break;
+                }
+
+                if( pxLastBuffer == NULL )
+                {
+                    pxFirstBuffer = pxNetworkBuffer;
+                }
+                else
+                {
+                    pxLastBuffer->pxNextBuffer = pxNetworkBuffer;
+                }
+
+                pxLastBuffer = pxNetworkBuffer;
+                uxCount++;
+
+                if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
+                {
+                    /* The entire block time has been used up. */
+                    xTicksToWait = ( TickType_t ) 0;
+                }
+            }
+
+            if( pxFirstBuffer != NULL )
+            {
+                /* Pass the whole chain to the IP-task with a single event. */
+                xStackTxEvent.pvData = pxFirstBuffer;
+
+                if( xSendEventStructToIPTask( &xStackTxEvent, xTicksToWait ) == pdPASS )
+                {
+                    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+                    {
+                        pxMessages[ uxIndex ].lLength = ( int32_t ) pxMessages[ uxIndex ].uxBufferLength;
+
+                        #if ( ipconfigUSE_CALLBACKS == 1 )
+                        {
+                            if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xUDP.pxHandleSent ) )
+                            {
+                                pxSocket->u.xUDP.pxHandleSent( pxSocket, pxMessages[ uxIndex ].uxBufferLength );
+                            }
+                        }
+                        #endif /* ipconfigUSE_CALLBACKS */
+                    }
+
+                    lReturn = ( int32_t ) uxCount;
+                }
+                else
+                {
+                    /* Release the buffers that were allocated in this function,
+                     * zero-copy buffers remain owned by the caller. */
+                    while( pxFirstBuffer != NULL )
+                    {
+                        pxNetworkBuffer = pxFirstBuffer;
+                        pxFirstBuffer = pxNetworkBuffer->pxNextBuffer;
+                        pxNetworkBuffer->pxNextBuffer = NULL;
+
+                        if( ( ( UBaseType_t ) xFlags & ( UBaseType_t ) FREERTOS_ZERO_COPY ) == 0U )
+                        {
+                            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+                        }
+                    }
+
+                    iptraceSTACK_TX_EVENT_LOST( ipSTACK_TX_EVENT );
+                }
+            }
+        }
+
+        return lReturn;
+    }
+
+#endif /* ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief binds a socket to a local port number. If port 0 is provided,
  *        a system provided port number will be assigned. This function
@@ -1789,11 +2395,27 @@ static BaseType_t prvSocketBindAdd( FreeRTOS_Socket_t * pxSocket,
                                     BaseType_t xInternal )
 {
     BaseType_t xReturn = 0;
+    BaseType_t xPortInUse = pdFALSE;
 
     /* Check to ensure the port is not already in use.  If the bind is
      * called internally, a port MAY be used by more than one socket. */
     if( ( ( xInternal == pdFALSE ) || ( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_TCP ) ) &&
         ( pxListFindListItemWithValue( pxSocketList, ( TickType_t ) pxAddress->sin_port ) != NULL ) )
+    {
+        xPortInUse = pdTRUE;
+
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+        {
+            /* UDP sockets that all set FREERTOS_SO_REUSEADDR may share the port. */
+            if( prvUDPPortCanBeShared( pxSocket, pxSocketList, ( TickType_t ) pxAddress->sin_port ) != pdFALSE )
+            {
+                xPortInUse = pdFALSE;
+            }
+        }
+        #endif
+    }
+
+    if( xPortInUse != pdFALSE )
     {
         FreeRTOS_debug_printf( ( "vSocketBind: %sP port %d in use\n",
                                  ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP ) ? "TC" : "UD",
@@ -1862,6 +2484,12 @@ static BaseType_t prvSocketBindAdd( FreeRTOS_Socket_t * pxSocket,
             /* Add the socket to 'xBoundUDPSocketsList' or 'xBoundTCPSocketsList' */
             vListInsertEnd( pxSocketList, &( pxSocket->xBoundSocketListItem ) );
 
+            #if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+            {
+                prvPortFilterUpdate( pxSocket );
+            }
+            #endif
+
             #if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
             {
                 ( void ) xTaskResumeAll();
@@ -2081,6 +2709,19 @@ void * vSocketClose( FreeRTOS_Socket_t * pxSocket )
 {
     NetworkBufferDescriptor_t * pxNetworkBuffer;
 
+    #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+    {
+        vSocketSelectRemove( pxSocket );
+    }
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+    {
+        /* Make sure that the socket can not be reported by FreeRTOS_epoll_wait(). */
+        vSocketEPollRemove( pxSocket );
+    }
+    #endif
+
     #if ( ipconfigUSE_TCP == 1 )
     {
         /* For TCP: clean up a little more. */
@@ -2133,6 +2774,13 @@ void * vSocketClose( FreeRTOS_Socket_t * pxSocket )
 
         ( void ) uxListRemove( &( pxSocket->xBoundSocketListItem ) );
 
+        #if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+        {
+            /* Another socket may still use a port that maps to the same bit. */
+            prvPortFilterUpdate( pxSocket );
+        }
+        #endif
+
         #if ( ipconfigETHERNET_DRIVER_FILTERS_PACKETS == 1 )
         {
             ( void ) xTaskResumeAll();
@@ -2144,6 +2792,12 @@ void * vSocketClose( FreeRTOS_Socket_t * pxSocket )
      * drained. */
     if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
     {
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+        {
+            vMulticastSocketClosed( pxSocket );
+        }
+        #endif
+
         while( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U )
         {
             pxNetworkBuffer = ( ( NetworkBufferDescriptor_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) );
@@ -2790,6 +3444,146 @@ static void prvSetOptionTimeout( FreeRTOS_Socket_t * pxSocket,
 #endif /* ( ipconfigUSE_TCP != 0 ) */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+
+/**
+ * @brief Handle the socket options FREERTOS_SO_IP_ADD_MEMBERSHIP,
+ *        FREERTOS_SO_IP_DROP_MEMBERSHIP, FREERTOS_SO_IPV6_ADD_MEMBERSHIP and
+ *        FREERTOS_SO_IPV6_DROP_MEMBERSHIP.  The group is joined on the interface
+ *        that is given, or on the interface of the first end-point of the IP
+ *        family.
+ *
+ * @param[in] pxSocket The UDP socket.
+ * @param[in] lOptionName The option name.
+ * @param[in] pvOptionValue A pointer to a 'struct freertos_ip_mreq' or to a
+ *                          'struct freertos_ipv6_mreq'.
+ * @param[in] uxOptionLength The size of the structure that pvOptionValue points to.
+ *
+ * @return If there is no error, then 0 is returned. Or a negative errno
+ *         value is returned.
+ */
+    static BaseType_t prvSetOptionMulticast( FreeRTOS_Socket_t * pxSocket,
+                                             int32_t lOptionName,
+                                             const void * pvOptionValue,
+                                             size_t uxOptionLength )
+    {
+        BaseType_t xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        BaseType_t xIsIPv6 = pdFALSE;
+        BaseType_t xJoin = pdFALSE;
+        NetworkInterface_t * pxInterface = NULL;
+        NetworkEndPoint_t * pxEndPoint;
+        IP_Address_t xGroup;
+
+        ( void ) memset( &( xGroup ), 0, sizeof( xGroup ) );
+
+        if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP ) && ( pvOptionValue != NULL ) )
+        {
+            switch( lOptionName )
+            {
+                #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) )
+                    case FREERTOS_SO_IP_ADD_MEMBERSHIP:
+                    case FREERTOS_SO_IP_DROP_MEMBERSHIP:
+                       {
+                           const struct freertos_ip_mreq * pxRequest = ( const struct freertos_ip_mreq * ) pvOptionValue;
+
+                           xJoin = ( lOptionName == FREERTOS_SO_IP_ADD_MEMBERSHIP ) ? pdTRUE : pdFALSE;
+
+                           if( uxOptionLength < sizeof( *pxRequest ) )
+                           {
+                               /* The structure is too short, return -pdFREERTOS_ERRNO_EINVAL. */
+                           }
+                           else if( xIsIPv4Multicast( pxRequest->imr_multiaddr ) != pdFALSE )
+                           {
+                               xGroup.ulIP_IPv4 = pxRequest->imr_multiaddr;
+
+                               if( pxRequest->imr_interface != FREERTOS_INADDR_ANY )
+                               {
+                                   pxEndPoint = FreeRTOS_FindEndPointOnIP_IPv4( pxRequest->imr_interface );
+                               }
+                               else
+                               {
+                                   for( pxEndPoint = FreeRTOS_FirstEndPoint( NULL );
+                                        pxEndPoint != NULL;
+                                        pxEndPoint = FreeRTOS_NextEndPoint( NULL, pxEndPoint ) )
+                                   {
+                                       if( pxEndPoint->bits.bIPv6 == pdFALSE_UNSIGNED )
+                                       {
+                                           break;
+                                       }
+                                   }
+                               }
+
+                               if( pxEndPoint != NULL )
+                               {
+                                   pxInterface = pxEndPoint->pxNetworkInterface;
+                               }
+                           }
+                       }
+                       break;
+                #endif /* ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) ) */
+
+                #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+                    case FREERTOS_SO_IPV6_ADD_MEMBERSHIP:
+                    case FREERTOS_SO_IPV6_DROP_MEMBERSHIP:
+                       {
+                           const struct freertos_ipv6_mreq * pxRequest = ( const struct freertos_ipv6_mreq * ) pvOptionValue;
+
+                           xIsIPv6 = pdTRUE;
+                           xJoin = ( lOptionName == FREERTOS_SO_IPV6_ADD_MEMBERSHIP ) ? pdTRUE : pdFALSE;
+
+                           if( uxOptionLength < sizeof( *pxRequest ) )
+                           {
+                               /* The structure is too short, return -pdFREERTOS_ERRNO_EINVAL. */
+                           }
+                           else if( pxRequest->ipv6mr_multiaddr.ucBytes[ 0 ] == 0xffU )
+                           {
+                               ( void ) memcpy( xGroup.xIP_IPv6.ucBytes, pxRequest->ipv6mr_multiaddr.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+                               if( pxRequest->ipv6mr_interface != NULL )
+                               {
+                                   pxInterface = pxRequest->ipv6mr_interface;
+                               }
+                               else
+                               {
+                                   for( pxEndPoint = FreeRTOS_FirstEndPoint( NULL );
+                                        pxEndPoint != NULL;
+                                        pxEndPoint = FreeRTOS_NextEndPoint( NULL, pxEndPoint ) )
+                                   {
+                                       if( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED )
+                                       {
+                                           pxInterface = pxEndPoint->pxNetworkInterface;
+                                           break;
+                                       }
+                                   }
+                               }
+                           }
+                       }
+                       break;
+                #endif /* ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) ) */
+
+                default:
+                    /* Not a multicast option. */
+                    break;
+            }
+        }
+
+        if( pxInterface != NULL )
+        {
+            if( xJoin != pdFALSE )
+            {
+                xReturn = xMulticastJoinGroup( pxSocket, &( xGroup ), xIsIPv6, pxInterface );
+            }
+            else
+            {
+                xReturn = xMulticastLeaveGroup( pxSocket, &( xGroup ), xIsIPv6, pxInterface );
+            }
+        }
+
+        return xReturn;
+    }
+#endif /* ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) ) */
+/*-----------------------------------------------------------*/
+
 /* FreeRTOS_setsockopt calls itself, but in a very limited way,
  * only when FREERTOS_SO_WIN_PROPERTIES is being set. */
 
@@ -2801,8 +3595,8 @@ static void prvSetOptionTimeout( FreeRTOS_Socket_t * pxSocket,
  *                    standard.
  * @param[in] lOptionName The name of the option to be set.
  * @param[in] pvOptionValue The value of the option to be set.
- * @param[in] uxOptionLength Not used. Parameter is used to maintain the Berkeley
- *                            sockets standard.
+ * @param[in] uxOptionLength The size of the option value.  Only checked for the
+ *                            multicast membership options.
  *
  * @return If the option can be set with the given value, then 0 is returned. Else,
  *         an error code is returned.
@@ -2948,6 +3742,32 @@ BaseType_t FreeRTOS_setsockopt( Socket_t xSocket,
                         break;
                 #endif /* ipconfigUSE_TCP == 1 */
 
+                #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+                    case FREERTOS_SO_REUSEADDR: /* Let other UDP sockets bind to the same port, set before binding. */
+
+                        if( pxSocket->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_UDP )
+                        {
+                            break; /* will return -pdFREERTOS_ERRNO_EINVAL */
+                        }
+
+                        pxSocket->u.xUDP.ucReuseAddress = ( *( ( const BaseType_t * ) pvOptionValue ) != 0 ) ? 1U : 0U;
+                        xReturn = 0;
+                        break;
+                #endif /* ipconfigSUPPORT_UDP_REUSEADDR */
+
+                #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+                    #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) )
+                        case FREERTOS_SO_IP_ADD_MEMBERSHIP:  /* Join an IPv4 multicast group, parameter is a pointer to 'struct freertos_ip_mreq' */
+                        case FREERTOS_SO_IP_DROP_MEMBERSHIP: /* Leave an IPv4 multicast group */
+                    #endif
+                    #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+                        case FREERTOS_SO_IPV6_ADD_MEMBERSHIP:  /* Join an IPv6 multicast group, parameter is a pointer to 'struct freertos_ipv6_mreq' */
+                        case FREERTOS_SO_IPV6_DROP_MEMBERSHIP: /* Leave an IPv6 multicast group */
+                    #endif
+                    xReturn = prvSetOptionMulticast( pxSocket, lOptionName, pvOptionValue, uxOptionLength );
+                    break;
+                #endif /* ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) ) */
+
             default:
                 /* No other options are handled. */
                 xReturn = -pdFREERTOS_ERRNO_ENOPROTOOPT;
@@ -3102,36 +3922,121 @@ FreeRTOS_Socket_t * pxUDPSocketLookup( UBaseType_t uxLocalPort )
 
 /*-----------------------------------------------------------*/
 
-#define sockDIGIT_COUNT    ( 3U ) /**< Each nibble is expressed in at most 3 digits such as "192". */
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
 
 /**
- * @brief Convert the 32-bit representation of the IP-address to the dotted decimal
- *        notation after some checks.
- *        A safe alternative is FreeRTOS_inet_ntop4().
+ * @brief Find the next UDP socket that is bound to the same port, when
+ *        several sockets share a port with FREERTOS_SO_REUSEADDR.
  *
- * @param[in] ulIPAddress 32-bit representation of the IP-address.
- * @param[out] pcBuffer The buffer where the dotted decimal representation will be
- *                      stored if all checks pass. The buffer must be at least 16
- *                      bytes long.
+ * @param[in] pxSocket A socket that was found by pxUDPSocketLookup() or by
+ *                     this function.
  *
- * @return The pointer returned will be same as pcBuffer and will have the address
- *         stored in the location.
+ * @return The next socket bound to the same port, or NULL when there is none.
  */
-const char * FreeRTOS_inet_ntoa( uint32_t ulIPAddress,
-                                 char * pcBuffer )
-{
-    socklen_t uxNibble;
-    socklen_t uxIndex = 0;
-    const uint8_t * pucAddress = ( const uint8_t * ) &( ulIPAddress );
-    const char * pcResult = pcBuffer;
-
-    for( uxNibble = 0; uxNibble < ipSIZE_OF_IPv4_ADDRESS; uxNibble++ )
+    FreeRTOS_Socket_t * pxUDPSocketLookupNext( const FreeRTOS_Socket_t * pxSocket )
     {
-        uint8_t pucDigits[ sockDIGIT_COUNT ];
-        uint8_t ucValue = pucAddress[ uxNibble ];
-        socklen_t uxSource = ( socklen_t ) sockDIGIT_COUNT - ( socklen_t ) 1U;
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( xBoundUDPSocketsList.xListEnd ) );
+        TickType_t xPort = listGET_LIST_ITEM_VALUE( &( pxSocket->xBoundSocketListItem ) );
+        const ListItem_t * pxIterator;
+        FreeRTOS_Socket_t * pxNext = NULL;
 
-        for( ; ; )
+        for( pxIterator = listGET_NEXT( &( pxSocket->xBoundSocketListItem ) );
+             pxIterator != pxEnd;
+             pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            if( listGET_LIST_ITEM_VALUE( pxIterator ) == xPort )
+            {
+                pxNext = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                break;
+            }
+        }
+
+        return pxNext;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a UDP socket may bind to a port that is already in use: the
+ *        socket and all the sockets that are bound to the port must have set
+ *        the option FREERTOS_SO_REUSEADDR.
+ *
+ * @param[in] pxSocket The socket that is being bound.
+ * @param[in] pxSocketList The list of bound sockets.
+ * @param[in] xPort The port number in network byte order.
+ *
+ * @return pdTRUE when the port can be shared.
+ */
+    static BaseType_t prvUDPPortCanBeShared( const FreeRTOS_Socket_t * pxSocket,
+                                             const List_t * pxSocketList,
+                                             TickType_t xPort )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP ) &&
+            ( pxSocket->u.xUDP.ucReuseAddress != 0U ) )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ListItem_t * pxEnd = ( ( const ListItem_t * ) &( pxSocketList->xListEnd ) );
+            const ListItem_t * pxIterator;
+
+            xReturn = pdTRUE;
+
+            for( pxIterator = listGET_HEAD_ENTRY( pxSocketList );
+                 pxIterator != pxEnd;
+                 pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                const FreeRTOS_Socket_t * pxOther = ( ( const FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                if( ( listGET_LIST_ITEM_VALUE( pxIterator ) == xPort ) &&
+                    ( ( pxOther->ucProtocol != ( uint8_t ) FREERTOS_IPPROTO_UDP ) || ( pxOther->u.xUDP.ucReuseAddress == 0U ) ) )
+                {
+                    xReturn = pdFALSE;
+                    break;
+                }
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) ) */
+
+#define sockDIGIT_COUNT    ( 3U ) /**< Each nibble is expressed in at most 3 digits such as "192". */
+
+/**
+ * @brief Convert the 32-bit representation of the IP-address to the dotted decimal
+ *        notation after some checks.
+ *        A safe alternative is FreeRTOS_inet_ntop4().
+ *
+ * @param[in] ulIPAddress 32-bit representation of the IP-address.
+ * @param[out] pcBuffer The buffer where the dotted decimal representation will be
+ *                      stored if all checks pass. The buffer must be at least 16
+ *                      bytes long.
+ *
+ * @return The pointer returned will be same as pcBuffer and will have the address
+ *         stored in the location.
+ */
+const char * FreeRTOS_inet_ntoa( uint32_t ulIPAddress,
+                                 char * pcBuffer )
+{
+    socklen_t uxNibble;
+    socklen_t uxIndex = 0;
+    const uint8_t * pucAddress = ( const uint8_t * ) &( ulIPAddress );
+    const char * pcResult = pcBuffer;
+
+    for( uxNibble = 0; uxNibble < ipSIZE_OF_IPv4_ADDRESS; uxNibble++ )
+    {
+        uint8_t pucDigits[ sockDIGIT_COUNT ];
+        uint8_t ucValue = pucAddress[ uxNibble ];
+        socklen_t uxSource = ( socklen_t ) sockDIGIT_COUNT - ( socklen_t ) 1U;
+
+        for( ; ; )
         {
             pucDigits[ uxSource ] = ucValue % ( uint8_t ) 10U;
             ucValue /= ( uint8_t ) 10U;
@@ -3566,7 +4471,23 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
                 pxSocket->xSocketBits |= xSelectBits;
                 ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, xSelectBits );
             }
+
+            #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+            {
+                /* Any event may change the select state of the socket. */
+                vSocketSelectChanged( pxSocket );
+            }
+            #endif
+        }
+
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+        {
+            if( pxSocket->pxEPoll != NULL )
+            {
+                vSocketEPollReady( pxSocket, ( pxSocket->xEventBits >> SOCKET_EVENT_BIT_COUNT ) & ( ( EventBits_t ) eSELECT_ALL ) );
+            }
         }
+        #endif /* ipconfigSUPPORT_EPOLL */
 
         pxSocket->xEventBits &= ( EventBits_t ) eSOCKET_ALL;
     }
@@ -3589,6 +4510,8 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
  *        UDP messages and see if there is any UDP socket bound to a given port
  *        number.  This is probably only useful in systems with a minimum of
  *        RAM and when lots of anonymous broadcast messages come in.
+ *        When ipconfigUSE_EARLY_RX_FILTER is enabled, the bound-port bitmap is
+ *        checked first, and the list is only searched when the bit is set.
  *
  * @param[in] usPortNr the port number to look for.
  *
@@ -3598,14 +4521,21 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
     {
         BaseType_t xFound = pdFALSE;
 
-        vTaskSuspendAll();
+        #if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+            /* A cleared bit means that no socket is bound to the port,
+             * the scheduler does not need to be suspended. */
+            if( xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_UDP, usPortNr ) != pdFALSE )
+        #endif
         {
-            if( ( pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) usPortNr ) != NULL ) )
+            vTaskSuspendAll();
             {
-                xFound = pdTRUE;
+                if( ( pxListFindListItemWithValue( &xBoundUDPSocketsList, ( TickType_t ) usPortNr ) != NULL ) )
+                {
+                    xFound = pdTRUE;
+                }
             }
+            ( void ) xTaskResumeAll();
         }
-        ( void ) xTaskResumeAll();
 
         return xFound;
     }
@@ -3614,6 +4544,106 @@ void vSocketWakeUpUser( FreeRTOS_Socket_t * pxSocket )
 
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+
+/**
+ * @brief Set or clear the bit of a socket's port number in the bound-port
+ *        bitmap of its protocol. The bit is set when any bound socket has a
+ *        port number that maps to it. The bitmap byte is written only once,
+ *        so a network driver never sees a bit cleared that should be set.
+ *
+ * @param[in] pxSocket The socket that was just bound or unbound.
+ */
+    static void prvPortFilterUpdate( const FreeRTOS_Socket_t * pxSocket )
+    {
+        const List_t * pxSocketList = &xBoundUDPSocketsList;
+        uint8_t * pucBits = ucUDPPortBits;
+        uint16_t usPort = ( uint16_t ) socketGET_SOCKET_PORT( pxSocket );
+        uint16_t usIndex = ( uint16_t ) ( FreeRTOS_ntohs( usPort ) & socketPORT_FILTER_MASK );
+        uint8_t ucMask = ( uint8_t ) ( 1U << ( usIndex & 7U ) );
+        uint8_t ucByte;
+        const ListItem_t * pxIterator;
+        const ListItem_t * pxEnd;
+
+        #if ( ipconfigUSE_TCP == 1 )
+            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+            {
+                pxSocketList = &xBoundTCPSocketsList;
+                pucBits = ucTCPPortBits;
+            }
+        #endif /* ipconfigUSE_TCP == 1 */
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        pxEnd = ( ( const ListItem_t * ) &( pxSocketList->xListEnd ) );
+        ucByte = ( uint8_t ) ( pucBits[ usIndex >> 3 ] & ( uint8_t ) ~ucMask );
+
+        for( pxIterator = listGET_HEAD_ENTRY( pxSocketList );
+             pxIterator != pxEnd;
+             pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            usPort = ( uint16_t ) listGET_LIST_ITEM_VALUE( pxIterator );
+
+            if( ( FreeRTOS_ntohs( usPort ) & socketPORT_FILTER_MASK ) == usIndex )
+            {
+                ucByte |= ucMask;
+                break;
+            }
+        }
+
+        pucBits[ usIndex >> 3 ] = ucByte;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a socket may be bound to a port number.  The check is done
+ *        with a bitmap, so it does not need a lock, and it can be called by a
+ *        network driver, also from an interrupt.  A result of pdTRUE may be a
+ *        false positive, pdFALSE means that no socket is bound to the port.
+ *        xPortHasUDPSocket() uses this check before it searches the list of
+ *        bound UDP sockets.
+ *
+ * @param[in] ucProtocol Either FREERTOS_IPPROTO_UDP or FREERTOS_IPPROTO_TCP.
+ * @param[in] usPortNr The port number in network-byte-order.
+ *
+ * @return pdFALSE when there is no socket bound to the port.
+ */
+    BaseType_t xPortMayHaveSocket( uint8_t ucProtocol,
+                                   uint16_t usPortNr )
+    {
+        const uint8_t * pucBits = NULL;
+        uint16_t usIndex = ( uint16_t ) ( FreeRTOS_ntohs( usPortNr ) & socketPORT_FILTER_MASK );
+        BaseType_t xReturn = pdFALSE;
+
+        if( ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_UDP )
+        {
+            pucBits = ucUDPPortBits;
+        }
+
+        #if ( ipconfigUSE_TCP == 1 )
+            else if( ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+            {
+                pucBits = ucTCPPortBits;
+            }
+        #endif /* ipconfigUSE_TCP == 1 */
+        else
+        {
+            /* Not a protocol with port numbers. */
+        }
+
+        if( ( pucBits != NULL ) && ( ( pucBits[ usIndex >> 3 ] & ( uint8_t ) ( 1U << ( usIndex & 7U ) ) ) != 0U ) )
+        {
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ipconfigUSE_EARLY_RX_FILTER != 0 ) */
+
+/*-----------------------------------------------------------*/
+
 #if ( ipconfigUSE_TCP == 1 )
 
 /**
@@ -6060,94 +7090,201 @@ BaseType_t FreeRTOS_GetIPType( ConstSocket_t xSocket )
     #endif /* ( ipconfigUSE_TCP == 1 ) */
 
 /**
- * @brief This internal non-blocking function will check all sockets that belong
- *        to a select set.  The events bits of each socket will be updated, and it
- *        will check if an ongoing select() call must be interrupted because of an
- *        event has occurred.
+ * @brief Find the select events that are active for a socket, limited to the
+ *        events in which the owner is interested ( xSelectBits ).
  *
- * @param[in] pxSocketSet The socket-set which is to be waited on for change.
+ * @param[in] pxSocket The socket which needs to be checked.
+ * @return An event mask of events that are active for this socket.
  */
-    void vSocketSelect( const SocketSelect_t * pxSocketSet )
+    static EventBits_t prvSocketSelectEvaluate( FreeRTOS_Socket_t * pxSocket )
     {
-        BaseType_t xRound;
-        EventBits_t xSocketBits, xBitsToClear;
+        EventBits_t xSocketBits = 0U;
 
-        #if ipconfigUSE_TCP == 1
-            BaseType_t xLastRound = 1;
-        #else
-            BaseType_t xLastRound = 0;
-        #endif
+        #if ( ipconfigUSE_TCP == 1 )
+            if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+            {
+                xSocketBits |= vSocketSelectTCP( pxSocket );
+            }
+            else
+        #endif /* ipconfigUSE_TCP == 1 */
+        {
+            /* Select events for UDP are simpler. */
+            if( ( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != 0U ) &&
+                ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
+            {
+                xSocketBits |= ( EventBits_t ) eSELECT_READ;
+            }
+
+            /* The WRITE and EXCEPT bits are not used for UDP */
+        } /* if( pxSocket->ucProtocol == FREERTOS_IPPROTO_TCP ) */
+
+        return xSocketBits;
+    }
+/*-----------------------------------------------------------*/
 
-        /* These flags will be switched on after checking the socket status. */
-        EventBits_t xGroupBits = 0;
+    #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
 
-        for( xRound = 0; xRound <= xLastRound; xRound++ )
+/**
+ * @brief Evaluate the members of a socket set that have changed since the last
+ *        call, and the members that had events during the last call. The other
+ *        members can not have any event.
+ *
+ * @param[in] pxSocketSet The socket-set which is to be evaluated.
+ *
+ * @return The ORed event bits of the evaluated members.
+ */
+        static EventBits_t prvSocketSelectIncremental( SocketSelect_t * pxSocketSet )
         {
             const ListItem_t * pxIterator;
+            const ListItem_t * pxNext;
             const ListItem_t * pxEnd;
-            const List_t * pxList;
+            FreeRTOS_Socket_t * pxSocket;
+            EventBits_t xGroupBits = 0U;
 
-            if( xRound == 0 )
+            /* The lists are also updated by the API functions. */
+            vTaskSuspendAll();
             {
-                /* MISRA Ref 11.3.1 [Misaligned access] */
-                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-                /* coverity[misra_c_2012_rule_11_3_violation] */
-                pxEnd = ( ( const ListItem_t * ) &( xBoundUDPSocketsList.xListEnd ) );
-                pxList = &xBoundUDPSocketsList;
-            }
+                /* Active sockets must be checked again: the user may have
+                 * consumed their events. */
+                pxEnd = listGET_END_MARKER( &( pxSocketSet->xActiveList ) );
 
-            #if ipconfigUSE_TCP == 1
-                else
+                for( pxIterator = listGET_HEAD_ENTRY( &( pxSocketSet->xActiveList ) );
+                     pxIterator != pxEnd;
+                     pxIterator = pxNext )
                 {
-                    /* MISRA Ref 11.3.1 [Misaligned access] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
-                    /* coverity[misra_c_2012_rule_11_3_violation] */
-                    pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
-                    pxList = &xBoundTCPSocketsList;
+                    pxNext = listGET_NEXT( pxIterator );
+                    pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                    /* Like in a full scan, only bound sockets can have events. */
+                    pxSocket->xSocketBits = socketSOCKET_IS_BOUND( pxSocket ) ? prvSocketSelectEvaluate( pxSocket ) : 0U;
+
+                    if( pxSocket->xSocketBits == 0U )
+                    {
+                        ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+                    }
+
+                    xGroupBits |= pxSocket->xSocketBits;
                 }
-            #endif /* ipconfigUSE_TCP == 1 */
 
-            for( pxIterator = listGET_HEAD_ENTRY( pxList );
-                 pxIterator != pxEnd;
-                 pxIterator = listGET_NEXT( pxIterator ) )
+                /* Sockets that had an event since the last evaluation. */
+                while( listCURRENT_LIST_LENGTH( &( pxSocketSet->xChangedList ) ) > 0U )
+                {
+                    pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocketSet->xChangedList ) ) );
+                    ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+
+                    pxSocket->xSocketBits = socketSOCKET_IS_BOUND( pxSocket ) ? prvSocketSelectEvaluate( pxSocket ) : 0U;
+
+                    if( pxSocket->xSocketBits != 0U )
+                    {
+                        vListInsertEnd( &( pxSocketSet->xActiveList ), &( pxSocket->xSelectListItem ) );
+                    }
+
+                    xGroupBits |= pxSocket->xSocketBits;
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            return xGroupBits;
+        }
+
+    #else /* if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) ) */
+
+/**
+ * @brief Evaluate all bound sockets that are a member of a socket set.
+ *
+ * @param[in] pxSocketSet The socket-set which is to be evaluated.
+ *
+ * @return The ORed event bits of all members.
+ */
+        static EventBits_t prvSocketSelectAll( const SocketSelect_t * pxSocketSet )
+        {
+            BaseType_t xRound;
+
+            #if ipconfigUSE_TCP == 1
+                BaseType_t xLastRound = 1;
+            #else
+                BaseType_t xLastRound = 0;
+            #endif
+
+            /* These flags will be switched on after checking the socket status. */
+            EventBits_t xGroupBits = 0;
+
+            for( xRound = 0; xRound <= xLastRound; xRound++ )
             {
-                FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+                const ListItem_t * pxIterator;
+                const ListItem_t * pxEnd;
+                const List_t * pxList;
 
-                if( pxSocket->pxSocketSet != pxSocketSet )
+                if( xRound == 0 )
                 {
-                    /* Socket does not belong to this select group. */
-                    continue;
+                    /* MISRA Ref 11.3.1 [Misaligned access] */
+                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                    /* coverity[misra_c_2012_rule_11_3_violation] */
+                    pxEnd = ( ( const ListItem_t * ) &( xBoundUDPSocketsList.xListEnd ) );
+                    pxList = &xBoundUDPSocketsList;
                 }
 
-                xSocketBits = 0;
-
-                #if ( ipconfigUSE_TCP == 1 )
-                    if( pxSocket->ucProtocol == ( uint8_t ) FREERTOS_IPPROTO_TCP )
+                #if ipconfigUSE_TCP == 1
+                    else
                     {
-                        xSocketBits |= vSocketSelectTCP( pxSocket );
+                        /* MISRA Ref 11.3.1 [Misaligned access] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                        /* coverity[misra_c_2012_rule_11_3_violation] */
+                        pxEnd = ( ( const ListItem_t * ) &( xBoundTCPSocketsList.xListEnd ) );
+                        pxList = &xBoundTCPSocketsList;
                     }
-                    else
                 #endif /* ipconfigUSE_TCP == 1 */
+
+                for( pxIterator = listGET_HEAD_ENTRY( pxList );
+                     pxIterator != pxEnd;
+                     pxIterator = listGET_NEXT( pxIterator ) )
                 {
-                    /* Select events for UDP are simpler. */
-                    if( ( ( pxSocket->xSelectBits & ( EventBits_t ) eSELECT_READ ) != 0U ) &&
-                        ( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) > 0U ) )
+                    FreeRTOS_Socket_t * pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) );
+
+                    if( pxSocket->pxSocketSet != pxSocketSet )
                     {
-                        xSocketBits |= ( EventBits_t ) eSELECT_READ;
+                        /* Socket does not belong to this select group. */
+                        continue;
                     }
 
-                    /* The WRITE and EXCEPT bits are not used for UDP */
-                } /* if( pxSocket->ucProtocol == FREERTOS_IPPROTO_TCP ) */
+                    /* Each socket keeps its own event flags, which are looked-up
+                     * by FreeRTOS_FD_ISSSET() */
+                    pxSocket->xSocketBits = prvSocketSelectEvaluate( pxSocket );
 
-                /* Each socket keeps its own event flags, which are looked-up
-                 * by FreeRTOS_FD_ISSSET() */
-                pxSocket->xSocketBits = xSocketBits;
+                    /* The ORed value will be used to set the bits in the event
+                     * group. */
+                    xGroupBits |= pxSocket->xSocketBits;
+                } /* for( pxIterator ... ) */
+            }     /* for( xRound = 0; xRound <= xLastRound; xRound++ ) */
 
-                /* The ORed value will be used to set the bits in the event
-                 * group. */
-                xGroupBits |= xSocketBits;
-            } /* for( pxIterator ... ) */
-        }     /* for( xRound = 0; xRound <= xLastRound; xRound++ ) */
+            return xGroupBits;
+        }
+
+    #endif /* if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief This internal non-blocking function will check all sockets that belong
+ *        to a select set.  The events bits of each socket will be updated, and it
+ *        will check if an ongoing select() call must be interrupted because of an
+ *        event has occurred.
+ *
+ * @param[in] pxSocketSet The socket-set which is to be waited on for change.
+ */
+    void vSocketSelect( SocketSelect_t * pxSocketSet )
+    {
+        EventBits_t xBitsToClear;
+        EventBits_t xGroupBits;
+
+        #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+        {
+            xGroupBits = prvSocketSelectIncremental( pxSocketSet );
+        }
+        #else
+        {
+            xGroupBits = prvSocketSelectAll( pxSocketSet );
+        }
+        #endif
 
         xBitsToClear = xEventGroupGetBits( pxSocketSet->xSelectGroup );
 
@@ -6171,11 +7308,475 @@ BaseType_t FreeRTOS_GetIPType( ConstSocket_t xSocket )
         /* Now include eSELECT_CALL_IP to wakeup the caller. */
         ( void ) xEventGroupSetBits( pxSocketSet->xSelectGroup, xGroupBits | ( EventBits_t ) eSELECT_CALL_IP );
     }
+/*-----------------------------------------------------------*/
+
+    #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+
+/**
+ * @brief Put a socket in the list of changed sockets of its socket set, so that
+ *        the next call to vSocketSelect() will evaluate it.
+ *
+ * @param[in] pxSocket The socket whose state may have changed.
+ */
+        void vSocketSelectChanged( FreeRTOS_Socket_t * pxSocket )
+        {
+            SocketSelect_t * pxSocketSet;
+            const List_t * pxContainer;
+
+            vTaskSuspendAll();
+            {
+                pxSocketSet = pxSocket->pxSocketSet;
+                pxContainer = listLIST_ITEM_CONTAINER( &( pxSocket->xSelectListItem ) );
+
+                if( pxSocketSet == NULL )
+                {
+                    /* The socket is not a member of a set. */
+                }
+                else if( ( pxContainer == &( pxSocketSet->xChangedList ) ) || ( pxContainer == &( pxSocketSet->xActiveList ) ) )
+                {
+                    /* The socket will be evaluated already. */
+                }
+                else
+                {
+                    /* The socket may still be in a list of another set. */
+                    if( pxContainer != NULL )
+                    {
+                        ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+                    }
+
+                    vListInsertEnd( &( pxSocketSet->xChangedList ), &( pxSocket->xSelectListItem ) );
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove a socket from the lists of its socket set.
+ *
+ * @param[in] pxSocket The socket that leaves its set, or that is being closed.
+ */
+        void vSocketSelectRemove( FreeRTOS_Socket_t * pxSocket )
+        {
+            vTaskSuspendAll();
+            {
+                if( listLIST_ITEM_CONTAINER( &( pxSocket->xSelectListItem ) ) != NULL )
+                {
+                    ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Remove all sockets from the lists of a socket set that is about to be
+ *        deleted.
+ *
+ * @param[in] pxSocketSet The socket set being deleted.
+ */
+        void vSocketSelectRemoveAll( SocketSelect_t * pxSocketSet )
+        {
+            FreeRTOS_Socket_t * pxSocket;
+
+            vTaskSuspendAll();
+            {
+                while( listCURRENT_LIST_LENGTH( &( pxSocketSet->xChangedList ) ) > 0U )
+                {
+                    pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocketSet->xChangedList ) ) );
+                    ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+                }
+
+                while( listCURRENT_LIST_LENGTH( &( pxSocketSet->xActiveList ) ) > 0U )
+                {
+                    pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxSocketSet->xActiveList ) ) );
+                    ( void ) uxListRemove( &( pxSocket->xSelectListItem ) );
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+
+    #endif /* ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) */
 
 
 #endif /* ipconfigSUPPORT_SELECT_FUNCTION == 1 */
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+
+/**
+ * @brief Add events to a socket and put it in the ready list of its epoll set.
+ *        Must be called while the scheduler is suspended.
+ *
+ * @param[in] pxSocket The socket that had an event.
+ * @param[in] xEvents The events that occurred.
+ */
+    static void prvEPollAddReady( FreeRTOS_Socket_t * pxSocket,
+                                  EventBits_t xEvents )
+    {
+        pxSocket->xEPollEvents |= xEvents;
+
+        if( listIS_CONTAINED_WITHIN( &( pxSocket->pxEPoll->xReadyList ), &( pxSocket->xEPollListItem ) ) == pdFALSE )
+        {
+            vListInsertEnd( &( pxSocket->pxEPoll->xReadyList ), &( pxSocket->xEPollListItem ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Disconnect a socket from its epoll set. Must be called while the
+ *        scheduler is suspended.
+ *
+ * @param[in] pxSocket The socket to be disconnected.
+ */
+    static void prvEPollDetach( FreeRTOS_Socket_t * pxSocket )
+    {
+        if( listLIST_ITEM_CONTAINER( &( pxSocket->xEPollListItem ) ) != NULL )
+        {
+            ( void ) uxListRemove( &( pxSocket->xEPollListItem ) );
+        }
+
+        if( listLIST_ITEM_CONTAINER( &( pxSocket->xEPollMemberItem ) ) != NULL )
+        {
+            ( void ) uxListRemove( &( pxSocket->xEPollMemberItem ) );
+        }
+
+        pxSocket->pxEPoll = NULL;
+        pxSocket->xSelectBits = 0U;
+        pxSocket->xEPollEvents = 0U;
+        pxSocket->pvEPollData = NULL;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create an epoll set.
+ *
+ * @return The new epoll set, or NULL when allocation has failed.
+ */
+    EPoll_t FreeRTOS_epoll_create( void )
+    {
+        SocketEPoll_t * pxEPoll;
+
+        /* MISRA Ref 4.12.1 [Use of dynamic memory]. */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#directive-412. */
+        /* coverity[misra_c_2012_directive_4_12_violation] */
+        pxEPoll = ( ( SocketEPoll_t * ) pvPortMalloc( sizeof( *pxEPoll ) ) );
+
+        if( pxEPoll != NULL )
+        {
+            ( void ) memset( pxEPoll, 0, sizeof( *pxEPoll ) );
+            pxEPoll->xEPollGroup = xEventGroupCreate();
+
+            if( pxEPoll->xEPollGroup == NULL )
+            {
+                vPortFree( pxEPoll );
+                pxEPoll = NULL;
+            }
+            else
+            {
+                vListInitialise( &( pxEPoll->xReadyList ) );
+                vListInitialise( &( pxEPoll->xMemberList ) );
+                iptraceMEM_STATS_CREATE( tcpSOCKET_SET, pxEPoll, sizeof( *pxEPoll ) + sizeof( StaticEventGroup_t ) );
+            }
+        }
+
+        return ( EPoll_t ) pxEPoll;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Delete an epoll set. The actual deletion is done by the IP-task,
+ *        which removes all sockets from the set, bound or not.
+ *
+ * @param[in] xEPoll The epoll set being deleted.
+ */
+    void FreeRTOS_epoll_delete( EPoll_t xEPoll )
+    {
+        IPStackEvent_t xDeleteEvent;
+
+        xDeleteEvent.eEventType = eEPollDeleteEvent;
+        xDeleteEvent.pvData = ( void * ) xEPoll;
+
+        if( xSendEventStructToIPTask( &xDeleteEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
+        {
+            FreeRTOS_printf( ( "FreeRTOS_epoll_delete: xSendEventStructToIPTask failed\n" ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Add a socket to an epoll set, change the events of interest, or
+ *        remove the socket from the set. When a socket is added or modified,
+ *        the events that are already active will be reported by the next call
+ *        to FreeRTOS_epoll_wait().
+ *
+ * @param[in] xEPoll The epoll set.
+ * @param[in] xOperation FREERTOS_EPOLL_CTL_ADD, FREERTOS_EPOLL_CTL_MOD or
+ *                        FREERTOS_EPOLL_CTL_DEL.
+ * @param[in] xSocket The socket.
+ * @param[in] xEvents The events of interest: a combination of eSELECT_READ,
+ *                     eSELECT_WRITE and eSELECT_EXCEPT.
+ * @param[in] pvData A value that will be reported along with the events.
+ *
+ * @return 0 on success, -pdFREERTOS_ERRNO_EEXIST when adding a socket that
+ *         already belongs to a set, -pdFREERTOS_ERRNO_ENOENT when the socket
+ *         does not belong to this set, or -pdFREERTOS_ERRNO_EINVAL.
+ */
+    BaseType_t FreeRTOS_epoll_ctl( EPoll_t xEPoll,
+                                   BaseType_t xOperation,
+                                   Socket_t xSocket,
+                                   EventBits_t xEvents,
+                                   void * pvData )
+    {
+        FreeRTOS_Socket_t * pxSocket = ( FreeRTOS_Socket_t * ) xSocket;
+        SocketEPoll_t * pxEPoll = ( SocketEPoll_t * ) xEPoll;
+        BaseType_t xReturn = 0;
+        IPStackEvent_t xCtlEvent;
+
+        if( ( pxEPoll == NULL ) || ( xSocketValid( pxSocket ) == pdFALSE ) )
+        {
+            xReturn = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            /* The socket fields are also used by the IP-task. */
+            vTaskSuspendAll();
+            {
+                switch( xOperation )
+                {
+                    case FREERTOS_EPOLL_CTL_ADD:
+
+                        if( ( pxSocket->pxEPoll != NULL ) || ( pxSocket->pxSocketSet != NULL ) )
+                        {
+                            xReturn = -pdFREERTOS_ERRNO_EEXIST;
+                        }
+                        else
+                        {
+                            pxSocket->pxEPoll = pxEPoll;
+                            vListInsertEnd( &( pxEPoll->xMemberList ), &( pxSocket->xEPollMemberItem ) );
+                        }
+
+                        break;
+
+                    case FREERTOS_EPOLL_CTL_MOD:
+                    case FREERTOS_EPOLL_CTL_DEL:
+
+                        if( pxSocket->pxEPoll != pxEPoll )
+                        {
+                            xReturn = -pdFREERTOS_ERRNO_ENOENT;
+                        }
+                        else if( xOperation == FREERTOS_EPOLL_CTL_DEL )
+                        {
+                            prvEPollDetach( pxSocket );
+                        }
+                        else
+                        {
+                            /* The new events will be set below. */
+                        }
+
+                        break;
+
+                    default:
+                        xReturn = -pdFREERTOS_ERRNO_EINVAL;
+                        break;
+                }
+
+                if( ( xReturn == 0 ) && ( xOperation != FREERTOS_EPOLL_CTL_DEL ) )
+                {
+                    /* The select bits are used by the IP-task to decide which
+                     * events must be reported. */
+                    pxSocket->xSelectBits = xEvents & ( ( EventBits_t ) eSELECT_READ | ( EventBits_t ) eSELECT_WRITE | ( EventBits_t ) eSELECT_EXCEPT );
+                    pxSocket->pvEPollData = pvData;
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( ( xReturn == 0 ) && ( xOperation != FREERTOS_EPOLL_CTL_DEL ) )
+            {
+                /* The state of the socket belongs to the IP-task. Let it report
+                 * the events that are already active, later events will be
+                 * reported by vSocketEPollReady(). */
+                xCtlEvent.eEventType = eEPollCtlEvent;
+                xCtlEvent.pvData = ( void * ) pxSocket;
+
+                if( xSendEventStructToIPTask( &xCtlEvent, ( TickType_t ) portMAX_DELAY ) == pdFAIL )
+                {
+                    FreeRTOS_printf( ( "FreeRTOS_epoll_ctl: xSendEventStructToIPTask failed\n" ) );
+                }
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Wait until one or more sockets in an epoll set have an event. The
+ *        events are edge-triggered: an event is reported once, and it will
+ *        only be reported again after it has occurred again.
+ *
+ * @param[in] xEPoll The epoll set.
+ * @param[out] pxEvents The array that will receive the events.
+ * @param[in] xMaxEvents The number of elements in pxEvents.
+ * @param[in] xBlockTimeTicks Maximum number of ticks to wait for an event.
+ *
+ * @return The number of events stored in pxEvents, zero on a time-out, or
+ *         -pdFREERTOS_ERRNO_EINVAL.
+ */
+    BaseType_t FreeRTOS_epoll_wait( EPoll_t xEPoll,
+                                    struct freertos_epoll_event * pxEvents,
+                                    BaseType_t xMaxEvents,
+                                    TickType_t xBlockTimeTicks )
+    {
+        SocketEPoll_t * pxEPoll = ( SocketEPoll_t * ) xEPoll;
+        FreeRTOS_Socket_t * pxSocket;
+        TimeOut_t xTimeOut;
+        TickType_t xRemainingTime = xBlockTimeTicks;
+        BaseType_t xCount = 0;
+
+        if( ( pxEPoll == NULL ) || ( pxEvents == NULL ) || ( xMaxEvents <= 0 ) )
+        {
+            xCount = -pdFREERTOS_ERRNO_EINVAL;
+        }
+        else
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            for( ; ; )
+            {
+                /* Clear the bit before looking at the list: a socket that
+                 * becomes ready after this point will set it again. */
+                ( void ) xEventGroupClearBits( pxEPoll->xEPollGroup, socketEPOLL_READY_BIT );
+
+                vTaskSuspendAll();
+                {
+                    while( ( xCount < xMaxEvents ) && ( listCURRENT_LIST_LENGTH( &( pxEPoll->xReadyList ) ) > 0U ) )
+                    {
+                        pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxEPoll->xReadyList ) ) );
+                        ( void ) uxListRemove( &( pxSocket->xEPollListItem ) );
+
+                        pxEvents[ xCount ].xSocket = pxSocket;
+                        pxEvents[ xCount ].xEvents = pxSocket->xEPollEvents;
+                        pxEvents[ xCount ].pvData = pxSocket->pvEPollData;
+                        pxSocket->xEPollEvents = 0U;
+                        xCount++;
+                    }
+                }
+                ( void ) xTaskResumeAll();
+
+                if( xCount > 0 )
+                {
+                    break;
+                }
+
+                /* Has the timeout been reached? */
+                if( xTaskCheckForTimeOut( &xTimeOut, &xRemainingTime ) != pdFALSE )
+                {
+                    break;
+                }
+
+                ( void ) xEventGroupWaitBits( pxEPoll->xEPollGroup, socketEPOLL_READY_BIT, pdFALSE, pdFALSE, xRemainingTime );
+            }
+        }
+
+        return xCount;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task when events have occurred for a socket. If the
+ *        socket belongs to an epoll set that is interested in the events, the
+ *        socket is put in the ready list and a waiting task is woken up.
+ *
+ * @param[in] pxSocket The socket that had an event.
+ * @param[in] xEvents The events, a combination of the eSELECT_ bits.
+ */
+    void vSocketEPollReady( FreeRTOS_Socket_t * pxSocket,
+                            EventBits_t xEvents )
+    {
+        EventBits_t xReadyEvents = xEvents & pxSocket->xSelectBits;
+        SocketEPoll_t * pxEPoll = pxSocket->pxEPoll;
+
+        if( ( pxEPoll != NULL ) && ( xReadyEvents != 0U ) )
+        {
+            vTaskSuspendAll();
+            {
+                prvEPollAddReady( pxSocket, xReadyEvents );
+            }
+            ( void ) xTaskResumeAll();
+
+            ( void ) xEventGroupSetBits( pxEPoll->xEPollGroup, socketEPOLL_READY_BIT );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task after FreeRTOS_epoll_ctl() has added a socket to
+ *        an epoll set or changed its events. The events that are already active
+ *        are reported, vSocketEPollReady() only reports new events.
+ *
+ * @param[in] pxSocket The socket that was added or modified.
+ */
+    void vSocketEPollCtl( FreeRTOS_Socket_t * pxSocket )
+    {
+        EventBits_t xEvents;
+
+        /* The socket may have been removed from its set in the meantime. */
+        if( pxSocket->pxEPoll != NULL )
+        {
+            xEvents = socketSOCKET_IS_BOUND( pxSocket ) ? prvSocketSelectEvaluate( pxSocket ) : 0U;
+            vSocketEPollReady( pxSocket, xEvents );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task when a socket is closed, to remove it from its
+ *        epoll set.
+ *
+ * @param[in] pxSocket The socket that is being closed.
+ */
+    void vSocketEPollRemove( FreeRTOS_Socket_t * pxSocket )
+    {
+        if( pxSocket->pxEPoll != NULL )
+        {
+            vTaskSuspendAll();
+            {
+                prvEPollDetach( pxSocket );
+            }
+            ( void ) xTaskResumeAll();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task to delete an epoll set. All sockets that still
+ *        refer to the set, bound or not, are detached from it.
+ *
+ * @param[in] pxEPoll The epoll set to be deleted.
+ */
+    void vSocketEPollDelete( SocketEPoll_t * pxEPoll )
+    {
+        FreeRTOS_Socket_t * pxSocket;
+
+        vTaskSuspendAll();
+        {
+            while( listCURRENT_LIST_LENGTH( &( pxEPoll->xMemberList ) ) > 0U )
+            {
+                pxSocket = ( ( FreeRTOS_Socket_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxEPoll->xMemberList ) ) );
+                prvEPollDetach( pxSocket );
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        iptraceMEM_STATS_DELETE( pxEPoll );
+        vEventGroupDelete( pxEPoll->xEPollGroup );
+        vPortFree( ( void * ) pxEPoll );
+    }
+
+#endif /* ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) */
+/*-----------------------------------------------------------*/
+
 #if ( ipconfigSUPPORT_SIGNALS != 0 )
 
 /**
@@ -40,6 +40,7 @@
 
 /* FreeRTOS+TCP includes. */
 #include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
 
 
 /**
@@ -423,3 +424,85 @@ size_t uxStreamBufferGet( StreamBuffer_t * const pxBuffer,
     return uxCount;
 }
 /*-----------------------------------------------------------*/
+
+#if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+
+/**
+ * @brief Copy data from the stream buffer, like uxStreamBufferGet() does in
+ *        'peek' mode, and calculate the checksum of the copied data in the
+ *        same pass.  The data stays in the stream buffer.
+ *
+ * @param[in] pxBuffer The buffer from which the data is to be read.
+ * @param[in] uxOffset The offset from the tail at which to start reading.
+ * @param[out] pucData The buffer into which the data is copied.
+ * @param[in] uxMaxCount The maximum number of bytes to be copied.
+ * @param[out] pusChecksum The sum of the copied bytes, in the format of
+ *                          usGenerateChecksum().
+ *
+ * @return The number of bytes copied.
+ */
+    size_t uxStreamBufferGetChecksum( const StreamBuffer_t * const pxBuffer,
+                                      size_t uxOffset,
+                                      uint8_t * const pucData,
+                                      size_t uxMaxCount,
+                                      uint16_t * pusChecksum )
+    {
+        size_t uxCount;
+        uint16_t usSum = 0U;
+
+        /* How much data is available? */
+        size_t uxSize = uxStreamBufferGetSize( pxBuffer );
+
+        if( uxSize > uxOffset )
+        {
+            uxSize -= uxOffset;
+        }
+        else
+        {
+            uxSize = 0U;
+        }
+
+        /* Use the minimum of the wanted bytes and the available bytes. */
+        uxCount = FreeRTOS_min_size_t( uxSize, uxMaxCount );
+
+        if( uxCount != 0U )
+        {
+            const size_t uxLength = pxBuffer->LENGTH;
+            size_t uxNextTail = pxBuffer->uxTail + uxOffset;
+            size_t uxFirst;
+
+            if( uxNextTail >= uxLength )
+            {
+                uxNextTail -= uxLength;
+            }
+
+            uxFirst = FreeRTOS_min_size_t( uxLength - uxNextTail, uxCount );
+            usSum = usGenerateChecksumCopy( 0U, pucData, &( pxBuffer->ucArray[ uxNextTail ] ), uxFirst );
+
+            if( uxCount > uxFirst )
+            {
+                /* The data wraps around to the start of the buffer. */
+                uint16_t usSecond = usGenerateChecksumCopy( 0U, &( pucData[ uxFirst ] ), pxBuffer->ucArray, uxCount - uxFirst );
+                uint32_t ulSum;
+
+                if( ( uxFirst & 1U ) != 0U )
+                {
+                    /* The second part starts at an odd offset, so its bytes
+                     * were summed in the wrong lanes.  Swapping the sum
+                     * corrects that. */
+                    usSecond = ( uint16_t ) ( ( usSecond << 8 ) | ( usSecond >> 8 ) );
+                }
+
+                ulSum = ( uint32_t ) usSum + ( uint32_t ) usSecond;
+                ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+                usSum = ( uint16_t ) ulSum;
+            }
+        }
+
+        *pusChecksum = usSum;
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ipconfigUSE_COPY_CHECKSUM != 0 */
@@ -91,6 +91,34 @@
 
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) )
+
+/**
+ * @brief Called by the IP-task before a frame of a linked receive burst is
+ *        processed.  When the next frame continues the same TCP flow, the
+ *        payload of the current frame will only be stored, and the state
+ *        handling will be done once for the last segment of the run.
+ *
+ * @param[in] pxNetworkBuffer The frame that is about to be processed, the
+ *                            hint will be stored in its 'ucGROFollows' field.
+ * @param[in] pxNextBuffer The next frame in the burst, or NULL.
+ */
+        void vTCPGROPrepare( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                             const NetworkBufferDescriptor_t * pxNextBuffer )
+        {
+            if( xTCPGROIsContinuation( pxNetworkBuffer, pxNextBuffer ) != pdFALSE )
+            {
+                pxNetworkBuffer->ucGROFollows = pdTRUE_UNSIGNED;
+            }
+            else
+            {
+                pxNetworkBuffer->ucGROFollows = pdFALSE_UNSIGNED;
+            }
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) */
+
 
 /** @brief Close the socket another time.
  *
@@ -746,10 +774,23 @@
         /* Function might modify the parameter. */
         NetworkBufferDescriptor_t * pxNetworkBuffer;
         size_t uxIPHeaderOffset;
+        BaseType_t xStored = pdFALSE;
+
+        #if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) )
+            BaseType_t xSegmentFollows;
+        #endif
 
         configASSERT( pxDescriptor != NULL );
         configASSERT( pxDescriptor->pucEthernetBuffer != NULL );
 
+        #if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) )
+        {
+            /* The hint only applies to this frame, consume it. */
+            xSegmentFollows = ( pxDescriptor->ucGROFollows != pdFALSE_UNSIGNED ) ? pdTRUE : pdFALSE;
+            pxDescriptor->ucGROFollows = pdFALSE_UNSIGNED;
+        }
+        #endif
+
         pxNetworkBuffer = pxDescriptor;
         uxIPHeaderOffset = ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer );
 
@@ -933,7 +974,24 @@
                     xResult = prvCheckOptions( pxSocket, pxNetworkBuffer );
                 }
 
-                if( xResult != pdFAIL )
+                #if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) )
+                {
+                    if( ( xResult != pdFAIL ) && ( xSegmentFollows != pdFALSE ) )
+                    {
+                        xStored = xTCPGROStoreSegment( pxSocket, pxNetworkBuffer );
+                    }
+
+                    if( xStored != pdFALSE )
+                    {
+                        /* The payload has been stored.  The next segment of this
+                         * burst will update the window, handle the state and decide
+                         * about the ACK for both. */
+                        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+                    }
+                }
+                #endif /* ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) */
+
+                if( ( xStored == pdFALSE ) && ( xResult != pdFAIL ) )
                 {
                     usWindow = FreeRTOS_ntohs( pxTCPHeader->usWindow );
                     pxSocket->u.xTCP.ulWindowSize = ( uint32_t ) usWindow;
@@ -36,6 +36,7 @@
 /* Standard includes. */
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
@@ -661,4 +662,236 @@
     }
     /*-----------------------------------------------------------*/
 
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) )
+
+/**
+ * @brief Locate the TCP header of a received frame that is a candidate for
+ *        receive coalescing: a plain IPv4 or IPv6 TCP segment without IP or
+ *        TCP options.
+ *
+ * @param[in] pxNetworkBuffer The received frame.
+ * @param[out] ppucAddresses Will point to the source and destination IP-address.
+ * @param[out] puxAddressLength The number of bytes in *ppucAddresses.
+ * @param[out] pulPayloadLength The number of bytes of TCP payload.
+ *
+ * @return The TCP header, or NULL when the frame can not be coalesced.
+ */
+        static const TCPHeader_t * prvGROGetTCPHeader( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                       const uint8_t ** ppucAddresses,
+                                                       size_t * puxAddressLength,
+                                                       uint32_t * pulPayloadLength )
+        {
+            const TCPHeader_t * pxTCPHeader = NULL;
+            const uint8_t * pucEthernetBuffer = pxNetworkBuffer->pucEthernetBuffer;
+            size_t uxIPHeaderLength = 0U;
+            uint32_t ulIPLength = 0U;
+            uint16_t usFrameType = 0U;
+
+            if( pxNetworkBuffer->xDataLength >= sizeof( EthernetHeader_t ) )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                usFrameType = ( ( const EthernetHeader_t * ) pucEthernetBuffer )->usFrameType;
+            }
+
+            switch( usFrameType )
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    case ipIPv4_FRAME_TYPE:
+
+                        /* The IP and TCP headers may only be read when the frame is long enough. */
+                        if( pxNetworkBuffer->xDataLength >= sizeof( TCPPacket_t ) )
+                        {
+                            /* MISRA Ref 11.3.1 [Misaligned access] */
+                            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                            /* coverity[misra_c_2012_rule_11_3_violation] */
+                            const IPHeader_t * pxIPHeader = ( ( const IPHeader_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                            if( ( pxIPHeader->ucVersionHeaderLength == ipIPV4_VERSION_HEADER_LENGTH_MIN ) &&
+                                ( pxIPHeader->ucProtocol == ( uint8_t ) ipPROTOCOL_TCP ) )
+                            {
+                                uxIPHeaderLength = ipSIZE_OF_IPv4_HEADER;
+                                ulIPLength = ( uint32_t ) FreeRTOS_ntohs( pxIPHeader->usLength );
+                                *ppucAddresses = ( const uint8_t * ) &( pxIPHeader->ulSourceIPAddress );
+                                *puxAddressLength = 2U * sizeof( pxIPHeader->ulSourceIPAddress );
+                            }
+                        }
+
+                        break;
+                #endif /* ( ipconfigUSE_IPv4 != 0 ) */
+
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    case ipIPv6_FRAME_TYPE:
+
+                        /* The IP and TCP headers may only be read when the frame is long enough. */
+                        if( pxNetworkBuffer->xDataLength >= sizeof( TCPPacket_IPv6_t ) )
+                        {
+                            /* MISRA Ref 11.3.1 [Misaligned access] */
+                            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                            /* coverity[misra_c_2012_rule_11_3_violation] */
+                            const IPHeader_IPv6_t * pxIPHeader = ( ( const IPHeader_IPv6_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ) );
+
+                            if( pxIPHeader->ucNextHeader == ( uint8_t ) ipPROTOCOL_TCP )
+                            {
+                                uxIPHeaderLength = ipSIZE_OF_IPv6_HEADER;
+                                ulIPLength = ( uint32_t ) FreeRTOS_ntohs( pxIPHeader->usPayloadLength ) + ipSIZE_OF_IPv6_HEADER;
+                                *ppucAddresses = pxIPHeader->xSourceAddress.ucBytes;
+                                *puxAddressLength = 2U * sizeof( pxIPHeader->xSourceAddress );
+                            }
+                        }
+
+                        break;
+                #endif /* ( ipconfigUSE_IPv6 != 0 ) */
+
+                default:
+                    /* Not an IP frame. */
+                    break;
+            }
+
+            if( ( uxIPHeaderLength != 0U ) &&
+                ( pxNetworkBuffer->xDataLength >= ( ipSIZE_OF_ETH_HEADER + uxIPHeaderLength + ipSIZE_OF_TCP_HEADER ) ) &&
+                ( ulIPLength >= ( uint32_t ) ( uxIPHeaderLength + ipSIZE_OF_TCP_HEADER ) ) &&
+                ( ulIPLength <= ( uint32_t ) ( pxNetworkBuffer->xDataLength - ipSIZE_OF_ETH_HEADER ) ) )
+            {
+                /* MISRA Ref 11.3.1 [Misaligned access] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+                /* coverity[misra_c_2012_rule_11_3_violation] */
+                pxTCPHeader = ( ( const TCPHeader_t * ) &( pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderLength ] ) );
+
+                if( ( pxTCPHeader->ucTCPOffset & tcpTCP_OFFSET_LENGTH_BITS ) != tcpTCP_OFFSET_STANDARD_LENGTH )
+                {
+                    /* Segments with TCP options are not coalesced. */
+                    pxTCPHeader = NULL;
+                }
+                else
+                {
+                    *pulPayloadLength = ulIPLength - ( uint32_t ) ( uxIPHeaderLength + ipSIZE_OF_TCP_HEADER );
+                }
+            }
+
+            return pxTCPHeader;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Check whether the next frame of a receive burst continues the TCP
+ *        stream of the current frame: same addresses and ports, and a sequence
+ *        number that starts exactly where the payload of the current frame ends.
+ *        The acknowledgement number and the window must be equal as well, the
+ *        values of an absorbed segment are never looked at.
+ *        Only plain data segments that carry no other flags than ACK and PSH
+ *        may be coalesced.
+ *
+ * @param[in] pxNetworkBuffer The frame that is about to be processed.
+ * @param[in] pxNextBuffer The frame that follows it in the same burst, may be NULL.
+ *
+ * @return pdTRUE when the state handling of pxNetworkBuffer may be left to
+ *         pxNextBuffer, otherwise pdFALSE.
+ */
+        BaseType_t xTCPGROIsContinuation( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                          const NetworkBufferDescriptor_t * pxNextBuffer )
+        {
+            BaseType_t xResult = pdFALSE;
+            const TCPHeader_t * pxTCPHeader;
+            const TCPHeader_t * pxNextTCPHeader;
+            const uint8_t * pucAddresses = NULL;
+            const uint8_t * pucNextAddresses = NULL;
+            size_t uxAddressLength = 0U;
+            size_t uxNextAddressLength = 0U;
+            uint32_t ulPayloadLength = 0U;
+            uint32_t ulNextPayloadLength = 0U;
+
+            if( ( pxNetworkBuffer != NULL ) && ( pxNextBuffer != NULL ) )
+            {
+                pxTCPHeader = prvGROGetTCPHeader( pxNetworkBuffer, &( pucAddresses ), &( uxAddressLength ), &( ulPayloadLength ) );
+                pxNextTCPHeader = prvGROGetTCPHeader( pxNextBuffer, &( pucNextAddresses ), &( uxNextAddressLength ), &( ulNextPayloadLength ) );
+
+                if( ( pxTCPHeader != NULL ) &&
+                    ( pxNextTCPHeader != NULL ) &&
+                    ( ulPayloadLength > 0U ) &&
+                    ( uxAddressLength == uxNextAddressLength ) &&
+                    ( ( pxTCPHeader->ucTCPFlags & ( uint8_t ) ~tcpTCP_FLAG_PSH ) == tcpTCP_FLAG_ACK ) &&
+                    ( pxTCPHeader->usSourcePort == pxNextTCPHeader->usSourcePort ) &&
+                    ( pxTCPHeader->usDestinationPort == pxNextTCPHeader->usDestinationPort ) &&
+                    ( pxTCPHeader->ulAckNr == pxNextTCPHeader->ulAckNr ) &&
+                    ( pxTCPHeader->usWindow == pxNextTCPHeader->usWindow ) &&
+                    ( ( FreeRTOS_ntohl( pxTCPHeader->ulSequenceNumber ) + ulPayloadLength ) == FreeRTOS_ntohl( pxNextTCPHeader->ulSequenceNumber ) ) &&
+                    ( memcmp( pucAddresses, pucNextAddresses, uxAddressLength ) == 0 ) )
+                {
+                    xResult = pdTRUE;
+                }
+            }
+
+            return xResult;
+        }
+        /*-----------------------------------------------------------*/
+
+/**
+ * @brief Store the payload of an in-order segment that is followed by another
+ *        segment of the same flow within the same receive burst.  The state
+ *        handling, the window update and the ACK are left to the last segment
+ *        of the burst.
+ *
+ * @param[in] pxSocket The socket owning the connection.
+ * @param[in] pxNetworkBuffer The received segment.
+ *
+ * @return pdTRUE when the segment has been absorbed and its buffer may be
+ *         released, pdFALSE when the segment must be handled normally.
+ */
+        BaseType_t xTCPGROStoreSegment( FreeRTOS_Socket_t * pxSocket,
+                                        NetworkBufferDescriptor_t * pxNetworkBuffer )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            const ProtocolHeaders_t * pxProtocolHeaders = ( ( const ProtocolHeaders_t * )
+                                                            &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer ) ] ) );
+            uint32_t ulSequenceNumber = FreeRTOS_ntohl( pxProtocolHeaders->xTCPHeader.ulSequenceNumber );
+            TCPWindow_t * pxTCPWindow = &( pxSocket->u.xTCP.xTCPWindow );
+            uint8_t * pucRecvData;
+            uint32_t ulReceiveLength;
+            BaseType_t xResult = pdFALSE;
+
+            /* Only absorb data that is expected next in an established connection.
+             * Anything else, such as retransmissions, out-of-order data or
+             * segments after a FIN, takes the normal path. */
+            if( ( pxSocket->u.xTCP.eTCPState == eESTABLISHED ) &&
+                ( pxSocket->u.xTCP.bits.bFinRecv == pdFALSE_UNSIGNED ) &&
+                ( ulSequenceNumber == pxTCPWindow->rx.ulCurrentSequenceNumber ) )
+            {
+                ulReceiveLength = ( uint32_t ) prvCheckRxData( pxNetworkBuffer, &pucRecvData );
+
+                if( ulReceiveLength > 0U )
+                {
+                    if( ( int32_t ) ( ulSequenceNumber + ulReceiveLength - pxTCPWindow->rx.ulHighestSequenceNumber ) > 0 )
+                    {
+                        pxTCPWindow->rx.ulHighestSequenceNumber = ulSequenceNumber + ulReceiveLength;
+                    }
+
+                    if( prvStoreRxData( pxSocket, pucRecvData, pxNetworkBuffer, ulReceiveLength ) == 0 )
+                    {
+                        /* In case the segment that follows does not make it through
+                         * the checks, make sure that the data stored here will
+                         * still be acknowledged shortly. */
+                        pxSocket->u.xTCP.bits.bWinChange = pdTRUE_UNSIGNED;
+
+                        if( ( pxSocket->u.xTCP.usTimeout == 0U ) ||
+                            ( pxSocket->u.xTCP.usTimeout > ( uint16_t ) tcpDELAYED_ACK_SHORT_DELAY_MS ) )
+                        {
+                            pxSocket->u.xTCP.usTimeout = ( uint16_t ) tcpDELAYED_ACK_SHORT_DELAY_MS;
+                        }
+                    }
+
+                    /* When storing failed, prvStoreRxData() has already sent a RST. */
+                    xResult = pdTRUE;
+                }
+            }
+
+            return xResult;
+        }
+        /*-----------------------------------------------------------*/
+
+    #endif /* ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) */
+
 #endif /* ipconfigUSE_TCP == 1 */
@@ -992,6 +992,12 @@
             {
                 pxNewSocket->pxSocketSet = pxSocket->pxSocketSet;
                 pxNewSocket->xSelectBits = pxSocket->xSelectBits | ( ( EventBits_t ) eSELECT_READ ) | ( ( EventBits_t ) eSELECT_EXCEPT );
+
+                #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+                {
+                    vSocketSelectChanged( pxNewSocket );
+                }
+                #endif
             }
         }
         #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
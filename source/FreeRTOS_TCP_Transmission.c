@@ -882,7 +882,17 @@
 
                     /* Here data is copied from the txStream in 'peek' mode.  Only
                      * when the packets are acked, the tail marker will be updated. */
-                    ulDataGot = ( uint32_t ) uxStreamBufferGet( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lDataLen, pdTRUE );
+                    #if ( ( ipconfigUSE_COPY_CHECKSUM != 0 ) && ( ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) || ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 ) ) )
+                    {
+                        /* Sum the data while copying it, for the TCP checksum. */
+                        ulDataGot = ( uint32_t ) uxStreamBufferGetChecksum( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lDataLen, &( pxNewBuffer->usPayloadChecksum ) );
+                        pxNewBuffer->usPayloadChecksumLength = ( uint16_t ) ulDataGot;
+                    }
+                    #else
+                    {
+                        ulDataGot = ( uint32_t ) uxStreamBufferGet( pxSocket->u.xTCP.txStream, uxOffset, pucSendData, ( size_t ) lDataLen, pdTRUE );
+                    }
+                    #endif
 
                     #if ( ipconfigHAS_DEBUG_PRINTF != 0 )
                     {
@@ -214,7 +214,11 @@ void prvTCPReturnPacket_IPV4( FreeRTOS_Socket_t * pxSocket,
                 pxIPHeader->usHeaderChecksum = ( uint16_t ) ~FreeRTOS_htons( pxIPHeader->usHeaderChecksum );
 
                 /* calculate the TCP checksum for an outgoing packet. */
-                ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxTCPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+                    ( void ) usGenerateProtocolChecksumCopied( pxNetworkBuffer, ( uint8_t * ) pxTCPPacket, pxNetworkBuffer->xDataLength );
+                #else
+                    ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxTCPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                #endif
             }
             #endif /* if ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) */
 
@@ -286,6 +290,13 @@ void prvTCPReturnPacket_IPV4( FreeRTOS_Socket_t * pxSocket,
             configASSERT( pxNetworkBuffer->pxEndPoint->pxNetworkInterface->pfOutput != NULL );
 
             pxInterface = pxNetworkBuffer->pxEndPoint->pxNetworkInterface;
+
+            #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            {
+                vPrepareTxChecksums( pxInterface, pxNetworkBuffer );
+            }
+            #endif
+
             ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, xDoRelease );
 
             if( xDoRelease == pdFALSE )
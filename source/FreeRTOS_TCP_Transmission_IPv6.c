@@ -215,7 +215,11 @@ void prvTCPReturnPacket_IPV6( FreeRTOS_Socket_t * pxSocket,
             {
                 /* calculate the TCP checksum for an outgoing packet. */
                 uint32_t ulTotalLength = ulLen + ipSIZE_OF_ETH_HEADER;
-                ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxNetworkBuffer->pucEthernetBuffer, ulTotalLength, pdTRUE );
+                #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+                    ( void ) usGenerateProtocolChecksumCopied( pxNetworkBuffer, ( uint8_t * ) pxNetworkBuffer->pucEthernetBuffer, ulTotalLength );
+                #else
+                    ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxNetworkBuffer->pucEthernetBuffer, ulTotalLength, pdTRUE );
+                #endif
             }
             #endif /* ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 */
 
@@ -280,6 +284,13 @@ void prvTCPReturnPacket_IPV6( FreeRTOS_Socket_t * pxSocket,
             configASSERT( pxNetworkBuffer->pxEndPoint->pxNetworkInterface->pfOutput != NULL );
 
             pxInterface = pxNetworkBuffer->pxEndPoint->pxNetworkInterface;
+
+            #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            {
+                vPrepareTxChecksums( pxInterface, pxNetworkBuffer );
+            }
+            #endif
+
             ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, xDoRelease );
 
             if( xDoRelease == pdFALSE )
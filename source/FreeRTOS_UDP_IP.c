@@ -97,6 +97,123 @@ void vProcessGeneratedUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuff
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) )
+
+/**
+ * @brief Check if a UDP packet may be sent through the given end-point by a
+ *        task other than the IP-task.
+ *
+ * @param[in] pxEndPoint The end-point through which the packet will be sent.
+ *
+ * @return pdTRUE when the end-point is up, and its interface has declared
+ *         that its output function may be called from any task.
+ */
+    BaseType_t xUDPDirectSendAllowed( const struct xNetworkEndPoint * pxEndPoint )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pxEndPoint != NULL ) &&
+            ( pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED ) &&
+            ( pxEndPoint->pxNetworkInterface != NULL ) )
+        {
+            const NetworkInterface_t * pxInterface = pxEndPoint->pxNetworkInterface;
+
+            if( ( pxInterface->bits.bInterfaceUp != pdFALSE_UNSIGNED ) &&
+                ( pxInterface->bits.bThreadSafeOutput != pdFALSE_UNSIGNED ) &&
+                ( pxInterface->pfOutput != NULL ) )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Try to send a UDP packet directly from the calling task. When the
+ *        address can not be resolved from the cache, or when the interface
+ *        does not allow it, the packet is left untouched.
+ *
+ *        The ARP and ND caches are read while the scheduler is suspended.
+ *        That only keeps the IP-task away on a single core, so a kernel with
+ *        more than one core always passes the packet to the IP-task.
+ *
+ * @param[in] pxNetworkBuffer The network buffer carrying the packet.
+ *
+ * @return pdTRUE when the packet has been sent, pdFALSE when it must be
+ *         passed to the IP-task.
+ */
+    BaseType_t xSendGeneratedUDPPacketDirect( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        BaseType_t xReturn = pdFALSE;
+        const UDPPacket_t * pxUDPPacket;
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        pxUDPPacket = ( ( UDPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+
+        #if ( defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 ) )
+        {
+            /* Another core might be running the IP-task. */
+            ( void ) pxUDPPacket;
+        }
+        #else
+        {
+            switch( pxUDPPacket->xEthernetHeader.usFrameType )
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    case ipIPv4_FRAME_TYPE:
+                        xReturn = xSendGeneratedUDPPacketDirect_IPv4( pxNetworkBuffer );
+                        break;
+                #endif
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    case ipIPv6_FRAME_TYPE:
+                        xReturn = xSendGeneratedUDPPacketDirect_IPv6( pxNetworkBuffer );
+                        break;
+                #endif
+                default:
+                    /* Let the IP-task handle it. */
+                    break;
+            }
+        }
+        #endif /* if ( defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 ) ) */
+
+        return xReturn;
+    }
+
+#endif /* ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) )
+
+/**
+ * @brief Process a chain of UDP packets that was passed to the IP-task by
+ *        FreeRTOS_sendmmsg(). The packets are linked through 'pxNextBuffer'.
+ *
+ * @param[in] pxNetworkBuffer The first network buffer of the chain.
+ */
+    void vProcessGeneratedUDPPacketBatch( NetworkBufferDescriptor_t * pxNetworkBuffer )
+    {
+        NetworkBufferDescriptor_t * pxBuffer = pxNetworkBuffer;
+        NetworkBufferDescriptor_t * pxNextBuffer;
+
+        while( pxBuffer != NULL )
+        {
+            pxNextBuffer = pxBuffer->pxNextBuffer;
+
+            /* The buffer may be stored while waiting for address resolution,
+             * so it should not keep a reference to the rest of the batch. */
+            pxBuffer->pxNextBuffer = NULL;
+            vProcessGeneratedUDPPacket( pxBuffer );
+            pxBuffer = pxNextBuffer;
+        }
+    }
+
+#endif /* ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Process the received UDP packet.
  *
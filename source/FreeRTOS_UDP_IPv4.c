@@ -66,6 +66,27 @@
 
 /*-----------------------------------------------------------*/
 
+static BaseType_t prvProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     BaseType_t xDirectSend );
+
+static BaseType_t prvDeliverUDPPacket_IPv4( FreeRTOS_Socket_t * pxSocket,
+                                            NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                            uint16_t usPort );
+
+#if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+    static BaseType_t prvHoldForResolution_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                 uint32_t ulNextHop,
+                                                 BaseType_t xSendRequest );
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+    static void prvFanOutUDPPacket_IPv4( const FreeRTOS_Socket_t * pxSocket,
+                                         NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                         uint16_t usPort );
+#endif
+
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Process the generated UDP packet and do other checks before sending the
  *        packet such as ARP cache check and address resolution.
@@ -73,10 +94,100 @@
  * @param[in] pxNetworkBuffer The network buffer carrying the packet.
  */
 void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+{
+    ( void ) prvProcessGeneratedUDPPacket_IPv4( pxNetworkBuffer, pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) )
+
+/**
+ * @brief Send a UDP packet from the calling task, without involving the IP-task.
+ *        This only happens when the MAC-address of the target is found in the
+ *        ARP cache, and when the interface allows direct sending.  Like all
+ *        UDP packets, it gets an IP identification of zero, so the counter
+ *        'usPacketIdentifier', which is owned by the IP-task, is not used.
+ *
+ * @param[in] pxNetworkBuffer The network buffer carrying the packet.
+ *
+ * @return pdTRUE when the packet was passed to the network interface ( or
+ *         dropped ). pdFALSE when the packet must be handled by the IP-task.
+ */
+    BaseType_t xSendGeneratedUDPPacketDirect_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        return prvProcessGeneratedUDPPacket_IPv4( pxNetworkBuffer, pdTRUE );
+    }
+
+#endif /* ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) */
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+
+/**
+ * @brief Keep a generated packet on the list of packets that are waiting for an
+ *        address resolution. It will be passed to the IP-task again when the
+ *        ARP reply for the next hop arrives, or released when the reply does
+ *        not come in time.
+ *
+ * @param[in] pxNetworkBuffer The network buffer carrying the packet, it is not
+ *                            changed.
+ * @param[in] ulNextHop The address that is being resolved: the destination, or
+ *                      a gateway.
+ * @param[in] xSendRequest pdTRUE when an ARP request must be sent for ulNextHop.
+ *
+ * @return pdTRUE when the packet is stored, pdFALSE when the caller still owns
+ *         the buffer.
+ */
+    static BaseType_t prvHoldForResolution_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                 uint32_t ulNextHop,
+                                                 BaseType_t xSendRequest )
+    {
+        BaseType_t xReturn = pdFALSE;
+        NetworkEndPoint_t * pxNextHopEndPoint = FreeRTOS_FindEndPointOnNetMask( ulNextHop );
+        IP_Address_t xNextHop;
+
+        if( pxNextHopEndPoint != NULL )
+        {
+            ( void ) memset( &( xNextHop ), 0, sizeof( xNextHop ) );
+            xNextHop.ulIP_IPv4 = ulNextHop;
+
+            if( xPendingResolutionAddOutgoing( pxNetworkBuffer, &( xNextHop ), pdFALSE ) == pdPASS )
+            {
+                if( xSendRequest != pdFALSE )
+                {
+                    FreeRTOS_OutputARPRequest_Multi( pxNextHopEndPoint, ulNextHop );
+                }
+
+                iptraceDELAYED_ARP_REQUEST_STARTED();
+                xReturn = pdTRUE;
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* ipconfigPENDING_RESOLUTION_ADDRESSES > 0 */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Process the generated UDP packet and do other checks before sending the
+ *        packet such as ARP cache check and address resolution.
+ *
+ * @param[in] pxNetworkBuffer The network buffer carrying the packet.
+ * @param[in] xDirectSend pdTRUE when called from a user task through
+ *                         xSendGeneratedUDPPacketDirect_IPv4().
+ *
+ * @return pdFALSE when xDirectSend is set and the packet was left untouched,
+ *         so it must be passed to the IP-task. Otherwise pdTRUE.
+ */
+static BaseType_t prvProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     BaseType_t xDirectSend )
 {
     UDPPacket_t * pxUDPPacket;
     IPHeader_t * pxIPHeader;
-    eResolutionLookupResult_t eReturned;
+    eResolutionLookupResult_t eReturned = eResolutionFailed;
+    BaseType_t xReturn = pdTRUE;
+    BaseType_t xHeld = pdFALSE;
     uint32_t ulIPAddress = pxNetworkBuffer->xIPAddress.ulIP_IPv4;
     NetworkEndPoint_t * pxEndPoint = pxNetworkBuffer->pxEndPoint;
     size_t uxPayloadSize;
@@ -102,10 +213,47 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
         uxPayloadSize = pxNetworkBuffer->xDataLength - sizeof( UDPPacket_t );
     }
 
-    /* Determine the ARP cache status for the requested IP address. */
-    eReturned = eARPGetCacheEntry( &( ulIPAddress ), &( pxUDPPacket->xEthernetHeader.xDestinationAddress ), &( pxEndPoint ) );
+    /* Determine the ARP cache status for the requested IP address.
+     * xDirectSend can only be set when ipconfigUDP_DIRECT_SEND is enabled. */
+    #if ( ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) )
+    {
+        if( xDirectSend != pdFALSE )
+        {
+            const NetworkEndPoint_t * pxSendEndPoint;
 
-    if( pxNetworkBuffer->pxEndPoint == NULL )
+            /* The ARP cache is maintained by the IP-task. Make sure that it
+             * does not change while it is being read by this task. */
+            vTaskSuspendAll();
+            {
+                eReturned = eARPGetCacheEntry( &( ulIPAddress ), &( pxUDPPacket->xEthernetHeader.xDestinationAddress ), &( pxEndPoint ) );
+            }
+            ( void ) xTaskResumeAll();
+
+            pxSendEndPoint = pxNetworkBuffer->pxEndPoint;
+
+            if( pxSendEndPoint == NULL )
+            {
+                pxSendEndPoint = pxEndPoint;
+            }
+
+            if( ( eReturned != eResolutionCacheHit ) || ( xUDPDirectSendAllowed( pxSendEndPoint ) == pdFALSE ) )
+            {
+                /* Sending an ARP request or waiting for the reply is left to the IP-task.
+                 * The end-point of the buffer is not changed, the IP-task will look it
+                 * up again. */
+                eReturned = eResolutionFailed;
+                xReturn = pdFALSE;
+            }
+        }
+    }
+    #endif /* ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) */
+
+    if( xDirectSend == pdFALSE )
+    {
+        eReturned = eARPGetCacheEntry( &( ulIPAddress ), &( pxUDPPacket->xEthernetHeader.xDestinationAddress ), &( pxEndPoint ) );
+    }
+
+    if( ( xReturn != pdFALSE ) && ( pxNetworkBuffer->pxEndPoint == NULL ) )
     {
         pxNetworkBuffer->pxEndPoint = pxEndPoint;
     }
@@ -252,7 +400,11 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
 
                 if( ( ucSocketOptions & ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) != 0U )
                 {
-                    ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxUDPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                    #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+                        ( void ) usGenerateProtocolChecksumCopied( pxNetworkBuffer, ( uint8_t * ) pxUDPPacket, pxNetworkBuffer->xDataLength );
+                    #else
+                        ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxUDPPacket, pxNetworkBuffer->xDataLength, pdTRUE );
+                    #endif
                 }
                 else
                 {
@@ -268,21 +420,35 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
              * outstanding, and perform retransmissions if necessary. */
             vARPRefreshCacheEntry( NULL, ulIPAddress, NULL );
 
-            /* Generate an ARP for the required IP address. */
-            iptracePACKET_DROPPED_TO_GENERATE_ARP( pxNetworkBuffer->xIPAddress.ulIP_IPv4 );
-
-            /* 'ulIPAddress' might have become the address of the Gateway.
-             * Find the route again. */
-            pxNetworkBuffer->pxEndPoint = FreeRTOS_FindEndPointOnNetMask( ulIPAddress );
+            #if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+            {
+                xHeld = prvHoldForResolution_IPv4( pxNetworkBuffer, ulIPAddress, pdTRUE );
+            }
+            #endif
 
-            if( pxNetworkBuffer->pxEndPoint == NULL )
+            if( xHeld != pdFALSE )
             {
+                /* The packet will be sent when the ARP reply arrives. */
                 eReturned = eResolutionFailed;
             }
             else
             {
-                pxNetworkBuffer->xIPAddress.ulIP_IPv4 = ulIPAddress;
-                vARPGenerateRequestPacket( pxNetworkBuffer );
+                /* Generate an ARP for the required IP address. */
+                iptracePACKET_DROPPED_TO_GENERATE_ARP( pxNetworkBuffer->xIPAddress.ulIP_IPv4 );
+
+                /* 'ulIPAddress' might have become the address of the Gateway.
+                 * Find the route again. */
+                pxNetworkBuffer->pxEndPoint = FreeRTOS_FindEndPointOnNetMask( ulIPAddress );
+
+                if( pxNetworkBuffer->pxEndPoint == NULL )
+                {
+                    eReturned = eResolutionFailed;
+                }
+                else
+                {
+                    pxNetworkBuffer->xIPAddress.ulIP_IPv4 = ulIPAddress;
+                    vARPGenerateRequestPacket( pxNetworkBuffer );
+                }
             }
         }
         else
@@ -326,6 +492,12 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
 
             if( ( pxInterface != NULL ) && ( pxInterface->pfOutput != NULL ) )
             {
+                #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+                {
+                    vPrepareTxChecksums( pxInterface, pxNetworkBuffer );
+                }
+                #endif
+
                 ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, pdTRUE );
             }
         }
@@ -335,15 +507,214 @@ void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetwor
             vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
         }
     }
+    else if( xHeld != pdFALSE )
+    {
+        /* The packet is waiting for the resolution of its next hop. */
+    }
+    else if( xReturn != pdFALSE )
+    {
+        #if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+        {
+            /* When an ARP request for the next hop is outstanding, the packet
+             * can wait for the reply. */
+            xHeld = prvHoldForResolution_IPv4( pxNetworkBuffer, ulIPAddress, pdFALSE );
+        }
+        #endif
+
+        if( xHeld == pdFALSE )
+        {
+            /* The packet can't be sent (DHCP not completed?).  Just drop the
+             * packet. */
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+    }
     else
     {
-        /* The packet can't be sent (DHCP not completed?).  Just drop the
-         * packet. */
-        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        /* The caller will pass the packet to the IP-task. */
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Pass a received UDP packet to a socket: call its reception handler,
+ *        or add the packet to its list of waiting packets and wake up the
+ *        user of the socket.
+ *
+ * @param[in] pxSocket The socket that is bound to the destination port.
+ * @param[in] pxNetworkBuffer The network buffer carrying the UDP packet.
+ * @param[in] usPort The port number on which this packet was received.
+ *
+ * @return pdPASS when the packet was queued, pdFAIL when the caller must
+ *         release the network buffer.
+ */
+static BaseType_t prvDeliverUDPPacket_IPv4( FreeRTOS_Socket_t * pxSocket,
+                                            NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                            uint16_t usPort )
+{
+    BaseType_t xReturn = pdPASS;
+
+    #if ( ipconfigUSE_CALLBACKS == 1 )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const UDPPacket_t * pxUDPPacket = ( ( const UDPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer );
+        /* Did the owner of this socket register a reception handler ? */
+        if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xUDP.pxHandleReceive ) )
+        {
+            struct freertos_sockaddr xSourceAddress, destinationAddress;
+            void * pcData = &( pxNetworkBuffer->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET_IPv4 ] );
+            FOnUDPReceive_t xHandler = ( FOnUDPReceive_t ) pxSocket->u.xUDP.pxHandleReceive;
+
+            xSourceAddress.sin_port = pxNetworkBuffer->usPort;
+            xSourceAddress.sin_address.ulIP_IPv4 = pxNetworkBuffer->xIPAddress.ulIP_IPv4;
+            xSourceAddress.sin_family = ( uint8_t ) FREERTOS_AF_INET4;
+            xSourceAddress.sin_len = ( uint8_t ) sizeof( xSourceAddress );
+            destinationAddress.sin_port = usPort;
+            destinationAddress.sin_address.ulIP_IPv4 = pxUDPPacket->xIPHeader.ulDestinationIPAddress;
+            destinationAddress.sin_family = ( uint8_t ) FREERTOS_AF_INET4;
+            destinationAddress.sin_len = ( uint8_t ) sizeof( destinationAddress );
+
+            /* The value of 'xDataLength' was proven to be at least the size of a UDP packet in prvProcessIPPacket(). */
+            if( xHandler( ( Socket_t ) pxSocket,
+                          ( void * ) pcData,
+                          ( size_t ) ( pxNetworkBuffer->xDataLength - ipUDP_PAYLOAD_OFFSET_IPv4 ),
+                          &( xSourceAddress ),
+                          &( destinationAddress ) ) != 0 )
+            {
+                xReturn = pdFAIL; /* xHandler has consumed the data, do not add it to .xWaitingPacketsList'. */
+            }
+        }
+    }
+    #endif /* ipconfigUSE_CALLBACKS */
+
+    #if ( ipconfigUDP_MAX_RX_PACKETS > 0U )
+    {
+        if( xReturn == pdPASS )
+        {
+            if( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) >= pxSocket->u.xUDP.uxMaxPackets )
+            {
+                FreeRTOS_debug_printf( ( "xProcessReceivedUDPPacket: buffer full %ld >= %ld port %u\n",
+                                         listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ),
+                                         pxSocket->u.xUDP.uxMaxPackets, pxSocket->usLocalPort ) );
+                xReturn = pdFAIL; /* we did not consume or release the buffer */
+            }
+        }
+    }
+    #endif /* if ( ipconfigUDP_MAX_RX_PACKETS > 0U ) */
+
+    #if ( ipconfigUSE_CALLBACKS == 1 ) || ( ipconfigUDP_MAX_RX_PACKETS > 0U )
+        if( xReturn == pdPASS ) /*lint !e774: Boolean within 'if' always evaluates to True, depending on configuration. [MISRA 2012 Rule 14.3, required. */
+    #else
+        /* xReturn is still pdPASS. */
+    #endif
+    {
+        vTaskSuspendAll();
+        {
+            /* Add the network packet to the list of packets to be
+             * processed by the socket. */
+            vListInsertEnd( &( pxSocket->u.xUDP.xWaitingPacketsList ), &( pxNetworkBuffer->xBufferListItem ) );
+        }
+        ( void ) xTaskResumeAll();
+
+        /* Set the socket's receive event */
+        if( pxSocket->xEventGroup != NULL )
+        {
+            ( void ) xEventGroupSetBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_RECEIVE );
+        }
+
+        #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+        {
+            if( ( pxSocket->pxSocketSet != NULL ) && ( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_READ ) ) != 0U ) )
+            {
+                ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_READ );
+            }
+
+            #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+            {
+                vSocketSelectChanged( pxSocket );
+            }
+            #endif
+        }
+        #endif
+
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+        {
+            vSocketEPollReady( pxSocket, ( EventBits_t ) eSELECT_READ );
+        }
+        #endif
+
+        #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
+        {
+            if( pxSocket->pxUserSemaphore != NULL )
+            {
+                ( void ) xSemaphoreGive( pxSocket->pxUserSemaphore );
+            }
+        }
+        #endif
+
+        #if ( ipconfigUSE_DHCP == 1 )
+        {
+            if( xIsDHCPSocket( pxSocket ) != 0 )
+            {
+                ( void ) xSendDHCPEvent( pxNetworkBuffer->pxEndPoint );
+            }
+        }
+        #endif
+
+        #if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+        {
+            if( xIsDNSResolverSocket( pxSocket ) != pdFALSE )
+            {
+                ( void ) xSendDNSResolverEvent( NULL );
+            }
+        }
+        #endif
     }
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+
+/**
+ * @brief Pass a received packet to the other sockets that are bound to the
+ *        same port as pxSocket.  Each socket gets a descriptor that shares
+ *        the Ethernet buffer of the packet, the payload is not copied.
+ *
+ * @param[in] pxSocket The first socket that is bound to the destination port.
+ * @param[in] pxNetworkBuffer The network buffer carrying the UDP packet.
+ * @param[in] usPort The port number on which this packet was received.
+ */
+    static void prvFanOutUDPPacket_IPv4( const FreeRTOS_Socket_t * pxSocket,
+                                         NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                         uint16_t usPort )
+    {
+        FreeRTOS_Socket_t * pxNext;
+
+        for( pxNext = pxUDPSocketLookupNext( pxSocket ); pxNext != NULL; pxNext = pxUDPSocketLookupNext( pxNext ) )
+        {
+            NetworkBufferDescriptor_t * pxSharedBuffer = pxShareNetworkBufferWithDescriptor( pxNetworkBuffer );
+
+            if( pxSharedBuffer == NULL )
+            {
+                /* Out of descriptors, the remaining sockets will miss this packet. */
+                break;
+            }
+
+            if( prvDeliverUDPPacket_IPv4( pxNext, pxSharedBuffer, usPort ) != pdPASS )
+            {
+                vReleaseNetworkBufferAndDescriptor( pxSharedBuffer );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) ) */
+
 /**
  * @brief Process the received UDP packet.
  *
@@ -406,99 +777,21 @@ BaseType_t xProcessReceivedUDPPacket_IPv4( NetworkBufferDescriptor_t * pxNetwork
                  * is not possible. */
             }
 
-            #if ( ipconfigUSE_CALLBACKS == 1 )
+            #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
             {
-                /* Did the owner of this socket register a reception handler ? */
-                if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xUDP.pxHandleReceive ) )
+                /* A multicast or broadcast packet is passed to all sockets
+                 * that share the port, before the first socket may consume it. */
+                if( ( pxSocket->u.xUDP.ucReuseAddress != 0U ) &&
+                    ( ( xIsIPv4Multicast( pxUDPPacket->xIPHeader.ulDestinationIPAddress ) != pdFALSE ) ||
+                      ( pxUDPPacket->xIPHeader.ulDestinationIPAddress == FREERTOS_INADDR_BROADCAST ) ||
+                      ( ( pxEndpoint != NULL ) && ( pxUDPPacket->xIPHeader.ulDestinationIPAddress == pxEndpoint->ipv4_settings.ulBroadcastAddress ) ) ) )
                 {
-                    struct freertos_sockaddr xSourceAddress, destinationAddress;
-                    void * pcData = &( pxNetworkBuffer->pucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET_IPv4 ] );
-                    FOnUDPReceive_t xHandler = ( FOnUDPReceive_t ) pxSocket->u.xUDP.pxHandleReceive;
-
-                    xSourceAddress.sin_port = pxNetworkBuffer->usPort;
-                    xSourceAddress.sin_address.ulIP_IPv4 = pxNetworkBuffer->xIPAddress.ulIP_IPv4;
-                    xSourceAddress.sin_family = ( uint8_t ) FREERTOS_AF_INET4;
-                    xSourceAddress.sin_len = ( uint8_t ) sizeof( xSourceAddress );
-                    destinationAddress.sin_port = usPort;
-                    destinationAddress.sin_address.ulIP_IPv4 = pxUDPPacket->xIPHeader.ulDestinationIPAddress;
-                    destinationAddress.sin_family = ( uint8_t ) FREERTOS_AF_INET4;
-                    destinationAddress.sin_len = ( uint8_t ) sizeof( destinationAddress );
-
-                    /* The value of 'xDataLength' was proven to be at least the size of a UDP packet in prvProcessIPPacket(). */
-                    if( xHandler( ( Socket_t ) pxSocket,
-                                  ( void * ) pcData,
-                                  ( size_t ) ( pxNetworkBuffer->xDataLength - ipUDP_PAYLOAD_OFFSET_IPv4 ),
-                                  &( xSourceAddress ),
-                                  &( destinationAddress ) ) != 0 )
-                    {
-                        xReturn = pdFAIL; /* xHandler has consumed the data, do not add it to .xWaitingPacketsList'. */
-                    }
-                }
-            }
-            #endif /* ipconfigUSE_CALLBACKS */
-
-            #if ( ipconfigUDP_MAX_RX_PACKETS > 0U )
-            {
-                if( xReturn == pdPASS )
-                {
-                    if( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) >= pxSocket->u.xUDP.uxMaxPackets )
-                    {
-                        FreeRTOS_debug_printf( ( "xProcessReceivedUDPPacket: buffer full %ld >= %ld port %u\n",
-                                                 listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ),
-                                                 pxSocket->u.xUDP.uxMaxPackets, pxSocket->usLocalPort ) );
-                        xReturn = pdFAIL; /* we did not consume or release the buffer */
-                    }
+                    prvFanOutUDPPacket_IPv4( pxSocket, pxNetworkBuffer, usPort );
                 }
             }
-            #endif /* if ( ipconfigUDP_MAX_RX_PACKETS > 0U ) */
-
-            #if ( ipconfigUSE_CALLBACKS == 1 ) || ( ipconfigUDP_MAX_RX_PACKETS > 0U )
-                if( xReturn == pdPASS ) /*lint !e774: Boolean within 'if' always evaluates to True, depending on configuration. [MISRA 2012 Rule 14.3, required. */
-            #else
-                /* xReturn is still pdPASS. */
             #endif
-            {
-                vTaskSuspendAll();
-                {
-                    /* Add the network packet to the list of packets to be
-                     * processed by the socket. */
-                    vListInsertEnd( &( pxSocket->u.xUDP.xWaitingPacketsList ), &( pxNetworkBuffer->xBufferListItem ) );
-                }
-                ( void ) xTaskResumeAll();
-
-                /* Set the socket's receive event */
-                if( pxSocket->xEventGroup != NULL )
-                {
-                    ( void ) xEventGroupSetBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_RECEIVE );
-                }
-
-                #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-                {
-                    if( ( pxSocket->pxSocketSet != NULL ) && ( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_READ ) ) != 0U ) )
-                    {
-                        ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_READ );
-                    }
-                }
-                #endif
-
-                #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
-                {
-                    if( pxSocket->pxUserSemaphore != NULL )
-                    {
-                        ( void ) xSemaphoreGive( pxSocket->pxUserSemaphore );
-                    }
-                }
-                #endif
 
-                #if ( ipconfigUSE_DHCP == 1 )
-                {
-                    if( xIsDHCPSocket( pxSocket ) != 0 )
-                    {
-                        ( void ) xSendDHCPEvent( pxNetworkBuffer->pxEndPoint );
-                    }
-                }
-                #endif
-            }
+            xReturn = prvDeliverUDPPacket_IPv4( pxSocket, pxNetworkBuffer, usPort );
         }
         else
         {
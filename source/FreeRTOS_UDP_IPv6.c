@@ -72,6 +72,25 @@
 static NetworkEndPoint_t * pxGetEndpoint( BaseType_t xIPType,
                                           BaseType_t xIsGlobal );
 
+static BaseType_t prvProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     BaseType_t xDirectSend );
+
+static BaseType_t prvDeliverUDPPacket_IPv6( FreeRTOS_Socket_t * pxSocket,
+                                            NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                            uint16_t usPort );
+
+#if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+    static BaseType_t prvHoldForResolution_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                 const IPv6_Address_t * pxDestination,
+                                                 BaseType_t xSendRequest );
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+    static void prvFanOutUDPPacket_IPv6( const FreeRTOS_Socket_t * pxSocket,
+                                         NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                         uint16_t usPort );
+#endif
+
 /**
  * @brief Get the first end point of the type (IPv4/IPv6) from the list
  *        the list of end points.
@@ -151,6 +170,81 @@ static eResolutionLookupResult_t prvStartLookup( NetworkBufferDescriptor_t * con
 }
 /*-----------------------------------------------------------*/
 
+#if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+
+/**
+ * @brief Keep a generated UDP or ICMPv6 packet on the list of packets that are
+ *        waiting for an address resolution. It will be passed to the IP-task
+ *        again when the neighbour advertisement for the next hop arrives, or
+ *        released when the advertisement does not come in time.
+ *
+ * @param[in] pxNetworkBuffer The network buffer carrying the packet. Its field
+ *                            'xIPAddress' holds the next hop: the destination,
+ *                            or a gateway.
+ * @param[in] pxDestination The original destination of the packet. It is put
+ *                          back in 'xIPAddress' when the packet is stored, so
+ *                          that the next hop is looked up again later.
+ * @param[in] xSendRequest pdTRUE when a neighbour solicitation must be sent for
+ *                         the next hop.
+ *
+ * @return pdTRUE when the packet is stored, pdFALSE when the caller still owns
+ *         the buffer.
+ */
+    static BaseType_t prvHoldForResolution_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                 const IPv6_Address_t * pxDestination,
+                                                 BaseType_t xSendRequest )
+    {
+        BaseType_t xReturn = pdFALSE;
+        NetworkEndPoint_t * pxNextHopEndPoint = pxNetworkBuffer->pxEndPoint;
+        NetworkBufferDescriptor_t * pxSolicitation;
+        IP_Address_t xNextHop;
+
+        if( pxNextHopEndPoint == NULL )
+        {
+            IPv6_Type_t eTargetType = xIPv6_GetIPType( &( pxNetworkBuffer->xIPAddress.xIP_IPv6 ) );
+            BaseType_t xIsGlobal = ( eTargetType == eIPv6_Global ) ? pdTRUE : pdFALSE;
+            pxNextHopEndPoint = pxGetEndpoint( ( BaseType_t ) ipTYPE_IPv6, xIsGlobal );
+        }
+
+        if( pxNextHopEndPoint != NULL )
+        {
+            ( void ) memset( &( xNextHop ), 0, sizeof( xNextHop ) );
+            ( void ) memcpy( xNextHop.xIP_IPv6.ucBytes, pxNetworkBuffer->xIPAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+            /* The address might have been replaced with the address of the gateway. */
+            ( void ) memcpy( pxNetworkBuffer->xIPAddress.xIP_IPv6.ucBytes, pxDestination->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+            if( xPendingResolutionAddOutgoing( pxNetworkBuffer, &( xNextHop ), pdTRUE ) == pdPASS )
+            {
+                if( xSendRequest != pdFALSE )
+                {
+                    /* The packet is kept, so the solicitation needs a buffer of its own. */
+                    pxSolicitation = pxGetNetworkBufferWithDescriptor( sizeof( ICMPPacket_IPv6_t ), 0U );
+
+                    if( pxSolicitation != NULL )
+                    {
+                        pxSolicitation->pxEndPoint = pxNextHopEndPoint;
+                        pxSolicitation->pxInterface = pxNextHopEndPoint->pxNetworkInterface;
+                        vNDSendNeighbourSolicitation( pxSolicitation, &( xNextHop.xIP_IPv6 ) );
+                    }
+                }
+
+                iptraceDELAYED_ND_REQUEST_STARTED();
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                /* Leave the packet as it was. */
+                ( void ) memcpy( pxNetworkBuffer->xIPAddress.xIP_IPv6.ucBytes, xNextHop.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* ipconfigPENDING_RESOLUTION_ADDRESSES > 0 */
+/*-----------------------------------------------------------*/
+
 /**
  * @brief Process the generated UDP packet and do other checks before sending the
  *        packet such as ND cache check and address resolution.
@@ -158,15 +252,55 @@ static eResolutionLookupResult_t prvStartLookup( NetworkBufferDescriptor_t * con
  * @param[in] pxNetworkBuffer The network buffer carrying the packet.
  */
 void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+{
+    ( void ) prvProcessGeneratedUDPPacket_IPv6( pxNetworkBuffer, pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) )
+
+/**
+ * @brief Send a UDP packet from the calling task, without involving the IP-task.
+ *        This only happens when the MAC-address of the target is found in the
+ *        ND cache, and when the interface allows direct sending.
+ *
+ * @param[in] pxNetworkBuffer The network buffer carrying the packet.
+ *
+ * @return pdTRUE when the packet was passed to the network interface ( or
+ *         dropped ). pdFALSE when the packet must be handled by the IP-task.
+ */
+    BaseType_t xSendGeneratedUDPPacketDirect_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer )
+    {
+        return prvProcessGeneratedUDPPacket_IPv6( pxNetworkBuffer, pdTRUE );
+    }
+
+#endif /* ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Process the generated UDP packet and do other checks before sending the
+ *        packet such as ND cache check and address resolution.
+ *
+ * @param[in] pxNetworkBuffer The network buffer carrying the packet.
+ * @param[in] xDirectSend pdTRUE when called from a user task through
+ *                         xSendGeneratedUDPPacketDirect_IPv6().
+ *
+ * @return pdFALSE when xDirectSend is set and the packet was left untouched,
+ *         so it must be passed to the IP-task. Otherwise pdTRUE.
+ */
+static BaseType_t prvProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                     BaseType_t xDirectSend )
 {
     UDPPacket_IPv6_t * pxUDPPacket_IPv6;
     IPHeader_IPv6_t * pxIPHeader_IPv6;
-    eResolutionLookupResult_t eReturned;
+    eResolutionLookupResult_t eReturned = eResolutionFailed;
+    BaseType_t xReturn = pdTRUE;
     size_t uxPayloadSize;
     /* memcpy() helper variables for MISRA Rule 21.15 compliance*/
     NetworkInterface_t * pxInterface = NULL;
     EthernetHeader_t * pxEthernetHeader = NULL;
     BaseType_t xLostBuffer = pdFALSE;
+    BaseType_t xHeld = pdFALSE;
     NetworkEndPoint_t * pxEndPoint = NULL;
     IPv6_Address_t xIPv6Address;
 
@@ -194,9 +328,39 @@ void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetwor
         uxPayloadSize = pxNetworkBuffer->xDataLength - sizeof( UDPPacket_IPv6_t );
     }
 
-    /* Look in the IPv6 MAC-address cache for the target IP-address. */
-    eReturned = eNDGetCacheEntry( &( pxNetworkBuffer->xIPAddress.xIP_IPv6 ), &( pxUDPPacket_IPv6->xEthernetHeader.xDestinationAddress ),
-                                  &( pxEndPoint ) );
+    /* Look in the IPv6 MAC-address cache for the target IP-address.
+     * xDirectSend can only be set when ipconfigUDP_DIRECT_SEND is enabled. */
+    #if ( ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) )
+    {
+        if( xDirectSend != pdFALSE )
+        {
+            /* The ND cache is maintained by the IP-task. Make sure that it
+             * does not change while it is being read by this task. */
+            vTaskSuspendAll();
+            {
+                eReturned = eNDGetCacheEntry( &( pxNetworkBuffer->xIPAddress.xIP_IPv6 ), &( pxUDPPacket_IPv6->xEthernetHeader.xDestinationAddress ),
+                                              &( pxEndPoint ) );
+            }
+            ( void ) xTaskResumeAll();
+
+            if( ( eReturned != eResolutionCacheHit ) || ( xUDPDirectSendAllowed( pxEndPoint ) == pdFALSE ) )
+            {
+                /* Sending a neighbour solicitation or waiting for the advertisement
+                 * is left to the IP-task. Restore the address, it might have been
+                 * replaced with the address of the gateway. */
+                ( void ) memcpy( pxNetworkBuffer->xIPAddress.xIP_IPv6.ucBytes, xIPv6Address.ucBytes, sizeof( xIPv6Address.ucBytes ) );
+                eReturned = eResolutionFailed;
+                xReturn = pdFALSE;
+            }
+        }
+    }
+    #endif /* ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) */
+
+    if( xDirectSend == pdFALSE )
+    {
+        eReturned = eNDGetCacheEntry( &( pxNetworkBuffer->xIPAddress.xIP_IPv6 ), &( pxUDPPacket_IPv6->xEthernetHeader.xDestinationAddress ),
+                                      &( pxEndPoint ) );
+    }
 
     if( eReturned != eResolutionFailed )
     {
@@ -288,7 +452,11 @@ void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetwor
             {
                 if( ( ucSocketOptions & ( uint8_t ) FREERTOS_SO_UDPCKSUM_OUT ) != 0U )
                 {
-                    ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxUDPPacket_IPv6, pxNetworkBuffer->xDataLength, pdTRUE );
+                    #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+                        ( void ) usGenerateProtocolChecksumCopied( pxNetworkBuffer, ( uint8_t * ) pxUDPPacket_IPv6, pxNetworkBuffer->xDataLength );
+                    #else
+                        ( void ) usGenerateProtocolChecksum( ( uint8_t * ) pxUDPPacket_IPv6, pxNetworkBuffer->xDataLength, pdTRUE );
+                    #endif
                 }
                 else
                 {
@@ -304,7 +472,21 @@ void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetwor
                 pxNetworkBuffer->pxEndPoint = pxEndPoint;
             }
 
-            eReturned = prvStartLookup( pxNetworkBuffer, &( xLostBuffer ) );
+            #if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+            {
+                xHeld = prvHoldForResolution_IPv6( pxNetworkBuffer, &( xIPv6Address ), pdTRUE );
+            }
+            #endif
+
+            if( xHeld != pdFALSE )
+            {
+                /* The packet will be sent when the neighbour advertisement arrives. */
+                eReturned = eResolutionFailed;
+            }
+            else
+            {
+                eReturned = prvStartLookup( pxNetworkBuffer, &( xLostBuffer ) );
+            }
         }
         else
         {
@@ -350,6 +532,13 @@ void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetwor
             }
             #endif /* if( ipconfigETHERNET_MINIMUM_PACKET_BYTES > 0 ) */
             iptraceNETWORK_INTERFACE_OUTPUT( pxNetworkBuffer->xDataLength, pxNetworkBuffer->pucEthernetBuffer );
+
+            #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            {
+                vPrepareTxChecksums( pxInterface, pxNetworkBuffer );
+            }
+            #endif
+
             ( void ) pxInterface->pfOutput( pxInterface, pxNetworkBuffer, pdTRUE );
         }
         else
@@ -358,15 +547,225 @@ void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetwor
             vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
         }
     }
+    else if( xHeld != pdFALSE )
+    {
+        /* The packet is waiting for the resolution of its next hop. */
+    }
+    else if( xReturn != pdFALSE )
+    {
+        #if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+        {
+            /* When a neighbour solicitation for the next hop is outstanding,
+             * the packet can wait for the advertisement. */
+            if( pxEndPoint != NULL )
+            {
+                pxNetworkBuffer->pxEndPoint = pxEndPoint;
+            }
+
+            xHeld = prvHoldForResolution_IPv6( pxNetworkBuffer, &( xIPv6Address ), pdFALSE );
+        }
+        #endif
+
+        if( xHeld == pdFALSE )
+        {
+            /* The packet can't be sent (DHCP not completed?).  Just drop the
+             * packet. */
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+    }
     else
     {
-        /* The packet can't be sent (DHCP not completed?).  Just drop the
-         * packet. */
-        vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        /* The caller will pass the packet to the IP-task. */
     }
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Pass a received UDP packet to a socket: call its reception handler,
+ *        or add the packet to its list of waiting packets and wake up the
+ *        user of the socket.
+ *
+ * @param[in] pxSocket The socket that is bound to the destination port.
+ * @param[in] pxNetworkBuffer The network buffer carrying the UDP packet.
+ * @param[in] usPort The port number on which this packet was received.
+ *
+ * @return pdPASS when the packet was queued, pdFAIL when the caller must
+ *         release the network buffer.
+ */
+static BaseType_t prvDeliverUDPPacket_IPv6( FreeRTOS_Socket_t * pxSocket,
+                                            NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                            uint16_t usPort )
+{
+    BaseType_t xReturn = pdPASS;
+
+    #if ( ipconfigUSE_CALLBACKS == 1 )
+    {
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const UDPPacket_IPv6_t * pxUDPPacket_IPv6 = ( ( const UDPPacket_IPv6_t * ) pxNetworkBuffer->pucEthernetBuffer );
+        size_t uxIPLength = uxIPHeaderSizePacket( pxNetworkBuffer );
+        size_t uxPayloadSize;
+
+        /* Did the owner of this socket register a reception handler ? */
+        if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xUDP.pxHandleReceive ) )
+        {
+            struct freertos_sockaddr xSourceAddress, destinationAddress;
+            /* The application hook needs to know the from- and to-addresses. */
+
+            void * pcData = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPLength + ipSIZE_OF_UDP_HEADER ] );
+            FOnUDPReceive_t xHandler = ( FOnUDPReceive_t ) pxSocket->u.xUDP.pxHandleReceive;
+
+            xSourceAddress.sin_port = pxNetworkBuffer->usPort;
+            destinationAddress.sin_port = usPort;
+            ( void ) memcpy( xSourceAddress.sin_address.xIP_IPv6.ucBytes, pxUDPPacket_IPv6->xIPHeader.xSourceAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+            ( void ) memcpy( destinationAddress.sin_address.xIP_IPv6.ucBytes, pxUDPPacket_IPv6->xIPHeader.xDestinationAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+            xSourceAddress.sin_family = ( uint8_t ) FREERTOS_AF_INET6;
+            destinationAddress.sin_family = ( uint8_t ) FREERTOS_AF_INET6;
+            xSourceAddress.sin_len = ( uint8_t ) sizeof( xSourceAddress );
+            destinationAddress.sin_len = ( uint8_t ) sizeof( destinationAddress );
+            uxPayloadSize = pxNetworkBuffer->xDataLength - ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_UDP_HEADER + ( size_t ) ipSIZE_OF_IPv6_HEADER );
+
+            /* The value of 'xDataLength' was proven to be at least the size of a UDP packet in prvProcessIPPacket(). */
+            if( xHandler( ( Socket_t ) pxSocket,
+                          ( void * ) pcData,
+                          uxPayloadSize,
+                          &( xSourceAddress ),
+                          &( destinationAddress ) ) != 0 )
+            {
+                xReturn = pdFAIL; /* xHandler has consumed the data, do not add it to .xWaitingPacketsList'. */
+            }
+        }
+    }
+    #endif /* ipconfigUSE_CALLBACKS */
+
+    #if ( ipconfigUDP_MAX_RX_PACKETS > 0U )
+    {
+        if( xReturn == pdPASS )
+        {
+            if( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) >= pxSocket->u.xUDP.uxMaxPackets )
+            {
+                FreeRTOS_debug_printf( ( "xProcessReceivedUDPPacket: buffer full %ld >= %ld port %u\n",
+                                         listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ),
+                                         pxSocket->u.xUDP.uxMaxPackets, pxSocket->usLocalPort ) );
+                xReturn = pdFAIL; /* we did not consume or release the buffer */
+            }
+        }
+    }
+    #endif /* if ( ipconfigUDP_MAX_RX_PACKETS > 0U ) */
+
+    #if ( ipconfigUSE_CALLBACKS == 1 ) || ( ipconfigUDP_MAX_RX_PACKETS > 0U )
+        if( xReturn == pdPASS ) /*lint !e774: Boolean within 'if' always evaluates to True, depending on configuration. [MISRA 2012 Rule 14.3, required. */
+    #else
+        /* xReturn is still pdPASS. */
+    #endif
+    {
+        vTaskSuspendAll();
+        {
+            /* Add the network packet to the list of packets to be
+             * processed by the socket. */
+            vListInsertEnd( &( pxSocket->u.xUDP.xWaitingPacketsList ), &( pxNetworkBuffer->xBufferListItem ) );
+        }
+        ( void ) xTaskResumeAll();
+
+        /* Set the socket's receive event */
+        if( pxSocket->xEventGroup != NULL )
+        {
+            ( void ) xEventGroupSetBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_RECEIVE );
+        }
+
+        #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
+        {
+            if( ( pxSocket->pxSocketSet != NULL ) && ( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_READ ) ) != 0U ) )
+            {
+                ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_READ );
+            }
+
+            #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+            {
+                vSocketSelectChanged( pxSocket );
+            }
+            #endif
+        }
+        #endif
+
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+        {
+            vSocketEPollReady( pxSocket, ( EventBits_t ) eSELECT_READ );
+        }
+        #endif
+
+        #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
+        {
+            if( pxSocket->pxUserSemaphore != NULL )
+            {
+                ( void ) xSemaphoreGive( pxSocket->pxUserSemaphore );
+            }
+        }
+        #endif
+
+        #if ( ipconfigUSE_DHCP == 1 )
+        {
+            if( xIsDHCPSocket( pxSocket ) != 0 )
+            {
+                ( void ) xSendDHCPEvent( pxNetworkBuffer->pxEndPoint );
+            }
+        }
+        #endif
+
+        #if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+        {
+            if( xIsDNSResolverSocket( pxSocket ) != pdFALSE )
+            {
+                ( void ) xSendDNSResolverEvent( NULL );
+            }
+        }
+        #endif
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+
+/**
+ * @brief Pass a received packet to the other sockets that are bound to the
+ *        same port as pxSocket.  Each socket gets a descriptor that shares
+ *        the Ethernet buffer of the packet, the payload is not copied.
+ *
+ * @param[in] pxSocket The first socket that is bound to the destination port.
+ * @param[in] pxNetworkBuffer The network buffer carrying the UDP packet.
+ * @param[in] usPort The port number on which this packet was received.
+ */
+    static void prvFanOutUDPPacket_IPv6( const FreeRTOS_Socket_t * pxSocket,
+                                         NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                         uint16_t usPort )
+    {
+        FreeRTOS_Socket_t * pxNext;
+
+        for( pxNext = pxUDPSocketLookupNext( pxSocket ); pxNext != NULL; pxNext = pxUDPSocketLookupNext( pxNext ) )
+        {
+            NetworkBufferDescriptor_t * pxSharedBuffer = pxShareNetworkBufferWithDescriptor( pxNetworkBuffer );
+
+            if( pxSharedBuffer == NULL )
+            {
+                /* Out of descriptors, the remaining sockets will miss this packet. */
+                break;
+            }
+
+            if( prvDeliverUDPPacket_IPv6( pxNext, pxSharedBuffer, usPort ) != pdPASS )
+            {
+                vReleaseNetworkBufferAndDescriptor( pxSharedBuffer );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) ) */
+
 /**
  * @brief Process the received UDP packet.
  *
@@ -431,105 +830,19 @@ BaseType_t xProcessReceivedUDPPacket_IPv6( NetworkBufferDescriptor_t * pxNetwork
             vNDRefreshCacheEntry( &( pxUDPPacket_IPv6->xEthernetHeader.xSourceAddress ), &( pxUDPPacket_IPv6->xIPHeader.xSourceAddress ),
                                   pxNetworkBuffer->pxEndPoint );
 
-            #if ( ipconfigUSE_CALLBACKS == 1 )
+            #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
             {
-                size_t uxIPLength = uxIPHeaderSizePacket( pxNetworkBuffer );
-                size_t uxPayloadSize;
-
-                /* Did the owner of this socket register a reception handler ? */
-                if( ipconfigIS_VALID_PROG_ADDRESS( pxSocket->u.xUDP.pxHandleReceive ) )
+                /* A multicast or broadcast packet is passed to all sockets
+                 * that share the port, before the first socket may consume it. */
+                if( ( pxSocket->u.xUDP.ucReuseAddress != 0U ) &&
+                    ( pxUDPPacket_IPv6->xIPHeader.xDestinationAddress.ucBytes[ 0 ] == 0xffU ) )
                 {
-                    struct freertos_sockaddr xSourceAddress, destinationAddress;
-                    /* The application hook needs to know the from- and to-addresses. */
-
-                    void * pcData = &( pxNetworkBuffer->pucEthernetBuffer[ ipSIZE_OF_ETH_HEADER + uxIPLength + ipSIZE_OF_UDP_HEADER ] );
-                    FOnUDPReceive_t xHandler = ( FOnUDPReceive_t ) pxSocket->u.xUDP.pxHandleReceive;
-
-                    xSourceAddress.sin_port = pxNetworkBuffer->usPort;
-                    destinationAddress.sin_port = usPort;
-                    ( void ) memcpy( xSourceAddress.sin_address.xIP_IPv6.ucBytes, pxUDPPacket_IPv6->xIPHeader.xSourceAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
-                    ( void ) memcpy( destinationAddress.sin_address.xIP_IPv6.ucBytes, pxUDPPacket_IPv6->xIPHeader.xDestinationAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
-                    xSourceAddress.sin_family = ( uint8_t ) FREERTOS_AF_INET6;
-                    destinationAddress.sin_family = ( uint8_t ) FREERTOS_AF_INET6;
-                    xSourceAddress.sin_len = ( uint8_t ) sizeof( xSourceAddress );
-                    destinationAddress.sin_len = ( uint8_t ) sizeof( destinationAddress );
-                    uxPayloadSize = pxNetworkBuffer->xDataLength - ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_UDP_HEADER + ( size_t ) ipSIZE_OF_IPv6_HEADER );
-
-                    /* The value of 'xDataLength' was proven to be at least the size of a UDP packet in prvProcessIPPacket(). */
-                    if( xHandler( ( Socket_t ) pxSocket,
-                                  ( void * ) pcData,
-                                  uxPayloadSize,
-                                  &( xSourceAddress ),
-                                  &( destinationAddress ) ) != 0 )
-                    {
-                        xReturn = pdFAIL; /* xHandler has consumed the data, do not add it to .xWaitingPacketsList'. */
-                    }
+                    prvFanOutUDPPacket_IPv6( pxSocket, pxNetworkBuffer, usPort );
                 }
             }
-            #endif /* ipconfigUSE_CALLBACKS */
-
-            #if ( ipconfigUDP_MAX_RX_PACKETS > 0U )
-            {
-                if( xReturn == pdPASS )
-                {
-                    if( listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ) >= pxSocket->u.xUDP.uxMaxPackets )
-                    {
-                        FreeRTOS_debug_printf( ( "xProcessReceivedUDPPacket: buffer full %ld >= %ld port %u\n",
-                                                 listCURRENT_LIST_LENGTH( &( pxSocket->u.xUDP.xWaitingPacketsList ) ),
-                                                 pxSocket->u.xUDP.uxMaxPackets, pxSocket->usLocalPort ) );
-                        xReturn = pdFAIL; /* we did not consume or release the buffer */
-                    }
-                }
-            }
-            #endif /* if ( ipconfigUDP_MAX_RX_PACKETS > 0U ) */
-
-            #if ( ipconfigUSE_CALLBACKS == 1 ) || ( ipconfigUDP_MAX_RX_PACKETS > 0U )
-                if( xReturn == pdPASS ) /*lint !e774: Boolean within 'if' always evaluates to True, depending on configuration. [MISRA 2012 Rule 14.3, required. */
-            #else
-                /* xReturn is still pdPASS. */
             #endif
-            {
-                vTaskSuspendAll();
-                {
-                    /* Add the network packet to the list of packets to be
-                     * processed by the socket. */
-                    vListInsertEnd( &( pxSocket->u.xUDP.xWaitingPacketsList ), &( pxNetworkBuffer->xBufferListItem ) );
-                }
-                ( void ) xTaskResumeAll();
-
-                /* Set the socket's receive event */
-                if( pxSocket->xEventGroup != NULL )
-                {
-                    ( void ) xEventGroupSetBits( pxSocket->xEventGroup, ( EventBits_t ) eSOCKET_RECEIVE );
-                }
-
-                #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
-                {
-                    if( ( pxSocket->pxSocketSet != NULL ) && ( ( pxSocket->xSelectBits & ( ( EventBits_t ) eSELECT_READ ) ) != 0U ) )
-                    {
-                        ( void ) xEventGroupSetBits( pxSocket->pxSocketSet->xSelectGroup, ( EventBits_t ) eSELECT_READ );
-                    }
-                }
-                #endif
 
-                #if ( ipconfigSOCKET_HAS_USER_SEMAPHORE == 1 )
-                {
-                    if( pxSocket->pxUserSemaphore != NULL )
-                    {
-                        ( void ) xSemaphoreGive( pxSocket->pxUserSemaphore );
-                    }
-                }
-                #endif
-
-                #if ( ipconfigUSE_DHCP == 1 )
-                {
-                    if( xIsDHCPSocket( pxSocket ) != 0 )
-                    {
-                        ( void ) xSendDHCPEvent( pxNetworkBuffer->pxEndPoint );
-                    }
-                }
-                #endif
-            }
+            xReturn = prvDeliverUDPPacket_IPv6( pxSocket, pxNetworkBuffer, usPort );
         }
         else
         {
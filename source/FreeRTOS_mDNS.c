@@ -0,0 +1,1364 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_mDNS.c
+ * @brief Implements an mDNS browser (RFC 6762) with a shared record cache.
+ *
+ * Continuous queries are sent by the IP-task with an exponential back-off.
+ * All questions that are due are sent in a single message, together with the
+ * cached answers that the responders do not need to repeat. Answers that are
+ * multicast by other hosts are stored as well, so repeated discovery is served
+ * from the cache. The queries are sent on every network interface that has
+ * an end-point that is up, once per IP family. The messages are sent without
+ * a socket, so that the mDNS responder keeps receiving the packets for port
+ * 5353.
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Timers.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Sockets.h"
+#include "FreeRTOS_UDP_IP.h"
+#include "FreeRTOS_Routing.h"
+#include "FreeRTOS_DNS.h"
+#include "FreeRTOS_DNS_Globals.h"
+#include "FreeRTOS_DNS_Parser.h"
+#include "NetworkBufferManagement.h"
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+
+/** @brief The period of the browser timer, which checks which questions are due. */
+    #define mdnsCHECK_PERIOD_MS           ( 1000U )
+
+/** @brief The interval between the first two queries of a question in seconds. */
+    #define mdnsFIRST_INTERVAL_SECONDS    ( 1U )
+
+/** @brief The maximum interval between two queries of a question: 60 minutes. */
+    #define mdnsMAX_INTERVAL_SECONDS      ( 3600U )
+
+/** @brief A question is sent again when one of its answers has reached this
+ *         percentage of its TTL, see RFC 6762 section 5.2. */
+    #define mdnsREFRESH_PERCENTAGE        ( 80U )
+
+/** @brief The top bit of the class of a record: flush older records of the same
+ *         name and type, see RFC 6762 section 10.2. */
+    #define mdnsCACHE_FLUSH_BIT           ( 0x8000U )
+
+/** @brief The top bit of the class of a question: a unicast response is requested. */
+    #define mdnsUNICAST_RESPONSE_BIT      ( 0x8000U )
+
+/** @brief The size of the fixed fields of a resource record: type, class, TTL
+ *         and data length. */
+    #define mdnsRECORD_FIXED_LENGTH       ( 10U )
+
+/** @brief A question slot that can be taken by FreeRTOS_mDNSQuery(). */
+    #define mdnsQUESTION_FREE             ( 0U )
+
+/** @brief A question that is being asked. */
+    #define mdnsQUESTION_ACTIVE           ( 1U )
+
+/** @brief A question that was stopped by the user. Its slot is freed by the
+ *         IP-task, which may still be reading it. */
+    #define mdnsQUESTION_STOPPED          ( 2U )
+
+/** @brief A continuous query, see RFC 6762 section 5.2. */
+    typedef struct xMDNS_QUESTION
+    {
+        char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ]; /**< The name that is asked for. */
+        TickType_t xLastSent;                         /**< The time at which the question was last sent. */
+        uint32_t ulInterval;                          /**< The time in seconds between the last and the next query, zero when the question was never sent. */
+        uint16_t usType;                              /**< The type of records that is asked for. */
+        uint8_t ucState;                              /**< mdnsQUESTION_FREE, mdnsQUESTION_ACTIVE or mdnsQUESTION_STOPPED. */
+        uint8_t ucDue;                                /**< Non-zero when the question will be included in the next query. */
+    } MDNSQuestion_t;
+
+/** @brief An entry of the record cache. */
+    typedef struct xMDNS_CACHE_ENTRY
+    {
+        MDNSRecord_t xRecord;   /**< The record, with the TTL as it was received. */
+        TickType_t xTimeStored; /**< The time at which the record was stored or refreshed. */
+        uint8_t ucUsed;         /**< Non-zero when the entry holds a record. */
+        uint8_t ucRefreshed;    /**< Non-zero when a refresh query was sent for the record. */
+    } MDNSCacheEntry_t;
+
+/** @brief The continuous queries. A question is filled in by the user while it
+ *         is free, and only the IP-task frees it again, so the IP-task can read
+ *         the name and the type without locking. The state is changed in a
+ *         critical section. */
+    static MDNSQuestion_t xMDNSQuestions[ ipconfigMDNS_MAX_QUESTIONS ];
+
+/** @brief The record cache. Only the IP-task changes it, in critical sections,
+ *         and the user reads it one entry at a time in a critical section. */
+    static MDNSCacheEntry_t xMDNSCache[ ipconfigMDNS_CACHE_ENTRIES ];
+
+/** @brief A record that is being decoded, only accessed by the IP-task. */
+    static MDNSRecord_t xMDNSDecoded;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the time that a cached record remains valid.
+ *
+ * @param[in] pxEntry The cache entry.
+ * @param[in] xNow The current time.
+ *
+ * @return The remaining TTL in seconds, zero when the record has expired.
+ */
+    static uint32_t prvMDNSRemainingTTL( const MDNSCacheEntry_t * pxEntry,
+                                         TickType_t xNow )
+    {
+        uint32_t ulElapsed = ( uint32_t ) ( ( xNow - pxEntry->xTimeStored ) / ( TickType_t ) configTICK_RATE_HZ );
+        uint32_t ulReturn = 0U;
+
+        if( pxEntry->xRecord.ulTTL > ulElapsed )
+        {
+            ulReturn = pxEntry->xRecord.ulTTL - ulElapsed;
+        }
+
+        return ulReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write a 16-bit value in network order.
+ *
+ * @param[out] pucBuffer Where the value will be written.
+ * @param[in] usValue The value in host order.
+ */
+    static void prvMDNSWrite16( uint8_t * pucBuffer,
+                                uint16_t usValue )
+    {
+        pucBuffer[ 0 ] = ( uint8_t ) ( usValue >> 8 );
+        pucBuffer[ 1 ] = ( uint8_t ) ( usValue & 0xFFU );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write a name in the label format of DNS, without compression.
+ *
+ * @param[out] pucBuffer The message.
+ * @param[in] uxOffset The offset at which the name will be written.
+ * @param[in] uxSize The size of the message buffer.
+ * @param[in] pcName The name in dotted notation.
+ *
+ * @return The offset of the first byte after the name, or zero when it does not fit.
+ */
+    static size_t prvMDNSWriteName( uint8_t * pucBuffer,
+                                    size_t uxOffset,
+                                    size_t uxSize,
+                                    const char * pcName )
+    {
+        size_t uxLengthIndex = uxOffset;
+        size_t uxIndex = uxOffset + 1U;
+        size_t uxReturn = 0U;
+        const char * pcChar = pcName;
+
+        while( uxIndex < uxSize )
+        {
+            if( ( *pcChar == '.' ) || ( *pcChar == '\0' ) )
+            {
+                size_t uxLabelLength = uxIndex - uxLengthIndex - 1U;
+
+                if( uxLabelLength > 63U )
+                {
+                    break;
+                }
+
+                if( uxLabelLength != 0U )
+                {
+                    pucBuffer[ uxLengthIndex ] = ( uint8_t ) uxLabelLength;
+                    uxLengthIndex = uxIndex;
+                    uxIndex++;
+                }
+
+                if( ( *pcChar == '\0' ) || ( pcChar[ 1 ] == '\0' ) )
+                {
+                    /* Terminate with a zero-length label, a trailing dot is ignored. */
+                    pucBuffer[ uxLengthIndex ] = 0U;
+                    uxReturn = uxLengthIndex + 1U;
+                    break;
+                }
+            }
+            else
+            {
+                pucBuffer[ uxIndex ] = ( uint8_t ) *pcChar;
+                uxIndex++;
+            }
+
+            pcChar++;
+        }
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if two records of the same name and type have the same data.
+ *
+ * @param[in] pxRecord1 The first record.
+ * @param[in] pxRecord2 The second record.
+ *
+ * @return pdTRUE when the data is equal.
+ */
+    static BaseType_t prvMDNSSameData( const MDNSRecord_t * pxRecord1,
+                                       const MDNSRecord_t * pxRecord2 )
+    {
+        BaseType_t xReturn;
+
+        switch( pxRecord1->usType )
+        {
+            case dnsTYPE_A_HOST:
+                xReturn = ( pxRecord1->xAddress.xIPAddress.ulIP_IPv4 == pxRecord2->xAddress.xIPAddress.ulIP_IPv4 ) ? pdTRUE : pdFALSE;
+                break;
+
+            case dnsTYPE_AAAA_HOST:
+                xReturn = ( memcmp( pxRecord1->xAddress.xIPAddress.xIP_IPv6.ucBytes,
+                                    pxRecord2->xAddress.xIPAddress.xIP_IPv6.ucBytes,
+                                    ipSIZE_OF_IPv6_ADDRESS ) == 0 ) ? pdTRUE : pdFALSE;
+                break;
+
+            case dnsTYPE_SRV:
+                xReturn = ( ( pxRecord1->usPort == pxRecord2->usPort ) &&
+                            ( DNS_NameEqual( pxRecord1->pcTarget, pxRecord2->pcTarget ) != pdFALSE ) ) ? pdTRUE : pdFALSE;
+                break;
+
+            default:
+                xReturn = DNS_NameEqual( pxRecord1->pcTarget, pxRecord2->pcTarget );
+                break;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if a record is worth storing: it answers an active question,
+ *        or it belongs to a name that an unexpired PTR or SRV record points to.
+ *
+ * @param[in] pxRecord The record.
+ *
+ * @return pdTRUE when the record should be stored.
+ */
+    static BaseType_t prvMDNSIsWanted( const MDNSRecord_t * pxRecord )
+    {
+        TickType_t xNow = xTaskGetTickCount();
+        BaseType_t xReturn = pdFALSE;
+        size_t uxIndex;
+
+        for( uxIndex = 0U; uxIndex < ipconfigMDNS_MAX_QUESTIONS; uxIndex++ )
+        {
+            if( ( xMDNSQuestions[ uxIndex ].ucState == mdnsQUESTION_ACTIVE ) &&
+                ( DNS_NameEqual( xMDNSQuestions[ uxIndex ].pcName, pxRecord->pcName ) != pdFALSE ) )
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+        }
+
+        for( uxIndex = 0U; ( uxIndex < ipconfigMDNS_CACHE_ENTRIES ) && ( xReturn == pdFALSE ); uxIndex++ )
+        {
+            if( ( xMDNSCache[ uxIndex ].ucUsed != 0U ) &&
+                ( ( xMDNSCache[ uxIndex ].xRecord.usType == dnsTYPE_PTR ) || ( xMDNSCache[ uxIndex ].xRecord.usType == dnsTYPE_SRV ) ) &&
+                ( prvMDNSRemainingTTL( &( xMDNSCache[ uxIndex ] ), xNow ) != 0U ) &&
+                ( DNS_NameEqual( xMDNSCache[ uxIndex ].xRecord.pcTarget, pxRecord->pcName ) != pdFALSE ) )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store a record in the cache. A known record gets a new TTL, a record
+ *        with a TTL of zero is a "goodbye" and expires after one second.
+ *
+ * @param[in] pxRecord The record.
+ * @param[in] xCacheFlush pdTRUE when the cache-flush bit was set: other records
+ *                        of the same name and type expire after one second.
+ */
+    static void prvMDNSStoreRecord( const MDNSRecord_t * pxRecord,
+                                    BaseType_t xCacheFlush )
+    {
+        TickType_t xNow = xTaskGetTickCount();
+        MDNSCacheEntry_t * pxFound = NULL;
+        MDNSCacheEntry_t * pxFree = NULL;
+        uint32_t ulLowestTTL = 0U;
+        size_t uxIndex;
+
+        for( uxIndex = 0U; uxIndex < ipconfigMDNS_CACHE_ENTRIES; uxIndex++ )
+        {
+            MDNSCacheEntry_t * pxEntry = &( xMDNSCache[ uxIndex ] );
+            uint32_t ulRemaining = 0U;
+
+            if( pxEntry->ucUsed != 0U )
+            {
+                ulRemaining = prvMDNSRemainingTTL( pxEntry, xNow );
+            }
+
+            if( ( ulRemaining != 0U ) &&
+                ( pxEntry->xRecord.usType == pxRecord->usType ) &&
+                ( DNS_NameEqual( pxEntry->xRecord.pcName, pxRecord->pcName ) != pdFALSE ) )
+            {
+                if( prvMDNSSameData( &( pxEntry->xRecord ), pxRecord ) != pdFALSE )
+                {
+                    pxFound = pxEntry;
+                }
+                else if( ( xCacheFlush != pdFALSE ) &&
+                         ( ( xNow - pxEntry->xTimeStored ) > ( TickType_t ) configTICK_RATE_HZ ) )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        pxEntry->xRecord.ulTTL = 1U;
+                        pxEntry->xTimeStored = xNow;
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                else
+                {
+                    /* A record that was received less than a second ago, or
+                     * another member of a shared record set. */
+                }
+            }
+
+            /* Use a free or expired entry, or else the one that expires first. */
+            if( ( pxFree == NULL ) || ( ulRemaining < ulLowestTTL ) )
+            {
+                pxFree = pxEntry;
+                ulLowestTTL = ulRemaining;
+            }
+        }
+
+        taskENTER_CRITICAL();
+        {
+            if( pxFound == NULL )
+            {
+                if( pxRecord->ulTTL != 0U )
+                {
+                    pxFound = pxFree;
+                    ( void ) memcpy( &( pxFound->xRecord ), pxRecord, sizeof( pxFound->xRecord ) );
+                    pxFound->ucUsed = pdTRUE_UNSIGNED;
+                }
+            }
+            else
+            {
+                /* A goodbye record expires after one second, RFC 6762 section 10.1. */
+                pxFound->xRecord.ulTTL = ( pxRecord->ulTTL != 0U ) ? pxRecord->ulTTL : 1U;
+            }
+
+            if( pxFound != NULL )
+            {
+                pxFound->xTimeStored = xNow;
+                pxFound->ucRefreshed = pdFALSE_UNSIGNED;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Skip the question section of a DNS message.
+ *
+ * @param[in] pucMessage The DNS message.
+ * @param[in] uxLength The length of the message.
+ * @param[in] uxQuestions The number of questions.
+ *
+ * @return The offset of the answer section, or zero when the message is malformed.
+ */
+    static size_t prvMDNSSkipQuestions( const uint8_t * pucMessage,
+                                        size_t uxLength,
+                                        size_t uxQuestions )
+    {
+        size_t uxOffset = sizeof( DNSMessage_t );
+        size_t uxIndex;
+
+        for( uxIndex = 0U; ( uxIndex < uxQuestions ) && ( uxOffset != 0U ); uxIndex++ )
+        {
+            size_t uxNameLength = DNS_SkipNameField( &( pucMessage[ uxOffset ] ), uxLength - uxOffset );
+
+            if( ( uxNameLength == 0U ) || ( ( uxOffset + uxNameLength + sizeof( uint32_t ) ) > uxLength ) )
+            {
+                uxOffset = 0U;
+            }
+            else
+            {
+                uxOffset += uxNameLength + sizeof( uint32_t );
+            }
+        }
+
+        return uxOffset;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Store the A, AAAA, PTR and SRV records of an mDNS response in the cache.
+ *
+ * @param[in] pucMessage The DNS message.
+ * @param[in] uxLength The length of the message.
+ */
+    static void prvMDNSStoreResponse( const uint8_t * pucMessage,
+                                      size_t uxLength )
+    {
+        size_t uxRecords = ( size_t ) usChar2u16( &( pucMessage[ 6 ] ) ) +
+                           ( size_t ) usChar2u16( &( pucMessage[ 8 ] ) ) +
+                           ( size_t ) usChar2u16( &( pucMessage[ 10 ] ) );
+        size_t uxOffset = prvMDNSSkipQuestions( pucMessage, uxLength, ( size_t ) usChar2u16( &( pucMessage[ 4 ] ) ) );
+        size_t uxIndex;
+
+        for( uxIndex = 0U; ( uxIndex < uxRecords ) && ( uxOffset != 0U ); uxIndex++ )
+        {
+            MDNSRecord_t * pxRecord = &( xMDNSDecoded );
+            size_t uxData;
+            size_t uxDataLength;
+            uint16_t usClass;
+            BaseType_t xStore = pdFALSE;
+
+            uxOffset = DNS_ReadName( pucMessage, uxLength, uxOffset, pxRecord->pcName, sizeof( pxRecord->pcName ) );
+
+            if( ( uxOffset == 0U ) || ( ( uxOffset + mdnsRECORD_FIXED_LENGTH ) > uxLength ) )
+            {
+                break;
+            }
+
+            pxRecord->usType = usChar2u16( &( pucMessage[ uxOffset ] ) );
+            usClass = usChar2u16( &( pucMessage[ uxOffset + 2U ] ) );
+            pxRecord->ulTTL = ulChar2u32( &( pucMessage[ uxOffset + 4U ] ) );
+            uxDataLength = ( size_t ) usChar2u16( &( pucMessage[ uxOffset + 8U ] ) );
+            uxData = uxOffset + mdnsRECORD_FIXED_LENGTH;
+
+            if( ( uxData + uxDataLength ) > uxLength )
+            {
+                break;
+            }
+
+            uxOffset = uxData + uxDataLength;
+
+            if( ( usClass & ( uint16_t ) ~mdnsCACHE_FLUSH_BIT ) != dnsCLASS_IN )
+            {
+                continue;
+            }
+
+            pxRecord->pcTarget[ 0 ] = '\0';
+            pxRecord->usPriority = 0U;
+            pxRecord->usWeight = 0U;
+            pxRecord->usPort = 0U;
+            ( void ) memset( &( pxRecord->xAddress ), 0, sizeof( pxRecord->xAddress ) );
+
+            switch( pxRecord->usType )
+            {
+                case dnsTYPE_A_HOST:
+
+                    if( uxDataLength == ipSIZE_OF_IPv4_ADDRESS )
+                    {
+                        ( void ) memcpy( &( pxRecord->xAddress.xIPAddress.ulIP_IPv4 ), &( pucMessage[ uxData ] ), ipSIZE_OF_IPv4_ADDRESS );
+                        xStore = pdTRUE;
+                    }
+
+                    break;
+
+                case dnsTYPE_AAAA_HOST:
+
+                    if( uxDataLength == ipSIZE_OF_IPv6_ADDRESS )
+                    {
+                        ( void ) memcpy( pxRecord->xAddress.xIPAddress.xIP_IPv6.ucBytes, &( pucMessage[ uxData ] ), ipSIZE_OF_IPv6_ADDRESS );
+                        pxRecord->xAddress.xIs_IPv6 = pdTRUE;
+                        xStore = pdTRUE;
+                    }
+
+                    break;
+
+                case dnsTYPE_PTR:
+
+                    if( DNS_ReadName( pucMessage, uxData + uxDataLength, uxData, pxRecord->pcTarget, sizeof( pxRecord->pcTarget ) ) != 0U )
+                    {
+                        xStore = pdTRUE;
+                    }
+
+                    break;
+
+                case dnsTYPE_SRV:
+
+                    if( ( uxDataLength > 6U ) &&
+                        ( DNS_ReadName( pucMessage, uxData + uxDataLength, uxData + 6U, pxRecord->pcTarget, sizeof( pxRecord->pcTarget ) ) != 0U ) )
+                    {
+                        pxRecord->usPriority = usChar2u16( &( pucMessage[ uxData ] ) );
+                        pxRecord->usWeight = usChar2u16( &( pucMessage[ uxData + 2U ] ) );
+                        pxRecord->usPort = usChar2u16( &( pucMessage[ uxData + 4U ] ) );
+                        xStore = pdTRUE;
+                    }
+
+                    break;
+
+                default:
+                    /* TXT and other types are not stored. */
+                    break;
+            }
+
+            if( ( xStore != pdFALSE ) && ( prvMDNSIsWanted( pxRecord ) != pdFALSE ) )
+            {
+                prvMDNSStoreRecord( pxRecord, ( ( usClass & mdnsCACHE_FLUSH_BIT ) != 0U ) ? pdTRUE : pdFALSE );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if an mDNS query already lists our own address as a known
+ *        answer with at least half of its TTL left, in which case the responder
+ *        must not answer it, see RFC 6762 section 7.1.
+ *
+ * @param[in] pxEndPoint The end-point on which the query was received.
+ * @param[in] pucMessage The DNS message.
+ * @param[in] uxLength The length of the message.
+ *
+ * @return pdTRUE when the query must not be answered.
+ */
+    static BaseType_t prvMDNSKnownAnswer( const NetworkEndPoint_t * pxEndPoint,
+                                          const uint8_t * pucMessage,
+                                          size_t uxLength )
+    {
+        BaseType_t xReturn = pdFALSE;
+        size_t uxQuestions = ( size_t ) usChar2u16( &( pucMessage[ 4 ] ) );
+        size_t uxAnswers = ( size_t ) usChar2u16( &( pucMessage[ 6 ] ) );
+        size_t uxOffset = 0U;
+        uint16_t usQuestionType = 0U;
+        size_t uxIndex;
+
+        if( uxQuestions != 0U )
+        {
+            uxOffset = prvMDNSSkipQuestions( pucMessage, uxLength, 1U );
+        }
+
+        if( uxOffset != 0U )
+        {
+            /* The responder only answers the first question. */
+            usQuestionType = usChar2u16( &( pucMessage[ uxOffset - sizeof( uint32_t ) ] ) );
+            uxOffset = prvMDNSSkipQuestions( pucMessage, uxLength, uxQuestions );
+        }
+
+        for( uxIndex = 0U; ( uxIndex < uxAnswers ) && ( uxOffset != 0U ) && ( xReturn == pdFALSE ); uxIndex++ )
+        {
+            size_t uxNameLength = DNS_SkipNameField( &( pucMessage[ uxOffset ] ), uxLength - uxOffset );
+            size_t uxData = uxOffset + uxNameLength + mdnsRECORD_FIXED_LENGTH;
+            size_t uxDataLength;
+
+            if( ( uxNameLength == 0U ) || ( uxData > uxLength ) )
+            {
+                break;
+            }
+
+            uxDataLength = ( size_t ) usChar2u16( &( pucMessage[ uxData - 2U ] ) );
+
+            if( ( uxData + uxDataLength ) > uxLength )
+            {
+                break;
+            }
+
+            if( ( usChar2u16( &( pucMessage[ uxOffset + uxNameLength ] ) ) == usQuestionType ) &&
+                ( ulChar2u32( &( pucMessage[ uxOffset + uxNameLength + 4U ] ) ) >= ( dnsLLMNR_TTL_VALUE / 2U ) ) )
+            {
+                #if ( ipconfigUSE_IPv4 != 0 )
+                    if( ( usQuestionType == dnsTYPE_A_HOST ) &&
+                        ( uxDataLength == ipSIZE_OF_IPv4_ADDRESS ) &&
+                        ( pxEndPoint->bits.bIPv6 == pdFALSE_UNSIGNED ) &&
+                        ( memcmp( &( pucMessage[ uxData ] ), &( pxEndPoint->ipv4_settings.ulIPAddress ), ipSIZE_OF_IPv4_ADDRESS ) == 0 ) )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                #endif
+
+                #if ( ipconfigUSE_IPv6 != 0 )
+                    if( ( usQuestionType == dnsTYPE_AAAA_HOST ) &&
+                        ( uxDataLength == ipSIZE_OF_IPv6_ADDRESS ) &&
+                        ( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED ) &&
+                        ( memcmp( &( pucMessage[ uxData ] ), pxEndPoint->ipv6_settings.xIPAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS ) == 0 ) )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                #endif
+            }
+
+            uxOffset = uxData + uxDataLength;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if there are cached answers to a question.
+ *
+ * @param[in] pxQuestion The question.
+ * @param[in] xNow The current time.
+ *
+ * @return pdTRUE when at least one answer is cached.
+ */
+    static BaseType_t prvMDNSHasAnswers( const MDNSQuestion_t * pxQuestion,
+                                         TickType_t xNow )
+    {
+        BaseType_t xReturn = pdFALSE;
+        size_t uxIndex;
+
+        for( uxIndex = 0U; uxIndex < ipconfigMDNS_CACHE_ENTRIES; uxIndex++ )
+        {
+            const MDNSCacheEntry_t * pxEntry = &( xMDNSCache[ uxIndex ] );
+
+            if( ( pxEntry->ucUsed != 0U ) &&
+                ( pxEntry->xRecord.usType == pxQuestion->usType ) &&
+                ( prvMDNSRemainingTTL( pxEntry, xNow ) != 0U ) &&
+                ( DNS_NameEqual( pxEntry->xRecord.pcName, pxQuestion->pcName ) != pdFALSE ) )
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Look at the questions in a query from another host. When it asks one
+ *        of our questions, which has no cached answers, our next query of that
+ *        question is postponed, see RFC 6762 section 7.3.
+ *
+ * @param[in] pucMessage The DNS message.
+ * @param[in] uxLength The length of the message.
+ */
+    static void prvMDNSSuppressDuplicates( const uint8_t * pucMessage,
+                                           size_t uxLength )
+    {
+        size_t uxQuestions = ( size_t ) usChar2u16( &( pucMessage[ 4 ] ) );
+        size_t uxOffset = sizeof( DNSMessage_t );
+        TickType_t xNow = xTaskGetTickCount();
+        size_t uxIndex;
+
+        /* A query with known answers is only a duplicate when those answers are
+         * the same as ours, which is not checked. */
+        if( usChar2u16( &( pucMessage[ 6 ] ) ) == 0U )
+        {
+            for( uxIndex = 0U; uxIndex < uxQuestions; uxIndex++ )
+            {
+                uint16_t usType;
+                uint16_t usClass;
+                size_t uxQuestion;
+
+                uxOffset = DNS_ReadName( pucMessage, uxLength, uxOffset, xMDNSDecoded.pcName, sizeof( xMDNSDecoded.pcName ) );
+
+                if( ( uxOffset == 0U ) || ( ( uxOffset + sizeof( uint32_t ) ) > uxLength ) )
+                {
+                    break;
+                }
+
+                usType = usChar2u16( &( pucMessage[ uxOffset ] ) );
+                usClass = usChar2u16( &( pucMessage[ uxOffset + 2U ] ) );
+                uxOffset += sizeof( uint32_t );
+
+                if( ( usClass & mdnsUNICAST_RESPONSE_BIT ) != 0U )
+                {
+                    /* The answer will not be multicast. */
+                    continue;
+                }
+
+                for( uxQuestion = 0U; uxQuestion < ipconfigMDNS_MAX_QUESTIONS; uxQuestion++ )
+                {
+                    MDNSQuestion_t * pxQuestion = &( xMDNSQuestions[ uxQuestion ] );
+
+                    if( ( pxQuestion->ucState == mdnsQUESTION_ACTIVE ) &&
+                        ( pxQuestion->ulInterval != 0U ) &&
+                        ( pxQuestion->usType == usType ) &&
+                        ( DNS_NameEqual( pxQuestion->pcName, xMDNSDecoded.pcName ) != pdFALSE ) &&
+                        ( prvMDNSHasAnswers( pxQuestion, xNow ) == pdFALSE ) )
+                    {
+                        pxQuestion->xLastSent = xNow;
+                    }
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write the questions that are due into a query, followed by their
+ *        cached answers with more than half of their TTL left, see RFC 6762
+ *        section 7.1. Known answers that do not fit are left out.
+ *
+ * @param[out] pucBuffer Where the DNS message will be written.
+ * @param[in] uxSize The maximum size of the message.
+ *
+ * @return The length of the message, or zero when no question fits.
+ */
+    static size_t prvMDNSBuildQuery( uint8_t * pucBuffer,
+                                     size_t uxSize )
+    {
+        size_t uxNameOffsets[ ipconfigMDNS_MAX_QUESTIONS ];
+        TickType_t xNow = xTaskGetTickCount();
+        size_t uxOffset = sizeof( DNSMessage_t );
+        uint16_t usQuestions = 0U;
+        uint16_t usAnswers = 0U;
+        size_t uxQuestion;
+        size_t uxIndex;
+
+        ( void ) memset( pucBuffer, 0, sizeof( DNSMessage_t ) );
+
+        for( uxQuestion = 0U; uxQuestion < ipconfigMDNS_MAX_QUESTIONS; uxQuestion++ )
+        {
+            const MDNSQuestion_t * pxQuestion = &( xMDNSQuestions[ uxQuestion ] );
+            size_t uxNext = 0U;
+
+            uxNameOffsets[ uxQuestion ] = 0U;
+
+            if( pxQuestion->ucDue != 0U )
+            {
+                uxNext = prvMDNSWriteName( pucBuffer, uxOffset, uxSize, pxQuestion->pcName );
+            }
+
+            if( ( uxNext != 0U ) && ( ( uxNext + sizeof( uint32_t ) ) <= uxSize ) )
+            {
+                uxNameOffsets[ uxQuestion ] = uxOffset;
+                prvMDNSWrite16( &( pucBuffer[ uxNext ] ), pxQuestion->usType );
+                prvMDNSWrite16( &( pucBuffer[ uxNext + 2U ] ), dnsCLASS_IN );
+                uxOffset = uxNext + sizeof( uint32_t );
+                usQuestions++;
+            }
+        }
+
+        for( uxQuestion = 0U; uxQuestion < ipconfigMDNS_MAX_QUESTIONS; uxQuestion++ )
+        {
+            const MDNSQuestion_t * pxQuestion = &( xMDNSQuestions[ uxQuestion ] );
+
+            if( uxNameOffsets[ uxQuestion ] == 0U )
+            {
+                continue;
+            }
+
+            for( uxIndex = 0U; uxIndex < ipconfigMDNS_CACHE_ENTRIES; uxIndex++ )
+            {
+                const MDNSCacheEntry_t * pxEntry = &( xMDNSCache[ uxIndex ] );
+                const MDNSRecord_t * pxRecord = &( pxEntry->xRecord );
+                uint32_t ulRemaining;
+                size_t uxData;
+                size_t uxEnd;
+
+                if( ( pxEntry->ucUsed == 0U ) ||
+                    ( pxRecord->usType != pxQuestion->usType ) ||
+                    ( DNS_NameEqual( pxRecord->pcName, pxQuestion->pcName ) == pdFALSE ) )
+                {
+                    continue;
+                }
+
+                ulRemaining = prvMDNSRemainingTTL( pxEntry, xNow );
+
+                if( ulRemaining <= ( pxRecord->ulTTL / 2U ) )
+                {
+                    /* The responders will send it again. */
+                    continue;
+                }
+
+                /* The owner name is a pointer to the name of the question. */
+                uxData = uxOffset + 2U + mdnsRECORD_FIXED_LENGTH;
+
+                if( uxData > uxSize )
+                {
+                    break;
+                }
+
+                switch( pxRecord->usType )
+                {
+                    case dnsTYPE_A_HOST:
+                        uxEnd = uxData + ipSIZE_OF_IPv4_ADDRESS;
+
+                        if( uxEnd <= uxSize )
+                        {
+                            ( void ) memcpy( &( pucBuffer[ uxData ] ), &( pxRecord->xAddress.xIPAddress.ulIP_IPv4 ), ipSIZE_OF_IPv4_ADDRESS );
+                        }
+
+                        break;
+
+                    case dnsTYPE_AAAA_HOST:
+                        uxEnd = uxData + ipSIZE_OF_IPv6_ADDRESS;
+
+                        if( uxEnd <= uxSize )
+                        {
+                            ( void ) memcpy( &( pucBuffer[ uxData ] ), pxRecord->xAddress.xIPAddress.xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                        }
+
+                        break;
+
+                    case dnsTYPE_SRV:
+                        uxEnd = 0U;
+
+                        if( ( uxData + 6U ) <= uxSize )
+                        {
+                            prvMDNSWrite16( &( pucBuffer[ uxData ] ), pxRecord->usPriority );
+                            prvMDNSWrite16( &( pucBuffer[ uxData + 2U ] ), pxRecord->usWeight );
+                            prvMDNSWrite16( &( pucBuffer[ uxData + 4U ] ), pxRecord->usPort );
+                            uxEnd = prvMDNSWriteName( pucBuffer, uxData + 6U, uxSize, pxRecord->pcTarget );
+                        }
+
+                        break;
+
+                    default:
+                        uxEnd = prvMDNSWriteName( pucBuffer, uxData, uxSize, pxRecord->pcTarget );
+                        break;
+                }
+
+                if( ( uxEnd == 0U ) || ( uxEnd > uxSize ) )
+                {
+                    break;
+                }
+
+                pucBuffer[ uxOffset ] = ( uint8_t ) ( dnsNAME_IS_OFFSET | ( uint8_t ) ( uxNameOffsets[ uxQuestion ] >> 8 ) );
+                pucBuffer[ uxOffset + 1U ] = ( uint8_t ) ( uxNameOffsets[ uxQuestion ] & 0xFFU );
+                prvMDNSWrite16( &( pucBuffer[ uxOffset + 2U ] ), pxRecord->usType );
+                prvMDNSWrite16( &( pucBuffer[ uxOffset + 4U ] ), dnsCLASS_IN );
+                prvMDNSWrite16( &( pucBuffer[ uxOffset + 6U ] ), ( uint16_t ) ( ulRemaining >> 16 ) );
+                prvMDNSWrite16( &( pucBuffer[ uxOffset + 8U ] ), ( uint16_t ) ( ulRemaining & 0xFFFFU ) );
+                prvMDNSWrite16( &( pucBuffer[ uxOffset + 10U ] ), ( uint16_t ) ( uxEnd - uxData ) );
+                uxOffset = uxEnd;
+                usAnswers++;
+            }
+        }
+
+        /* The identifier and the flags of a multicast query are zero. */
+        prvMDNSWrite16( &( pucBuffer[ 4 ] ), usQuestions );
+        prvMDNSWrite16( &( pucBuffer[ 6 ] ), usAnswers );
+
+        return ( usQuestions != 0U ) ? uxOffset : 0U;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if an end-point can send mDNS queries: it is up, and an IPv4
+ *        end-point has an address.
+ *
+ * @param[in] pxEndPoint The end-point.
+ *
+ * @return pdTRUE when the end-point can be used.
+ */
+    static BaseType_t prvMDNSEndPointReady( const NetworkEndPoint_t * pxEndPoint )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxEndPoint->bits.bEndPointUp != pdFALSE_UNSIGNED )
+        {
+            xReturn = pdTRUE;
+
+            #if ( ipconfigUSE_IPv4 != 0 )
+                if( ( pxEndPoint->bits.bIPv6 == pdFALSE_UNSIGNED ) && ( pxEndPoint->ipv4_settings.ulIPAddress == 0U ) )
+                {
+                    /* No address yet, e.g. while DHCP is in progress. */
+                    xReturn = pdFALSE;
+                }
+            #endif
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check if an end-point is the first ready end-point of its IP family
+ *        on its network interface. A query is sent once per interface and
+ *        family, even when the interface has several end-points.
+ *
+ * @param[in] pxEndPoint The end-point.
+ *
+ * @return pdTRUE when the queries will be sent through this end-point.
+ */
+    static BaseType_t prvMDNSFirstOfInterface( NetworkEndPoint_t * pxEndPoint )
+    {
+        BaseType_t xReturn = prvMDNSEndPointReady( pxEndPoint );
+        NetworkEndPoint_t * pxIterator;
+
+        for( pxIterator = FreeRTOS_FirstEndPoint( pxEndPoint->pxNetworkInterface );
+             ( pxIterator != NULL ) && ( pxIterator != pxEndPoint ) && ( xReturn != pdFALSE );
+             pxIterator = FreeRTOS_NextEndPoint( pxEndPoint->pxNetworkInterface, pxIterator ) )
+        {
+            if( ( pxIterator->bits.bIPv6 == pxEndPoint->bits.bIPv6 ) &&
+                ( prvMDNSEndPointReady( pxIterator ) != pdFALSE ) )
+            {
+                xReturn = pdFALSE;
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send the questions that are due to the mDNS group of the IP family of
+ *        an end-point, on the network interface of the end-point.
+ *
+ * @param[in] pxEndPoint The end-point. An IPv6 end-point sends to ff02::fb,
+ *                       an IPv4 end-point to 224.0.0.251.
+ */
+    static void prvMDNSSendQuery( NetworkEndPoint_t * pxEndPoint )
+    {
+        NetworkBufferDescriptor_t * pxNetworkBuffer;
+        size_t uxPayloadOffset;
+        size_t uxMaxLength;
+        size_t uxLength = 0U;
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+            if( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED )
+            {
+                uxPayloadOffset = ipUDP_PAYLOAD_OFFSET_IPv6;
+                uxMaxLength = ipconfigNETWORK_MTU - ( ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER );
+            }
+            else
+        #endif
+        {
+            uxPayloadOffset = ipUDP_PAYLOAD_OFFSET_IPv4;
+            uxMaxLength = ipconfigNETWORK_MTU - ( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER );
+        }
+
+        pxNetworkBuffer = pxGetNetworkBufferWithDescriptor( uxPayloadOffset + uxMaxLength, 0U );
+
+        if( pxNetworkBuffer != NULL )
+        {
+            uxLength = prvMDNSBuildQuery( &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] ), uxMaxLength );
+        }
+
+        if( uxLength != 0U )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            EthernetHeader_t * pxEthernetHeader = ( ( EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer );
+
+            #if ( ipconfigUSE_IPv6 != 0 )
+                if( pxEndPoint->bits.bIPv6 != pdFALSE_UNSIGNED )
+                {
+                    pxEthernetHeader->usFrameType = ipIPv6_FRAME_TYPE;
+                    ( void ) memcpy( pxNetworkBuffer->xIPAddress.xIP_IPv6.ucBytes, ipMDNS_IP_ADDR_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+                }
+                else
+            #endif
+            {
+                pxEthernetHeader->usFrameType = ipIPv4_FRAME_TYPE;
+                pxNetworkBuffer->xIPAddress.ulIP_IPv4 = ipMDNS_IP_ADDRESS;
+            }
+
+            pxNetworkBuffer->pucEthernetBuffer[ ipSOCKET_OPTIONS_OFFSET ] = FREERTOS_SO_UDPCKSUM_OUT;
+            pxNetworkBuffer->pxEndPoint = pxEndPoint;
+            pxNetworkBuffer->usPort = FreeRTOS_htons( ipMDNS_PORT );
+            pxNetworkBuffer->usBoundPort = FreeRTOS_htons( ipMDNS_PORT );
+            pxNetworkBuffer->xDataLength = uxPayloadOffset + uxLength;
+
+            /* The buffer is released by the stack. */
+            vProcessGeneratedUDPPacket( pxNetworkBuffer );
+        }
+        else if( pxNetworkBuffer != NULL )
+        {
+            vReleaseNetworkBufferAndDescriptor( pxNetworkBuffer );
+        }
+        else
+        {
+            /* No buffer. */
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send all questions that are due in a single query per network
+ *        interface and IP family, and schedule their next query.
+ */
+    static void prvMDNSSendDue( void )
+    {
+        TickType_t xNow = xTaskGetTickCount();
+        BaseType_t xActive = pdFALSE;
+        BaseType_t xDue = pdFALSE;
+        size_t uxQuestion;
+        size_t uxIndex;
+
+        for( uxQuestion = 0U; uxQuestion < ipconfigMDNS_MAX_QUESTIONS; uxQuestion++ )
+        {
+            MDNSQuestion_t * pxQuestion = &( xMDNSQuestions[ uxQuestion ] );
+
+            pxQuestion->ucDue = pdFALSE_UNSIGNED;
+
+            if( pxQuestion->ucState == mdnsQUESTION_STOPPED )
+            {
+                /* The user may have restarted the question in the meantime. */
+                taskENTER_CRITICAL();
+                {
+                    if( pxQuestion->ucState == mdnsQUESTION_STOPPED )
+                    {
+                        pxQuestion->ucState = mdnsQUESTION_FREE;
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+
+            if( pxQuestion->ucState != mdnsQUESTION_ACTIVE )
+            {
+                continue;
+            }
+
+            xActive = pdTRUE;
+
+            if( ( pxQuestion->ulInterval == 0U ) ||
+                ( ( xNow - pxQuestion->xLastSent ) >= ( ( TickType_t ) pxQuestion->ulInterval * ( TickType_t ) configTICK_RATE_HZ ) ) )
+            {
+                pxQuestion->ucDue = pdTRUE_UNSIGNED;
+            }
+
+            /* Ask again for answers that are about to expire. */
+            for( uxIndex = 0U; uxIndex < ipconfigMDNS_CACHE_ENTRIES; uxIndex++ )
+            {
+                MDNSCacheEntry_t * pxEntry = &( xMDNSCache[ uxIndex ] );
+
+                if( ( pxEntry->ucUsed != 0U ) &&
+                    ( pxEntry->ucRefreshed == 0U ) &&
+                    ( pxEntry->xRecord.usType == pxQuestion->usType ) &&
+                    ( DNS_NameEqual( pxEntry->xRecord.pcName, pxQuestion->pcName ) != pdFALSE ) )
+                {
+                    uint32_t ulRemaining = prvMDNSRemainingTTL( pxEntry, xNow );
+
+                    if( ( ulRemaining != 0U ) &&
+                        ( ( ( uint64_t ) ulRemaining * 100U ) <= ( ( uint64_t ) pxEntry->xRecord.ulTTL * ( 100U - mdnsREFRESH_PERCENTAGE ) ) ) )
+                    {
+                        pxEntry->ucRefreshed = pdTRUE_UNSIGNED;
+                        pxQuestion->ucDue = pdTRUE_UNSIGNED;
+                    }
+                }
+            }
+
+            if( pxQuestion->ucDue != 0U )
+            {
+                xDue = pdTRUE;
+            }
+        }
+
+        if( xDue != pdFALSE )
+        {
+            NetworkEndPoint_t * pxEndPoint;
+
+            for( pxEndPoint = FreeRTOS_FirstEndPoint( NULL );
+                 pxEndPoint != NULL;
+                 pxEndPoint = FreeRTOS_NextEndPoint( NULL, pxEndPoint ) )
+            {
+                if( prvMDNSFirstOfInterface( pxEndPoint ) != pdFALSE )
+                {
+                    prvMDNSSendQuery( pxEndPoint );
+                }
+            }
+
+            for( uxQuestion = 0U; uxQuestion < ipconfigMDNS_MAX_QUESTIONS; uxQuestion++ )
+            {
+                MDNSQuestion_t * pxQuestion = &( xMDNSQuestions[ uxQuestion ] );
+
+                if( pxQuestion->ucDue != 0U )
+                {
+                    /* The interval starts at one second and doubles until it
+                     * reaches 60 minutes, RFC 6762 section 5.2. */
+                    if( pxQuestion->ulInterval == 0U )
+                    {
+                        pxQuestion->ulInterval = mdnsFIRST_INTERVAL_SECONDS;
+                    }
+                    else if( ( xNow - pxQuestion->xLastSent ) >= ( ( TickType_t ) pxQuestion->ulInterval * ( TickType_t ) configTICK_RATE_HZ ) )
+                    {
+                        pxQuestion->ulInterval = FreeRTOS_min_uint32( pxQuestion->ulInterval * 2U, mdnsMAX_INTERVAL_SECONDS );
+                    }
+                    else
+                    {
+                        /* Only a refresh, the interval stays the same. */
+                    }
+
+                    pxQuestion->xLastSent = xNow;
+                    pxQuestion->ucDue = pdFALSE_UNSIGNED;
+                }
+            }
+        }
+
+        if( xActive == pdFALSE )
+        {
+            /* No more questions, no need for periodic checks. */
+            vIPSetMDNSTimerEnableState( pdFALSE );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Look at an mDNS message that was received on port 5353, called by
+ *        the IP-task before the responder sees it. The answers of a response
+ *        are stored, a query may postpone our own queries.
+ *
+ * @param[in] pxNetworkBuffer The network buffer that holds the message.
+ * @param[in] pucMessage The DNS message.
+ * @param[in] uxLength The length of the message.
+ *
+ * @return pdTRUE when the message is a query that must not be answered,
+ *         because it lists our address as a known answer.
+ */
+    BaseType_t xMDNSProcessPacket( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                   const uint8_t * pucMessage,
+                                   size_t uxLength )
+    {
+        BaseType_t xReturn = pdFALSE;
+        size_t uxUDPOffset = ipSIZE_OF_ETH_HEADER + uxIPHeaderSizePacket( pxNetworkBuffer );
+
+        /* MISRA Ref 11.3.1 [Misaligned access] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Plus-TCP/blob/main/MISRA.md#rule-113 */
+        /* coverity[misra_c_2012_rule_11_3_violation] */
+        const UDPHeader_t * pxUDPHeader = ( ( const UDPHeader_t * ) &( pxNetworkBuffer->pucEthernetBuffer[ uxUDPOffset ] ) );
+        uint16_t usFlags = usChar2u16( &( pucMessage[ 2 ] ) );
+
+        if( ( usFlags & dnsFLAGS_RESPONSE ) != 0U )
+        {
+            /* Only a response from port 5353 is a multicast DNS response,
+             * see RFC 6762 section 6. */
+            if( ( pxUDPHeader->usSourcePort == FreeRTOS_htons( ipMDNS_PORT ) ) &&
+                ( ( usFlags & dnsFLAGS_RCODE_MASK ) == 0U ) )
+            {
+                prvMDNSStoreResponse( pucMessage, uxLength );
+            }
+        }
+        else if( pxUDPHeader->usDestinationPort == FreeRTOS_htons( ipMDNS_PORT ) )
+        {
+            prvMDNSSuppressDuplicates( pucMessage, uxLength );
+
+            if( pxNetworkBuffer->pxEndPoint != NULL )
+            {
+                xReturn = prvMDNSKnownAnswer( pxNetworkBuffer->pxEndPoint, pucMessage, uxLength );
+            }
+        }
+        else
+        {
+            /* Not an mDNS message. */
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Send the questions that were just started, called by the IP-task
+ *        when it receives an eMDNSEvent.
+ */
+    void vMDNSHandleEvent( void )
+    {
+        prvMDNSSendDue();
+        vMDNSTimerReload( pdMS_TO_TICKS( mdnsCHECK_PERIOD_MS ) );
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Called by the IP-task when the browser timer expires.
+ */
+    void vMDNSCheck( void )
+    {
+        prvMDNSSendDue();
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start a continuous mDNS query. The first query is sent right away,
+ *        the next ones after 1, 2, 4, ... seconds, up to once per hour.
+ *        Answers, and the records that they point to, are stored in the cache
+ *        and can be read with FreeRTOS_mDNSLookup().
+ *
+ * @param[in] pcName The name to ask for, e.g. "_http._tcp.local".
+ * @param[in] usType The type of records: dnsTYPE_PTR, dnsTYPE_SRV,
+ *                   dnsTYPE_A_HOST or dnsTYPE_AAAA_HOST.
+ *
+ * @return pdPASS when the query is active, pdFAIL when the name is too long
+ *         or when ipconfigMDNS_MAX_QUESTIONS queries are already active or
+ *         have just been stopped.
+ */
+    BaseType_t FreeRTOS_mDNSQuery( const char * pcName,
+                                   uint16_t usType )
+    {
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xStarted = pdFALSE;
+        MDNSQuestion_t * pxFree = NULL;
+        size_t uxQuestion;
+
+        if( ( pcName != NULL ) && ( strlen( pcName ) < ( size_t ) ipconfigDNS_CACHE_NAME_LENGTH ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                for( uxQuestion = 0U; uxQuestion < ipconfigMDNS_MAX_QUESTIONS; uxQuestion++ )
+                {
+                    MDNSQuestion_t * pxQuestion = &( xMDNSQuestions[ uxQuestion ] );
+
+                    if( pxQuestion->ucState == mdnsQUESTION_FREE )
+                    {
+                        if( pxFree == NULL )
+                        {
+                            pxFree = pxQuestion;
+                        }
+                    }
+                    else if( ( pxQuestion->usType == usType ) &&
+                             ( DNS_NameEqual( pxQuestion->pcName, pcName ) != pdFALSE ) )
+                    {
+                        /* The query is already active, or it was stopped and
+                         * the IP-task has not freed it yet. */
+                        pxQuestion->ucState = mdnsQUESTION_ACTIVE;
+                        xReturn = pdPASS;
+                        break;
+                    }
+                    else
+                    {
+                        /* Another query. */
+                    }
+                }
+
+                if( ( xReturn == pdFAIL ) && ( pxFree != NULL ) )
+                {
+                    ( void ) strcpy( pxFree->pcName, pcName );
+                    pxFree->usType = usType;
+                    pxFree->ulInterval = 0U;
+                    pxFree->ucDue = pdFALSE_UNSIGNED;
+                    pxFree->ucState = mdnsQUESTION_ACTIVE;
+                    xStarted = pdTRUE;
+                    xReturn = pdPASS;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        if( xStarted != pdFALSE )
+        {
+            /* When the event can not be sent, the question will be sent by
+             * the browser timer, if it is running. */
+            ( void ) xSendEventToIPTask( eMDNSEvent );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Stop a continuous mDNS query. The cached answers stay until they expire.
+ *
+ * @param[in] pcName The name that was passed to FreeRTOS_mDNSQuery().
+ * @param[in] usType The type that was passed to FreeRTOS_mDNSQuery().
+ */
+    void FreeRTOS_mDNSStopQuery( const char * pcName,
+                                 uint16_t usType )
+    {
+        BaseType_t xStopped = pdFALSE;
+        size_t uxQuestion;
+
+        if( pcName != NULL )
+        {
+            taskENTER_CRITICAL();
+            {
+                for( uxQuestion = 0U; uxQuestion < ipconfigMDNS_MAX_QUESTIONS; uxQuestion++ )
+                {
+                    MDNSQuestion_t * pxQuestion = &( xMDNSQuestions[ uxQuestion ] );
+
+                    if( ( pxQuestion->ucState == mdnsQUESTION_ACTIVE ) &&
+                        ( pxQuestion->usType == usType ) &&
+                        ( DNS_NameEqual( pxQuestion->pcName, pcName ) != pdFALSE ) )
+                    {
+                        /* The IP-task will free the question. */
+                        pxQuestion->ucState = mdnsQUESTION_STOPPED;
+                        xStopped = pdTRUE;
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        if( xStopped != pdFALSE )
+        {
+            /* Let the IP-task free the question now, otherwise it is freed
+             * by the browser timer. */
+            ( void ) xSendEventToIPTask( eMDNSEvent );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Copy the cached records of a name and type. No traffic is caused,
+ *        use FreeRTOS_mDNSQuery() to have the cache filled.
+ *
+ * @param[in] pcName The owner name of the records.
+ * @param[in] usType The type of the records.
+ * @param[out] pxRecords Where the records will be copied to. The field ulTTL
+ *                       gets the remaining time-to-live.
+ * @param[in] uxMaxRecords The maximum number of records to copy.
+ *
+ * @return The number of records copied.
+ */
+    size_t FreeRTOS_mDNSLookup( const char * pcName,
+                                uint16_t usType,
+                                MDNSRecord_t * pxRecords,
+                                size_t uxMaxRecords )
+    {
+        size_t uxCount = 0U;
+        size_t uxIndex;
+
+        if( ( pcName != NULL ) && ( pxRecords != NULL ) )
+        {
+            TickType_t xNow = xTaskGetTickCount();
+
+            for( uxIndex = 0U; ( uxIndex < ipconfigMDNS_CACHE_ENTRIES ) && ( uxCount < uxMaxRecords ); uxIndex++ )
+            {
+                const MDNSCacheEntry_t * pxEntry = &( xMDNSCache[ uxIndex ] );
+
+                /* The IP-task may be changing the entry. */
+                taskENTER_CRITICAL();
+                {
+                    if( ( pxEntry->ucUsed != 0U ) &&
+                        ( pxEntry->xRecord.usType == usType ) &&
+                        ( DNS_NameEqual( pxEntry->xRecord.pcName, pcName ) != pdFALSE ) )
+                    {
+                        uint32_t ulRemaining = prvMDNSRemainingTTL( pxEntry, xNow );
+
+                        if( ulRemaining != 0U )
+                        {
+                            ( void ) memcpy( &( pxRecords[ uxCount ] ), &( pxEntry->xRecord ), sizeof( pxRecords[ uxCount ] ) );
+                            pxRecords[ uxCount ].ulTTL = ulRemaining;
+                            uxCount++;
+                        }
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+        }
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) ) */
@@ -450,6 +450,63 @@ STATIC_ASSERT( pdMS_TO_TICKS( ipconfigRA_IP_TEST_TIME_OUT_MSEC ) <= portMAX_DELA
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigSUPPORT_IP_MULTICAST
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Enables multicast group membership.  A UDP socket can join and leave groups
+ * with the socket options FREERTOS_SO_IP_ADD_MEMBERSHIP and
+ * FREERTOS_SO_IP_DROP_MEMBERSHIP for IPv4, or FREERTOS_SO_IPV6_ADD_MEMBERSHIP
+ * and FREERTOS_SO_IPV6_DROP_MEMBERSHIP for IPv6.
+ *
+ * The IP-task keeps a table of the groups that are joined on each interface.
+ * The MAC address of a group is passed to pfAddAllowedMAC() of the interface
+ * when the first socket joins, and to pfRemoveAllowedMAC() when the last
+ * socket leaves, so that a driver with a hash or perfect filter only receives
+ * the multicast frames that are wanted.  Memberships are announced with
+ * IGMPv3 (RFC 3376) and MLDv2 (RFC 3810) reports, and queries are answered.
+ * When an IGMPv1/v2 querier or an MLDv1 querier is heard, the older messages
+ * are used for a while.
+ *
+ * Queries often carry a Router Alert IP option, so
+ * ipconfigIP_PASS_PACKETS_WITH_IP_OPTIONS should stay enabled.
+ */
+
+#ifndef ipconfigSUPPORT_IP_MULTICAST
+    #define ipconfigSUPPORT_IP_MULTICAST    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_IP_MULTICAST != ipconfigDISABLE ) && ( ipconfigSUPPORT_IP_MULTICAST != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_IP_MULTICAST configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigMULTICAST_MAX_GROUPS
+ *
+ * Type: size_t
+ * Unit: count of multicast groups
+ * Minimum: 1
+ * Maximum: 32
+ *
+ * The number of entries in the table of multicast groups.  A group that is
+ * joined on two interfaces takes two entries; sockets that join the same group
+ * on the same interface share an entry.  Only used when
+ * ipconfigSUPPORT_IP_MULTICAST is enabled.
+ */
+
+#ifndef ipconfigMULTICAST_MAX_GROUPS
+    #define ipconfigMULTICAST_MAX_GROUPS    ( 8U )
+#endif
+
+#if ( ( ipconfigMULTICAST_MAX_GROUPS < 1 ) || ( ipconfigMULTICAST_MAX_GROUPS > 32 ) )
+    #error ipconfigMULTICAST_MAX_GROUPS must be between 1 and 32
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigMAX_IP_TASK_SLEEP_TIME
  *
@@ -641,6 +698,139 @@ STATIC_ASSERT( ipconfigMAX_IP_TASK_SLEEP_TIME <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, checksum offloading is a property of each network interface
+ * instead of the whole stack.  Useful when an EMAC with checksum offloading is
+ * used together with e.g. a USB-Ethernet adapter or a loop-back interface.
+ *
+ * Both ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM and
+ * ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM must be enabled.  The driver then sets
+ * ipINTERFACE_CHECKSUM_OFFLOAD_RX and/or ipINTERFACE_CHECKSUM_OFFLOAD_TX in the
+ * field 'ucChecksumOffload' of its NetworkInterface_t.  The stack verifies the
+ * checksums of packets received on an interface without RX offloading, unless
+ * the driver has set ipBUFFER_CHECKSUM_VERIFIED in the network buffer.  It
+ * calculates the checksums of packets that are sent through an interface
+ * without TX offloading.  Outgoing IP packets for an interface with TX
+ * offloading get the flag ipBUFFER_CHECKSUM_NEEDED.
+ */
+
+#ifndef ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD
+    #define ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != ipconfigDISABLE ) && ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD configuration
+#endif
+
+#if ( ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 ) && ( ( ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM == 0 ) || ( ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM == 0 ) ) )
+    #error ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD requires ipconfigDRIVER_INCLUDED_RX_IP_CHECKSUM and ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigCHECKSUM_KERNEL
+ *
+ * Type: BaseType_t ( ipconfigCHECKSUM_KERNEL_PORTABLE |
+ *                    ipconfigCHECKSUM_KERNEL_64BIT |
+ *                    ipconfigCHECKSUM_KERNEL_SSE2 |
+ *                    ipconfigCHECKSUM_KERNEL_AVX2 |
+ *                    ipconfigCHECKSUM_KERNEL_NEON )
+ *
+ * Selects the implementation of usGenerateChecksum(), which calculates the
+ * IP, TCP, UDP and ICMP checksums in software.
+ *
+ * The portable version is written for 32-bit MCUs.  On 64-bit CPUs, the
+ * 64BIT kernel adds 32-bit words to 64-bit accumulators and folds the carries
+ * only once.  The SSE2, AVX2 and NEON kernels do the same with vector
+ * registers, and require the compiler to target that instruction set, e.g.
+ * with -msse2, -mavx2 or an ARMv8-A target.  See FreeRTOS_IP_Checksum.c.
+ */
+
+#ifndef ipconfigCHECKSUM_KERNEL_PORTABLE
+    #define ipconfigCHECKSUM_KERNEL_PORTABLE    ( 0 )
+#endif
+
+#ifndef ipconfigCHECKSUM_KERNEL_64BIT
+    #define ipconfigCHECKSUM_KERNEL_64BIT    ( 1 )
+#endif
+
+#ifndef ipconfigCHECKSUM_KERNEL_SSE2
+    #define ipconfigCHECKSUM_KERNEL_SSE2    ( 2 )
+#endif
+
+#ifndef ipconfigCHECKSUM_KERNEL_AVX2
+    #define ipconfigCHECKSUM_KERNEL_AVX2    ( 3 )
+#endif
+
+#ifndef ipconfigCHECKSUM_KERNEL_NEON
+    #define ipconfigCHECKSUM_KERNEL_NEON    ( 4 )
+#endif
+
+#ifndef ipconfigCHECKSUM_KERNEL
+    #define ipconfigCHECKSUM_KERNEL    ipconfigCHECKSUM_KERNEL_PORTABLE
+#endif
+
+#if ( ( ipconfigCHECKSUM_KERNEL < ipconfigCHECKSUM_KERNEL_PORTABLE ) || ( ipconfigCHECKSUM_KERNEL > ipconfigCHECKSUM_KERNEL_NEON ) )
+    #error Invalid ipconfigCHECKSUM_KERNEL configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_COPY_CHECKSUM
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the payload of an outgoing UDP datagram or TCP segment is
+ * summed while it is copied into the network buffer, by FreeRTOS_sendto() or
+ * from the TCP transmission stream.  The protocol checksum then only has to
+ * read the headers, so each payload byte is read once instead of twice.
+ *
+ * Only useful when ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM is disabled, or
+ * when ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD is enabled.  Zero copy
+ * transmissions are summed when the checksum is calculated, as before.
+ */
+
+#ifndef ipconfigUSE_COPY_CHECKSUM
+    #define ipconfigUSE_COPY_CHECKSUM    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_COPY_CHECKSUM != ipconfigDISABLE ) && ( ipconfigUSE_COPY_CHECKSUM != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_COPY_CHECKSUM configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_INCREMENTAL_CHECKSUM
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the checksum of an ICMP or ICMPv6 echo request is adjusted
+ * for the fields that change when it is turned into an echo reply, as
+ * described in RFC 1624, instead of summing the whole message again.  The
+ * cost of a reply no longer depends on the size of the echo data.
+ *
+ * A request with an incorrect checksum gets a reply with an incorrect
+ * checksum.  Only useful when ipconfigDRIVER_INCLUDED_TX_IP_CHECKSUM is
+ * disabled.
+ */
+
+#ifndef ipconfigUSE_INCREMENTAL_CHECKSUM
+    #define ipconfigUSE_INCREMENTAL_CHECKSUM    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_INCREMENTAL_CHECKSUM != ipconfigDISABLE ) && ( ipconfigUSE_INCREMENTAL_CHECKSUM != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_INCREMENTAL_CHECKSUM configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * A MISRA note: The macros 'ipconfigETHERNET_DRIVER_FILTERS_FRAME_TYPES'
  * and 'ipconfigETHERNET_DRIVER_FILTERS_PACKETS' are too long: the first 32
@@ -730,6 +920,13 @@ STATIC_ASSERT( ipconfigMAX_IP_TASK_SLEEP_TIME <= portMAX_DELAY );
  * also checking the target IP address. Also when disabled, xPortHasUDPSocket()
  * won't be included. That means that the IP-task can access the
  * 'xBoundUDPSocketsList' without locking.
+ *
+ * xPortHasUDPSocket() suspends the scheduler, so it can not be called from an
+ * interrupt.  When ipconfigUSE_EARLY_RX_FILTER is also enabled, it first
+ * checks the bound-port bitmap, and only suspends the scheduler when a socket
+ * may be bound to the port.  A driver that filters in an interrupt, or that
+ * also wants to filter TCP packets, can replace the example above with a call
+ * to eFilterReceivedFrame(), which does not need this option.
  */
 
 #ifndef ipconfigETHERNET_DRIVER_FILTERS_PACKETS
@@ -742,6 +939,67 @@ STATIC_ASSERT( ipconfigMAX_IP_TASK_SLEEP_TIME <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_EARLY_RX_FILTER
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, a network driver can call eFilterReceivedFrame() on a received
+ * frame, before it allocates a network buffer or sends an event to the
+ * IP-task.  On top of the checks of eConsiderFrameForProcessing(), it drops
+ * IP packets that are not addressed to any end-point, UDP packets to a port
+ * without a socket, and, when ipconfigIGNORE_UNKNOWN_PACKETS is enabled, TCP
+ * packets to a port without a socket.  The ports are looked up in a bitmap
+ * that is kept up to date by the IP-task, see ipconfigEARLY_RX_FILTER_PORT_BITS.
+ *
+ * The filter only reads the frame and the bitmap, so it may be called from
+ * an interrupt.  The bitmap is also read by xPortHasUDPSocket(), see
+ * ipconfigETHERNET_DRIVER_FILTERS_PACKETS, and by xPortMayHaveSocket().
+ */
+
+#ifndef ipconfigUSE_EARLY_RX_FILTER
+    #define ipconfigUSE_EARLY_RX_FILTER    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_EARLY_RX_FILTER != ipconfigDISABLE ) && ( ipconfigUSE_EARLY_RX_FILTER != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_EARLY_RX_FILTER configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigEARLY_RX_FILTER_PORT_BITS
+ *
+ * Type: size_t
+ * Unit: bits, a power of 2
+ * Minimum: 8
+ * Maximum: 65536
+ *
+ * The number of bits in each of the bound-port bitmaps (one for UDP, one for
+ * TCP) that are used by eFilterReceivedFrame().  A port number is mapped to a
+ * bit by its lowest bits, so a port that shares a bit with a bound port will
+ * pass the filter, and will be dropped later by the IP-task.  With 65536 bits
+ * (8 KB per protocol) the filter is exact.
+ */
+
+#ifndef ipconfigEARLY_RX_FILTER_PORT_BITS
+    #define ipconfigEARLY_RX_FILTER_PORT_BITS    ( 256 )
+#endif
+
+#if ( ipconfigEARLY_RX_FILTER_PORT_BITS < 8 )
+    #error ipconfigEARLY_RX_FILTER_PORT_BITS must be at least 8
+#endif
+
+#if ( ipconfigEARLY_RX_FILTER_PORT_BITS > 65536 )
+    #error ipconfigEARLY_RX_FILTER_PORT_BITS must be at most 65536
+#endif
+
+#if ( ( ipconfigEARLY_RX_FILTER_PORT_BITS & ( ipconfigEARLY_RX_FILTER_PORT_BITS - 1 ) ) != 0 )
+    #error ipconfigEARLY_RX_FILTER_PORT_BITS must be a power of 2
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigETHERNET_MINIMUM_PACKET_BYTES
  *
@@ -1203,6 +1461,79 @@ STATIC_ASSERT( ipconfigIP_TASK_STACK_SIZE_WORDS <= SIZE_MAX );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigRX_WORKER_TASKS
+ *
+ * Type: UBaseType_t
+ * Unit: tasks
+ * Minimum: 0
+ *
+ * When larger than zero, received frames that a driver passes to
+ * xSendEventStructToIPTask() are first steered to one of this number of RX
+ * worker tasks.  The worker is chosen by a Toeplitz hash over the IP
+ * addresses and the TCP/UDP ports, the same hash that is used by NICs for
+ * receive side scaling, so all frames of a connection are handled by the same
+ * worker, in order.  When ipconfigUSE_LINKED_RX_MESSAGES is enabled, the
+ * frames of one flow that follow each other in a chain from the driver stay
+ * linked, and are queued to the worker as a single item.
+ *
+ * A worker applies eFilterReceivedFrame() when ipconfigUSE_EARLY_RX_FILTER is
+ * enabled, verifies the IP and protocol checksums of the frames and marks the
+ * network buffers as verified.  It then passes the chain to the IP-task as one
+ * eNetworkRxEvent, with xSendEventStructToIPTask().  The workers do not access
+ * sockets or the TCP state, which stay owned by the IP-task.
+ *
+ * The workers have the priority ipconfigIP_TASK_PRIORITY, and each one has a
+ * queue of ipconfigEVENT_QUEUE_LENGTH chains.  A worker blocks while the queue
+ * of the IP-task is full, so when the IP-task falls behind, frames are dropped
+ * by the driver, when it can not queue them to a worker.  When no worker could
+ * be created, the frames are passed to the IP-task directly.
+ *
+ * Requires an SMP kernel ( configNUMBER_OF_CORES > 1 ), on a single core the
+ * workers only add a task switch per frame.  Also requires
+ * ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD, which lets the IP-task skip the
+ * checksums that were already verified.
+ */
+
+#ifndef ipconfigRX_WORKER_TASKS
+    #define ipconfigRX_WORKER_TASKS    ( 0 )
+#endif
+
+#if ( ipconfigRX_WORKER_TASKS < 0 )
+    #error ipconfigRX_WORKER_TASKS must be at least 0
+#endif
+
+#if ( ( ipconfigRX_WORKER_TASKS > 0 ) && ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD == 0 ) )
+    #error ipconfigRX_WORKER_TASKS requires ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD
+#endif
+
+#if ( ( ipconfigRX_WORKER_TASKS > 0 ) && ( !defined( configNUMBER_OF_CORES ) || ( configNUMBER_OF_CORES < 2 ) ) )
+    #error ipconfigRX_WORKER_TASKS requires an SMP kernel ( configNUMBER_OF_CORES > 1 )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigRX_WORKER_TASK_STACK_SIZE_WORDS
+ *
+ * Type: size_t
+ * Unit: words
+ * Minimum: configMINIMAL_STACK_SIZE
+ *
+ * The size, in words (not bytes), of the stack of each RX worker task, see
+ * ipconfigRX_WORKER_TASKS.
+ */
+
+#ifndef ipconfigRX_WORKER_TASK_STACK_SIZE_WORDS
+    #define ipconfigRX_WORKER_TASK_STACK_SIZE_WORDS    configMINIMAL_STACK_SIZE
+#endif
+
+STATIC_ASSERT( ipconfigRX_WORKER_TASK_STACK_SIZE_WORDS >= configMINIMAL_STACK_SIZE );
+
+STATIC_ASSERT( ipconfigRX_WORKER_TASK_STACK_SIZE_WORDS <= SIZE_MAX );
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES
  *
@@ -1684,6 +2015,38 @@ STATIC_ASSERT( ipconfigTCP_KEEP_ALIVE_INTERVAL <= ( portMAX_DELAY / configTICK_R
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_TCP_GRO
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Advanced users only.
+ *
+ * Generic receive offload.  When a network interface passes a chain of
+ * received packets to the IP-task ( see ipconfigUSE_LINKED_RX_MESSAGES ),
+ * consecutive in-order TCP segments of the same connection are coalesced:
+ * the payload of each segment is stored in the socket's reception stream,
+ * but the TCP state handling, the window update and the decision to send an
+ * ACK are done only once, for the last segment of the run.
+ *
+ * Only segments without IP or TCP options, which carry no other flags than
+ * ACK and PSH, are coalesced.
+ */
+
+#ifndef ipconfigUSE_TCP_GRO
+    #define ipconfigUSE_TCP_GRO    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_TCP_GRO != ipconfigDISABLE ) && ( ipconfigUSE_TCP_GRO != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_TCP_GRO configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) && ipconfigIS_DISABLED( ipconfigUSE_LINKED_RX_MESSAGES ) )
+    #error ipconfigUSE_TCP_GRO requires ipconfigUSE_LINKED_RX_MESSAGES to be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * pvPortMallocLarge / vPortFreeLarge
  *
@@ -1825,6 +2188,88 @@ STATIC_ASSERT( ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUDP_DIRECT_SEND
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, FreeRTOS_sendto() will try to send a UDP packet from the
+ * calling task, without passing it to the IP-task. This is only done when the
+ * MAC-address of the target is found in the ARP or ND cache, and when the
+ * network interface has set 'bits.bThreadSafeOutput', to declare that its
+ * output function may be called from any task at any time. In all other
+ * cases the packet is passed to the IP-task as usual.
+ *
+ * The cache lookup is done while the scheduler is suspended, so the logging
+ * functions FreeRTOS_printf() and FreeRTOS_debug_printf() must not block.
+ */
+
+#ifndef ipconfigUDP_DIRECT_SEND
+    #define ipconfigUDP_DIRECT_SEND    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUDP_DIRECT_SEND != ipconfigDISABLE ) && ( ipconfigUDP_DIRECT_SEND != ipconfigENABLE ) )
+    #error Invalid ipconfigUDP_DIRECT_SEND configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUDP_SUPPORT_MMSG
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include the batched UDP functions FreeRTOS_recvmmsg() and
+ * FreeRTOS_sendmmsg(). FreeRTOS_recvmmsg() takes several packets from the
+ * socket's reception list in one go, FreeRTOS_sendmmsg() passes several
+ * packets to the IP-task with a single event.
+ *
+ * When enabled, each network buffer gets a 'pxNextBuffer' field, which is
+ * used to link the packets of a batch.
+ */
+
+#ifndef ipconfigUDP_SUPPORT_MMSG
+    #define ipconfigUDP_SUPPORT_MMSG    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUDP_SUPPORT_MMSG != ipconfigDISABLE ) && ( ipconfigUDP_SUPPORT_MMSG != ipconfigENABLE ) )
+    #error Invalid ipconfigUDP_SUPPORT_MMSG configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSUPPORT_UDP_REUSEADDR
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include the socket option FREERTOS_SO_REUSEADDR. UDP sockets that set it
+ * before they are bound may share a port number. A multicast or broadcast
+ * packet is delivered to every socket that is bound to its destination port;
+ * a unicast packet is delivered to the first one only.
+ *
+ * The sockets share the received network buffer: each extra socket gets a
+ * network buffer descriptor that refers to the same Ethernet buffer, which is
+ * released when the last descriptor is released. The extra descriptor still
+ * takes a buffer from the pool: with BufferAllocation_1 every extra socket
+ * costs one whole network buffer while the packet is queued. A payload that is received
+ * with FREERTOS_ZERO_COPY from a shared port must therefore be treated as
+ * read-only. FreeRTOS_sendto() sends a copy of such a payload, and
+ * FreeRTOS_sendmmsg() refuses to send it. Both vReleaseNetworkBufferAndDescriptor()
+ * and vNetworkBufferReleaseFromISR() only release the Ethernet buffer together
+ * with its last descriptor.
+ */
+
+#ifndef ipconfigSUPPORT_UDP_REUSEADDR
+    #define ipconfigSUPPORT_UDP_REUSEADDR    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_UDP_REUSEADDR != ipconfigDISABLE ) && ( ipconfigSUPPORT_UDP_REUSEADDR != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_UDP_REUSEADDR configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*===========================================================================*/
 /*                                UDP CONFIG                                 */
 /*===========================================================================*/
@@ -1888,6 +2333,65 @@ STATIC_ASSERT( ipconfigUDP_MAX_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigSUPPORT_EPOLL
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include support for FreeRTOS_epoll_create(), FreeRTOS_epoll_ctl() and
+ * FreeRTOS_epoll_wait(). This is an edge-triggered alternative to
+ * FreeRTOS_select(): a socket puts itself in the ready list of its epoll set
+ * as soon as an event occurs, so the cost of a wait is proportional to the
+ * number of ready sockets, not to the number of sockets in the set.
+ *
+ * The epoll functions use the select event bits, so they require
+ * ipconfigSUPPORT_SELECT_FUNCTION. A socket can be a member of either a
+ * socket set or an epoll set, not both.
+ */
+
+#ifndef ipconfigSUPPORT_EPOLL
+    #define ipconfigSUPPORT_EPOLL    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSUPPORT_EPOLL != ipconfigDISABLE ) && ( ipconfigSUPPORT_EPOLL != ipconfigENABLE ) )
+    #error Invalid ipconfigSUPPORT_EPOLL configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) && ipconfigIS_DISABLED( ipconfigSUPPORT_SELECT_FUNCTION ) )
+    #error ipconfigSUPPORT_EPOLL requires ipconfigSUPPORT_SELECT_FUNCTION to be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigSELECT_INCREMENTAL
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Normally, every call to FreeRTOS_select() and FreeRTOS_FD_SET() makes the
+ * IP-task walk through all bound sockets, and evaluate the state of each
+ * member of the socket set. When this option is enabled, each socket set
+ * keeps a list of members whose state has changed since the last evaluation,
+ * and a list of members that had events during the last evaluation. Only the
+ * sockets in those two lists will be evaluated again.
+ *
+ * Only used when ipconfigSUPPORT_SELECT_FUNCTION is enabled.
+ */
+
+#ifndef ipconfigSELECT_INCREMENTAL
+    #define ipconfigSELECT_INCREMENTAL    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigSELECT_INCREMENTAL != ipconfigDISABLE ) && ( ipconfigSELECT_INCREMENTAL != ipconfigENABLE ) )
+    #error Invalid ipconfigSELECT_INCREMENTAL configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) && ipconfigIS_DISABLED( ipconfigSUPPORT_SELECT_FUNCTION ) )
+    #error ipconfigSELECT_INCREMENTAL requires ipconfigSUPPORT_SELECT_FUNCTION to be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigSELECT_USES_NOTIFY
  *
@@ -2373,40 +2877,117 @@ STATIC_ASSERT( ipconfigSOCK_DEFAULT_SEND_BLOCK_TIME <= portMAX_DELAY );
 /*---------------------------------------------------------------------------*/
 
 /*
- * ipconfigMAXIMUM_DISCOVER_TX_PERIOD
- *
- * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigMAXIMUM_DISCOVER_TX_PERIOD
+ * ipconfigDHCP_USE_INIT_REBOOT
  *
- * Type: TickType_t
- * Unit: Ticks
- * Minimum: 0
- * Maximum: portMAX_DELAY
- *
- * Sets the max interval allowed between transmissions of DHCP requests before
- * the default IP address will be used.
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
  *
- * When 'endpoint->bits.bWantDHCP' is set, DHCP requests will be sent out at
- * increasing time intervals until either a reply is received from a DHCP
- * server and accepted, or the interval between transmissions reaches
- * ipconfigMAXIMUM_DISCOVER_TX_PERIOD. If no reply is received, the TCP/IP
- * stack will revert to using the default IP address of the endpoint
- * 'endpoint->ipv4_defaults.ulIPAddress' for IPv4 address or
- * 'endpoint->ipv6_defaults.xIPAddress' for IPv6 address.
+ * When DHCP starts over, for instance after the link went down and up again,
+ * the address of the last lease is requested directly with a REQUEST in the
+ * INIT-REBOOT state (RFC 2131 section 3.2), in stead of starting with a
+ * DISCOVER.  When the server does not answer, or declines the address, the
+ * normal DISCOVER process follows.
  */
 
-#ifndef ipconfigMAXIMUM_DISCOVER_TX_PERIOD
-    #ifdef _WINDOWS_
-        #define ipconfigMAXIMUM_DISCOVER_TX_PERIOD    pdMS_TO_TICKS( 999 )
-    #else
-        #define ipconfigMAXIMUM_DISCOVER_TX_PERIOD    pdMS_TO_TICKS( 30000 )
-    #endif
+#ifndef ipconfigDHCP_USE_INIT_REBOOT
+    #define ipconfigDHCP_USE_INIT_REBOOT    ipconfigDISABLE
 #endif
 
-STATIC_ASSERT( ipconfigMAXIMUM_DISCOVER_TX_PERIOD <= portMAX_DELAY );
+#if ( ( ipconfigDHCP_USE_INIT_REBOOT != ipconfigDISABLE ) && ( ipconfigDHCP_USE_INIT_REBOOT != ipconfigENABLE ) )
+    #error Invalid ipconfigDHCP_USE_INIT_REBOOT configuration
+#endif
 
 /*---------------------------------------------------------------------------*/
 
-/*===========================================================================*/
+/*
+ * ipconfigUSE_DHCP_LEASE_HOOK
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Lets the application keep the leased address in non-volatile memory, so
+ * that the INIT-REBOOT state can also be used after a reset.  The store hook
+ * is only called when the leased address changes.
+ *
+ * Requires ipconfigDHCP_USE_INIT_REBOOT to be enabled.
+ *
+ * Function prototypes:
+ *
+ * BaseType_t xApplicationDHCPLoadLease( const struct xNetworkEndPoint * pxEndPoint,
+ *                                       uint32_t * pulIPAddress );
+ *
+ * void vApplicationDHCPStoreLease( const struct xNetworkEndPoint * pxEndPoint,
+ *                                  uint32_t ulIPAddress );
+ */
+
+#ifndef ipconfigUSE_DHCP_LEASE_HOOK
+    #define ipconfigUSE_DHCP_LEASE_HOOK    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_DHCP_LEASE_HOOK != ipconfigDISABLE ) && ( ipconfigUSE_DHCP_LEASE_HOOK != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_DHCP_LEASE_HOOK configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP_LEASE_HOOK ) && ipconfigIS_DISABLED( ipconfigDHCP_USE_INIT_REBOOT ) )
+    #error ipconfigUSE_DHCP_LEASE_HOOK requires ipconfigDHCP_USE_INIT_REBOOT to be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDHCP_USE_RAPID_COMMIT
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Adds the Rapid Commit option (RFC 4039) to a DISCOVER.  A server that
+ * supports it answers with an ACK right away, so that an address is leased
+ * after a single round-trip.  An ACK without the Rapid Commit option is
+ * ignored in reply to a DISCOVER.
+ */
+
+#ifndef ipconfigDHCP_USE_RAPID_COMMIT
+    #define ipconfigDHCP_USE_RAPID_COMMIT    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigDHCP_USE_RAPID_COMMIT != ipconfigDISABLE ) && ( ipconfigDHCP_USE_RAPID_COMMIT != ipconfigENABLE ) )
+    #error Invalid ipconfigDHCP_USE_RAPID_COMMIT configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigMAXIMUM_DISCOVER_TX_PERIOD
+ *
+ * https://www.freertos.org/FreeRTOS-Plus/FreeRTOS_Plus_TCP/TCP_IP_Configuration.html#ipconfigMAXIMUM_DISCOVER_TX_PERIOD
+ *
+ * Type: TickType_t
+ * Unit: Ticks
+ * Minimum: 0
+ * Maximum: portMAX_DELAY
+ *
+ * Sets the max interval allowed between transmissions of DHCP requests before
+ * the default IP address will be used.
+ *
+ * When 'endpoint->bits.bWantDHCP' is set, DHCP requests will be sent out at
+ * increasing time intervals until either a reply is received from a DHCP
+ * server and accepted, or the interval between transmissions reaches
+ * ipconfigMAXIMUM_DISCOVER_TX_PERIOD. If no reply is received, the TCP/IP
+ * stack will revert to using the default IP address of the endpoint
+ * 'endpoint->ipv4_defaults.ulIPAddress' for IPv4 address or
+ * 'endpoint->ipv6_defaults.xIPAddress' for IPv6 address.
+ */
+
+#ifndef ipconfigMAXIMUM_DISCOVER_TX_PERIOD
+    #ifdef _WINDOWS_
+        #define ipconfigMAXIMUM_DISCOVER_TX_PERIOD    pdMS_TO_TICKS( 999 )
+    #else
+        #define ipconfigMAXIMUM_DISCOVER_TX_PERIOD    pdMS_TO_TICKS( 30000 )
+    #endif
+#endif
+
+STATIC_ASSERT( ipconfigMAXIMUM_DISCOVER_TX_PERIOD <= portMAX_DELAY );
+
+/*---------------------------------------------------------------------------*/
+
+/*===========================================================================*/
 /*                               DHCP CONFIG                                 */
 /*===========================================================================*/
 /*---------------------------------------------------------------------------*/
@@ -2550,6 +3131,99 @@ STATIC_ASSERT( ipconfigMAXIMUM_DISCOVER_TX_PERIOD <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigDNS_CACHE_HASH_BUCKETS
+ *
+ * Type: size_t
+ * Unit: count of hash buckets
+ * Minimum: 0
+ *
+ * When non-zero, the DNS cache keeps a hash index on the host name with this
+ * number of buckets, so that a look-up no longer compares the name with all
+ * ipconfigDNS_CACHE_ENTRIES entries. The hash and the comparison of names are
+ * case-insensitive. When the cache is full, the least recently used entry is
+ * replaced, in stead of the entries being overwritten in a round-robin way.
+ *
+ * The entries then do not contain a name buffer of
+ * ipconfigDNS_CACHE_NAME_LENGTH bytes; the names are stored with their actual
+ * length in an arena of ipconfigDNS_CACHE_NAME_ARENA_SIZE bytes. The IPv4 and
+ * the IPv6 entry of a host share the same copy of its name.
+ *
+ * Must be zero or a power of two.
+ */
+
+#ifndef ipconfigDNS_CACHE_HASH_BUCKETS
+    #define ipconfigDNS_CACHE_HASH_BUCKETS    ( 0 )
+#endif
+
+#if ( ipconfigDNS_CACHE_HASH_BUCKETS < 0 )
+    #error ipconfigDNS_CACHE_HASH_BUCKETS must be at least 0
+#endif
+
+#if ( ( ipconfigDNS_CACHE_HASH_BUCKETS & ( ipconfigDNS_CACHE_HASH_BUCKETS - 1 ) ) != 0 )
+    #error ipconfigDNS_CACHE_HASH_BUCKETS must be a power of two
+#endif
+
+#if ( ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) && ( ipconfigDNS_CACHE_ENTRIES > 65535 ) )
+    #error ipconfigDNS_CACHE_ENTRIES can be at most 65535 when ipconfigDNS_CACHE_HASH_BUCKETS is used
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_NAME_ARENA_SIZE
+ *
+ * Type: size_t
+ * Unit: bytes
+ * Minimum: 2
+ *
+ * The size of the arena in which the host names of the DNS cache are stored,
+ * when ipconfigDNS_CACHE_HASH_BUCKETS is non-zero. Each name takes its length
+ * plus one byte. When the arena is full, it is compacted, and if needed the
+ * least recently used entries are removed from the cache.
+ */
+
+#ifndef ipconfigDNS_CACHE_NAME_ARENA_SIZE
+    #define ipconfigDNS_CACHE_NAME_ARENA_SIZE    ( ipconfigDNS_CACHE_ENTRIES * 64U )
+#endif
+
+#if ( ipconfigDNS_CACHE_NAME_ARENA_SIZE < 2 )
+    #error ipconfigDNS_CACHE_NAME_ARENA_SIZE must be at least 2
+#endif
+
+#if ( ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) && ( ipconfigDNS_CACHE_NAME_ARENA_SIZE > 65535 ) )
+    #error ipconfigDNS_CACHE_NAME_ARENA_SIZE can be at most 65535 when ipconfigDNS_CACHE_HASH_BUCKETS is used
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_SERVE_STALE_SECONDS
+ *
+ * Type: uint32_t
+ * Unit: seconds
+ * Minimum: 0
+ *
+ * When non-zero, an entry of the DNS cache is kept for this many seconds after
+ * its TTL has expired. An expired entry is never used while a DNS server can
+ * be asked. Only when a look-up does not get an answer, because no DNS server
+ * could be reached, is the expired entry served instead (RFC 8767). This
+ * applies to FreeRTOS_gethostbyname(), FreeRTOS_getaddrinfo() and the
+ * asynchronous resolver.
+ *
+ * RFC 8767 suggests a value between one and three days.
+ */
+
+#ifndef ipconfigDNS_CACHE_SERVE_STALE_SECONDS
+    #define ipconfigDNS_CACHE_SERVE_STALE_SECONDS    ( 0U )
+#endif
+
+#if ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS < 0 )
+    #error ipconfigDNS_CACHE_SERVE_STALE_SECONDS must be at least 0
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigDNS_REQUEST_ATTEMPTS
  *
@@ -2658,6 +3332,191 @@ STATIC_ASSERT( ipconfigDNS_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigDNS_ASYNC_RESOLVER
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include the asynchronous DNS resolver: FreeRTOS_DNSResolveStart(),
+ * FreeRTOS_DNSResolveWait() and FreeRTOS_DNSResolveRelease().
+ *
+ * The resolver runs in the IP-task and uses a single UDP socket for all
+ * look-ups. Concurrent look-ups of the same name and record type share one
+ * query, and the A and AAAA queries of a look-up are sent at the same time.
+ * The result is either passed to a callback of type FOnDNSEvent, or it can
+ * be collected through the handle of the look-up.
+ *
+ * Each query is retransmitted after ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS, at
+ * most ipconfigDNS_REQUEST_ATTEMPTS times, using the next DNS server of the
+ * end-point. Names ending in ".local" are not handled by the resolver because
+ * mDNS replies are sent to port 5353.
+ *
+ * Requires ipconfigDNS_USE_CALLBACKS.
+ */
+
+#ifndef ipconfigDNS_ASYNC_RESOLVER
+    #define ipconfigDNS_ASYNC_RESOLVER    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigDNS_ASYNC_RESOLVER != ipconfigDISABLE ) && ( ipconfigDNS_ASYNC_RESOLVER != ipconfigENABLE ) )
+    #error Invalid ipconfigDNS_ASYNC_RESOLVER configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) && ipconfigIS_DISABLED( ipconfigDNS_USE_CALLBACKS ) )
+    #error ipconfigDNS_ASYNC_RESOLVER requires ipconfigDNS_USE_CALLBACKS to be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_RESOLVER_MAX_QUERIES
+ *
+ * Type: size_t
+ * Unit: count of queries
+ * Minimum: 1
+ * Maximum: 254
+ *
+ * The maximum number of DNS queries that the asynchronous resolver has
+ * outstanding at the same time. A look-up of both an IPv4 and an IPv6
+ * address uses two queries. Look-ups that can not get a query wait until
+ * another query has finished. Each query stores a copy of the host name, so
+ * it takes about ipconfigDNS_CACHE_NAME_LENGTH bytes of RAM.
+ *
+ * Only used when ipconfigDNS_ASYNC_RESOLVER is enabled.
+ */
+
+#ifndef ipconfigDNS_RESOLVER_MAX_QUERIES
+    #define ipconfigDNS_RESOLVER_MAX_QUERIES    ( 8U )
+#endif
+
+#if ( ipconfigDNS_RESOLVER_MAX_QUERIES < 1 )
+    #error ipconfigDNS_RESOLVER_MAX_QUERIES must be at least 1
+#endif
+
+#if ( ipconfigDNS_RESOLVER_MAX_QUERIES > 254 )
+    #error ipconfigDNS_RESOLVER_MAX_QUERIES must be at most 254
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigDNS_CACHE_PREFETCH_HITS
+ *
+ * Type: size_t
+ * Unit: count of look-ups
+ * Minimum: 0
+ * Maximum: 255
+ *
+ * When non-zero, the DNS cache counts the look-ups of each entry. An entry
+ * that was used at least this many times during its TTL, will be refreshed
+ * in the background when it is used during the last 10% of its TTL. The
+ * refresh is done by the asynchronous resolver, so that a popular name does
+ * not have to wait for a DNS server when its entry expires.
+ *
+ * Requires ipconfigUSE_DNS_CACHE and ipconfigDNS_ASYNC_RESOLVER.
+ */
+
+#ifndef ipconfigDNS_CACHE_PREFETCH_HITS
+    #define ipconfigDNS_CACHE_PREFETCH_HITS    ( 0U )
+#endif
+
+#if ( ipconfigDNS_CACHE_PREFETCH_HITS < 0 )
+    #error ipconfigDNS_CACHE_PREFETCH_HITS must be at least 0
+#endif
+
+#if ( ipconfigDNS_CACHE_PREFETCH_HITS > 255 )
+    #error ipconfigDNS_CACHE_PREFETCH_HITS must be at most 255
+#endif
+
+#if ( ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 ) && ( ipconfigIS_DISABLED( ipconfigUSE_DNS_CACHE ) || ipconfigIS_DISABLED( ipconfigDNS_ASYNC_RESOLVER ) ) )
+    #error ipconfigDNS_CACHE_PREFETCH_HITS requires ipconfigUSE_DNS_CACHE and ipconfigDNS_ASYNC_RESOLVER to be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigUSE_HAPPY_EYEBALLS
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include FreeRTOS_connect_by_name() and FreeRTOS_connect_addrinfo(), which
+ * connect a TCP socket to a host that may have both IPv6 and IPv4 addresses
+ * (Happy Eyeballs, RFC 8305). The addresses are tried in an order that
+ * alternates between the families, starting with IPv6. A new attempt is
+ * started every ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS, or as soon as an
+ * earlier attempt fails, without cancelling the attempts that are still in
+ * progress. The first socket that gets connected is returned, all others are
+ * closed. A network with broken IPv6 connectivity then costs one attempt
+ * delay instead of a full connect time-out. FreeRTOS_connect_by_name() sends
+ * the AAAA and A queries at the same time through the asynchronous resolver,
+ * and starts connecting as soon as the first of them is answered.
+ *
+ * Requires ipconfigUSE_TCP, ipconfigUSE_DNS, ipconfigDNS_ASYNC_RESOLVER and
+ * ipconfigSUPPORT_SELECT_FUNCTION.
+ */
+
+#ifndef ipconfigUSE_HAPPY_EYEBALLS
+    #define ipconfigUSE_HAPPY_EYEBALLS    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_HAPPY_EYEBALLS != ipconfigDISABLE ) && ( ipconfigUSE_HAPPY_EYEBALLS != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_HAPPY_EYEBALLS configuration
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_HAPPY_EYEBALLS ) && ( ipconfigIS_DISABLED( ipconfigUSE_TCP ) || ipconfigIS_DISABLED( ipconfigUSE_DNS ) || ipconfigIS_DISABLED( ipconfigDNS_ASYNC_RESOLVER ) || ipconfigIS_DISABLED( ipconfigSUPPORT_SELECT_FUNCTION ) ) )
+    #error ipconfigUSE_HAPPY_EYEBALLS requires ipconfigUSE_TCP, ipconfigUSE_DNS, ipconfigDNS_ASYNC_RESOLVER and ipconfigSUPPORT_SELECT_FUNCTION to be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS
+ *
+ * Type: uint32_t
+ * Unit: milliseconds
+ * Minimum: 10
+ * Maximum: 2000
+ *
+ * The "Connection Attempt Delay" of RFC 8305: the time after which the next
+ * address is tried while earlier connection attempts are still in progress.
+ * RFC 8305 recommends 250 ms.
+ */
+
+#ifndef ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS
+    #define ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS    ( 250U )
+#endif
+
+#if ( ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS < 10 )
+    #error ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS must be at least 10
+#endif
+
+#if ( ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS > 2000 )
+    #error ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS must be at most 2000
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS
+ *
+ * Type: size_t
+ * Unit: count of addresses
+ * Minimum: 1
+ *
+ * The maximum number of addresses of a host that will be tried. Each
+ * attempt that is in progress uses a TCP socket.
+ */
+
+#ifndef ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS
+    #define ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS    ( 4U )
+#endif
+
+#if ( ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS < 1 )
+    #error ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigUSE_LLMNR
  *
@@ -2728,6 +3587,56 @@ STATIC_ASSERT( ipconfigDNS_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigMDNS_CACHE_ENTRIES
+ *
+ * Type: size_t
+ * Unit: count of mDNS records
+ * Minimum: 0
+ *
+ * The number of records in the cache of the mDNS browser. When zero, the
+ * browser is not included and mDNS only answers queries for our own name.
+ *
+ * The browser sends continuous queries that were started with
+ * FreeRTOS_mDNSQuery(), see RFC 6762 section 5.2. Questions that are due are
+ * sent in a single message, along with the cached answers that are still
+ * valid, so that responders will not repeat them. The A, AAAA, PTR and SRV
+ * records that answer a question, or that belong to a PTR or SRV target that
+ * is in the cache, are stored. Every record takes about
+ * 2 * ipconfigDNS_CACHE_NAME_LENGTH bytes of RAM.
+ */
+
+#ifndef ipconfigMDNS_CACHE_ENTRIES
+    #define ipconfigMDNS_CACHE_ENTRIES    ( 0U )
+#endif
+
+#if ( ( ipconfigMDNS_CACHE_ENTRIES > 0 ) && ipconfigIS_DISABLED( ipconfigUSE_MDNS ) )
+    #error ipconfigMDNS_CACHE_ENTRIES requires ipconfigUSE_MDNS to be enabled
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigMDNS_MAX_QUESTIONS
+ *
+ * Type: size_t
+ * Unit: count of continuous queries
+ * Minimum: 1
+ *
+ * The maximum number of continuous mDNS queries that can be active at the
+ * same time. Only used when ipconfigMDNS_CACHE_ENTRIES is non-zero.
+ */
+
+#ifndef ipconfigMDNS_MAX_QUESTIONS
+    #define ipconfigMDNS_MAX_QUESTIONS    ( 4U )
+#endif
+
+#if ( ipconfigMDNS_MAX_QUESTIONS < 1 )
+    #error ipconfigMDNS_MAX_QUESTIONS must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*===========================================================================*/
 /*                                DNS CONFIG                                 */
 /*===========================================================================*/
@@ -2776,6 +3685,42 @@ STATIC_ASSERT( ipconfigDNS_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigARP_HASH_BUCKETS
+ *
+ * Type: size_t
+ * Unit: count of hash buckets
+ * Minimum: 0
+ *
+ * When non-zero, the ARP cache keeps a hash index on the IP-address with this
+ * number of buckets, so that looking up an address no longer scans all
+ * ipconfigARP_CACHE_ENTRIES entries. When a new address must be stored in a
+ * full cache, the least recently used entry will be replaced, in stead of
+ * the entry with the lowest age.
+ *
+ * Must be zero or a power of two. A value of about ipconfigARP_CACHE_ENTRIES
+ * keeps the hash chains short. The hash index uses 6 bytes per cache entry
+ * and 2 bytes per bucket.
+ */
+
+#ifndef ipconfigARP_HASH_BUCKETS
+    #define ipconfigARP_HASH_BUCKETS    ( 0 )
+#endif
+
+#if ( ipconfigARP_HASH_BUCKETS < 0 )
+    #error ipconfigARP_HASH_BUCKETS must be at least 0
+#endif
+
+#if ( ( ipconfigARP_HASH_BUCKETS & ( ipconfigARP_HASH_BUCKETS - 1 ) ) != 0 )
+    #error ipconfigARP_HASH_BUCKETS must be a power of two
+#endif
+
+#if ( ( ipconfigARP_HASH_BUCKETS > 0 ) && ( ipconfigARP_CACHE_ENTRIES > 65535 ) )
+    #error ipconfigARP_CACHE_ENTRIES can be at most 65535 when ipconfigARP_HASH_BUCKETS is used
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigARP_STORES_REMOTE_ADDRESSES
  *
@@ -2921,6 +3866,57 @@ STATIC_ASSERT( ipconfigDNS_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigPENDING_RESOLUTION_ADDRESSES
+ *
+ * Type: size_t
+ * Unit: count of addresses
+ * Minimum: 0
+ *
+ * A received packet whose source address is not in the ARP or ND cache will
+ * be held while the address is being resolved. By default, only a single
+ * packet can be held: while one address is being resolved, other packets
+ * that need a resolution are dropped.
+ *
+ * When non-zero, packets for up to this number of addresses can be held at
+ * the same time, each address with its own queue of up to
+ * ipconfigPENDING_RESOLUTION_PACKETS packets. The packets of an address are
+ * processed as soon as the ARP reply or neighbour advertisement arrives, or
+ * released when the resolution takes too long.
+ */
+
+#ifndef ipconfigPENDING_RESOLUTION_ADDRESSES
+    #define ipconfigPENDING_RESOLUTION_ADDRESSES    ( 0 )
+#endif
+
+#if ( ipconfigPENDING_RESOLUTION_ADDRESSES < 0 )
+    #error ipconfigPENDING_RESOLUTION_ADDRESSES must be at least 0
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigPENDING_RESOLUTION_PACKETS
+ *
+ * Type: size_t
+ * Unit: count of network buffers
+ * Minimum: 1
+ *
+ * The maximum number of packets that can be held per address, while that
+ * address is being resolved. Only used when ipconfigPENDING_RESOLUTION_ADDRESSES
+ * is non-zero.
+ */
+
+#ifndef ipconfigPENDING_RESOLUTION_PACKETS
+    #define ipconfigPENDING_RESOLUTION_PACKETS    ( 2 )
+#endif
+
+#if ( ipconfigPENDING_RESOLUTION_PACKETS < 1 )
+    #error ipconfigPENDING_RESOLUTION_PACKETS must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*
  * ipconfigUSE_ARP_REMOVE_ENTRY
  *
@@ -3040,6 +4036,73 @@ STATIC_ASSERT( ipconfigDNS_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigND_USE_REACHABILITY_STATES
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * When enabled, the entries of the ND cache follow the neighbour reachability
+ * states of RFC 4861: INCOMPLETE, REACHABLE, STALE, DELAY and PROBE. A
+ * REACHABLE entry becomes STALE after ipconfigMAX_ND_AGE periods of the ND
+ * timer. A STALE entry stays usable without sending solicitations; only when
+ * it is used, it will be probed with unicast solicitations. An INCOMPLETE
+ * entry sends its solicitations one second apart, and it is removed when three
+ * of them got no answer. When the cache is full, the oldest entry is
+ * replaced.
+ *
+ * When disabled, an entry is removed after ipconfigMAX_ND_AGE periods of the ND
+ * timer, unless it is refreshed in the mean time.
+ */
+
+#ifndef ipconfigND_USE_REACHABILITY_STATES
+    #define ipconfigND_USE_REACHABILITY_STATES    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigND_USE_REACHABILITY_STATES != ipconfigDISABLE ) && ( ipconfigND_USE_REACHABILITY_STATES != ipconfigENABLE ) )
+    #error Invalid ipconfigND_USE_REACHABILITY_STATES configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigND_HASH_BUCKETS
+ *
+ * Type: size_t
+ * Unit: count of hash buckets
+ * Minimum: 0
+ *
+ * When non-zero, the ND cache keeps a hash index on the IPv6 address with this
+ * number of buckets, so that looking up an address no longer scans all
+ * ipconfigND_CACHE_ENTRIES entries. The index is kept up-to-date by the code
+ * of the reachability states, so ipconfigND_USE_REACHABILITY_STATES must be
+ * enabled as well.
+ *
+ * Must be zero or a power of two. A value of about ipconfigND_CACHE_ENTRIES
+ * keeps the hash chains short.
+ */
+
+#ifndef ipconfigND_HASH_BUCKETS
+    #define ipconfigND_HASH_BUCKETS    ( 0 )
+#endif
+
+#if ( ipconfigND_HASH_BUCKETS < 0 )
+    #error ipconfigND_HASH_BUCKETS must be at least 0
+#endif
+
+#if ( ( ipconfigND_HASH_BUCKETS & ( ipconfigND_HASH_BUCKETS - 1 ) ) != 0 )
+    #error ipconfigND_HASH_BUCKETS must be a power of two
+#endif
+
+#if ( ( ipconfigND_HASH_BUCKETS > 0 ) && ( ipconfigND_CACHE_ENTRIES > 65535 ) )
+    #error ipconfigND_CACHE_ENTRIES can be at most 65535 when ipconfigND_HASH_BUCKETS is used
+#endif
+
+#if ( ( ipconfigND_HASH_BUCKETS > 0 ) && ( ipconfigND_USE_REACHABILITY_STATES == ipconfigDISABLE ) )
+    #error ipconfigND_HASH_BUCKETS needs ipconfigND_USE_REACHABILITY_STATES
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*===========================================================================*/
 /*                                ND CONFIG                                  */
 /*===========================================================================*/
@@ -3157,6 +4220,83 @@ STATIC_ASSERT( ipconfigDNS_SEND_BLOCK_TIME_TICKS <= portMAX_DELAY );
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * ipconfigUSE_ROUTE_TABLE
+ *
+ * Type: BaseType_t ( ipconfigENABLE | ipconfigDISABLE )
+ *
+ * Include a table of static routes, which can be added and removed at runtime
+ * with FreeRTOS_AddRoute() and FreeRTOS_RemoveRoute(). A route sends the
+ * packets for a network prefix to a gateway, or directly, through a given
+ * end-point. The routes are looked up with a longest-prefix match in a radix
+ * trie, one for IPv4 and one for IPv6.
+ *
+ * The table is only consulted for destinations that are not on the network of
+ * an end-point. When no route matches, the gateway of the first end-point that
+ * has one is used, as before.
+ */
+
+#ifndef ipconfigUSE_ROUTE_TABLE
+    #define ipconfigUSE_ROUTE_TABLE    ipconfigDISABLE
+#endif
+
+#if ( ( ipconfigUSE_ROUTE_TABLE != ipconfigDISABLE ) && ( ipconfigUSE_ROUTE_TABLE != ipconfigENABLE ) )
+    #error Invalid ipconfigUSE_ROUTE_TABLE configuration
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigROUTE_TABLE_ENTRIES
+ *
+ * Type: size_t
+ * Unit: count of routes
+ * Minimum: 1
+ *
+ * The maximum number of IPv4 and IPv6 routes together, when
+ * ipconfigUSE_ROUTE_TABLE is enabled. The nodes of the tries are taken from a
+ * static pool of twice this number.
+ */
+
+#ifndef ipconfigROUTE_TABLE_ENTRIES
+    #define ipconfigROUTE_TABLE_ENTRIES    ( 16 )
+#endif
+
+#if ( ipconfigROUTE_TABLE_ENTRIES < 1 )
+    #error ipconfigROUTE_TABLE_ENTRIES must be at least 1
+#endif
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * ipconfigROUTE_CACHE_ENTRIES
+ *
+ * Type: size_t
+ * Unit: count of destinations
+ * Minimum: 0
+ *
+ * The number of entries in the route cache, when ipconfigUSE_ROUTE_TABLE is
+ * enabled. The cache remembers the result of the route look-up for recently
+ * used destination addresses, including the destinations that have no route.
+ * It is emptied when a route is added or removed. Zero disables the cache.
+ *
+ * Must be zero or a power of two.
+ */
+
+#ifndef ipconfigROUTE_CACHE_ENTRIES
+    #define ipconfigROUTE_CACHE_ENTRIES    ( 8 )
+#endif
+
+#if ( ipconfigROUTE_CACHE_ENTRIES < 0 )
+    #error ipconfigROUTE_CACHE_ENTRIES must be at least 0
+#endif
+
+#if ( ( ipconfigROUTE_CACHE_ENTRIES & ( ipconfigROUTE_CACHE_ENTRIES - 1 ) ) != 0 )
+    #error ipconfigROUTE_CACHE_ENTRIES must be a power of two
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*===========================================================================*/
 /*                              ROUTING CONFIG                               */
 /*===========================================================================*/
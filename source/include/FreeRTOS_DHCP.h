@@ -79,6 +79,7 @@
 #define dhcpIPv4_SERVER_IP_ADDRESS_OPTION_CODE     ( 54U )     /**< Server Identifier. See RFC 2132. */
 #define dhcpIPv4_PARAMETER_REQUEST_OPTION_CODE     ( 55U )     /**< Parameter Request list. See RFC 2132. */
 #define dhcpIPv4_CLIENT_IDENTIFIER_OPTION_CODE     ( 61U )     /**<  Client Identifier. See RFC 2132. */
+#define dhcpIPv4_RAPID_COMMIT_OPTION_CODE          ( 80U )     /**< Rapid Commit. See RFC 4039. */
 
 /* The four DHCP message types of interest. */
 #define dhcpMESSAGE_TYPE_DISCOVER                  ( 1 )     /**< DHCP discover message. */
@@ -94,6 +95,8 @@
 #define dhcpDHCP_SERVER_IP_ADDRESS_OFFSET          ( 20U )     /**< Offset for the server IP-address option. */
 #define dhcpOPTION_50_OFFSET                       ( 12U )     /**< Offset of option-50. */
 #define dhcpOPTION_50_SIZE                         ( 6U )      /**< Number of bytes included in option-50. */
+#define dhcpOPTION_54_OFFSET                       ( 18U )     /**< Offset of option-54 in a request. */
+#define dhcpOPTION_54_SIZE                         ( 6U )      /**< Number of bytes included in option-54. */
 
 
 /* Values used in the DHCP packets. */
@@ -209,6 +212,13 @@ struct xDHCP_DATA
     Socket_t xDHCPSocket;
     /**< Record latest client ID for DHCPv6. */
     uint8_t ucClientDUID[ dhcpIPv6_CLIENT_DUID_LENGTH ];
+    #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_INIT_REBOOT ) )
+        uint32_t ulLastLeasedAddress; /**< The address of the last lease, which will be requested directly after a restart. */
+        BaseType_t xInitReboot;       /**< pdTRUE while the last leased address is being requested in the INIT-REBOOT state. */
+    #endif
+    #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_RAPID_COMMIT ) )
+        BaseType_t xRapidCommitAck;   /**< pdTRUE when a DISCOVER was answered with an ACK, see RFC 4039. */
+    #endif
 };
 
 typedef struct xDHCP_DATA DHCPData_t;
@@ -223,6 +233,10 @@ typedef struct xProcessSet
     uint32_t ulParameter;       /**< The uint32 value of the answer, if available. */
     uint32_t ulProcessed;       /**< The number of essential options that were parsed. */
     const uint8_t * pucByte;    /**< A pointer to the data to be analysed. */
+    #if ( ipconfigIS_ENABLED( ipconfigDHCP_USE_RAPID_COMMIT ) )
+        BaseType_t xRapidAck;    /**< An ACK was received while an OFFER was expected. */
+        BaseType_t xRapidCommit; /**< The Rapid Commit option was present. */
+    #endif
 } ProcessSet_t;
 
 
@@ -261,6 +275,21 @@ BaseType_t xIsDHCPSocket( const ConstSocket_t xSocket );
     #endif /* ( ipconfigIPv4_BACKWARD_COMPATIBLE == 1 ) */
 #endif /* ( ipconfigUSE_DHCP_HOOK != 0 ) */
 
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP_LEASE_HOOK ) )
+
+/* Prototypes of the hooks that must be provided by the application if
+ * ipconfigUSE_DHCP_LEASE_HOOK is enabled.  xApplicationDHCPLoadLease() is
+ * called when DHCP starts without a known lease, and returns pdTRUE when a
+ * stored address (network byte order) was written to 'pulIPAddress'.
+ * vApplicationDHCPStoreLease() is called when a new address was leased, or
+ * with zero when the server declined the stored address. */
+    BaseType_t xApplicationDHCPLoadLease( const struct xNetworkEndPoint * pxEndPoint,
+                                          uint32_t * pulIPAddress );
+
+    void vApplicationDHCPStoreLease( const struct xNetworkEndPoint * pxEndPoint,
+                                     uint32_t ulIPAddress );
+#endif /* ipconfigIS_ENABLED( ipconfigUSE_DHCP_LEASE_HOOK ) */
+
 #if ( ipconfigDHCP_FALL_BACK_AUTO_IP != 0 )
     struct xNetworkEndPoint;
 
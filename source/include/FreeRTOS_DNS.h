@@ -124,6 +124,70 @@ uint32_t ulDNSHandlePacket( const NetworkBufferDescriptor_t * pxNetworkBuffer );
 
 #endif /* if ( ipconfigDNS_USE_CALLBACKS != 0 ) */
 
+#if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+
+/** @brief The handle of a look-up of the asynchronous DNS resolver. */
+    typedef struct xDNS_RESOLVE_REQUEST * DNSResolveHandle_t;
+
+/*
+ * Start an asynchronous look-up of 'pcHostName'. The look-up is done by the
+ * IP-task, concurrent look-ups of the same name share their queries.
+ * xFamily is either FREERTOS_AF_INET4, FREERTOS_AF_INET6, or 0 to look up
+ * both in parallel. uxTimeout is in units of ms.
+ * When pCallback is not NULL, it will be called from the IP-task with the
+ * result, which will be released after the call.
+ * When pCallback is NULL, the result must be collected with
+ * FreeRTOS_DNSResolveWait().
+ * In both cases the handle must be released with FreeRTOS_DNSResolveRelease(),
+ * also after the callback has been called.
+ * Returns NULL when the look-up could not be started.
+ */
+    DNSResolveHandle_t FreeRTOS_DNSResolveStart( const char * pcHostName,
+                                                 BaseType_t xFamily,
+                                                 FOnDNSEvent pCallback,
+                                                 void * pvSearchID,
+                                                 TickType_t uxTimeout );
+
+/*
+ * Wait at most uxBlockTime clock ticks for the look-up to finish. Returns
+ * 0 when it has finished, in which case *ppxResult gets the list of addresses
+ * found, or NULL when nothing was found. The list must be released with
+ * FreeRTOS_freeaddrinfo(). Returns -pdFREERTOS_ERRNO_EWOULDBLOCK when the
+ * look-up has not finished yet.
+ */
+    BaseType_t FreeRTOS_DNSResolveWait( DNSResolveHandle_t xHandle,
+                                        TickType_t uxBlockTime,
+                                        struct freertos_addrinfo ** ppxResult );
+
+/*
+ * Release the handle of a look-up. A look-up that has not finished yet is
+ * cancelled, its callback will not be called.
+ */
+    void FreeRTOS_DNSResolveRelease( DNSResolveHandle_t xHandle );
+
+/* The functions below are called by the IP-task. */
+    void vDNSResolverInitialise( void );
+    void vDNSResolverHandleEvent( void * pvData );
+    void vDNSResolverCheck( void );
+    BaseType_t xIsDNSResolverSocket( ConstSocket_t xSocket );
+    BaseType_t xSendDNSResolverEvent( DNSResolveHandle_t xHandle );
+
+    #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+/* Refresh an entry of the DNS cache in the background. */
+        BaseType_t xDNSResolverPrefetch( const char * pcHostName,
+                                         BaseType_t xFamily );
+    #endif
+
+/* Send a single query for the resolver. When xNextServer is pdTRUE, the next
+ * DNS server of the end-point will be used. */
+    BaseType_t xDNSSendQuery( const char * pcHostName,
+                              TickType_t uxIdentifier,
+                              Socket_t xDNSSocket,
+                              BaseType_t xFamily,
+                              BaseType_t xNextServer );
+
+#endif /* if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) ) */
+
 /*
  * Lookup a IPv4 node in a blocking-way.
  * It returns a 32-bit IP-address, 0 when not found.
@@ -153,6 +217,60 @@ BaseType_t FreeRTOS_getaddrinfo( const char * pcName,                      /* Th
  */
 void FreeRTOS_freeaddrinfo( struct freertos_addrinfo * pxInfo );
 
+#if ( ipconfigIS_ENABLED( ipconfigUSE_HAPPY_EYEBALLS ) )
+
+/* Connect a TCP socket to the first of a list of addresses that answers,
+ * racing IPv6 and IPv4 attempts (RFC 8305). */
+    Socket_t FreeRTOS_connect_addrinfo( const struct freertos_addrinfo * pxAddresses,
+                                        uint16_t usPort,
+                                        TickType_t xBlockTimeTicks );
+
+/* Look up the IPv6 and IPv4 addresses of a host name in parallel, and race
+ * connection attempts to them as soon as the first look-up has answered. */
+    Socket_t FreeRTOS_connect_by_name( const char * pcHostName,
+                                       uint16_t usPort,
+                                       TickType_t xBlockTimeTicks );
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+
+/** @brief A record from the cache of the mDNS browser. */
+    typedef struct xMDNS_RECORD
+    {
+        char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ];   /**< The owner name of the record. */
+        char pcTarget[ ipconfigDNS_CACHE_NAME_LENGTH ]; /**< PTR: the name pointed to, SRV: the target host. */
+        IPv46_Address_t xAddress;                       /**< A and AAAA: the address of the host. */
+        uint32_t ulTTL;                                 /**< The remaining time-to-live in seconds. */
+        uint16_t usType;                                /**< dnsTYPE_A_HOST, dnsTYPE_AAAA_HOST, dnsTYPE_PTR or dnsTYPE_SRV. */
+        uint16_t usPriority;                            /**< SRV: the priority of the target host. */
+        uint16_t usWeight;                              /**< SRV: the weight of the target host. */
+        uint16_t usPort;                                /**< SRV: the port of the service, in host-endian order. */
+    } MDNSRecord_t;
+
+/* Start a continuous mDNS query for records of the given name and type.
+ * Answers are collected in the cache of the mDNS browser. */
+    BaseType_t FreeRTOS_mDNSQuery( const char * pcName,
+                                   uint16_t usType );
+
+/* Stop a continuous mDNS query. The cached records stay until they expire. */
+    void FreeRTOS_mDNSStopQuery( const char * pcName,
+                                 uint16_t usType );
+
+/* Copy the cached records of the given name and type. Returns the number of
+ * records copied. */
+    size_t FreeRTOS_mDNSLookup( const char * pcName,
+                                uint16_t usType,
+                                MDNSRecord_t * pxRecords,
+                                size_t uxMaxRecords );
+
+/* The functions below are called by the IP-task. */
+    void vMDNSHandleEvent( void );
+    void vMDNSCheck( void );
+    BaseType_t xMDNSProcessPacket( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                   const uint8_t * pucMessage,
+                                   size_t uxLength );
+#endif /* if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) ) */
+
 /* Sets the DNS IP preference while doing DNS lookup to indicate the preference
  * for a DNS server: either IPv4 or IPv6. Defaults to xPreferenceIPv4 */
 BaseType_t FreeRTOS_SetDNSIPPreference( IPPreference_t eIPPreference );
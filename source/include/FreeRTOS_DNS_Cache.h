@@ -44,13 +44,22 @@
     typedef struct xDNS_CACHE_TABLE_ROW
     {
         IPv46_Address_t xAddresses[ ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY ]; /*!< The IP address(es) of a DNS cache entry. */
-        char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ];                        /*!< The name of the host */
+        #if ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 )
+            uint32_t ulNameHash;                                             /*!< Case-insensitive hash of the name of the host */
+            uint16_t usNameOffset;                                           /*!< Offset plus one of the name in the name arena, zero for a free entry */
+        #else
+            char pcName[ ipconfigDNS_CACHE_NAME_LENGTH ];                    /*!< The name of the host */
+        #endif
         uint32_t ulTTL;                                                      /*!< Time-to-Live (in seconds) from the DNS server. */
         uint32_t ulTimeWhenAddedInSeconds;                                   /*!< time at which the entry was added */
         #if ( ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY > 1 )
             uint8_t ucNumIPAddresses;                                        /*!< number of ip addresses for the same entry */
             uint8_t ucCurrentIPAddress;                                      /*!< current ip address index */
         #endif
+        #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+            uint8_t ucHits;                                                  /*!< number of look-ups since the entry was stored, saturates at 255 */
+            uint8_t ucRefresh;                                               /*!< non-zero while a refresh of the entry is wanted or outstanding */
+        #endif
     } DNSCacheRow_t;
 
 /* Look for the indicated host name in the DNS cache. Returns the IPv4
@@ -79,6 +88,27 @@
     uint32_t Prepare_CacheLookup( const char * pcHostName,
                                   BaseType_t xFamily,
                                   struct freertos_addrinfo ** ppxAddressInfo );
+
+    #if ( ipconfigDNS_CACHE_SERVE_STALE_SECONDS > 0 )
+/* Look up a host name, also accepting an entry whose TTL has expired. */
+        uint32_t Prepare_StaleCacheLookup( const char * pcHostName,
+                                           BaseType_t xFamily,
+                                           struct freertos_addrinfo ** ppxAddressInfo );
+
+/* The same, storing the addresses in an array instead of a list. */
+        size_t uxDNSCacheReadStale( const char * pcHostName,
+                                    BaseType_t xFamily,
+                                    DNSAddressRecord_t * pxRecords,
+                                    size_t uxMaxRecords );
+    #endif
+
+    #if ( ipconfigDNS_CACHE_PREFETCH_HITS > 0 )
+/* Start the refreshes of popular entries, called by the IP-task. */
+        void vDNSCacheStartRefreshes( void );
+
+/* A refresh of the entry of 'pcName' has finished, with or without answers. */
+        void vDNSCacheRefreshDone( const char * pcName );
+    #endif
 #endif /* if ( ipconfigUSE_DNS_CACHE == 1 ) */
 
 #endif /* FREERTOS_DNS_CACHE_H */
@@ -64,10 +64,17 @@
         #define dnsNBNS_FLAGS_OPCODE_QUERY    0x0000U /**< NBNS opcode query. */
     #endif /* ( ipconfigUSE_NBNS == 1 ) */
 
+/* Flags of a DNS message, in host-endian order. */
+    #define dnsFLAGS_RESPONSE         0x8000U /**< The message is a response. */
+    #define dnsFLAGS_RCODE_MASK       0x000FU /**< The response code, zero when there is no error. */
+
 /* Host types. */
     #define dnsTYPE_A_HOST            0x01U /**< DNS type A host. */
     #define dnsTYPE_AAAA_HOST         0x001CU
     #define dnsTYPE_ANY_HOST          0x00FFU
+    #define dnsTYPE_CNAME             0x0005U /**< DNS type CNAME, an alias of another domain name. */
+    #define dnsTYPE_PTR               0x000CU /**< DNS type PTR, a pointer to another domain name. */
+    #define dnsTYPE_SRV               0x0021U /**< DNS type SRV, the location of a service (RFC 2782). */
 
     #define dnsCLASS_IN               0x01U /**< DNS class IN (Internet). */
 
@@ -198,6 +205,14 @@
         struct freertos_addrinfo * pxLastAddress;         /**< This variable is used while creating a linked-list of IP-addresses. */
         struct freertos_addrinfo ** ppxLastAddress;       /**< This variable is also used while creating a linked-list of IP-addresses. */
     } ParseSet_t;
+
+/** @brief An address that was found by DNS_ParseAddressRecords(). */
+    typedef struct xDNS_ADDRESS_RECORD
+    {
+        IPv46_Address_t xAddress; /**< The IPv4 or IPv6 address. */
+        uint32_t ulTTL;           /**< Time-to-Live in seconds, host-endian. */
+    } DNSAddressRecord_t;
+
     #if ( ipconfigUSE_LLMNR == 1 ) || ( ipconfigUSE_MDNS == 1 )
 
         #include "pack_struct_start.h"
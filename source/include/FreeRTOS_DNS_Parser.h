@@ -62,6 +62,53 @@
     size_t DNS_SkipNameField( const uint8_t * pucByte,
                               size_t uxLength );
 
+/*
+ * The only functions that read the labels of a name in a DNS message. They
+ * follow compression pointers, which must point backwards, and are shared by
+ * the DNS, LLMNR and mDNS code. DNS_ReadName() skips the name when pcName is
+ * NULL. Both return the offset after the name field, or zero when the name is
+ * malformed.
+ */
+    size_t DNS_ReadName( const uint8_t * pucMessage,
+                         size_t uxLength,
+                         size_t uxOffset,
+                         char * pcName,
+                         size_t uxNameSize );
+
+    size_t DNS_MatchName( const uint8_t * pucMessage,
+                          size_t uxLength,
+                          size_t uxOffset,
+                          const char * pcCompare,
+                          BaseType_t * pxMatch );
+
+/* Host names are compared and hashed without regard to case. */
+    uint8_t DNS_LowerCase( uint8_t ucChar );
+
+    BaseType_t DNS_NameEqual( const char * pcName1,
+                              const char * pcName2 );
+
+/*
+ * Parse a reply from a DNS server in a single pass, storing the A and AAAA
+ * records in a caller-supplied array. No memory is allocated.
+ */
+    BaseType_t DNS_ParseAddressRecords( const uint8_t * pucUDPPayloadBuffer,
+                                        size_t uxBufferLength,
+                                        const char * pcExpectedName,
+                                        DNSAddressRecord_t * pxRecords,
+                                        size_t uxMaxRecords );
+
+/* Create a struct freertos_addrinfo list of the addresses that were parsed. */
+    struct freertos_addrinfo * DNS_AddressRecordsToList( const char * pcName,
+                                                         const DNSAddressRecord_t * pxRecords,
+                                                         size_t uxCount );
+
+    #if ( ipconfigUSE_DNS_CACHE == 1 )
+/* Store the addresses of an expected reply in the DNS cache. */
+        void DNS_StoreAddressRecords( const char * pcName,
+                                      const DNSAddressRecord_t * pxRecords,
+                                      size_t uxCount );
+    #endif
+
 /*
  * Process a response packet from a DNS server.
  * The parameter 'xExpected' indicates whether the identifier in the reply
@@ -0,0 +1,113 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/**
+ * @file FreeRTOS_IGMP.h
+ * @brief Header file for multicast group membership: IGMP for IPv4 and MLD for IPv6.
+ */
+
+#ifndef FREERTOS_IGMP_H
+#define FREERTOS_IGMP_H
+
+/* FreeRTOS+TCP includes. */
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+#include "FreeRTOS_Routing.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+
+/** @brief The period of the multicast timer, which sends scheduled reports. */
+    #define ipMULTICAST_TIMER_PERIOD_MS    ( 100U )
+
+/*
+ * Let a UDP socket join a multicast group on an interface.  Called from
+ * FreeRTOS_setsockopt(), the IP-task sends the report.
+ */
+    BaseType_t xMulticastJoinGroup( FreeRTOS_Socket_t * pxSocket,
+                                    const IP_Address_t * pxGroupAddress,
+                                    BaseType_t xIsIPv6,
+                                    NetworkInterface_t * pxInterface );
+
+/*
+ * Let a UDP socket leave a multicast group that it has joined.
+ */
+    BaseType_t xMulticastLeaveGroup( FreeRTOS_Socket_t * pxSocket,
+                                     const IP_Address_t * pxGroupAddress,
+                                     BaseType_t xIsIPv6,
+                                     const NetworkInterface_t * pxInterface );
+
+/*
+ * Drop all the memberships of a socket that is being closed.
+ */
+    void vMulticastSocketClosed( FreeRTOS_Socket_t * pxSocket );
+
+/*
+ * Called by the IP-task when a socket has joined or left a group.
+ */
+    void vMulticastHandleEvent( void );
+
+/*
+ * Called by the IP-task when the multicast timer expires.
+ */
+    void vMulticastCheck( void );
+
+/*
+ * Send new reports for the groups of an interface, when an end-point goes up.
+ */
+    void vMulticastNetworkUp( const NetworkEndPoint_t * pxEndPoint );
+
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) )
+
+/*
+ * Process a received IGMP message.
+ */
+        eFrameProcessingResult_t eProcessIGMPPacket( const NetworkBufferDescriptor_t * const pxNetworkBuffer );
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+
+/*
+ * Process a received MLD query or MLDv1 report.
+ */
+        void vProcessMLDPacket( const NetworkBufferDescriptor_t * const pxNetworkBuffer );
+    #endif
+
+#endif /* ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_IGMP_H */
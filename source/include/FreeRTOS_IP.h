@@ -154,6 +154,12 @@ extern uint32_t ulApplicationGetNextSequenceNumber( uint32_t ulSourceAddress,
     #define DEBUG_SET_TRACE_VARIABLE( var, value )                                 /**< Empty definition since ipconfigHAS_PRINTF != 1. */
 #endif
 
+#if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+    /* Flags in the field 'ucChecksumFlags' of a network buffer. */
+    #define ipBUFFER_CHECKSUM_VERIFIED    0x01U /**< Set by a driver: the checksums of this received packet are correct. */
+    #define ipBUFFER_CHECKSUM_NEEDED      0x02U /**< Set by the stack: the driver must insert the checksums of this outgoing packet. */
+#endif
+
 /**
  * The structure used to store buffers and pass them around the network stack.
  * Buffers can be in use by the stack, in use by the network interface hardware
@@ -169,9 +175,24 @@ typedef struct xNETWORK_BUFFER
     struct xNetworkEndPoint * pxEndPoint;      /**< The end-point through which this packet shall be sent. */
     uint16_t usPort;                           /**< Source or destination port, depending on usage scenario. */
     uint16_t usBoundPort;                      /**< The port to which a transmitting socket is bound. */
-    #if ( ipconfigUSE_LINKED_RX_MESSAGES != 0 )
+    #if ( ( ipconfigUSE_LINKED_RX_MESSAGES != 0 ) || ( ipconfigUDP_SUPPORT_MMSG != 0 ) )
         struct xNETWORK_BUFFER * pxNextBuffer; /**< Possible optimisation for expert users - requires network driver support. */
     #endif
+    #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+        uint16_t usPayloadChecksum;       /**< The sum of the payload, calculated while it was copied into the buffer. */
+        uint16_t usPayloadChecksumLength; /**< The number of payload bytes in usPayloadChecksum, zero when there is no sum. */
+    #endif
+    #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+        uint8_t ucChecksumFlags; /**< ipBUFFER_CHECKSUM_VERIFIED and/or ipBUFFER_CHECKSUM_NEEDED. */
+    #endif
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+        struct xNETWORK_BUFFER * pxSharedOwner; /**< In a shared copy: the descriptor that owns the Ethernet buffer. */
+        uint8_t * pucOwnBuffer;                 /**< In a shared copy: its own Ethernet buffer, restored when it is released. */
+        uint16_t usShareCount;                  /**< In an owner: the number of descriptors that refer to its Ethernet buffer, zero when not shared. */
+    #endif
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) )
+        uint8_t ucGROFollows; /**< Set by the IP-task: the next frame of the receive burst continues the same TCP flow. */
+    #endif
 
 #define ul_IPAddress     xIPAddress.xIP_IPv4
 #define x_IPv6Address    xIPAddress.xIP_IPv6
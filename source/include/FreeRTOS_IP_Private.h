@@ -71,21 +71,27 @@ typedef enum eFrameProcessingResult
 typedef enum
 {
     eNoEvent = -1,
-    eNetworkDownEvent,    /* 0: The network interface has been lost and/or needs [re]connecting. */
-    eNetworkRxEvent,      /* 1: The network interface has queued a received Ethernet frame. */
-    eNetworkTxEvent,      /* 2: Let the IP-task send a network packet. */
-    eARPTimerEvent,       /* 3: The ARP timer expired. */
-    eNDTimerEvent,        /* 4: The ND timer expired. */
-    eStackTxEvent,        /* 5: The software stack has queued a packet to transmit. */
-    eDHCPEvent,           /* 6: Process the DHCP state machine. */
-    eTCPTimerEvent,       /* 7: See if any TCP socket needs attention. */
-    eTCPAcceptEvent,      /* 8: Client API FreeRTOS_accept() waiting for client connections. */
-    eTCPNetStat,          /* 9: IP-task is asked to produce a netstat listing. */
-    eSocketBindEvent,     /*10: Send a message to the IP-task to bind a socket to a port. */
-    eSocketCloseEvent,    /*11: Send a message to the IP-task to close a socket. */
-    eSocketSelectEvent,   /*12: Send a message to the IP-task for select(). */
-    eSocketSignalEvent,   /*13: A socket must be signalled. */
-    eSocketSetDeleteEvent /*14: A socket set must be deleted. */
+    eNetworkDownEvent,     /* 0: The network interface has been lost and/or needs [re]connecting. */
+    eNetworkRxEvent,       /* 1: The network interface has queued a received Ethernet frame. */
+    eNetworkTxEvent,       /* 2: Let the IP-task send a network packet. */
+    eARPTimerEvent,        /* 3: The ARP timer expired. */
+    eNDTimerEvent,         /* 4: The ND timer expired. */
+    eStackTxEvent,         /* 5: The software stack has queued a packet to transmit. */
+    eDHCPEvent,            /* 6: Process the DHCP state machine. */
+    eTCPTimerEvent,        /* 7: See if any TCP socket needs attention. */
+    eTCPAcceptEvent,       /* 8: Client API FreeRTOS_accept() waiting for client connections. */
+    eTCPNetStat,           /* 9: IP-task is asked to produce a netstat listing. */
+    eSocketBindEvent,      /*10: Send a message to the IP-task to bind a socket to a port. */
+    eSocketCloseEvent,     /*11: Send a message to the IP-task to close a socket. */
+    eSocketSelectEvent,    /*12: Send a message to the IP-task for select(). */
+    eSocketSignalEvent,    /*13: A socket must be signalled. */
+    eSocketSetDeleteEvent, /*14: A socket set must be deleted. */
+    eStackTxBatchEvent,    /*15: The software stack has queued a chain of UDP packets to transmit. */
+    eEPollDeleteEvent,     /*16: An epoll set must be deleted. */
+    eDNSResolverEvent,     /*17: A DNS look-up was started, or the DNS resolver socket has received a reply. */
+    eMDNSEvent,            /*18: A continuous mDNS query was started. */
+    eMulticastEvent,       /*19: A socket has joined or left a multicast group. */
+    eEPollCtlEvent         /*20: A socket was added to an epoll set or its events were changed. */
 } eIPEvent_t;
 
 /**
@@ -256,8 +262,34 @@ struct xPacketSummary
     ProtocolHeaders_t * pxProtocolHeaders; /**< Points to first byte after IP-header */
     uint16_t usPayloadLength;              /**< Property of IP-header (for IPv4: length of IP-header included) */
     uint16_t usProtocolBytes;              /**< The total length of the protocol data. */
+    #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+        uint16_t usPayloadChecksum;       /**< The sum of the last usPayloadChecksumLength bytes of the protocol data. */
+        size_t uxPayloadChecksumLength;   /**< The number of bytes that were summed in advance, or zero. */
+    #endif
 };
 
+/** @brief The classes of received frames, as determined by eClassifyFrame(). */
+typedef enum eFRAME_CLASS
+{
+    eFrameClassInvalid = 0, /**< The frame is too short or its headers are not valid. */
+    eFrameClassARP,         /**< An ARP packet. */
+    eFrameClassIPv4,        /**< An IPv4 packet. */
+    eFrameClassIPv6,        /**< An IPv6 packet. */
+    eFrameClassOther,       /**< Any other frame type, see ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES. */
+    eFrameClassCount        /**< The number of classes, not a class. */
+} eFrameClass_t;
+
+/** @brief The headers of a received frame, parsed once by eClassifyFrame() or by
+ * the IP-task, and passed on to the protocol handlers. */
+typedef struct xFRAME_SUMMARY
+{
+    eFrameClass_t eClass;       /**< The class of the frame. */
+    size_t uxIPHeaderLength;    /**< The length of the IPv4 header including options, or of the fixed IPv6 header. */
+    uint8_t ucProtocol;         /**< The IPv4 protocol or the IPv6 next header. */
+    uint16_t usSourcePort;      /**< The TCP or UDP source port in network byte order, or zero. */
+    uint16_t usDestinationPort; /**< The TCP or UDP destination port in network byte order, or zero. */
+} FrameSummary_t;
+
 /* Offset into the Ethernet frame that is used to temporarily store information
  * on the fragmentation status of the packet being sent.  The value is important,
  * as it is past the location into which the destination address will get placed. */
@@ -427,6 +459,17 @@ eFrameProcessingResult_t eARPProcessPacket( const NetworkBufferDescriptor_t * px
  */
 eFrameProcessingResult_t eConsiderFrameForProcessing( const uint8_t * const pucEthernetBuffer );
 
+#if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+
+/*
+ * Like eConsiderFrameForProcessing(), but also drops IP packets that are not
+ * for any end-point, and UDP/TCP packets to ports that have no socket.  Can be
+ * called by a network driver before it allocates a network buffer.
+ */
+    eFrameProcessingResult_t eFilterReceivedFrame( const uint8_t * const pucEthernetBuffer,
+                                                   size_t uxBufferLength );
+#endif
+
 /*
  * Return the checksum generated over xDataLengthBytes from pucNextData.
  */
@@ -434,6 +477,65 @@ uint16_t usGenerateChecksum( uint16_t usSum,
                              const uint8_t * pucNextData,
                              size_t uxByteCount );
 
+#if ( ipconfigCHECKSUM_KERNEL != ipconfigCHECKSUM_KERNEL_PORTABLE )
+
+/*
+ * Checksum kernels that return the same value as usGenerateChecksum().  The
+ * one selected by ipconfigCHECKSUM_KERNEL implements usGenerateChecksum(), the
+ * others are built when the compiler targets their instruction set.
+ */
+    uint16_t usGenerateChecksum64( uint16_t usSum,
+                                   const uint8_t * pucNextData,
+                                   size_t uxByteCount );
+
+    #if defined( __SSE2__ )
+        uint16_t usGenerateChecksumSSE2( uint16_t usSum,
+                                         const uint8_t * pucNextData,
+                                         size_t uxByteCount );
+    #elif ( ipconfigCHECKSUM_KERNEL == ipconfigCHECKSUM_KERNEL_SSE2 )
+        #error ipconfigCHECKSUM_KERNEL_SSE2 requires a compiler that targets SSE2
+    #endif
+
+    #if defined( __AVX2__ )
+        uint16_t usGenerateChecksumAVX2( uint16_t usSum,
+                                         const uint8_t * pucNextData,
+                                         size_t uxByteCount );
+    #elif ( ipconfigCHECKSUM_KERNEL == ipconfigCHECKSUM_KERNEL_AVX2 )
+        #error ipconfigCHECKSUM_KERNEL_AVX2 requires a compiler that targets AVX2
+    #endif
+
+    #if defined( __ARM_NEON )
+        uint16_t usGenerateChecksumNEON( uint16_t usSum,
+                                         const uint8_t * pucNextData,
+                                         size_t uxByteCount );
+    #elif ( ipconfigCHECKSUM_KERNEL == ipconfigCHECKSUM_KERNEL_NEON )
+        #error ipconfigCHECKSUM_KERNEL_NEON requires a compiler that targets NEON
+    #endif
+#endif /* ipconfigCHECKSUM_KERNEL != ipconfigCHECKSUM_KERNEL_PORTABLE */
+
+#if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+
+/*
+ * Copy an array of bytes, and return the same sum as usGenerateChecksum()
+ * would return for the copied bytes.
+ */
+    uint16_t usGenerateChecksumCopy( uint16_t usSum,
+                                     uint8_t * pucDestination,
+                                     const uint8_t * pucSource,
+                                     size_t uxByteCount );
+#endif /* ipconfigUSE_COPY_CHECKSUM != 0 */
+
+#if ( ipconfigUSE_INCREMENTAL_CHECKSUM != 0 )
+
+/*
+ * Adjust a checksum for a change of some fields in the data it covers, as
+ * described in RFC 1624.
+ */
+    uint16_t usAdjustChecksum( uint16_t usChecksum,
+                               uint16_t usOldSum,
+                               uint16_t usNewSum );
+#endif /* ipconfigUSE_INCREMENTAL_CHECKSUM != 0 */
+
 /* Socket related private functions. */
 
 /*
@@ -606,6 +708,12 @@ typedef struct UDPSOCKET
                                           */
         FOnUDPSent_t pxHandleSent;       /**< Function pointer to handle the events after a successful send. */
     #endif /* ipconfigUSE_CALLBACKS */
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+        uint32_t ulMulticastGroups; /**< One bit for every entry in the multicast group table that this socket has joined. */
+    #endif
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+        uint8_t ucReuseAddress; /**< Non-zero when FREERTOS_SO_REUSEADDR was set: the port may be shared with other sockets. */
+    #endif
 } IPUDPSocket_t;
 
 /* Formally typedef'd as eSocketEvent_t. */
@@ -659,7 +767,17 @@ struct xSOCKET
 
         EventBits_t xSocketBits;          /**< These bits indicate the events which have actually occurred.
                                            * They are maintained by the IP-task */
+        #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+            ListItem_t xSelectListItem; /**< Used to reference the socket from the lists of its socket set. */
+        #endif
     #endif /* ipconfigSUPPORT_SELECT_FUNCTION */
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+        struct xSOCKET_EPOLL * pxEPoll; /**< The epoll set that watches this socket, or NULL. */
+        ListItem_t xEPollListItem;      /**< Used to reference the socket from the ready list of the epoll set. */
+        ListItem_t xEPollMemberItem;    /**< Used to reference the socket from the member list of the epoll set. */
+        EventBits_t xEPollEvents;       /**< Events that occurred and that have not been reported yet. */
+        void * pvEPollData;             /**< User data, reported by FreeRTOS_epoll_wait(). */
+    #endif /* ipconfigSUPPORT_EPOLL */
     struct xNetworkEndPoint * pxEndPoint; /**< The end-point to which the socket is bound. */
 
     /* This field is only only by the user, and can be accessed with
@@ -711,6 +829,14 @@ struct xSOCKET
  */
 FreeRTOS_Socket_t * pxUDPSocketLookup( UBaseType_t uxLocalPort );
 
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+
+/*
+ * Find the next UDP socket that shares the port of a socket.
+ */
+    FreeRTOS_Socket_t * pxUDPSocketLookupNext( const FreeRTOS_Socket_t * pxSocket );
+#endif
+
 /*
  * Calculate the upper-layer checksum
  * Works both for UDP, ICMP and TCP packages
@@ -722,6 +848,55 @@ uint16_t usGenerateProtocolChecksum( uint8_t * pucEthernetBuffer,
                                      size_t uxBufferLength,
                                      BaseType_t xOutgoingPacket );
 
+#if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+
+/*
+ * Set the checksum of an outgoing UDP or TCP packet, using the sum of the
+ * payload that was stored in the network buffer while copying it.
+ */
+    uint16_t usGenerateProtocolChecksumCopied( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                               uint8_t * pucEthernetBuffer,
+                                               size_t uxBufferLength );
+#endif /* ipconfigUSE_COPY_CHECKSUM != 0 */
+
+#if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+
+/*
+ * Returns pdTRUE when the checksums of a received packet have been verified by
+ * the interface or by its driver.
+ */
+    BaseType_t xIsRxChecksumOffloaded( const NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/*
+ * Calculate the checksums of an outgoing packet when the interface through
+ * which it will be sent can not insert them.
+ */
+    void vPrepareTxChecksums( const struct xNetworkInterface * pxInterface,
+                              NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif /* ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 */
+
+/*
+ * Parse the headers of a received frame and return its class.
+ */
+eFrameClass_t eClassifyFrame( const uint8_t * pucEthernetBuffer,
+                              size_t uxBufferLength,
+                              FrameSummary_t * pxSummary );
+
+/*
+ * Calculate the RSS (Toeplitz) hash over the addresses and ports of a received frame.
+ */
+uint32_t ulFrameFlowHash( const uint8_t * pucEthernetBuffer,
+                          const FrameSummary_t * pxSummary );
+
+#if ( ipconfigRX_WORKER_TASKS > 0 )
+
+/*
+ * Verify the checksums of a received frame, and mark it when they are correct.
+ */
+    void vVerifyRxChecksums( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                             const FrameSummary_t * pxSummary );
+#endif /* ( ipconfigRX_WORKER_TASKS > 0 ) */
+
 /*
  * An Ethernet frame has been updated (maybe it was an ARP request or a PING
  * request?) and is to be sent back to its source.
@@ -820,6 +995,24 @@ size_t uxIPHeaderSizeSocket( const FreeRTOS_Socket_t * pxSocket );
 /* Returns pdTRUE is this function is called from the IP-task */
 BaseType_t xIsCallingFromIPTask( void );
 
+#if ( ipconfigPENDING_RESOLUTION_ADDRESSES > 0 )
+    /* Hold a received packet until its source address has been resolved. */
+    BaseType_t xPendingResolutionAdd( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                      BaseType_t xIsIPv6 );
+
+    /* Hold a generated packet until the address of its next hop has been resolved. */
+    BaseType_t xPendingResolutionAddOutgoing( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                              const IP_Address_t * pxNextHop,
+                                              BaseType_t xIsIPv6 );
+
+    /* Process the packets that were waiting for an address that has been resolved. */
+    BaseType_t xPendingResolutionFlush( const IP_Address_t * pxAddress,
+                                        BaseType_t xIsIPv6 );
+
+    /* Release the packets of addresses that could not be resolved in time. */
+    void vPendingResolutionTimeout( BaseType_t xIsIPv6 );
+#endif
+
 #if ( ipconfigSUPPORT_SELECT_FUNCTION == 1 )
 
 /** @brief Structure for event groups of the Socket Select functions */
@@ -828,9 +1021,49 @@ BaseType_t xIsCallingFromIPTask( void );
         /** @brief Event group for the socket select function.
          */
         EventGroupHandle_t xSelectGroup;
+        #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+            List_t xChangedList; /**< Members whose state may have changed since the last evaluation. */
+            List_t xActiveList;  /**< Members that had events during the last evaluation. */
+        #endif
     } SocketSelect_t;
 
-    extern void vSocketSelect( const SocketSelect_t * pxSocketSet );
+    extern void vSocketSelect( SocketSelect_t * pxSocketSet );
+
+    #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+        /* Mark a socket as changed, so that the next vSocketSelect() will evaluate it. */
+        void vSocketSelectChanged( FreeRTOS_Socket_t * pxSocket );
+
+        /* Take a socket out of the lists of its socket set. */
+        void vSocketSelectRemove( FreeRTOS_Socket_t * pxSocket );
+
+        /* Take all sockets out of the lists of a socket set that is being deleted. */
+        void vSocketSelectRemoveAll( SocketSelect_t * pxSocketSet );
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+
+/** @brief Structure for the epoll functions. */
+        typedef struct xSOCKET_EPOLL
+        {
+            EventGroupHandle_t xEPollGroup; /**< Used to wake-up a task blocked in FreeRTOS_epoll_wait(). */
+            List_t xReadyList;              /**< The sockets that have unreported events. */
+            List_t xMemberList;             /**< All sockets that were added to the set, bound or not. */
+        } SocketEPoll_t;
+
+/* Called by the IP-task when events have occurred for a socket. */
+        void vSocketEPollReady( FreeRTOS_Socket_t * pxSocket,
+                                EventBits_t xEvents );
+
+/* Called by the IP-task to report the events that are already active
+ * when a socket is added to an epoll set, or when its events are changed. */
+        void vSocketEPollCtl( FreeRTOS_Socket_t * pxSocket );
+
+/* Called by the IP-task to remove the socket from its epoll set. */
+        void vSocketEPollRemove( FreeRTOS_Socket_t * pxSocket );
+
+/* Called by the IP-task to delete an epoll set. */
+        void vSocketEPollDelete( SocketEPoll_t * pxEPoll );
+    #endif /* ipconfigSUPPORT_EPOLL */
 
 /** @brief Define the data that must be passed for a 'eSocketSelectEvent'. */
     typedef struct xSocketSelectMessage
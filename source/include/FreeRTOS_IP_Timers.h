@@ -54,6 +54,16 @@
 #include "NetworkBufferManagement.h"
 #include "FreeRTOS_DNS.h"
 
+/** @brief Defines how often the ND resolution timer callback function is executed.  The time is
+ * shorter in the Windows simulator as simulated time is not real time. */
+#ifndef ipND_TIMER_PERIOD_MS
+    #ifdef _WINDOWS_
+        #define ipND_TIMER_PERIOD_MS    ( 500U ) /* For windows simulator builds. */
+    #else
+        #define ipND_TIMER_PERIOD_MS    ( 10000U )
+    #endif
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     extern "C" {
@@ -107,6 +117,11 @@ void vIPSetTCPTimerExpiredState( BaseType_t xExpiredState );
  */
     void vNDTimerReload( TickType_t xTime );
 
+/*
+ * Let the ND timer expire once after a given time, it keeps its reload time.
+ */
+    void vNDTimerStart( TickType_t xTime );
+
 /*
  * Start an ND Resolution timer.
  */
@@ -143,6 +158,33 @@ void vIPSetTCPTimerExpiredState( BaseType_t xExpiredState );
     void vIPSetDNSTimerEnableState( BaseType_t xEnableState );
 #endif /* ipconfigDNS_USE_CALLBACKS != 0 */
 
+#if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+
+/**
+ * @brief Enable/disable the timer of the asynchronous DNS resolver.
+ * @param[in] xEnableState: pdTRUE - enable timer; pdFALSE - disable timer.
+ */
+    void vIPSetDNSResolverTimerEnableState( BaseType_t xEnableState );
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+
+/**
+ * @brief Enable/disable the timer of the mDNS browser.
+ * @param[in] xEnableState: pdTRUE - enable timer; pdFALSE - disable timer.
+ */
+    void vIPSetMDNSTimerEnableState( BaseType_t xEnableState );
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+
+/**
+ * @brief Enable/disable the timer of the IGMP and MLD reports.
+ * @param[in] xEnableState: pdTRUE - enable timer; pdFALSE - disable timer.
+ */
+    void vIPSetMulticastTimerEnableState( BaseType_t xEnableState );
+#endif
+
 /**
  * Sets the reload time of an TCP timer and restarts it.
  */
@@ -161,6 +203,30 @@ void vTCPTimerReload( TickType_t xTime );
     void vDNSTimerReload( uint32_t ulCheckTime );
 #endif /* ipconfigDNS_USE_CALLBACKS != 0 */
 
+#if ( ipconfigIS_ENABLED( ipconfigDNS_ASYNC_RESOLVER ) )
+
+/**
+ * Reload the timer of the asynchronous DNS resolver.
+ */
+    void vDNSResolverTimerReload( TickType_t xTime );
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigUSE_MDNS ) && ( ipconfigMDNS_CACHE_ENTRIES > 0 ) )
+
+/**
+ * Reload the timer of the mDNS browser.
+ */
+    void vMDNSTimerReload( TickType_t xTime );
+#endif
+
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+
+/**
+ * Reload the timer of the IGMP and MLD reports.
+ */
+    void vMulticastTimerReload( TickType_t xTime );
+#endif
+
 /**
  * Reload the Network timer.
  */
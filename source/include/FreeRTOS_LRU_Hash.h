@@ -0,0 +1,136 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ *  FreeRTOS_LRU_Hash.h
+ *
+ *  A hash index and an LRU list for a fixed array of cache entries.  The
+ *  caches (ARP, ND, DNS) own their entries and their keys: they calculate
+ *  a 32-bit hash of a key and compare the keys themselves.  This module only
+ *  keeps the links between the entries, which are referred to by their index.
+ */
+
+#ifndef FREERTOS_LRU_HASH_H
+#define FREERTOS_LRU_HASH_H
+
+/* Application level configuration options. */
+#include "FreeRTOSIPConfig.h"
+#include "FreeRTOSIPConfigDefaults.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/** @brief The module is only needed when one of the caches uses a hash index. */
+#define lruHASH_IS_USED                                                   \
+    ( ( ipconfigARP_HASH_BUCKETS > 0 ) || ( ipconfigND_HASH_BUCKETS > 0 ) || \
+      ( ipconfigDNS_CACHE_HASH_BUCKETS > 0 ) )
+
+#if ( lruHASH_IS_USED )
+
+/** @brief The type of a link.  An entry number is stored plus one, so that zero
+ * means "no entry", and the tables are valid when they are zero-initialised. */
+    typedef uint16_t LRUHashLink_t;
+
+/** @brief The links of one cache entry. */
+    typedef struct xLRU_HASH_LINKS
+    {
+        LRUHashLink_t xHashNext; /**< The next entry in the same hash bucket. */
+        LRUHashLink_t xLRUPrev;  /**< The more recently used entry. */
+        LRUHashLink_t xLRUNext;  /**< The less recently used entry. */
+    } LRUHashLinks_t;
+
+/** @brief A hash index and an LRU list.  The LRU list runs from the most recently
+ * used entry (head) to the least recently used entry (tail).  Only the entries
+ * that have been taken into use can be in the list. */
+    typedef struct xLRU_HASH_TABLE
+    {
+        LRUHashLink_t * pxHeads;  /**< The first entry in each hash bucket. */
+        LRUHashLinks_t * pxLinks; /**< The links of each cache entry. */
+        size_t uxBucketCount;     /**< The number of buckets, a power of two. */
+        size_t uxEntryCount;      /**< The number of cache entries, at most 65535. */
+        LRUHashLink_t xLRUHead;   /**< The most recently used entry. */
+        LRUHashLink_t xLRUTail;   /**< The least recently used entry. */
+        size_t uxEntriesUsed;     /**< The number of entries that have been taken into use. */
+    } LRUHashTable_t;
+
+/** @brief Initialiser of a static LRUHashTable_t, for a hash index that is stored
+ * in the arrays 'xHeads' and 'xLinks'. */
+    #define lruHASH_TABLE_INIT( xHeads, xLinks )                \
+    {                                                           \
+        ( xHeads ),                                             \
+        ( xLinks ),                                             \
+        sizeof( xHeads ) / sizeof( ( xHeads )[ 0 ] ),           \
+        sizeof( xLinks ) / sizeof( ( xLinks )[ 0 ] ),           \
+        0U,                                                     \
+        0U,                                                     \
+        0U                                                      \
+    }
+
+    BaseType_t xLRUHashFirst( const LRUHashTable_t * pxTable,
+                              uint32_t ulHash );
+
+    BaseType_t xLRUHashNext( const LRUHashTable_t * pxTable,
+                             BaseType_t xEntry );
+
+    void vLRUHashInsert( LRUHashTable_t * pxTable,
+                         uint32_t ulHash,
+                         BaseType_t xEntry );
+
+    void vLRUHashRemove( LRUHashTable_t * pxTable,
+                         uint32_t ulHash,
+                         BaseType_t xEntry );
+
+    void vLRUHashTouch( LRUHashTable_t * pxTable,
+                        BaseType_t xEntry );
+
+    void vLRUHashRelease( LRUHashTable_t * pxTable,
+                          BaseType_t xEntry );
+
+    void vLRUHashUnlink( LRUHashTable_t * pxTable,
+                         BaseType_t xEntry );
+
+    BaseType_t xLRUHashTake( LRUHashTable_t * pxTable );
+
+    BaseType_t xLRUHashOldest( const LRUHashTable_t * pxTable );
+
+    BaseType_t xLRUHashNewer( const LRUHashTable_t * pxTable,
+                              BaseType_t xEntry );
+
+    void vLRUHashClear( LRUHashTable_t * pxTable );
+
+#endif /* lruHASH_IS_USED */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    } /* extern "C" */
+#endif
+/* *INDENT-ON* */
+
+#endif /* FREERTOS_LRU_HASH_H */
@@ -45,6 +45,22 @@
 /* Miscellaneous structure and definitions. */
 /*-----------------------------------------------------------*/
 
+    #if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) )
+
+/**
+ * @brief The reachability states of an ND cache entry, as described in RFC 4861.
+ */
+        typedef enum eND_CACHE_STATE
+        {
+            eNDStateUnused = 0, /* 0 The entry is free. */
+            eNDStateIncomplete, /* 1 Address resolution is in progress, the MAC-address is not known yet. */
+            eNDStateReachable,  /* 2 The neighbour was recently known to be reachable. */
+            eNDStateStale,      /* 3 Reachability is unknown, nothing is done until the entry is used. */
+            eNDStateDelay,      /* 4 The stale entry was used, probing will start unless it gets confirmed. */
+            eNDStateProbe       /* 5 Unicast solicitations are sent to confirm the reachability. */
+        } eNDCacheState_t;
+    #endif /* if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) ) */
+
 /**
  * @brief 'NDCacheRow_t' defines one row in the ND address cache.
  * @note About A value that is periodically decremented but can
@@ -59,6 +75,10 @@
                                                * remote device had responded. */
         uint8_t ucAge;                        /**< See here above. */
         uint8_t ucValid;                      /**< pdTRUE: xMACAddress is valid, pdFALSE: waiting for ND reply */
+        #if ( ipconfigIS_ENABLED( ipconfigND_USE_REACHABILITY_STATES ) )
+            uint8_t ucState;                  /**< The reachability state, an eNDCacheState_t. */
+            TickType_t xStateTime;            /**< The time of the last state change or solicitation. */
+        #endif
     } NDCacheRow_t;
 
 /*
@@ -59,6 +59,12 @@
     typedef void ( * NetworkInterfaceMACFilterFunction_t ) ( struct xNetworkInterface * pxInterface,
                                                              const uint8_t * pucMacAddressBytes );
 
+    #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+        /* Flags in the field 'ucChecksumOffload' of a network interface. */
+        #define ipINTERFACE_CHECKSUM_OFFLOAD_RX    0x01U /**< The interface drops received packets with a wrong IP, TCP, UDP or ICMP checksum. */
+        #define ipINTERFACE_CHECKSUM_OFFLOAD_TX    0x02U /**< The interface inserts the IP, TCP, UDP and ICMP checksums of outgoing packets. */
+    #endif
+
 /** @brief These NetworkInterface access functions are collected in a struct: */
     typedef struct xNetworkInterface
     {
@@ -107,9 +113,14 @@
         {
             uint32_t
                 bInterfaceUp : 1,             /**< Non-zero as soon as the interface is up. */
-                bCallDownEvent : 1;           /**< The down-event must be called. */
+                bCallDownEvent : 1,           /**< The down-event must be called. */
+                bThreadSafeOutput : 1;        /**< pfOutput() may be called from any task, see ipconfigUDP_DIRECT_SEND. */
         } bits;                               /**< A collection of boolean flags. */
 
+        #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            uint8_t ucChecksumOffload; /**< The checksum offloading capabilities, see ipINTERFACE_CHECKSUM_OFFLOAD_RX/TX. */
+        #endif
+
         struct xNetworkEndPoint * pxEndPoint; /**< A list of end-points bound to this interface. */
         struct xNetworkInterface * pxNext;    /**< The next interface in a linked list. */
     } NetworkInterface_t;
@@ -319,6 +330,40 @@
  * xIPType should equal ipTYPE_IPv4 or ipTYPE_IPv6. */
     NetworkEndPoint_t * FreeRTOS_FindGateWay( BaseType_t xIPType );
 
+    #if ( ipconfigIS_ENABLED( ipconfigUSE_ROUTE_TABLE ) )
+
+/* Add a static route to a network prefix, or replace the route to that prefix.
+ * The IP-type of the route is the type of the end-point.  pxGateway may be
+ * NULL or zero for a network that is reached directly through the end-point.
+ * Returns 0 or a negative errno value. */
+        BaseType_t FreeRTOS_AddRoute( const IP_Address_t * pxDestination,
+                                      size_t uxPrefixLength,
+                                      const IP_Address_t * pxGateway,
+                                      NetworkEndPoint_t * pxEndPoint );
+
+/* Remove the route to a network prefix.  xIPType should equal ipTYPE_IPv4
+ * or ipTYPE_IPv6.  Returns 0 or a negative errno value. */
+        BaseType_t FreeRTOS_RemoveRoute( const IP_Address_t * pxDestination,
+                                         size_t uxPrefixLength,
+                                         BaseType_t xIPType );
+
+        #if ( ipconfigUSE_IPv4 != 0 )
+
+/* Find the route with the longest prefix that matches an IPv4 address.
+ * Returns its end-point and stores the next hop, or returns NULL. */
+            NetworkEndPoint_t * FreeRTOS_FindRoute_IPv4( uint32_t ulIPAddress,
+                                                         uint32_t * pulNextHop );
+        #endif
+
+        #if ( ipconfigUSE_IPv6 != 0 )
+
+/* Find the route with the longest prefix that matches an IPv6 address.
+ * Returns its end-point and stores the next hop, or returns NULL. */
+            NetworkEndPoint_t * FreeRTOS_FindRoute_IPv6( const IPv6_Address_t * pxIPAddress,
+                                                         IPv6_Address_t * pxNextHop );
+        #endif
+    #endif /* ipconfigIS_ENABLED( ipconfigUSE_ROUTE_TABLE ) */
+
 /* Fill-in the end-point structure. */
     void FreeRTOS_FillEndPoint( NetworkInterface_t * pxNetworkInterface,
                                 NetworkEndPoint_t * pxEndPoint,
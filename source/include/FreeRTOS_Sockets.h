@@ -150,6 +150,21 @@
     #if ( ipconfigUSE_TCP == 1 )
         #define FREERTOS_SO_SET_LOW_HIGH_WATER            ( 18 )
     #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+        #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) )
+            #define FREERTOS_SO_IP_ADD_MEMBERSHIP      ( 19 ) /* Join an IPv4 multicast group, parameter is a pointer to struct freertos_ip_mreq (UDP only). */
+            #define FREERTOS_SO_IP_DROP_MEMBERSHIP     ( 20 ) /* Leave an IPv4 multicast group, parameter is a pointer to struct freertos_ip_mreq (UDP only). */
+        #endif
+        #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+            #define FREERTOS_SO_IPV6_ADD_MEMBERSHIP    ( 21 ) /* Join an IPv6 multicast group, parameter is a pointer to struct freertos_ipv6_mreq (UDP only). */
+            #define FREERTOS_SO_IPV6_DROP_MEMBERSHIP   ( 22 ) /* Leave an IPv6 multicast group, parameter is a pointer to struct freertos_ipv6_mreq (UDP only). */
+        #endif
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+        #define FREERTOS_SO_REUSEADDR    ( 23 ) /* Allow other sockets to bind to the same UDP port, set before binding. Parameter is a pointer to a BaseType_t. */
+    #endif
     #define FREERTOS_INADDR_ANY                           ( 0U )           /* The 0.0.0.0 IPv4 address. */
     #define FREERTOS_INADDR_BROADCAST                     ( 0xffffffffUL ) /* 255.255.255.255 is a special broadcast address that represents all host attached to the physical network. */
 
@@ -190,6 +205,37 @@
 /** Introduce a short name to make casting easier. */
     typedef struct freertos_sockaddr   xFreertosSocAddr;
 
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) )
+
+        struct xNetworkInterface;
+
+        #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv4 ) )
+
+/**
+ * Structure to pass for the options FREERTOS_SO_IP_ADD_MEMBERSHIP and
+ * FREERTOS_SO_IP_DROP_MEMBERSHIP.
+ */
+            struct freertos_ip_mreq
+            {
+                uint32_t imr_multiaddr; /**< The IPv4 multicast group, in network byte order. */
+                uint32_t imr_interface; /**< The IPv4 address of the end-point whose interface is used, or FREERTOS_INADDR_ANY for the interface of the first IPv4 end-point. */
+            };
+        #endif
+
+        #if ( ipconfigIS_ENABLED( ipconfigUSE_IPv6 ) )
+
+/**
+ * Structure to pass for the options FREERTOS_SO_IPV6_ADD_MEMBERSHIP and
+ * FREERTOS_SO_IPV6_DROP_MEMBERSHIP.
+ */
+            struct freertos_ipv6_mreq
+            {
+                IPv6_Address_t ipv6mr_multiaddr;             /**< The IPv6 multicast group. */
+                struct xNetworkInterface * ipv6mr_interface; /**< The interface to use, or NULL for the interface of the first IPv6 end-point. */
+            };
+        #endif
+    #endif /* ipconfigIS_ENABLED( ipconfigSUPPORT_IP_MULTICAST ) */
+
 /* The socket type itself. */
     struct xSOCKET;
     typedef struct xSOCKET             * Socket_t;
@@ -267,6 +313,33 @@
                                struct freertos_sockaddr * pxSourceAddress,
                                socklen_t * pxSourceAddressLength );
 
+    #if ( ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) )
+
+/**
+ * One message of a batch passed to FreeRTOS_recvmmsg() or FreeRTOS_sendmmsg().
+ */
+        struct freertos_mmsghdr
+        {
+            void * pvBuffer;                   /**< The payload buffer, or the zero-copy payload pointer. */
+            size_t uxBufferLength;             /**< Size of the buffer (receive) or number of bytes to send. */
+            struct freertos_sockaddr xAddress; /**< The source (receive) or destination (send) address. */
+            socklen_t xAddressLength;          /**< Receive: set to the size of 'xAddress', or zero when no packet was stored. */
+            int32_t lLength;                   /**< Set to the number of bytes received or sent, zero for a message that was not used. */
+        };
+
+/* Receive several packets from a UDP socket in a single call. */
+        int32_t FreeRTOS_recvmmsg( const ConstSocket_t xSocket,
+                                   struct freertos_mmsghdr * pxMessages,
+                                   size_t uxMessageCount,
+                                   BaseType_t xFlags );
+
+/* Send several packets to a UDP socket, using a single event to the IP-task. */
+        int32_t FreeRTOS_sendmmsg( Socket_t xSocket,
+                                   struct freertos_mmsghdr * pxMessages,
+                                   size_t uxMessageCount,
+                                   BaseType_t xFlags );
+    #endif /* ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) */
+
 
 /* Function to get the local address and IP port. */
     size_t FreeRTOS_GetLocalAddress( ConstSocket_t xSocket,
@@ -277,6 +350,12 @@
         BaseType_t xPortHasUDPSocket( uint16_t usPortNr );
     #endif
 
+    #if ( ipconfigUSE_EARLY_RX_FILTER != 0 )
+/* Returns false if no UDP or TCP socket is bound to the port number, may have false positives. */
+        BaseType_t xPortMayHaveSocket( uint8_t ucProtocol,
+                                       uint16_t usPortNr );
+    #endif
+
 /* End UDP Socket Attributes */
 
 
@@ -561,6 +640,47 @@
         EventBits_t FreeRTOS_FD_ISSET( const ConstSocket_t xSocket,
                                        const ConstSocketSet_t xSocketSet );
 
+        #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+
+/* The EPoll_t type is the equivalent to an epoll file descriptor. */
+            struct xSOCKET_EPOLL;
+            typedef struct xSOCKET_EPOLL * EPoll_t;
+
+/* Operations for FreeRTOS_epoll_ctl(). */
+            #define FREERTOS_EPOLL_CTL_ADD    ( 1 )
+            #define FREERTOS_EPOLL_CTL_MOD    ( 2 )
+            #define FREERTOS_EPOLL_CTL_DEL    ( 3 )
+
+/**
+ * An event as reported by FreeRTOS_epoll_wait().
+ */
+            struct freertos_epoll_event
+            {
+                Socket_t xSocket;    /**< The socket that had an event. */
+                EventBits_t xEvents; /**< The events that occurred, a combination of eSELECT_READ, eSELECT_WRITE and eSELECT_EXCEPT. */
+                void * pvData;       /**< The user data passed to FreeRTOS_epoll_ctl(). */
+            };
+
+/* Create an epoll set. */
+            EPoll_t FreeRTOS_epoll_create( void );
+
+/* Delete an epoll set. */
+            void FreeRTOS_epoll_delete( EPoll_t xEPoll );
+
+/* Add, modify or delete the interest of an epoll set in a socket. */
+            BaseType_t FreeRTOS_epoll_ctl( EPoll_t xEPoll,
+                                           BaseType_t xOperation,
+                                           Socket_t xSocket,
+                                           EventBits_t xEvents,
+                                           void * pvData );
+
+/* Wait until at least one socket in the epoll set has an event. */
+            BaseType_t FreeRTOS_epoll_wait( EPoll_t xEPoll,
+                                            struct freertos_epoll_event * pxEvents,
+                                            BaseType_t xMaxEvents,
+                                            TickType_t xBlockTimeTicks );
+        #endif /* ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) */
+
     #endif /* ( ipconfigSUPPORT_SELECT_FUNCTION == 1 ) */
 
 
@@ -92,6 +92,14 @@ size_t uxStreamBufferGet( StreamBuffer_t * const pxBuffer,
                           size_t uxMaxCount,
                           BaseType_t xPeek );
 
+#if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+    size_t uxStreamBufferGetChecksum( const StreamBuffer_t * const pxBuffer,
+                                      size_t uxOffset,
+                                      uint8_t * const pucData,
+                                      size_t uxMaxCount,
+                                      uint16_t * pusChecksum );
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     } /* extern "C" */
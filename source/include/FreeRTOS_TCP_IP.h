@@ -190,6 +190,17 @@ void prvTCPTouchSocket( struct xSOCKET * pxSocket );
  */
 TickType_t prvTCPNextTimeout( struct xSOCKET * pxSocket );
 
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) )
+
+/*
+ * Called by the IP-task for every frame of a linked receive burst, just before
+ * the frame is processed.  Tells the TCP layer whether the next frame continues
+ * the same flow, so that the state handling can be done once per run.
+ */
+    void vTCPGROPrepare( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                         const NetworkBufferDescriptor_t * pxNextBuffer );
+#endif
+
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
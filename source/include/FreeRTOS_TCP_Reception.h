@@ -57,6 +57,24 @@ BaseType_t prvStoreRxData( FreeRTOS_Socket_t * pxSocket,
                            NetworkBufferDescriptor_t * pxNetworkBuffer,
                            uint32_t ulReceiveLength );
 
+#if ( ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) )
+
+/*
+ * Called by the IP-task for each frame of a linked receive burst.  Returns
+ * pdTRUE when the next frame continues the same TCP flow in sequence.
+ */
+    BaseType_t xTCPGROIsContinuation( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                      const NetworkBufferDescriptor_t * pxNextBuffer );
+
+/*
+ * Called from xProcessReceivedTCPPacket().  Store the payload of a segment
+ * whose state handling is left to the next segment of the same burst.
+ */
+    BaseType_t xTCPGROStoreSegment( FreeRTOS_Socket_t * pxSocket,
+                                    NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+#endif /* ipconfigIS_ENABLED( ipconfigUSE_TCP_GRO ) */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     } /* extern "C" */
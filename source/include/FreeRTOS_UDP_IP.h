@@ -44,9 +44,31 @@
  */
 void vProcessGeneratedUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+/*
+ * Called for a chain of packets that was passed by FreeRTOS_sendmmsg().
+ */
+#if ( ipconfigIS_ENABLED( ipconfigUDP_SUPPORT_MMSG ) )
+    void vProcessGeneratedUDPPacketBatch( NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif
+
 void vProcessGeneratedUDPPacket_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer );
 void vProcessGeneratedUDPPacket_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer );
 
+#if ( ipconfigIS_ENABLED( ipconfigUDP_DIRECT_SEND ) )
+
+/*
+ * Called by FreeRTOS_sendto() to send a packet without the help of the IP-task.
+ * Returns pdFALSE when the packet must be passed to the IP-task after all.
+ */
+    BaseType_t xSendGeneratedUDPPacketDirect( NetworkBufferDescriptor_t * const pxNetworkBuffer );
+
+    BaseType_t xSendGeneratedUDPPacketDirect_IPv4( NetworkBufferDescriptor_t * const pxNetworkBuffer );
+    BaseType_t xSendGeneratedUDPPacketDirect_IPv6( NetworkBufferDescriptor_t * const pxNetworkBuffer );
+
+/* Returns pdTRUE if the end-point may be used by tasks other than the IP-task. */
+    BaseType_t xUDPDirectSendAllowed( const struct xNetworkEndPoint * pxEndPoint );
+#endif
+
 /*
  * The caller must ensure that pxNetworkBuffer->xDataLength is the UDP packet
  * payload size (excluding packet headers) and that the packet in pucEthernetBuffer
@@ -655,6 +655,22 @@
 
 /*---------------------------------------------------------------------------*/
 
+/*
+ * iptracePENDING_RESOLUTION_PACKET_LOST
+ *
+ * An ARP reply or neighbour advertisement was received for an address that
+ * packets were waiting for, but one of the packets could not be passed to the
+ * IP-task again because the network event queue was full (see the
+ * ipconfigEVENT_QUEUE_LENGTH setting in FreeRTOSIPConfig.h). The packet is
+ * dropped. eEventType is eNetworkRxEvent for a received packet, and
+ * eStackTxEvent for a packet generated by the stack.
+ */
+#ifndef iptracePENDING_RESOLUTION_PACKET_LOST
+    #define iptracePENDING_RESOLUTION_PACKET_LOST( eEventType )
+#endif
+
+/*---------------------------------------------------------------------------*/
+
 /*===========================================================================*/
 /*                              ND TRACE MACROS                              */
 /*===========================================================================*/
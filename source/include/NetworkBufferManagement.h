@@ -65,6 +65,25 @@ UBaseType_t uxGetMinimumFreeNetworkBuffers( void );
 NetworkBufferDescriptor_t * pxDuplicateNetworkBufferWithDescriptor( const NetworkBufferDescriptor_t * const pxNetworkBuffer,
                                                                     size_t uxNewLength );
 
+#if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+
+/* Get a descriptor that refers to the Ethernet buffer of another one, without
+ * copying it. */
+    NetworkBufferDescriptor_t * pxShareNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* Called by vReleaseNetworkBufferAndDescriptor(): returns pdFALSE while other
+ * descriptors still refer to the Ethernet buffer. */
+    BaseType_t xReleaseSharedNetworkBuffer( NetworkBufferDescriptor_t * pxNetworkBuffer );
+
+/* The same, called by vNetworkBufferReleaseFromISR(), which must release the
+ * owner that is returned in ppxOwner. */
+    BaseType_t xReleaseSharedNetworkBufferFromISR( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                                   NetworkBufferDescriptor_t ** ppxOwner );
+
+/* Release a shared copy, while the owner keeps its reference to the Ethernet buffer. */
+    NetworkBufferDescriptor_t * pxUnshareNetworkBuffer( NetworkBufferDescriptor_t * pxNetworkBuffer );
+#endif
+
 /* Increase the size of a Network Buffer.
  * In case BufferAllocation_2.c is used, the new space must be allocated. */
 NetworkBufferDescriptor_t * pxResizeNetworkBufferWithDescriptor( NetworkBufferDescriptor_t * pxNetworkBuffer,
@@ -295,6 +295,20 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
                 pxReturn->pxInterface = NULL;
                 pxReturn->pxEndPoint = NULL;
 
+                #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+                {
+                    /* The buffer does not have a sum of its payload yet. */
+                    pxReturn->usPayloadChecksumLength = 0U;
+                }
+                #endif
+
+                #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+                {
+                    /* Checksums are neither verified nor needed yet. */
+                    pxReturn->ucChecksumFlags = 0U;
+                }
+                #endif
+
                 #if ( ipconfigTCP_IP_SANITY != 0 )
                 {
                     prvShowWarnings();
@@ -364,17 +378,45 @@ NetworkBufferDescriptor_t * pxNetworkBufferGetFromISR( size_t xRequestedSizeByte
 BaseType_t vNetworkBufferReleaseFromISR( NetworkBufferDescriptor_t * const pxNetworkBuffer )
 {
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    BaseType_t xReleaseNow = pdTRUE;
 
-    /* Ensure the buffer is returned to the list of free buffers before the
-     * counting semaphore is 'given' to say a buffer is available. */
-    ipconfigBUFFER_ALLOC_LOCK_FROM_ISR();
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+        NetworkBufferDescriptor_t * pxOwner = NULL;
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
     {
-        vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+        /* Keep the buffer while other descriptors still refer to it. */
+        xReleaseNow = xReleaseSharedNetworkBufferFromISR( pxNetworkBuffer, &( pxOwner ) );
     }
-    ipconfigBUFFER_ALLOC_UNLOCK_FROM_ISR();
+    #endif
 
-    ( void ) xSemaphoreGiveFromISR( xNetworkBufferSemaphore, &xHigherPriorityTaskWoken );
-    iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+    if( xReleaseNow != pdFALSE )
+    {
+        /* Ensure the buffer is returned to the list of free buffers before the
+         * counting semaphore is 'given' to say a buffer is available. */
+        ipconfigBUFFER_ALLOC_LOCK_FROM_ISR();
+        {
+            vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+        }
+        ipconfigBUFFER_ALLOC_UNLOCK_FROM_ISR();
+
+        ( void ) xSemaphoreGiveFromISR( xNetworkBufferSemaphore, &xHigherPriorityTaskWoken );
+        iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+    }
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+    {
+        if( pxOwner != NULL )
+        {
+            /* A shared copy dropped its reference on the owner. */
+            if( vNetworkBufferReleaseFromISR( pxOwner ) != pdFALSE )
+            {
+                xHigherPriorityTaskWoken = pdTRUE;
+            }
+        }
+    }
+    #endif
 
     return xHigherPriorityTaskWoken;
 }
@@ -383,12 +425,25 @@ BaseType_t vNetworkBufferReleaseFromISR( NetworkBufferDescriptor_t * const pxNet
 void vReleaseNetworkBufferAndDescriptor( NetworkBufferDescriptor_t * const pxNetworkBuffer )
 {
     BaseType_t xListItemAlreadyInFreeList;
+    BaseType_t xReleaseNow = pdTRUE;
 
     if( bIsValidNetworkDescriptor( pxNetworkBuffer ) == pdFALSE_UNSIGNED )
     {
         FreeRTOS_debug_printf( ( "vReleaseNetworkBufferAndDescriptor: Invalid buffer %p\n", pxNetworkBuffer ) );
+        xReleaseNow = pdFALSE;
     }
-    else
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+    {
+        /* Keep the buffer while other descriptors still refer to it. */
+        if( xReleaseNow != pdFALSE )
+        {
+            xReleaseNow = xReleaseSharedNetworkBuffer( pxNetworkBuffer );
+        }
+    }
+    #endif
+
+    if( xReleaseNow != pdFALSE )
     {
         /* Ensure the buffer is returned to the list of free buffers before the
          * counting semaphore is 'given' to say a buffer is available. */
@@ -325,6 +325,20 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
             /* Allocate storage of exactly the requested size to the buffer. */
             configASSERT( pxReturn->pucEthernetBuffer == NULL );
 
+            #if ( ipconfigUSE_COPY_CHECKSUM != 0 )
+            {
+                /* The buffer does not have a sum of its payload yet. */
+                pxReturn->usPayloadChecksumLength = 0U;
+            }
+            #endif
+
+            #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+            {
+                /* Checksums are neither verified nor needed yet. */
+                pxReturn->ucChecksumFlags = 0U;
+            }
+            #endif
+
             if( xRequestedSizeBytesCopy > 0U )
             {
                 /* Extra space is obtained so a pointer to the network buffer can
@@ -394,43 +408,54 @@ NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor( size_t xRequestedS
 void vReleaseNetworkBufferAndDescriptor( NetworkBufferDescriptor_t * const pxNetworkBuffer )
 {
     BaseType_t xListItemAlreadyInFreeList;
+    BaseType_t xReleaseNow = pdTRUE;
 
-    /* Ensure the buffer is returned to the list of free buffers before the
-    * counting semaphore is 'given' to say a buffer is available.  Release the
-    * storage allocated to the buffer payload.  THIS FILE SHOULD NOT BE USED
-    * IF THE PROJECT INCLUDES A MEMORY ALLOCATOR THAT WILL FRAGMENT THE HEAP
-    * MEMORY.  For example, heap_2 must not be used, heap_4 can be used. */
-    vReleaseNetworkBuffer( pxNetworkBuffer->pucEthernetBuffer );
-    pxNetworkBuffer->pucEthernetBuffer = NULL;
-    pxNetworkBuffer->xDataLength = 0U;
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_UDP_REUSEADDR ) )
+    {
+        /* Keep the buffer while other descriptors still refer to it. */
+        xReleaseNow = xReleaseSharedNetworkBuffer( pxNetworkBuffer );
+    }
+    #endif
 
-    taskENTER_CRITICAL();
+    if( xReleaseNow != pdFALSE )
     {
-        xListItemAlreadyInFreeList = listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+        /* Ensure the buffer is returned to the list of free buffers before the
+        * counting semaphore is 'given' to say a buffer is available.  Release the
+        * storage allocated to the buffer payload.  THIS FILE SHOULD NOT BE USED
+        * IF THE PROJECT INCLUDES A MEMORY ALLOCATOR THAT WILL FRAGMENT THE HEAP
+        * MEMORY.  For example, heap_2 must not be used, heap_4 can be used. */
+        vReleaseNetworkBuffer( pxNetworkBuffer->pucEthernetBuffer );
+        pxNetworkBuffer->pucEthernetBuffer = NULL;
+        pxNetworkBuffer->xDataLength = 0U;
+
+        taskENTER_CRITICAL();
+        {
+            xListItemAlreadyInFreeList = listIS_CONTAINED_WITHIN( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
 
+            if( xListItemAlreadyInFreeList == pdFALSE )
+            {
+                vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /*
+         * Update the network state machine, unless the program fails to release its 'xNetworkBufferSemaphore'.
+         * The program should only try to release its semaphore if 'xListItemAlreadyInFreeList' is false.
+         */
         if( xListItemAlreadyInFreeList == pdFALSE )
         {
-            vListInsertEnd( &xFreeBuffersList, &( pxNetworkBuffer->xBufferListItem ) );
+            if( xSemaphoreGive( xNetworkBufferSemaphore ) == pdTRUE )
+            {
+                iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
+            }
         }
-    }
-    taskEXIT_CRITICAL();
-
-    /*
-     * Update the network state machine, unless the program fails to release its 'xNetworkBufferSemaphore'.
-     * The program should only try to release its semaphore if 'xListItemAlreadyInFreeList' is false.
-     */
-    if( xListItemAlreadyInFreeList == pdFALSE )
-    {
-        if( xSemaphoreGive( xNetworkBufferSemaphore ) == pdTRUE )
+        else
         {
+            /* No action. */
             iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
         }
     }
-    else
-    {
-        /* No action. */
-        iptraceNETWORK_BUFFER_RELEASED( pxNetworkBuffer );
-    }
 }
 /*-----------------------------------------------------------*/
 
@@ -104,6 +104,14 @@ NetworkInterface_t * pxLoopback_FillInterfaceDescriptor( BaseType_t xEMACIndex,
     pxInterface->pfOutput = prvLoopback_Output;
     pxInterface->pfGetPhyLinkStatus = prvLoopback_GetPhyLinkStatus;
 
+    #if ( ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD != 0 )
+    {
+        /* Looped-back packets never travel over a wire, their checksums
+         * do not have to be calculated nor verified. */
+        pxInterface->ucChecksumOffload = ( uint8_t ) ( ipINTERFACE_CHECKSUM_OFFLOAD_RX | ipINTERFACE_CHECKSUM_OFFLOAD_TX );
+    }
+    #endif
+
     FreeRTOS_AddNetworkInterface( pxInterface );
     xLoopbackInterface = pxInterface;
 
@@ -40,13 +40,29 @@
 #define ipconfigUSE_ARP_REMOVE_ENTRY               1
 #define ipconfigARP_STORES_REMOTE_ADDRESSES        1
 #define ipconfigUSE_LINKED_RX_MESSAGES             1
+#define ipconfigUSE_TCP_GRO                        1
 #define ipconfigFORCE_IP_DONT_FRAGMENT             1
 #define ipconfigUDP_PASS_ZERO_CHECKSUM_PACKETS     1
+#define ipconfigCHECKSUM_KERNEL                    ipconfigCHECKSUM_KERNEL_64BIT
+#define ipconfigUSE_COPY_CHECKSUM                  1
+#define ipconfigUSE_INCREMENTAL_CHECKSUM           1
+#define ipconfigUSE_INTERFACE_CHECKSUM_OFFLOAD     1
+#define ipconfigUSE_EARLY_RX_FILTER                1
+#if ( defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 ) )
+    #define ipconfigRX_WORKER_TASKS                2
+#endif
+#define ipconfigSUPPORT_IP_MULTICAST               1
+#define ipconfigSUPPORT_UDP_REUSEADDR              1
+#define ipconfigUSE_ROUTE_TABLE                    1
 #define ipconfigDHCP_FALL_BACK_AUTO_IP             1
+#define ipconfigDHCP_USE_INIT_REBOOT               1
+#define ipconfigUSE_DHCP_LEASE_HOOK                1
+#define ipconfigDHCP_USE_RAPID_COMMIT              1
 #define ipconfigARP_USE_CLASH_DETECTION            1
 #define ipconfigUSE_LLMNR                          1
 #define ipconfigUSE_NBNS                           1
 #define ipconfigUSE_MDNS                           1
+#define ipconfigMDNS_CACHE_ENTRIES                 16U
 #define ipconfigSUPPORT_OUTGOING_PINGS             1
 #define ipconfigETHERNET_DRIVER_FILTERS_PACKETS    1
 #define ipconfigZERO_COPY_TX_DRIVER                1
@@ -55,8 +71,13 @@
 #define ipconfigSOCKET_HAS_USER_SEMAPHORE          1
 #define ipconfigSELECT_USES_NOTIFY                 1
 #define ipconfigSUPPORT_SIGNALS                    1
+#define ipconfigSUPPORT_EPOLL                      1
+#define ipconfigSELECT_INCREMENTAL                 1
+#define ipconfigUDP_DIRECT_SEND                    1
+#define ipconfigUDP_SUPPORT_MMSG                   1
 #define ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES     1
 #define ipconfigDNS_USE_CALLBACKS                  1
+#define ipconfigDNS_ASYNC_RESOLVER                 1
 #define ipconfigCOMPATIBLE_WITH_SINGLE             1
 #define ipconfigIGNORE_UNKNOWN_PACKETS             1
 #define ipconfigCHECK_IP_QUEUE_SPACE               1
@@ -107,6 +128,10 @@
  */
 #define ipconfigUSE_DNS_CACHE                      ( 1 )
 #define ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY      ( 6 )
+#define ipconfigDNS_CACHE_HASH_BUCKETS             4
+#define ipconfigDNS_CACHE_SERVE_STALE_SECONDS      ( 86400U )
+#define ipconfigDNS_CACHE_PREFETCH_HITS            ( 2U )
+#define ipconfigUSE_HAPPY_EYEBALLS                 1
 #define ipconfigDNS_REQUEST_ATTEMPTS               ( 2 )
 
 /* The IP stack executes it its own task (although any application task can make
@@ -182,6 +207,11 @@
  * required MAC address information.  ipconfigARP_CACHE_ENTRIES defines the maximum
  * number of entries that can exist in the ARP table at any one time. */
 #define ipconfigARP_CACHE_ENTRIES                  6
+#define ipconfigARP_HASH_BUCKETS                   8
+#define ipconfigND_USE_REACHABILITY_STATES         1
+#define ipconfigND_HASH_BUCKETS                    8
+#define ipconfigPENDING_RESOLUTION_ADDRESSES       4
+#define ipconfigPENDING_RESOLUTION_PACKETS         2
 
 /* ARP requests that do not result in an ARP response will be re-transmitted a
  * maximum of ipconfigMAX_ARP_RETRANSMISSIONS times before the ARP request is
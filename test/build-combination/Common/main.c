@@ -337,6 +337,21 @@ struct xNetworkInterface * pxFillInterfaceDescriptor( BaseType_t xEMACIndex,
     }
 #endif /* ( ipconfigUSE_DHCP_HOOK != 0 ) */
 
+#if ( ipconfigIS_ENABLED( ipconfigUSE_DHCP_LEASE_HOOK ) )
+    BaseType_t xApplicationDHCPLoadLease( const struct xNetworkEndPoint * pxEndPoint,
+                                          uint32_t * pulIPAddress )
+    {
+        /* Provide a stub for this function. */
+        return pdFALSE;
+    }
+
+    void vApplicationDHCPStoreLease( const struct xNetworkEndPoint * pxEndPoint,
+                                     uint32_t ulIPAddress )
+    {
+        /* Provide a stub for this function. */
+    }
+#endif /* ipconfigIS_ENABLED( ipconfigUSE_DHCP_LEASE_HOOK ) */
+
 #if ( ipconfigPROCESS_CUSTOM_ETHERNET_FRAMES != 0 )
 
 /*
@@ -80,6 +80,9 @@ void harness()
 
     __CPROVER_assume( pxSet.pucByte != NULL );
 
+    /* The name is read on its own, compression pointers are not followed. */
+    pxSet.pucUDPPayloadBuffer = NULL;
+
     /* Avoid overflow on uxSourceLen - 1U with uxSourceLen == uxRemainingBytes */
     /*__CPROVER_assume(uxRemainingBytes > 0); */
 
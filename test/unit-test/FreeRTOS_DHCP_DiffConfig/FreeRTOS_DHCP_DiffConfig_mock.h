@@ -0,0 +1,11 @@
+#include "FreeRTOS_DHCP.h"
+
+eDHCPCallbackAnswer_t xApplicationDHCPHook_Multi( eDHCPCallbackPhase_t eDHCPPhase,
+                                                  struct xNetworkEndPoint * pxEndPoint,
+                                                  IP_Address_t * pxIPAddress );
+
+BaseType_t xApplicationDHCPLoadLease( const struct xNetworkEndPoint * pxEndPoint,
+                                      uint32_t * pulIPAddress );
+
+void vApplicationDHCPStoreLease( const struct xNetworkEndPoint * pxEndPoint,
+                                 uint32_t ulIPAddress );
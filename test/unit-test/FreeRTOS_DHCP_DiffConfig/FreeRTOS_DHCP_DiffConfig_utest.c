@@ -0,0 +1,468 @@
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_task.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_DHCP_DiffConfig_mock.h"
+#include "mock_FreeRTOS_IP_Common.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+
+#include "FreeRTOS_DHCP.h"
+
+#include "FreeRTOS_DHCP_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/*-------------------------------------Extern Variables--------------------------*/
+
+void vDHCPProcessEndPoint( BaseType_t xReset,
+                           BaseType_t xDoCheck,
+                           NetworkEndPoint_t * pxEndPoint );
+
+extern Socket_t xDHCPv4Socket;
+extern BaseType_t xDHCPSocketUserCount;
+
+static const char * pcHostName = "Unit-Test";
+
+/* The address of the DHCP server, and the address that it leases. */
+static const uint32_t ulServerAddress = 0x0100A8C0; /* 192.168.0.1 */
+static const uint32_t ulLeasedAddress = 0x0A00A8C0; /* 192.168.0.10 */
+
+/* The options of the last message that was passed to FreeRTOS_sendto(). */
+static uint8_t ucSentOptions[ 64 ];
+
+/*-------------------------------------Helpers--------------------------------*/
+
+static int32_t FreeRTOS_sendto_SaveOptions( Socket_t xSocket,
+                                            const void * pvBuffer,
+                                            size_t uxTotalDataLength,
+                                            BaseType_t xFlags,
+                                            const struct freertos_sockaddr * pxDestinationAddress,
+                                            socklen_t xDestinationAddressLength,
+                                            int callbacks )
+{
+    size_t uxLength = uxTotalDataLength - dhcpFIRST_OPTION_BYTE_OFFSET;
+
+    TEST_ASSERT_TRUE( uxLength <= sizeof( ucSentOptions ) );
+
+    memset( ucSentOptions, dhcpOPTION_END_BYTE, sizeof( ucSentOptions ) );
+    memcpy( ucSentOptions, &( ( ( const uint8_t * ) pvBuffer )[ dhcpFIRST_OPTION_BYTE_OFFSET ] ), uxLength );
+
+    return 1;
+}
+
+/*
+ * @brief Find an option in the last message that was sent.
+ */
+static const uint8_t * prvFindSentOption( uint8_t ucOptionCode )
+{
+    const uint8_t * pucReturn = NULL;
+    size_t uxIndex = 0U;
+
+    while( ( uxIndex + 1U ) < sizeof( ucSentOptions ) )
+    {
+        if( ucSentOptions[ uxIndex ] == dhcpOPTION_END_BYTE )
+        {
+            break;
+        }
+
+        if( ucSentOptions[ uxIndex ] == ucOptionCode )
+        {
+            pucReturn = &( ucSentOptions[ uxIndex ] );
+            break;
+        }
+
+        uxIndex += 2U + ucSentOptions[ uxIndex + 1U ];
+    }
+
+    return pucReturn;
+}
+
+/*
+ * @brief Create a reply of the server in 'pucMessage', which must be big enough.
+ *
+ * @return The length of the reply.
+ */
+static size_t prvCreateReply( uint8_t * pucMessage,
+                              uint8_t ucMessageType,
+                              BaseType_t xRapidCommit )
+{
+    DHCPMessage_IPv4_t * pxDHCPMessage = ( DHCPMessage_IPv4_t * ) pucMessage;
+    uint8_t * pucOption = &( pucMessage[ sizeof( DHCPMessage_IPv4_t ) ] );
+
+    memset( pucMessage, 0, sizeof( DHCPMessage_IPv4_t ) );
+    memcpy( pucMessage, DHCP_header, sizeof( DHCP_header ) );
+    memcpy( pxDHCPMessage->ucClientHardwareAddress, xDefault_MacAddress.ucBytes, sizeof( MACAddress_t ) );
+    pxDHCPMessage->ulDHCPCookie = dhcpCOOKIE;
+    pxDHCPMessage->ulYourIPAddress_yiaddr = ulLeasedAddress;
+
+    *pucOption++ = dhcpIPv4_MESSAGE_TYPE_OPTION_CODE;
+    *pucOption++ = 1;
+    *pucOption++ = ucMessageType;
+
+    *pucOption++ = dhcpIPv4_SERVER_IP_ADDRESS_OPTION_CODE;
+    *pucOption++ = 4;
+    memcpy( pucOption, &ulServerAddress, sizeof( ulServerAddress ) );
+    pucOption += sizeof( ulServerAddress );
+
+    if( xRapidCommit != pdFALSE )
+    {
+        *pucOption++ = dhcpIPv4_RAPID_COMMIT_OPTION_CODE;
+        *pucOption++ = 0;
+    }
+
+    *pucOption++ = dhcpOPTION_END_BYTE;
+
+    return ( size_t ) ( pucOption - pucMessage );
+}
+
+/*
+ * @brief Prepare an end-point that is waiting for a reply of the DHCP server.
+ */
+static void prvPrepareEndPoint( NetworkEndPoint_t * pxEndPoint,
+                                Socket_t xSocket,
+                                eDHCPState_t eState )
+{
+    memset( pxEndPoint, 0, sizeof( *pxEndPoint ) );
+
+    xDHCPv4Socket = xSocket;
+    xDHCPSocketUserCount = 1;
+    pxEndPoint->xDHCPData.xDHCPSocket = xSocket;
+    pxEndPoint->xDHCPData.eDHCPState = eState;
+    pxEndPoint->xDHCPData.eExpectedState = eState;
+    pxEndPoint->xDHCPData.ulTransactionId = 0x01ABCDEF;
+    memcpy( pxEndPoint->xMACAddress.ucBytes, xDefault_MacAddress.ucBytes, sizeof( MACAddress_t ) );
+}
+
+/*
+ * @brief Expect the calls that are made when a lease is acknowledged.
+ */
+static void prvExpectLeaseAcknowledged( NetworkEndPoint_t * pxEndPoint,
+                                        Socket_t xSocket )
+{
+    vIPNetworkUpCalls_Expect( pxEndPoint );
+    vSocketClose_ExpectAndReturn( xSocket, NULL );
+    vARPSendGratuitous_Expect();
+    vDHCP_RATimerReload_Expect( pxEndPoint, dhcpDEFAULT_LEASE_TIME );
+}
+
+/*
+ * @brief Expect the calls that are made when DHCP starts over, after the
+ *        stored lease has been looked up.
+ */
+static void prvExpectInitialise( NetworkEndPoint_t * pxEndPoint,
+                                 Socket_t xSocket )
+{
+    FreeRTOS_socket_ExpectAndReturn( FREERTOS_AF_INET, FREERTOS_SOCK_DGRAM, FREERTOS_IPPROTO_UDP, xSocket );
+    xSocketValid_ExpectAnyArgsAndReturn( pdTRUE );
+    xSocketValid_ExpectAnyArgsAndReturn( pdTRUE );
+    FreeRTOS_setsockopt_ExpectAnyArgsAndReturn( pdPASS );
+    FreeRTOS_setsockopt_ExpectAnyArgsAndReturn( pdPASS );
+    vSocketBind_ExpectAnyArgsAndReturn( 0 );
+    vDHCP_RATimerReload_Expect( pxEndPoint, dhcpINITIAL_TIMER_PERIOD );
+}
+
+/*---------------------------------------Test Cases--------------------------*/
+
+/*
+ * @brief After a reset, a lease that the application stored is requested directly.
+ */
+void test_vDHCPProcess_Reset_LoadsStoredLease( void )
+{
+    struct xSOCKET xTestSocket;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+    uint32_t ulStoredAddress = ulLeasedAddress;
+
+    prvPrepareEndPoint( pxEndPoint, NULL, eInitialWait );
+    xDHCPSocketUserCount = 0;
+
+    xApplicationGetRandomNumber_ExpectAndReturn( &( pxEndPoint->xDHCPData.ulTransactionId ), pdTRUE );
+    xApplicationDHCPLoadLease_ExpectAndReturn( pxEndPoint, NULL, pdTRUE );
+    xApplicationDHCPLoadLease_IgnoreArg_pulIPAddress();
+    xApplicationDHCPLoadLease_ReturnThruPtr_pulIPAddress( &ulStoredAddress );
+    prvExpectInitialise( pxEndPoint, &xTestSocket );
+
+    vDHCPProcess( pdTRUE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( eWaitingSendFirstDiscover, pxEndPoint->xDHCPData.eDHCPState );
+    TEST_ASSERT_EQUAL( ulLeasedAddress, pxEndPoint->xDHCPData.ulLastLeasedAddress );
+    TEST_ASSERT_EQUAL( pdTRUE, pxEndPoint->xDHCPData.xInitReboot );
+}
+
+/*
+ * @brief Without a known lease, DHCP starts with a DISCOVER.
+ */
+void test_vDHCPProcess_Reset_NoStoredLease( void )
+{
+    struct xSOCKET xTestSocket;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+
+    prvPrepareEndPoint( pxEndPoint, NULL, eInitialWait );
+    xDHCPSocketUserCount = 0;
+
+    xApplicationGetRandomNumber_ExpectAndReturn( &( pxEndPoint->xDHCPData.ulTransactionId ), pdTRUE );
+    xApplicationDHCPLoadLease_ExpectAndReturn( pxEndPoint, NULL, pdFALSE );
+    xApplicationDHCPLoadLease_IgnoreArg_pulIPAddress();
+    prvExpectInitialise( pxEndPoint, &xTestSocket );
+
+    vDHCPProcess( pdTRUE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( 0, pxEndPoint->xDHCPData.ulLastLeasedAddress );
+    TEST_ASSERT_EQUAL( pdFALSE, pxEndPoint->xDHCPData.xInitReboot );
+}
+
+/*
+ * @brief The lease of the end-point is used before the stored lease.
+ */
+void test_vDHCPProcess_Reset_KnownLease( void )
+{
+    struct xSOCKET xTestSocket;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+
+    prvPrepareEndPoint( pxEndPoint, NULL, eInitialWait );
+    xDHCPSocketUserCount = 0;
+    pxEndPoint->xDHCPData.ulLastLeasedAddress = ulLeasedAddress;
+
+    /* xApplicationDHCPLoadLease() is not called. */
+    xApplicationGetRandomNumber_ExpectAndReturn( &( pxEndPoint->xDHCPData.ulTransactionId ), pdTRUE );
+    prvExpectInitialise( pxEndPoint, &xTestSocket );
+
+    vDHCPProcess( pdTRUE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( ulLeasedAddress, pxEndPoint->xDHCPData.ulLastLeasedAddress );
+    TEST_ASSERT_EQUAL( pdTRUE, pxEndPoint->xDHCPData.xInitReboot );
+}
+
+/*
+ * @brief In the INIT-REBOOT state, a REQUEST for the last leased address is
+ *        sent instead of a DISCOVER, without a server identifier.
+ */
+void test_vDHCPProcess_InitReboot_SendsRequest( void )
+{
+    struct xSOCKET xTestSocket;
+    TickType_t xTimeValue = 1234;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+    const uint8_t * pucOption;
+
+    prvPrepareEndPoint( pxEndPoint, &xTestSocket, eWaitingSendFirstDiscover );
+    pxEndPoint->xDHCPData.ulLastLeasedAddress = ulLeasedAddress;
+    pxEndPoint->xDHCPData.xInitReboot = pdTRUE;
+
+    FreeRTOS_recvfrom_ExpectAndReturn( xDHCPv4Socket, NULL, 0UL, FREERTOS_ZERO_COPY + FREERTOS_MSG_PEEK, NULL, NULL, 0 );
+    FreeRTOS_recvfrom_IgnoreArg_pvBuffer();
+    vReleaseSinglePacketFromUDPSocket_Expect( xDHCPv4Socket );
+    eStubExpectedDHCPPhase = eDHCPPhasePreDiscover;
+    pxStubExpectedEndPoint = pxEndPoint;
+    ulStubExpectedIPAddress = pxEndPoint->ipv4_defaults.ulIPAddress;
+    eStubExpectedReturn = eDHCPContinue;
+    xApplicationDHCPHook_Multi_Stub( xStubApplicationDHCPHook_Multi );
+    xTaskGetTickCount_ExpectAndReturn( xTimeValue );
+    pcApplicationHostnameHook_ExpectAndReturn( pcHostName );
+    pxGetNetworkBufferWithDescriptor_Stub( GetNetworkBuffer );
+    xSocketValid_ExpectAnyArgsAndReturn( pdTRUE );
+    FreeRTOS_sendto_Stub( FreeRTOS_sendto_SaveOptions );
+
+    vDHCPProcess( pdFALSE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( eWaitingAcknowledge, pxEndPoint->xDHCPData.eDHCPState );
+    TEST_ASSERT_EQUAL( ulLeasedAddress, pxEndPoint->xDHCPData.ulOfferedIPAddress );
+
+    pucOption = prvFindSentOption( dhcpIPv4_MESSAGE_TYPE_OPTION_CODE );
+    TEST_ASSERT_NOT_NULL( pucOption );
+    TEST_ASSERT_EQUAL( dhcpMESSAGE_TYPE_REQUEST, pucOption[ 2 ] );
+    pucOption = prvFindSentOption( dhcpIPv4_REQUEST_IP_ADDRESS_OPTION_CODE );
+    TEST_ASSERT_NOT_NULL( pucOption );
+    TEST_ASSERT_EQUAL_MEMORY( &ulLeasedAddress, &( pucOption[ 2 ] ), sizeof( ulLeasedAddress ) );
+    TEST_ASSERT_NULL( prvFindSentOption( dhcpIPv4_SERVER_IP_ADDRESS_OPTION_CODE ) );
+    TEST_ASSERT_NOT_NULL( prvFindSentOption( dhcpIPv4_DNS_HOSTNAME_OPTIONS_CODE ) );
+
+    ReleaseNetworkBuffer();
+}
+
+/*
+ * @brief An ACK in the INIT-REBOOT state is accepted from any server. The store
+ *        hook is not called, because the address did not change.
+ */
+void test_vDHCPProcess_InitReboot_Ack( void )
+{
+    struct xSOCKET xTestSocket;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+    uint8_t DHCPMsg[ sizeof( DHCPMessage_IPv4_t ) + 16 ];
+
+    prvPrepareEndPoint( pxEndPoint, &xTestSocket, eWaitingAcknowledge );
+    pxEndPoint->xDHCPData.ulLastLeasedAddress = ulLeasedAddress;
+    pxEndPoint->xDHCPData.ulOfferedIPAddress = ulLeasedAddress;
+    pxEndPoint->xDHCPData.xInitReboot = pdTRUE;
+
+    ucGenericPtr = DHCPMsg;
+    ulGenericLength = prvCreateReply( DHCPMsg, dhcpMESSAGE_TYPE_ACK, pdFALSE );
+    FreeRTOS_recvfrom_Stub( FreeRTOS_recvfrom_Generic );
+    FreeRTOS_ReleaseUDPPayloadBuffer_Expect( DHCPMsg );
+    prvExpectLeaseAcknowledged( pxEndPoint, &xTestSocket );
+
+    vDHCPProcessEndPoint( pdFALSE, pdTRUE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( eLeasedAddress, pxEndPoint->xDHCPData.eDHCPState );
+    TEST_ASSERT_EQUAL( ulLeasedAddress, pxEndPoint->ipv4_settings.ulIPAddress );
+    TEST_ASSERT_EQUAL( ulServerAddress, pxEndPoint->xDHCPData.ulDHCPServerAddress );
+    TEST_ASSERT_EQUAL( pdFALSE, pxEndPoint->xDHCPData.xInitReboot );
+}
+
+/*
+ * @brief A NAK in the INIT-REBOOT state makes DHCP start over, and the
+ *        stored lease is forgotten.
+ */
+void test_vDHCPProcess_InitReboot_Nak( void )
+{
+    struct xSOCKET xTestSocket;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+    uint8_t DHCPMsg[ sizeof( DHCPMessage_IPv4_t ) + 16 ];
+
+    prvPrepareEndPoint( pxEndPoint, &xTestSocket, eWaitingAcknowledge );
+    pxEndPoint->xDHCPData.ulLastLeasedAddress = ulLeasedAddress;
+    pxEndPoint->xDHCPData.ulOfferedIPAddress = ulLeasedAddress;
+    pxEndPoint->xDHCPData.xInitReboot = pdTRUE;
+
+    ucGenericPtr = DHCPMsg;
+    ulGenericLength = prvCreateReply( DHCPMsg, dhcpMESSAGE_TYPE_NACK, pdFALSE );
+    FreeRTOS_recvfrom_Stub( FreeRTOS_recvfrom_Generic );
+    vApplicationDHCPStoreLease_Expect( pxEndPoint, 0U );
+    FreeRTOS_ReleaseUDPPayloadBuffer_Expect( DHCPMsg );
+
+    vDHCPProcessEndPoint( pdFALSE, pdTRUE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( eInitialWait, pxEndPoint->xDHCPData.eDHCPState );
+    TEST_ASSERT_EQUAL( eInitialWait, pxEndPoint->xDHCPData.eExpectedState );
+    TEST_ASSERT_EQUAL( 0, pxEndPoint->xDHCPData.ulLastLeasedAddress );
+}
+
+/*
+ * @brief When the last leased address is not confirmed in time, DHCP falls
+ *        back to a DISCOVER, which asks for a Rapid Commit.
+ */
+void test_vDHCPProcess_InitReboot_TimeoutFallsBackToDiscover( void )
+{
+    struct xSOCKET xTestSocket;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+    TickType_t xTimeValue = 1000;
+    const uint8_t * pucOption;
+
+    prvPrepareEndPoint( pxEndPoint, &xTestSocket, eWaitingAcknowledge );
+    pxEndPoint->xDHCPData.ulLastLeasedAddress = ulLeasedAddress;
+    pxEndPoint->xDHCPData.ulOfferedIPAddress = ulLeasedAddress;
+    pxEndPoint->xDHCPData.xInitReboot = pdTRUE;
+    pxEndPoint->xDHCPData.xDHCPTxTime = 100;
+    pxEndPoint->xDHCPData.xDHCPTxPeriod = 10;
+
+    xTaskGetTickCount_ExpectAndReturn( xTimeValue );
+    xTaskGetTickCount_ExpectAndReturn( xTimeValue );
+    pcApplicationHostnameHook_ExpectAndReturn( pcHostName );
+    pxGetNetworkBufferWithDescriptor_Stub( GetNetworkBuffer );
+    xSocketValid_ExpectAnyArgsAndReturn( pdTRUE );
+    FreeRTOS_sendto_Stub( FreeRTOS_sendto_SaveOptions );
+
+    vDHCPProcessEndPoint( pdFALSE, pdFALSE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( eWaitingOffer, pxEndPoint->xDHCPData.eDHCPState );
+    TEST_ASSERT_EQUAL( pdFALSE, pxEndPoint->xDHCPData.xInitReboot );
+    TEST_ASSERT_EQUAL( 0, pxEndPoint->xDHCPData.ulOfferedIPAddress );
+    TEST_ASSERT_EQUAL( xTimeValue, pxEndPoint->xDHCPData.xDHCPTxTime );
+    TEST_ASSERT_EQUAL( dhcpINITIAL_DHCP_TX_PERIOD, pxEndPoint->xDHCPData.xDHCPTxPeriod );
+
+    pucOption = prvFindSentOption( dhcpIPv4_MESSAGE_TYPE_OPTION_CODE );
+    TEST_ASSERT_NOT_NULL( pucOption );
+    TEST_ASSERT_EQUAL( dhcpMESSAGE_TYPE_DISCOVER, pucOption[ 2 ] );
+    pucOption = prvFindSentOption( dhcpIPv4_RAPID_COMMIT_OPTION_CODE );
+    TEST_ASSERT_NOT_NULL( pucOption );
+    TEST_ASSERT_EQUAL( 0, pucOption[ 1 ] );
+
+    ReleaseNetworkBuffer();
+}
+
+/*
+ * @brief An ACK with the Rapid Commit option answers a DISCOVER: the address
+ *        is leased without a REQUEST, and the new lease is stored.
+ */
+void test_vDHCPProcess_eWaitingOffer_RapidCommitAck( void )
+{
+    struct xSOCKET xTestSocket;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+    uint8_t DHCPMsg[ sizeof( DHCPMessage_IPv4_t ) + 16 ];
+
+    prvPrepareEndPoint( pxEndPoint, &xTestSocket, eWaitingOffer );
+
+    ucGenericPtr = DHCPMsg;
+    ulGenericLength = prvCreateReply( DHCPMsg, dhcpMESSAGE_TYPE_ACK, pdTRUE );
+    FreeRTOS_recvfrom_Stub( FreeRTOS_recvfrom_Generic );
+    FreeRTOS_ReleaseUDPPayloadBuffer_Expect( DHCPMsg );
+    /* The pre-request hook is not called. */
+    prvExpectLeaseAcknowledged( pxEndPoint, &xTestSocket );
+    vApplicationDHCPStoreLease_Expect( pxEndPoint, ulLeasedAddress );
+
+    vDHCPProcessEndPoint( pdFALSE, pdTRUE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( eLeasedAddress, pxEndPoint->xDHCPData.eDHCPState );
+    TEST_ASSERT_EQUAL( ulLeasedAddress, pxEndPoint->ipv4_settings.ulIPAddress );
+    TEST_ASSERT_EQUAL( ulLeasedAddress, pxEndPoint->xDHCPData.ulLastLeasedAddress );
+}
+
+/*
+ * @brief An ACK without the Rapid Commit option does not answer a DISCOVER.
+ */
+void test_vDHCPProcess_eWaitingOffer_AckWithoutRapidCommit( void )
+{
+    struct xSOCKET xTestSocket;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+    uint8_t DHCPMsg[ sizeof( DHCPMessage_IPv4_t ) + 16 ];
+
+    prvPrepareEndPoint( pxEndPoint, &xTestSocket, eWaitingOffer );
+
+    ucGenericPtr = DHCPMsg;
+    ulGenericLength = prvCreateReply( DHCPMsg, dhcpMESSAGE_TYPE_ACK, pdFALSE );
+    FreeRTOS_recvfrom_Stub( FreeRTOS_recvfrom_Generic );
+    FreeRTOS_ReleaseUDPPayloadBuffer_Expect( DHCPMsg );
+
+    vDHCPProcessEndPoint( pdFALSE, pdTRUE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( eWaitingOffer, pxEndPoint->xDHCPData.eDHCPState );
+    TEST_ASSERT_EQUAL( 0, pxEndPoint->ipv4_settings.ulIPAddress );
+    TEST_ASSERT_EQUAL( 0, pxEndPoint->xDHCPData.ulLastLeasedAddress );
+}
+
+/*
+ * @brief A renewed lease of the same address is not stored again.
+ */
+void test_vDHCPProcess_eWaitingAcknowledge_SameLeaseNotStored( void )
+{
+    struct xSOCKET xTestSocket;
+    NetworkEndPoint_t xEndPoint, * pxEndPoint = &xEndPoint;
+    uint8_t DHCPMsg[ sizeof( DHCPMessage_IPv4_t ) + 16 ];
+
+    prvPrepareEndPoint( pxEndPoint, &xTestSocket, eWaitingAcknowledge );
+    pxEndPoint->xDHCPData.ulLastLeasedAddress = ulLeasedAddress;
+    pxEndPoint->xDHCPData.ulDHCPServerAddress = ulServerAddress;
+
+    ucGenericPtr = DHCPMsg;
+    ulGenericLength = prvCreateReply( DHCPMsg, dhcpMESSAGE_TYPE_ACK, pdFALSE );
+    FreeRTOS_recvfrom_Stub( FreeRTOS_recvfrom_Generic );
+    FreeRTOS_ReleaseUDPPayloadBuffer_Expect( DHCPMsg );
+    /* vApplicationDHCPStoreLease() is not called. */
+    prvExpectLeaseAcknowledged( pxEndPoint, &xTestSocket );
+
+    vDHCPProcessEndPoint( pdFALSE, pdTRUE, pxEndPoint );
+
+    TEST_ASSERT_EQUAL( eLeasedAddress, pxEndPoint->xDHCPData.eDHCPState );
+    TEST_ASSERT_EQUAL( ulLeasedAddress, pxEndPoint->xDHCPData.ulLastLeasedAddress );
+}
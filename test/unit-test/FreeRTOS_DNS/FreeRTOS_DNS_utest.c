@@ -450,6 +450,76 @@ void test_FreeRTOS_gethostbyname_Success( void )
     free( xReceiveBuffer.pucPayloadBuffer );
 }
 
+/**
+ * @brief The answer of a DNS server to a blocking look-up is parsed into an
+ *        array, stored in the DNS cache, and its first IPv4 address returned.
+ */
+void test_FreeRTOS_gethostbyname_ParseAddressRecords( void )
+{
+    uint32_t ret;
+    NetworkBufferDescriptor_t xNetworkBuffer;
+    struct xDNSBuffer xReceiveBuffer;
+    struct freertos_sockaddr xRecvAddress = { 0 };
+    DNSAddressRecord_t xRecord = { 0 };
+    uint32_t ulNumber = 343;
+    NetworkEndPoint_t xEndPoint = { 0 };
+    struct xSOCKET xDNSSocket;
+
+    uint8_t buffer[ 2280 + ipBUFFER_PADDING ];
+
+    xEndPoint.bits.bIPv6 = 0;
+    xEndPoint.ipv4_settings.ulDNSServerAddresses[ 0 ] = 0xC0C0C0C0;
+    xEndPoint.ipv4_settings.ucDNSIndex = 0;
+    xReceiveBuffer.pucPayloadBuffer = malloc( 300 );
+    xReceiveBuffer.uxPayloadLength = 300;
+    memset( xReceiveBuffer.pucPayloadBuffer, 0x00, 300 );
+    DNSMessage_t * header = ( DNSMessage_t * ) xReceiveBuffer.pucPayloadBuffer;
+
+    header->usIdentifier = ( uint16_t ) ulNumber;
+    xDNSSocket.usLocalPort = 0;
+    xRecvAddress.sin_port = dnsDNS_PORT;
+    xRecord.xAddress.xIPAddress.ulIP_IPv4 = 0x0102A8C0U;
+    xRecord.ulTTL = 300U;
+
+    xNetworkBuffer.xDataLength = 2280;
+    xNetworkBuffer.pucEthernetBuffer = buffer;
+    xNetworkBuffer.pucEthernetBuffer += ipBUFFER_PADDING;
+    memset( xNetworkBuffer.pucEthernetBuffer, 0x00, 2280 );
+
+    DNS_BindSocket_IgnoreAndReturn( 0 );
+    FreeRTOS_inet_addr_ExpectAndReturn( GOOD_ADDRESS, 0 );
+    Prepare_CacheLookup_ExpectAnyArgsAndReturn( 0 );
+    xApplicationGetRandomNumber_ExpectAnyArgsAndReturn( pdTRUE );
+    xApplicationGetRandomNumber_ReturnThruPtr_pulNumber( &ulNumber );
+
+    DNS_CreateSocket_ExpectAnyArgsAndReturn( &xDNSSocket );
+    FreeRTOS_FirstEndPoint_IgnoreAndReturn( &xEndPoint );
+    FreeRTOS_NextEndPoint_IgnoreAndReturn( NULL );
+    pxGetNetworkBufferWithDescriptor_ExpectAnyArgsAndReturn( &xNetworkBuffer );
+    DNS_SendRequest_ExpectAnyArgsAndReturn( pdPASS );
+    DNS_ReadReply_ExpectAnyArgsAndReturn( 40 );
+    DNS_ReadReply_ReturnThruPtr_pxReceiveBuffer( &xReceiveBuffer );
+    DNS_ReadReply_ReturnThruPtr_xAddress( &xRecvAddress );
+    /* prvDNSReply */
+    DNS_ParseAddressRecords_ExpectAndReturn( xReceiveBuffer.pucPayloadBuffer, 40, GOOD_ADDRESS, NULL, ipconfigDNS_CACHE_ADDRESSES_PER_ENTRY, 1 );
+    DNS_ParseAddressRecords_IgnoreArg_pxRecords();
+    DNS_ParseAddressRecords_ReturnThruPtr_pxRecords( &xRecord );
+    DNS_StoreAddressRecords_Expect( GOOD_ADDRESS, NULL, 1 );
+    DNS_StoreAddressRecords_IgnoreArg_pxRecords();
+    DNS_AddressRecordsToList_ExpectAndReturn( GOOD_ADDRESS, NULL, 1, NULL );
+    DNS_AddressRecordsToList_IgnoreArg_pxRecords();
+    FreeRTOS_ReleaseUDPPayloadBuffer_ExpectAnyArgs();
+
+    /* back in prvGetHostByName */
+    DNS_CloseSocket_Ignore();
+
+    ret = FreeRTOS_gethostbyname( GOOD_ADDRESS );
+    TEST_ASSERT_EQUAL( 0x0102A8C0U, ret );
+
+    xNetworkBuffer.pucEthernetBuffer -= ipBUFFER_PADDING;
+    free( xReceiveBuffer.pucPayloadBuffer );
+}
+
 /**
  * @brief Ensures that DNS_ParseDNSReply is called, this function always returns
  *        pdFAIL
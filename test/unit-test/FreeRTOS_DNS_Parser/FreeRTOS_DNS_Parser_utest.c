@@ -4025,3 +4025,492 @@ void test_prepareReplyDNSMessage_null_pointer( void )
     uxIPHeaderSizePacket_IgnoreAndReturn( ipSIZE_OF_IPv4_HEADER );
     catch_assert( prepareReplyDNSMessage( &pxNetworkBuffer, lNetLength ) );
 }
+
+/* ============== test the name walker and DNS_ParseAddressRecords ============== */
+
+/**
+ * @brief Read a big-endian 16-bit value, replaces the mocked usChar2u16().
+ */
+static uint16_t usChar2u16_Callback( const uint8_t * pucPtr,
+                                     int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return ( uint16_t ) ( ( ( uint16_t ) pucPtr[ 0 ] << 8 ) | pucPtr[ 1 ] );
+}
+
+/**
+ * @brief Read a big-endian 32-bit value, replaces the mocked ulChar2u32().
+ */
+static uint32_t ulChar2u32_Callback( const uint8_t * pucPtr,
+                                     int cmock_num_calls )
+{
+    ( void ) cmock_num_calls;
+
+    return ( ( uint32_t ) pucPtr[ 0 ] << 24 ) | ( ( uint32_t ) pucPtr[ 1 ] << 16 ) |
+           ( ( uint32_t ) pucPtr[ 2 ] << 8 ) | ( uint32_t ) pucPtr[ 3 ];
+}
+
+/**
+ * @brief Write a DNS header with the given flags and counts.
+ */
+static size_t prvAddHeader( uint8_t * pucBuffer,
+                            uint16_t usFlags,
+                            uint16_t usQuestions,
+                            uint16_t usAnswers )
+{
+    DNSMessage_t * pxHeader = ( DNSMessage_t * ) pucBuffer;
+
+    memset( pxHeader, 0, sizeof( *pxHeader ) );
+    pxHeader->usFlags = FreeRTOS_htons( usFlags );
+    pxHeader->usQuestions = FreeRTOS_htons( usQuestions );
+    pxHeader->usAnswers = FreeRTOS_htons( usAnswers );
+
+    return sizeof( DNSMessage_t );
+}
+
+/**
+ * @brief Write a name in dotted notation as a list of labels.
+ */
+static size_t prvAddName( uint8_t * pucBuffer,
+                          size_t uxOffset,
+                          const char * pcName )
+{
+    const char * pcLabel = pcName;
+
+    while( *pcLabel != 0 )
+    {
+        const char * pcDot = strchr( pcLabel, '.' );
+        size_t uxLength = ( pcDot != NULL ) ? ( size_t ) ( pcDot - pcLabel ) : strlen( pcLabel );
+
+        pucBuffer[ uxOffset++ ] = ( uint8_t ) uxLength;
+        memcpy( &( pucBuffer[ uxOffset ] ), pcLabel, uxLength );
+        uxOffset += uxLength;
+        pcLabel += uxLength;
+
+        if( *pcLabel == '.' )
+        {
+            pcLabel++;
+        }
+    }
+
+    pucBuffer[ uxOffset++ ] = 0U;
+
+    return uxOffset;
+}
+
+/**
+ * @brief Write the type and class of a question, class IN.
+ */
+static size_t prvAddQuestionFields( uint8_t * pucBuffer,
+                                    size_t uxOffset,
+                                    uint16_t usType )
+{
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) ( usType >> 8 );
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) usType;
+    pucBuffer[ uxOffset++ ] = 0U;
+    pucBuffer[ uxOffset++ ] = dnsCLASS_IN;
+
+    return uxOffset;
+}
+
+/**
+ * @brief Write the fixed fields and the data of a record, class IN.
+ */
+static size_t prvAddRecordData( uint8_t * pucBuffer,
+                                size_t uxOffset,
+                                uint16_t usType,
+                                uint32_t ulTTL,
+                                const uint8_t * pucData,
+                                uint16_t usLength )
+{
+    uxOffset = prvAddQuestionFields( pucBuffer, uxOffset, usType );
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) ( ulTTL >> 24 );
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) ( ulTTL >> 16 );
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) ( ulTTL >> 8 );
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) ulTTL;
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) ( usLength >> 8 );
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) usLength;
+    memcpy( &( pucBuffer[ uxOffset ] ), pucData, usLength );
+
+    return uxOffset + usLength;
+}
+
+/**
+ * @brief Write a compression pointer.
+ */
+static size_t prvAddPointer( uint8_t * pucBuffer,
+                             size_t uxOffset,
+                             size_t uxTarget )
+{
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) ( dnsNAME_IS_OFFSET | ( uxTarget >> 8 ) );
+    pucBuffer[ uxOffset++ ] = ( uint8_t ) uxTarget;
+
+    return uxOffset;
+}
+
+/**
+ * @brief A name is decoded, also when it ends in a compression pointer.
+ */
+void test_DNS_ReadName_FollowsPointer( void )
+{
+    uint8_t ucBuffer[ 64 ] = { 0 };
+    char pcName[ 32 ];
+    size_t uxEnd;
+
+    uxEnd = prvAddName( ucBuffer, 0U, "freertos.org" );
+    ucBuffer[ uxEnd ] = 3;
+    memcpy( &( ucBuffer[ uxEnd + 1U ] ), "www", 3 );
+    uxEnd = prvAddPointer( ucBuffer, uxEnd + 4U, 0U );
+
+    TEST_ASSERT_EQUAL( uxEnd, DNS_ReadName( ucBuffer, uxEnd, 14U, pcName, sizeof( pcName ) ) );
+    TEST_ASSERT_EQUAL_STRING( "www.freertos.org", pcName );
+
+    /* Without an output, the name is only skipped. */
+    TEST_ASSERT_EQUAL( uxEnd, DNS_ReadName( ucBuffer, uxEnd, 14U, NULL, 0U ) );
+}
+
+/**
+ * @brief A name that does not fit in the output is refused.
+ */
+void test_DNS_ReadName_NameTooLong( void )
+{
+    uint8_t ucBuffer[ 64 ] = { 0 };
+    char pcName[ 12 ];
+    size_t uxEnd;
+
+    uxEnd = prvAddName( ucBuffer, 0U, "www.freertos.org" );
+
+    TEST_ASSERT_EQUAL( 0, DNS_ReadName( ucBuffer, uxEnd, 0U, pcName, sizeof( pcName ) ) );
+}
+
+/**
+ * @brief A pointer to itself, or to a later position, is refused.
+ */
+void test_DNS_ReadName_PointerLoop( void )
+{
+    uint8_t ucBuffer[ 64 ] = { 0 };
+    char pcName[ 32 ];
+
+    /* A pointer to itself. */
+    ( void ) prvAddPointer( ucBuffer, 0U, 0U );
+    TEST_ASSERT_EQUAL( 0, DNS_ReadName( ucBuffer, 2U, 0U, pcName, sizeof( pcName ) ) );
+
+    /* A pointer forward, to a name that points back. */
+    ucBuffer[ 0 ] = 1;
+    ucBuffer[ 1 ] = 'a';
+    ( void ) prvAddPointer( ucBuffer, 2U, 4U );
+    ( void ) prvAddPointer( ucBuffer, 4U, 0U );
+    TEST_ASSERT_EQUAL( 0, DNS_ReadName( ucBuffer, 6U, 0U, pcName, sizeof( pcName ) ) );
+
+    /* Two names that point to each other. */
+    ( void ) prvAddPointer( ucBuffer, 0U, 2U );
+    ( void ) prvAddPointer( ucBuffer, 2U, 0U );
+    TEST_ASSERT_EQUAL( 0, DNS_ReadName( ucBuffer, 4U, 2U, pcName, sizeof( pcName ) ) );
+}
+
+/**
+ * @brief Labels that run past the end of the message, truncated pointers and
+ *        unknown label types are refused.
+ */
+void test_DNS_ReadName_Malformed( void )
+{
+    uint8_t ucBuffer[ 64 ] = { 0 };
+    char pcName[ 32 ];
+    size_t uxEnd;
+
+    uxEnd = prvAddName( ucBuffer, 0U, "www.freertos.org" );
+    TEST_ASSERT_EQUAL( 0, DNS_ReadName( ucBuffer, uxEnd - 1U, 0U, pcName, sizeof( pcName ) ) );
+    TEST_ASSERT_EQUAL( 0, DNS_ReadName( ucBuffer, uxEnd - 3U, 0U, NULL, 0U ) );
+
+    ucBuffer[ 0 ] = dnsNAME_IS_OFFSET;
+    TEST_ASSERT_EQUAL( 0, DNS_ReadName( ucBuffer, 1U, 0U, pcName, sizeof( pcName ) ) );
+
+    ucBuffer[ 0 ] = 0x40U;
+    TEST_ASSERT_EQUAL( 0, DNS_ReadName( ucBuffer, uxEnd, 0U, pcName, sizeof( pcName ) ) );
+}
+
+/**
+ * @brief Names are compared without copying them, and without regard to case.
+ */
+void test_DNS_MatchName( void )
+{
+    uint8_t ucBuffer[ 64 ] = { 0 };
+    BaseType_t xMatch = pdFALSE;
+    size_t uxEnd;
+
+    uxEnd = prvAddName( ucBuffer, 0U, "WWW.FreeRTOS.org" );
+
+    TEST_ASSERT_EQUAL( uxEnd, DNS_MatchName( ucBuffer, uxEnd, 0U, "www.freertos.ORG", &( xMatch ) ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xMatch );
+
+    TEST_ASSERT_EQUAL( uxEnd, DNS_MatchName( ucBuffer, uxEnd, 0U, "www.freertos", &( xMatch ) ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xMatch );
+
+    TEST_ASSERT_EQUAL( uxEnd, DNS_MatchName( ucBuffer, uxEnd, 0U, "www.freertos.org.uk", &( xMatch ) ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xMatch );
+
+    TEST_ASSERT_EQUAL( uxEnd, DNS_MatchName( ucBuffer, uxEnd, 0U, "www-freertos.org", &( xMatch ) ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xMatch );
+
+    TEST_ASSERT_EQUAL( 0, DNS_MatchName( ucBuffer, uxEnd - 1U, 0U, "www.freertos.org", &( xMatch ) ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xMatch );
+}
+
+/**
+ * @brief The helpers for a case-insensitive comparison.
+ */
+void test_DNS_NameEqual( void )
+{
+    TEST_ASSERT_EQUAL( 'a', DNS_LowerCase( 'A' ) );
+    TEST_ASSERT_EQUAL( 'z', DNS_LowerCase( 'Z' ) );
+    TEST_ASSERT_EQUAL( '@', DNS_LowerCase( '@' ) );
+    TEST_ASSERT_EQUAL( '[', DNS_LowerCase( '[' ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, DNS_NameEqual( "FreeRTOS.org", "freertos.ORG" ) );
+    TEST_ASSERT_EQUAL( pdFALSE, DNS_NameEqual( "freertos.org", "freertos.or" ) );
+    TEST_ASSERT_EQUAL( pdFALSE, DNS_NameEqual( "freertos", "freertos.org" ) );
+}
+
+/**
+ * @brief A reply with an A and an AAAA record is parsed.
+ */
+void test_DNS_ParseAddressRecords_Success( void )
+{
+    uint8_t ucBuffer[ 200 ] = { 0 };
+    DNSAddressRecord_t xRecords[ 4 ];
+    const uint8_t ucIPv4[ 4 ] = { 192, 168, 2, 1 };
+    const uint8_t ucIPv6[ 16 ] = { 0x20, 0x01, 0x0d, 0xb8, [ 15 ] = 1 };
+    size_t uxOffset;
+    BaseType_t xResult;
+
+    usChar2u16_Stub( usChar2u16_Callback );
+    ulChar2u32_Stub( ulChar2u32_Callback );
+
+    uxOffset = prvAddHeader( ucBuffer, 0x8180U, 1U, 2U );
+    uxOffset = prvAddName( ucBuffer, uxOffset, "www.freertos.org" );
+    uxOffset = prvAddQuestionFields( ucBuffer, uxOffset, dnsTYPE_A_HOST );
+    uxOffset = prvAddPointer( ucBuffer, uxOffset, sizeof( DNSMessage_t ) );
+    uxOffset = prvAddRecordData( ucBuffer, uxOffset, dnsTYPE_A_HOST, 300U, ucIPv4, sizeof( ucIPv4 ) );
+    uxOffset = prvAddPointer( ucBuffer, uxOffset, sizeof( DNSMessage_t ) );
+    uxOffset = prvAddRecordData( ucBuffer, uxOffset, dnsTYPE_AAAA_HOST, 600U, ucIPv6, sizeof( ucIPv6 ) );
+
+    xResult = DNS_ParseAddressRecords( ucBuffer, uxOffset, "WWW.FreeRTOS.org", xRecords, 4U );
+
+    TEST_ASSERT_EQUAL( 2, xResult );
+    TEST_ASSERT_EQUAL( pdFALSE, xRecords[ 0 ].xAddress.xIs_IPv6 );
+    TEST_ASSERT_EQUAL_MEMORY( ucIPv4, &( xRecords[ 0 ].xAddress.xIPAddress.ulIP_IPv4 ), sizeof( ucIPv4 ) );
+    TEST_ASSERT_EQUAL( 300U, xRecords[ 0 ].ulTTL );
+    TEST_ASSERT_EQUAL( pdTRUE, xRecords[ 1 ].xAddress.xIs_IPv6 );
+    TEST_ASSERT_EQUAL_MEMORY( ucIPv6, xRecords[ 1 ].xAddress.xIPAddress.xIP_IPv6.ucBytes, sizeof( ucIPv6 ) );
+    TEST_ASSERT_EQUAL( 600U, xRecords[ 1 ].ulTTL );
+
+    /* The addresses that do not fit are skipped. */
+    xResult = DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.org", xRecords, 1U );
+    TEST_ASSERT_EQUAL( 1, xResult );
+}
+
+/**
+ * @brief A truncated header, a query and a reply to another name are refused.
+ */
+void test_DNS_ParseAddressRecords_NotAnAnswer( void )
+{
+    uint8_t ucBuffer[ 200 ] = { 0 };
+    DNSAddressRecord_t xRecords[ 4 ];
+    size_t uxOffset;
+
+    usChar2u16_Stub( usChar2u16_Callback );
+    ulChar2u32_Stub( ulChar2u32_Callback );
+
+    uxOffset = prvAddHeader( ucBuffer, 0x8180U, 1U, 0U );
+    uxOffset = prvAddName( ucBuffer, uxOffset, "www.freertos.org" );
+    uxOffset = prvAddQuestionFields( ucBuffer, uxOffset, dnsTYPE_A_HOST );
+
+    TEST_ASSERT_EQUAL( 0, DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.org", xRecords, 4U ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, DNS_ParseAddressRecords( ucBuffer, sizeof( DNSMessage_t ) - 1U, NULL, xRecords, 4U ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.com", xRecords, 4U ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, DNS_ParseAddressRecords( ucBuffer, uxOffset - 1U, "www.freertos.org", xRecords, 4U ) );
+
+    ( void ) prvAddHeader( ucBuffer, 0x0100U, 1U, 0U );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.org", xRecords, 4U ) );
+
+    /* A reply without questions can not be checked. */
+    ( void ) prvAddHeader( ucBuffer, 0x8180U, 0U, 0U );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.org", xRecords, 4U ) );
+}
+
+/**
+ * @brief An error response has no addresses, even when it has answers.
+ */
+void test_DNS_ParseAddressRecords_ErrorResponse( void )
+{
+    uint8_t ucBuffer[ 200 ] = { 0 };
+    DNSAddressRecord_t xRecords[ 4 ];
+    const uint8_t ucIPv4[ 4 ] = { 192, 168, 2, 1 };
+    size_t uxOffset;
+
+    usChar2u16_Stub( usChar2u16_Callback );
+    ulChar2u32_Stub( ulChar2u32_Callback );
+
+    uxOffset = prvAddHeader( ucBuffer, 0x8183U, 1U, 1U );
+    uxOffset = prvAddName( ucBuffer, uxOffset, "www.freertos.org" );
+    uxOffset = prvAddQuestionFields( ucBuffer, uxOffset, dnsTYPE_A_HOST );
+    uxOffset = prvAddPointer( ucBuffer, uxOffset, sizeof( DNSMessage_t ) );
+    uxOffset = prvAddRecordData( ucBuffer, uxOffset, dnsTYPE_A_HOST, 300U, ucIPv4, sizeof( ucIPv4 ) );
+
+    TEST_ASSERT_EQUAL( 0, DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.org", xRecords, 4U ) );
+}
+
+/**
+ * @brief Answers that run past the end of the message, or whose owner name
+ *        loops, make the reply invalid.
+ */
+void test_DNS_ParseAddressRecords_MalformedAnswer( void )
+{
+    uint8_t ucBuffer[ 200 ] = { 0 };
+    DNSAddressRecord_t xRecords[ 4 ];
+    const uint8_t ucIPv4[ 4 ] = { 192, 168, 2, 1 };
+    size_t uxQuestionEnd;
+    size_t uxOffset;
+
+    usChar2u16_Stub( usChar2u16_Callback );
+    ulChar2u32_Stub( ulChar2u32_Callback );
+
+    uxOffset = prvAddHeader( ucBuffer, 0x8180U, 1U, 1U );
+    uxOffset = prvAddName( ucBuffer, uxOffset, "www.freertos.org" );
+    uxQuestionEnd = prvAddQuestionFields( ucBuffer, uxOffset, dnsTYPE_A_HOST );
+    uxOffset = prvAddPointer( ucBuffer, uxQuestionEnd, sizeof( DNSMessage_t ) );
+    uxOffset = prvAddRecordData( ucBuffer, uxOffset, dnsTYPE_A_HOST, 300U, ucIPv4, sizeof( ucIPv4 ) );
+
+    /* The record data is truncated. */
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, DNS_ParseAddressRecords( ucBuffer, uxOffset - 1U, "www.freertos.org", xRecords, 4U ) );
+
+    /* The fixed fields are truncated. */
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, DNS_ParseAddressRecords( ucBuffer, uxQuestionEnd + 6U, "www.freertos.org", xRecords, 4U ) );
+
+    /* The owner name points to itself. */
+    ( void ) prvAddPointer( ucBuffer, uxQuestionEnd, uxQuestionEnd );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.org", xRecords, 4U ) );
+
+    /* The owner name points forward. */
+    ( void ) prvAddPointer( ucBuffer, uxQuestionEnd, uxQuestionEnd + 2U );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.org", xRecords, 4U ) );
+}
+
+/**
+ * @brief Answers for another name are ignored, an answer of 0.0.0.0 as well.
+ */
+void test_DNS_ParseAddressRecords_ForeignOwner( void )
+{
+    uint8_t ucBuffer[ 200 ] = { 0 };
+    DNSAddressRecord_t xRecords[ 4 ];
+    const uint8_t ucIPv4[ 4 ] = { 192, 168, 2, 1 };
+    const uint8_t ucZero[ 4 ] = { 0 };
+    size_t uxOffset;
+
+    usChar2u16_Stub( usChar2u16_Callback );
+    ulChar2u32_Stub( ulChar2u32_Callback );
+
+    uxOffset = prvAddHeader( ucBuffer, 0x8180U, 1U, 2U );
+    uxOffset = prvAddName( ucBuffer, uxOffset, "www.freertos.org" );
+    uxOffset = prvAddQuestionFields( ucBuffer, uxOffset, dnsTYPE_A_HOST );
+    uxOffset = prvAddName( ucBuffer, uxOffset, "www.attacker.org" );
+    uxOffset = prvAddRecordData( ucBuffer, uxOffset, dnsTYPE_A_HOST, 300U, ucIPv4, sizeof( ucIPv4 ) );
+    uxOffset = prvAddPointer( ucBuffer, uxOffset, sizeof( DNSMessage_t ) );
+    uxOffset = prvAddRecordData( ucBuffer, uxOffset, dnsTYPE_A_HOST, 300U, ucZero, sizeof( ucZero ) );
+
+    TEST_ASSERT_EQUAL( 0, DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.org", xRecords, 4U ) );
+
+    /* Without an expected name, the owner is not checked. */
+    TEST_ASSERT_EQUAL( 1, DNS_ParseAddressRecords( ucBuffer, uxOffset, NULL, xRecords, 4U ) );
+}
+
+/**
+ * @brief The addresses of an alias are accepted, when the CNAME record of the
+ *        name that was asked comes first.
+ */
+void test_DNS_ParseAddressRecords_CNAMEChain( void )
+{
+    uint8_t ucBuffer[ 200 ] = { 0 };
+    uint8_t ucAlias[ 32 ];
+    DNSAddressRecord_t xRecords[ 4 ];
+    const uint8_t ucIPv4[ 4 ] = { 192, 168, 2, 1 };
+    size_t uxAliasLength;
+    size_t uxAlias;
+    size_t uxOffset;
+
+    usChar2u16_Stub( usChar2u16_Callback );
+    ulChar2u32_Stub( ulChar2u32_Callback );
+
+    uxOffset = prvAddHeader( ucBuffer, 0x8180U, 1U, 3U );
+    uxOffset = prvAddName( ucBuffer, uxOffset, "www.freertos.org" );
+    uxOffset = prvAddQuestionFields( ucBuffer, uxOffset, dnsTYPE_A_HOST );
+
+    /* www.freertos.org is an alias of cdn.freertos.org, the alias points to
+     * the suffix in the question. */
+    ucAlias[ 0 ] = 3;
+    memcpy( &( ucAlias[ 1 ] ), "cdn", 3 );
+    uxAliasLength = prvAddPointer( ucAlias, 4U, sizeof( DNSMessage_t ) + 4U );
+    uxOffset = prvAddPointer( ucBuffer, uxOffset, sizeof( DNSMessage_t ) );
+    uxAlias = uxOffset + 10U;
+    uxOffset = prvAddRecordData( ucBuffer, uxOffset, dnsTYPE_CNAME, 300U, ucAlias, ( uint16_t ) uxAliasLength );
+
+    /* An address of the original name is no longer expected. */
+    uxOffset = prvAddPointer( ucBuffer, uxOffset, sizeof( DNSMessage_t ) );
+    uxOffset = prvAddRecordData( ucBuffer, uxOffset, dnsTYPE_A_HOST, 300U, ucIPv4, sizeof( ucIPv4 ) );
+
+    uxOffset = prvAddPointer( ucBuffer, uxOffset, uxAlias );
+    uxOffset = prvAddRecordData( ucBuffer, uxOffset, dnsTYPE_A_HOST, 60U, ucIPv4, sizeof( ucIPv4 ) );
+
+    TEST_ASSERT_EQUAL( 1, DNS_ParseAddressRecords( ucBuffer, uxOffset, "www.freertos.org", xRecords, 4U ) );
+    TEST_ASSERT_EQUAL( 60U, xRecords[ 0 ].ulTTL );
+}
+
+/**
+ * @brief A list of addresses is made from the records.
+ */
+void test_DNS_AddressRecordsToList( void )
+{
+    DNSAddressRecord_t xRecords[ 2 ] = { 0 };
+    struct freertos_addrinfo xInfo[ 2 ] = { 0 };
+    struct freertos_addrinfo * pxList;
+
+    xRecords[ 0 ].xAddress.xIPAddress.ulIP_IPv4 = 0x0102A8C0U;
+    xRecords[ 1 ].xAddress.xIs_IPv6 = pdTRUE;
+
+    pxNew_AddrInfo_ExpectAndReturn( "freertos", FREERTOS_AF_INET4, ( const uint8_t * ) &( xRecords[ 0 ].xAddress.xIPAddress.ulIP_IPv4 ), &( xInfo[ 0 ] ) );
+    pxNew_AddrInfo_ExpectAndReturn( "freertos", FREERTOS_AF_INET6, xRecords[ 1 ].xAddress.xIPAddress.xIP_IPv6.ucBytes, &( xInfo[ 1 ] ) );
+
+    pxList = DNS_AddressRecordsToList( "freertos", xRecords, 2U );
+
+    TEST_ASSERT_EQUAL_PTR( &( xInfo[ 0 ] ), pxList );
+    TEST_ASSERT_EQUAL_PTR( &( xInfo[ 1 ] ), xInfo[ 0 ].ai_next );
+
+    /* The list ends when running out of memory. */
+    xInfo[ 0 ].ai_next = NULL;
+    pxNew_AddrInfo_ExpectAnyArgsAndReturn( &( xInfo[ 0 ] ) );
+    pxNew_AddrInfo_ExpectAnyArgsAndReturn( NULL );
+
+    pxList = DNS_AddressRecordsToList( "freertos", xRecords, 2U );
+
+    TEST_ASSERT_EQUAL_PTR( &( xInfo[ 0 ] ), pxList );
+    TEST_ASSERT_NULL( xInfo[ 0 ].ai_next );
+}
+
+/**
+ * @brief The records are stored in the DNS cache, with a network-endian TTL.
+ */
+void test_DNS_StoreAddressRecords( void )
+{
+    DNSAddressRecord_t xRecords[ 2 ] = { 0 };
+
+    xRecords[ 0 ].ulTTL = 300U;
+    xRecords[ 1 ].ulTTL = 600U;
+
+    FreeRTOS_dns_update_ExpectAndReturn( "freertos", NULL, FreeRTOS_htonl( 300U ), pdFALSE, NULL, pdTRUE );
+    FreeRTOS_dns_update_IgnoreArg_pxIP();
+    FreeRTOS_dns_update_ExpectAndReturn( "freertos", NULL, FreeRTOS_htonl( 600U ), pdFALSE, NULL, pdTRUE );
+    FreeRTOS_dns_update_IgnoreArg_pxIP();
+
+    DNS_StoreAddressRecords( "freertos", xRecords, 2U );
+}
@@ -0,0 +1,838 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "mock_task.h"
+#include "mock_list.h"
+#include "mock_queue.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_DNS.h"
+#include "mock_FreeRTOS_DNS_Cache.h"
+#include "mock_FreeRTOS_DNS_Parser.h"
+
+#include "FreeRTOS_DNS_Globals.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* The maximum number of queries that a test sends. */
+#define TEST_MAX_QUERIES    8
+
+/* A query that was passed to xDNSSendQuery(). */
+typedef struct xTEST_QUERY
+{
+    char pcName[ 32 ];       /* The host name that is looked up. */
+    uint16_t usIdentifier;   /* The identifier of the DNS message. */
+    BaseType_t xFamily;      /* FREERTOS_AF_INET4 or FREERTOS_AF_INET6. */
+    BaseType_t xNextServer;  /* pdTRUE for a retransmission through the next DNS server. */
+} TestQuery_t;
+
+/* The result of a look-up with a callback. */
+typedef struct xTEST_LOOK_UP
+{
+    size_t uxCalled;                     /* The number of times the callback was called. */
+    struct freertos_addrinfo * pxResult; /* The addresses passed to the callback. */
+} TestLookUp_t;
+
+/* Defined in the stubs, the number of blocks that have not been freed. */
+extern int lAllocatedBlocks;
+
+static TickType_t xTestTime;
+static uint8_t ucTestSocket;
+
+static TestQuery_t xQueries[ TEST_MAX_QUERIES ];
+static size_t uxQueryCount;
+static uint32_t ulNextIdentifier;
+
+/* The look-up that was passed to the IP-task. */
+static void * pvEventData;
+
+/* A reply that will be returned by FreeRTOS_recvfrom(), once. */
+static uint8_t ucReply[ sizeof( DNSMessage_t ) + 32U ];
+static BaseType_t xReplyPending;
+static size_t uxParseCalls;
+static BaseType_t xParseResult;
+static size_t uxStoreCalls;
+
+/* The behaviour of the DNS cache. */
+static BaseType_t xCacheHit;
+static size_t uxCacheLookUps;
+static size_t uxStaleRecords;
+static size_t uxRefreshDoneCalls;
+static char pcRefreshDoneName[ 32 ];
+
+static BaseType_t xTimerEnabled;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static TickType_t xStubGetTickCount( int NumCalls )
+{
+    return xTestTime;
+}
+
+static void vStubSetTimeOutState( TimeOut_t * const pxTimeOut,
+                                  int NumCalls )
+{
+    pxTimeOut->xOverflowCount = 0;
+    pxTimeOut->xTimeOnEntering = xTestTime;
+}
+
+static BaseType_t xStubCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                        TickType_t * const pxTicksToWait,
+                                        int NumCalls )
+{
+    BaseType_t xReturn = pdFALSE;
+    TickType_t xElapsed = xTestTime - pxTimeOut->xTimeOnEntering;
+
+    if( *pxTicksToWait == portMAX_DELAY )
+    {
+        /* Wait forever. */
+    }
+    else if( xElapsed >= *pxTicksToWait )
+    {
+        *pxTicksToWait = 0U;
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        *pxTicksToWait -= xElapsed;
+        pxTimeOut->xTimeOnEntering = xTestTime;
+    }
+
+    return xReturn;
+}
+
+static void vStubListInitialise( List_t * const pxList,
+                                 int NumCalls )
+{
+    ListItem_t * pxEnd = ( ListItem_t * ) &( pxList->xListEnd );
+
+    pxList->pxIndex = pxEnd;
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = pxEnd;
+    pxList->xListEnd.pxPrevious = pxEnd;
+    pxList->uxNumberOfItems = 0U;
+}
+
+static void vStubListInitialiseItem( ListItem_t * const pxItem,
+                                     int NumCalls )
+{
+    pxItem->pxContainer = NULL;
+}
+
+static void vStubListInsertEnd( List_t * const pxList,
+                                ListItem_t * const pxNewListItem,
+                                int NumCalls )
+{
+    ListItem_t * pxEnd = ( ListItem_t * ) &( pxList->xListEnd );
+
+    pxNewListItem->pxNext = pxEnd;
+    pxNewListItem->pxPrevious = pxEnd->pxPrevious;
+    pxEnd->pxPrevious->pxNext = pxNewListItem;
+    pxEnd->pxPrevious = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    pxList->uxNumberOfItems++;
+}
+
+static UBaseType_t uxStubListRemove( ListItem_t * const pxItemToRemove,
+                                     int NumCalls )
+{
+    List_t * pxList = pxItemToRemove->pxContainer;
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+    pxItemToRemove->pxContainer = NULL;
+    pxList->uxNumberOfItems--;
+
+    return pxList->uxNumberOfItems;
+}
+
+static BaseType_t xStubGetRandomNumber( uint32_t * pulNumber,
+                                       int NumCalls )
+{
+    *pulNumber = ulNextIdentifier++;
+
+    return pdTRUE;
+}
+
+static BaseType_t xStubSendEventStructToIPTask( const IPStackEvent_t * pxEvent,
+                                                TickType_t uxTimeout,
+                                                int NumCalls )
+{
+    TEST_ASSERT_EQUAL( eDNSResolverEvent, pxEvent->eEventType );
+    pvEventData = pxEvent->pvData;
+
+    return pdPASS;
+}
+
+static void vStubSetTimerEnableState( BaseType_t xEnableState,
+                                      int NumCalls )
+{
+    xTimerEnabled = xEnableState;
+}
+
+static void vStubTimerReload( TickType_t xTime,
+                              int NumCalls )
+{
+    xTimerEnabled = pdTRUE;
+}
+
+static BaseType_t xStubSendQuery( const char * pcHostName,
+                                  TickType_t uxIdentifier,
+                                  Socket_t xDNSSocket,
+                                  BaseType_t xFamily,
+                                  BaseType_t xNextServer,
+                                  int NumCalls )
+{
+    TestQuery_t * pxQuery = &( xQueries[ uxQueryCount ] );
+
+    TEST_ASSERT_LESS_THAN( TEST_MAX_QUERIES, uxQueryCount );
+    TEST_ASSERT_EQUAL_PTR( &( ucTestSocket ), xDNSSocket );
+
+    ( void ) strncpy( pxQuery->pcName, pcHostName, sizeof( pxQuery->pcName ) - 1U );
+    pxQuery->usIdentifier = ( uint16_t ) uxIdentifier;
+    pxQuery->xFamily = xFamily;
+    pxQuery->xNextServer = xNextServer;
+    uxQueryCount++;
+
+    return pdPASS;
+}
+
+static int32_t lStubRecvFrom( const ConstSocket_t xSocket,
+                              void * pvBuffer,
+                              size_t uxBufferLength,
+                              BaseType_t xFlags,
+                              struct freertos_sockaddr * pxSourceAddress,
+                              socklen_t * pxSourceAddressLength,
+                              int NumCalls )
+{
+    int32_t lReturn = -pdFREERTOS_ERRNO_EWOULDBLOCK;
+
+    TEST_ASSERT_EQUAL( FREERTOS_ZERO_COPY, xFlags );
+
+    if( xReplyPending != pdFALSE )
+    {
+        xReplyPending = pdFALSE;
+        *( ( uint8_t ** ) pvBuffer ) = ucReply;
+        lReturn = ( int32_t ) sizeof( ucReply );
+    }
+
+    return lReturn;
+}
+
+/* Every reply holds xParseResult addresses, 192.168.0.1 and up. */
+static BaseType_t xStubParseAddressRecords( const uint8_t * pucUDPPayloadBuffer,
+                                            size_t uxBufferLength,
+                                            const char * pcExpectedName,
+                                            DNSAddressRecord_t * pxRecords,
+                                            size_t uxMaxRecords,
+                                            int NumCalls )
+{
+    BaseType_t xIndex;
+
+    TEST_ASSERT_EQUAL_PTR( ucReply, pucUDPPayloadBuffer );
+    TEST_ASSERT_EQUAL_STRING( "www.freertos.org", pcExpectedName );
+
+    for( xIndex = 0; ( xIndex < xParseResult ) && ( ( size_t ) xIndex < uxMaxRecords ); xIndex++ )
+    {
+        pxRecords[ xIndex ].xAddress.xIPAddress.ulIP_IPv4 = FreeRTOS_htonl( 0xC0A80001U + ( uint32_t ) xIndex );
+        pxRecords[ xIndex ].ulTTL = 60U;
+    }
+
+    uxParseCalls++;
+
+    return xParseResult;
+}
+
+static void vStubStoreAddressRecords( const char * pcName,
+                                      const DNSAddressRecord_t * pxRecords,
+                                      size_t uxCount,
+                                      int NumCalls )
+{
+    uxStoreCalls++;
+}
+
+static struct freertos_addrinfo * pxStubAddressRecordsToList( const char * pcName,
+                                                              const DNSAddressRecord_t * pxRecords,
+                                                              size_t uxCount,
+                                                              int NumCalls )
+{
+    struct freertos_addrinfo * pxInfo = pvPortMalloc( sizeof( *pxInfo ) );
+
+    TEST_ASSERT_GREATER_THAN( 0U, uxCount );
+
+    ( void ) memset( pxInfo, 0, sizeof( *pxInfo ) );
+    pxInfo->ai_family = FREERTOS_AF_INET4;
+
+    return pxInfo;
+}
+
+static void vStubFreeAddrInfo( struct freertos_addrinfo * pxInfo,
+                               int NumCalls )
+{
+    while( pxInfo != NULL )
+    {
+        struct freertos_addrinfo * pxNext = pxInfo->ai_next;
+
+        vPortFree( pxInfo );
+        pxInfo = pxNext;
+    }
+}
+
+static uint32_t ulStubCacheLookup( const char * pcHostName,
+                                   BaseType_t xFamily,
+                                   struct freertos_addrinfo ** ppxAddressInfo,
+                                   int NumCalls )
+{
+    uint32_t ulReturn = 0U;
+
+    uxCacheLookUps++;
+
+    if( xCacheHit != pdFALSE )
+    {
+        *ppxAddressInfo = pxStubAddressRecordsToList( pcHostName, NULL, 1U, 0 );
+        ulReturn = FreeRTOS_htonl( 0xC0A80001U );
+    }
+
+    return ulReturn;
+}
+
+static size_t uxStubReadStale( const char * pcHostName,
+                               BaseType_t xFamily,
+                               DNSAddressRecord_t * pxRecords,
+                               size_t uxMaxRecords,
+                               int NumCalls )
+{
+    TEST_ASSERT_EQUAL_STRING( "www.freertos.org", pcHostName );
+
+    return ( uxStaleRecords < uxMaxRecords ) ? uxStaleRecords : uxMaxRecords;
+}
+
+static void vStubRefreshDone( const char * pcName,
+                              int NumCalls )
+{
+    ( void ) strncpy( pcRefreshDoneName, pcName, sizeof( pcRefreshDoneName ) - 1U );
+    uxRefreshDoneCalls++;
+}
+
+static void vTestCallback( const char * pcName,
+                           void * pvSearchID,
+                           struct freertos_addrinfo * pxAddress )
+{
+    TestLookUp_t * pxLookUp = ( TestLookUp_t * ) pvSearchID;
+
+    pxLookUp->uxCalled++;
+    pxLookUp->pxResult = pxAddress;
+}
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    xTestTime = 1000U;
+    uxQueryCount = 0U;
+    ulNextIdentifier = 0x1234U;
+    pvEventData = NULL;
+    xReplyPending = pdFALSE;
+    uxParseCalls = 0U;
+    xParseResult = 1;
+    uxStoreCalls = 0U;
+    xCacheHit = pdFALSE;
+    uxCacheLookUps = 0U;
+    uxStaleRecords = 0U;
+    uxRefreshDoneCalls = 0U;
+    xTimerEnabled = pdFALSE;
+    lAllocatedBlocks = 0;
+
+    ( void ) memset( xQueries, 0, sizeof( xQueries ) );
+    ( void ) memset( ucReply, 0, sizeof( ucReply ) );
+    ( void ) memset( pcRefreshDoneName, 0, sizeof( pcRefreshDoneName ) );
+
+    xTaskGetTickCount_Stub( xStubGetTickCount );
+    vTaskSetTimeOutState_Stub( vStubSetTimeOutState );
+    xTaskCheckForTimeOut_Stub( xStubCheckForTimeOut );
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdFALSE );
+
+    vListInitialise_Stub( vStubListInitialise );
+    vListInitialiseItem_Stub( vStubListInitialiseItem );
+    vListInsertEnd_Stub( vStubListInsertEnd );
+    uxListRemove_Stub( uxStubListRemove );
+
+    xApplicationGetRandomNumber_Stub( xStubGetRandomNumber );
+    xSendEventStructToIPTask_Stub( xStubSendEventStructToIPTask );
+    vIPSetDNSResolverTimerEnableState_Stub( vStubSetTimerEnableState );
+    vDNSResolverTimerReload_Stub( vStubTimerReload );
+
+    /* The socket is created by the first test that starts a look-up. */
+    FreeRTOS_socket_IgnoreAndReturn( ( Socket_t ) &( ucTestSocket ) );
+    xSocketValid_IgnoreAndReturn( pdTRUE );
+    FreeRTOS_setsockopt_IgnoreAndReturn( 0 );
+    vSocketBind_IgnoreAndReturn( 0 );
+    FreeRTOS_recvfrom_Stub( lStubRecvFrom );
+    FreeRTOS_ReleaseUDPPayloadBuffer_Ignore();
+
+    xDNSSendQuery_Stub( xStubSendQuery );
+    FreeRTOS_freeaddrinfo_Stub( vStubFreeAddrInfo );
+    DNS_ParseAddressRecords_Stub( xStubParseAddressRecords );
+    DNS_StoreAddressRecords_Stub( vStubStoreAddressRecords );
+    DNS_AddressRecordsToList_Stub( pxStubAddressRecordsToList );
+    Prepare_CacheLookup_Stub( ulStubCacheLookup );
+    uxDNSCacheReadStale_Stub( uxStubReadStale );
+    vDNSCacheRefreshDone_Stub( vStubRefreshDone );
+    vDNSCacheStartRefreshes_Ignore();
+
+    vDNSResolverInitialise();
+}
+
+/* ======================== Helper functions ======================== */
+
+/*
+ * @brief Start a look-up with a callback and let the IP-task add it.
+ */
+static DNSResolveHandle_t prvStartLookUp( const char * pcName,
+                                          BaseType_t xFamily,
+                                          TestLookUp_t * pxLookUp,
+                                          TickType_t uxTimeout )
+{
+    DNSResolveHandle_t xHandle = FreeRTOS_DNSResolveStart( pcName, xFamily, vTestCallback, pxLookUp, uxTimeout );
+
+    TEST_ASSERT_NOT_NULL( xHandle );
+    TEST_ASSERT_EQUAL_PTR( xHandle, pvEventData );
+
+    vDNSResolverHandleEvent( pvEventData );
+
+    return xHandle;
+}
+
+/*
+ * @brief Let the socket of the resolver receive a reply to a query.
+ */
+static void prvReceiveReply( size_t uxQuery )
+{
+    DNSMessage_t * pxHeader = ( DNSMessage_t * ) ucReply;
+
+    pxHeader->usIdentifier = xQueries[ uxQuery ].usIdentifier;
+    xReplyPending = pdTRUE;
+
+    vDNSResolverHandleEvent( NULL );
+
+    TEST_ASSERT_FALSE( xReplyPending );
+}
+
+/* ======================== Test cases ======================== */
+
+/*
+ * @brief Two look-ups of the same name share a single query, both get the
+ *        answer. The timer stops when no look-ups are left.
+ */
+void test_FreeRTOS_DNSResolveStart_SharedQuery( void )
+{
+    TestLookUp_t xFirst = { 0 };
+    TestLookUp_t xSecond = { 0 };
+    DNSResolveHandle_t xHandle1;
+    DNSResolveHandle_t xHandle2;
+
+    xHandle1 = prvStartLookUp( "www.freertos.org", FREERTOS_AF_INET4, &( xFirst ), 0U );
+    TEST_ASSERT_TRUE( xTimerEnabled );
+
+    /* The name is compared without case. */
+    xHandle2 = prvStartLookUp( "WWW.FreeRTOS.org", FREERTOS_AF_INET4, &( xSecond ), 0U );
+
+    TEST_ASSERT_EQUAL( 1U, uxQueryCount );
+    TEST_ASSERT_EQUAL_STRING( "www.freertos.org", xQueries[ 0 ].pcName );
+    TEST_ASSERT_EQUAL( FREERTOS_AF_INET4, xQueries[ 0 ].xFamily );
+    TEST_ASSERT_FALSE( xQueries[ 0 ].xNextServer );
+    TEST_ASSERT_EQUAL( 2U, uxCacheLookUps );
+
+    prvReceiveReply( 0U );
+
+    TEST_ASSERT_EQUAL( 1U, uxParseCalls );
+    TEST_ASSERT_EQUAL( 1U, uxStoreCalls );
+    TEST_ASSERT_EQUAL( 1U, xFirst.uxCalled );
+    TEST_ASSERT_EQUAL( 1U, xSecond.uxCalled );
+    TEST_ASSERT_NOT_NULL( xFirst.pxResult );
+    TEST_ASSERT_NOT_NULL( xSecond.pxResult );
+    TEST_ASSERT_TRUE( xFirst.pxResult != xSecond.pxResult );
+    TEST_ASSERT_FALSE( xTimerEnabled );
+
+    /* The results belong to the handles. */
+    FreeRTOS_DNSResolveRelease( xHandle1 );
+    FreeRTOS_DNSResolveRelease( xHandle2 );
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief When one of two look-ups that share a query is released, the
+ *        other one still gets the answer.
+ */
+void test_FreeRTOS_DNSResolveStart_SharedQueryOneReleased( void )
+{
+    TestLookUp_t xFirst = { 0 };
+    TestLookUp_t xSecond = { 0 };
+    DNSResolveHandle_t xHandle1;
+    DNSResolveHandle_t xHandle2;
+
+    xHandle1 = prvStartLookUp( "www.freertos.org", FREERTOS_AF_INET4, &( xFirst ), 0U );
+    xHandle2 = prvStartLookUp( "www.freertos.org", FREERTOS_AF_INET4, &( xSecond ), 0U );
+
+    FreeRTOS_DNSResolveRelease( xHandle1 );
+
+    /* The IP-task releases the cancelled look-up. */
+    vDNSResolverCheck();
+    TEST_ASSERT_TRUE( xTimerEnabled );
+
+    prvReceiveReply( 0U );
+
+    TEST_ASSERT_EQUAL( 1U, uxQueryCount );
+    TEST_ASSERT_EQUAL( 0U, xFirst.uxCalled );
+    TEST_ASSERT_EQUAL( 1U, xSecond.uxCalled );
+    TEST_ASSERT_NOT_NULL( xSecond.pxResult );
+
+    FreeRTOS_DNSResolveRelease( xHandle2 );
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief A look-up of both families sends two queries, the callback is
+ *        called when both have been answered.
+ */
+void test_FreeRTOS_DNSResolveStart_BothFamilies( void )
+{
+    TestLookUp_t xLookUp = { 0 };
+    DNSResolveHandle_t xHandle;
+
+    xHandle = prvStartLookUp( "www.freertos.org", 0, &( xLookUp ), 0U );
+
+    TEST_ASSERT_EQUAL( 2U, uxQueryCount );
+    TEST_ASSERT_EQUAL( FREERTOS_AF_INET4, xQueries[ 0 ].xFamily );
+    TEST_ASSERT_EQUAL( FREERTOS_AF_INET6, xQueries[ 1 ].xFamily );
+    TEST_ASSERT_TRUE( xQueries[ 0 ].usIdentifier != xQueries[ 1 ].usIdentifier );
+
+    prvReceiveReply( 1U );
+    TEST_ASSERT_EQUAL( 0U, xLookUp.uxCalled );
+
+    /* A reply without answers finishes the query as well. */
+    xParseResult = 0;
+    prvReceiveReply( 0U );
+
+    TEST_ASSERT_EQUAL( 1U, xLookUp.uxCalled );
+    TEST_ASSERT_NOT_NULL( xLookUp.pxResult );
+
+    FreeRTOS_DNSResolveRelease( xHandle );
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief An answer found in the DNS cache finishes the look-up without
+ *        sending a query.
+ */
+void test_FreeRTOS_DNSResolveStart_CacheHit( void )
+{
+    TestLookUp_t xLookUp = { 0 };
+    DNSResolveHandle_t xHandle;
+
+    xCacheHit = pdTRUE;
+
+    xHandle = prvStartLookUp( "www.freertos.org", FREERTOS_AF_INET4, &( xLookUp ), 0U );
+
+    TEST_ASSERT_EQUAL( 0U, uxQueryCount );
+    TEST_ASSERT_EQUAL( 1U, xLookUp.uxCalled );
+    TEST_ASSERT_NOT_NULL( xLookUp.pxResult );
+    TEST_ASSERT_FALSE( xTimerEnabled );
+
+    FreeRTOS_DNSResolveRelease( xHandle );
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief A look-up without callback is collected with
+ *        FreeRTOS_DNSResolveWait(), which passes the result only once.
+ */
+void test_FreeRTOS_DNSResolveWait_CollectsResult( void )
+{
+    DNSResolveHandle_t xHandle;
+    struct freertos_addrinfo * pxResult = NULL;
+
+    xQueueGenericCreate_IgnoreAndReturn( ( QueueHandle_t ) &( ucTestSocket ) );
+    xQueueGenericSend_IgnoreAndReturn( pdPASS );
+    vQueueDelete_Ignore();
+
+    xHandle = FreeRTOS_DNSResolveStart( "www.freertos.org", FREERTOS_AF_INET4, NULL, NULL, 0U );
+    TEST_ASSERT_NOT_NULL( xHandle );
+    vDNSResolverHandleEvent( pvEventData );
+
+    xQueueSemaphoreTake_ExpectAndReturn( ( QueueHandle_t ) &( ucTestSocket ), 10U, pdFAIL );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EWOULDBLOCK, FreeRTOS_DNSResolveWait( xHandle, 10U, &( pxResult ) ) );
+
+    prvReceiveReply( 0U );
+
+    xQueueSemaphoreTake_ExpectAndReturn( ( QueueHandle_t ) &( ucTestSocket ), 10U, pdPASS );
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_DNSResolveWait( xHandle, 10U, &( pxResult ) ) );
+    TEST_ASSERT_NOT_NULL( pxResult );
+    FreeRTOS_freeaddrinfo( pxResult );
+
+    xQueueSemaphoreTake_ExpectAndReturn( ( QueueHandle_t ) &( ucTestSocket ), 10U, pdPASS );
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_DNSResolveWait( xHandle, 10U, &( pxResult ) ) );
+    TEST_ASSERT_NULL( pxResult );
+
+    FreeRTOS_DNSResolveRelease( xHandle );
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief A look-up that is released before the IP-task has seen it, is
+ *        freed by the IP-task without sending a query.
+ */
+void test_FreeRTOS_DNSResolveRelease_BeforeEvent( void )
+{
+    TestLookUp_t xLookUp = { 0 };
+    DNSResolveHandle_t xHandle;
+
+    xHandle = FreeRTOS_DNSResolveStart( "www.freertos.org", FREERTOS_AF_INET4, vTestCallback, &( xLookUp ), 0U );
+    TEST_ASSERT_NOT_NULL( xHandle );
+
+    FreeRTOS_DNSResolveRelease( xHandle );
+    TEST_ASSERT_EQUAL( 1, lAllocatedBlocks );
+
+    vDNSResolverHandleEvent( pvEventData );
+
+    TEST_ASSERT_EQUAL( 0U, uxQueryCount );
+    TEST_ASSERT_EQUAL( 0U, xLookUp.uxCalled );
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief A look-up that is released before the answer arrives, is freed by
+ *        the IP-task. Its callback is not called, and a late reply is ignored.
+ */
+void test_FreeRTOS_DNSResolveRelease_BeforeAnswer( void )
+{
+    TestLookUp_t xLookUp = { 0 };
+    DNSResolveHandle_t xHandle;
+
+    xHandle = prvStartLookUp( "www.freertos.org", FREERTOS_AF_INET4, &( xLookUp ), 0U );
+    TEST_ASSERT_EQUAL( 1U, uxQueryCount );
+
+    FreeRTOS_DNSResolveRelease( xHandle );
+    TEST_ASSERT_EQUAL( 1, lAllocatedBlocks );
+
+    vDNSResolverCheck();
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+    TEST_ASSERT_FALSE( xTimerEnabled );
+
+    /* The query is free, the reply is not parsed. */
+    prvReceiveReply( 0U );
+
+    TEST_ASSERT_EQUAL( 0U, uxParseCalls );
+    TEST_ASSERT_EQUAL( 0U, xLookUp.uxCalled );
+}
+
+/*
+ * @brief A query that does not get a reply is retransmitted through the next
+ *        DNS server. When all attempts have failed, an expired entry of the
+ *        DNS cache is served.
+ */
+void test_vDNSResolverCheck_TimeOutServesStale( void )
+{
+    TestLookUp_t xLookUp = { 0 };
+    DNSResolveHandle_t xHandle;
+
+    uxStaleRecords = 1U;
+
+    xHandle = prvStartLookUp( "www.freertos.org", FREERTOS_AF_INET4, &( xLookUp ), 0U );
+
+    xTestTime += ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS - 1U;
+    vDNSResolverCheck();
+    TEST_ASSERT_EQUAL( 1U, uxQueryCount );
+
+    xTestTime += 1U;
+    vDNSResolverCheck();
+    TEST_ASSERT_EQUAL( 2U, uxQueryCount );
+    TEST_ASSERT_TRUE( xQueries[ 1 ].xNextServer );
+    TEST_ASSERT_EQUAL( xQueries[ 0 ].usIdentifier, xQueries[ 1 ].usIdentifier );
+    TEST_ASSERT_EQUAL( 0U, xLookUp.uxCalled );
+
+    xTestTime += ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS;
+    vDNSResolverCheck();
+
+    TEST_ASSERT_EQUAL( ipconfigDNS_REQUEST_ATTEMPTS, uxQueryCount );
+    TEST_ASSERT_EQUAL( 1U, xLookUp.uxCalled );
+    TEST_ASSERT_NOT_NULL( xLookUp.pxResult );
+
+    FreeRTOS_DNSResolveRelease( xHandle );
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief When all attempts have failed and the DNS cache has no expired
+ *        entry, the look-up finishes without addresses.
+ */
+void test_vDNSResolverCheck_TimeOutNothingStale( void )
+{
+    TestLookUp_t xLookUp = { 0 };
+    DNSResolveHandle_t xHandle;
+
+    xHandle = prvStartLookUp( "www.freertos.org", FREERTOS_AF_INET4, &( xLookUp ), 0U );
+
+    xTestTime += ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS;
+    vDNSResolverCheck();
+    xTestTime += ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS;
+    vDNSResolverCheck();
+
+    TEST_ASSERT_EQUAL( 1U, xLookUp.uxCalled );
+    TEST_ASSERT_NULL( xLookUp.pxResult );
+
+    FreeRTOS_DNSResolveRelease( xHandle );
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief A look-up whose own time-out expires finishes without addresses,
+ *        and its query becomes free.
+ */
+void test_vDNSResolverCheck_LookUpTimedOut( void )
+{
+    TestLookUp_t xLookUp = { 0 };
+    DNSResolveHandle_t xHandle;
+
+    xHandle = prvStartLookUp( "www.freertos.org", FREERTOS_AF_INET4, &( xLookUp ), 1000U );
+
+    xTestTime += pdMS_TO_TICKS( 1000U );
+    vDNSResolverCheck();
+
+    TEST_ASSERT_EQUAL( 1U, xLookUp.uxCalled );
+    TEST_ASSERT_NULL( xLookUp.pxResult );
+    TEST_ASSERT_FALSE( xTimerEnabled );
+
+    prvReceiveReply( 0U );
+    TEST_ASSERT_EQUAL( 0U, uxParseCalls );
+
+    FreeRTOS_DNSResolveRelease( xHandle );
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief A refresh of the DNS cache does not look in the cache. Its reply
+ *        is stored, the cache is told that the refresh is done, and the
+ *        look-up is freed by the IP-task.
+ */
+void test_xDNSResolverPrefetch_RefreshesCache( void )
+{
+    xCacheHit = pdTRUE;
+
+    TEST_ASSERT_EQUAL( pdPASS, xDNSResolverPrefetch( "www.freertos.org", FREERTOS_AF_INET4 ) );
+
+    TEST_ASSERT_EQUAL( 0U, uxCacheLookUps );
+    TEST_ASSERT_EQUAL( 1U, uxQueryCount );
+    TEST_ASSERT_EQUAL( 0U, uxRefreshDoneCalls );
+
+    prvReceiveReply( 0U );
+
+    TEST_ASSERT_EQUAL( 1U, uxStoreCalls );
+    TEST_ASSERT_EQUAL( 1U, uxRefreshDoneCalls );
+    TEST_ASSERT_EQUAL_STRING( "www.freertos.org", pcRefreshDoneName );
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief A look-up of a name that is being refreshed shares the query of
+ *        the refresh.
+ */
+void test_xDNSResolverPrefetch_SharedWithLookUp( void )
+{
+    TestLookUp_t xLookUp = { 0 };
+    DNSResolveHandle_t xHandle;
+
+    TEST_ASSERT_EQUAL( pdPASS, xDNSResolverPrefetch( "www.freertos.org", FREERTOS_AF_INET4 ) );
+    xHandle = prvStartLookUp( "www.freertos.org", FREERTOS_AF_INET4, &( xLookUp ), 0U );
+
+    TEST_ASSERT_EQUAL( 1U, uxQueryCount );
+
+    prvReceiveReply( 0U );
+
+    TEST_ASSERT_EQUAL( 1U, uxRefreshDoneCalls );
+    TEST_ASSERT_EQUAL( 1U, xLookUp.uxCalled );
+    TEST_ASSERT_NOT_NULL( xLookUp.pxResult );
+
+    FreeRTOS_DNSResolveRelease( xHandle );
+
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief A refresh that fails, tells the DNS cache as well, so the entry
+ *        may be refreshed again later.
+ */
+void test_xDNSResolverPrefetch_NoReply( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, xDNSResolverPrefetch( "www.freertos.org", FREERTOS_AF_INET6 ) );
+    TEST_ASSERT_EQUAL( FREERTOS_AF_INET6, xQueries[ 0 ].xFamily );
+
+    xTestTime += ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS;
+    vDNSResolverCheck();
+    xTestTime += ipconfigDNS_RECEIVE_BLOCK_TIME_TICKS;
+    vDNSResolverCheck();
+
+    TEST_ASSERT_EQUAL( 1U, uxRefreshDoneCalls );
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
+
+/*
+ * @brief A refresh of an invalid name is not started.
+ */
+void test_xDNSResolverPrefetch_InvalidName( void )
+{
+    TEST_ASSERT_EQUAL( pdFAIL, xDNSResolverPrefetch( "", FREERTOS_AF_INET4 ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xDNSResolverPrefetch( "printer.local", FREERTOS_AF_INET4 ) );
+
+    TEST_ASSERT_EQUAL( 0U, uxQueryCount );
+    TEST_ASSERT_EQUAL( 0, lAllocatedBlocks );
+}
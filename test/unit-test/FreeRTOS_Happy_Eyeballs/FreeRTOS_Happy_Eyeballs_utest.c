@@ -0,0 +1,658 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "mock_task.h"
+#include "mock_list.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_DNS.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* The maximum number of sockets, addresses and look-ups of a test. */
+#define TEST_MAX_SOCKETS      ipconfigHAPPY_EYEBALLS_MAX_ATTEMPTS
+#define TEST_MAX_ADDRESSES    4
+
+/* A time that never comes. */
+#define TEST_NEVER            ( ( TickType_t ) 0xFFFFFFFFU )
+
+/* The number of calls after which a test is considered to be stuck in a loop. */
+#define TEST_MAX_CALLS        10000
+
+/* The behaviour of a connection attempt, relative to its start. */
+typedef struct xTEST_ATTEMPT
+{
+    TickType_t xConnectAfter; /* The time until the attempt is connected. */
+    TickType_t xFailAfter;    /* The time until the attempt is refused. */
+    TickType_t xStartTime;    /* The time at which the attempt was started. */
+    BaseType_t xFamily;       /* The family of the address that is tried. */
+    uint8_t ucHost;           /* The last byte of the address that is tried. */
+    BaseType_t xClosed;       /* pdTRUE when the socket was closed. */
+} TestAttempt_t;
+
+/* The behaviour of a look-up of the asynchronous resolver. */
+typedef struct xTEST_LOOK_UP
+{
+    BaseType_t xStartFails;              /* pdTRUE when FreeRTOS_DNSResolveStart() returns NULL. */
+    TickType_t xAnswerTime;              /* The time at which the look-up finishes. */
+    struct freertos_addrinfo * pxAnswer; /* The addresses found. */
+    BaseType_t xCollected;               /* pdTRUE when the answer was passed to the caller. */
+    BaseType_t xReleased;                /* pdTRUE when the handle was released. */
+} TestLookUp_t;
+
+static TickType_t xTestTime;
+static size_t uxCalls;
+
+static uint8_t ucSockets[ TEST_MAX_SOCKETS ];
+static TestAttempt_t xAttempts[ TEST_MAX_SOCKETS ];
+static size_t uxAttemptCount;
+
+/* Index 0 is the IPv6 look-up, index 1 is the IPv4 look-up. */
+static TestLookUp_t xLookUps[ 2 ];
+static size_t uxGetAddrInfoCount;
+static size_t uxFreeAddrInfoCount;
+
+static struct freertos_addrinfo xIPv6Addresses[ TEST_MAX_ADDRESSES ];
+static struct freertos_addrinfo xIPv4Addresses[ TEST_MAX_ADDRESSES ];
+
+/* ======================== Stub Callback Functions ========================= */
+
+static TickType_t xStubGetTickCount( int NumCalls )
+{
+    TEST_ASSERT_LESS_THAN( TEST_MAX_CALLS, ++uxCalls );
+
+    return xTestTime;
+}
+
+static void vStubSetTimeOutState( TimeOut_t * const pxTimeOut,
+                                  int NumCalls )
+{
+    pxTimeOut->xOverflowCount = 0;
+    pxTimeOut->xTimeOnEntering = xTestTime;
+}
+
+static BaseType_t xStubCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                        TickType_t * const pxTicksToWait,
+                                        int NumCalls )
+{
+    BaseType_t xReturn = pdFALSE;
+    TickType_t xElapsed = xTestTime - pxTimeOut->xTimeOnEntering;
+
+    if( xElapsed >= *pxTicksToWait )
+    {
+        *pxTicksToWait = 0U;
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        *pxTicksToWait -= xElapsed;
+        pxTimeOut->xTimeOnEntering = xTestTime;
+    }
+
+    return xReturn;
+}
+
+static size_t prvAttemptIndex( Socket_t xSocket )
+{
+    size_t uxIndex = ( size_t ) ( ( uint8_t * ) xSocket - ucSockets );
+
+    TEST_ASSERT_LESS_THAN( uxAttemptCount, uxIndex );
+
+    return uxIndex;
+}
+
+/* The time at which an attempt in progress will change its state. */
+static TickType_t prvAttemptEvent( const TestAttempt_t * pxAttempt )
+{
+    TickType_t xEvent = TEST_NEVER;
+
+    if( pxAttempt->xConnectAfter != TEST_NEVER )
+    {
+        xEvent = pxAttempt->xStartTime + pxAttempt->xConnectAfter;
+    }
+
+    if( ( pxAttempt->xFailAfter != TEST_NEVER ) && ( ( pxAttempt->xStartTime + pxAttempt->xFailAfter ) < xEvent ) )
+    {
+        xEvent = pxAttempt->xStartTime + pxAttempt->xFailAfter;
+    }
+
+    return xEvent;
+}
+
+static Socket_t xStubSocket( BaseType_t xDomain,
+                             BaseType_t xType,
+                             BaseType_t xProtocol,
+                             int NumCalls )
+{
+    TEST_ASSERT_LESS_THAN( TEST_MAX_SOCKETS, uxAttemptCount );
+    TEST_ASSERT_EQUAL( FREERTOS_SOCK_STREAM, xType );
+
+    xAttempts[ uxAttemptCount ].xFamily = xDomain;
+    xAttempts[ uxAttemptCount ].xStartTime = xTestTime;
+
+    return ( Socket_t ) &( ucSockets[ uxAttemptCount++ ] );
+}
+
+static BaseType_t xStubConnect( Socket_t xClientSocket,
+                                const struct freertos_sockaddr * pxAddress,
+                                socklen_t xAddressLength,
+                                int NumCalls )
+{
+    TestAttempt_t * pxAttempt = &( xAttempts[ prvAttemptIndex( xClientSocket ) ] );
+
+    TEST_ASSERT_EQUAL( pxAttempt->xFamily, pxAddress->sin_family );
+    TEST_ASSERT_EQUAL( FreeRTOS_htons( 443U ), pxAddress->sin_port );
+
+    if( pxAddress->sin_family == FREERTOS_AF_INET6 )
+    {
+        pxAttempt->ucHost = pxAddress->sin_address.xIP_IPv6.ucBytes[ 15 ];
+    }
+    else
+    {
+        pxAttempt->ucHost = ( uint8_t ) ( FreeRTOS_ntohl( pxAddress->sin_address.ulIP_IPv4 ) & 0xFFU );
+    }
+
+    return -pdFREERTOS_ERRNO_EWOULDBLOCK;
+}
+
+static BaseType_t xStubCloseSocket( Socket_t xSocket,
+                                    int NumCalls )
+{
+    xAttempts[ prvAttemptIndex( xSocket ) ].xClosed = pdTRUE;
+
+    return 1;
+}
+
+static BaseType_t xStubIsSocketConnected( ConstSocket_t xSocket,
+                                          int NumCalls )
+{
+    const TestAttempt_t * pxAttempt = &( xAttempts[ prvAttemptIndex( ( Socket_t ) xSocket ) ] );
+    BaseType_t xReturn = pdFALSE;
+
+    if( ( pxAttempt->xConnectAfter != TEST_NEVER ) && ( xTestTime >= ( pxAttempt->xStartTime + pxAttempt->xConnectAfter ) ) )
+    {
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+
+static BaseType_t xStubConnStatus( ConstSocket_t xSocket,
+                                   int NumCalls )
+{
+    const TestAttempt_t * pxAttempt = &( xAttempts[ prvAttemptIndex( ( Socket_t ) xSocket ) ] );
+    BaseType_t xReturn = ( BaseType_t ) eSYN_FIRST;
+
+    if( ( pxAttempt->xFailAfter != TEST_NEVER ) && ( xTestTime >= ( pxAttempt->xStartTime + pxAttempt->xFailAfter ) ) )
+    {
+        xReturn = ( BaseType_t ) eCLOSE_WAIT;
+    }
+
+    return xReturn;
+}
+
+/* Let the time pass until the wait time has passed, or until an attempt in
+ * progress changes its state. */
+static BaseType_t xStubSelect( SocketSet_t xSocketSet,
+                               TickType_t xBlockTimeTicks,
+                               int NumCalls )
+{
+    TickType_t xWakeUp = xTestTime + xBlockTimeTicks;
+    size_t uxIndex;
+
+    TEST_ASSERT_LESS_THAN( TEST_MAX_CALLS, NumCalls );
+
+    for( uxIndex = 0U; uxIndex < uxAttemptCount; uxIndex++ )
+    {
+        TickType_t xEvent = prvAttemptEvent( &( xAttempts[ uxIndex ] ) );
+
+        if( ( xAttempts[ uxIndex ].xClosed == pdFALSE ) && ( xEvent > xTestTime ) && ( xEvent < xWakeUp ) )
+        {
+            xWakeUp = xEvent;
+        }
+    }
+
+    xTestTime = xWakeUp;
+
+    return 1;
+}
+
+static size_t prvLookUpIndex( DNSResolveHandle_t xHandle )
+{
+    size_t uxIndex = ( size_t ) ( ( TestLookUp_t * ) xHandle - xLookUps );
+
+    TEST_ASSERT_LESS_THAN( 2U, uxIndex );
+    TEST_ASSERT_FALSE( xLookUps[ uxIndex ].xReleased );
+
+    return uxIndex;
+}
+
+static DNSResolveHandle_t xStubResolveStart( const char * pcHostName,
+                                             BaseType_t xFamily,
+                                             FOnDNSEvent pCallback,
+                                             void * pvSearchID,
+                                             TickType_t uxTimeout,
+                                             int NumCalls )
+{
+    size_t uxIndex = ( xFamily == FREERTOS_AF_INET6 ) ? 0U : 1U;
+    DNSResolveHandle_t xHandle = NULL;
+
+    TEST_ASSERT_EQUAL_STRING( "www.freertos.org", pcHostName );
+    TEST_ASSERT_NULL( pCallback );
+
+    if( xLookUps[ uxIndex ].xStartFails == pdFALSE )
+    {
+        xHandle = ( DNSResolveHandle_t ) &( xLookUps[ uxIndex ] );
+    }
+
+    return xHandle;
+}
+
+/* Wait for a look-up, the time passes while waiting. */
+static BaseType_t xStubResolveWait( DNSResolveHandle_t xHandle,
+                                    TickType_t uxBlockTime,
+                                    struct freertos_addrinfo ** ppxResult,
+                                    int NumCalls )
+{
+    TestLookUp_t * pxLookUp = &( xLookUps[ prvLookUpIndex( xHandle ) ] );
+    BaseType_t xReturn = -pdFREERTOS_ERRNO_EWOULDBLOCK;
+
+    TEST_ASSERT_LESS_THAN( TEST_MAX_CALLS, NumCalls );
+
+    if( ( xTestTime < pxLookUp->xAnswerTime ) && ( ( pxLookUp->xAnswerTime - xTestTime ) <= uxBlockTime ) )
+    {
+        xTestTime = pxLookUp->xAnswerTime;
+    }
+    else if( xTestTime < pxLookUp->xAnswerTime )
+    {
+        xTestTime += uxBlockTime;
+    }
+    else
+    {
+        /* Finished already. */
+    }
+
+    if( xTestTime >= pxLookUp->xAnswerTime )
+    {
+        *ppxResult = ( pxLookUp->xCollected == pdFALSE ) ? pxLookUp->pxAnswer : NULL;
+        pxLookUp->xCollected = pdTRUE;
+        xReturn = 0;
+    }
+
+    return xReturn;
+}
+
+static void vStubResolveRelease( DNSResolveHandle_t xHandle,
+                                 int NumCalls )
+{
+    xLookUps[ prvLookUpIndex( xHandle ) ].xReleased = pdTRUE;
+}
+
+static BaseType_t xStubGetAddrInfo( const char * pcName,
+                                    const char * pcService,
+                                    const struct freertos_addrinfo * pxHints,
+                                    struct freertos_addrinfo ** ppxResult,
+                                    int NumCalls )
+{
+    size_t uxIndex = ( pxHints->ai_family == FREERTOS_AF_INET6 ) ? 0U : 1U;
+    BaseType_t xReturn = -pdFREERTOS_ERRNO_ENOENT;
+
+    TEST_ASSERT_EQUAL_STRING( "www.freertos.org", pcName );
+    TEST_ASSERT_TRUE( xLookUps[ uxIndex ].xStartFails );
+
+    uxGetAddrInfoCount++;
+    *ppxResult = xLookUps[ uxIndex ].pxAnswer;
+
+    if( *ppxResult != NULL )
+    {
+        xReturn = 0;
+    }
+
+    return xReturn;
+}
+
+static void vStubFreeAddrInfo( struct freertos_addrinfo * pxInfo,
+                               int NumCalls )
+{
+    TEST_ASSERT_TRUE( ( pxInfo == xIPv6Addresses ) || ( pxInfo == xIPv4Addresses ) );
+
+    uxFreeAddrInfoCount++;
+}
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    size_t uxIndex;
+
+    xTestTime = 1000U;
+    uxCalls = 0U;
+    uxAttemptCount = 0U;
+    uxGetAddrInfoCount = 0U;
+    uxFreeAddrInfoCount = 0U;
+
+    ( void ) memset( xAttempts, 0, sizeof( xAttempts ) );
+    ( void ) memset( xLookUps, 0, sizeof( xLookUps ) );
+    ( void ) memset( xIPv6Addresses, 0, sizeof( xIPv6Addresses ) );
+    ( void ) memset( xIPv4Addresses, 0, sizeof( xIPv4Addresses ) );
+
+    for( uxIndex = 0U; uxIndex < TEST_MAX_SOCKETS; uxIndex++ )
+    {
+        xAttempts[ uxIndex ].xConnectAfter = TEST_NEVER;
+        xAttempts[ uxIndex ].xFailAfter = TEST_NEVER;
+    }
+
+    /* Address n of a family ends in byte n + 1. */
+    for( uxIndex = 0U; uxIndex < TEST_MAX_ADDRESSES; uxIndex++ )
+    {
+        xIPv6Addresses[ uxIndex ].ai_family = FREERTOS_AF_INET6;
+        xIPv6Addresses[ uxIndex ].ai_addr = &( xIPv6Addresses[ uxIndex ].xPrivateStorage.sockaddr );
+        xIPv6Addresses[ uxIndex ].ai_addr->sin_family = FREERTOS_AF_INET6;
+        xIPv6Addresses[ uxIndex ].ai_addr->sin_address.xIP_IPv6.ucBytes[ 15 ] = ( uint8_t ) ( uxIndex + 1U );
+
+        xIPv4Addresses[ uxIndex ].ai_family = FREERTOS_AF_INET4;
+        xIPv4Addresses[ uxIndex ].ai_addr = &( xIPv4Addresses[ uxIndex ].xPrivateStorage.sockaddr );
+        xIPv4Addresses[ uxIndex ].ai_addr->sin_family = FREERTOS_AF_INET4;
+        xIPv4Addresses[ uxIndex ].ai_addr->sin_address.ulIP_IPv4 = FreeRTOS_htonl( 0xC0A80000U + uxIndex + 1U );
+    }
+
+    xTaskGetTickCount_Stub( xStubGetTickCount );
+    vTaskSetTimeOutState_Stub( vStubSetTimeOutState );
+    xTaskCheckForTimeOut_Stub( xStubCheckForTimeOut );
+
+    FreeRTOS_socket_Stub( xStubSocket );
+    xSocketValid_IgnoreAndReturn( pdTRUE );
+    FreeRTOS_setsockopt_IgnoreAndReturn( 0 );
+    FreeRTOS_connect_Stub( xStubConnect );
+    FreeRTOS_closesocket_Stub( xStubCloseSocket );
+    FreeRTOS_issocketconnected_Stub( xStubIsSocketConnected );
+    FreeRTOS_connstatus_Stub( xStubConnStatus );
+    FreeRTOS_CreateSocketSet_IgnoreAndReturn( ( SocketSet_t ) &( xTestTime ) );
+    FreeRTOS_DeleteSocketSet_Ignore();
+    FreeRTOS_FD_SET_Ignore();
+    FreeRTOS_FD_CLR_Ignore();
+    FreeRTOS_select_Stub( xStubSelect );
+
+    FreeRTOS_DNSResolveStart_Stub( xStubResolveStart );
+    FreeRTOS_DNSResolveWait_Stub( xStubResolveWait );
+    FreeRTOS_DNSResolveRelease_Stub( vStubResolveRelease );
+    FreeRTOS_getaddrinfo_Stub( xStubGetAddrInfo );
+    FreeRTOS_freeaddrinfo_Stub( vStubFreeAddrInfo );
+}
+
+/* ======================== Helper functions ======================== */
+
+/*
+ * @brief Chain the first uxCount addresses of an array into a list.
+ */
+static struct freertos_addrinfo * prvMakeList( struct freertos_addrinfo * pxAddresses,
+                                               size_t uxCount )
+{
+    size_t uxIndex;
+
+    for( uxIndex = 0U; ( uxIndex + 1U ) < uxCount; uxIndex++ )
+    {
+        pxAddresses[ uxIndex ].ai_next = &( pxAddresses[ uxIndex + 1U ] );
+    }
+
+    return pxAddresses;
+}
+
+/*
+ * @brief Check the family and the address of an attempt.
+ */
+static void prvCheckAttempt( size_t uxIndex,
+                             BaseType_t xFamily,
+                             uint8_t ucHost )
+{
+    TEST_ASSERT_EQUAL( xFamily, xAttempts[ uxIndex ].xFamily );
+    TEST_ASSERT_EQUAL( ucHost, xAttempts[ uxIndex ].ucHost );
+}
+
+/* ======================== Test cases ======================== */
+
+/*
+ * @brief An empty list does not create a socket set.
+ */
+void test_FreeRTOS_connect_addrinfo_EmptyList( void )
+{
+    Socket_t xSocket;
+
+    FreeRTOS_CreateSocketSet_StopIgnore();
+
+    xSocket = FreeRTOS_connect_addrinfo( NULL, 443U, 1000U );
+
+    TEST_ASSERT_EQUAL_PTR( FREERTOS_INVALID_SOCKET, xSocket );
+    TEST_ASSERT_EQUAL( 0, uxAttemptCount );
+}
+
+/*
+ * @brief The families alternate, starting with IPv6, and a refused attempt
+ *        starts the next one without waiting.
+ */
+void test_FreeRTOS_connect_addrinfo_AlternatesFamilies( void )
+{
+    Socket_t xSocket;
+    size_t uxIndex;
+
+    /* The IPv4 addresses come first in the list. */
+    prvMakeList( xIPv6Addresses, 2U );
+    prvMakeList( xIPv4Addresses, 2U );
+    xIPv4Addresses[ 1 ].ai_next = xIPv6Addresses;
+
+    for( uxIndex = 0U; uxIndex < TEST_MAX_SOCKETS; uxIndex++ )
+    {
+        xAttempts[ uxIndex ].xFailAfter = 5U;
+    }
+
+    xSocket = FreeRTOS_connect_addrinfo( xIPv4Addresses, 443U, 10000U );
+
+    TEST_ASSERT_EQUAL_PTR( FREERTOS_INVALID_SOCKET, xSocket );
+    TEST_ASSERT_EQUAL( 4, uxAttemptCount );
+    prvCheckAttempt( 0U, FREERTOS_AF_INET6, 1U );
+    prvCheckAttempt( 1U, FREERTOS_AF_INET4, 1U );
+    prvCheckAttempt( 2U, FREERTOS_AF_INET6, 2U );
+    prvCheckAttempt( 3U, FREERTOS_AF_INET4, 2U );
+
+    for( uxIndex = 0U; uxIndex < uxAttemptCount; uxIndex++ )
+    {
+        TEST_ASSERT_TRUE( xAttempts[ uxIndex ].xClosed );
+        TEST_ASSERT_EQUAL( 1000U + ( uxIndex * 5U ), xAttempts[ uxIndex ].xStartTime );
+    }
+}
+
+/*
+ * @brief A slow attempt is not cancelled when the next one starts, the first
+ *        one that connects wins and the others are closed.
+ */
+void test_FreeRTOS_connect_addrinfo_SecondAttemptWins( void )
+{
+    Socket_t xSocket;
+
+    prvMakeList( xIPv6Addresses, 2U );
+    xIPv6Addresses[ 1 ].ai_next = xIPv4Addresses;
+    xAttempts[ 0 ].xConnectAfter = 400U;
+    xAttempts[ 1 ].xConnectAfter = 100U;
+
+    xSocket = FreeRTOS_connect_addrinfo( xIPv6Addresses, 443U, 10000U );
+
+    TEST_ASSERT_EQUAL_PTR( &( ucSockets[ 1 ] ), xSocket );
+    TEST_ASSERT_EQUAL( 2, uxAttemptCount );
+    prvCheckAttempt( 0U, FREERTOS_AF_INET6, 1U );
+    prvCheckAttempt( 1U, FREERTOS_AF_INET4, 1U );
+    TEST_ASSERT_EQUAL( 1000U + ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS, xAttempts[ 1 ].xStartTime );
+    TEST_ASSERT_TRUE( xAttempts[ 0 ].xClosed );
+    TEST_ASSERT_FALSE( xAttempts[ 1 ].xClosed );
+    TEST_ASSERT_EQUAL( 1000U + ipconfigHAPPY_EYEBALLS_ATTEMPT_DELAY_MS + 100U, xTestTime );
+}
+
+/*
+ * @brief No attempt connects within the block time.
+ */
+void test_FreeRTOS_connect_addrinfo_TimeOut( void )
+{
+    Socket_t xSocket;
+
+    xSocket = FreeRTOS_connect_addrinfo( xIPv4Addresses, 443U, 2000U );
+
+    TEST_ASSERT_EQUAL_PTR( FREERTOS_INVALID_SOCKET, xSocket );
+    TEST_ASSERT_EQUAL( 1, uxAttemptCount );
+    TEST_ASSERT_TRUE( xAttempts[ 0 ].xClosed );
+    TEST_ASSERT_EQUAL( 3000U, xTestTime );
+}
+
+/*
+ * @brief Both look-ups are started before any attempt, and the first answer
+ *        starts the race: the IPv4 answer comes first, the IPv6 addresses
+ *        join the race when they arrive.
+ */
+void test_FreeRTOS_connect_by_name_ConnectsOnFirstAnswer( void )
+{
+    Socket_t xSocket;
+
+    xLookUps[ 0 ].xAnswerTime = 1500U;
+    xLookUps[ 0 ].pxAnswer = prvMakeList( xIPv6Addresses, 1U );
+    xLookUps[ 1 ].xAnswerTime = 1020U;
+    xLookUps[ 1 ].pxAnswer = prvMakeList( xIPv4Addresses, 1U );
+    xAttempts[ 1 ].xConnectAfter = 10U;
+
+    xSocket = FreeRTOS_connect_by_name( "www.freertos.org", 443U, 5000U );
+
+    TEST_ASSERT_EQUAL_PTR( &( ucSockets[ 1 ] ), xSocket );
+    TEST_ASSERT_EQUAL( 2, uxAttemptCount );
+    prvCheckAttempt( 0U, FREERTOS_AF_INET4, 1U );
+    prvCheckAttempt( 1U, FREERTOS_AF_INET6, 1U );
+
+    /* The IPv4 attempt did not wait for the AAAA answer. */
+    TEST_ASSERT_LESS_OR_EQUAL( 1020U + 10U, xAttempts[ 0 ].xStartTime );
+    TEST_ASSERT_GREATER_OR_EQUAL( 1500U, xAttempts[ 1 ].xStartTime );
+    TEST_ASSERT_LESS_OR_EQUAL( 1500U + 10U, xAttempts[ 1 ].xStartTime );
+
+    TEST_ASSERT_TRUE( xAttempts[ 0 ].xClosed );
+    TEST_ASSERT_TRUE( xLookUps[ 0 ].xReleased );
+    TEST_ASSERT_TRUE( xLookUps[ 1 ].xReleased );
+    TEST_ASSERT_EQUAL( 2, uxFreeAddrInfoCount );
+    TEST_ASSERT_EQUAL( 0, uxGetAddrInfoCount );
+}
+
+/*
+ * @brief A look-up that has not been answered when the race is won is
+ *        cancelled.
+ */
+void test_FreeRTOS_connect_by_name_CancelsSlowLookUp( void )
+{
+    Socket_t xSocket;
+
+    xLookUps[ 0 ].xAnswerTime = TEST_NEVER;
+    xLookUps[ 1 ].xAnswerTime = 1000U;
+    xLookUps[ 1 ].pxAnswer = prvMakeList( xIPv4Addresses, 1U );
+    xAttempts[ 0 ].xConnectAfter = 30U;
+
+    xSocket = FreeRTOS_connect_by_name( "www.freertos.org", 443U, 5000U );
+
+    TEST_ASSERT_EQUAL_PTR( &( ucSockets[ 0 ] ), xSocket );
+    TEST_ASSERT_EQUAL( 1, uxAttemptCount );
+    TEST_ASSERT_EQUAL( 1000U, xAttempts[ 0 ].xStartTime );
+    TEST_ASSERT_FALSE( xLookUps[ 0 ].xCollected );
+    TEST_ASSERT_TRUE( xLookUps[ 0 ].xReleased );
+    TEST_ASSERT_TRUE( xLookUps[ 1 ].xReleased );
+    TEST_ASSERT_EQUAL( 1, uxFreeAddrInfoCount );
+}
+
+/*
+ * @brief The look-ups that find nothing end the race without any attempt.
+ */
+void test_FreeRTOS_connect_by_name_NothingFound( void )
+{
+    Socket_t xSocket;
+
+    xLookUps[ 0 ].xAnswerTime = 1100U;
+    xLookUps[ 1 ].xAnswerTime = 1200U;
+
+    xSocket = FreeRTOS_connect_by_name( "www.freertos.org", 443U, 5000U );
+
+    TEST_ASSERT_EQUAL_PTR( FREERTOS_INVALID_SOCKET, xSocket );
+    TEST_ASSERT_EQUAL( 0, uxAttemptCount );
+    TEST_ASSERT_EQUAL( 1200U, xTestTime );
+    TEST_ASSERT_TRUE( xLookUps[ 0 ].xReleased );
+    TEST_ASSERT_TRUE( xLookUps[ 1 ].xReleased );
+    TEST_ASSERT_EQUAL( 0, uxFreeAddrInfoCount );
+}
+
+/*
+ * @brief The block time includes the look-ups.
+ */
+void test_FreeRTOS_connect_by_name_LookUpTimeOut( void )
+{
+    Socket_t xSocket;
+
+    xLookUps[ 0 ].xAnswerTime = TEST_NEVER;
+    xLookUps[ 1 ].xAnswerTime = TEST_NEVER;
+
+    xSocket = FreeRTOS_connect_by_name( "www.freertos.org", 443U, 500U );
+
+    TEST_ASSERT_EQUAL_PTR( FREERTOS_INVALID_SOCKET, xSocket );
+    TEST_ASSERT_EQUAL( 0, uxAttemptCount );
+    TEST_ASSERT_EQUAL( 1500U, xTestTime );
+    TEST_ASSERT_TRUE( xLookUps[ 0 ].xReleased );
+    TEST_ASSERT_TRUE( xLookUps[ 1 ].xReleased );
+}
+
+/*
+ * @brief A look-up that the resolver does not take, is done by
+ *        FreeRTOS_getaddrinfo().
+ */
+void test_FreeRTOS_connect_by_name_ResolverNotAvailable( void )
+{
+    Socket_t xSocket;
+
+    xLookUps[ 0 ].xStartFails = pdTRUE;
+    xLookUps[ 1 ].xStartFails = pdTRUE;
+    xLookUps[ 1 ].pxAnswer = prvMakeList( xIPv4Addresses, 1U );
+    xAttempts[ 0 ].xConnectAfter = 30U;
+
+    xSocket = FreeRTOS_connect_by_name( "www.freertos.org", 443U, 5000U );
+
+    TEST_ASSERT_EQUAL_PTR( &( ucSockets[ 0 ] ), xSocket );
+    TEST_ASSERT_EQUAL( 2, uxGetAddrInfoCount );
+    prvCheckAttempt( 0U, FREERTOS_AF_INET4, 1U );
+    TEST_ASSERT_EQUAL( 1, uxFreeAddrInfoCount );
+}
@@ -0,0 +1,844 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "FreeRTOS_IP.h"
+
+#include "mock_task.h"
+#include "mock_list.h"
+#include "mock_queue.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_IPv4.h"
+#include "mock_FreeRTOS_IPv4_Utils.h"
+#include "mock_FreeRTOS_IPv6_Utils.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_NetworkBufferManagement.h"
+
+#include "FreeRTOS_IGMP.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* IGMP message types, and the group record types of IGMPv3 and MLDv2 reports. */
+#define TEST_IGMP_QUERY              0x11U
+#define TEST_IGMPv2_REPORT           0x16U
+#define TEST_IGMPv2_LEAVE            0x17U
+#define TEST_IGMPv3_REPORT           0x22U
+#define TEST_MODE_IS_EXCLUDE         2U
+#define TEST_CHANGE_TO_INCLUDE       3U
+#define TEST_CHANGE_TO_EXCLUDE       4U
+
+/* The offset of an IGMP message that was sent, after an IP header with a
+ * Router Alert option, and of an MLD message, after a Hop-by-Hop header. */
+#define TEST_SENT_IGMP_OFFSET        ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + 4U )
+#define TEST_SENT_MLD_OFFSET         ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + 8U )
+
+/* The offset of a received IGMP message, after an IP header without options,
+ * and of a received MLD message. */
+#define TEST_RECEIVED_IGMP_OFFSET    ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER )
+#define TEST_RECEIVED_MLD_OFFSET     ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER )
+
+/* The number of timer periods after which all state-change reports were sent,
+ * when the random delays are one period. */
+#define TEST_SETTLE_PERIODS          20U
+
+/* The Older Version Querier Present Timeout, in timer periods. */
+#define TEST_OLDER_QUERIER_PERIODS   ( ( ( 2U * 125000U ) + 10000U ) / ipMULTICAST_TIMER_PERIOD_MS )
+
+/* The state of FreeRTOS_IGMP.c, which is not static in the unit-tests. */
+extern uint32_t ulOlderQuerierTimer[ 2 ];
+extern BaseType_t xMulticastTimerRunning;
+
+static NetworkInterface_t xInterface;
+static NetworkEndPoint_t xEndPointIPv4;
+static NetworkEndPoint_t xEndPointIPv6;
+static FreeRTOS_Socket_t xSockets[ 2 ];
+
+static NetworkBufferDescriptor_t xSentBuffer;
+static uint8_t ucSentBytes[ 256 ];
+static NetworkBufferDescriptor_t xReceivedBuffer;
+static uint8_t ucReceivedBytes[ 256 ];
+
+/* The value that xApplicationGetRandomNumber() returns. */
+static uint32_t ulRandomValue;
+
+/* What was sent, and how the MAC filter was changed. */
+static size_t uxSentCount;
+static uint8_t ucSentType;
+static uint8_t ucSentRecordType;
+static size_t uxAddedMACs;
+static size_t uxRemovedMACs;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static BaseType_t xApplicationGetRandomNumber_Callback( uint32_t * pulNumber,
+                                                        int NumCalls )
+{
+    ( void ) NumCalls;
+
+    *pulNumber = ulRandomValue;
+
+    return pdTRUE;
+}
+
+static NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor_Callback( size_t xRequestedSizeBytes,
+                                                                              TickType_t xBlockTimeTicks,
+                                                                              int NumCalls )
+{
+    ( void ) xBlockTimeTicks;
+    ( void ) NumCalls;
+
+    TEST_ASSERT_TRUE( xRequestedSizeBytes <= sizeof( ucSentBytes ) );
+
+    ( void ) memset( &( xSentBuffer ), 0, sizeof( xSentBuffer ) );
+    ( void ) memset( ucSentBytes, 0, sizeof( ucSentBytes ) );
+    xSentBuffer.pucEthernetBuffer = ucSentBytes;
+    xSentBuffer.xDataLength = xRequestedSizeBytes;
+
+    return &( xSentBuffer );
+}
+
+static NetworkEndPoint_t * FreeRTOS_FirstEndPoint_Callback( const NetworkInterface_t * pxInterface,
+                                                            int NumCalls )
+{
+    ( void ) pxInterface;
+    ( void ) NumCalls;
+
+    return &( xEndPointIPv4 );
+}
+
+static NetworkEndPoint_t * FreeRTOS_NextEndPoint_Callback( const NetworkInterface_t * pxInterface,
+                                                           NetworkEndPoint_t * pxEndPoint,
+                                                           int NumCalls )
+{
+    ( void ) pxInterface;
+    ( void ) NumCalls;
+
+    return ( pxEndPoint == &( xEndPointIPv4 ) ) ? &( xEndPointIPv6 ) : NULL;
+}
+
+/*
+ * @brief The output function of the interface: remember the type of the
+ *        message, and the type of the first group record.
+ */
+static BaseType_t prvOutput( struct xNetworkInterface * pxDescriptor,
+                             NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                             BaseType_t xReleaseAfterSend )
+{
+    const EthernetHeader_t * pxEthernetHeader = ( const EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer;
+    size_t uxOffset = TEST_SENT_MLD_OFFSET;
+
+    ( void ) pxDescriptor;
+
+    TEST_ASSERT_EQUAL( pdTRUE, xReleaseAfterSend );
+
+    if( pxEthernetHeader->usFrameType == ipIPv4_FRAME_TYPE )
+    {
+        uxOffset = TEST_SENT_IGMP_OFFSET;
+    }
+
+    ucSentType = pxNetworkBuffer->pucEthernetBuffer[ uxOffset ];
+    ucSentRecordType = pxNetworkBuffer->pucEthernetBuffer[ uxOffset + 8U ];
+    uxSentCount++;
+
+    return pdTRUE;
+}
+
+static void prvAddAllowedMAC( struct xNetworkInterface * pxInterface,
+                              const uint8_t * pucMacAddress )
+{
+    ( void ) pxInterface;
+    ( void ) pucMacAddress;
+
+    uxAddedMACs++;
+}
+
+static void prvRemoveAllowedMAC( struct xNetworkInterface * pxInterface,
+                                 const uint8_t * pucMacAddress )
+{
+    ( void ) pxInterface;
+    ( void ) pucMacAddress;
+
+    uxRemovedMACs++;
+}
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdFALSE );
+    xApplicationGetRandomNumber_Stub( xApplicationGetRandomNumber_Callback );
+    pxGetNetworkBufferWithDescriptor_Stub( pxGetNetworkBufferWithDescriptor_Callback );
+    FreeRTOS_FirstEndPoint_Stub( FreeRTOS_FirstEndPoint_Callback );
+    FreeRTOS_NextEndPoint_Stub( FreeRTOS_NextEndPoint_Callback );
+    xIPv6_GetIPType_IgnoreAndReturn( eIPv6_LinkLocal );
+    xIsIPv4Multicast_IgnoreAndReturn( pdTRUE );
+    vSetMultiCastIPv4MacAddress_Ignore();
+    vSetMultiCastIPv6MacAddress_Ignore();
+    usGenerateChecksum_IgnoreAndReturn( 0U );
+    usGenerateProtocolChecksum_IgnoreAndReturn( ipCORRECT_CRC );
+    vIPSetMulticastTimerEnableState_Ignore();
+    vMulticastTimerReload_Ignore();
+    xSendEventToIPTask_IgnoreAndReturn( pdPASS );
+
+    ( void ) memset( &( xInterface ), 0, sizeof( xInterface ) );
+    xInterface.pfOutput = prvOutput;
+    xInterface.pfAddAllowedMAC = prvAddAllowedMAC;
+    xInterface.pfRemoveAllowedMAC = prvRemoveAllowedMAC;
+    xInterface.bits.bInterfaceUp = pdTRUE_UNSIGNED;
+
+    ( void ) memset( &( xEndPointIPv4 ), 0, sizeof( xEndPointIPv4 ) );
+    xEndPointIPv4.pxNetworkInterface = &( xInterface );
+    xEndPointIPv4.ipv4_settings.ulIPAddress = FreeRTOS_inet_addr_quick( 192, 168, 1, 10 );
+
+    ( void ) memset( &( xEndPointIPv6 ), 0, sizeof( xEndPointIPv6 ) );
+    xEndPointIPv6.pxNetworkInterface = &( xInterface );
+    xEndPointIPv6.bits.bIPv6 = pdTRUE_UNSIGNED;
+
+    ( void ) memset( xSockets, 0, sizeof( xSockets ) );
+
+    ulRandomValue = 0U;
+    uxSentCount = 0U;
+    ucSentType = 0U;
+    ucSentRecordType = 0U;
+    uxAddedMACs = 0U;
+    uxRemovedMACs = 0U;
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    size_t uxPeriod;
+
+    /* Leave all groups, and let the leave messages be sent, so that the
+     * group table is empty for the next test. */
+    ulRandomValue = 0U;
+    ulOlderQuerierTimer[ 0 ] = 0U;
+    ulOlderQuerierTimer[ 1 ] = 0U;
+    vMulticastSocketClosed( &( xSockets[ 0 ] ) );
+    vMulticastSocketClosed( &( xSockets[ 1 ] ) );
+
+    for( uxPeriod = 0U; uxPeriod < TEST_SETTLE_PERIODS; uxPeriod++ )
+    {
+        vMulticastCheck();
+    }
+
+    xMulticastTimerRunning = pdFALSE;
+}
+
+/* ======================== Helper functions ======================== */
+
+/*
+ * @brief Get an IPv4 group address.
+ */
+static IP_Address_t prvIPv4Group( uint8_t ucLast )
+{
+    IP_Address_t xGroup;
+
+    ( void ) memset( &( xGroup ), 0, sizeof( xGroup ) );
+    xGroup.ulIP_IPv4 = FreeRTOS_inet_addr_quick( 239, 1, 2, ucLast );
+
+    return xGroup;
+}
+
+/*
+ * @brief Get the IPv6 group address ff02::1:ucLast.
+ */
+static IP_Address_t prvIPv6Group( uint8_t ucLast )
+{
+    IP_Address_t xGroup;
+
+    ( void ) memset( &( xGroup ), 0, sizeof( xGroup ) );
+    xGroup.xIP_IPv6.ucBytes[ 0 ] = 0xffU;
+    xGroup.xIP_IPv6.ucBytes[ 1 ] = 0x02U;
+    xGroup.xIP_IPv6.ucBytes[ 13 ] = 0x01U;
+    xGroup.xIP_IPv6.ucBytes[ 15 ] = ucLast;
+
+    return xGroup;
+}
+
+/*
+ * @brief Call the multicast timer function a number of times.
+ */
+static void prvRunPeriods( size_t uxPeriods )
+{
+    size_t uxPeriod;
+
+    for( uxPeriod = 0U; uxPeriod < uxPeriods; uxPeriod++ )
+    {
+        vMulticastCheck();
+    }
+}
+
+/*
+ * @brief Call the multicast timer function until a message is sent.
+ *
+ * @return The number of timer periods, or 0 when nothing was sent within
+ *         uxMaxPeriods.
+ */
+static size_t prvPeriodsUntilSent( size_t uxMaxPeriods )
+{
+    size_t uxPeriods = 0U;
+    size_t uxCount = uxSentCount;
+    size_t uxReturn = 0U;
+
+    while( uxPeriods < uxMaxPeriods )
+    {
+        vMulticastCheck();
+        uxPeriods++;
+
+        if( uxSentCount != uxCount )
+        {
+            uxReturn = uxPeriods;
+            break;
+        }
+    }
+
+    return uxReturn;
+}
+
+/*
+ * @brief Let a socket join a group, and let the IP-task send all state-change
+ *        reports.
+ */
+static void prvJoinAndSettle( FreeRTOS_Socket_t * pxSocket,
+                              const IP_Address_t * pxGroup,
+                              BaseType_t xIsIPv6 )
+{
+    TEST_ASSERT_EQUAL( 0, xMulticastJoinGroup( pxSocket, pxGroup, xIsIPv6, &( xInterface ) ) );
+    vMulticastHandleEvent();
+    prvRunPeriods( TEST_SETTLE_PERIODS );
+
+    uxSentCount = 0U;
+}
+
+/*
+ * @brief Prepare an IGMP message from another host in xReceivedBuffer.
+ */
+static void prvPrepareIGMP( uint8_t ucType,
+                            uint8_t ucCode,
+                            uint32_t ulGroup,
+                            size_t uxLength )
+{
+    IPHeader_t * pxIPHeader = ( IPHeader_t * ) &( ucReceivedBytes[ ipSIZE_OF_ETH_HEADER ] );
+    uint8_t * pucIGMP = &( ucReceivedBytes[ TEST_RECEIVED_IGMP_OFFSET ] );
+
+    ( void ) memset( ucReceivedBytes, 0, sizeof( ucReceivedBytes ) );
+    ( void ) memset( &( xReceivedBuffer ), 0, sizeof( xReceivedBuffer ) );
+    xReceivedBuffer.pucEthernetBuffer = ucReceivedBytes;
+    xReceivedBuffer.xDataLength = TEST_RECEIVED_IGMP_OFFSET + uxLength;
+    xReceivedBuffer.pxInterface = &( xInterface );
+
+    pxIPHeader->ucVersionHeaderLength = 0x45U;
+    pxIPHeader->usLength = FreeRTOS_htons( ( uint16_t ) ( ipSIZE_OF_IPv4_HEADER + uxLength ) );
+    pucIGMP[ 0 ] = ucType;
+    pucIGMP[ 1 ] = ucCode;
+    ( void ) memcpy( &( pucIGMP[ 4 ] ), &( ulGroup ), sizeof( ulGroup ) );
+}
+
+/*
+ * @brief Receive an IGMP message from another host.
+ */
+static void prvReceiveIGMP( uint8_t ucType,
+                            uint8_t ucCode,
+                            uint32_t ulGroup,
+                            size_t uxLength )
+{
+    prvPrepareIGMP( ucType, ucCode, ulGroup, uxLength );
+
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eProcessIGMPPacket( &( xReceivedBuffer ) ) );
+}
+
+/*
+ * @brief Receive an MLD message from another host.
+ */
+static void prvReceiveMLD( uint8_t ucType,
+                           uint16_t usCode,
+                           const IP_Address_t * pxGroup,
+                           size_t uxLength )
+{
+    IPHeader_IPv6_t * pxIPHeader = ( IPHeader_IPv6_t * ) &( ucReceivedBytes[ ipSIZE_OF_ETH_HEADER ] );
+    uint8_t * pucMLD = &( ucReceivedBytes[ TEST_RECEIVED_MLD_OFFSET ] );
+
+    ( void ) memset( ucReceivedBytes, 0, sizeof( ucReceivedBytes ) );
+    ( void ) memset( &( xReceivedBuffer ), 0, sizeof( xReceivedBuffer ) );
+    xReceivedBuffer.pucEthernetBuffer = ucReceivedBytes;
+    xReceivedBuffer.xDataLength = TEST_RECEIVED_MLD_OFFSET + uxLength;
+    xReceivedBuffer.pxInterface = &( xInterface );
+
+    pxIPHeader->usPayloadLength = FreeRTOS_htons( ( uint16_t ) uxLength );
+    pxIPHeader->xSourceAddress.ucBytes[ 0 ] = 0xfeU;
+    pxIPHeader->xSourceAddress.ucBytes[ 1 ] = 0x80U;
+    pxIPHeader->xSourceAddress.ucBytes[ 15 ] = 0x02U;
+    pucMLD[ 0 ] = ucType;
+    pucMLD[ 4 ] = ( uint8_t ) ( usCode >> 8 );
+    pucMLD[ 5 ] = ( uint8_t ) ( usCode & 0xffU );
+    ( void ) memcpy( &( pucMLD[ 8 ] ), pxGroup->xIP_IPv6.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+    vProcessMLDPacket( &( xReceivedBuffer ) );
+}
+
+/* ======================== Test cases ======================== */
+
+/*
+ * @brief Sockets that join the same group share an entry: the group is added
+ *        to the MAC filter and reported once.
+ */
+void test_xMulticastJoinGroup_SharedEntry( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    TEST_ASSERT_EQUAL( 0, xMulticastJoinGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    TEST_ASSERT_EQUAL( 0, xMulticastJoinGroup( &( xSockets[ 1 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EADDRINUSE, xMulticastJoinGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    TEST_ASSERT_EQUAL_HEX32( 1U, xSockets[ 0 ].u.xUDP.ulMulticastGroups );
+    TEST_ASSERT_EQUAL_HEX32( 1U, xSockets[ 1 ].u.xUDP.ulMulticastGroups );
+
+    vMulticastHandleEvent();
+
+    TEST_ASSERT_EQUAL( 1, uxAddedMACs );
+    TEST_ASSERT_EQUAL( 1, uxSentCount );
+    TEST_ASSERT_EQUAL( TEST_IGMPv3_REPORT, ucSentType );
+    TEST_ASSERT_EQUAL( TEST_CHANGE_TO_EXCLUDE, ucSentRecordType );
+
+    /* The state-change report is repeated once. */
+    TEST_ASSERT_EQUAL( 1, prvPeriodsUntilSent( TEST_SETTLE_PERIODS ) );
+    TEST_ASSERT_EQUAL( TEST_CHANGE_TO_EXCLUDE, ucSentRecordType );
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( TEST_SETTLE_PERIODS ) );
+
+    /* Handling the event again changes nothing. */
+    vMulticastHandleEvent();
+    TEST_ASSERT_EQUAL( 1, uxAddedMACs );
+    TEST_ASSERT_EQUAL( 2, uxSentCount );
+}
+
+/*
+ * @brief The group is only left when the last socket leaves it.
+ */
+void test_xMulticastLeaveGroup_LastMemberLeaves( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    TEST_ASSERT_EQUAL( 0, xMulticastJoinGroup( &( xSockets[ 1 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    TEST_ASSERT_EQUAL( 0, xMulticastLeaveGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EADDRNOTAVAIL, xMulticastLeaveGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    vMulticastHandleEvent();
+
+    TEST_ASSERT_EQUAL( 0, uxRemovedMACs );
+    TEST_ASSERT_EQUAL( 0, uxSentCount );
+
+    TEST_ASSERT_EQUAL( 0, xMulticastLeaveGroup( &( xSockets[ 1 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    vMulticastHandleEvent();
+
+    TEST_ASSERT_EQUAL( 1, uxRemovedMACs );
+    TEST_ASSERT_EQUAL( 1, uxSentCount );
+    TEST_ASSERT_EQUAL( TEST_IGMPv3_REPORT, ucSentType );
+    TEST_ASSERT_EQUAL( TEST_CHANGE_TO_INCLUDE, ucSentRecordType );
+
+    /* The leave message is repeated once, after which the entry is free. */
+    TEST_ASSERT_EQUAL( 1, prvPeriodsUntilSent( TEST_SETTLE_PERIODS ) );
+    TEST_ASSERT_EQUAL( TEST_CHANGE_TO_INCLUDE, ucSentRecordType );
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( TEST_SETTLE_PERIODS ) );
+}
+
+/*
+ * @brief A group that is left before the IP-task handled the join is never
+ *        reported, and its entry is freed at once.
+ */
+void test_xMulticastLeaveGroup_BeforeIPTask( void )
+{
+    IP_Address_t xGroup;
+    uint8_t ucIndex;
+
+    xGroup = prvIPv4Group( 1U );
+    TEST_ASSERT_EQUAL( 0, xMulticastJoinGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    TEST_ASSERT_EQUAL( 0, xMulticastLeaveGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    vMulticastHandleEvent();
+
+    TEST_ASSERT_EQUAL( 0, uxAddedMACs );
+    TEST_ASSERT_EQUAL( 0, uxSentCount );
+
+    /* All entries can be used again. */
+    for( ucIndex = 0U; ucIndex < ( uint8_t ) ipconfigMULTICAST_MAX_GROUPS; ucIndex++ )
+    {
+        xGroup = prvIPv4Group( ( uint8_t ) ( ucIndex + 10U ) );
+        TEST_ASSERT_EQUAL( 0, xMulticastJoinGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    }
+
+    xGroup = prvIPv4Group( 1U );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOBUFS, xMulticastJoinGroup( &( xSockets[ 1 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+}
+
+/*
+ * @brief When the IP-task can not be informed, the membership is dropped again.
+ */
+void test_xMulticastJoinGroup_EventNotSent( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    xSendEventToIPTask_IgnoreAndReturn( pdFAIL );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOBUFS, xMulticastJoinGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    TEST_ASSERT_EQUAL_HEX32( 0U, xSockets[ 0 ].u.xUDP.ulMulticastGroups );
+
+    xSendEventToIPTask_IgnoreAndReturn( pdPASS );
+
+    TEST_ASSERT_EQUAL( 0, xMulticastJoinGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+}
+
+/*
+ * @brief Membership of the all-systems group is never reported.
+ */
+void test_vMulticastHandleEvent_AllSystemsNotReported( void )
+{
+    IP_Address_t xGroup;
+
+    ( void ) memset( &( xGroup ), 0, sizeof( xGroup ) );
+    xGroup.ulIP_IPv4 = FreeRTOS_inet_addr_quick( 224, 0, 0, 1 );
+
+    TEST_ASSERT_EQUAL( 0, xMulticastJoinGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    vMulticastHandleEvent();
+    prvRunPeriods( TEST_SETTLE_PERIODS );
+
+    TEST_ASSERT_EQUAL( 1, uxAddedMACs );
+    TEST_ASSERT_EQUAL( 0, uxSentCount );
+
+    prvReceiveIGMP( TEST_IGMP_QUERY, 10U, 0U, 12U );
+    prvRunPeriods( TEST_SETTLE_PERIODS );
+
+    TEST_ASSERT_EQUAL( 0, uxSentCount );
+}
+
+/*
+ * @brief An IGMPv3 query with a small code gives the response time in
+ *        tenths of a second.
+ */
+void test_eProcessIGMPPacket_V3QueryLinearCode( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    /* 5 seconds is 50 periods, the random number selects the last one. */
+    ulRandomValue = 49U;
+    prvReceiveIGMP( TEST_IGMP_QUERY, 50U, 0U, 12U );
+
+    TEST_ASSERT_EQUAL( 50, prvPeriodsUntilSent( 1000U ) );
+    TEST_ASSERT_EQUAL( TEST_IGMPv3_REPORT, ucSentType );
+    TEST_ASSERT_EQUAL( TEST_MODE_IS_EXCLUDE, ucSentRecordType );
+    TEST_ASSERT_EQUAL( 0U, ulOlderQuerierTimer[ 0 ] );
+}
+
+/*
+ * @brief An IGMPv3 query code from 128 upwards has a floating point format.
+ */
+void test_eProcessIGMPPacket_V3QueryFloatingPointCode( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    /* 0xC8: exponent 4, mantissa 8, ( 0x10 | 8 ) << ( 4 + 3 ) = 3072 tenths. */
+    ulRandomValue = 3071U;
+    prvReceiveIGMP( TEST_IGMP_QUERY, 0xC8U, 0U, 12U );
+
+    TEST_ASSERT_EQUAL( 3072, prvPeriodsUntilSent( 4000U ) );
+    TEST_ASSERT_EQUAL( TEST_MODE_IS_EXCLUDE, ucSentRecordType );
+}
+
+/*
+ * @brief A group-specific query is only answered for that group.
+ */
+void test_eProcessIGMPPacket_GroupSpecificQuery( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+    IP_Address_t xOther = prvIPv4Group( 2U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    prvReceiveIGMP( TEST_IGMP_QUERY, 10U, xOther.ulIP_IPv4, 12U );
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( 100U ) );
+
+    prvReceiveIGMP( TEST_IGMP_QUERY, 10U, xGroup.ulIP_IPv4, 12U );
+    TEST_ASSERT_EQUAL( 1, prvPeriodsUntilSent( 100U ) );
+}
+
+/*
+ * @brief A second query does not postpone a report that is due earlier.
+ */
+void test_eProcessIGMPPacket_EarlierReportKept( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    ulRandomValue = 9U;
+    prvReceiveIGMP( TEST_IGMP_QUERY, 100U, 0U, 12U );
+    ulRandomValue = 99U;
+    prvReceiveIGMP( TEST_IGMP_QUERY, 100U, 0U, 12U );
+
+    TEST_ASSERT_EQUAL( 10, prvPeriodsUntilSent( 200U ) );
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( 200U ) );
+}
+
+/*
+ * @brief An IGMPv2 query starts the older querier timer, and is answered with
+ *        an IGMPv2 report within the maximum response time.
+ */
+void test_eProcessIGMPPacket_V2Query( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    ulRandomValue = 19U;
+    prvReceiveIGMP( TEST_IGMP_QUERY, 20U, 0U, 8U );
+
+    TEST_ASSERT_EQUAL( TEST_OLDER_QUERIER_PERIODS, ulOlderQuerierTimer[ 0 ] );
+    TEST_ASSERT_EQUAL( 0U, ulOlderQuerierTimer[ 1 ] );
+    TEST_ASSERT_EQUAL( 20, prvPeriodsUntilSent( 1000U ) );
+    TEST_ASSERT_EQUAL( TEST_IGMPv2_REPORT, ucSentType );
+}
+
+/*
+ * @brief An IGMPv1 query has no maximum response time, 10 seconds is used.
+ */
+void test_eProcessIGMPPacket_V1Query( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    ulRandomValue = 99U;
+    prvReceiveIGMP( TEST_IGMP_QUERY, 0U, 0U, 8U );
+
+    TEST_ASSERT_EQUAL( TEST_OLDER_QUERIER_PERIODS, ulOlderQuerierTimer[ 0 ] );
+    TEST_ASSERT_EQUAL( 100, prvPeriodsUntilSent( 1000U ) );
+    TEST_ASSERT_EQUAL( TEST_IGMPv2_REPORT, ucSentType );
+}
+
+/*
+ * @brief Queries of other lengths, and truncated packets, are ignored.
+ */
+void test_eProcessIGMPPacket_InvalidLength( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    prvReceiveIGMP( TEST_IGMP_QUERY, 10U, 0U, 10U );
+
+    TEST_ASSERT_EQUAL( 0U, ulOlderQuerierTimer[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( 100U ) );
+
+    /* A query that is longer than the frame. */
+    prvPrepareIGMP( TEST_IGMP_QUERY, 10U, 0U, 12U );
+    xReceivedBuffer.xDataLength--;
+    TEST_ASSERT_EQUAL( eReleaseBuffer, eProcessIGMPPacket( &( xReceivedBuffer ) ) );
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( 100U ) );
+}
+
+/*
+ * @brief While an older querier is present, a single IGMPv2 leave is sent.
+ *        After the Older Version Querier Present Timeout IGMPv3 is used again.
+ */
+void test_vMulticastCheck_OlderQuerierFallback( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+    IP_Address_t xOther = prvIPv4Group( 2U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+    prvJoinAndSettle( &( xSockets[ 1 ] ), &( xOther ), pdFALSE );
+
+    prvReceiveIGMP( TEST_IGMP_QUERY, 10U, 0U, 8U );
+    prvRunPeriods( TEST_SETTLE_PERIODS );
+    uxSentCount = 0U;
+
+    TEST_ASSERT_EQUAL( 0, xMulticastLeaveGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    vMulticastHandleEvent();
+
+    TEST_ASSERT_EQUAL( 1, uxSentCount );
+    TEST_ASSERT_EQUAL( TEST_IGMPv2_LEAVE, ucSentType );
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( TEST_SETTLE_PERIODS ) );
+
+    /* Let the older querier timer expire. */
+    prvRunPeriods( TEST_OLDER_QUERIER_PERIODS );
+    TEST_ASSERT_EQUAL( 0U, ulOlderQuerierTimer[ 0 ] );
+
+    TEST_ASSERT_EQUAL( 0, xMulticastLeaveGroup( &( xSockets[ 1 ] ), &( xOther ), pdFALSE, &( xInterface ) ) );
+    vMulticastHandleEvent();
+
+    TEST_ASSERT_EQUAL( 2, uxSentCount );
+    TEST_ASSERT_EQUAL( TEST_IGMPv3_REPORT, ucSentType );
+    TEST_ASSERT_EQUAL( TEST_CHANGE_TO_INCLUDE, ucSentRecordType );
+}
+
+/*
+ * @brief In IGMPv2 mode, a report of another host suppresses our own report.
+ */
+void test_eProcessIGMPPacket_ReportSuppressed( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    ulRandomValue = 49U;
+    prvReceiveIGMP( TEST_IGMP_QUERY, 100U, 0U, 8U );
+    prvRunPeriods( 10U );
+    prvReceiveIGMP( TEST_IGMPv2_REPORT, 0U, xGroup.ulIP_IPv4, 8U );
+
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( 200U ) );
+}
+
+/*
+ * @brief In IGMPv3 mode, reports of other hosts are not used for suppression.
+ */
+void test_eProcessIGMPPacket_ReportNotSuppressedInV3Mode( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE );
+
+    ulRandomValue = 49U;
+    prvReceiveIGMP( TEST_IGMP_QUERY, 100U, 0U, 12U );
+    prvRunPeriods( 10U );
+    prvReceiveIGMP( TEST_IGMPv2_REPORT, 0U, xGroup.ulIP_IPv4, 8U );
+
+    TEST_ASSERT_EQUAL( 40, prvPeriodsUntilSent( 200U ) );
+}
+
+/*
+ * @brief A pending state-change report is not suppressed by another host.
+ */
+void test_eProcessIGMPPacket_StateChangeNotSuppressed( void )
+{
+    IP_Address_t xGroup = prvIPv4Group( 1U );
+
+    prvReceiveIGMP( TEST_IGMP_QUERY, 10U, 0U, 8U );
+
+    TEST_ASSERT_EQUAL( 0, xMulticastJoinGroup( &( xSockets[ 0 ] ), &( xGroup ), pdFALSE, &( xInterface ) ) );
+    vMulticastHandleEvent();
+    TEST_ASSERT_EQUAL( 1, uxSentCount );
+
+    prvReceiveIGMP( TEST_IGMPv2_REPORT, 0U, xGroup.ulIP_IPv4, 8U );
+
+    TEST_ASSERT_EQUAL( 1, prvPeriodsUntilSent( TEST_SETTLE_PERIODS ) );
+    TEST_ASSERT_EQUAL( TEST_IGMPv2_REPORT, ucSentType );
+}
+
+/*
+ * @brief An MLDv2 query gives the maximum response time in milliseconds, with a
+ *        floating point format from 32768 upwards.
+ */
+void test_vProcessMLDPacket_V2QueryCodes( void )
+{
+    IP_Address_t xGroup = prvIPv6Group( 3U );
+    IP_Address_t xGeneral;
+
+    ( void ) memset( &( xGeneral ), 0, sizeof( xGeneral ) );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdTRUE );
+
+    /* 2000 ms is 20 periods. */
+    ulRandomValue = 19U;
+    prvReceiveMLD( ipICMP_MLD_QUERY_IPv6, 2000U, &( xGeneral ), 28U );
+
+    TEST_ASSERT_EQUAL( 20, prvPeriodsUntilSent( 1000U ) );
+    TEST_ASSERT_EQUAL( ipICMP_MLDv2_REPORT_IPv6, ucSentType );
+    TEST_ASSERT_EQUAL( TEST_MODE_IS_EXCLUDE, ucSentRecordType );
+
+    /* 0x9001: exponent 1, mantissa 1, ( 0x1000 | 1 ) << ( 1 + 3 ) = 65552 ms,
+     * which is rounded up to 656 periods. */
+    ulRandomValue = 655U;
+    prvReceiveMLD( ipICMP_MLD_QUERY_IPv6, 0x9001U, &( xGroup ), 28U );
+
+    TEST_ASSERT_EQUAL( 656, prvPeriodsUntilSent( 1000U ) );
+    TEST_ASSERT_EQUAL( 0U, ulOlderQuerierTimer[ 1 ] );
+}
+
+/*
+ * @brief An MLDv1 query starts the older querier timer of IPv6 only, and is
+ *        answered with an MLDv1 report.  Another report suppresses it.
+ */
+void test_vProcessMLDPacket_V1QueryAndSuppression( void )
+{
+    IP_Address_t xGroup = prvIPv6Group( 3U );
+    IP_Address_t xGeneral;
+
+    ( void ) memset( &( xGeneral ), 0, sizeof( xGeneral ) );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdTRUE );
+
+    ulRandomValue = 9U;
+    prvReceiveMLD( ipICMP_MLD_QUERY_IPv6, 1000U, &( xGeneral ), 24U );
+
+    TEST_ASSERT_EQUAL( TEST_OLDER_QUERIER_PERIODS, ulOlderQuerierTimer[ 1 ] );
+    TEST_ASSERT_EQUAL( 0U, ulOlderQuerierTimer[ 0 ] );
+    TEST_ASSERT_EQUAL( 10, prvPeriodsUntilSent( 1000U ) );
+    TEST_ASSERT_EQUAL( ipICMP_MLD_REPORT_IPv6, ucSentType );
+
+    prvReceiveMLD( ipICMP_MLD_QUERY_IPv6, 1000U, &( xGeneral ), 24U );
+    prvRunPeriods( 5U );
+    prvReceiveMLD( ipICMP_MLD_REPORT_IPv6, 0U, &( xGroup ), 24U );
+
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( 100U ) );
+}
+
+/*
+ * @brief MLD messages from an address that is not link-local are ignored.
+ */
+void test_vProcessMLDPacket_NotLinkLocal( void )
+{
+    IP_Address_t xGroup = prvIPv6Group( 3U );
+    IP_Address_t xGeneral;
+
+    ( void ) memset( &( xGeneral ), 0, sizeof( xGeneral ) );
+
+    prvJoinAndSettle( &( xSockets[ 0 ] ), &( xGroup ), pdTRUE );
+
+    xIPv6_GetIPType_IgnoreAndReturn( eIPv6_Global );
+    prvReceiveMLD( ipICMP_MLD_QUERY_IPv6, 1000U, &( xGeneral ), 24U );
+
+    TEST_ASSERT_EQUAL( 0U, ulOlderQuerierTimer[ 1 ] );
+    TEST_ASSERT_EQUAL( 0, prvPeriodsUntilSent( 100U ) );
+}
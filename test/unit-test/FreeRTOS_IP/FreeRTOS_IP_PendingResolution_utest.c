@@ -0,0 +1,425 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_IP_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IPv4_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IPv6_Utils.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_TCP_IP.h"
+#include "mock_FreeRTOS_ICMP.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_DHCP.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_FreeRTOS_DNS.h"
+#include "mock_FreeRTOS_DNS_Cache.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+#include "mock_FreeRTOS_ND.h"
+#include "mock_FreeRTOS_IPv6.h"
+#include "mock_FreeRTOS_IPv4.h"
+
+#include "FreeRTOS_IP.h"
+
+#include "FreeRTOS_IP_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+extern BaseType_t xIPTaskInitialised;
+
+/* ============================ Test Constants ============================ */
+
+/* The same value as ipARP_RESOLUTION_MAX_DELAY and ipND_RESOLUTION_MAX_DELAY
+ * in FreeRTOS_IP.c. */
+#define testRESOLUTION_MAX_DELAY    ( pdMS_TO_TICKS( 2000U ) )
+
+/* The time at which the tests store their packets. */
+#define testSTART_TIME              ( ( TickType_t ) 1000U )
+
+/* ============================ Test Variables ============================ */
+
+/* The events passed to xQueueGenericSend(). */
+static IPStackEvent_t xSentEvents[ 8 ];
+static BaseType_t xSentEventCount;
+
+/* The value returned by xQueueGenericSend(). */
+static BaseType_t xQueueSendResult;
+
+/* Ethernet frames that carry an IPv4 and an IPv6 packet. */
+static uint8_t ucEthernetBuffers[ 4 ][ ipconfigTCP_MSS ];
+static NetworkBufferDescriptor_t xNetworkBuffers[ 4 ];
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    BaseType_t x;
+
+    xIPTaskInitialised = pdTRUE;
+    xSentEventCount = 0;
+    xQueueSendResult = pdPASS;
+
+    memset( xSentEvents, 0, sizeof( xSentEvents ) );
+    memset( ucEthernetBuffers, 0, sizeof( ucEthernetBuffers ) );
+    memset( xNetworkBuffers, 0, sizeof( xNetworkBuffers ) );
+
+    for( x = 0; x < 4; x++ )
+    {
+        xNetworkBuffers[ x ].pucEthernetBuffer = ucEthernetBuffers[ x ];
+    }
+
+    xIsCallingFromIPTask_IgnoreAndReturn( pdTRUE );
+    xTaskGetTickCount_IgnoreAndReturn( testSTART_TIME );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+}
+
+/* ======================== Stub Callback Functions ========================= */
+
+static BaseType_t xQueueGenericSend_Record( QueueHandle_t xQueue,
+                                            const void * const pvItemToQueue,
+                                            TickType_t xTicksToWait,
+                                            const BaseType_t xCopyPosition,
+                                            int lCallCount )
+{
+    ( void ) xQueue;
+    ( void ) xCopyPosition;
+    ( void ) lCallCount;
+
+    /* A flush runs in the IP-task, it may not block. */
+    TEST_ASSERT_EQUAL( 0, xTicksToWait );
+
+    if( xQueueSendResult == pdPASS )
+    {
+        TEST_ASSERT_LESS_THAN( 8, xSentEventCount );
+        memcpy( &( xSentEvents[ xSentEventCount ] ), pvItemToQueue, sizeof( IPStackEvent_t ) );
+        xSentEventCount++;
+    }
+
+    return xQueueSendResult;
+}
+
+/* ============================ Helper Functions ============================ */
+
+/*
+ * Let a network buffer carry an IPv4 packet with the given source address.
+ */
+static void prvSetSourceIPv4( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                              uint32_t ulSource )
+{
+    IPPacket_t * pxIPPacket = ( IPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer;
+
+    pxIPPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+    pxIPPacket->xIPHeader.ulSourceIPAddress = ulSource;
+}
+
+/*
+ * Let a network buffer carry an IPv6 packet with the given source address.
+ */
+static void prvSetSourceIPv6( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                              const IPv6_Address_t * pxSource )
+{
+    IPPacket_IPv6_t * pxIPPacket = ( IPPacket_IPv6_t * ) pxNetworkBuffer->pucEthernetBuffer;
+
+    pxIPPacket->xEthernetHeader.usFrameType = ipIPv6_FRAME_TYPE;
+    memcpy( pxIPPacket->xIPHeader.xSourceAddress.ucBytes, pxSource->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+}
+
+/*
+ * Return an IPv4 address in the format of IP_Address_t.
+ */
+static IP_Address_t prvAddressIPv4( uint32_t ulAddress )
+{
+    IP_Address_t xAddress;
+
+    memset( &( xAddress ), 0, sizeof( xAddress ) );
+    xAddress.ulIP_IPv4 = ulAddress;
+
+    return xAddress;
+}
+
+/* First IPv6 address is 2001:1234:5678::5 */
+static const IPv6_Address_t xIPAddressFive = { 0x20, 0x01, 0x12, 0x34, 0x56, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05 };
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief A received IPv4 packet waits for the resolution of its source address,
+ *        and is passed to the IP-task again when the ARP reply comes in.
+ */
+void test_xPendingResolutionAdd_IPv4_Flush( void )
+{
+    IP_Address_t xAddress = prvAddressIPv4( 0x0A000001U );
+    BaseType_t xReturn;
+
+    prvSetSourceIPv4( &( xNetworkBuffers[ 0 ] ), xAddress.ulIP_IPv4 );
+
+    /* The first packet starts the ARP resolution timer. */
+    vIPTimerStartARPResolution_Expect( testRESOLUTION_MAX_DELAY );
+
+    xReturn = xPendingResolutionAdd( &( xNetworkBuffers[ 0 ] ), pdFALSE );
+    TEST_ASSERT_EQUAL( pdPASS, xReturn );
+
+    /* The reply came in, no packets are waiting any more. */
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+    vIPSetARPResolutionTimerEnableState_Expect( pdFALSE );
+
+    xReturn = xPendingResolutionFlush( &( xAddress ), pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+    TEST_ASSERT_EQUAL( 1, xSentEventCount );
+    TEST_ASSERT_EQUAL( eNetworkRxEvent, xSentEvents[ 0 ].eEventType );
+    TEST_ASSERT_EQUAL_PTR( &( xNetworkBuffers[ 0 ] ), xSentEvents[ 0 ].pvData );
+
+    /* A second reply finds nothing. */
+    xReturn = xPendingResolutionFlush( &( xAddress ), pdFALSE );
+    TEST_ASSERT_EQUAL( pdFALSE, xReturn );
+}
+
+/**
+ * @brief A generated IPv6 packet waits for the resolution of its next hop, and
+ *        is sent again as an eStackTxEvent. Packets are flushed in the order in
+ *        which they were stored.
+ */
+void test_xPendingResolutionAddOutgoing_IPv6_FlushInOrder( void )
+{
+    IP_Address_t xAddress;
+    BaseType_t xReturn;
+
+    memset( &( xAddress ), 0, sizeof( xAddress ) );
+    memcpy( xAddress.xIP_IPv6.ucBytes, xIPAddressFive.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+    /* Only the first packet starts the ND resolution timer. */
+    vIPTimerStartNDResolution_Expect( testRESOLUTION_MAX_DELAY );
+
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 0 ] ), &( xAddress ), pdTRUE ) );
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 1 ] ), &( xAddress ), pdTRUE ) );
+
+    /* An IPv4 address with the same first bytes is a different address. */
+    TEST_ASSERT_EQUAL( pdFALSE, xPendingResolutionFlush( &( xAddress ), pdFALSE ) );
+
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+    vIPSetNDResolutionTimerEnableState_Expect( pdFALSE );
+
+    xReturn = xPendingResolutionFlush( &( xAddress ), pdTRUE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+    TEST_ASSERT_EQUAL( 2, xSentEventCount );
+    TEST_ASSERT_EQUAL( eStackTxEvent, xSentEvents[ 0 ].eEventType );
+    TEST_ASSERT_EQUAL_PTR( &( xNetworkBuffers[ 0 ] ), xSentEvents[ 0 ].pvData );
+    TEST_ASSERT_EQUAL( eStackTxEvent, xSentEvents[ 1 ].eEventType );
+    TEST_ASSERT_EQUAL_PTR( &( xNetworkBuffers[ 1 ] ), xSentEvents[ 1 ].pvData );
+}
+
+/**
+ * @brief A received IPv6 packet is stored under its source address.
+ */
+void test_xPendingResolutionAdd_IPv6_KeyedOnSource( void )
+{
+    IP_Address_t xAddress;
+
+    memset( &( xAddress ), 0, sizeof( xAddress ) );
+    memcpy( xAddress.xIP_IPv6.ucBytes, xIPAddressFive.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+    prvSetSourceIPv6( &( xNetworkBuffers[ 0 ] ), &( xIPAddressFive ) );
+
+    vIPTimerStartNDResolution_Expect( testRESOLUTION_MAX_DELAY );
+
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAdd( &( xNetworkBuffers[ 0 ] ), pdTRUE ) );
+
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+    vIPSetNDResolutionTimerEnableState_Expect( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xPendingResolutionFlush( &( xAddress ), pdTRUE ) );
+    TEST_ASSERT_EQUAL( 1, xSentEventCount );
+    TEST_ASSERT_EQUAL( eNetworkRxEvent, xSentEvents[ 0 ].eEventType );
+}
+
+/**
+ * @brief An address holds no more than ipconfigPENDING_RESOLUTION_PACKETS packets,
+ *        and no more than ipconfigPENDING_RESOLUTION_ADDRESSES addresses are
+ *        resolved at the same time.
+ */
+void test_xPendingResolutionAddOutgoing_Full( void )
+{
+    IP_Address_t xFirst = prvAddressIPv4( 0x0A000001U );
+    IP_Address_t xSecond = prvAddressIPv4( 0x0A000002U );
+    IP_Address_t xThird = prvAddressIPv4( 0x0A000003U );
+
+    vIPTimerStartARPResolution_Expect( testRESOLUTION_MAX_DELAY );
+    vIPTimerStartARPResolution_Expect( testRESOLUTION_MAX_DELAY );
+
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 0 ] ), &( xFirst ), pdFALSE ) );
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 1 ] ), &( xFirst ), pdFALSE ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 2 ] ), &( xFirst ), pdFALSE ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 2 ] ), &( xSecond ), pdFALSE ) );
+    TEST_ASSERT_EQUAL( pdFAIL, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 3 ] ), &( xThird ), pdFALSE ) );
+
+    /* Empty the table again. */
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+    vIPTimerStartARPResolution_Expect( testRESOLUTION_MAX_DELAY );
+    vIPSetARPResolutionTimerEnableState_Expect( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xPendingResolutionFlush( &( xFirst ), pdFALSE ) );
+    TEST_ASSERT_EQUAL( pdTRUE, xPendingResolutionFlush( &( xSecond ), pdFALSE ) );
+    TEST_ASSERT_EQUAL( 3, xSentEventCount );
+}
+
+/**
+ * @brief When the event queue is full, a flushed packet is released.
+ */
+void test_xPendingResolutionFlush_QueueFull( void )
+{
+    IP_Address_t xAddress = prvAddressIPv4( 0x0A000001U );
+
+    vIPTimerStartARPResolution_Expect( testRESOLUTION_MAX_DELAY );
+
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 0 ] ), &( xAddress ), pdFALSE ) );
+
+    xQueueSendResult = pdFAIL;
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+    vReleaseNetworkBufferAndDescriptor_Expect( &( xNetworkBuffers[ 0 ] ) );
+    vIPSetARPResolutionTimerEnableState_Expect( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xPendingResolutionFlush( &( xAddress ), pdFALSE ) );
+    TEST_ASSERT_EQUAL( 0, xSentEventCount );
+}
+
+/**
+ * @brief The resolution timer releases the packets of an address once it has
+ *        waited long enough, and restarts for the younger addresses.
+ */
+void test_vPendingResolutionTimeout( void )
+{
+    IP_Address_t xOld = prvAddressIPv4( 0x0A000001U );
+    IP_Address_t xYoung = prvAddressIPv4( 0x0A000002U );
+
+    vIPTimerStartARPResolution_Expect( testRESOLUTION_MAX_DELAY );
+
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 0 ] ), &( xOld ), pdFALSE ) );
+
+    /* Store another packet 500 ticks later. The timer still expires for the
+     * oldest address. */
+    xTaskGetTickCount_IgnoreAndReturn( testSTART_TIME + 500U );
+    vIPTimerStartARPResolution_Expect( testRESOLUTION_MAX_DELAY - 500U );
+
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 1 ] ), &( xYoung ), pdFALSE ) );
+
+    /* Too early: nothing is released, the timer is restarted. */
+    xTaskGetTickCount_IgnoreAndReturn( testSTART_TIME + 600U );
+    vIPTimerStartARPResolution_Expect( testRESOLUTION_MAX_DELAY - 600U );
+
+    vPendingResolutionTimeout( pdFALSE );
+
+    /* The first address expires, the second one waits another 500 ticks. */
+    xTaskGetTickCount_IgnoreAndReturn( testSTART_TIME + testRESOLUTION_MAX_DELAY );
+    vReleaseNetworkBufferAndDescriptor_Expect( &( xNetworkBuffers[ 0 ] ) );
+    vIPTimerStartARPResolution_Expect( 500U );
+
+    vPendingResolutionTimeout( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xPendingResolutionFlush( &( xOld ), pdFALSE ) );
+
+    /* The second address expires as well. */
+    xTaskGetTickCount_IgnoreAndReturn( testSTART_TIME + 500U + testRESOLUTION_MAX_DELAY );
+    vReleaseNetworkBufferAndDescriptor_Expect( &( xNetworkBuffers[ 1 ] ) );
+    vIPSetARPResolutionTimerEnableState_Expect( pdFALSE );
+
+    vPendingResolutionTimeout( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xPendingResolutionFlush( &( xYoung ), pdFALSE ) );
+}
+
+/**
+ * @brief The ARP timer leaves the packets that wait for an ND resolution alone.
+ */
+void test_vPendingResolutionTimeout_OtherFamily( void )
+{
+    IP_Address_t xAddressIPv4 = prvAddressIPv4( 0x0A000001U );
+    IP_Address_t xAddressIPv6;
+
+    memset( &( xAddressIPv6 ), 0, sizeof( xAddressIPv6 ) );
+    memcpy( xAddressIPv6.xIP_IPv6.ucBytes, xIPAddressFive.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+    vIPTimerStartARPResolution_Expect( testRESOLUTION_MAX_DELAY );
+    vIPTimerStartNDResolution_Expect( testRESOLUTION_MAX_DELAY );
+
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 0 ] ), &( xAddressIPv4 ), pdFALSE ) );
+    TEST_ASSERT_EQUAL( pdPASS, xPendingResolutionAddOutgoing( &( xNetworkBuffers[ 1 ] ), &( xAddressIPv6 ), pdTRUE ) );
+
+    xTaskGetTickCount_IgnoreAndReturn( testSTART_TIME + testRESOLUTION_MAX_DELAY );
+    vReleaseNetworkBufferAndDescriptor_Expect( &( xNetworkBuffers[ 0 ] ) );
+    vIPSetARPResolutionTimerEnableState_Expect( pdFALSE );
+
+    vPendingResolutionTimeout( pdFALSE );
+
+    /* The IPv6 packet is still there. */
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+    vIPSetNDResolutionTimerEnableState_Expect( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xPendingResolutionFlush( &( xAddressIPv6 ), pdTRUE ) );
+    TEST_ASSERT_EQUAL( 1, xSentEventCount );
+    TEST_ASSERT_EQUAL_PTR( &( xNetworkBuffers[ 1 ] ), xSentEvents[ 0 ].pvData );
+}
+
+/**
+ * @brief A timer event without waiting packets stops the timer.
+ */
+void test_vPendingResolutionTimeout_Empty( void )
+{
+    vIPSetNDResolutionTimerEnableState_Expect( pdFALSE );
+
+    vPendingResolutionTimeout( pdTRUE );
+}
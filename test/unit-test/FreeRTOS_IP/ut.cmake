@@ -126,3 +126,39 @@ create_test(${utest_name}
             "${utest_dep_list}"
             "${test_include_directories}"
         )
+
+# The packets that wait for an ARP or ND resolution are tested with a second
+# build of FreeRTOS_IP.c in which ipconfigPENDING_RESOLUTION_ADDRESSES is enabled.
+set(real_name_pending "${project_name}_PendingResolution_real")
+
+create_real_library(${real_name_pending}
+                    "${real_source_files}"
+                    "${real_include_directories}"
+                    "${mock_name}"
+        )
+
+target_compile_definitions(${real_name_pending} PUBLIC
+            ipconfigPENDING_RESOLUTION_ADDRESSES=2
+            ipconfigPENDING_RESOLUTION_PACKETS=2
+        )
+
+set( utest_link_list "" )
+list(APPEND utest_link_list
+            -l${mock_name}
+            lib${real_name_pending}.a
+        )
+
+set( utest_dep_list "" )
+list(APPEND utest_dep_list
+            ${real_name_pending}
+        )
+
+set(utest_name "${project_name}_PendingResolution_utest")
+set(utest_source "${project_name}/${project_name}_PendingResolution_utest.c" )
+
+create_test(${utest_name}
+            ${utest_source}
+            "${utest_link_list}"
+            "${utest_dep_list}"
+            "${test_include_directories}"
+        )
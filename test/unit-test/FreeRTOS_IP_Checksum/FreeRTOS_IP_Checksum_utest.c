@@ -0,0 +1,303 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "mock_task.h"
+#include "mock_list.h"
+#include "mock_FreeRTOS_IP.h"
+
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_IP_Private.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+/* The largest block that will be checksummed, an IP packet of 64 KB. */
+#define CHECKSUM_MAX_LENGTH    65535U
+
+/* The number of bytes by which the data will be misaligned. */
+#define CHECKSUM_MAX_OFFSET    16U
+
+/* The number of random lengths, alignments and initial sums that are tried. */
+#define CHECKSUM_RANDOM_RUNS    2000U
+
+/* The signature shared by all checksum kernels. */
+typedef uint16_t ( * ChecksumKernel_t )( uint16_t usSum,
+                                         const uint8_t * pucNextData,
+                                         size_t uxByteCount );
+
+static uint8_t ucData[ CHECKSUM_MAX_LENGTH + CHECKSUM_MAX_OFFSET ];
+
+static uint8_t ucCopy[ CHECKSUM_MAX_LENGTH + CHECKSUM_MAX_OFFSET ];
+
+/* ============================  Helper Functions  ============================ */
+
+/**
+ * @brief The RFC 1071 checksum, calculated one byte at a time, in the same
+ *        format as usGenerateChecksum().
+ */
+static uint16_t prvReferenceChecksum( uint16_t usSum,
+                                      const uint8_t * pucData,
+                                      size_t uxLength )
+{
+    uint32_t ulSum = usSum;
+    size_t uxIndex;
+
+    for( uxIndex = 0U; ( uxIndex + 1U ) < uxLength; uxIndex += 2U )
+    {
+        ulSum += ( ( uint32_t ) pucData[ uxIndex ] << 8 ) | pucData[ uxIndex + 1U ];
+    }
+
+    if( ( uxLength & 1U ) != 0U )
+    {
+        ulSum += ( uint32_t ) pucData[ uxLength - 1U ] << 8;
+    }
+
+    while( ( ulSum >> 16 ) != 0U )
+    {
+        ulSum = ( ulSum & 0xFFFFU ) + ( ulSum >> 16 );
+    }
+
+    return ( uint16_t ) ulSum;
+}
+
+/**
+ * @brief Compare a kernel with the reference for every length up to 256 bytes
+ *        at every offset, and for random lengths, offsets and initial sums.
+ */
+static void prvCheckKernel( ChecksumKernel_t xKernel )
+{
+    size_t uxIndex;
+    size_t uxLength;
+    size_t uxOffset;
+    size_t uxRun;
+    uint16_t usSum;
+
+    srand( 1 );
+
+    for( uxIndex = 0U; uxIndex < sizeof( ucData ); uxIndex++ )
+    {
+        ucData[ uxIndex ] = ( uint8_t ) rand();
+    }
+
+    for( uxLength = 0U; uxLength <= 256U; uxLength++ )
+    {
+        for( uxOffset = 0U; uxOffset < CHECKSUM_MAX_OFFSET; uxOffset++ )
+        {
+            usSum = ( uint16_t ) rand();
+            TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( usSum, &( ucData[ uxOffset ] ), uxLength ),
+                                     xKernel( usSum, &( ucData[ uxOffset ] ), uxLength ) );
+        }
+    }
+
+    for( uxRun = 0U; uxRun < CHECKSUM_RANDOM_RUNS; uxRun++ )
+    {
+        uxLength = ( size_t ) rand() % ( CHECKSUM_MAX_LENGTH + 1U );
+        uxOffset = ( size_t ) rand() % CHECKSUM_MAX_OFFSET;
+        usSum = ( uint16_t ) rand();
+        TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( usSum, &( ucData[ uxOffset ] ), uxLength ),
+                                 xKernel( usSum, &( ucData[ uxOffset ] ), uxLength ) );
+    }
+
+    /* Data with the most carries, and data that sums to zero. */
+    ( void ) memset( ucData, 0xFF, sizeof( ucData ) );
+    TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( 0xFFFFU, &( ucData[ 1 ] ), CHECKSUM_MAX_LENGTH ),
+                             xKernel( 0xFFFFU, &( ucData[ 1 ] ), CHECKSUM_MAX_LENGTH ) );
+
+    ( void ) memset( ucData, 0x00, sizeof( ucData ) );
+    TEST_ASSERT_EQUAL_HEX16( 0U, xKernel( 0U, ucData, CHECKSUM_MAX_LENGTH ) );
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief The 64-bit kernel must give the same results as the reference.
+ */
+void test_usGenerateChecksum64_MatchesReference( void )
+{
+    prvCheckKernel( usGenerateChecksum64 );
+}
+
+/**
+ * @brief usGenerateChecksum() must use the selected kernel.
+ */
+void test_usGenerateChecksum_MatchesReference( void )
+{
+    prvCheckKernel( usGenerateChecksum );
+}
+
+#if defined( __SSE2__ )
+
+/**
+ * @brief The SSE2 kernel must give the same results as the reference.
+ */
+    void test_usGenerateChecksumSSE2_MatchesReference( void )
+    {
+        prvCheckKernel( usGenerateChecksumSSE2 );
+    }
+#endif
+
+#if defined( __AVX2__ )
+
+/**
+ * @brief The AVX2 kernel must give the same results as the reference.
+ */
+    void test_usGenerateChecksumAVX2_MatchesReference( void )
+    {
+        prvCheckKernel( usGenerateChecksumAVX2 );
+    }
+#endif
+
+#if defined( __ARM_NEON )
+
+/**
+ * @brief The NEON kernel must give the same results as the reference.
+ */
+    void test_usGenerateChecksumNEON_MatchesReference( void )
+    {
+        prvCheckKernel( usGenerateChecksumNEON );
+    }
+#endif
+
+/**
+ * @brief usGenerateChecksumCopy() must copy the data, and give the same
+ *        results as the reference for any alignment of both buffers.
+ */
+void test_usGenerateChecksumCopy_MatchesReference( void )
+{
+    size_t uxIndex;
+    size_t uxLength;
+    size_t uxOffset;
+    size_t uxRun;
+    size_t uxCopyOffset;
+    uint16_t usSum;
+
+    srand( 2 );
+
+    for( uxIndex = 0U; uxIndex < sizeof( ucData ); uxIndex++ )
+    {
+        ucData[ uxIndex ] = ( uint8_t ) rand();
+    }
+
+    for( uxLength = 0U; uxLength <= 256U; uxLength++ )
+    {
+        for( uxOffset = 0U; uxOffset < CHECKSUM_MAX_OFFSET; uxOffset++ )
+        {
+            uxCopyOffset = ( size_t ) rand() % CHECKSUM_MAX_OFFSET;
+            usSum = ( uint16_t ) rand();
+            TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( usSum, &( ucData[ uxOffset ] ), uxLength ),
+                                     usGenerateChecksumCopy( usSum, &( ucCopy[ uxCopyOffset ] ), &( ucData[ uxOffset ] ), uxLength ) );
+            TEST_ASSERT_EQUAL_MEMORY( &( ucData[ uxOffset ] ), &( ucCopy[ uxCopyOffset ] ), uxLength );
+        }
+    }
+
+    for( uxRun = 0U; uxRun < CHECKSUM_RANDOM_RUNS; uxRun++ )
+    {
+        uxLength = ( size_t ) rand() % ( CHECKSUM_MAX_LENGTH + 1U );
+        uxOffset = ( size_t ) rand() % CHECKSUM_MAX_OFFSET;
+        uxCopyOffset = ( size_t ) rand() % CHECKSUM_MAX_OFFSET;
+        usSum = ( uint16_t ) rand();
+        TEST_ASSERT_EQUAL_HEX16( prvReferenceChecksum( usSum, &( ucData[ uxOffset ] ), uxLength ),
+                                 usGenerateChecksumCopy( usSum, &( ucCopy[ uxCopyOffset ] ), &( ucData[ uxOffset ] ), uxLength ) );
+        TEST_ASSERT_EQUAL_MEMORY( &( ucData[ uxOffset ] ), &( ucCopy[ uxCopyOffset ] ), uxLength );
+    }
+}
+
+/**
+ * @brief usAdjustChecksum() must give the result of the example in RFC 1624.
+ */
+void test_usAdjustChecksum_RFC1624Example( void )
+{
+    TEST_ASSERT_EQUAL_HEX16( 0x0000U, usAdjustChecksum( FreeRTOS_htons( 0xDD2FU ), 0x5555U, 0x3285U ) );
+}
+
+/**
+ * @brief After a change of some fields, usAdjustChecksum() must give the same
+ *        checksum as a full calculation.
+ */
+void test_usAdjustChecksum_MatchesFullChecksum( void )
+{
+    size_t uxIndex;
+    size_t uxLength;
+    size_t uxOffset;
+    size_t uxFieldLength;
+    size_t uxRun;
+    uint16_t usChecksum;
+    uint16_t usOldSum;
+
+    srand( 3 );
+
+    for( uxRun = 0U; uxRun < CHECKSUM_RANDOM_RUNS; uxRun++ )
+    {
+        /* An even number of bytes, with the checksum in the first two. */
+        uxLength = 4U + ( 2U * ( ( size_t ) rand() % 700U ) );
+
+        for( uxIndex = 2U; uxIndex < uxLength; uxIndex++ )
+        {
+            ucData[ uxIndex ] = ( ( uxRun % 5U ) == 0U ) ? 0U : ( uint8_t ) rand();
+        }
+
+        usChecksum = 0U;
+        ( void ) memcpy( ucData, &( usChecksum ), sizeof( usChecksum ) );
+        usChecksum = FreeRTOS_htons( ( uint16_t ) ~usGenerateChecksum( 0U, ucData, uxLength ) );
+
+        /* Change a field of 2 to 8 bytes, at an even offset. */
+        uxOffset = 2U + ( 2U * ( ( size_t ) rand() % ( ( uxLength - 2U ) / 2U ) ) );
+        uxFieldLength = 2U * ( 1U + ( ( size_t ) rand() % 4U ) );
+
+        if( ( uxOffset + uxFieldLength ) > uxLength )
+        {
+            uxFieldLength = uxLength - uxOffset;
+        }
+
+        usOldSum = usGenerateChecksum( 0U, &( ucData[ uxOffset ] ), uxFieldLength );
+
+        for( uxIndex = 0U; uxIndex < uxFieldLength; uxIndex++ )
+        {
+            ucData[ uxOffset + uxIndex ] = ( ( uxRun % 3U ) == 0U ) ? 0U : ( uint8_t ) rand();
+        }
+
+        usChecksum = usAdjustChecksum( usChecksum, usOldSum, usGenerateChecksum( 0U, &( ucData[ uxOffset ] ), uxFieldLength ) );
+
+        if( usChecksum != 0U )
+        {
+            /* Zero may also be returned for all-zero data, see usAdjustChecksum(). */
+            TEST_ASSERT_EQUAL_HEX16( FreeRTOS_htons( ( uint16_t ) ~usGenerateChecksum( 0U, ucData, uxLength ) ), usChecksum );
+        }
+    }
+}
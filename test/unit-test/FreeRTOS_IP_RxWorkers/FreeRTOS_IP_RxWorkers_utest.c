@@ -0,0 +1,492 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_IP_RxWorkers_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_DHCP.h"
+#include "mock_FreeRTOS_DHCPv6.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_Routing.h"
+
+#include "FreeRTOS_IP.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+void prvCreateRxWorkers( void );
+void prvRxWorkerTask( void * pvParameters );
+
+extern QueueHandle_t xNetworkEventQueue;
+extern BaseType_t xIPTaskInitialised;
+extern QueueHandle_t xRxWorkerQueues[ ipconfigRX_WORKER_TASKS ];
+extern TaskHandle_t xRxWorkerTasks[ ipconfigRX_WORKER_TASKS ];
+extern UBaseType_t uxRxWorkerCount;
+extern NetworkBufferDescriptor_t * pxVerifiedBuffers[];
+extern size_t uxVerifiedCount;
+
+/* The maximum number of queue sends that are recorded. */
+#define rxTEST_MAX_SENDS    ( 4 )
+
+/* The queues, the items and the timeouts of the recorded queue sends. */
+static QueueHandle_t xSentQueues[ rxTEST_MAX_SENDS ];
+static IPStackEvent_t xSentEvents[ rxTEST_MAX_SENDS ];
+static NetworkBufferDescriptor_t * pxSentChains[ rxTEST_MAX_SENDS ];
+static TickType_t xSentTimeouts[ rxTEST_MAX_SENDS ];
+static int lSendCount;
+
+/* The call to xQueueGenericSend() that fails, or -1. */
+static int lFailingSend;
+
+/* Dummy handles for the queues and the tasks. */
+static uint8_t ucQueueHandles[ 3 ];
+static uint8_t ucTaskHandles[ 3 ];
+
+/* ============================ Unity Fixtures ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    xNetworkEventQueue = ( QueueHandle_t ) &( ucQueueHandles[ 2 ] );
+    xIPTaskInitialised = pdTRUE;
+    xRxWorkerQueues[ 0 ] = ( QueueHandle_t ) &( ucQueueHandles[ 0 ] );
+    xRxWorkerQueues[ 1 ] = ( QueueHandle_t ) &( ucQueueHandles[ 1 ] );
+    xRxWorkerTasks[ 0 ] = ( TaskHandle_t ) &( ucTaskHandles[ 0 ] );
+    xRxWorkerTasks[ 1 ] = ( TaskHandle_t ) &( ucTaskHandles[ 1 ] );
+    uxRxWorkerCount = 2U;
+
+    memset( xSentQueues, 0, sizeof( xSentQueues ) );
+    memset( xSentEvents, 0, sizeof( xSentEvents ) );
+    memset( pxSentChains, 0, sizeof( pxSentChains ) );
+    memset( xSentTimeouts, 0, sizeof( xSentTimeouts ) );
+    lSendCount = 0;
+    lFailingSend = -1;
+    uxVerifiedCount = 0U;
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    uxRxWorkerCount = 0U;
+}
+
+/* ======================== Stub Callback Functions ========================= */
+
+/*
+ * Record a queue send.  An item of a worker queue is a chain of network
+ * buffers, an item of the queue of the IP-task is an event.
+ */
+static BaseType_t xQueueGenericSend_Record( QueueHandle_t xQueue,
+                                            const void * const pvItemToQueue,
+                                            TickType_t xTicksToWait,
+                                            const BaseType_t xCopyPosition,
+                                            int lCallCount )
+{
+    BaseType_t xReturn = pdPASS;
+
+    ( void ) xCopyPosition;
+
+    TEST_ASSERT_LESS_THAN( rxTEST_MAX_SENDS, lSendCount );
+
+    xSentQueues[ lSendCount ] = xQueue;
+    xSentTimeouts[ lSendCount ] = xTicksToWait;
+
+    if( xQueue == xNetworkEventQueue )
+    {
+        memcpy( &( xSentEvents[ lSendCount ] ), pvItemToQueue, sizeof( IPStackEvent_t ) );
+    }
+    else
+    {
+        memcpy( &( pxSentChains[ lSendCount ] ), pvItemToQueue, sizeof( NetworkBufferDescriptor_t * ) );
+    }
+
+    if( lCallCount == lFailingSend )
+    {
+        xReturn = pdFAIL;
+    }
+
+    lSendCount++;
+
+    return xReturn;
+}
+
+/*
+ * The flow hash of a test frame is stored in its first byte.
+ */
+static uint32_t ulFrameFlowHash_FirstByte( const uint8_t * pucEthernetBuffer,
+                                           const FrameSummary_t * pxSummary,
+                                           int lCallCount )
+{
+    ( void ) pxSummary;
+    ( void ) lCallCount;
+
+    return pucEthernetBuffer[ 0 ];
+}
+
+/* ============================ Helper Functions ============================ */
+
+/*
+ * Link the network buffers into a chain, as a driver does when
+ * ipconfigUSE_LINKED_RX_MESSAGES is enabled.  The first byte of each
+ * frame holds its flow hash.
+ */
+static void prvMakeChain( NetworkBufferDescriptor_t * pxBuffers,
+                          uint8_t * pucFrames,
+                          const uint8_t * pucHashes,
+                          size_t uxCount )
+{
+    size_t uxIndex;
+
+    memset( pxBuffers, 0, uxCount * sizeof( NetworkBufferDescriptor_t ) );
+
+    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+    {
+        pucFrames[ uxIndex * ipconfigTCP_MSS ] = pucHashes[ uxIndex ];
+        pxBuffers[ uxIndex ].pucEthernetBuffer = &( pucFrames[ uxIndex * ipconfigTCP_MSS ] );
+        pxBuffers[ uxIndex ].xDataLength = ipconfigTCP_MSS;
+
+        if( ( uxIndex + 1U ) < uxCount )
+        {
+            pxBuffers[ uxIndex ].pxNextBuffer = &( pxBuffers[ uxIndex + 1U ] );
+        }
+    }
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief test_xSendEventStructToIPTask_SteersFlows
+ * To validate that a chain from the driver is split into runs of frames of the
+ * same flow, that each run stays linked and is queued as one item, and that
+ * the worker is chosen by the flow hash.
+ */
+void test_xSendEventStructToIPTask_SteersFlows( void )
+{
+    NetworkBufferDescriptor_t xBuffers[ 4 ];
+    uint8_t ucFrames[ 4 * ipconfigTCP_MSS ];
+    const uint8_t ucHashes[ 4 ] = { 5U, 5U, 2U, 5U };
+    IPStackEvent_t xEvent;
+
+    prvMakeChain( xBuffers, ucFrames, ucHashes, 4U );
+    xEvent.eEventType = eNetworkRxEvent;
+    xEvent.pvData = &( xBuffers[ 0 ] );
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( NULL );
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    eClassifyFrame_IgnoreAndReturn( eFrameClassIPv4 );
+    ulFrameFlowHash_Stub( ulFrameFlowHash_FirstByte );
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, 10U ) );
+
+    TEST_ASSERT_EQUAL( 3, lSendCount );
+
+    /* The first two frames go to worker 5 % 2 as one chain. */
+    TEST_ASSERT_EQUAL_PTR( xRxWorkerQueues[ 1 ], xSentQueues[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 0 ] ), pxSentChains[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 1 ] ), xBuffers[ 0 ].pxNextBuffer );
+    TEST_ASSERT_NULL( xBuffers[ 1 ].pxNextBuffer );
+
+    TEST_ASSERT_EQUAL_PTR( xRxWorkerQueues[ 0 ], xSentQueues[ 1 ] );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 2 ] ), pxSentChains[ 1 ] );
+    TEST_ASSERT_NULL( xBuffers[ 2 ].pxNextBuffer );
+
+    TEST_ASSERT_EQUAL_PTR( xRxWorkerQueues[ 1 ], xSentQueues[ 2 ] );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 3 ] ), pxSentChains[ 2 ] );
+    TEST_ASSERT_EQUAL( 10U, xSentTimeouts[ 2 ] );
+}
+
+/**
+ * @brief test_xSendEventStructToIPTask_SteerFromIPTask
+ * To validate that the IP-task, e.g. through the loopback interface, does not
+ * block on a full worker queue.
+ */
+void test_xSendEventStructToIPTask_SteerFromIPTask( void )
+{
+    NetworkBufferDescriptor_t xBuffers[ 1 ];
+    uint8_t ucFrames[ ipconfigTCP_MSS ];
+    const uint8_t ucHashes[ 1 ] = { 3U };
+    IPStackEvent_t xEvent;
+
+    prvMakeChain( xBuffers, ucFrames, ucHashes, 1U );
+    xEvent.eEventType = eNetworkRxEvent;
+    xEvent.pvData = &( xBuffers[ 0 ] );
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( NULL );
+    xIsCallingFromIPTask_ExpectAndReturn( pdTRUE );
+    eClassifyFrame_IgnoreAndReturn( eFrameClassIPv4 );
+    ulFrameFlowHash_Stub( ulFrameFlowHash_FirstByte );
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, portMAX_DELAY ) );
+
+    TEST_ASSERT_EQUAL( 1, lSendCount );
+    TEST_ASSERT_EQUAL_PTR( xRxWorkerQueues[ 1 ], xSentQueues[ 0 ] );
+    TEST_ASSERT_EQUAL( 0U, xSentTimeouts[ 0 ] );
+}
+
+/**
+ * @brief test_xSendEventStructToIPTask_FirstFlowFails
+ * To validate that when the first run can not be queued, the whole chain is
+ * given back linked, so that the driver can release it.
+ */
+void test_xSendEventStructToIPTask_FirstFlowFails( void )
+{
+    NetworkBufferDescriptor_t xBuffers[ 3 ];
+    uint8_t ucFrames[ 3 * ipconfigTCP_MSS ];
+    const uint8_t ucHashes[ 3 ] = { 4U, 4U, 7U };
+    IPStackEvent_t xEvent;
+
+    prvMakeChain( xBuffers, ucFrames, ucHashes, 3U );
+    xEvent.eEventType = eNetworkRxEvent;
+    xEvent.pvData = &( xBuffers[ 0 ] );
+    lFailingSend = 0;
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( NULL );
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    eClassifyFrame_IgnoreAndReturn( eFrameClassIPv4 );
+    ulFrameFlowHash_Stub( ulFrameFlowHash_FirstByte );
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+
+    TEST_ASSERT_EQUAL( pdFAIL, xSendEventStructToIPTask( &xEvent, 0U ) );
+
+    TEST_ASSERT_EQUAL( 1, lSendCount );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 1 ] ), xBuffers[ 0 ].pxNextBuffer );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 2 ] ), xBuffers[ 1 ].pxNextBuffer );
+    TEST_ASSERT_NULL( xBuffers[ 2 ].pxNextBuffer );
+}
+
+/**
+ * @brief test_xSendEventStructToIPTask_LaterFlowFails
+ * To validate that a later run that can not be queued is released, while the
+ * runs that were queued are kept.
+ */
+void test_xSendEventStructToIPTask_LaterFlowFails( void )
+{
+    NetworkBufferDescriptor_t xBuffers[ 3 ];
+    uint8_t ucFrames[ 3 * ipconfigTCP_MSS ];
+    const uint8_t ucHashes[ 3 ] = { 1U, 2U, 2U };
+    IPStackEvent_t xEvent;
+
+    prvMakeChain( xBuffers, ucFrames, ucHashes, 3U );
+    xEvent.eEventType = eNetworkRxEvent;
+    xEvent.pvData = &( xBuffers[ 0 ] );
+    lFailingSend = 1;
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( NULL );
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    eClassifyFrame_IgnoreAndReturn( eFrameClassIPv4 );
+    ulFrameFlowHash_Stub( ulFrameFlowHash_FirstByte );
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+    vReleaseNetworkBufferAndDescriptor_Expect( &( xBuffers[ 1 ] ) );
+    vReleaseNetworkBufferAndDescriptor_Expect( &( xBuffers[ 2 ] ) );
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, 0U ) );
+
+    TEST_ASSERT_EQUAL( 2, lSendCount );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 0 ] ), pxSentChains[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 1 ] ), pxSentChains[ 1 ] );
+}
+
+/**
+ * @brief test_xSendEventStructToIPTask_NoWorkers
+ * To validate that received frames go to the IP-task directly when no RX
+ * worker could be created.
+ */
+void test_xSendEventStructToIPTask_NoWorkers( void )
+{
+    NetworkBufferDescriptor_t xBuffer;
+    IPStackEvent_t xEvent;
+
+    memset( &xBuffer, 0, sizeof( xBuffer ) );
+    xEvent.eEventType = eNetworkRxEvent;
+    xEvent.pvData = &xBuffer;
+    uxRxWorkerCount = 0U;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, 0U ) );
+
+    TEST_ASSERT_EQUAL( 1, lSendCount );
+    TEST_ASSERT_EQUAL_PTR( xNetworkEventQueue, xSentQueues[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &xBuffer, xSentEvents[ 0 ].pvData );
+}
+
+/**
+ * @brief test_xSendEventStructToIPTask_FromRxWorker
+ * To validate that frames posted by an RX worker go to the IP-task, and are
+ * not steered to a worker again.
+ */
+void test_xSendEventStructToIPTask_FromRxWorker( void )
+{
+    NetworkBufferDescriptor_t xBuffer;
+    IPStackEvent_t xEvent;
+
+    memset( &xBuffer, 0, sizeof( xBuffer ) );
+    xEvent.eEventType = eNetworkRxEvent;
+    xEvent.pvData = &xBuffer;
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( xRxWorkerTasks[ 1 ] );
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, portMAX_DELAY ) );
+
+    TEST_ASSERT_EQUAL( 1, lSendCount );
+    TEST_ASSERT_EQUAL_PTR( xNetworkEventQueue, xSentQueues[ 0 ] );
+    TEST_ASSERT_EQUAL( portMAX_DELAY, xSentTimeouts[ 0 ] );
+}
+
+/**
+ * @brief test_xSendEventStructToIPTask_NotReceived
+ * To validate that events other than received frames are not steered.
+ */
+void test_xSendEventStructToIPTask_NotReceived( void )
+{
+    IPStackEvent_t xEvent;
+
+    xEvent.eEventType = eNetworkTxEvent;
+    xEvent.pvData = NULL;
+
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+
+    TEST_ASSERT_EQUAL( pdPASS, xSendEventStructToIPTask( &xEvent, 0U ) );
+
+    TEST_ASSERT_EQUAL( 1, lSendCount );
+    TEST_ASSERT_EQUAL_PTR( xNetworkEventQueue, xSentQueues[ 0 ] );
+}
+
+/**
+ * @brief test_prvRxWorkerTask_ChecksAndPostsChain
+ * To validate that a worker verifies the checksums that were not offloaded,
+ * and posts the frames to the IP-task as one chain.
+ */
+void test_prvRxWorkerTask_ChecksAndPostsChain( void )
+{
+    NetworkBufferDescriptor_t xBuffers[ 3 ];
+    uint8_t ucFrames[ 3 * ipconfigTCP_MSS ];
+    const uint8_t ucHashes[ 3 ] = { 6U, 6U, 6U };
+    NetworkBufferDescriptor_t * pxChain = &( xBuffers[ 0 ] );
+
+    prvMakeChain( xBuffers, ucFrames, ucHashes, 3U );
+
+    /* The checksums of the second frame were offloaded. */
+    ucFrames[ ipconfigTCP_MSS + 1U ] = 1U;
+
+    ipFOREVER_ExpectAndReturn( pdTRUE );
+    xQueueReceive_ExpectAnyArgsAndReturn( pdPASS );
+    xQueueReceive_ReturnMemThruPtr_pvBuffer( &pxChain, sizeof( pxChain ) );
+    eClassifyFrame_ExpectAndReturn( xBuffers[ 0 ].pucEthernetBuffer, xBuffers[ 0 ].xDataLength, NULL, eFrameClassIPv4 );
+    eClassifyFrame_IgnoreArg_pxSummary();
+    eClassifyFrame_ExpectAndReturn( xBuffers[ 2 ].pucEthernetBuffer, xBuffers[ 2 ].xDataLength, NULL, eFrameClassIPv4 );
+    eClassifyFrame_IgnoreArg_pxSummary();
+
+    xTaskGetCurrentTaskHandle_ExpectAndReturn( xRxWorkerTasks[ 0 ] );
+    xIsCallingFromIPTask_ExpectAndReturn( pdFALSE );
+    xQueueGenericSend_Stub( xQueueGenericSend_Record );
+
+    ipFOREVER_ExpectAndReturn( pdFALSE );
+
+    prvRxWorkerTask( xRxWorkerQueues[ 0 ] );
+
+    TEST_ASSERT_EQUAL( 2U, uxVerifiedCount );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 0 ] ), pxVerifiedBuffers[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 2 ] ), pxVerifiedBuffers[ 1 ] );
+
+    TEST_ASSERT_EQUAL( 1, lSendCount );
+    TEST_ASSERT_EQUAL_PTR( xNetworkEventQueue, xSentQueues[ 0 ] );
+    TEST_ASSERT_EQUAL( eNetworkRxEvent, xSentEvents[ 0 ].eEventType );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 0 ] ), xSentEvents[ 0 ].pvData );
+    TEST_ASSERT_EQUAL( portMAX_DELAY, xSentTimeouts[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 1 ] ), xBuffers[ 0 ].pxNextBuffer );
+    TEST_ASSERT_EQUAL_PTR( &( xBuffers[ 2 ] ), xBuffers[ 1 ].pxNextBuffer );
+    TEST_ASSERT_NULL( xBuffers[ 2 ].pxNextBuffer );
+}
+
+/**
+ * @brief test_prvCreateRxWorkers_PartialFailure
+ * To validate that a worker which can not be created is left out, and that
+ * the flows are spread over the workers that were created.
+ */
+void test_prvCreateRxWorkers_PartialFailure( void )
+{
+    uxRxWorkerCount = 0U;
+
+    /* The queue of the first worker can not be created. */
+    xQueueGenericCreateStatic_ExpectAnyArgsAndReturn( NULL );
+
+    xQueueGenericCreateStatic_ExpectAnyArgsAndReturn( ( QueueHandle_t ) &( ucQueueHandles[ 1 ] ) );
+    xTaskCreateStatic_ExpectAnyArgsAndReturn( ( TaskHandle_t ) &( ucTaskHandles[ 1 ] ) );
+
+    prvCreateRxWorkers();
+
+    TEST_ASSERT_EQUAL( 1U, uxRxWorkerCount );
+    TEST_ASSERT_EQUAL_PTR( &( ucQueueHandles[ 1 ] ), xRxWorkerQueues[ 0 ] );
+    TEST_ASSERT_EQUAL_PTR( &( ucTaskHandles[ 1 ] ), xRxWorkerTasks[ 0 ] );
+}
+
+/**
+ * @brief test_prvCreateRxWorkers_NoWorkers
+ * To validate that no worker is counted when the tasks can not be created,
+ * so that received frames go to the IP-task directly.
+ */
+void test_prvCreateRxWorkers_NoWorkers( void )
+{
+    uxRxWorkerCount = 0U;
+
+    xQueueGenericCreateStatic_ExpectAnyArgsAndReturn( ( QueueHandle_t ) &( ucQueueHandles[ 0 ] ) );
+    xTaskCreateStatic_ExpectAnyArgsAndReturn( NULL );
+    xQueueGenericCreateStatic_ExpectAnyArgsAndReturn( ( QueueHandle_t ) &( ucQueueHandles[ 1 ] ) );
+    xTaskCreateStatic_ExpectAnyArgsAndReturn( NULL );
+
+    prvCreateRxWorkers();
+
+    TEST_ASSERT_EQUAL( 0U, uxRxWorkerCount );
+}
@@ -3363,3 +3363,305 @@ void test_vReleaseSinglePacketFromUDPSocket_NonHappyPath( void )
 
     vReleaseSinglePacketFromUDPSocket( &xSocket );
 }
+
+/**
+ * @brief test_eClassifyFrame_TooShort
+ * To validate that a frame that is shorter than an Ethernet header
+ * is invalid, and that the summary is cleared.
+ */
+void test_eClassifyFrame_TooShort( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    FrameSummary_t xSummary;
+    eFrameClass_t eClass;
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    memset( &xSummary, 0xA5, sizeof( xSummary ) );
+
+    eClass = eClassifyFrame( ucEthBuffer, sizeof( EthernetHeader_t ) - 1U, &xSummary );
+
+    TEST_ASSERT_EQUAL( eFrameClassInvalid, eClass );
+    TEST_ASSERT_EQUAL( eFrameClassInvalid, xSummary.eClass );
+    TEST_ASSERT_EQUAL( 0U, xSummary.uxIPHeaderLength );
+    TEST_ASSERT_EQUAL( 0U, xSummary.ucProtocol );
+    TEST_ASSERT_EQUAL( 0U, xSummary.usSourcePort );
+    TEST_ASSERT_EQUAL( 0U, xSummary.usDestinationPort );
+}
+
+/**
+ * @brief test_eClassifyFrame_ARP
+ * To validate that an ARP packet is only recognised when it is complete.
+ */
+void test_eClassifyFrame_ARP( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    ARPPacket_t * pxARPPacket = ( ARPPacket_t * ) ucEthBuffer;
+    FrameSummary_t xSummary;
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    pxARPPacket->xEthernetHeader.usFrameType = ipARP_FRAME_TYPE;
+
+    TEST_ASSERT_EQUAL( eFrameClassARP, eClassifyFrame( ucEthBuffer, sizeof( ARPPacket_t ), &xSummary ) );
+    TEST_ASSERT_EQUAL( eFrameClassARP, xSummary.eClass );
+    TEST_ASSERT_EQUAL( 0U, xSummary.uxIPHeaderLength );
+
+    TEST_ASSERT_EQUAL( eFrameClassInvalid, eClassifyFrame( ucEthBuffer, sizeof( ARPPacket_t ) - 1U, &xSummary ) );
+}
+
+/**
+ * @brief test_eClassifyFrame_OtherFrameType
+ * To validate that an unknown frame type is classified as 'other'.
+ */
+void test_eClassifyFrame_OtherFrameType( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    EthernetHeader_t * pxEthernetHeader = ( EthernetHeader_t * ) ucEthBuffer;
+    FrameSummary_t xSummary;
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    pxEthernetHeader->usFrameType = 0xFFFFU;
+
+    TEST_ASSERT_EQUAL( eFrameClassOther, eClassifyFrame( ucEthBuffer, sizeof( EthernetHeader_t ), &xSummary ) );
+    TEST_ASSERT_EQUAL( eFrameClassOther, xSummary.eClass );
+}
+
+/**
+ * @brief test_eClassifyFrame_IPv4UDP
+ * To validate that the header length, the protocol and the ports of
+ * an IPv4 UDP packet are stored in the summary.
+ */
+void test_eClassifyFrame_IPv4UDP( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    UDPPacket_t * pxUDPPacket = ( UDPPacket_t * ) ucEthBuffer;
+    FrameSummary_t xSummary;
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    pxUDPPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+    pxUDPPacket->xIPHeader.ucVersionHeaderLength = 0x45U;
+    pxUDPPacket->xIPHeader.ucProtocol = ipPROTOCOL_UDP;
+    pxUDPPacket->xUDPHeader.usSourcePort = FreeRTOS_htons( 1024U );
+    pxUDPPacket->xUDPHeader.usDestinationPort = FreeRTOS_htons( 53U );
+
+    TEST_ASSERT_EQUAL( eFrameClassIPv4, eClassifyFrame( ucEthBuffer, sizeof( UDPPacket_t ), &xSummary ) );
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER, xSummary.uxIPHeaderLength );
+    TEST_ASSERT_EQUAL( ipPROTOCOL_UDP, xSummary.ucProtocol );
+    TEST_ASSERT_EQUAL( FreeRTOS_htons( 1024U ), xSummary.usSourcePort );
+    TEST_ASSERT_EQUAL( FreeRTOS_htons( 53U ), xSummary.usDestinationPort );
+}
+
+/**
+ * @brief test_eClassifyFrame_IPv4Options
+ * To validate that the ports of a TCP packet are found behind the IP-options.
+ */
+void test_eClassifyFrame_IPv4Options( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    IPPacket_t * pxIPPacket = ( IPPacket_t * ) ucEthBuffer;
+    size_t uxPortsOffset = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + 4U;
+    uint16_t usSourcePort = FreeRTOS_htons( 80U );
+    uint16_t usDestinationPort = FreeRTOS_htons( 49152U );
+    FrameSummary_t xSummary;
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    pxIPPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+    pxIPPacket->xIPHeader.ucVersionHeaderLength = 0x46U;
+    pxIPPacket->xIPHeader.ucProtocol = ipPROTOCOL_TCP;
+    memcpy( &( ucEthBuffer[ uxPortsOffset ] ), &usSourcePort, sizeof( usSourcePort ) );
+    memcpy( &( ucEthBuffer[ uxPortsOffset + 2U ] ), &usDestinationPort, sizeof( usDestinationPort ) );
+
+    TEST_ASSERT_EQUAL( eFrameClassIPv4, eClassifyFrame( ucEthBuffer, uxPortsOffset + ipSIZE_OF_TCP_HEADER, &xSummary ) );
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv4_HEADER + 4U, xSummary.uxIPHeaderLength );
+    TEST_ASSERT_EQUAL( ipPROTOCOL_TCP, xSummary.ucProtocol );
+    TEST_ASSERT_EQUAL( usSourcePort, xSummary.usSourcePort );
+    TEST_ASSERT_EQUAL( usDestinationPort, xSummary.usDestinationPort );
+}
+
+/**
+ * @brief test_eClassifyFrame_IPv4Fragment
+ * To validate that the ports are not read from a fragment, which might
+ * not start with a UDP header.
+ */
+void test_eClassifyFrame_IPv4Fragment( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    UDPPacket_t * pxUDPPacket = ( UDPPacket_t * ) ucEthBuffer;
+    FrameSummary_t xSummary;
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    pxUDPPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+    pxUDPPacket->xIPHeader.ucVersionHeaderLength = 0x45U;
+    pxUDPPacket->xIPHeader.ucProtocol = ipPROTOCOL_UDP;
+    pxUDPPacket->xIPHeader.usFragmentOffset = FreeRTOS_htons( 0x0010U );
+    pxUDPPacket->xUDPHeader.usSourcePort = FreeRTOS_htons( 1024U );
+    pxUDPPacket->xUDPHeader.usDestinationPort = FreeRTOS_htons( 53U );
+
+    TEST_ASSERT_EQUAL( eFrameClassIPv4, eClassifyFrame( ucEthBuffer, sizeof( UDPPacket_t ), &xSummary ) );
+    TEST_ASSERT_EQUAL( ipPROTOCOL_UDP, xSummary.ucProtocol );
+    TEST_ASSERT_EQUAL( 0U, xSummary.usSourcePort );
+    TEST_ASSERT_EQUAL( 0U, xSummary.usDestinationPort );
+}
+
+/**
+ * @brief test_eClassifyFrame_IPv4InvalidHeaderLength
+ * To validate that an IPv4 packet is invalid when its header is shorter than
+ * 20 bytes, when its header does not fit in the frame, or when the frame
+ * is too short.
+ */
+void test_eClassifyFrame_IPv4InvalidHeaderLength( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    IPPacket_t * pxIPPacket = ( IPPacket_t * ) ucEthBuffer;
+    FrameSummary_t xSummary;
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    pxIPPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+
+    pxIPPacket->xIPHeader.ucVersionHeaderLength = 0x44U;
+    TEST_ASSERT_EQUAL( eFrameClassInvalid, eClassifyFrame( ucEthBuffer, sizeof( IPPacket_t ), &xSummary ) );
+
+    pxIPPacket->xIPHeader.ucVersionHeaderLength = 0x46U;
+    TEST_ASSERT_EQUAL( eFrameClassInvalid, eClassifyFrame( ucEthBuffer, sizeof( IPPacket_t ), &xSummary ) );
+
+    pxIPPacket->xIPHeader.ucVersionHeaderLength = 0x45U;
+    TEST_ASSERT_EQUAL( eFrameClassInvalid, eClassifyFrame( ucEthBuffer, sizeof( IPPacket_t ) - 1U, &xSummary ) );
+}
+
+/**
+ * @brief test_eClassifyFrame_IPv6UDP
+ * To validate that the next header and the ports of an IPv6 UDP packet are
+ * stored in the summary.
+ */
+void test_eClassifyFrame_IPv6UDP( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    UDPPacket_IPv6_t * pxUDPPacket = ( UDPPacket_IPv6_t * ) ucEthBuffer;
+    FrameSummary_t xSummary;
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    pxUDPPacket->xEthernetHeader.usFrameType = ipIPv6_FRAME_TYPE;
+    pxUDPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_UDP;
+    pxUDPPacket->xUDPHeader.usSourcePort = FreeRTOS_htons( 5353U );
+    pxUDPPacket->xUDPHeader.usDestinationPort = FreeRTOS_htons( 5355U );
+
+    TEST_ASSERT_EQUAL( eFrameClassIPv6, eClassifyFrame( ucEthBuffer, sizeof( UDPPacket_IPv6_t ), &xSummary ) );
+    TEST_ASSERT_EQUAL( ipSIZE_OF_IPv6_HEADER, xSummary.uxIPHeaderLength );
+    TEST_ASSERT_EQUAL( ipPROTOCOL_UDP, xSummary.ucProtocol );
+    TEST_ASSERT_EQUAL( FreeRTOS_htons( 5353U ), xSummary.usSourcePort );
+    TEST_ASSERT_EQUAL( FreeRTOS_htons( 5355U ), xSummary.usDestinationPort );
+}
+
+/**
+ * @brief test_eClassifyFrame_IPv6NoPorts
+ * To validate that the ports are left zero for an IPv6 packet that is too
+ * short to hold them, or that carries another protocol.
+ */
+void test_eClassifyFrame_IPv6NoPorts( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    UDPPacket_IPv6_t * pxUDPPacket = ( UDPPacket_IPv6_t * ) ucEthBuffer;
+    FrameSummary_t xSummary;
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    pxUDPPacket->xEthernetHeader.usFrameType = ipIPv6_FRAME_TYPE;
+    pxUDPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_UDP;
+    pxUDPPacket->xUDPHeader.usSourcePort = FreeRTOS_htons( 5353U );
+
+    TEST_ASSERT_EQUAL( eFrameClassIPv6, eClassifyFrame( ucEthBuffer, sizeof( IPPacket_IPv6_t ), &xSummary ) );
+    TEST_ASSERT_EQUAL( 0U, xSummary.usSourcePort );
+
+    pxUDPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_ICMP_IPv6;
+    TEST_ASSERT_EQUAL( eFrameClassIPv6, eClassifyFrame( ucEthBuffer, sizeof( UDPPacket_IPv6_t ), &xSummary ) );
+    TEST_ASSERT_EQUAL( ipPROTOCOL_ICMP_IPv6, xSummary.ucProtocol );
+    TEST_ASSERT_EQUAL( 0U, xSummary.usSourcePort );
+
+    TEST_ASSERT_EQUAL( eFrameClassInvalid, eClassifyFrame( ucEthBuffer, sizeof( IPPacket_IPv6_t ) - 1U, &xSummary ) );
+}
+
+/**
+ * @brief test_ulFrameFlowHash_IPv4
+ * To validate the hash of IPv4 packets against the reference values that
+ * Microsoft publishes for RSS ( "Verifying the RSS Hash Calculation" ),
+ * with and without the TCP ports.
+ */
+void test_ulFrameFlowHash_IPv4( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    IPPacket_t * pxIPPacket = ( IPPacket_t * ) ucEthBuffer;
+    FrameSummary_t xSummary;
+    size_t uxIndex;
+    const struct
+    {
+        uint32_t ulSource;
+        uint32_t ulDestination;
+        uint16_t usSourcePort;
+        uint16_t usDestinationPort;
+        uint32_t ulHashIP;
+        uint32_t ulHashPorts;
+    }
+    xVectors[] =
+    {
+        { FreeRTOS_inet_addr_quick( 66, 9, 149, 187 ),  FreeRTOS_inet_addr_quick( 161, 142, 100, 80 ), 2794U,  1766U,  0x323e8fc2U, 0x51ccc178U },
+        { FreeRTOS_inet_addr_quick( 199, 92, 111, 2 ),  FreeRTOS_inet_addr_quick( 65, 69, 140, 83 ),   14230U, 4739U,  0xd718262aU, 0xc626b0eaU },
+        { FreeRTOS_inet_addr_quick( 24, 19, 198, 95 ),  FreeRTOS_inet_addr_quick( 12, 22, 207, 184 ),  12898U, 38024U, 0xd2d0a5deU, 0x5c2b394aU }
+    };
+
+    for( uxIndex = 0U; uxIndex < ( sizeof( xVectors ) / sizeof( xVectors[ 0 ] ) ); uxIndex++ )
+    {
+        memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+        pxIPPacket->xIPHeader.ulSourceIPAddress = xVectors[ uxIndex ].ulSource;
+        pxIPPacket->xIPHeader.ulDestinationIPAddress = xVectors[ uxIndex ].ulDestination;
+
+        memset( &xSummary, 0, sizeof( xSummary ) );
+        xSummary.eClass = eFrameClassIPv4;
+        TEST_ASSERT_EQUAL_HEX32( xVectors[ uxIndex ].ulHashIP, ulFrameFlowHash( ucEthBuffer, &xSummary ) );
+
+        xSummary.usSourcePort = FreeRTOS_htons( xVectors[ uxIndex ].usSourcePort );
+        xSummary.usDestinationPort = FreeRTOS_htons( xVectors[ uxIndex ].usDestinationPort );
+        TEST_ASSERT_EQUAL_HEX32( xVectors[ uxIndex ].ulHashPorts, ulFrameFlowHash( ucEthBuffer, &xSummary ) );
+    }
+}
+
+/**
+ * @brief test_ulFrameFlowHash_IPv6
+ * To validate the hash of an IPv6 packet against the RSS reference values,
+ * with and without the ports.
+ */
+void test_ulFrameFlowHash_IPv6( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    IPPacket_IPv6_t * pxIPPacket = ( IPPacket_IPv6_t * ) ucEthBuffer;
+    FrameSummary_t xSummary;
+    /* 3ffe:2501:200:1fff::7 and 3ffe:2501:200:3::1 */
+    const uint8_t ucSource[ ipSIZE_OF_IPv6_ADDRESS ] = { 0x3fU, 0xfeU, 0x25U, 0x01U, 0x02U, 0x00U, 0x1fU, 0xffU, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0x07U };
+    const uint8_t ucDestination[ ipSIZE_OF_IPv6_ADDRESS ] = { 0x3fU, 0xfeU, 0x25U, 0x01U, 0x02U, 0x00U, 0x00U, 0x03U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0x01U };
+
+    memset( ucEthBuffer, 0, sizeof( ucEthBuffer ) );
+    memcpy( pxIPPacket->xIPHeader.xSourceAddress.ucBytes, ucSource, sizeof( ucSource ) );
+    memcpy( pxIPPacket->xIPHeader.xDestinationAddress.ucBytes, ucDestination, sizeof( ucDestination ) );
+
+    memset( &xSummary, 0, sizeof( xSummary ) );
+    xSummary.eClass = eFrameClassIPv6;
+    TEST_ASSERT_EQUAL_HEX32( 0x2cc18cd5U, ulFrameFlowHash( ucEthBuffer, &xSummary ) );
+
+    xSummary.usSourcePort = FreeRTOS_htons( 2794U );
+    xSummary.usDestinationPort = FreeRTOS_htons( 1766U );
+    TEST_ASSERT_EQUAL_HEX32( 0x40207d3dU, ulFrameFlowHash( ucEthBuffer, &xSummary ) );
+}
+
+/**
+ * @brief test_ulFrameFlowHash_NotIP
+ * To validate that frames which are not IP packets get a hash of zero.
+ */
+void test_ulFrameFlowHash_NotIP( void )
+{
+    uint8_t ucEthBuffer[ ipconfigTCP_MSS ];
+    FrameSummary_t xSummary;
+
+    memset( ucEthBuffer, 0xA5, sizeof( ucEthBuffer ) );
+    memset( &xSummary, 0, sizeof( xSummary ) );
+    xSummary.eClass = eFrameClassARP;
+    xSummary.usDestinationPort = FreeRTOS_htons( 80U );
+
+    TEST_ASSERT_EQUAL_HEX32( 0U, ulFrameFlowHash( ucEthBuffer, &xSummary ) );
+}
@@ -0,0 +1,316 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_IP_Utils_ChecksumOffload_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_ARP.h"
+#include "mock_FreeRTOS_ND.h"
+#include "mock_FreeRTOS_DHCP.h"
+#include "mock_FreeRTOS_DHCPv6.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_IPv4_Utils.h"
+#include "mock_FreeRTOS_IPv6_Utils.h"
+#include "mock_NetworkBufferManagement.h"
+
+#include "FreeRTOS_IP_Utils.h"
+
+#include "FreeRTOS_IP_Utils_ChecksumOffload_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/* The length of the UDP payload of the test packets. */
+#define TEST_UDP_PAYLOAD_LENGTH    ( 10U )
+
+/* The length of an IPv4 UDP packet, including the Ethernet header. */
+#define TEST_UDP_IPv4_LENGTH       ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER + TEST_UDP_PAYLOAD_LENGTH )
+
+/* The length of an IPv6 UDP packet, including the Ethernet header. */
+#define TEST_UDP_IPv6_LENGTH       ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + ipSIZE_OF_UDP_HEADER + TEST_UDP_PAYLOAD_LENGTH )
+
+static uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU ];
+
+static NetworkBufferDescriptor_t xNetworkBuffer;
+
+static NetworkInterface_t xInterface;
+
+/* ============================ Helper Functions ============================ */
+
+/*
+ * @brief Prepare a network buffer that holds an outgoing IPv4 UDP packet.
+ */
+static UDPPacket_t * prvPrepareUDPv4Packet( void )
+{
+    UDPPacket_t * pxUDPPacket = ( UDPPacket_t * ) ucEthernetBuffer;
+    size_t uxIndex;
+
+    ( void ) memset( ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+    ( void ) memset( &( xNetworkBuffer ), 0, sizeof( xNetworkBuffer ) );
+
+    pxUDPPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+    pxUDPPacket->xIPHeader.ucVersionHeaderLength = ipIPV4_VERSION_HEADER_LENGTH_MIN;
+    pxUDPPacket->xIPHeader.usLength = FreeRTOS_htons( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_UDP_HEADER + TEST_UDP_PAYLOAD_LENGTH );
+    pxUDPPacket->xIPHeader.ucTimeToLive = 64U;
+    pxUDPPacket->xIPHeader.ucProtocol = ipPROTOCOL_UDP;
+    pxUDPPacket->xIPHeader.ulSourceIPAddress = FreeRTOS_htonl( 0xC0A80102U );
+    pxUDPPacket->xIPHeader.ulDestinationIPAddress = FreeRTOS_htonl( 0xC0A80103U );
+    pxUDPPacket->xUDPHeader.usSourcePort = FreeRTOS_htons( 5000U );
+    pxUDPPacket->xUDPHeader.usDestinationPort = FreeRTOS_htons( 6000U );
+    pxUDPPacket->xUDPHeader.usLength = FreeRTOS_htons( ipSIZE_OF_UDP_HEADER + TEST_UDP_PAYLOAD_LENGTH );
+
+    for( uxIndex = 0U; uxIndex < TEST_UDP_PAYLOAD_LENGTH; uxIndex++ )
+    {
+        ucEthernetBuffer[ TEST_UDP_IPv4_LENGTH - TEST_UDP_PAYLOAD_LENGTH + uxIndex ] = ( uint8_t ) ( uxIndex + 1U );
+    }
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+    xNetworkBuffer.xDataLength = TEST_UDP_IPv4_LENGTH;
+
+    return pxUDPPacket;
+}
+
+/*
+ * @brief Prepare a network buffer that holds an outgoing IPv6 UDP packet.
+ */
+static UDPPacket_IPv6_t * prvPrepareUDPv6Packet( void )
+{
+    UDPPacket_IPv6_t * pxUDPPacket = ( UDPPacket_IPv6_t * ) ucEthernetBuffer;
+
+    ( void ) memset( ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+    ( void ) memset( &( xNetworkBuffer ), 0, sizeof( xNetworkBuffer ) );
+
+    pxUDPPacket->xEthernetHeader.usFrameType = ipIPv6_FRAME_TYPE;
+    pxUDPPacket->xIPHeader.ucVersionTrafficClass = 0x60U;
+    pxUDPPacket->xIPHeader.usPayloadLength = FreeRTOS_htons( ipSIZE_OF_UDP_HEADER + TEST_UDP_PAYLOAD_LENGTH );
+    pxUDPPacket->xIPHeader.ucNextHeader = ipPROTOCOL_UDP;
+    pxUDPPacket->xIPHeader.ucHopLimit = 64U;
+    pxUDPPacket->xIPHeader.xSourceAddress.ucBytes[ 0 ] = 0xFEU;
+    pxUDPPacket->xIPHeader.xSourceAddress.ucBytes[ 15 ] = 0x02U;
+    pxUDPPacket->xIPHeader.xDestinationAddress.ucBytes[ 0 ] = 0xFEU;
+    pxUDPPacket->xIPHeader.xDestinationAddress.ucBytes[ 15 ] = 0x03U;
+    pxUDPPacket->xUDPHeader.usSourcePort = FreeRTOS_htons( 5000U );
+    pxUDPPacket->xUDPHeader.usDestinationPort = FreeRTOS_htons( 6000U );
+    pxUDPPacket->xUDPHeader.usLength = FreeRTOS_htons( ipSIZE_OF_UDP_HEADER + TEST_UDP_PAYLOAD_LENGTH );
+    ucEthernetBuffer[ TEST_UDP_IPv6_LENGTH - 1U ] = 0x5AU;
+
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+    xNetworkBuffer.xDataLength = TEST_UDP_IPv6_LENGTH;
+
+    return pxUDPPacket;
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief test_xIsRxChecksumOffloaded_DriverVerified
+ * A packet whose checksums were verified by the driver is not checked again,
+ * whatever the interface can do.
+ */
+void test_xIsRxChecksumOffloaded_DriverVerified( void )
+{
+    ( void ) memset( &( xNetworkBuffer ), 0, sizeof( xNetworkBuffer ) );
+    ( void ) memset( &( xInterface ), 0, sizeof( xInterface ) );
+
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_VERIFIED;
+
+    TEST_ASSERT_EQUAL( pdTRUE, xIsRxChecksumOffloaded( &( xNetworkBuffer ) ) );
+
+    xNetworkBuffer.pxInterface = &( xInterface );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xIsRxChecksumOffloaded( &( xNetworkBuffer ) ) );
+}
+
+/**
+ * @brief test_xIsRxChecksumOffloaded_InterfaceRx
+ * An interface with RX checksum offloading has verified the checksums.
+ */
+void test_xIsRxChecksumOffloaded_InterfaceRx( void )
+{
+    ( void ) memset( &( xNetworkBuffer ), 0, sizeof( xNetworkBuffer ) );
+    ( void ) memset( &( xInterface ), 0, sizeof( xInterface ) );
+
+    xInterface.ucChecksumOffload = ipINTERFACE_CHECKSUM_OFFLOAD_RX;
+    xNetworkBuffer.pxInterface = &( xInterface );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xIsRxChecksumOffloaded( &( xNetworkBuffer ) ) );
+}
+
+/**
+ * @brief test_xIsRxChecksumOffloaded_SoftwareCheck
+ * The stack verifies the checksums when the interface has no RX checksum
+ * offloading, or when the buffer has no interface.
+ */
+void test_xIsRxChecksumOffloaded_SoftwareCheck( void )
+{
+    ( void ) memset( &( xNetworkBuffer ), 0, sizeof( xNetworkBuffer ) );
+    ( void ) memset( &( xInterface ), 0, sizeof( xInterface ) );
+
+    /* The TX flag of a buffer does not mean anything on reception. */
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_NEEDED;
+
+    TEST_ASSERT_EQUAL( pdFALSE, xIsRxChecksumOffloaded( &( xNetworkBuffer ) ) );
+
+    xInterface.ucChecksumOffload = ipINTERFACE_CHECKSUM_OFFLOAD_TX;
+    xNetworkBuffer.pxInterface = &( xInterface );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xIsRxChecksumOffloaded( &( xNetworkBuffer ) ) );
+}
+
+/**
+ * @brief test_vPrepareTxChecksums_OffloadIPv4
+ * An interface with TX checksum offloading gets an IPv4 packet flagged with
+ * ipBUFFER_CHECKSUM_NEEDED, the checksums are left to the driver.
+ */
+void test_vPrepareTxChecksums_OffloadIPv4( void )
+{
+    UDPPacket_t * pxUDPPacket = prvPrepareUDPv4Packet();
+
+    ( void ) memset( &( xInterface ), 0, sizeof( xInterface ) );
+    xInterface.ucChecksumOffload = ipINTERFACE_CHECKSUM_OFFLOAD_TX;
+
+    vPrepareTxChecksums( &( xInterface ), &( xNetworkBuffer ) );
+
+    TEST_ASSERT_EQUAL( ipBUFFER_CHECKSUM_NEEDED, xNetworkBuffer.ucChecksumFlags );
+    TEST_ASSERT_EQUAL( 0U, pxUDPPacket->xIPHeader.usHeaderChecksum );
+    TEST_ASSERT_EQUAL( 0U, pxUDPPacket->xUDPHeader.usChecksum );
+}
+
+/**
+ * @brief test_vPrepareTxChecksums_OffloadIPv6
+ * An interface with TX checksum offloading gets an IPv6 packet flagged with
+ * ipBUFFER_CHECKSUM_NEEDED, the checksums are left to the driver.
+ */
+void test_vPrepareTxChecksums_OffloadIPv6( void )
+{
+    UDPPacket_IPv6_t * pxUDPPacket = prvPrepareUDPv6Packet();
+
+    ( void ) memset( &( xInterface ), 0, sizeof( xInterface ) );
+    xInterface.ucChecksumOffload = ( uint8_t ) ( ipINTERFACE_CHECKSUM_OFFLOAD_RX | ipINTERFACE_CHECKSUM_OFFLOAD_TX );
+
+    vPrepareTxChecksums( &( xInterface ), &( xNetworkBuffer ) );
+
+    TEST_ASSERT_EQUAL( ipBUFFER_CHECKSUM_NEEDED, xNetworkBuffer.ucChecksumFlags );
+    TEST_ASSERT_EQUAL( 0U, pxUDPPacket->xUDPHeader.usChecksum );
+}
+
+/**
+ * @brief test_vPrepareTxChecksums_SoftwareIPv4
+ * An interface without TX checksum offloading gets an IPv4 packet with both
+ * the IP-header checksum and the UDP checksum filled in.  A flag that was left
+ * in the buffer is cleared.
+ */
+void test_vPrepareTxChecksums_SoftwareIPv4( void )
+{
+    UDPPacket_t * pxUDPPacket = prvPrepareUDPv4Packet();
+
+    ( void ) memset( &( xInterface ), 0, sizeof( xInterface ) );
+    xInterface.ucChecksumOffload = ipINTERFACE_CHECKSUM_OFFLOAD_RX;
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_NEEDED;
+
+    prvChecksumIPv4Checks_Stub( prvChecksumIPv4Checks_Valid );
+
+    vPrepareTxChecksums( &( xInterface ), &( xNetworkBuffer ) );
+
+    TEST_ASSERT_EQUAL( 0U, xNetworkBuffer.ucChecksumFlags );
+    TEST_ASSERT_NOT_EQUAL( 0U, pxUDPPacket->xIPHeader.usHeaderChecksum );
+    TEST_ASSERT_NOT_EQUAL( 0U, pxUDPPacket->xUDPHeader.usChecksum );
+
+    /* A correct header sums up to all ones. */
+    TEST_ASSERT_EQUAL_HEX16( 0xFFFFU, usGenerateChecksum( 0U, &( ucEthernetBuffer[ ipSIZE_OF_ETH_HEADER ] ), ipSIZE_OF_IPv4_HEADER ) );
+    TEST_ASSERT_EQUAL( ipCORRECT_CRC, usGenerateProtocolChecksum( ucEthernetBuffer, xNetworkBuffer.xDataLength, pdFALSE ) );
+}
+
+/**
+ * @brief test_vPrepareTxChecksums_SoftwareIPv6
+ * An interface without TX checksum offloading gets an IPv6 packet with the
+ * UDP checksum filled in.
+ */
+void test_vPrepareTxChecksums_SoftwareIPv6( void )
+{
+    UDPPacket_IPv6_t * pxUDPPacket = prvPrepareUDPv6Packet();
+
+    ( void ) memset( &( xInterface ), 0, sizeof( xInterface ) );
+
+    prvChecksumIPv6Checks_Stub( prvChecksumIPv6Checks_Valid );
+
+    vPrepareTxChecksums( &( xInterface ), &( xNetworkBuffer ) );
+
+    TEST_ASSERT_EQUAL( 0U, xNetworkBuffer.ucChecksumFlags );
+    TEST_ASSERT_NOT_EQUAL( 0U, pxUDPPacket->xUDPHeader.usChecksum );
+    TEST_ASSERT_EQUAL( ipCORRECT_CRC, usGenerateProtocolChecksum( ucEthernetBuffer, xNetworkBuffer.xDataLength, pdFALSE ) );
+}
+
+/**
+ * @brief test_vPrepareTxChecksums_NotIP
+ * A frame that is not an IP packet is neither flagged nor changed.
+ */
+void test_vPrepareTxChecksums_NotIP( void )
+{
+    uint8_t ucCopy[ TEST_UDP_IPv4_LENGTH ];
+    EthernetHeader_t * pxEthernetHeader = ( EthernetHeader_t * ) ucEthernetBuffer;
+
+    ( void ) prvPrepareUDPv4Packet();
+    pxEthernetHeader->usFrameType = ipARP_FRAME_TYPE;
+    ( void ) memcpy( ucCopy, ucEthernetBuffer, sizeof( ucCopy ) );
+
+    ( void ) memset( &( xInterface ), 0, sizeof( xInterface ) );
+    xInterface.ucChecksumOffload = ipINTERFACE_CHECKSUM_OFFLOAD_TX;
+    xNetworkBuffer.ucChecksumFlags = ipBUFFER_CHECKSUM_NEEDED;
+
+    vPrepareTxChecksums( &( xInterface ), &( xNetworkBuffer ) );
+
+    TEST_ASSERT_EQUAL( 0U, xNetworkBuffer.ucChecksumFlags );
+    TEST_ASSERT_EQUAL_MEMORY( ucCopy, ucEthernetBuffer, sizeof( ucCopy ) );
+
+    xInterface.ucChecksumOffload = 0U;
+
+    vPrepareTxChecksums( &( xInterface ), &( xNetworkBuffer ) );
+
+    TEST_ASSERT_EQUAL( 0U, xNetworkBuffer.ucChecksumFlags );
+    TEST_ASSERT_EQUAL_MEMORY( ucCopy, ucEthernetBuffer, sizeof( ucCopy ) );
+}
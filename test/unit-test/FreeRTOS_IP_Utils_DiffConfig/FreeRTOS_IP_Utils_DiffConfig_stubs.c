@@ -56,3 +56,21 @@ static BaseType_t xNetworkInterfaceInitialise_test( struct xNetworkInterface * p
 {
     return pdPASS;
 }
+
+void vPortEnterCritical( void )
+{
+}
+
+void vPortExitCritical( void )
+{
+}
+
+BaseType_t xPortSetInterruptMask( void )
+{
+    return 0;
+}
+
+void vPortClearInterruptMask( BaseType_t xMask )
+{
+    ( void ) xMask;
+}
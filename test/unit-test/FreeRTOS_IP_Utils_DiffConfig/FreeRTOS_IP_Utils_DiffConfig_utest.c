@@ -335,3 +335,200 @@ void test_pxUDPPayloadBuffer_to_NetworkBuffer_IPv6( void )
 
     TEST_ASSERT_EQUAL( pxNetBufferToReturn, pxNetworkBuffer );
 }
+
+/**
+ * @brief A descriptor that is released by vReleaseNetworkBufferAndDescriptor(),
+ *        in the way that BufferAllocation_x.c does it.
+ */
+static NetworkBufferDescriptor_t * pxReleasedBuffer;
+
+static void vReleaseNetworkBufferAndDescriptor_SharedStub( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                                           int NumCalls )
+{
+    ( void ) NumCalls;
+
+    if( xReleaseSharedNetworkBuffer( pxNetworkBuffer ) != pdFALSE )
+    {
+        pxReleasedBuffer = pxNetworkBuffer;
+    }
+}
+
+/**
+ * @brief Make a shared copy of 'pxNetworkBuffer', that gets 'pxNewBuffer' and
+ *        its buffer 'pucOwnBuffer'.
+ */
+static NetworkBufferDescriptor_t * prvShare( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                             NetworkBufferDescriptor_t * pxNewBuffer,
+                                             uint8_t * pucOwnBuffer )
+{
+    memset( pxNewBuffer, 0, sizeof( *pxNewBuffer ) );
+    pxNewBuffer->pucEthernetBuffer = pucOwnBuffer;
+
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( 0U, 0U, pxNewBuffer );
+
+    return pxShareNetworkBufferWithDescriptor( pxNetworkBuffer );
+}
+
+/**
+ * @brief test_pxShareNetworkBufferWithDescriptor_CountsReferences
+ * To validate that the owner counts its references: zero means one reference,
+ * and every shared copy adds one.  A copy of a copy refers to the owner.
+ */
+void test_pxShareNetworkBufferWithDescriptor_CountsReferences( void )
+{
+    NetworkBufferDescriptor_t xOwner, xCopy1, xCopy2;
+    uint8_t ucEthBuf[ 64 ], ucOwnBuf1[ 8 ], ucOwnBuf2[ 8 ];
+    NetworkBufferDescriptor_t * pxReturn;
+
+    memset( &xOwner, 0, sizeof( xOwner ) );
+    xOwner.pucEthernetBuffer = ucEthBuf;
+    xOwner.xDataLength = 42U;
+    xOwner.usPort = 0x1234U;
+
+    pxReturn = prvShare( &xOwner, &xCopy1, ucOwnBuf1 );
+
+    TEST_ASSERT_EQUAL_PTR( &xCopy1, pxReturn );
+    TEST_ASSERT_EQUAL( 2U, xOwner.usShareCount );
+    TEST_ASSERT_EQUAL_PTR( &xOwner, xCopy1.pxSharedOwner );
+    TEST_ASSERT_EQUAL_PTR( ucEthBuf, xCopy1.pucEthernetBuffer );
+    TEST_ASSERT_EQUAL_PTR( ucOwnBuf1, xCopy1.pucOwnBuffer );
+    TEST_ASSERT_EQUAL( 42U, xCopy1.xDataLength );
+    TEST_ASSERT_EQUAL( 0x1234U, xCopy1.usPort );
+
+    pxReturn = prvShare( &xCopy1, &xCopy2, ucOwnBuf2 );
+
+    TEST_ASSERT_EQUAL_PTR( &xCopy2, pxReturn );
+    TEST_ASSERT_EQUAL( 3U, xOwner.usShareCount );
+    TEST_ASSERT_EQUAL_PTR( &xOwner, xCopy2.pxSharedOwner );
+    TEST_ASSERT_EQUAL_PTR( ucEthBuf, xCopy2.pucEthernetBuffer );
+}
+
+/**
+ * @brief test_pxShareNetworkBufferWithDescriptor_NoDescriptor
+ * To validate that the count does not change when no descriptor is available.
+ */
+void test_pxShareNetworkBufferWithDescriptor_NoDescriptor( void )
+{
+    NetworkBufferDescriptor_t xOwner;
+    NetworkBufferDescriptor_t * pxReturn;
+
+    memset( &xOwner, 0, sizeof( xOwner ) );
+
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( 0U, 0U, NULL );
+
+    pxReturn = pxShareNetworkBufferWithDescriptor( &xOwner );
+
+    TEST_ASSERT_EQUAL_PTR( NULL, pxReturn );
+    TEST_ASSERT_EQUAL( 0U, xOwner.usShareCount );
+}
+
+/**
+ * @brief test_xReleaseSharedNetworkBuffer_OwnerReleasedLast
+ * To validate that a shared copy gets its own buffer back, and that the
+ * Ethernet buffer is only released with the last reference, whatever the
+ * order of the releases.
+ */
+void test_xReleaseSharedNetworkBuffer_OwnerReleasedLast( void )
+{
+    NetworkBufferDescriptor_t xOwner, xCopy1, xCopy2;
+    uint8_t ucEthBuf[ 64 ], ucOwnBuf1[ 8 ], ucOwnBuf2[ 8 ];
+
+    memset( &xOwner, 0, sizeof( xOwner ) );
+    xOwner.pucEthernetBuffer = ucEthBuf;
+
+    ( void ) prvShare( &xOwner, &xCopy1, ucOwnBuf1 );
+    ( void ) prvShare( &xOwner, &xCopy2, ucOwnBuf2 );
+
+    pxReleasedBuffer = NULL;
+    vReleaseNetworkBufferAndDescriptor_Stub( vReleaseNetworkBufferAndDescriptor_SharedStub );
+
+    /* The owner is released first, while two copies still refer to it. */
+    TEST_ASSERT_EQUAL( pdFALSE, xReleaseSharedNetworkBuffer( &xOwner ) );
+    TEST_ASSERT_EQUAL( 2U, xOwner.usShareCount );
+
+    /* A copy gets its own buffer back. */
+    TEST_ASSERT_EQUAL( pdTRUE, xReleaseSharedNetworkBuffer( &xCopy1 ) );
+    TEST_ASSERT_EQUAL_PTR( ucOwnBuf1, xCopy1.pucEthernetBuffer );
+    TEST_ASSERT_EQUAL_PTR( NULL, xCopy1.pxSharedOwner );
+    TEST_ASSERT_EQUAL_PTR( NULL, pxReleasedBuffer );
+
+    /* A single reference is left, which is counted as zero. */
+    TEST_ASSERT_EQUAL( 0U, xOwner.usShareCount );
+
+    /* The last copy releases the owner. */
+    TEST_ASSERT_EQUAL( pdTRUE, xReleaseSharedNetworkBuffer( &xCopy2 ) );
+    TEST_ASSERT_EQUAL_PTR( ucOwnBuf2, xCopy2.pucEthernetBuffer );
+    TEST_ASSERT_EQUAL_PTR( &xOwner, pxReleasedBuffer );
+    TEST_ASSERT_EQUAL( 0U, xOwner.usShareCount );
+}
+
+/**
+ * @brief test_xReleaseSharedNetworkBuffer_NotShared
+ * To validate that a buffer that is not shared is released at once.
+ */
+void test_xReleaseSharedNetworkBuffer_NotShared( void )
+{
+    NetworkBufferDescriptor_t xNetworkBuffer;
+
+    memset( &xNetworkBuffer, 0, sizeof( xNetworkBuffer ) );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xReleaseSharedNetworkBuffer( &xNetworkBuffer ) );
+    TEST_ASSERT_EQUAL( 0U, xNetworkBuffer.usShareCount );
+}
+
+/**
+ * @brief test_xReleaseSharedNetworkBufferFromISR
+ * To validate that the ISR variant honours the count, and hands the owner of
+ * a shared copy to the caller instead of releasing it.
+ */
+void test_xReleaseSharedNetworkBufferFromISR( void )
+{
+    NetworkBufferDescriptor_t xOwner, xCopy;
+    NetworkBufferDescriptor_t * pxOwner;
+    uint8_t ucEthBuf[ 64 ], ucOwnBuf[ 8 ];
+
+    memset( &xOwner, 0, sizeof( xOwner ) );
+    xOwner.pucEthernetBuffer = ucEthBuf;
+
+    ( void ) prvShare( &xOwner, &xCopy, ucOwnBuf );
+
+    /* The owner is still referred to by the copy. */
+    TEST_ASSERT_EQUAL( pdFALSE, xReleaseSharedNetworkBufferFromISR( &xOwner, &pxOwner ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, pxOwner );
+    TEST_ASSERT_EQUAL( 0U, xOwner.usShareCount );
+
+    /* The copy gets its own buffer back, the caller must release the owner. */
+    TEST_ASSERT_EQUAL( pdTRUE, xReleaseSharedNetworkBufferFromISR( &xCopy, &pxOwner ) );
+    TEST_ASSERT_EQUAL_PTR( &xOwner, pxOwner );
+    TEST_ASSERT_EQUAL_PTR( ucOwnBuf, xCopy.pucEthernetBuffer );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xReleaseSharedNetworkBufferFromISR( &xOwner, &pxOwner ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, pxOwner );
+}
+
+/**
+ * @brief test_pxUnshareNetworkBuffer
+ * To validate that a shared copy hands its reference over to the owner, and
+ * that a buffer that is not shared is returned as it is.
+ */
+void test_pxUnshareNetworkBuffer( void )
+{
+    NetworkBufferDescriptor_t xOwner, xCopy;
+    uint8_t ucEthBuf[ 64 ], ucOwnBuf[ 8 ];
+
+    memset( &xOwner, 0, sizeof( xOwner ) );
+    xOwner.pucEthernetBuffer = ucEthBuf;
+
+    ( void ) prvShare( &xOwner, &xCopy, ucOwnBuf );
+
+    vReleaseNetworkBufferAndDescriptor_Expect( &xCopy );
+
+    TEST_ASSERT_EQUAL_PTR( &xOwner, pxUnshareNetworkBuffer( &xCopy ) );
+    TEST_ASSERT_EQUAL_PTR( ucOwnBuf, xCopy.pucEthernetBuffer );
+    TEST_ASSERT_EQUAL_PTR( NULL, xCopy.pxSharedOwner );
+
+    /* The reference of the copy now belongs to the owner. */
+    TEST_ASSERT_EQUAL( 2U, xOwner.usShareCount );
+
+    TEST_ASSERT_EQUAL_PTR( &xOwner, pxUnshareNetworkBuffer( &xOwner ) );
+}
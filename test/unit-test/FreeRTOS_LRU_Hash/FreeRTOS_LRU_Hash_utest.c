@@ -0,0 +1,290 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+#include "FreeRTOS_LRU_Hash.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* The number of entries and buckets of the table under test. */
+#define TEST_ENTRY_COUNT     4
+#define TEST_BUCKET_COUNT    4
+
+static LRUHashLink_t xHeads[ TEST_BUCKET_COUNT ];
+static LRUHashLinks_t xLinks[ TEST_ENTRY_COUNT ];
+static LRUHashTable_t xTable = lruHASH_TABLE_INIT( xHeads, xLinks );
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    vLRUHashClear( &xTable );
+}
+
+/* ======================== Helper functions ======================== */
+
+/*
+ * @brief Take all entries into use, and touch them in the order 0, 1, 2, 3, so
+ *        that entry 3 is the most recently used one.
+ */
+static void prvTakeAllEntries( void )
+{
+    BaseType_t xEntry;
+
+    for( xEntry = 0; xEntry < TEST_ENTRY_COUNT; xEntry++ )
+    {
+        TEST_ASSERT_EQUAL( xEntry, xLRUHashTake( &xTable ) );
+        vLRUHashTouch( &xTable, xEntry );
+    }
+}
+
+/*
+ * @brief Count the entries in the hash bucket of a hash value.
+ */
+static size_t prvBucketLength( uint32_t ulHash )
+{
+    BaseType_t xEntry;
+    size_t uxCount = 0U;
+
+    for( xEntry = xLRUHashFirst( &xTable, ulHash ); xEntry >= 0; xEntry = xLRUHashNext( &xTable, xEntry ) )
+    {
+        uxCount++;
+    }
+
+    return uxCount;
+}
+
+/* ======================== Test cases ======================== */
+
+/*
+ * @brief The static initialiser sets the sizes of the arrays.
+ */
+void test_lruHASH_TABLE_INIT( void )
+{
+    TEST_ASSERT_EQUAL_PTR( xHeads, xTable.pxHeads );
+    TEST_ASSERT_EQUAL_PTR( xLinks, xTable.pxLinks );
+    TEST_ASSERT_EQUAL( TEST_BUCKET_COUNT, xTable.uxBucketCount );
+    TEST_ASSERT_EQUAL( TEST_ENTRY_COUNT, xTable.uxEntryCount );
+}
+
+/*
+ * @brief Entries that were never used are taken first, in order.
+ */
+void test_xLRUHashTake_NeverUsedEntries( void )
+{
+    prvTakeAllEntries();
+
+    TEST_ASSERT_EQUAL( TEST_ENTRY_COUNT, xTable.uxEntriesUsed );
+}
+
+/*
+ * @brief A full table gives the least recently used entry.
+ */
+void test_xLRUHashTake_LeastRecentlyUsed( void )
+{
+    prvTakeAllEntries();
+
+    TEST_ASSERT_EQUAL( 0, xLRUHashTake( &xTable ) );
+
+    /* Using entry 0 makes entry 1 the oldest. */
+    vLRUHashTouch( &xTable, 0 );
+    TEST_ASSERT_EQUAL( 1, xLRUHashTake( &xTable ) );
+
+    /* Touching the most recently used entry changes nothing. */
+    vLRUHashTouch( &xTable, 0 );
+    TEST_ASSERT_EQUAL( 1, xLRUHashTake( &xTable ) );
+}
+
+/*
+ * @brief A released entry is re-used first.
+ */
+void test_vLRUHashRelease( void )
+{
+    prvTakeAllEntries();
+
+    vLRUHashRelease( &xTable, 2 );
+    TEST_ASSERT_EQUAL( 2, xLRUHashTake( &xTable ) );
+
+    /* Releasing the oldest entry changes nothing. */
+    vLRUHashRelease( &xTable, 2 );
+    TEST_ASSERT_EQUAL( 2, xLRUHashTake( &xTable ) );
+}
+
+/*
+ * @brief Entries that were never taken are not added to the LRU list.
+ */
+void test_TouchAndRelease_NeverUsedEntry( void )
+{
+    TEST_ASSERT_EQUAL( 0, xLRUHashTake( &xTable ) );
+
+    vLRUHashTouch( &xTable, 3 );
+    vLRUHashRelease( &xTable, 2 );
+
+    TEST_ASSERT_EQUAL( 1, xTable.xLRUHead );
+    TEST_ASSERT_EQUAL( 1, xTable.xLRUTail );
+    TEST_ASSERT_EQUAL( 1, xLRUHashTake( &xTable ) );
+}
+
+/*
+ * @brief An unlinked entry is not re-used, until it is touched again.
+ */
+void test_vLRUHashUnlink( void )
+{
+    prvTakeAllEntries();
+
+    /* Unlink the tail, an entry in the middle and the head. */
+    vLRUHashUnlink( &xTable, 0 );
+    vLRUHashUnlink( &xTable, 2 );
+    vLRUHashUnlink( &xTable, 3 );
+    TEST_ASSERT_EQUAL( 1, xLRUHashTake( &xTable ) );
+
+    /* Unlinking twice is harmless. */
+    vLRUHashUnlink( &xTable, 0 );
+    TEST_ASSERT_EQUAL( 1, xLRUHashTake( &xTable ) );
+
+    vLRUHashUnlink( &xTable, 1 );
+    TEST_ASSERT_EQUAL( -1, xLRUHashTake( &xTable ) );
+
+    vLRUHashTouch( &xTable, 2 );
+    TEST_ASSERT_EQUAL( 2, xLRUHashTake( &xTable ) );
+}
+
+/*
+ * @brief The LRU list can be walked from the least to the most recently used entry.
+ */
+void test_xLRUHashOldest_WalkList( void )
+{
+    TEST_ASSERT_EQUAL( -1, xLRUHashOldest( &xTable ) );
+
+    prvTakeAllEntries();
+    vLRUHashTouch( &xTable, 1 );
+
+    TEST_ASSERT_EQUAL( 0, xLRUHashOldest( &xTable ) );
+    TEST_ASSERT_EQUAL( 2, xLRUHashNewer( &xTable, 0 ) );
+    TEST_ASSERT_EQUAL( 3, xLRUHashNewer( &xTable, 2 ) );
+    TEST_ASSERT_EQUAL( 1, xLRUHashNewer( &xTable, 3 ) );
+    TEST_ASSERT_EQUAL( -1, xLRUHashNewer( &xTable, 1 ) );
+}
+
+/*
+ * @brief Entries with the same hash are found in the same bucket.
+ */
+void test_vLRUHashInsert_SameBucket( void )
+{
+    BaseType_t xEntry;
+
+    vLRUHashInsert( &xTable, 0x12345678U, 0 );
+    vLRUHashInsert( &xTable, 0x12345678U, 2 );
+
+    /* The most recently inserted entry comes first. */
+    xEntry = xLRUHashFirst( &xTable, 0x12345678U );
+    TEST_ASSERT_EQUAL( 2, xEntry );
+    xEntry = xLRUHashNext( &xTable, xEntry );
+    TEST_ASSERT_EQUAL( 0, xEntry );
+    xEntry = xLRUHashNext( &xTable, xEntry );
+    TEST_ASSERT_EQUAL( -1, xEntry );
+}
+
+/*
+ * @brief The higher bits of the hash are folded into the bucket number.
+ */
+void test_xLRUHashFirst_FoldsHigherBits( void )
+{
+    vLRUHashInsert( &xTable, 0x00010000U, 1 );
+
+    TEST_ASSERT_EQUAL( 1, xLRUHashFirst( &xTable, 0x00000001U ) );
+    TEST_ASSERT_EQUAL( -1, xLRUHashFirst( &xTable, 0x00000002U ) );
+}
+
+/*
+ * @brief An entry can be removed from the start, the middle and the end of a bucket.
+ */
+void test_vLRUHashRemove( void )
+{
+    vLRUHashInsert( &xTable, 7U, 0 );
+    vLRUHashInsert( &xTable, 7U, 1 );
+    vLRUHashInsert( &xTable, 7U, 2 );
+    vLRUHashInsert( &xTable, 7U, 3 );
+    TEST_ASSERT_EQUAL( 4, prvBucketLength( 7U ) );
+
+    vLRUHashRemove( &xTable, 7U, 2 );
+    TEST_ASSERT_EQUAL( 3, prvBucketLength( 7U ) );
+    TEST_ASSERT_EQUAL( 3, xLRUHashFirst( &xTable, 7U ) );
+    TEST_ASSERT_EQUAL( 1, xLRUHashNext( &xTable, 3 ) );
+
+    vLRUHashRemove( &xTable, 7U, 3 );
+    vLRUHashRemove( &xTable, 7U, 0 );
+    TEST_ASSERT_EQUAL( 1, prvBucketLength( 7U ) );
+    TEST_ASSERT_EQUAL( 1, xLRUHashFirst( &xTable, 7U ) );
+    TEST_ASSERT_EQUAL( -1, xLRUHashNext( &xTable, 1 ) );
+}
+
+/*
+ * @brief Removing an entry that is not in the bucket changes nothing.
+ */
+void test_vLRUHashRemove_NotInBucket( void )
+{
+    vLRUHashInsert( &xTable, 7U, 0 );
+
+    vLRUHashRemove( &xTable, 7U, 1 );
+    vLRUHashRemove( &xTable, 5U, 0 );
+
+    TEST_ASSERT_EQUAL( 1, prvBucketLength( 7U ) );
+}
+
+/*
+ * @brief Clearing the table empties the buckets and the LRU list.
+ */
+void test_vLRUHashClear( void )
+{
+    prvTakeAllEntries();
+    vLRUHashInsert( &xTable, 7U, 0 );
+
+    vLRUHashClear( &xTable );
+
+    TEST_ASSERT_EQUAL( -1, xLRUHashFirst( &xTable, 7U ) );
+    TEST_ASSERT_EQUAL( 0, xTable.uxEntriesUsed );
+    TEST_ASSERT_EQUAL( 0, xTable.xLRUHead );
+    TEST_ASSERT_EQUAL( 0, xTable.xLRUTail );
+    TEST_ASSERT_EQUAL( 0, xLRUHashTake( &xTable ) );
+}
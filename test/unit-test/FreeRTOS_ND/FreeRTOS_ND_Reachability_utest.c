@@ -0,0 +1,543 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IPv6.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_FreeRTOS_IPv6_Utils.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_NetworkBufferManagement.h"
+
+#include "catch_assert.h"
+#include "FreeRTOS_ND_stubs.c"
+#include "FreeRTOS_ND.h"
+#include "FreeRTOS_LRU_Hash.h"
+
+/* ===========================  EXTERN VARIABLES  =========================== */
+
+/* The ND cache, its hash index and the state of the retransmission timer. */
+extern NDCacheRow_t xNDCache[ ipconfigND_CACHE_ENTRIES ];
+extern LRUHashTable_t xNDHashTable;
+extern BaseType_t xNDRetransTimerStarted;
+
+uint32_t prvNDHash( const IPv6_Address_t * pxIPAddress );
+BaseType_t prvNDFindEntry( const IPv6_Address_t * pxIPAddress );
+size_t prvLRUHashBucket( const LRUHashTable_t * pxTable,
+                         uint32_t ulHash );
+
+/* ============================  Test Constants  ============================ */
+
+/* The timing constants of RFC 4861, as used in FreeRTOS_ND.c. */
+#define testRETRANS_TIMER              ( pdMS_TO_TICKS( 1000U ) )
+#define testDELAY_FIRST_PROBE_TIME     ( pdMS_TO_TICKS( 5000U ) )
+#define testREACHABLE_TIME             ( pdMS_TO_TICKS( ipND_TIMER_PERIOD_MS ) * ( TickType_t ) ipconfigMAX_ND_AGE )
+
+/* The number of solicitations sent for an INCOMPLETE or a PROBE entry. */
+#define testMAX_SOLICIT                ( 3 )
+
+/* The time at which the tests start. */
+#define testSTART_TIME                 ( ( TickType_t ) 10000U )
+
+/* ============================  Test Variables  ============================ */
+
+/* The address of the end-point: "fe80::1234". */
+static const IPv6_Address_t xEndPointAddress =
+{
+    0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x34
+};
+
+/* The address of a neighbour: "fe80::7009". */
+static const IPv6_Address_t xNeighbourAddress =
+{
+    0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x09
+};
+
+static const MACAddress_t xEndPointMAC = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 };
+static const MACAddress_t xNeighbourMAC = { 0x22, 0x22, 0x22, 0x22, 0x22, 0x22 };
+static const MACAddress_t xOtherMAC = { 0x66, 0x66, 0x66, 0x66, 0x66, 0x66 };
+
+static NetworkEndPoint_t xEndPoint;
+
+/* The network buffer that will be used for the solicitations. */
+static uint8_t ucEthernetBuffer[ ipconfigTCP_MSS ];
+static NetworkBufferDescriptor_t xNetworkBuffer;
+
+/* The current time, as returned by xTaskGetTickCount(). */
+static TickType_t xTestTime;
+
+/* The solicitations that were sent. */
+static BaseType_t xSolicitationCount;
+static MACAddress_t xLastDestinationMAC;
+static IPv6_Address_t xLastDestinationAddress;
+static IPv6_Address_t xLastTargetAddress;
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    FreeRTOS_ClearND( NULL );
+    xNDRetransTimerStarted = pdFALSE;
+
+    memset( &( xEndPoint ), 0, sizeof( xEndPoint ) );
+    xEndPoint.bits.bIPv6 = pdTRUE_UNSIGNED;
+    memcpy( xEndPoint.ipv6_settings.xIPAddress.ucBytes, xEndPointAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+    memcpy( xEndPoint.xMACAddress.ucBytes, xEndPointMAC.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+
+    memset( ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+    memset( &( xNetworkBuffer ), 0, sizeof( xNetworkBuffer ) );
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+    xNetworkBuffer.xDataLength = sizeof( ucEthernetBuffer );
+
+    xTestTime = testSTART_TIME;
+    xSolicitationCount = 0;
+    memset( &( xLastDestinationMAC ), 0, sizeof( xLastDestinationMAC ) );
+    memset( &( xLastDestinationAddress ), 0, sizeof( xLastDestinationAddress ) );
+    memset( &( xLastTargetAddress ), 0, sizeof( xLastTargetAddress ) );
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+}
+
+/* ========================  Stub Callback Functions  ======================= */
+
+static TickType_t xTaskGetTickCount_Test( int lCallCount )
+{
+    ( void ) lCallCount;
+
+    return xTestTime;
+}
+
+static NetworkBufferDescriptor_t * pxGetNetworkBufferWithDescriptor_Test( size_t xRequestedSizeBytes,
+                                                                          TickType_t xBlockTimeTicks,
+                                                                          int lCallCount )
+{
+    ( void ) xRequestedSizeBytes;
+    ( void ) xBlockTimeTicks;
+    ( void ) lCallCount;
+
+    xNetworkBuffer.xDataLength = sizeof( ucEthernetBuffer );
+
+    return &( xNetworkBuffer );
+}
+
+static void vReturnEthernetFrame_Test( NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                       BaseType_t xReleaseAfterSend,
+                                       int lCallCount )
+{
+    const ICMPPacket_IPv6_t * pxICMPPacket = ( const ICMPPacket_IPv6_t * ) pxNetworkBuffer->pucEthernetBuffer;
+
+    ( void ) xReleaseAfterSend;
+    ( void ) lCallCount;
+
+    TEST_ASSERT_EQUAL( ipICMP_NEIGHBOR_SOLICITATION_IPv6, pxICMPPacket->xICMPHeaderIPv6.ucTypeOfMessage );
+
+    /* The source and destination MAC-address will be swapped. */
+    memcpy( xLastDestinationMAC.ucBytes, pxICMPPacket->xEthernetHeader.xSourceAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+    memcpy( xLastDestinationAddress.ucBytes, pxICMPPacket->xIPHeader.xDestinationAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+    memcpy( xLastTargetAddress.ucBytes, pxICMPPacket->xICMPHeaderIPv6.xIPv6Address.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+    xSolicitationCount++;
+}
+
+/* ============================  Helper Functions  ========================== */
+
+/*
+ * Let the kernel, the buffer allocation and the output of frames behave like
+ * in a running system.
+ */
+static void prvUseTestStubs( void )
+{
+    xTaskGetTickCount_Stub( xTaskGetTickCount_Test );
+    pxGetNetworkBufferWithDescriptor_Stub( pxGetNetworkBufferWithDescriptor_Test );
+    vReturnEthernetFrame_Stub( vReturnEthernetFrame_Test );
+    usGenerateProtocolChecksum_IgnoreAndReturn( 0U );
+}
+
+/*
+ * Return the state of the cache entry for an address, or eNDStateUnused when
+ * the address is not in the cache.
+ */
+static eNDCacheState_t prvState( const IPv6_Address_t * pxIPAddress )
+{
+    BaseType_t xEntry = prvNDFindEntry( pxIPAddress );
+    eNDCacheState_t eState = eNDStateUnused;
+
+    if( xEntry >= 0 )
+    {
+        eState = ( eNDCacheState_t ) xNDCache[ xEntry ].ucState;
+    }
+
+    return eState;
+}
+
+/*
+ * Age the cache at a given time after the start of the test. When xTimerStarts
+ * is pdTRUE, the ND timer must be restarted with RETRANS_TIMER.
+ */
+static void prvAgeCacheAt( TickType_t xTime,
+                           BaseType_t xTimerStarts )
+{
+    xTestTime = testSTART_TIME + xTime;
+
+    if( xTimerStarts != pdFALSE )
+    {
+        vNDTimerStart_Expect( testRETRANS_TIMER );
+    }
+
+    vNDAgeCache();
+}
+
+/*
+ * Let the stack ask for the resolution of an address.
+ */
+static void prvSolicit( const IPv6_Address_t * pxIPAddress )
+{
+    xNetworkBuffer.pxEndPoint = &( xEndPoint );
+    vNDSendNeighbourSolicitation( &( xNetworkBuffer ), pxIPAddress );
+}
+
+/*
+ * Look up an address that is in the cache, as the stack does before sending
+ * a packet. When xTimerStarts is pdTRUE, a STALE entry must start the ND timer.
+ */
+static void prvLookupHit( const IPv6_Address_t * pxIPAddress,
+                          const MACAddress_t * pxExpectedMAC,
+                          BaseType_t xTimerStarts )
+{
+    IPv6_Address_t xAddress;
+    MACAddress_t xMACAddress;
+    NetworkEndPoint_t * pxEndPoint = NULL;
+
+    memcpy( xAddress.ucBytes, pxIPAddress->ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+    xIsIPv6AllowedMulticast_ExpectAnyArgsAndReturn( pdFALSE );
+
+    if( xTimerStarts != pdFALSE )
+    {
+        vNDTimerStart_Expect( testRETRANS_TIMER );
+    }
+
+    TEST_ASSERT_EQUAL( eResolutionCacheHit, eNDGetCacheEntry( &( xAddress ), &( xMACAddress ), &( pxEndPoint ) ) );
+    TEST_ASSERT_EQUAL_MEMORY( pxExpectedMAC->ucBytes, xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoint ), pxEndPoint );
+}
+
+/* =============================== Test Cases =============================== */
+
+/**
+ * @brief The first solicitation for an address creates an INCOMPLETE entry and
+ *        starts the retransmission timer. While the entry is INCOMPLETE, the
+ *        stack does not send more solicitations for it.
+ */
+void test_vNDSendNeighbourSolicitation_Incomplete( void )
+{
+    prvUseTestStubs();
+    vNDTimerStart_Expect( testRETRANS_TIMER );
+
+    prvSolicit( &( xNeighbourAddress ) );
+
+    TEST_ASSERT_EQUAL( 1, xSolicitationCount );
+    TEST_ASSERT_EQUAL( eNDStateIncomplete, prvState( &( xNeighbourAddress ) ) );
+    TEST_ASSERT_EQUAL_MEMORY( xNeighbourAddress.ucBytes, xLastTargetAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+    /* A multicast solicitation: 33:33:ff:xx:xx:xx. */
+    TEST_ASSERT_EQUAL_HEX8( 0x33U, xLastDestinationMAC.ucBytes[ 0 ] );
+    TEST_ASSERT_EQUAL_HEX8( 0xffU, xLastDestinationMAC.ucBytes[ 2 ] );
+
+    /* The second request is suppressed, the buffer is released. */
+    vReleaseNetworkBufferAndDescriptor_Expect( &( xNetworkBuffer ) );
+
+    prvSolicit( &( xNeighbourAddress ) );
+
+    TEST_ASSERT_EQUAL( 1, xSolicitationCount );
+}
+
+/**
+ * @brief Solicitations for the end-point's own address detect duplicate
+ *        addresses, they do not create a cache entry.
+ */
+void test_vNDSendNeighbourSolicitation_OwnAddress( void )
+{
+    prvUseTestStubs();
+
+    prvSolicit( &( xEndPointAddress ) );
+    prvSolicit( &( xEndPointAddress ) );
+
+    TEST_ASSERT_EQUAL( 2, xSolicitationCount );
+    TEST_ASSERT_EQUAL( -1, prvNDFindEntry( &( xEndPointAddress ) ) );
+}
+
+/**
+ * @brief An INCOMPLETE entry is solicited RETRANS_TIMER apart, and removed when
+ *        MAX_MULTICAST_SOLICIT solicitations got no answer.
+ */
+void test_vNDAgeCache_Incomplete_RetransmitExhausted( void )
+{
+    prvUseTestStubs();
+    vNDTimerStart_Expect( testRETRANS_TIMER );
+
+    prvSolicit( &( xNeighbourAddress ) );
+
+    /* Too early for a retransmission, but the timer must keep running. */
+    prvAgeCacheAt( testRETRANS_TIMER - 1U, pdTRUE );
+    TEST_ASSERT_EQUAL( 1, xSolicitationCount );
+
+    prvAgeCacheAt( testRETRANS_TIMER, pdTRUE );
+    TEST_ASSERT_EQUAL( 2, xSolicitationCount );
+
+    prvAgeCacheAt( 2U * testRETRANS_TIMER, pdTRUE );
+    TEST_ASSERT_EQUAL( testMAX_SOLICIT, xSolicitationCount );
+    TEST_ASSERT_EQUAL( eNDStateIncomplete, prvState( &( xNeighbourAddress ) ) );
+
+    /* No answer to the last solicitation: the entry is removed, and the
+     * timer is no longer needed. */
+    prvAgeCacheAt( 3U * testRETRANS_TIMER, pdFALSE );
+    TEST_ASSERT_EQUAL( testMAX_SOLICIT, xSolicitationCount );
+    TEST_ASSERT_EQUAL( -1, prvNDFindEntry( &( xNeighbourAddress ) ) );
+}
+
+/**
+ * @brief An advertisement for an INCOMPLETE entry makes it REACHABLE. After
+ *        REACHABLE_TIME it becomes STALE, and stays usable without traffic.
+ */
+void test_vNDRefreshCacheEntry_ReachableToStale( void )
+{
+    prvUseTestStubs();
+    vNDTimerStart_Expect( testRETRANS_TIMER );
+
+    prvSolicit( &( xNeighbourAddress ) );
+    vNDRefreshCacheEntry( &( xNeighbourMAC ), &( xNeighbourAddress ), &( xEndPoint ) );
+
+    TEST_ASSERT_EQUAL( eNDStateReachable, prvState( &( xNeighbourAddress ) ) );
+    prvLookupHit( &( xNeighbourAddress ), &( xNeighbourMAC ), pdFALSE );
+
+    /* A REACHABLE entry does not need the retransmission timer. */
+    prvAgeCacheAt( testREACHABLE_TIME - 1U, pdFALSE );
+    TEST_ASSERT_EQUAL( eNDStateReachable, prvState( &( xNeighbourAddress ) ) );
+
+    prvAgeCacheAt( testREACHABLE_TIME, pdFALSE );
+    TEST_ASSERT_EQUAL( eNDStateStale, prvState( &( xNeighbourAddress ) ) );
+
+    /* STALE entries do not cause any traffic. */
+    prvAgeCacheAt( 2U * testREACHABLE_TIME, pdFALSE );
+    TEST_ASSERT_EQUAL( eNDStateStale, prvState( &( xNeighbourAddress ) ) );
+    TEST_ASSERT_EQUAL( 1, xSolicitationCount );
+}
+
+/**
+ * @brief An advertisement with a different MAC-address makes an entry STALE.
+ */
+void test_vNDRefreshCacheEntry_NewMAC_Stale( void )
+{
+    prvUseTestStubs();
+
+    vNDRefreshCacheEntry( &( xNeighbourMAC ), &( xNeighbourAddress ), &( xEndPoint ) );
+    TEST_ASSERT_EQUAL( eNDStateReachable, prvState( &( xNeighbourAddress ) ) );
+
+    vNDRefreshCacheEntry( &( xOtherMAC ), &( xNeighbourAddress ), &( xEndPoint ) );
+    TEST_ASSERT_EQUAL( eNDStateStale, prvState( &( xNeighbourAddress ) ) );
+
+    /* The new MAC-address is used. */
+    prvLookupHit( &( xNeighbourAddress ), &( xOtherMAC ), pdTRUE );
+}
+
+/**
+ * @brief Using a STALE entry puts it in the DELAY state. After
+ *        DELAY_FIRST_PROBE_TIME it is probed with a unicast solicitation, and
+ *        an advertisement makes it REACHABLE again.
+ */
+void test_eNDGetCacheEntry_StaleToDelayToProbe( void )
+{
+    prvUseTestStubs();
+
+    vNDRefreshCacheEntry( &( xNeighbourMAC ), &( xNeighbourAddress ), &( xEndPoint ) );
+    prvAgeCacheAt( testREACHABLE_TIME, pdFALSE );
+    TEST_ASSERT_EQUAL( eNDStateStale, prvState( &( xNeighbourAddress ) ) );
+
+    /* The lookup still succeeds, and starts the timer. */
+    prvLookupHit( &( xNeighbourAddress ), &( xNeighbourMAC ), pdTRUE );
+    TEST_ASSERT_EQUAL( eNDStateDelay, prvState( &( xNeighbourAddress ) ) );
+
+    /* A second lookup does not start the timer again. */
+    prvLookupHit( &( xNeighbourAddress ), &( xNeighbourMAC ), pdFALSE );
+
+    prvAgeCacheAt( testREACHABLE_TIME + testDELAY_FIRST_PROBE_TIME - 1U, pdTRUE );
+    TEST_ASSERT_EQUAL( eNDStateDelay, prvState( &( xNeighbourAddress ) ) );
+    TEST_ASSERT_EQUAL( 0, xSolicitationCount );
+
+    prvAgeCacheAt( testREACHABLE_TIME + testDELAY_FIRST_PROBE_TIME, pdTRUE );
+    TEST_ASSERT_EQUAL( eNDStateProbe, prvState( &( xNeighbourAddress ) ) );
+
+    /* The probe is sent directly to the cached MAC- and IP-address. */
+    TEST_ASSERT_EQUAL( 1, xSolicitationCount );
+    TEST_ASSERT_EQUAL_MEMORY( xNeighbourMAC.ucBytes, xLastDestinationMAC.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+    TEST_ASSERT_EQUAL_MEMORY( xNeighbourAddress.ucBytes, xLastDestinationAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+    /* The entry can still be used while it is probed. */
+    prvLookupHit( &( xNeighbourAddress ), &( xNeighbourMAC ), pdFALSE );
+
+    vNDRefreshCacheEntry( &( xNeighbourMAC ), &( xNeighbourAddress ), &( xEndPoint ) );
+    TEST_ASSERT_EQUAL( eNDStateReachable, prvState( &( xNeighbourAddress ) ) );
+}
+
+/**
+ * @brief A PROBE entry is removed when MAX_UNICAST_SOLICIT probes got no answer.
+ */
+void test_vNDAgeCache_Probe_RetransmitExhausted( void )
+{
+    TickType_t xProbeTime = testREACHABLE_TIME + testDELAY_FIRST_PROBE_TIME;
+
+    prvUseTestStubs();
+
+    vNDRefreshCacheEntry( &( xNeighbourMAC ), &( xNeighbourAddress ), &( xEndPoint ) );
+    prvAgeCacheAt( testREACHABLE_TIME, pdFALSE );
+    prvLookupHit( &( xNeighbourAddress ), &( xNeighbourMAC ), pdTRUE );
+
+    prvAgeCacheAt( xProbeTime, pdTRUE );
+    prvAgeCacheAt( xProbeTime + testRETRANS_TIMER, pdTRUE );
+    prvAgeCacheAt( xProbeTime + 2U * testRETRANS_TIMER, pdTRUE );
+
+    TEST_ASSERT_EQUAL( testMAX_SOLICIT, xSolicitationCount );
+    TEST_ASSERT_EQUAL( eNDStateProbe, prvState( &( xNeighbourAddress ) ) );
+
+    prvAgeCacheAt( xProbeTime + 3U * testRETRANS_TIMER, pdFALSE );
+
+    TEST_ASSERT_EQUAL( testMAX_SOLICIT, xSolicitationCount );
+    TEST_ASSERT_EQUAL( -1, prvNDFindEntry( &( xNeighbourAddress ) ) );
+}
+
+/**
+ * @brief Two addresses that fall in the same hash bucket are both found, and
+ *        removing one of them leaves the other in the bucket.
+ */
+void test_prvNDHash_Collision( void )
+{
+    IPv6_Address_t xFirst, xSecond;
+    NetworkEndPoint_t xOtherEndPoint;
+    size_t uxBucket;
+    MACAddress_t xMACAddress;
+    NetworkEndPoint_t * pxEndPoint;
+    uint8_t ucLast;
+
+    prvUseTestStubs();
+
+    /* Look for an address that falls in the same bucket as xNeighbourAddress. */
+    memcpy( xFirst.ucBytes, xNeighbourAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+    memcpy( xSecond.ucBytes, xNeighbourAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+    uxBucket = prvLRUHashBucket( &( xNDHashTable ), prvNDHash( &( xFirst ) ) );
+
+    for( ucLast = 0U; ucLast < 0xffU; ucLast++ )
+    {
+        xSecond.ucBytes[ 15 ] = ucLast;
+
+        if( ( ucLast != xFirst.ucBytes[ 15 ] ) &&
+            ( prvLRUHashBucket( &( xNDHashTable ), prvNDHash( &( xSecond ) ) ) == uxBucket ) )
+        {
+            break;
+        }
+    }
+
+    TEST_ASSERT_NOT_EQUAL( prvNDHash( &( xFirst ) ), prvNDHash( &( xSecond ) ) );
+    TEST_ASSERT_EQUAL( uxBucket, prvLRUHashBucket( &( xNDHashTable ), prvNDHash( &( xSecond ) ) ) );
+
+    memcpy( &( xOtherEndPoint ), &( xEndPoint ), sizeof( xOtherEndPoint ) );
+
+    vNDRefreshCacheEntry( &( xNeighbourMAC ), &( xFirst ), &( xOtherEndPoint ) );
+    vNDRefreshCacheEntry( &( xOtherMAC ), &( xSecond ), &( xEndPoint ) );
+
+    TEST_ASSERT_NOT_EQUAL( prvNDFindEntry( &( xFirst ) ), prvNDFindEntry( &( xSecond ) ) );
+    prvLookupHit( &( xSecond ), &( xOtherMAC ), pdFALSE );
+
+    xIsIPv6AllowedMulticast_ExpectAnyArgsAndReturn( pdFALSE );
+    TEST_ASSERT_EQUAL( eResolutionCacheHit, eNDGetCacheEntry( &( xFirst ), &( xMACAddress ), &( pxEndPoint ) ) );
+    TEST_ASSERT_EQUAL_MEMORY( xNeighbourMAC.ucBytes, xMACAddress.ucBytes, ipMAC_ADDRESS_LENGTH_BYTES );
+
+    /* Remove the entries of one end-point only. */
+    FreeRTOS_ClearND( &( xOtherEndPoint ) );
+
+    TEST_ASSERT_EQUAL( -1, prvNDFindEntry( &( xFirst ) ) );
+    prvLookupHit( &( xSecond ), &( xOtherMAC ), pdFALSE );
+}
+
+/**
+ * @brief When the cache is full, the least recently used entry is replaced.
+ */
+void test_vNDRefreshCacheEntry_Full_ReplacesLeastRecentlyUsed( void )
+{
+    IPv6_Address_t xAddresses[ ipconfigND_CACHE_ENTRIES + 1 ];
+    BaseType_t x;
+
+    prvUseTestStubs();
+
+    for( x = 0; x <= ipconfigND_CACHE_ENTRIES; x++ )
+    {
+        memcpy( xAddresses[ x ].ucBytes, xNeighbourAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+        xAddresses[ x ].ucBytes[ 15 ] = ( uint8_t ) x;
+    }
+
+    for( x = 0; x < ipconfigND_CACHE_ENTRIES; x++ )
+    {
+        vNDRefreshCacheEntry( &( xNeighbourMAC ), &( xAddresses[ x ] ), &( xEndPoint ) );
+    }
+
+    /* Use the oldest entry, the second one becomes the least recently used. */
+    prvLookupHit( &( xAddresses[ 0 ] ), &( xNeighbourMAC ), pdFALSE );
+
+    vNDRefreshCacheEntry( &( xOtherMAC ), &( xAddresses[ ipconfigND_CACHE_ENTRIES ] ), &( xEndPoint ) );
+
+    TEST_ASSERT_EQUAL( -1, prvNDFindEntry( &( xAddresses[ 1 ] ) ) );
+    prvLookupHit( &( xAddresses[ 0 ] ), &( xNeighbourMAC ), pdFALSE );
+    prvLookupHit( &( xAddresses[ ipconfigND_CACHE_ENTRIES ] ), &( xOtherMAC ), pdFALSE );
+
+    for( x = 2; x < ipconfigND_CACHE_ENTRIES; x++ )
+    {
+        TEST_ASSERT_EQUAL( eNDStateReachable, prvState( &( xAddresses[ x ] ) ) );
+    }
+}
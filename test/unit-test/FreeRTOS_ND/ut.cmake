@@ -113,3 +113,47 @@ create_test(${utest_name}
             "${utest_dep_list}"
             "${test_include_directories}"
         )
+
+# The reachability states of RFC 4861 are tested with a second build of
+# FreeRTOS_ND.c, which uses a small cache with a hash index. The definitions
+# are PUBLIC, so the tests see the same cache rows.
+set(real_name_reachability "${project_name}_Reachability_real")
+
+set(real_source_files_reachability "")
+list(APPEND real_source_files_reachability
+            ${CMAKE_BINARY_DIR}/Annexed_TCP_Sources/${project_name}.c
+            ${CMAKE_BINARY_DIR}/Annexed_TCP_Sources/FreeRTOS_LRU_Hash.c
+	)
+
+create_real_library(${real_name_reachability}
+                    "${real_source_files_reachability}"
+                    "${real_include_directories}"
+                    "${mock_name}"
+        )
+
+target_compile_definitions(${real_name_reachability} PUBLIC
+            ipconfigND_USE_REACHABILITY_STATES=1
+            ipconfigND_HASH_BUCKETS=4
+            ipconfigND_CACHE_ENTRIES=4
+        )
+
+set( utest_link_list "" )
+list(APPEND utest_link_list
+            -l${mock_name}
+            lib${real_name_reachability}.a
+        )
+
+set( utest_dep_list "" )
+list(APPEND utest_dep_list
+            ${real_name_reachability}
+        )
+
+set(utest_name "${project_name}_Reachability_utest")
+set(utest_source "${project_name}/${project_name}_Reachability_utest.c" )
+
+create_test(${utest_name}
+            ${utest_source}
+            "${utest_link_list}"
+            "${utest_dep_list}"
+            "${test_include_directories}"
+        )
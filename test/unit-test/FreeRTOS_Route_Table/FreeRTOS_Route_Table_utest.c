@@ -0,0 +1,352 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+#include "FreeRTOS_IP.h"
+#include "FreeRTOS_Routing.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+extern struct xROUTE_NODE * pxRouteRoots[ 2 ];
+extern struct xROUTE_NODE * pxFreeRouteNodes;
+extern BaseType_t xRouteNodesInitialised;
+extern UBaseType_t uxRouteCount;
+
+static NetworkEndPoint_t xEndPoints[ 3 ];
+static NetworkEndPoint_t xEndPointIPv6;
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    IP_Address_t xAddress = { 0 };
+
+    memset( xEndPoints, 0, sizeof( xEndPoints ) );
+    memset( &xEndPointIPv6, 0, sizeof( xEndPointIPv6 ) );
+    xEndPointIPv6.bits.bIPv6 = pdTRUE_UNSIGNED;
+
+    /* Start with empty tries, and a pool that will be initialised again. */
+    pxRouteRoots[ 0 ] = NULL;
+    pxRouteRoots[ 1 ] = NULL;
+    pxFreeRouteNodes = NULL;
+    xRouteNodesInitialised = pdFALSE;
+    uxRouteCount = 0U;
+
+    /* Adding and removing a route also empties the route cache. */
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AddRoute( &xAddress, 0U, NULL, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_RemoveRoute( &xAddress, 0U, ipTYPE_IPv4 ) );
+}
+
+/* ======================== Helper functions ======================== */
+
+/*
+ * @brief Add an IPv4 route, ulGateway zero means a network that is reached directly.
+ */
+static BaseType_t prvAddRoute( uint32_t ulDestination,
+                               size_t uxPrefixLength,
+                               uint32_t ulGateway,
+                               NetworkEndPoint_t * pxEndPoint )
+{
+    IP_Address_t xDestination = { 0 };
+    IP_Address_t xGateway = { 0 };
+
+    xDestination.ulIP_IPv4 = ulDestination;
+    xGateway.ulIP_IPv4 = ulGateway;
+
+    return FreeRTOS_AddRoute( &xDestination, uxPrefixLength, ( ulGateway != 0U ) ? &xGateway : NULL, pxEndPoint );
+}
+
+/*
+ * @brief Remove an IPv4 route.
+ */
+static BaseType_t prvRemoveRoute( uint32_t ulDestination,
+                                  size_t uxPrefixLength )
+{
+    IP_Address_t xDestination = { 0 };
+
+    xDestination.ulIP_IPv4 = ulDestination;
+
+    return FreeRTOS_RemoveRoute( &xDestination, uxPrefixLength, ipTYPE_IPv4 );
+}
+
+/*
+ * @brief Find the end-point of the route to an IPv4 address.
+ */
+static NetworkEndPoint_t * prvFindRoute( uint32_t ulIPAddress )
+{
+    uint32_t ulNextHop = 0U;
+
+    return FreeRTOS_FindRoute_IPv4( ulIPAddress, &ulNextHop );
+}
+
+/* ======================== Test cases ======================== */
+
+/*
+ * @brief Invalid parameters are refused.
+ */
+void test_FreeRTOS_AddRoute_RemoveRoute_InvalidParameters( void )
+{
+    IP_Address_t xAddress = { 0 };
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_AddRoute( NULL, 8U, NULL, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_AddRoute( &xAddress, 8U, NULL, NULL ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_AddRoute( &xAddress, 33U, NULL, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_AddRoute( &xAddress, 129U, NULL, &xEndPointIPv6 ) );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_RemoveRoute( NULL, 8U, ipTYPE_IPv4 ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_RemoveRoute( &xAddress, 33U, ipTYPE_IPv4 ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, FreeRTOS_RemoveRoute( &xAddress, 8U, 0 ) );
+
+    TEST_ASSERT_EQUAL( 0, uxRouteCount );
+}
+
+/*
+ * @brief The route with the longest matching prefix is found, whatever the
+ *        order in which the routes were added.
+ */
+void test_FreeRTOS_FindRoute_IPv4_LongestPrefix( void )
+{
+    uint32_t ulNextHop = 0U;
+
+    /* A longer prefix first, then a shorter one that becomes its parent. */
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 0 ), 16U, FreeRTOS_inet_addr_quick( 192, 168, 1, 1 ), &( xEndPoints[ 1 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 0, 0, 0 ), 8U, 0U, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( 0U, 0U, FreeRTOS_inet_addr_quick( 192, 168, 1, 254 ), &( xEndPoints[ 2 ] ) ) );
+    TEST_ASSERT_EQUAL( 3, uxRouteCount );
+
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 1 ] ), FreeRTOS_FindRoute_IPv4( FreeRTOS_inet_addr_quick( 10, 1, 2, 3 ), &ulNextHop ) );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_inet_addr_quick( 192, 168, 1, 1 ), ulNextHop );
+
+    /* A network that is reached directly: the next hop is the destination. */
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 0 ] ), FreeRTOS_FindRoute_IPv4( FreeRTOS_inet_addr_quick( 10, 2, 0, 1 ), &ulNextHop ) );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_inet_addr_quick( 10, 2, 0, 1 ), ulNextHop );
+
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 2 ] ), FreeRTOS_FindRoute_IPv4( FreeRTOS_inet_addr_quick( 172, 16, 0, 1 ), &ulNextHop ) );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_inet_addr_quick( 192, 168, 1, 254 ), ulNextHop );
+}
+
+/*
+ * @brief Diverging prefixes get a branching node, which is not a route itself.
+ *        A later route to the prefix of that node takes it into use.
+ */
+void test_FreeRTOS_AddRoute_BranchingNode( void )
+{
+    /* 10.1.0.0/16 and 10.2.0.0/16 branch at 10.0.0.0/14. */
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 0 ), 16U, 0U, &( xEndPoints[ 1 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 2, 0, 0 ), 16U, 0U, &( xEndPoints[ 2 ] ) ) );
+
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 1 ] ), prvFindRoute( FreeRTOS_inet_addr_quick( 10, 1, 255, 255 ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 2 ] ), prvFindRoute( FreeRTOS_inet_addr_quick( 10, 2, 0, 0 ) ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, prvFindRoute( FreeRTOS_inet_addr_quick( 10, 3, 0, 1 ) ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, prvFindRoute( FreeRTOS_inet_addr_quick( 11, 1, 0, 1 ) ) );
+
+    /* The branching node is not a route that can be removed. */
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOENT, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 0, 0, 0 ), 14U ) );
+
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 0, 0, 0 ), 14U, 0U, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 3, uxRouteCount );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 0 ] ), prvFindRoute( FreeRTOS_inet_addr_quick( 10, 3, 0, 1 ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 1 ] ), prvFindRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 1 ) ) );
+}
+
+/*
+ * @brief The bits after the prefix are ignored, and adding the same prefix
+ *        again replaces the route.
+ */
+void test_FreeRTOS_AddRoute_ReplaceRoute( void )
+{
+    uint32_t ulNextHop = 0U;
+
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 1, 2, 3 ), 16U, FreeRTOS_inet_addr_quick( 192, 168, 1, 1 ), &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 0 ), 16U, 0U, &( xEndPoints[ 1 ] ) ) );
+    TEST_ASSERT_EQUAL( 1, uxRouteCount );
+
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 1 ] ), FreeRTOS_FindRoute_IPv4( FreeRTOS_inet_addr_quick( 10, 1, 9, 9 ), &ulNextHop ) );
+    TEST_ASSERT_EQUAL_HEX32( FreeRTOS_inet_addr_quick( 10, 1, 9, 9 ), ulNextHop );
+
+    TEST_ASSERT_EQUAL( 0, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 1, 255, 255 ), 16U ) );
+    TEST_ASSERT_EQUAL( 0, uxRouteCount );
+}
+
+/*
+ * @brief A full table refuses new routes, but routes can still be replaced.
+ */
+void test_FreeRTOS_AddRoute_TableFull( void )
+{
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 0 ), 16U, 0U, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 2, 0, 0 ), 16U, 0U, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 192, 168, 0, 0 ), 16U, 0U, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 172, 16, 0, 0 ), 12U, 0U, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( ipconfigROUTE_TABLE_ENTRIES, uxRouteCount );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOBUFS, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 3, 0, 0 ), 16U, 0U, &( xEndPoints[ 1 ] ) ) );
+
+    /* The prefix of the branching node 10.0.0.0/14 would be a new route. */
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOBUFS, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 0, 0, 0 ), 14U, 0U, &( xEndPoints[ 1 ] ) ) );
+
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 2, 0, 0 ), 16U, 0U, &( xEndPoints[ 1 ] ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 1 ] ), prvFindRoute( FreeRTOS_inet_addr_quick( 10, 2, 3, 4 ) ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, prvFindRoute( FreeRTOS_inet_addr_quick( 10, 3, 3, 4 ) ) );
+}
+
+/*
+ * @brief Removing a route collapses the nodes that no longer branch, while the
+ *        routes below them are still found.
+ */
+void test_FreeRTOS_RemoveRoute_Collapse( void )
+{
+    /* 10.0.0.0/8 has a single child: the branching node 10.0.0.0/14. */
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 0, 0, 0 ), 8U, 0U, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 0 ), 16U, 0U, &( xEndPoints[ 1 ] ) ) );
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 2, 0, 0 ), 16U, 0U, &( xEndPoints[ 2 ] ) ) );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOENT, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 3, 0, 0 ), 16U ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOENT, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 0, 0, 0 ), 9U ) );
+
+    /* The branching node takes the place of the removed route. */
+    TEST_ASSERT_EQUAL( 0, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 0, 0, 0 ), 8U ) );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOENT, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 0, 0, 0 ), 8U ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 1 ] ), prvFindRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 1 ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 2 ] ), prvFindRoute( FreeRTOS_inet_addr_quick( 10, 2, 0, 1 ) ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, prvFindRoute( FreeRTOS_inet_addr_quick( 10, 3, 0, 1 ) ) );
+
+    /* The leaf is removed, and then its parent that only branched. */
+    TEST_ASSERT_EQUAL( 0, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 0 ), 16U ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, prvFindRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 1 ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 2 ] ), prvFindRoute( FreeRTOS_inet_addr_quick( 10, 2, 0, 1 ) ) );
+
+    TEST_ASSERT_EQUAL( 0, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 2, 0, 0 ), 16U ) );
+    TEST_ASSERT_EQUAL( 0, uxRouteCount );
+    TEST_ASSERT_EQUAL_PTR( NULL, pxRouteRoots[ 0 ] );
+}
+
+/*
+ * @brief Collapsed nodes are returned to the pool: filling and emptying the
+ *        table many times, in a different order, never runs out of nodes.
+ */
+void test_FreeRTOS_RemoveRoute_NodesReturnedToPool( void )
+{
+    BaseType_t xRound;
+    BaseType_t xRoute;
+
+    for( xRound = 0; xRound < 4 * ipconfigROUTE_TABLE_ENTRIES; xRound++ )
+    {
+        /* Four /24 networks that need three branching nodes. */
+        for( xRoute = 0; xRoute < ipconfigROUTE_TABLE_ENTRIES; xRoute++ )
+        {
+            TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 0, xRoute, 0 ), 24U, 0U, &( xEndPoints[ 0 ] ) ) );
+        }
+
+        for( xRoute = 0; xRoute < ipconfigROUTE_TABLE_ENTRIES; xRoute++ )
+        {
+            BaseType_t xIndex = ( xRoute + xRound ) % ipconfigROUTE_TABLE_ENTRIES;
+
+            TEST_ASSERT_EQUAL( 0, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 0, xIndex, 0 ), 24U ) );
+        }
+
+        TEST_ASSERT_EQUAL( 0, uxRouteCount );
+        TEST_ASSERT_EQUAL_PTR( NULL, pxRouteRoots[ 0 ] );
+    }
+}
+
+/*
+ * @brief The route cache is emptied when a route is added or removed.
+ */
+void test_FreeRTOS_FindRoute_IPv4_CacheEmptied( void )
+{
+    uint32_t ulAddress = FreeRTOS_inet_addr_quick( 10, 1, 2, 3 );
+
+    /* The missing route is remembered in the cache. */
+    TEST_ASSERT_EQUAL_PTR( NULL, prvFindRoute( ulAddress ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, prvFindRoute( ulAddress ) );
+
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 1, 0, 0 ), 16U, 0U, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 0 ] ), prvFindRoute( ulAddress ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 0 ] ), prvFindRoute( ulAddress ) );
+
+    TEST_ASSERT_EQUAL( 0, prvAddRoute( FreeRTOS_inet_addr_quick( 10, 1, 2, 0 ), 24U, 0U, &( xEndPoints[ 1 ] ) ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 1 ] ), prvFindRoute( ulAddress ) );
+
+    TEST_ASSERT_EQUAL( 0, prvRemoveRoute( FreeRTOS_inet_addr_quick( 10, 1, 2, 0 ), 24U ) );
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 0 ] ), prvFindRoute( ulAddress ) );
+}
+
+/*
+ * @brief IPv6 routes are kept apart from the IPv4 routes, and the next hop may
+ *        be written over the destination address.
+ */
+void test_FreeRTOS_FindRoute_IPv6( void )
+{
+    IP_Address_t xDestination = { 0 };
+    IP_Address_t xGateway = { 0 };
+    IPv6_Address_t xAddress = { { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 } };
+    IPv6_Address_t xNextHop;
+    const uint8_t ucGateway[ ipSIZE_OF_IPv6_ADDRESS ] = { 0xfe, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01 };
+
+    /* 2001:db8::/32 through a gateway, and 2001:db8:1::/48 directly. */
+    xDestination.xIP_IPv6.ucBytes[ 0 ] = 0x20;
+    xDestination.xIP_IPv6.ucBytes[ 1 ] = 0x01;
+    xDestination.xIP_IPv6.ucBytes[ 2 ] = 0x0d;
+    xDestination.xIP_IPv6.ucBytes[ 3 ] = 0xb8;
+    memcpy( xGateway.xIP_IPv6.ucBytes, ucGateway, sizeof( ucGateway ) );
+
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AddRoute( &xDestination, 32U, &xGateway, &xEndPointIPv6 ) );
+
+    xDestination.xIP_IPv6.ucBytes[ 5 ] = 0x01;
+    xEndPoints[ 0 ].bits.bIPv6 = pdTRUE_UNSIGNED;
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_AddRoute( &xDestination, 48U, NULL, &( xEndPoints[ 0 ] ) ) );
+    TEST_ASSERT_EQUAL( 2, uxRouteCount );
+
+    /* The destination itself is the next hop. */
+    TEST_ASSERT_EQUAL_PTR( &( xEndPoints[ 0 ] ), FreeRTOS_FindRoute_IPv6( &xAddress, &xNextHop ) );
+    TEST_ASSERT_EQUAL_MEMORY( xAddress.ucBytes, xNextHop.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+    /* The gateway is written over the destination. */
+    xAddress.ucBytes[ 5 ] = 0x02;
+    TEST_ASSERT_EQUAL_PTR( &xEndPointIPv6, FreeRTOS_FindRoute_IPv6( &xAddress, &xAddress ) );
+    TEST_ASSERT_EQUAL_MEMORY( ucGateway, xAddress.ucBytes, ipSIZE_OF_IPv6_ADDRESS );
+
+    TEST_ASSERT_EQUAL_PTR( NULL, prvFindRoute( FreeRTOS_inet_addr_quick( 32, 1, 13, 184 ) ) );
+}
@@ -0,0 +1,559 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_Sockets_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_portable.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_IPv4_Sockets.h"
+#include "mock_FreeRTOS_IPv6_Sockets.h"
+
+#include "FreeRTOS_Sockets.h"
+
+#include "FreeRTOS_Sockets_stubs.c"
+#include "FreeRTOS_Sockets_list_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/* The bit in the event group of an epoll set that wakes up
+ * FreeRTOS_epoll_wait(), see socketEPOLL_READY_BIT. */
+#define TEST_EPOLL_READY_BIT    ( ( EventBits_t ) 0x0001U )
+
+/* The memory of the epoll set, as returned by pvPortMalloc(). */
+static SocketEPoll_t xEPollMemory;
+
+/* A list that stands in for xBoundUDPSocketsList. */
+static List_t xBoundList;
+
+/* The last event that was sent to the IP-task, and the number of events. */
+static IPStackEvent_t xLastEvent;
+static BaseType_t xEventCount;
+
+/* The number of times that the event group of the epoll set was set. */
+static BaseType_t xSetBitsCount;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static BaseType_t xSendEventStructToIPTask_Record( const IPStackEvent_t * pxEvent,
+                                                   TickType_t uxTimeout,
+                                                   int lCallCount )
+{
+    ( void ) uxTimeout;
+    ( void ) lCallCount;
+
+    xLastEvent = *pxEvent;
+    xEventCount++;
+
+    return pdPASS;
+}
+
+static EventBits_t xEventGroupSetBits_Record( EventGroupHandle_t xEventGroup,
+                                              const EventBits_t uxBitsToSet,
+                                              int lCallCount )
+{
+    ( void ) lCallCount;
+
+    TEST_ASSERT_EQUAL_PTR( xEPollMemory.xEPollGroup, xEventGroup );
+    TEST_ASSERT_EQUAL( TEST_EPOLL_READY_BIT, uxBitsToSet );
+    xSetBitsCount++;
+
+    return uxBitsToSet;
+}
+
+/* ============================ Helper Functions ============================ */
+
+void setUp( void )
+{
+    memset( &xEPollMemory, 0x5A, sizeof( xEPollMemory ) );
+    memset( &xLastEvent, 0, sizeof( xLastEvent ) );
+    xEventCount = 0;
+    xSetBitsCount = 0;
+
+    prvUseWorkingLists();
+    vListInitialise_Working( &xBoundList, 0 );
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdFALSE );
+    xSendEventStructToIPTask_Stub( xSendEventStructToIPTask_Record );
+    xEventGroupSetBits_Stub( xEventGroupSetBits_Record );
+}
+
+/*
+ * Create an epoll set in xEPollMemory.
+ */
+static EPoll_t prvCreateEPoll( void )
+{
+    EPoll_t xEPoll;
+
+    pvPortMalloc_ExpectAndReturn( sizeof( SocketEPoll_t ), &xEPollMemory );
+    xEventGroupCreate_ExpectAndReturn( ( EventGroupHandle_t ) 0x1234 );
+
+    xEPoll = FreeRTOS_epoll_create();
+    TEST_ASSERT_EQUAL_PTR( &xEPollMemory, xEPoll );
+
+    return xEPoll;
+}
+
+/*
+ * Initialise a UDP socket and put it in the list of bound sockets.
+ */
+static void prvCreateBoundUDPSocket( FreeRTOS_Socket_t * pxSocket )
+{
+    prvInitialiseSocket( pxSocket, FREERTOS_IPPROTO_UDP );
+    vListInitialise_Working( &( pxSocket->u.xUDP.xWaitingPacketsList ), 0 );
+    vListInsertEnd_Working( &xBoundList, &( pxSocket->xBoundSocketListItem ), 0 );
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief A new epoll set has an event group and empty lists.
+ */
+void test_FreeRTOS_epoll_create_Success( void )
+{
+    ( void ) prvCreateEPoll();
+
+    TEST_ASSERT_EQUAL_PTR( ( EventGroupHandle_t ) 0x1234, xEPollMemory.xEPollGroup );
+    TEST_ASSERT_EQUAL( 0U, xEPollMemory.xReadyList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL( 0U, xEPollMemory.xMemberList.uxNumberOfItems );
+}
+
+/**
+ * @brief No epoll set is returned when its memory can not be allocated.
+ */
+void test_FreeRTOS_epoll_create_NoMemory( void )
+{
+    EPoll_t xEPoll;
+
+    pvPortMalloc_ExpectAndReturn( sizeof( SocketEPoll_t ), NULL );
+
+    xEPoll = FreeRTOS_epoll_create();
+
+    TEST_ASSERT_NULL( xEPoll );
+}
+
+/**
+ * @brief The memory is freed again when the event group can not be created.
+ */
+void test_FreeRTOS_epoll_create_NoEventGroup( void )
+{
+    EPoll_t xEPoll;
+
+    pvPortMalloc_ExpectAndReturn( sizeof( SocketEPoll_t ), &xEPollMemory );
+    xEventGroupCreate_ExpectAndReturn( NULL );
+    vPortFree_Expect( &xEPollMemory );
+
+    xEPoll = FreeRTOS_epoll_create();
+
+    TEST_ASSERT_NULL( xEPoll );
+}
+
+/**
+ * @brief Invalid parameters are refused.
+ */
+void test_FreeRTOS_epoll_ctl_InvalidParameters( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    BaseType_t xReturn;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+
+    xReturn = FreeRTOS_epoll_ctl( NULL, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ, NULL );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, FREERTOS_INVALID_SOCKET, eSELECT_READ, NULL );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, 0, &xSocket, eSELECT_READ, NULL );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    TEST_ASSERT_NULL( xSocket.pxEPoll );
+    TEST_ASSERT_EQUAL( 0, xEventCount );
+}
+
+/**
+ * @brief Adding a socket makes it a member of the set. The user task does not
+ *        look at the state of the socket, the IP-task is asked to do that.
+ */
+void test_FreeRTOS_epoll_ctl_Add( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    BaseType_t xReturn;
+    int iData;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ | eSELECT_CALL_IP, &iData );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+    TEST_ASSERT_EQUAL_PTR( xEPoll, xSocket.pxEPoll );
+    TEST_ASSERT_EQUAL_PTR( &( xEPollMemory.xMemberList ), xSocket.xEPollMemberItem.pxContainer );
+    TEST_ASSERT_EQUAL( eSELECT_READ, xSocket.xSelectBits );
+    TEST_ASSERT_EQUAL_PTR( &iData, xSocket.pvEPollData );
+    TEST_ASSERT_EQUAL( 0U, xEPollMemory.xReadyList.uxNumberOfItems );
+
+    TEST_ASSERT_EQUAL( 1, xEventCount );
+    TEST_ASSERT_EQUAL( eEPollCtlEvent, xLastEvent.eEventType );
+    TEST_ASSERT_EQUAL_PTR( &xSocket, xLastEvent.pvData );
+}
+
+/**
+ * @brief A socket can only belong to one set, and not to a socket set.
+ */
+void test_FreeRTOS_epoll_ctl_AddTwice( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    FreeRTOS_Socket_t xSelectSocket;
+    BaseType_t xReturn;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+    prvCreateBoundUDPSocket( &xSelectSocket );
+    xSelectSocket.pxSocketSet = ( SocketSelect_t * ) 0x4321;
+
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ, NULL );
+    TEST_ASSERT_EQUAL( 0, xReturn );
+
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_WRITE, NULL );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EEXIST, xReturn );
+    TEST_ASSERT_EQUAL( eSELECT_READ, xSocket.xSelectBits );
+
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSelectSocket, eSELECT_READ, NULL );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EEXIST, xReturn );
+    TEST_ASSERT_NULL( xSelectSocket.pxEPoll );
+
+    TEST_ASSERT_EQUAL( 1U, xEPollMemory.xMemberList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL( 1, xEventCount );
+}
+
+/**
+ * @brief Modifying a socket changes its events, and lets the IP-task report
+ *        the events that are active.
+ */
+void test_FreeRTOS_epoll_ctl_Modify( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    BaseType_t xReturn;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ, NULL );
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_MOD, &xSocket, eSELECT_WRITE | eSELECT_EXCEPT, &xSocket );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+    TEST_ASSERT_EQUAL( eSELECT_WRITE | eSELECT_EXCEPT, xSocket.xSelectBits );
+    TEST_ASSERT_EQUAL_PTR( &xSocket, xSocket.pvEPollData );
+    TEST_ASSERT_EQUAL( 2, xEventCount );
+    TEST_ASSERT_EQUAL( eEPollCtlEvent, xLastEvent.eEventType );
+}
+
+/**
+ * @brief Modifying or deleting a socket that is not a member fails.
+ */
+void test_FreeRTOS_epoll_ctl_NotAMember( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    BaseType_t xReturn;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_MOD, &xSocket, eSELECT_READ, NULL );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOENT, xReturn );
+
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_DEL, &xSocket, 0U, NULL );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_ENOENT, xReturn );
+
+    TEST_ASSERT_EQUAL( 0U, xSocket.xSelectBits );
+    TEST_ASSERT_EQUAL( 0, xEventCount );
+}
+
+/**
+ * @brief Deleting a socket removes it from the member list and from the
+ *        ready list, without an event to the IP-task.
+ */
+void test_FreeRTOS_epoll_ctl_Delete( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    BaseType_t xReturn;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ, &xSocket );
+    vSocketEPollReady( &xSocket, eSELECT_READ );
+    TEST_ASSERT_EQUAL( 1U, xEPollMemory.xReadyList.uxNumberOfItems );
+
+    xReturn = FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_DEL, &xSocket, 0U, NULL );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+    TEST_ASSERT_NULL( xSocket.pxEPoll );
+    TEST_ASSERT_NULL( xSocket.pvEPollData );
+    TEST_ASSERT_EQUAL( 0U, xSocket.xSelectBits );
+    TEST_ASSERT_EQUAL( 0U, xSocket.xEPollEvents );
+    TEST_ASSERT_EQUAL( 0U, xEPollMemory.xMemberList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL( 0U, xEPollMemory.xReadyList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL( 1, xEventCount );
+}
+
+/**
+ * @brief The IP-task reports the events that were already active when the
+ *        socket was added.
+ */
+void test_vSocketEPollCtl_ActiveEvents( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    ListItem_t xPacketItem;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+    vListInsertEnd_Working( &( xSocket.u.xUDP.xWaitingPacketsList ), &xPacketItem, 0 );
+
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ, NULL );
+    TEST_ASSERT_EQUAL( 0, xSetBitsCount );
+
+    vSocketEPollCtl( &xSocket );
+
+    TEST_ASSERT_EQUAL( 1U, xEPollMemory.xReadyList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL( eSELECT_READ, xSocket.xEPollEvents );
+    TEST_ASSERT_EQUAL( 1, xSetBitsCount );
+}
+
+/**
+ * @brief Nothing is reported when no event of interest is active.
+ */
+void test_vSocketEPollCtl_NoActiveEvents( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ, NULL );
+    vSocketEPollCtl( &xSocket );
+
+    TEST_ASSERT_EQUAL( 0U, xEPollMemory.xReadyList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL( 0, xSetBitsCount );
+}
+
+/**
+ * @brief A socket that was deleted from its set before the IP-task handled
+ *        the event is not reported.
+ */
+void test_vSocketEPollCtl_DeletedInTheMeantime( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    ListItem_t xPacketItem;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+    vListInsertEnd_Working( &( xSocket.u.xUDP.xWaitingPacketsList ), &xPacketItem, 0 );
+
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ, NULL );
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_DEL, &xSocket, 0U, NULL );
+    vSocketEPollCtl( &xSocket );
+
+    TEST_ASSERT_EQUAL( 0U, xEPollMemory.xReadyList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL( 0, xSetBitsCount );
+}
+
+/**
+ * @brief Only the events of interest are reported, and an event is reported
+ *        once.
+ */
+void test_FreeRTOS_epoll_wait_ReportsEvents( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    struct freertos_epoll_event xEvents[ 2 ];
+    BaseType_t xReturn;
+    int iData;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ, &iData );
+
+    vSocketEPollReady( &xSocket, eSELECT_READ | eSELECT_WRITE );
+    vSocketEPollReady( &xSocket, eSELECT_READ );
+    TEST_ASSERT_EQUAL( 1U, xEPollMemory.xReadyList.uxNumberOfItems );
+
+    vTaskSetTimeOutState_Ignore();
+    xEventGroupClearBits_IgnoreAndReturn( 0U );
+
+    xReturn = FreeRTOS_epoll_wait( xEPoll, xEvents, 2, 0U );
+
+    TEST_ASSERT_EQUAL( 1, xReturn );
+    TEST_ASSERT_EQUAL_PTR( &xSocket, xEvents[ 0 ].xSocket );
+    TEST_ASSERT_EQUAL( eSELECT_READ, xEvents[ 0 ].xEvents );
+    TEST_ASSERT_EQUAL_PTR( &iData, xEvents[ 0 ].pvData );
+    TEST_ASSERT_EQUAL( 0U, xSocket.xEPollEvents );
+    TEST_ASSERT_EQUAL( 0U, xEPollMemory.xReadyList.uxNumberOfItems );
+}
+
+/**
+ * @brief Without events, FreeRTOS_epoll_wait() returns zero after the time-out.
+ */
+void test_FreeRTOS_epoll_wait_TimeOut( void )
+{
+    EPoll_t xEPoll;
+    struct freertos_epoll_event xEvents[ 1 ];
+    BaseType_t xReturn;
+
+    xEPoll = prvCreateEPoll();
+
+    vTaskSetTimeOutState_Ignore();
+    xEventGroupClearBits_IgnoreAndReturn( 0U );
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+    xEventGroupWaitBits_ExpectAndReturn( xEPollMemory.xEPollGroup, TEST_EPOLL_READY_BIT, pdFALSE, pdFALSE, 10U, 0U );
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdTRUE );
+
+    xReturn = FreeRTOS_epoll_wait( xEPoll, xEvents, 1, 10U );
+
+    TEST_ASSERT_EQUAL( 0, xReturn );
+}
+
+/**
+ * @brief Invalid parameters are refused.
+ */
+void test_FreeRTOS_epoll_wait_InvalidParameters( void )
+{
+    EPoll_t xEPoll;
+    struct freertos_epoll_event xEvents[ 1 ];
+    BaseType_t xReturn;
+
+    xEPoll = prvCreateEPoll();
+
+    xReturn = FreeRTOS_epoll_wait( NULL, xEvents, 1, 0U );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    xReturn = FreeRTOS_epoll_wait( xEPoll, NULL, 1, 0U );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+
+    xReturn = FreeRTOS_epoll_wait( xEPoll, xEvents, 0, 0U );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xReturn );
+}
+
+/**
+ * @brief The deletion of a set is left to the IP-task.
+ */
+void test_FreeRTOS_epoll_delete_SendsEvent( void )
+{
+    EPoll_t xEPoll;
+
+    xEPoll = prvCreateEPoll();
+
+    FreeRTOS_epoll_delete( xEPoll );
+
+    TEST_ASSERT_EQUAL( 1, xEventCount );
+    TEST_ASSERT_EQUAL( eEPollDeleteEvent, xLastEvent.eEventType );
+    TEST_ASSERT_EQUAL_PTR( xEPoll, xLastEvent.pvData );
+}
+
+/**
+ * @brief The IP-task detaches all members, also the ones that are not bound,
+ *        before the set is freed.
+ */
+void test_vSocketEPollDelete_DetachesMembers( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xBoundSocket;
+    FreeRTOS_Socket_t xUnboundSocket;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xBoundSocket );
+    prvInitialiseSocket( &xUnboundSocket, FREERTOS_IPPROTO_UDP );
+
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xBoundSocket, eSELECT_READ, NULL );
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xUnboundSocket, eSELECT_READ, NULL );
+    vSocketEPollReady( &xBoundSocket, eSELECT_READ );
+
+    vEventGroupDelete_Expect( xEPollMemory.xEPollGroup );
+    vPortFree_Expect( &xEPollMemory );
+
+    vSocketEPollDelete( &xEPollMemory );
+
+    TEST_ASSERT_NULL( xBoundSocket.pxEPoll );
+    TEST_ASSERT_NULL( xUnboundSocket.pxEPoll );
+    TEST_ASSERT_NULL( xBoundSocket.xEPollListItem.pxContainer );
+    TEST_ASSERT_NULL( xBoundSocket.xEPollMemberItem.pxContainer );
+    TEST_ASSERT_NULL( xUnboundSocket.xEPollMemberItem.pxContainer );
+}
+
+/**
+ * @brief A socket that belongs to an epoll set can not be added to a socket set.
+ */
+void test_FreeRTOS_FD_SET_EPollMember( void )
+{
+    EPoll_t xEPoll;
+    FreeRTOS_Socket_t xSocket;
+    SocketSelect_t xSocketSet;
+
+    xEPoll = prvCreateEPoll();
+    prvCreateBoundUDPSocket( &xSocket );
+    ( void ) FreeRTOS_epoll_ctl( xEPoll, FREERTOS_EPOLL_CTL_ADD, &xSocket, eSELECT_READ, NULL );
+
+    catch_assert( FreeRTOS_FD_SET( &xSocket, &xSocketSet, eSELECT_WRITE ) );
+
+    TEST_ASSERT_NULL( xSocket.pxSocketSet );
+    TEST_ASSERT_EQUAL( eSELECT_READ, xSocket.xSelectBits );
+}
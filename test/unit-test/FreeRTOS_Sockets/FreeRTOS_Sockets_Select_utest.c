@@ -0,0 +1,359 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_Sockets_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_portable.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_IPv4_Sockets.h"
+#include "mock_FreeRTOS_IPv6_Sockets.h"
+
+#include "FreeRTOS_Sockets.h"
+
+#include "FreeRTOS_Sockets_stubs.c"
+#include "FreeRTOS_Sockets_list_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/* A list that stands in for xBoundUDPSocketsList. */
+static List_t xBoundList;
+
+/* The bits that vSocketSelect() has set in the event group of the set. */
+static EventBits_t xGroupBitsSet;
+
+/* The number of times that the state of a UDP socket was looked at. */
+static BaseType_t xEvaluateCount;
+
+/* ======================== Stub Callback Functions ========================= */
+
+static EventBits_t xEventGroupSetBits_Record( EventGroupHandle_t xEventGroup,
+                                              const EventBits_t uxBitsToSet,
+                                              int lCallCount )
+{
+    ( void ) xEventGroup;
+    ( void ) lCallCount;
+
+    xGroupBitsSet = uxBitsToSet;
+
+    return uxBitsToSet;
+}
+
+/*
+ * Count the evaluations of UDP sockets: prvSocketSelectEvaluate() looks at the
+ * length of xWaitingPacketsList.
+ */
+static UBaseType_t listCURRENT_LIST_LENGTH_Count( const List_t * pxList,
+                                                 int lCallCount )
+{
+    if( pxList->xListEnd.xItemValue == ( TickType_t ) 0x1234U )
+    {
+        xEvaluateCount++;
+    }
+
+    return listCURRENT_LIST_LENGTH_Working( pxList, lCallCount );
+}
+
+/* ============================ Helper Functions ============================ */
+
+void setUp( void )
+{
+    xGroupBitsSet = 0U;
+    xEvaluateCount = 0;
+
+    prvUseWorkingLists();
+    listCURRENT_LIST_LENGTH_Stub( listCURRENT_LIST_LENGTH_Count );
+    vListInitialise_Working( &xBoundList, 0 );
+
+    vTaskSuspendAll_Ignore();
+    xTaskResumeAll_IgnoreAndReturn( pdFALSE );
+    xEventGroupClearBits_IgnoreAndReturn( 0U );
+    xEventGroupSetBits_Stub( xEventGroupSetBits_Record );
+}
+
+/*
+ * Initialise a socket set with empty lists.
+ */
+static void prvInitialiseSocketSet( SocketSelect_t * pxSocketSet )
+{
+    memset( pxSocketSet, 0, sizeof( *pxSocketSet ) );
+    pxSocketSet->xSelectGroup = ( EventGroupHandle_t ) 0x4321;
+    vListInitialise_Working( &( pxSocketSet->xChangedList ), 0 );
+    vListInitialise_Working( &( pxSocketSet->xActiveList ), 0 );
+}
+
+/*
+ * Initialise a bound UDP socket that is a member of a socket set. When
+ * pxPacketItem is not NULL, a packet is waiting in the socket.
+ */
+static void prvCreateMember( FreeRTOS_Socket_t * pxSocket,
+                             SocketSelect_t * pxSocketSet,
+                             ListItem_t * pxPacketItem )
+{
+    prvInitialiseSocket( pxSocket, FREERTOS_IPPROTO_UDP );
+    vListInitialise_Working( &( pxSocket->u.xUDP.xWaitingPacketsList ), 0 );
+
+    /* Mark the list, so that its evaluations can be counted. */
+    pxSocket->u.xUDP.xWaitingPacketsList.xListEnd.xItemValue = ( TickType_t ) 0x1234U;
+
+    if( pxPacketItem != NULL )
+    {
+        vListInsertEnd_Working( &( pxSocket->u.xUDP.xWaitingPacketsList ), pxPacketItem, 0 );
+    }
+
+    vListInsertEnd_Working( &xBoundList, &( pxSocket->xBoundSocketListItem ), 0 );
+    pxSocket->pxSocketSet = pxSocketSet;
+    pxSocket->xSelectBits = ( EventBits_t ) eSELECT_READ;
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief A socket that is not a member of a set is not put in any list.
+ */
+void test_vSocketSelectChanged_NotAMember( void )
+{
+    FreeRTOS_Socket_t xSocket;
+
+    prvInitialiseSocket( &xSocket, FREERTOS_IPPROTO_UDP );
+
+    vSocketSelectChanged( &xSocket );
+
+    TEST_ASSERT_NULL( xSocket.xSelectListItem.pxContainer );
+}
+
+/**
+ * @brief A changed socket is put in the list of changed sockets only once.
+ */
+void test_vSocketSelectChanged_AddedOnce( void )
+{
+    SocketSelect_t xSocketSet;
+    FreeRTOS_Socket_t xSocket;
+
+    prvInitialiseSocketSet( &xSocketSet );
+    prvCreateMember( &xSocket, &xSocketSet, NULL );
+
+    vSocketSelectChanged( &xSocket );
+    vSocketSelectChanged( &xSocket );
+
+    TEST_ASSERT_EQUAL_PTR( &( xSocketSet.xChangedList ), xSocket.xSelectListItem.pxContainer );
+    TEST_ASSERT_EQUAL( 1U, xSocketSet.xChangedList.uxNumberOfItems );
+}
+
+/**
+ * @brief An active socket will be evaluated anyway, it stays in the active list.
+ */
+void test_vSocketSelectChanged_ActiveSocket( void )
+{
+    SocketSelect_t xSocketSet;
+    FreeRTOS_Socket_t xSocket;
+
+    prvInitialiseSocketSet( &xSocketSet );
+    prvCreateMember( &xSocket, &xSocketSet, NULL );
+    vListInsertEnd_Working( &( xSocketSet.xActiveList ), &( xSocket.xSelectListItem ), 0 );
+
+    vSocketSelectChanged( &xSocket );
+
+    TEST_ASSERT_EQUAL_PTR( &( xSocketSet.xActiveList ), xSocket.xSelectListItem.pxContainer );
+    TEST_ASSERT_EQUAL( 0U, xSocketSet.xChangedList.uxNumberOfItems );
+}
+
+/**
+ * @brief A socket that moved to another set leaves the lists of the old set.
+ */
+void test_vSocketSelectChanged_MovedToOtherSet( void )
+{
+    SocketSelect_t xOldSet;
+    SocketSelect_t xNewSet;
+    FreeRTOS_Socket_t xSocket;
+
+    prvInitialiseSocketSet( &xOldSet );
+    prvInitialiseSocketSet( &xNewSet );
+    prvCreateMember( &xSocket, &xOldSet, NULL );
+    vListInsertEnd_Working( &( xOldSet.xActiveList ), &( xSocket.xSelectListItem ), 0 );
+
+    xSocket.pxSocketSet = &xNewSet;
+    vSocketSelectChanged( &xSocket );
+
+    TEST_ASSERT_EQUAL( 0U, xOldSet.xActiveList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL_PTR( &( xNewSet.xChangedList ), xSocket.xSelectListItem.pxContainer );
+}
+
+/**
+ * @brief Only the sockets that have changed are evaluated. A socket with a
+ *        waiting packet that did not change is not looked at.
+ */
+void test_vSocketSelect_OnlyChangedSocketsAreEvaluated( void )
+{
+    SocketSelect_t xSocketSet;
+    FreeRTOS_Socket_t xChanged;
+    FreeRTOS_Socket_t xUnchanged;
+    FreeRTOS_Socket_t xIdle;
+    ListItem_t xPacket1;
+    ListItem_t xPacket2;
+
+    prvInitialiseSocketSet( &xSocketSet );
+    prvCreateMember( &xChanged, &xSocketSet, &xPacket1 );
+    prvCreateMember( &xUnchanged, &xSocketSet, &xPacket2 );
+    prvCreateMember( &xIdle, &xSocketSet, NULL );
+
+    vSocketSelectChanged( &xChanged );
+    vSocketSelectChanged( &xIdle );
+
+    vSocketSelect( &xSocketSet );
+
+    TEST_ASSERT_EQUAL( 2, xEvaluateCount );
+    TEST_ASSERT_EQUAL( eSELECT_READ, xChanged.xSocketBits );
+    TEST_ASSERT_EQUAL( 0U, xUnchanged.xSocketBits );
+    TEST_ASSERT_EQUAL( 0U, xIdle.xSocketBits );
+    TEST_ASSERT_EQUAL( eSELECT_READ | eSELECT_CALL_IP, xGroupBitsSet );
+
+    /* Only the socket with an event is kept for the next evaluation. */
+    TEST_ASSERT_EQUAL( 0U, xSocketSet.xChangedList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL_PTR( &( xSocketSet.xActiveList ), xChanged.xSelectListItem.pxContainer );
+    TEST_ASSERT_NULL( xIdle.xSelectListItem.pxContainer );
+}
+
+/**
+ * @brief An active socket is evaluated again, and it leaves the active list
+ *        once its event has been consumed.
+ */
+void test_vSocketSelect_ActiveSocketIsEvaluatedAgain( void )
+{
+    SocketSelect_t xSocketSet;
+    FreeRTOS_Socket_t xSocket;
+    ListItem_t xPacket;
+
+    prvInitialiseSocketSet( &xSocketSet );
+    prvCreateMember( &xSocket, &xSocketSet, &xPacket );
+
+    vSocketSelectChanged( &xSocket );
+    vSocketSelect( &xSocketSet );
+    TEST_ASSERT_EQUAL_PTR( &( xSocketSet.xActiveList ), xSocket.xSelectListItem.pxContainer );
+
+    /* The user reads the packet. */
+    ( void ) uxListRemove_Working( &xPacket, 0 );
+    xEvaluateCount = 0;
+
+    vSocketSelect( &xSocketSet );
+
+    TEST_ASSERT_EQUAL( 1, xEvaluateCount );
+    TEST_ASSERT_EQUAL( 0U, xSocket.xSocketBits );
+    TEST_ASSERT_NULL( xSocket.xSelectListItem.pxContainer );
+    TEST_ASSERT_EQUAL( eSELECT_CALL_IP, xGroupBitsSet );
+}
+
+/**
+ * @brief A socket that is not bound can not have events.
+ */
+void test_vSocketSelect_UnboundSocket( void )
+{
+    SocketSelect_t xSocketSet;
+    FreeRTOS_Socket_t xSocket;
+    ListItem_t xPacket;
+
+    prvInitialiseSocketSet( &xSocketSet );
+    prvCreateMember( &xSocket, &xSocketSet, &xPacket );
+    ( void ) uxListRemove_Working( &( xSocket.xBoundSocketListItem ), 0 );
+
+    vSocketSelectChanged( &xSocket );
+    vSocketSelect( &xSocketSet );
+
+    TEST_ASSERT_EQUAL( 0, xEvaluateCount );
+    TEST_ASSERT_EQUAL( 0U, xSocket.xSocketBits );
+    TEST_ASSERT_NULL( xSocket.xSelectListItem.pxContainer );
+}
+
+/**
+ * @brief FreeRTOS_FD_CLR() unlinks a socket that leaves its set.
+ */
+void test_FreeRTOS_FD_CLR_UnlinksSocket( void )
+{
+    SocketSelect_t xSocketSet;
+    FreeRTOS_Socket_t xSocket;
+
+    prvInitialiseSocketSet( &xSocketSet );
+    prvCreateMember( &xSocket, &xSocketSet, NULL );
+    vSocketSelectChanged( &xSocket );
+
+    FreeRTOS_FD_CLR( &xSocket, &xSocketSet, eSELECT_ALL );
+
+    TEST_ASSERT_NULL( xSocket.pxSocketSet );
+    TEST_ASSERT_NULL( xSocket.xSelectListItem.pxContainer );
+    TEST_ASSERT_EQUAL( 0U, xSocketSet.xChangedList.uxNumberOfItems );
+}
+
+/**
+ * @brief All sockets are unlinked from a socket set that is being deleted.
+ */
+void test_vSocketSelectRemoveAll_UnlinksSockets( void )
+{
+    SocketSelect_t xSocketSet;
+    FreeRTOS_Socket_t xActive;
+    FreeRTOS_Socket_t xChanged;
+    ListItem_t xPacket;
+
+    prvInitialiseSocketSet( &xSocketSet );
+    prvCreateMember( &xActive, &xSocketSet, &xPacket );
+    prvCreateMember( &xChanged, &xSocketSet, NULL );
+
+    vSocketSelectChanged( &xActive );
+    vSocketSelect( &xSocketSet );
+    vSocketSelectChanged( &xChanged );
+    TEST_ASSERT_EQUAL( 1U, xSocketSet.xActiveList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL( 1U, xSocketSet.xChangedList.uxNumberOfItems );
+
+    vSocketSelectRemoveAll( &xSocketSet );
+
+    TEST_ASSERT_EQUAL( 0U, xSocketSet.xActiveList.uxNumberOfItems );
+    TEST_ASSERT_EQUAL( 0U, xSocketSet.xChangedList.uxNumberOfItems );
+    TEST_ASSERT_NULL( xActive.xSelectListItem.pxContainer );
+    TEST_ASSERT_NULL( xChanged.xSelectListItem.pxContainer );
+}
@@ -0,0 +1,188 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+/*
+ * The epoll and select tests follow sockets as they move between several
+ * lists.  Instead of expecting every single list operation, the mocked list
+ * functions are replaced by the working implementations below.
+ */
+
+/* ======================== Stub Callback Functions ========================= */
+
+static void vListInitialise_Working( List_t * const pxList,
+                                     int lCallCount )
+{
+    ListItem_t * pxEnd = ( ListItem_t * ) &( pxList->xListEnd );
+
+    ( void ) lCallCount;
+
+    pxList->pxIndex = pxEnd;
+    pxList->xListEnd.xItemValue = portMAX_DELAY;
+    pxList->xListEnd.pxNext = pxEnd;
+    pxList->xListEnd.pxPrevious = pxEnd;
+    pxList->uxNumberOfItems = 0U;
+}
+
+static void vListInsertEnd_Working( List_t * const pxList,
+                                    ListItem_t * const pxNewListItem,
+                                    int lCallCount )
+{
+    ListItem_t * pxEnd = ( ListItem_t * ) &( pxList->xListEnd );
+
+    ( void ) lCallCount;
+
+    pxNewListItem->pxNext = pxEnd;
+    pxNewListItem->pxPrevious = pxEnd->pxPrevious;
+    pxEnd->pxPrevious->pxNext = pxNewListItem;
+    pxEnd->pxPrevious = pxNewListItem;
+    pxNewListItem->pxContainer = pxList;
+    pxList->uxNumberOfItems++;
+}
+
+static UBaseType_t uxListRemove_Working( ListItem_t * const pxItemToRemove,
+                                         int lCallCount )
+{
+    List_t * pxList = pxItemToRemove->pxContainer;
+
+    ( void ) lCallCount;
+
+    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
+    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+    pxItemToRemove->pxContainer = NULL;
+    pxList->uxNumberOfItems--;
+
+    return pxList->uxNumberOfItems;
+}
+
+static UBaseType_t listCURRENT_LIST_LENGTH_Working( const List_t * pxList,
+                                                   int lCallCount )
+{
+    ( void ) lCallCount;
+
+    return pxList->uxNumberOfItems;
+}
+
+static void * listGET_OWNER_OF_HEAD_ENTRY_Working( const List_t * pxList,
+                                                   int lCallCount )
+{
+    ( void ) lCallCount;
+
+    return pxList->xListEnd.pxNext->pvOwner;
+}
+
+static ListItem_t * listGET_HEAD_ENTRY_Working( const List_t * pxList,
+                                                int lCallCount )
+{
+    ( void ) lCallCount;
+
+    return pxList->xListEnd.pxNext;
+}
+
+static ListItem_t * listGET_END_MARKER_Working( List_t * pxList,
+                                                int lCallCount )
+{
+    ( void ) lCallCount;
+
+    return ( ListItem_t * ) &( pxList->xListEnd );
+}
+
+static ListItem_t * listGET_NEXT_Working( const ListItem_t * pxListItem,
+                                          int lCallCount )
+{
+    ( void ) lCallCount;
+
+    return pxListItem->pxNext;
+}
+
+static void * listGET_LIST_ITEM_OWNER_Working( const ListItem_t * pxListItem,
+                                               int lCallCount )
+{
+    ( void ) lCallCount;
+
+    return pxListItem->pvOwner;
+}
+
+static BaseType_t listIS_CONTAINED_WITHIN_Working( List_t * pxList,
+                                                   const ListItem_t * pxListItem,
+                                                   int lCallCount )
+{
+    ( void ) lCallCount;
+
+    return ( pxListItem->pxContainer == pxList ) ? pdTRUE : pdFALSE;
+}
+
+static List_t * listLIST_ITEM_CONTAINER_Working( const ListItem_t * pxListItem,
+                                                 int lCallCount )
+{
+    ( void ) lCallCount;
+
+    return pxListItem->pxContainer;
+}
+
+/* ============================ Helper Functions ============================ */
+
+/*
+ * Let all list functions behave like the real ones.
+ */
+static void prvUseWorkingLists( void )
+{
+    vListInitialise_Stub( vListInitialise_Working );
+    vListInsertEnd_Stub( vListInsertEnd_Working );
+    uxListRemove_Stub( uxListRemove_Working );
+    listCURRENT_LIST_LENGTH_Stub( listCURRENT_LIST_LENGTH_Working );
+    listGET_OWNER_OF_HEAD_ENTRY_Stub( listGET_OWNER_OF_HEAD_ENTRY_Working );
+    listGET_HEAD_ENTRY_Stub( listGET_HEAD_ENTRY_Working );
+    listGET_END_MARKER_Stub( listGET_END_MARKER_Working );
+    listGET_NEXT_Stub( listGET_NEXT_Working );
+    listGET_LIST_ITEM_OWNER_Stub( listGET_LIST_ITEM_OWNER_Working );
+    listIS_CONTAINED_WITHIN_Stub( listIS_CONTAINED_WITHIN_Working );
+    listLIST_ITEM_CONTAINER_Stub( listLIST_ITEM_CONTAINER_Working );
+}
+
+/*
+ * Initialise the list items of a socket, as vListInitialiseItem() would do.
+ */
+static void prvInitialiseSocket( FreeRTOS_Socket_t * pxSocket,
+                                 uint8_t ucProtocol )
+{
+    memset( pxSocket, 0, sizeof( *pxSocket ) );
+    pxSocket->ucProtocol = ucProtocol;
+    pxSocket->xBoundSocketListItem.pvOwner = pxSocket;
+
+    #if ( ipconfigIS_ENABLED( ipconfigSELECT_INCREMENTAL ) )
+    {
+        pxSocket->xSelectListItem.pvOwner = pxSocket;
+    }
+    #endif
+
+    #if ( ipconfigIS_ENABLED( ipconfigSUPPORT_EPOLL ) )
+    {
+        pxSocket->xEPollListItem.pvOwner = pxSocket;
+        pxSocket->xEPollMemberItem.pvOwner = pxSocket;
+    }
+    #endif
+}
@@ -155,3 +155,51 @@ create_test(${utest_name}
             "${utest_dep_list}"
             "${test_include_directories}"
         )
+
+# The epoll API and the incremental select() are tested with a second build of
+# FreeRTOS_Sockets.c in which ipconfigSUPPORT_EPOLL and ipconfigSELECT_INCREMENTAL
+# are enabled. The definitions are PUBLIC, so the tests see the same socket
+# structure.
+set(real_name_select "${project_name}_Select_real")
+
+create_real_library(${real_name_select}
+                    "${real_source_files}"
+                    "${real_include_directories}"
+                    "${mock_name}"
+        )
+
+target_compile_definitions(${real_name_select} PUBLIC
+            ipconfigSUPPORT_EPOLL=1
+            ipconfigSELECT_INCREMENTAL=1
+        )
+
+set( utest_link_list "" )
+list(APPEND utest_link_list
+            -l${mock_name}
+            lib${real_name_select}.a
+        )
+
+set( utest_dep_list "" )
+list(APPEND utest_dep_list
+            ${real_name_select}
+        )
+
+set(utest_name "${project_name}_EPoll_utest")
+set(utest_source "${project_name}/${project_name}_EPoll_utest.c" )
+
+create_test(${utest_name}
+            ${utest_source}
+            "${utest_link_list}"
+            "${utest_dep_list}"
+            "${test_include_directories}"
+        )
+
+set(utest_name "${project_name}_Select_utest")
+set(utest_source "${project_name}/${project_name}_Select_utest.c" )
+
+create_test(${utest_name}
+            ${utest_source}
+            "${utest_link_list}"
+            "${utest_dep_list}"
+            "${test_include_directories}"
+        )
@@ -0,0 +1,445 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_Sockets_MMSG_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_portable.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_IPv4_Sockets.h"
+#include "mock_FreeRTOS_IPv6_Sockets.h"
+
+#include "FreeRTOS_Sockets.h"
+
+#include "FreeRTOS_Sockets_MMSG_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+/* The number of messages passed in each call. */
+#define TEST_MESSAGE_COUNT    3U
+
+/* A value that FreeRTOS_recvmmsg() and FreeRTOS_sendmmsg() must overwrite. */
+#define TEST_GARBAGE          0x5A5A5A5A
+
+static struct freertos_mmsghdr xMessages[ TEST_MESSAGE_COUNT ];
+
+/* ============================ Helper Functions ============================ */
+
+/*
+ * Fill all messages with garbage, so that the tests can check that every
+ * message gets a defined result.
+ */
+static void prvFillMessagesWithGarbage( void )
+{
+    size_t uxIndex;
+
+    memset( xMessages, 0x5A, sizeof( xMessages ) );
+
+    for( uxIndex = 0U; uxIndex < TEST_MESSAGE_COUNT; uxIndex++ )
+    {
+        xMessages[ uxIndex ].lLength = TEST_GARBAGE;
+        xMessages[ uxIndex ].xAddressLength = TEST_GARBAGE;
+    }
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief Invalid parameters are refused without touching the messages.
+ */
+void test_FreeRTOS_recvmmsg_InvalidParameters( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+
+    prvFillMessagesWithGarbage();
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    lReturn = FreeRTOS_recvmmsg( &xSocket, NULL, TEST_MESSAGE_COUNT, 0 );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, lReturn );
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    lReturn = FreeRTOS_recvmmsg( &xSocket, xMessages, TEST_MESSAGE_COUNT, FREERTOS_MSG_PEEK );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, lReturn );
+    TEST_ASSERT_EQUAL( TEST_GARBAGE, xMessages[ 0 ].lLength );
+}
+
+/**
+ * @brief Nothing was received: every message reports a length of zero.
+ */
+void test_FreeRTOS_recvmmsg_NothingReceived( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+    size_t uxIndex;
+
+    prvFillMessagesWithGarbage();
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    listCURRENT_LIST_LENGTH_ExpectAndReturn( &( xSocket.u.xUDP.xWaitingPacketsList ), 0 );
+    xEventGroupWaitBits_ExpectAndReturn( xSocket.xEventGroup, ( EventBits_t ) eSOCKET_INTR, pdTRUE, pdFALSE, 0, 0 );
+
+    lReturn = FreeRTOS_recvmmsg( &xSocket, xMessages, TEST_MESSAGE_COUNT, FREERTOS_MSG_DONTWAIT );
+
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EWOULDBLOCK, lReturn );
+
+    for( uxIndex = 0U; uxIndex < TEST_MESSAGE_COUNT; uxIndex++ )
+    {
+        TEST_ASSERT_EQUAL( 0, xMessages[ uxIndex ].lLength );
+        TEST_ASSERT_EQUAL( 0, xMessages[ uxIndex ].xAddressLength );
+    }
+}
+
+/**
+ * @brief One packet is received while three messages are offered: the unused
+ *        messages report a length of zero.
+ */
+void test_FreeRTOS_recvmmsg_OnePacketThreeMessages( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+    NetworkBufferDescriptor_t xNetworkBuffer = { 0 };
+    uint8_t ucEthernetBuffer[ ipconfigTCP_MSS ];
+    uint8_t ucUserBuffer[ ipconfigTCP_MSS ];
+    size_t uxIndex;
+
+    prvFillMessagesWithGarbage();
+    memset( ucEthernetBuffer, 0x12, sizeof( ucEthernetBuffer ) );
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+    xNetworkBuffer.xDataLength = ipUDP_PAYLOAD_OFFSET_IPv4 + 100U;
+
+    for( uxIndex = 0U; uxIndex < TEST_MESSAGE_COUNT; uxIndex++ )
+    {
+        xMessages[ uxIndex ].pvBuffer = ucUserBuffer;
+        xMessages[ uxIndex ].uxBufferLength = sizeof( ucUserBuffer );
+    }
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    listCURRENT_LIST_LENGTH_ExpectAndReturn( &( xSocket.u.xUDP.xWaitingPacketsList ), 1 );
+
+    vTaskSuspendAll_Expect();
+    listGET_OWNER_OF_HEAD_ENTRY_ExpectAndReturn( &( xSocket.u.xUDP.xWaitingPacketsList ), &xNetworkBuffer );
+    uxListRemove_ExpectAndReturn( &( xNetworkBuffer.xBufferListItem ), 0 );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    /* No other packets are queued. */
+    vTaskSuspendAll_Expect();
+    listCURRENT_LIST_LENGTH_ExpectAndReturn( &( xSocket.u.xUDP.xWaitingPacketsList ), 0 );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    uxIPHeaderSizePacket_IgnoreAndReturn( ipSIZE_OF_IPv4_HEADER );
+    xRecv_Update_IPv4_ExpectAndReturn( &xNetworkBuffer, &( xMessages[ 0 ].xAddress ), ipUDP_PAYLOAD_OFFSET_IPv4 );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xNetworkBuffer );
+
+    lReturn = FreeRTOS_recvmmsg( &xSocket, xMessages, TEST_MESSAGE_COUNT, 0 );
+
+    TEST_ASSERT_EQUAL( 1, lReturn );
+    TEST_ASSERT_EQUAL( 100, xMessages[ 0 ].lLength );
+    TEST_ASSERT_EQUAL( sizeof( struct freertos_sockaddr ), xMessages[ 0 ].xAddressLength );
+
+    for( uxIndex = 1U; uxIndex < TEST_MESSAGE_COUNT; uxIndex++ )
+    {
+        TEST_ASSERT_EQUAL( 0, xMessages[ uxIndex ].lLength );
+        TEST_ASSERT_EQUAL( 0, xMessages[ uxIndex ].xAddressLength );
+    }
+}
+
+/**
+ * @brief A packet with an unknown IP header: the message reports the error
+ *        and no address.
+ */
+void test_FreeRTOS_recvmmsg_UnknownHeader( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+    NetworkBufferDescriptor_t xNetworkBuffer = { 0 };
+    uint8_t ucEthernetBuffer[ ipconfigTCP_MSS ];
+
+    prvFillMessagesWithGarbage();
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    listCURRENT_LIST_LENGTH_ExpectAndReturn( &( xSocket.u.xUDP.xWaitingPacketsList ), 1 );
+
+    vTaskSuspendAll_Expect();
+    listGET_OWNER_OF_HEAD_ENTRY_ExpectAndReturn( &( xSocket.u.xUDP.xWaitingPacketsList ), &xNetworkBuffer );
+    uxListRemove_ExpectAndReturn( &( xNetworkBuffer.xBufferListItem ), 0 );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    vTaskSuspendAll_Expect();
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    uxIPHeaderSizePacket_IgnoreAndReturn( 0U );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xNetworkBuffer );
+
+    lReturn = FreeRTOS_recvmmsg( &xSocket, xMessages, 1U, 0 );
+
+    TEST_ASSERT_EQUAL( 1, lReturn );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, xMessages[ 0 ].lLength );
+    TEST_ASSERT_EQUAL( 0, xMessages[ 0 ].xAddressLength );
+    TEST_ASSERT_EQUAL( TEST_GARBAGE, xMessages[ 1 ].lLength );
+}
+
+/**
+ * @brief Invalid parameters are refused.
+ */
+void test_FreeRTOS_sendmmsg_InvalidParameters( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+
+    lReturn = FreeRTOS_sendmmsg( &xSocket, NULL, TEST_MESSAGE_COUNT, 0 );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, lReturn );
+
+    lReturn = FreeRTOS_sendmmsg( &xSocket, xMessages, 0U, 0 );
+    TEST_ASSERT_EQUAL( -pdFREERTOS_ERRNO_EINVAL, lReturn );
+}
+
+/**
+ * @brief The second message is too long: only the first one is sent, and the
+ *        other messages report a length of zero.
+ */
+void test_FreeRTOS_sendmmsg_SecondMessageTooLong( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+    NetworkBufferDescriptor_t xNetworkBuffer = { 0 };
+    uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+    uint8_t ucPayload[ ipconfigNETWORK_MTU ];
+    size_t uxIndex;
+
+    prvFillMessagesWithGarbage();
+    memset( ucPayload, 0x34, sizeof( ucPayload ) );
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+
+    for( uxIndex = 0U; uxIndex < TEST_MESSAGE_COUNT; uxIndex++ )
+    {
+        xMessages[ uxIndex ].pvBuffer = ucPayload;
+        xMessages[ uxIndex ].uxBufferLength = 100U;
+        xMessages[ uxIndex ].xAddress.sin_family = FREERTOS_AF_INET4;
+    }
+
+    xMessages[ 1 ].uxBufferLength = ipconfigNETWORK_MTU;
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    vTaskSetTimeOutState_ExpectAnyArgs();
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( ipUDP_PAYLOAD_OFFSET_IPv4 + 100U, 0U, &xNetworkBuffer );
+    xSend_UDP_Update_IPv4_ExpectAndReturn( &xNetworkBuffer, &( xMessages[ 0 ].xAddress ), 0 );
+    listGET_LIST_ITEM_VALUE_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), 0x1234 );
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+    xSendEventStructToIPTask_ExpectAnyArgsAndReturn( pdPASS );
+
+    lReturn = FreeRTOS_sendmmsg( &xSocket, xMessages, TEST_MESSAGE_COUNT, FREERTOS_MSG_DONTWAIT );
+
+    TEST_ASSERT_EQUAL( 1, lReturn );
+    TEST_ASSERT_EQUAL( 100, xMessages[ 0 ].lLength );
+    TEST_ASSERT_EQUAL( 0, xMessages[ 1 ].lLength );
+    TEST_ASSERT_EQUAL( 0, xMessages[ 2 ].lLength );
+    TEST_ASSERT_EQUAL_MEMORY( ucPayload, &( ucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET_IPv4 ] ), 100U );
+}
+
+/**
+ * @brief The IP-task can not be reached: the buffers are released and every
+ *        message reports a length of zero.
+ */
+void test_FreeRTOS_sendmmsg_EventNotSent( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+    NetworkBufferDescriptor_t xNetworkBuffer = { 0 };
+    uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+    uint8_t ucPayload[ 100 ];
+
+    prvFillMessagesWithGarbage();
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+
+    xMessages[ 0 ].pvBuffer = ucPayload;
+    xMessages[ 0 ].uxBufferLength = sizeof( ucPayload );
+    xMessages[ 0 ].xAddress.sin_family = FREERTOS_AF_INET4;
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    vTaskSetTimeOutState_ExpectAnyArgs();
+    pxGetNetworkBufferWithDescriptor_ExpectAndReturn( ipUDP_PAYLOAD_OFFSET_IPv4 + sizeof( ucPayload ), 0U, &xNetworkBuffer );
+    xSend_UDP_Update_IPv4_ExpectAndReturn( &xNetworkBuffer, &( xMessages[ 0 ].xAddress ), 0 );
+    listGET_LIST_ITEM_VALUE_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), 0x1234 );
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+
+    /* The second message has an unknown family. */
+    xMessages[ 1 ].xAddress.sin_family = 0U;
+
+    xSendEventStructToIPTask_ExpectAnyArgsAndReturn( pdFAIL );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xNetworkBuffer );
+
+    lReturn = FreeRTOS_sendmmsg( &xSocket, xMessages, TEST_MESSAGE_COUNT, FREERTOS_MSG_DONTWAIT );
+
+    TEST_ASSERT_EQUAL( 0, lReturn );
+    TEST_ASSERT_EQUAL( 0, xMessages[ 0 ].lLength );
+    TEST_ASSERT_EQUAL( 0, xMessages[ 1 ].lLength );
+    TEST_ASSERT_EQUAL( 0, xMessages[ 2 ].lLength );
+}
+
+/**
+ * @brief A zero-copy payload that was received on a shared port is not sent,
+ *        it remains owned by the caller.  The messages before it are sent.
+ */
+void test_FreeRTOS_sendmmsg_SharedZeroCopyBuffer( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+    NetworkBufferDescriptor_t xNetworkBuffer = { 0 };
+    NetworkBufferDescriptor_t xSharedBuffer = { 0 };
+    uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+    uint8_t ucSharedEthernetBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+
+    prvFillMessagesWithGarbage();
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+    xSharedBuffer.pucEthernetBuffer = ucSharedEthernetBuffer;
+    xSharedBuffer.usShareCount = 2U;
+
+    xMessages[ 0 ].pvBuffer = &( ucEthernetBuffer[ ipUDP_PAYLOAD_OFFSET_IPv4 ] );
+    xMessages[ 0 ].uxBufferLength = 100U;
+    xMessages[ 0 ].xAddress.sin_family = FREERTOS_AF_INET4;
+    xMessages[ 1 ].pvBuffer = &( ucSharedEthernetBuffer[ ipUDP_PAYLOAD_OFFSET_IPv4 ] );
+    xMessages[ 1 ].uxBufferLength = 100U;
+    xMessages[ 1 ].xAddress.sin_family = FREERTOS_AF_INET4;
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    vTaskSetTimeOutState_ExpectAnyArgs();
+    pxUDPPayloadBuffer_to_NetworkBuffer_ExpectAndReturn( xMessages[ 0 ].pvBuffer, &xNetworkBuffer );
+    xSend_UDP_Update_IPv4_ExpectAndReturn( &xNetworkBuffer, &( xMessages[ 0 ].xAddress ), 0 );
+    listGET_LIST_ITEM_VALUE_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), 0x1234 );
+    xTaskCheckForTimeOut_ExpectAnyArgsAndReturn( pdFALSE );
+    pxUDPPayloadBuffer_to_NetworkBuffer_ExpectAndReturn( xMessages[ 1 ].pvBuffer, &xSharedBuffer );
+    xSendEventStructToIPTask_ExpectAnyArgsAndReturn( pdPASS );
+
+    lReturn = FreeRTOS_sendmmsg( &xSocket, xMessages, TEST_MESSAGE_COUNT, FREERTOS_ZERO_COPY | FREERTOS_MSG_DONTWAIT );
+
+    TEST_ASSERT_EQUAL( 1, lReturn );
+    TEST_ASSERT_EQUAL( 100, xMessages[ 0 ].lLength );
+    TEST_ASSERT_EQUAL( 0, xMessages[ 1 ].lLength );
+    TEST_ASSERT_EQUAL( 0, xMessages[ 2 ].lLength );
+    TEST_ASSERT_EQUAL_PTR( NULL, xNetworkBuffer.pxNextBuffer );
+}
+
+/**
+ * @brief FreeRTOS_sendto() sends a copy of a zero-copy payload that was received
+ *        on a shared port.  The payload buffer of the caller is released once
+ *        the copy is sent.
+ */
+void test_FreeRTOS_sendto_SharedZeroCopyBuffer( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+    NetworkBufferDescriptor_t xSharedBuffer = { 0 };
+    NetworkBufferDescriptor_t xCopy = { 0 };
+    uint8_t ucSharedEthernetBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+    uint8_t ucCopyEthernetBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+    struct freertos_sockaddr xAddress = { 0 };
+    void * pvPayload = &( ucSharedEthernetBuffer[ ipUDP_PAYLOAD_OFFSET_IPv4 ] );
+
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+    xSharedBuffer.pucEthernetBuffer = ucSharedEthernetBuffer;
+    xSharedBuffer.usShareCount = 2U;
+    xCopy.pucEthernetBuffer = ucCopyEthernetBuffer;
+    xAddress.sin_family = FREERTOS_AF_INET4;
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    pxUDPPayloadBuffer_to_NetworkBuffer_ExpectAndReturn( pvPayload, &xSharedBuffer );
+    pxDuplicateNetworkBufferWithDescriptor_ExpectAndReturn( &xSharedBuffer, ipUDP_PAYLOAD_OFFSET_IPv4 + 100U, &xCopy );
+    xSend_UDP_Update_IPv4_ExpectAndReturn( &xCopy, &xAddress, 0 );
+    listGET_LIST_ITEM_VALUE_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), 0x1234 );
+    xSendEventStructToIPTask_ExpectAnyArgsAndReturn( pdPASS );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xSharedBuffer );
+
+    lReturn = FreeRTOS_sendto( &xSocket, pvPayload, 100U, FREERTOS_ZERO_COPY | FREERTOS_MSG_DONTWAIT, &xAddress, sizeof( xAddress ) );
+
+    TEST_ASSERT_EQUAL( 100, lReturn );
+}
+
+/**
+ * @brief When the copy of a shared payload can not be sent, the copy is released
+ *        and the payload buffer remains owned by the caller.
+ */
+void test_FreeRTOS_sendto_SharedZeroCopyBuffer_NotSent( void )
+{
+    int32_t lReturn;
+    FreeRTOS_Socket_t xSocket = { 0 };
+    NetworkBufferDescriptor_t xSharedBuffer = { 0 };
+    NetworkBufferDescriptor_t xCopy = { 0 };
+    uint8_t ucSharedEthernetBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+    uint8_t ucCopyEthernetBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+    struct freertos_sockaddr xAddress = { 0 };
+    void * pvPayload = &( ucSharedEthernetBuffer[ ipUDP_PAYLOAD_OFFSET_IPv4 ] );
+
+    xSocket.ucProtocol = FREERTOS_IPPROTO_UDP;
+    xSharedBuffer.pucEthernetBuffer = ucSharedEthernetBuffer;
+    xSharedBuffer.usShareCount = 2U;
+    xCopy.pucEthernetBuffer = ucCopyEthernetBuffer;
+    xAddress.sin_family = FREERTOS_AF_INET4;
+
+    listLIST_ITEM_CONTAINER_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), ( struct xLIST * ) ( uintptr_t ) 0x11223344 );
+    pxUDPPayloadBuffer_to_NetworkBuffer_ExpectAndReturn( pvPayload, &xSharedBuffer );
+    pxDuplicateNetworkBufferWithDescriptor_ExpectAndReturn( &xSharedBuffer, ipUDP_PAYLOAD_OFFSET_IPv4 + 100U, &xCopy );
+    xSend_UDP_Update_IPv4_ExpectAndReturn( &xCopy, &xAddress, 0 );
+    listGET_LIST_ITEM_VALUE_ExpectAndReturn( &( xSocket.xBoundSocketListItem ), 0x1234 );
+    xSendEventStructToIPTask_ExpectAnyArgsAndReturn( pdFAIL );
+    vReleaseNetworkBufferAndDescriptor_Expect( &xCopy );
+
+    lReturn = FreeRTOS_sendto( &xSocket, pvPayload, 100U, FREERTOS_ZERO_COPY | FREERTOS_MSG_DONTWAIT, &xAddress, sizeof( xAddress ) );
+
+    TEST_ASSERT_EQUAL( 0, lReturn );
+}
@@ -0,0 +1,263 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_task.h"
+#include "mock_list.h"
+
+/* This must come after list.h is included (in this case, indirectly
+ * by mock_list.h). */
+#include "mock_Sockets_RxFilter_list_macros.h"
+#include "mock_queue.h"
+#include "mock_event_groups.h"
+#include "mock_portable.h"
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_IPv4_Sockets.h"
+#include "mock_FreeRTOS_IPv6_Sockets.h"
+
+#include "FreeRTOS_Sockets.h"
+
+#include "FreeRTOS_Sockets_RxFilter_stubs.c"
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* =========================== EXTERN VARIABLES =========================== */
+
+void prvPortFilterUpdate( const FreeRTOS_Socket_t * pxSocket );
+
+extern List_t xBoundUDPSocketsList;
+extern List_t xBoundTCPSocketsList;
+extern uint8_t ucUDPPortBits[ ipconfigEARLY_RX_FILTER_PORT_BITS / 8 ];
+extern uint8_t ucTCPPortBits[ ipconfigEARLY_RX_FILTER_PORT_BITS / 8 ];
+
+/* Ports 5000 and 5064 map to the same bit of the bitmaps, 5001 to another bit. */
+#define TEST_PORT              5000U
+#define TEST_PORT_SAME_BIT     5064U
+#define TEST_PORT_OTHER_BIT    5001U
+
+/* The maximum number of bound sockets in a test. */
+#define TEST_MAX_SOCKETS    3U
+
+static ListItem_t xBoundItems[ TEST_MAX_SOCKETS ];
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    ( void ) memset( ucUDPPortBits, 0, sizeof( ucUDPPortBits ) );
+    ( void ) memset( ucTCPPortBits, 0, sizeof( ucTCPPortBits ) );
+}
+
+/* ============================ Helper Functions ============================ */
+
+/*
+ * @brief Expect prvPortFilterUpdate() to be called for a socket bound to
+ *        'usPort', while the sockets in 'pusBoundPorts' are in 'pxList'.
+ *        The list is searched until a port is found with the same bit.
+ */
+static void prvExpectPortFilterUpdate( FreeRTOS_Socket_t * pxSocket,
+                                       uint16_t usPort,
+                                       List_t * pxList,
+                                       const uint16_t * pusBoundPorts,
+                                       size_t uxCount )
+{
+    const uint16_t usMask = ( uint16_t ) ( ipconfigEARLY_RX_FILTER_PORT_BITS - 1 );
+    ListItem_t * pxEnd = ( ListItem_t * ) &( pxList->xListEnd );
+    size_t uxIndex;
+
+    TEST_ASSERT_TRUE( uxCount <= TEST_MAX_SOCKETS );
+
+    listGET_LIST_ITEM_VALUE_ExpectAndReturn( &( pxSocket->xBoundSocketListItem ), FreeRTOS_htons( usPort ) );
+    listGET_HEAD_ENTRY_ExpectAndReturn( pxList, ( uxCount > 0U ) ? &( xBoundItems[ 0 ] ) : pxEnd );
+
+    for( uxIndex = 0U; uxIndex < uxCount; uxIndex++ )
+    {
+        listGET_LIST_ITEM_VALUE_ExpectAndReturn( &( xBoundItems[ uxIndex ] ), FreeRTOS_htons( pusBoundPorts[ uxIndex ] ) );
+
+        if( ( pusBoundPorts[ uxIndex ] & usMask ) == ( usPort & usMask ) )
+        {
+            break;
+        }
+
+        listGET_NEXT_ExpectAndReturn( &( xBoundItems[ uxIndex ] ), ( ( uxIndex + 1U ) < uxCount ) ? &( xBoundItems[ uxIndex + 1U ] ) : pxEnd );
+    }
+}
+
+/* ============================== Test Cases ============================== */
+
+/**
+ * @brief Binding a UDP socket sets the bit of its port in the UDP bitmap only.
+ */
+void test_prvPortFilterUpdate_UDPSocketBound( void )
+{
+    FreeRTOS_Socket_t xSocket;
+    uint16_t usBoundPorts[] = { TEST_PORT };
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    xSocket.ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_UDP;
+
+    prvExpectPortFilterUpdate( &xSocket, TEST_PORT, &xBoundUDPSocketsList, usBoundPorts, 1U );
+    prvPortFilterUpdate( &xSocket );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_UDP, FreeRTOS_htons( TEST_PORT ) ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_UDP, FreeRTOS_htons( TEST_PORT_OTHER_BIT ) ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_TCP, FreeRTOS_htons( TEST_PORT ) ) );
+}
+
+/**
+ * @brief Binding a TCP socket sets the bit of its port in the TCP bitmap only.
+ */
+void test_prvPortFilterUpdate_TCPSocketBound( void )
+{
+    FreeRTOS_Socket_t xSocket;
+    uint16_t usBoundPorts[] = { TEST_PORT_OTHER_BIT, TEST_PORT };
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    xSocket.ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_TCP;
+
+    prvExpectPortFilterUpdate( &xSocket, TEST_PORT, &xBoundTCPSocketsList, usBoundPorts, 2U );
+    prvPortFilterUpdate( &xSocket );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_TCP, FreeRTOS_htons( TEST_PORT ) ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_UDP, FreeRTOS_htons( TEST_PORT ) ) );
+}
+
+/**
+ * @brief When a socket is unbound, its bit stays set while another socket
+ *        uses a port with the same bit, and is cleared after that.
+ */
+void test_prvPortFilterUpdate_SocketUnbound( void )
+{
+    FreeRTOS_Socket_t xSocket;
+    uint16_t usBoundPorts[] = { TEST_PORT_OTHER_BIT, TEST_PORT_SAME_BIT };
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    xSocket.ucProtocol = ( uint8_t ) FREERTOS_IPPROTO_UDP;
+    ucUDPPortBits[ ( TEST_PORT & ( ipconfigEARLY_RX_FILTER_PORT_BITS - 1 ) ) >> 3 ] = 0xFFU;
+
+    /* TEST_PORT is unbound, TEST_PORT_SAME_BIT is still bound. */
+    prvExpectPortFilterUpdate( &xSocket, TEST_PORT, &xBoundUDPSocketsList, usBoundPorts, 2U );
+    prvPortFilterUpdate( &xSocket );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_UDP, FreeRTOS_htons( TEST_PORT ) ) );
+
+    /* TEST_PORT_SAME_BIT is unbound, only TEST_PORT_OTHER_BIT is left. */
+    prvExpectPortFilterUpdate( &xSocket, TEST_PORT_SAME_BIT, &xBoundUDPSocketsList, usBoundPorts, 1U );
+    prvPortFilterUpdate( &xSocket );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_UDP, FreeRTOS_htons( TEST_PORT ) ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_UDP, FreeRTOS_htons( TEST_PORT_SAME_BIT ) ) );
+
+    /* The other bits of the byte are left alone. */
+    TEST_ASSERT_EQUAL( 0xFFU & ~( 1U << ( TEST_PORT & 7U ) ), ucUDPPortBits[ ( TEST_PORT & ( ipconfigEARLY_RX_FILTER_PORT_BITS - 1 ) ) >> 3 ] );
+}
+
+/**
+ * @brief Protocols without port numbers never have a socket.
+ */
+void test_xPortMayHaveSocket_OtherProtocol( void )
+{
+    ( void ) memset( ucUDPPortBits, 0xFF, sizeof( ucUDPPortBits ) );
+    ( void ) memset( ucTCPPortBits, 0xFF, sizeof( ucTCPPortBits ) );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xPortMayHaveSocket( ( uint8_t ) ipPROTOCOL_ICMP, FreeRTOS_htons( TEST_PORT ) ) );
+}
+
+/**
+ * @brief xPortHasUDPSocket() does not suspend the scheduler when the bit of
+ *        the port is cleared.
+ */
+void test_xPortHasUDPSocket_BitCleared( void )
+{
+    TEST_ASSERT_EQUAL( pdFALSE, xPortHasUDPSocket( FreeRTOS_htons( TEST_PORT ) ) );
+}
+
+/**
+ * @brief xPortHasUDPSocket() searches the list when the bit of the port is set.
+ */
+void test_xPortHasUDPSocket_SocketFound( void )
+{
+    ucUDPPortBits[ ( TEST_PORT & ( ipconfigEARLY_RX_FILTER_PORT_BITS - 1 ) ) >> 3 ] = ( uint8_t ) ( 1U << ( TEST_PORT & 7U ) );
+
+    vTaskSuspendAll_Expect();
+    xIPIsNetworkTaskReady_ExpectAndReturn( pdTRUE );
+    listGET_HEAD_ENTRY_ExpectAndReturn( &xBoundUDPSocketsList, &( xBoundItems[ 0 ] ) );
+    listGET_LIST_ITEM_VALUE_ExpectAndReturn( &( xBoundItems[ 0 ] ), FreeRTOS_htons( TEST_PORT ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xPortHasUDPSocket( FreeRTOS_htons( TEST_PORT ) ) );
+}
+
+/**
+ * @brief A port that only shares a bit with a bound port is not found in the list.
+ */
+void test_xPortHasUDPSocket_SharedBit( void )
+{
+    ucUDPPortBits[ ( TEST_PORT & ( ipconfigEARLY_RX_FILTER_PORT_BITS - 1 ) ) >> 3 ] = ( uint8_t ) ( 1U << ( TEST_PORT & 7U ) );
+
+    vTaskSuspendAll_Expect();
+    xIPIsNetworkTaskReady_ExpectAndReturn( pdTRUE );
+    listGET_HEAD_ENTRY_ExpectAndReturn( &xBoundUDPSocketsList, &( xBoundItems[ 0 ] ) );
+    listGET_LIST_ITEM_VALUE_ExpectAndReturn( &( xBoundItems[ 0 ] ), FreeRTOS_htons( TEST_PORT_SAME_BIT ) );
+    listGET_NEXT_ExpectAndReturn( &( xBoundItems[ 0 ] ), ( ListItem_t * ) &( xBoundUDPSocketsList.xListEnd ) );
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xPortHasUDPSocket( FreeRTOS_htons( TEST_PORT ) ) );
+}
+
+/**
+ * @brief vNetworkSocketsInit() clears both bitmaps.
+ */
+void test_vNetworkSocketsInit_ClearsBitmaps( void )
+{
+    ( void ) memset( ucUDPPortBits, 0xFF, sizeof( ucUDPPortBits ) );
+    ( void ) memset( ucTCPPortBits, 0xFF, sizeof( ucTCPPortBits ) );
+
+    vListInitialise_Expect( &xBoundUDPSocketsList );
+    vListInitialise_Expect( &xBoundTCPSocketsList );
+
+    vNetworkSocketsInit();
+
+    TEST_ASSERT_EQUAL( pdFALSE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_UDP, FreeRTOS_htons( TEST_PORT ) ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xPortMayHaveSocket( ( uint8_t ) FREERTOS_IPPROTO_TCP, FreeRTOS_htons( TEST_PORT ) ) );
+}
@@ -0,0 +1,371 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2024 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Utils.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_NetworkInterface.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_Stream_Buffer.h"
+#include "mock_FreeRTOS_TCP_WIN.h"
+#include "mock_FreeRTOS_TCP_Transmission.h"
+
+#include "FreeRTOS_TCP_IP.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+#include "FreeRTOS_TCP_Reception.h"
+
+/* The number of payload bytes in every test segment. */
+#define GRO_TEST_PAYLOAD_LENGTH    100U
+
+/* The sequence number of the first test segment. */
+#define GRO_TEST_SEQUENCE          0x10000000UL
+
+static NetworkBufferDescriptor_t xFirstBuffer, xNextBuffer;
+static uint8_t ucFirstFrame[ ipconfigNETWORK_MTU ];
+static uint8_t ucNextFrame[ ipconfigNETWORK_MTU ];
+
+/*
+ * Fill a network buffer with an IPv4 TCP segment without options, carrying
+ * GRO_TEST_PAYLOAD_LENGTH bytes of data.
+ */
+static void prvFillSegment_IPv4( NetworkBufferDescriptor_t * pxBuffer,
+                                 uint8_t * pucFrame,
+                                 uint32_t ulSequenceNumber )
+{
+    TCPPacket_t * pxPacket = ( TCPPacket_t * ) pucFrame;
+    size_t uxIPLength = ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER + GRO_TEST_PAYLOAD_LENGTH;
+
+    memset( pucFrame, 0, ipconfigNETWORK_MTU );
+    memset( pxBuffer, 0, sizeof( *pxBuffer ) );
+
+    pxPacket->xEthernetHeader.usFrameType = ipIPv4_FRAME_TYPE;
+    pxPacket->xIPHeader.ucVersionHeaderLength = ipIPV4_VERSION_HEADER_LENGTH_MIN;
+    pxPacket->xIPHeader.ucProtocol = ( uint8_t ) ipPROTOCOL_TCP;
+    pxPacket->xIPHeader.usLength = FreeRTOS_htons( uxIPLength );
+    pxPacket->xIPHeader.ulSourceIPAddress = FreeRTOS_htonl( 0xC0A80001UL );
+    pxPacket->xIPHeader.ulDestinationIPAddress = FreeRTOS_htonl( 0xC0A80002UL );
+
+    pxPacket->xTCPHeader.usSourcePort = FreeRTOS_htons( 80U );
+    pxPacket->xTCPHeader.usDestinationPort = FreeRTOS_htons( 4321U );
+    pxPacket->xTCPHeader.ulSequenceNumber = FreeRTOS_htonl( ulSequenceNumber );
+    pxPacket->xTCPHeader.ulAckNr = FreeRTOS_htonl( 0x20000000UL );
+    pxPacket->xTCPHeader.ucTCPOffset = tcpTCP_OFFSET_STANDARD_LENGTH;
+    pxPacket->xTCPHeader.ucTCPFlags = tcpTCP_FLAG_ACK;
+    pxPacket->xTCPHeader.usWindow = FreeRTOS_htons( 0x1000U );
+
+    pxBuffer->pucEthernetBuffer = pucFrame;
+    pxBuffer->xDataLength = ipSIZE_OF_ETH_HEADER + uxIPLength;
+}
+
+/*
+ * Fill a network buffer with an IPv6 TCP segment without options, carrying
+ * GRO_TEST_PAYLOAD_LENGTH bytes of data.
+ */
+static void prvFillSegment_IPv6( NetworkBufferDescriptor_t * pxBuffer,
+                                 uint8_t * pucFrame,
+                                 uint32_t ulSequenceNumber )
+{
+    TCPPacket_IPv6_t * pxPacket = ( TCPPacket_IPv6_t * ) pucFrame;
+    size_t uxPayloadLength = ipSIZE_OF_TCP_HEADER + GRO_TEST_PAYLOAD_LENGTH;
+
+    memset( pucFrame, 0, ipconfigNETWORK_MTU );
+    memset( pxBuffer, 0, sizeof( *pxBuffer ) );
+
+    pxPacket->xEthernetHeader.usFrameType = ipIPv6_FRAME_TYPE;
+    pxPacket->xIPHeader.ucVersionTrafficClass = 0x60U;
+    pxPacket->xIPHeader.ucNextHeader = ( uint8_t ) ipPROTOCOL_TCP;
+    pxPacket->xIPHeader.usPayloadLength = FreeRTOS_htons( uxPayloadLength );
+    pxPacket->xIPHeader.xSourceAddress.ucBytes[ 0 ] = 0xfeU;
+    pxPacket->xIPHeader.xSourceAddress.ucBytes[ 15 ] = 0x01U;
+    pxPacket->xIPHeader.xDestinationAddress.ucBytes[ 0 ] = 0xfeU;
+    pxPacket->xIPHeader.xDestinationAddress.ucBytes[ 15 ] = 0x02U;
+
+    pxPacket->xTCPHeader.usSourcePort = FreeRTOS_htons( 80U );
+    pxPacket->xTCPHeader.usDestinationPort = FreeRTOS_htons( 4321U );
+    pxPacket->xTCPHeader.ulSequenceNumber = FreeRTOS_htonl( ulSequenceNumber );
+    pxPacket->xTCPHeader.ulAckNr = FreeRTOS_htonl( 0x20000000UL );
+    pxPacket->xTCPHeader.ucTCPOffset = tcpTCP_OFFSET_STANDARD_LENGTH;
+    pxPacket->xTCPHeader.ucTCPFlags = tcpTCP_FLAG_ACK;
+    pxPacket->xTCPHeader.usWindow = FreeRTOS_htons( 0x1000U );
+
+    pxBuffer->pucEthernetBuffer = pucFrame;
+    pxBuffer->xDataLength = ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv6_HEADER + uxPayloadLength;
+}
+
+/*
+ * Prepare two IPv4 segments of the same flow, the second one continues
+ * exactly where the first one ends.
+ */
+static void prvFillTwoSegments_IPv4( void )
+{
+    prvFillSegment_IPv4( &xFirstBuffer, ucFirstFrame, GRO_TEST_SEQUENCE );
+    prvFillSegment_IPv4( &xNextBuffer, ucNextFrame, GRO_TEST_SEQUENCE + GRO_TEST_PAYLOAD_LENGTH );
+}
+
+/* ==============================  Test Cases  ============================== */
+
+/**
+ * @brief Two consecutive IPv4 data segments of the same flow may be coalesced.
+ */
+void test_xTCPGROIsContinuation_IPv4_Merge( void )
+{
+    prvFillTwoSegments_IPv4();
+
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief The PSH flag does not prevent coalescing.
+ */
+void test_xTCPGROIsContinuation_IPv4_Merge_PSH( void )
+{
+    TCPPacket_t * pxPacket = ( TCPPacket_t * ) ucFirstFrame;
+
+    prvFillTwoSegments_IPv4();
+    pxPacket->xTCPHeader.ucTCPFlags |= tcpTCP_FLAG_PSH;
+
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief Two consecutive IPv6 data segments of the same flow may be coalesced.
+ */
+void test_xTCPGROIsContinuation_IPv6_Merge( void )
+{
+    prvFillSegment_IPv6( &xFirstBuffer, ucFirstFrame, GRO_TEST_SEQUENCE );
+    prvFillSegment_IPv6( &xNextBuffer, ucNextFrame, GRO_TEST_SEQUENCE + GRO_TEST_PAYLOAD_LENGTH );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief There is nothing to coalesce with when the burst ends.
+ */
+void test_xTCPGROIsContinuation_NoNextBuffer( void )
+{
+    prvFillTwoSegments_IPv4();
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, NULL ) );
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( NULL, &xNextBuffer ) );
+}
+
+/**
+ * @brief A segment that acknowledges other data is not coalesced, otherwise
+ *        the acknowledgement of the absorbed segment would be lost.
+ */
+void test_xTCPGROIsContinuation_DifferentAck( void )
+{
+    TCPPacket_t * pxPacket = ( TCPPacket_t * ) ucNextFrame;
+
+    prvFillTwoSegments_IPv4();
+    pxPacket->xTCPHeader.ulAckNr = FreeRTOS_htonl( 0x20000100UL );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief A segment that announces another window is not coalesced.
+ */
+void test_xTCPGROIsContinuation_DifferentWindow( void )
+{
+    TCPPacket_t * pxPacket = ( TCPPacket_t * ) ucNextFrame;
+
+    prvFillTwoSegments_IPv4();
+    pxPacket->xTCPHeader.usWindow = FreeRTOS_htons( 0x0800U );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief A gap in the sequence numbers prevents coalescing.
+ */
+void test_xTCPGROIsContinuation_SequenceGap( void )
+{
+    prvFillSegment_IPv4( &xFirstBuffer, ucFirstFrame, GRO_TEST_SEQUENCE );
+    prvFillSegment_IPv4( &xNextBuffer, ucNextFrame, GRO_TEST_SEQUENCE + GRO_TEST_PAYLOAD_LENGTH + 1U );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief Segments of another connection are not coalesced.
+ */
+void test_xTCPGROIsContinuation_DifferentFlow( void )
+{
+    TCPPacket_t * pxPacket = ( TCPPacket_t * ) ucNextFrame;
+
+    prvFillTwoSegments_IPv4();
+    pxPacket->xTCPHeader.usDestinationPort = FreeRTOS_htons( 4322U );
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+
+    prvFillTwoSegments_IPv4();
+    pxPacket->xIPHeader.ulSourceIPAddress = FreeRTOS_htonl( 0xC0A80003UL );
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief Only plain data segments are coalesced: a FIN, RST or SYN is always
+ *        handled on its own.
+ */
+void test_xTCPGROIsContinuation_OtherFlags( void )
+{
+    TCPPacket_t * pxPacket = ( TCPPacket_t * ) ucFirstFrame;
+
+    prvFillTwoSegments_IPv4();
+    pxPacket->xTCPHeader.ucTCPFlags = tcpTCP_FLAG_ACK | tcpTCP_FLAG_FIN;
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+
+    pxPacket->xTCPHeader.ucTCPFlags = tcpTCP_FLAG_ACK | tcpTCP_FLAG_RST;
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+
+    pxPacket->xTCPHeader.ucTCPFlags = tcpTCP_FLAG_SYN;
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief A segment without payload is not coalesced.
+ */
+void test_xTCPGROIsContinuation_NoPayload( void )
+{
+    TCPPacket_t * pxPacket = ( TCPPacket_t * ) ucFirstFrame;
+
+    prvFillTwoSegments_IPv4();
+    pxPacket->xIPHeader.usLength = FreeRTOS_htons( ipSIZE_OF_IPv4_HEADER + ipSIZE_OF_TCP_HEADER );
+    pxPacket = ( TCPPacket_t * ) ucNextFrame;
+    pxPacket->xTCPHeader.ulSequenceNumber = FreeRTOS_htonl( GRO_TEST_SEQUENCE );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief Segments with TCP options are not coalesced.
+ */
+void test_xTCPGROIsContinuation_TCPOptions( void )
+{
+    TCPPacket_t * pxPacket = ( TCPPacket_t * ) ucNextFrame;
+
+    prvFillTwoSegments_IPv4();
+    pxPacket->xTCPHeader.ucTCPOffset = 0x80U;
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief Frames that are too short to contain the headers are not inspected.
+ */
+void test_xTCPGROIsContinuation_ShortFrame( void )
+{
+    prvFillTwoSegments_IPv4();
+    xNextBuffer.xDataLength = sizeof( TCPPacket_t ) - 1U;
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+
+    prvFillTwoSegments_IPv4();
+    xFirstBuffer.xDataLength = sizeof( EthernetHeader_t ) - 1U;
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+
+    prvFillSegment_IPv6( &xFirstBuffer, ucFirstFrame, GRO_TEST_SEQUENCE );
+    prvFillSegment_IPv6( &xNextBuffer, ucNextFrame, GRO_TEST_SEQUENCE + GRO_TEST_PAYLOAD_LENGTH );
+    xFirstBuffer.xDataLength = sizeof( TCPPacket_IPv6_t ) - 1U;
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief An IP length that exceeds the frame is not trusted.
+ */
+void test_xTCPGROIsContinuation_IPLengthTooLong( void )
+{
+    prvFillTwoSegments_IPv4();
+    xFirstBuffer.xDataLength -= 1U;
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROIsContinuation( &xFirstBuffer, &xNextBuffer ) );
+}
+
+/**
+ * @brief A segment is not absorbed when the connection is not established.
+ */
+void test_xTCPGROStoreSegment_NotEstablished( void )
+{
+    FreeRTOS_Socket_t xSocket;
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    prvFillTwoSegments_IPv4();
+    xSocket.u.xTCP.eTCPState = eSYN_RECEIVED;
+    xSocket.u.xTCP.xTCPWindow.rx.ulCurrentSequenceNumber = GRO_TEST_SEQUENCE;
+
+    uxIPHeaderSizePacket_ExpectAnyArgsAndReturn( ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROStoreSegment( &xSocket, &xFirstBuffer ) );
+}
+
+/**
+ * @brief A segment that is not the next expected one is not absorbed.
+ */
+void test_xTCPGROStoreSegment_OutOfOrder( void )
+{
+    FreeRTOS_Socket_t xSocket;
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    prvFillTwoSegments_IPv4();
+    xSocket.u.xTCP.eTCPState = eESTABLISHED;
+    xSocket.u.xTCP.xTCPWindow.rx.ulCurrentSequenceNumber = GRO_TEST_SEQUENCE + 1U;
+
+    uxIPHeaderSizePacket_ExpectAnyArgsAndReturn( ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROStoreSegment( &xSocket, &xFirstBuffer ) );
+}
+
+/**
+ * @brief A segment after a FIN is not absorbed.
+ */
+void test_xTCPGROStoreSegment_FinReceived( void )
+{
+    FreeRTOS_Socket_t xSocket;
+
+    memset( &xSocket, 0, sizeof( xSocket ) );
+    prvFillTwoSegments_IPv4();
+    xSocket.u.xTCP.eTCPState = eESTABLISHED;
+    xSocket.u.xTCP.bits.bFinRecv = pdTRUE_UNSIGNED;
+    xSocket.u.xTCP.xTCPWindow.rx.ulCurrentSequenceNumber = GRO_TEST_SEQUENCE;
+
+    uxIPHeaderSizePacket_ExpectAnyArgsAndReturn( ipSIZE_OF_IPv4_HEADER );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xTCPGROStoreSegment( &xSocket, &xFirstBuffer ) );
+}
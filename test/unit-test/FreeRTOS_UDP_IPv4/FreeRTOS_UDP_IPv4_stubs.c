@@ -41,6 +41,7 @@
 
 extern const uint32_t ulDefaultIPv4Address;
 extern BaseType_t xIsIfOutCalled;
+extern BaseType_t xDirectSendAllowed;
 
 /* ======================== Stub Callback Functions ========================= */
 
@@ -93,6 +94,11 @@ BaseType_t xNetworkInterfaceOutput( struct xNetworkInterface * pxDescriptor,
     return pdPASS;
 }
 
+BaseType_t xUDPDirectSendAllowed( const struct xNetworkEndPoint * pxEndPoint )
+{
+    return ( pxEndPoint != NULL ) ? xDirectSendAllowed : pdFALSE;
+}
+
 NetworkBufferDescriptor_t * prvPrepareDefaultNetworkbuffer( uint8_t ucProtocol )
 {
     static NetworkBufferDescriptor_t xNetworkBuffer;
@@ -59,6 +59,7 @@
 const uint32_t ulDefaultIPv4Address = 0x12345678;
 const uint16_t ulDefaultProtoChecksum = 0xABCD;
 BaseType_t xIsIfOutCalled = 0;
+BaseType_t xDirectSendAllowed = pdTRUE;
 
 /* ============================  Unity Fixtures  ============================ */
 
@@ -66,6 +67,7 @@ BaseType_t xIsIfOutCalled = 0;
 void setUp( void )
 {
     xIsIfOutCalled = 0;
+    xDirectSendAllowed = pdTRUE;
 }
 
 /* ==============================  Test Cases  ============================== */
@@ -1698,3 +1700,132 @@ void test_vProcessGeneratedUDPPacket_IPv4_UDPCacheMissEndPointNotFound()
     TEST_ASSERT_EQUAL( NULL, pxNetworkBuffer->pxEndPoint );
     TEST_ASSERT_EQUAL( 0, xIsIfOutCalled );
 }
+
+/**
+ * @brief A user task sends a UDP packet directly when the ARP cache has the
+ * target. The IP identification stays zero, the counter of the IP-task is not used.
+ */
+void test_xSendGeneratedUDPPacketDirect_IPv4_CacheHit()
+{
+    BaseType_t xReturn;
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    NetworkEndPoint_t * pxEndPoint;
+    UDPPacket_t * pxUDPPacket;
+
+    pxNetworkBuffer = prvPrepareDefaultNetworkbuffer( ipPROTOCOL_UDP );
+    pxEndPoint = prvPrepareDefaultIPv4EndPoint();
+
+    pxUDPPacket = ( UDPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer;
+    pxUDPPacket->xIPHeader.usIdentification = 0xFFFFU;
+
+    vTaskSuspendAll_Expect();
+    eARPGetCacheEntry_ExpectAndReturn( &( pxNetworkBuffer->xIPAddress.ulIP_IPv4 ), &( pxUDPPacket->xEthernetHeader.xDestinationAddress ), NULL, eResolutionCacheHit );
+    eARPGetCacheEntry_IgnoreArg_ppxEndPoint();
+    eARPGetCacheEntry_ReturnThruPtr_ppxEndPoint( &pxEndPoint );
+    eARPGetCacheEntry_IgnoreArg_pulIPAddress();
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+    uxIPHeaderSizePacket_ExpectAndReturn( pxNetworkBuffer, ipSIZE_OF_IPv4_HEADER );
+    usGenerateChecksum_ExpectAnyArgsAndReturn( ulDefaultProtoChecksum );
+
+    xReturn = xSendGeneratedUDPPacketDirect_IPv4( pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdTRUE, xReturn );
+    TEST_ASSERT_EQUAL( pxEndPoint, pxNetworkBuffer->pxEndPoint );
+    TEST_ASSERT_EQUAL( 0U, pxUDPPacket->xIPHeader.usIdentification );
+    TEST_ASSERT_EQUAL( ulDefaultIPv4Address, pxUDPPacket->xIPHeader.ulSourceIPAddress );
+    TEST_ASSERT_EQUAL( 1, xIsIfOutCalled );
+}
+
+/**
+ * @brief A cache miss in a user task: the packet is left for the IP-task, no ARP
+ * request is sent, and the end-point of the buffer is not changed.
+ */
+void test_xSendGeneratedUDPPacketDirect_IPv4_CacheMiss()
+{
+    BaseType_t xReturn;
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    NetworkEndPoint_t * pxEndPoint;
+    UDPPacket_t * pxUDPPacket;
+
+    pxNetworkBuffer = prvPrepareDefaultNetworkbuffer( ipPROTOCOL_UDP );
+    pxEndPoint = prvPrepareDefaultIPv4EndPoint();
+
+    pxUDPPacket = ( UDPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer;
+
+    vTaskSuspendAll_Expect();
+    eARPGetCacheEntry_ExpectAndReturn( &( pxNetworkBuffer->xIPAddress.ulIP_IPv4 ), &( pxUDPPacket->xEthernetHeader.xDestinationAddress ), NULL, eResolutionCacheMiss );
+    eARPGetCacheEntry_IgnoreArg_ppxEndPoint();
+    eARPGetCacheEntry_ReturnThruPtr_ppxEndPoint( &pxEndPoint );
+    eARPGetCacheEntry_IgnoreArg_pulIPAddress();
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    xReturn = xSendGeneratedUDPPacketDirect_IPv4( pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xReturn );
+    TEST_ASSERT_EQUAL( NULL, pxNetworkBuffer->pxEndPoint );
+    TEST_ASSERT_EQUAL( 0, xIsIfOutCalled );
+}
+
+/**
+ * @brief A cache hit through an interface that does not allow direct sending:
+ * the packet and its end-point are left for the IP-task.
+ */
+void test_xSendGeneratedUDPPacketDirect_IPv4_NotAllowed()
+{
+    BaseType_t xReturn;
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    NetworkEndPoint_t * pxEndPoint;
+    UDPPacket_t * pxUDPPacket;
+
+    pxNetworkBuffer = prvPrepareDefaultNetworkbuffer( ipPROTOCOL_UDP );
+    pxEndPoint = prvPrepareDefaultIPv4EndPoint();
+    xDirectSendAllowed = pdFALSE;
+
+    pxUDPPacket = ( UDPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer;
+
+    vTaskSuspendAll_Expect();
+    eARPGetCacheEntry_ExpectAndReturn( &( pxNetworkBuffer->xIPAddress.ulIP_IPv4 ), &( pxUDPPacket->xEthernetHeader.xDestinationAddress ), NULL, eResolutionCacheHit );
+    eARPGetCacheEntry_IgnoreArg_ppxEndPoint();
+    eARPGetCacheEntry_ReturnThruPtr_ppxEndPoint( &pxEndPoint );
+    eARPGetCacheEntry_IgnoreArg_pulIPAddress();
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    xReturn = xSendGeneratedUDPPacketDirect_IPv4( pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xReturn );
+    TEST_ASSERT_EQUAL( NULL, pxNetworkBuffer->pxEndPoint );
+    TEST_ASSERT_EQUAL( 0, xIsIfOutCalled );
+}
+
+/**
+ * @brief The buffer already has an end-point: direct sending checks that
+ * end-point, and leaves it in place when the packet goes to the IP-task.
+ */
+void test_xSendGeneratedUDPPacketDirect_IPv4_KeepsOwnEndPoint()
+{
+    BaseType_t xReturn;
+    NetworkBufferDescriptor_t * pxNetworkBuffer;
+    NetworkEndPoint_t * pxEndPoint, xCacheEndPoint, * pxCacheEndPoint = &xCacheEndPoint;
+    UDPPacket_t * pxUDPPacket;
+
+    memset( &xCacheEndPoint, 0, sizeof( xCacheEndPoint ) );
+
+    pxNetworkBuffer = prvPrepareDefaultNetworkbuffer( ipPROTOCOL_UDP );
+    pxEndPoint = prvPrepareDefaultIPv4EndPoint();
+    pxNetworkBuffer->pxEndPoint = pxEndPoint;
+
+    pxUDPPacket = ( UDPPacket_t * ) pxNetworkBuffer->pucEthernetBuffer;
+
+    vTaskSuspendAll_Expect();
+    eARPGetCacheEntry_ExpectAndReturn( &( pxNetworkBuffer->xIPAddress.ulIP_IPv4 ), &( pxUDPPacket->xEthernetHeader.xDestinationAddress ), NULL, eResolutionCacheMiss );
+    eARPGetCacheEntry_IgnoreArg_ppxEndPoint();
+    eARPGetCacheEntry_ReturnThruPtr_ppxEndPoint( &pxCacheEndPoint );
+    eARPGetCacheEntry_IgnoreArg_pulIPAddress();
+    xTaskResumeAll_ExpectAndReturn( pdFALSE );
+
+    xReturn = xSendGeneratedUDPPacketDirect_IPv4( pxNetworkBuffer );
+
+    TEST_ASSERT_EQUAL( pdFALSE, xReturn );
+    TEST_ASSERT_EQUAL( pxEndPoint, pxNetworkBuffer->pxEndPoint );
+    TEST_ASSERT_EQUAL( 0, xIsIfOutCalled );
+}
@@ -0,0 +1,549 @@
+/*
+ * FreeRTOS+TCP <DEVELOPMENT BRANCH>
+ * Copyright (C) 2022 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://aws.amazon.com/freertos
+ * http://www.FreeRTOS.org
+ */
+
+
+/* Include Unity header */
+#include "unity.h"
+
+/* Include standard libraries */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "FreeRTOS_IP.h"
+
+#include "mock_task.h"
+#include "mock_list.h"
+#include "mock_queue.h"
+#include "mock_FreeRTOS_IP.h"
+#include "mock_FreeRTOS_IP_Private.h"
+#include "mock_FreeRTOS_IP_Timers.h"
+#include "mock_FreeRTOS_Sockets.h"
+#include "mock_FreeRTOS_UDP_IP.h"
+#include "mock_FreeRTOS_Routing.h"
+#include "mock_NetworkBufferManagement.h"
+#include "mock_FreeRTOS_DNS_Cache.h"
+#include "mock_FreeRTOS_DNS_Callback.h"
+#include "mock_FreeRTOS_DNS_Networking.h"
+
+#include "FreeRTOS_DNS.h"
+#include "FreeRTOS_DNS_Globals.h"
+
+#include "catch_assert.h"
+
+#include "FreeRTOSIPConfig.h"
+
+/* The names that the tests ask for. */
+#define TEST_SERVICE_NAME       "_ipp._tcp.local"
+#define TEST_OTHER_NAME         "_http._tcp.local"
+#define TEST_HOST_NAME          "host.local"
+
+/* The number of end-points that the routing stubs know about. */
+#define TEST_MAX_END_POINTS     6
+
+/* The number of queries that are recorded. */
+#define TEST_MAX_SENT           4
+
+/* The size of a recorded DNS message. */
+#define TEST_MESSAGE_SIZE       256
+
+/* The offset of the UDP header in a received IPv4 packet. */
+#define TEST_UDP_OFFSET         ( ipSIZE_OF_ETH_HEADER + ipSIZE_OF_IPv4_HEADER )
+
+/* Defined in FreeRTOS_mDNS_stubs.c. */
+extern size_t uxCriticalSections;
+extern size_t uxCriticalNesting;
+
+/* A query that was passed to vProcessGeneratedUDPPacket(). */
+typedef struct xTEST_SENT
+{
+    NetworkEndPoint_t * pxEndPoint;
+    uint32_t ulIPv4Address;
+    uint16_t usFrameType;
+    uint8_t ucMessage[ TEST_MESSAGE_SIZE ];
+} TestSent_t;
+
+static TickType_t xTestTime;
+static BaseType_t xEventsSent;
+
+static NetworkInterface_t xInterfaces[ 2 ];
+static NetworkEndPoint_t xEndPoints[ TEST_MAX_END_POINTS ];
+static size_t uxEndPointCount;
+
+static NetworkBufferDescriptor_t xNetworkBuffer;
+static uint8_t ucEthernetBuffer[ ipconfigNETWORK_MTU + ipSIZE_OF_ETH_HEADER ];
+
+static TestSent_t xSent[ TEST_MAX_SENT ];
+static size_t uxSentCount;
+
+/* A response that announces the printer "printer._ipp._tcp.local" with a
+ * TTL of 120 seconds, and the address of the printer. */
+static const uint8_t ucResponse[] =
+{
+    0x00, 0x00, 0x84, 0x00,                               /* Identifier, flags: an authoritative response. */
+    0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00,       /* No questions, 2 answers. */
+    0x04, '_',  'i',  'p',  'p',  0x04, '_',  't',  'c',  'p',  0x05, 'l', 'o', 'c', 'a', 'l', 0x00,
+    0x00, 0x0c, 0x00, 0x01, 0x00, 0x00, 0x00, 0x78,       /* PTR, IN, TTL 120. */
+    0x00, 0x0a, 0x07, 'p',  'r',  'i',  'n',  't',  'e',  'r',  0xc0, 0x0c,
+    0xc0, 0x27,                                           /* "printer._ipp._tcp.local" */
+    0x00, 0x01, 0x80, 0x01, 0x00, 0x00, 0x00, 0x78,       /* A, IN with cache-flush, TTL 120. */
+    0x00, 0x04, 192,  168,  1,    20
+};
+
+/* ============================  Stub Callback Functions  ============================ */
+
+static TickType_t xStub_xTaskGetTickCount( int NumCalls )
+{
+    return xTestTime;
+}
+
+static BaseType_t xStub_xSendEventToIPTask( eIPEvent_t eEvent,
+                                            int NumCalls )
+{
+    TEST_ASSERT_EQUAL( eMDNSEvent, eEvent );
+    xEventsSent++;
+
+    return pdPASS;
+}
+
+static uint16_t usStub_usChar2u16( const uint8_t * pucPtr,
+                                   int NumCalls )
+{
+    return ( uint16_t ) ( ( ( ( uint32_t ) pucPtr[ 0 ] ) << 8 ) | ( ( uint32_t ) pucPtr[ 1 ] ) );
+}
+
+static uint32_t ulStub_ulChar2u32( const uint8_t * pucPtr,
+                                   int NumCalls )
+{
+    return ( ( ( uint32_t ) pucPtr[ 0 ] ) << 24 ) | ( ( ( uint32_t ) pucPtr[ 1 ] ) << 16 ) |
+           ( ( ( uint32_t ) pucPtr[ 2 ] ) << 8 ) | ( ( uint32_t ) pucPtr[ 3 ] );
+}
+
+static uint32_t ulStub_FreeRTOS_min_uint32( uint32_t a,
+                                            uint32_t b,
+                                            int NumCalls )
+{
+    return ( a < b ) ? a : b;
+}
+
+static size_t uxStub_uxIPHeaderSizePacket( const NetworkBufferDescriptor_t * pxNetworkBuffer,
+                                           int NumCalls )
+{
+    return ipSIZE_OF_IPv4_HEADER;
+}
+
+/* The end-points of an interface, or all end-points when the interface is NULL. */
+static NetworkEndPoint_t * pxStub_FreeRTOS_NextEndPoint( const NetworkInterface_t * pxInterface,
+                                                          NetworkEndPoint_t * pxEndPoint,
+                                                          int NumCalls )
+{
+    size_t uxIndex = ( pxEndPoint == NULL ) ? 0U : ( size_t ) ( pxEndPoint - xEndPoints ) + 1U;
+    NetworkEndPoint_t * pxReturn = NULL;
+
+    for( ; uxIndex < uxEndPointCount; uxIndex++ )
+    {
+        if( ( pxInterface == NULL ) || ( xEndPoints[ uxIndex ].pxNetworkInterface == pxInterface ) )
+        {
+            pxReturn = &( xEndPoints[ uxIndex ] );
+            break;
+        }
+    }
+
+    return pxReturn;
+}
+
+static NetworkEndPoint_t * pxStub_FreeRTOS_FirstEndPoint( const NetworkInterface_t * pxInterface,
+                                                           int NumCalls )
+{
+    return pxStub_FreeRTOS_NextEndPoint( pxInterface, NULL, NumCalls );
+}
+
+static NetworkBufferDescriptor_t * pxStub_pxGetNetworkBufferWithDescriptor( size_t uxRequestedSizeBytes,
+                                                                            TickType_t xBlockTimeTicks,
+                                                                            int NumCalls )
+{
+    TEST_ASSERT_TRUE( uxRequestedSizeBytes <= sizeof( ucEthernetBuffer ) );
+
+    ( void ) memset( &( xNetworkBuffer ), 0, sizeof( xNetworkBuffer ) );
+    ( void ) memset( ucEthernetBuffer, 0, sizeof( ucEthernetBuffer ) );
+    xNetworkBuffer.pucEthernetBuffer = ucEthernetBuffer;
+    xNetworkBuffer.xDataLength = uxRequestedSizeBytes;
+
+    return &( xNetworkBuffer );
+}
+
+static void vStub_vProcessGeneratedUDPPacket( NetworkBufferDescriptor_t * const pxNetworkBuffer,
+                                              int NumCalls )
+{
+    const EthernetHeader_t * pxEthernetHeader = ( const EthernetHeader_t * ) pxNetworkBuffer->pucEthernetBuffer;
+    size_t uxPayloadOffset;
+
+    TEST_ASSERT_TRUE( uxSentCount < TEST_MAX_SENT );
+    TEST_ASSERT_EQUAL( FreeRTOS_htons( ipMDNS_PORT ), pxNetworkBuffer->usPort );
+
+    uxPayloadOffset = ( pxEthernetHeader->usFrameType == ipIPv6_FRAME_TYPE ) ? ipUDP_PAYLOAD_OFFSET_IPv6 : ipUDP_PAYLOAD_OFFSET_IPv4;
+
+    xSent[ uxSentCount ].pxEndPoint = pxNetworkBuffer->pxEndPoint;
+    xSent[ uxSentCount ].ulIPv4Address = pxNetworkBuffer->xIPAddress.ulIP_IPv4;
+    xSent[ uxSentCount ].usFrameType = pxEthernetHeader->usFrameType;
+    ( void ) memcpy( xSent[ uxSentCount ].ucMessage, &( pxNetworkBuffer->pucEthernetBuffer[ uxPayloadOffset ] ), TEST_MESSAGE_SIZE );
+    uxSentCount++;
+}
+
+/* ============================  Unity Fixtures  ============================ */
+
+/*! called before each test case */
+void setUp( void )
+{
+    /* Let the records of earlier tests expire. */
+    xTestTime += 100000000U;
+    xEventsSent = 0;
+    uxEndPointCount = 0U;
+    uxSentCount = 0U;
+    uxCriticalSections = 0U;
+    uxCriticalNesting = 0U;
+    ( void ) memset( xEndPoints, 0, sizeof( xEndPoints ) );
+
+    xTaskGetTickCount_Stub( xStub_xTaskGetTickCount );
+    xSendEventToIPTask_Stub( xStub_xSendEventToIPTask );
+    usChar2u16_Stub( usStub_usChar2u16 );
+    ulChar2u32_Stub( ulStub_ulChar2u32 );
+    FreeRTOS_min_uint32_Stub( ulStub_FreeRTOS_min_uint32 );
+    uxIPHeaderSizePacket_Stub( uxStub_uxIPHeaderSizePacket );
+    FreeRTOS_FirstEndPoint_Stub( pxStub_FreeRTOS_FirstEndPoint );
+    FreeRTOS_NextEndPoint_Stub( pxStub_FreeRTOS_NextEndPoint );
+    pxGetNetworkBufferWithDescriptor_Stub( pxStub_pxGetNetworkBufferWithDescriptor );
+    vProcessGeneratedUDPPacket_Stub( vStub_vProcessGeneratedUDPPacket );
+    vReleaseNetworkBufferAndDescriptor_Ignore();
+    vIPSetMDNSTimerEnableState_Ignore();
+    vMDNSTimerReload_Ignore();
+}
+
+/*! called after each test case */
+void tearDown( void )
+{
+    /* Stop all questions, and let the IP-task free their slots. */
+    FreeRTOS_mDNSStopQuery( TEST_SERVICE_NAME, dnsTYPE_PTR );
+    FreeRTOS_mDNSStopQuery( TEST_OTHER_NAME, dnsTYPE_PTR );
+    FreeRTOS_mDNSStopQuery( TEST_HOST_NAME, dnsTYPE_A_HOST );
+    uxEndPointCount = 0U;
+    vMDNSCheck();
+}
+
+/* ======================== Helper functions ======================== */
+
+/*
+ * @brief Add an end-point to the list of the routing stubs.
+ */
+static NetworkEndPoint_t * prvAddEndPoint( NetworkInterface_t * pxInterface,
+                                           BaseType_t xIPv6,
+                                           BaseType_t xUp,
+                                           uint32_t ulIPAddress )
+{
+    NetworkEndPoint_t * pxEndPoint = &( xEndPoints[ uxEndPointCount ] );
+
+    TEST_ASSERT_TRUE( uxEndPointCount < TEST_MAX_END_POINTS );
+    uxEndPointCount++;
+
+    pxEndPoint->pxNetworkInterface = pxInterface;
+    pxEndPoint->bits.bIPv6 = ( xIPv6 != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+    pxEndPoint->bits.bEndPointUp = ( xUp != pdFALSE ) ? pdTRUE_UNSIGNED : pdFALSE_UNSIGNED;
+    pxEndPoint->ipv4_settings.ulIPAddress = ulIPAddress;
+
+    return pxEndPoint;
+}
+
+/*
+ * @brief Pass a message to xMDNSProcessPacket() as if it was received from
+ *        port 5353.
+ */
+static BaseType_t prvReceive( const uint8_t * pucMessage,
+                              size_t uxLength )
+{
+    static uint8_t ucHeaders[ TEST_UDP_OFFSET + ipSIZE_OF_UDP_HEADER ];
+    NetworkBufferDescriptor_t xReceived;
+    UDPHeader_t * pxUDPHeader = ( UDPHeader_t * ) &( ucHeaders[ TEST_UDP_OFFSET ] );
+
+    ( void ) memset( &( xReceived ), 0, sizeof( xReceived ) );
+    ( void ) memset( ucHeaders, 0, sizeof( ucHeaders ) );
+    xReceived.pucEthernetBuffer = ucHeaders;
+    pxUDPHeader->usSourcePort = FreeRTOS_htons( ipMDNS_PORT );
+    pxUDPHeader->usDestinationPort = FreeRTOS_htons( ipMDNS_PORT );
+
+    return xMDNSProcessPacket( &( xReceived ), pucMessage, uxLength );
+}
+
+/*
+ * @brief Read a 16-bit field of a recorded query.
+ */
+static uint16_t prvSentField( size_t uxSent,
+                              size_t uxOffset )
+{
+    return usStub_usChar2u16( &( xSent[ uxSent ].ucMessage[ uxOffset ] ), 0 );
+}
+
+/* ======================== Test cases ======================== */
+
+/*
+ * @brief A query is started once and the IP-task is woken up, the same name
+ *        in another case refers to the same query.
+ */
+void test_FreeRTOS_mDNSQuery_StartsOnce( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+    TEST_ASSERT_EQUAL( 1, xEventsSent );
+
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( "_IPP._TCP.Local", dnsTYPE_PTR ) );
+    TEST_ASSERT_EQUAL( 1, xEventsSent );
+
+    /* The slots were changed in critical sections. */
+    TEST_ASSERT_EQUAL( 2, uxCriticalSections );
+    TEST_ASSERT_EQUAL( 0, uxCriticalNesting );
+}
+
+/*
+ * @brief A missing name, or a name that does not fit, is refused.
+ */
+void test_FreeRTOS_mDNSQuery_BadName( void )
+{
+    char pcLongName[ ipconfigDNS_CACHE_NAME_LENGTH + 1 ];
+
+    ( void ) memset( pcLongName, 'a', ipconfigDNS_CACHE_NAME_LENGTH );
+    pcLongName[ ipconfigDNS_CACHE_NAME_LENGTH ] = '\0';
+
+    TEST_ASSERT_EQUAL( pdFAIL, FreeRTOS_mDNSQuery( NULL, dnsTYPE_PTR ) );
+    TEST_ASSERT_EQUAL( pdFAIL, FreeRTOS_mDNSQuery( pcLongName, dnsTYPE_PTR ) );
+    TEST_ASSERT_EQUAL( 0, xEventsSent );
+}
+
+/*
+ * @brief No more than ipconfigMDNS_MAX_QUESTIONS queries can be active.
+ */
+void test_FreeRTOS_mDNSQuery_AllSlotsUsed( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_OTHER_NAME, dnsTYPE_PTR ) );
+    TEST_ASSERT_EQUAL( pdFAIL, FreeRTOS_mDNSQuery( TEST_HOST_NAME, dnsTYPE_A_HOST ) );
+}
+
+/*
+ * @brief The slot of a stopped query is only re-used after the IP-task has
+ *        freed it.
+ */
+void test_FreeRTOS_mDNSStopQuery_FreedByIPTask( void )
+{
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_OTHER_NAME, dnsTYPE_PTR ) );
+    xEventsSent = 0;
+
+    FreeRTOS_mDNSStopQuery( TEST_SERVICE_NAME, dnsTYPE_PTR );
+    TEST_ASSERT_EQUAL( 1, xEventsSent );
+
+    /* The IP-task may still be reading the stopped question. */
+    TEST_ASSERT_EQUAL( pdFAIL, FreeRTOS_mDNSQuery( TEST_HOST_NAME, dnsTYPE_A_HOST ) );
+
+    vMDNSCheck();
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_HOST_NAME, dnsTYPE_A_HOST ) );
+}
+
+/*
+ * @brief Stopping an unknown query does not wake up the IP-task.
+ */
+void test_FreeRTOS_mDNSStopQuery_Unknown( void )
+{
+    FreeRTOS_mDNSStopQuery( TEST_SERVICE_NAME, dnsTYPE_PTR );
+    FreeRTOS_mDNSStopQuery( NULL, dnsTYPE_PTR );
+
+    TEST_ASSERT_EQUAL( 0, xEventsSent );
+}
+
+/*
+ * @brief A query that is restarted before the IP-task freed it stays active.
+ */
+void test_FreeRTOS_mDNSQuery_RestartStopped( void )
+{
+    NetworkInterface_t * pxInterface = &( xInterfaces[ 0 ] );
+
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+    FreeRTOS_mDNSStopQuery( TEST_SERVICE_NAME, dnsTYPE_PTR );
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+
+    ( void ) prvAddEndPoint( pxInterface, pdFALSE, pdTRUE, 0x0101A8C0U );
+    vMDNSHandleEvent();
+
+    TEST_ASSERT_EQUAL( 1, uxSentCount );
+    TEST_ASSERT_EQUAL( 1, prvSentField( 0, 4 ) );
+}
+
+/*
+ * @brief A query is sent once per network interface and IP family, through an
+ *        end-point that is up and has an address.
+ */
+void test_vMDNSHandleEvent_OncePerInterface( void )
+{
+    static const uint8_t ucQuestion[] =
+    {
+        0x04, '_', 'i', 'p', 'p', 0x04, '_', 't', 'c', 'p', 0x05, 'l', 'o', 'c', 'a', 'l', 0x00,
+        0x00, 0x0c, 0x00, 0x01
+    };
+    NetworkEndPoint_t * pxIPv4;
+    NetworkEndPoint_t * pxIPv6;
+    NetworkEndPoint_t * pxOther;
+
+    pxIPv4 = prvAddEndPoint( &( xInterfaces[ 0 ] ), pdFALSE, pdTRUE, 0x0101A8C0U );
+    ( void ) prvAddEndPoint( &( xInterfaces[ 0 ] ), pdFALSE, pdTRUE, 0x0201A8C0U );
+    pxIPv6 = prvAddEndPoint( &( xInterfaces[ 0 ] ), pdTRUE, pdTRUE, 0U );
+    ( void ) prvAddEndPoint( &( xInterfaces[ 1 ] ), pdFALSE, pdTRUE, 0U );
+    ( void ) prvAddEndPoint( &( xInterfaces[ 1 ] ), pdFALSE, pdFALSE, 0x0100000AU );
+    pxOther = prvAddEndPoint( &( xInterfaces[ 1 ] ), pdFALSE, pdTRUE, 0x0200000AU );
+
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+    vMDNSHandleEvent();
+
+    TEST_ASSERT_EQUAL( 3, uxSentCount );
+    TEST_ASSERT_EQUAL_PTR( pxIPv4, xSent[ 0 ].pxEndPoint );
+    TEST_ASSERT_EQUAL( ipIPv4_FRAME_TYPE, xSent[ 0 ].usFrameType );
+    TEST_ASSERT_EQUAL( ipMDNS_IP_ADDRESS, xSent[ 0 ].ulIPv4Address );
+    TEST_ASSERT_EQUAL_PTR( pxIPv6, xSent[ 1 ].pxEndPoint );
+    TEST_ASSERT_EQUAL( ipIPv6_FRAME_TYPE, xSent[ 1 ].usFrameType );
+    TEST_ASSERT_EQUAL_PTR( pxOther, xSent[ 2 ].pxEndPoint );
+
+    /* One question, no known answers. */
+    TEST_ASSERT_EQUAL( 1, prvSentField( 0, 4 ) );
+    TEST_ASSERT_EQUAL( 0, prvSentField( 0, 6 ) );
+    TEST_ASSERT_EQUAL_MEMORY( ucQuestion, &( xSent[ 0 ].ucMessage[ sizeof( DNSMessage_t ) ] ), sizeof( ucQuestion ) );
+    TEST_ASSERT_EQUAL_MEMORY( xSent[ 0 ].ucMessage, xSent[ 1 ].ucMessage, TEST_MESSAGE_SIZE );
+}
+
+/*
+ * @brief The interval between the queries starts at one second and doubles.
+ */
+void test_vMDNSCheck_Backoff( void )
+{
+    ( void ) prvAddEndPoint( &( xInterfaces[ 0 ] ), pdFALSE, pdTRUE, 0x0101A8C0U );
+
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+    vMDNSHandleEvent();
+    TEST_ASSERT_EQUAL( 1, uxSentCount );
+
+    xTestTime += configTICK_RATE_HZ - 1U;
+    vMDNSCheck();
+    TEST_ASSERT_EQUAL( 1, uxSentCount );
+
+    xTestTime += 1U;
+    vMDNSCheck();
+    TEST_ASSERT_EQUAL( 2, uxSentCount );
+
+    xTestTime += configTICK_RATE_HZ;
+    vMDNSCheck();
+    TEST_ASSERT_EQUAL( 2, uxSentCount );
+
+    xTestTime += configTICK_RATE_HZ;
+    vMDNSCheck();
+    TEST_ASSERT_EQUAL( 3, uxSentCount );
+}
+
+/*
+ * @brief The answer to a question is stored, together with the address of the
+ *        host it points to, and can be read with the remaining TTL.
+ */
+void test_xMDNSProcessPacket_StoresAnswers( void )
+{
+    MDNSRecord_t xRecords[ 2 ];
+    size_t uxCriticalBefore;
+
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+    TEST_ASSERT_EQUAL( pdFALSE, prvReceive( ucResponse, sizeof( ucResponse ) ) );
+    TEST_ASSERT_EQUAL( 0, uxCriticalNesting );
+
+    xTestTime += 20U * configTICK_RATE_HZ;
+    uxCriticalBefore = uxCriticalSections;
+
+    TEST_ASSERT_EQUAL( 1, FreeRTOS_mDNSLookup( "_IPP._tcp.local", dnsTYPE_PTR, xRecords, 2 ) );
+    TEST_ASSERT_EQUAL_STRING( "printer._ipp._tcp.local", xRecords[ 0 ].pcTarget );
+    TEST_ASSERT_EQUAL( 100, xRecords[ 0 ].ulTTL );
+
+    /* Every cache entry was read in a critical section. */
+    TEST_ASSERT_EQUAL( uxCriticalBefore + ipconfigMDNS_CACHE_ENTRIES, uxCriticalSections );
+    TEST_ASSERT_EQUAL( 0, uxCriticalNesting );
+
+    TEST_ASSERT_EQUAL( 1, FreeRTOS_mDNSLookup( "printer._ipp._tcp.local", dnsTYPE_A_HOST, xRecords, 2 ) );
+    TEST_ASSERT_EQUAL( FreeRTOS_inet_addr_quick( 192, 168, 1, 20 ), xRecords[ 0 ].xAddress.xIPAddress.ulIP_IPv4 );
+}
+
+/*
+ * @brief Records that no question asks for are not stored.
+ */
+void test_xMDNSProcessPacket_NotWanted( void )
+{
+    MDNSRecord_t xRecord;
+
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_OTHER_NAME, dnsTYPE_PTR ) );
+    ( void ) prvReceive( ucResponse, sizeof( ucResponse ) );
+
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_mDNSLookup( TEST_SERVICE_NAME, dnsTYPE_PTR, &( xRecord ), 1 ) );
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_mDNSLookup( "printer._ipp._tcp.local", dnsTYPE_A_HOST, &( xRecord ), 1 ) );
+}
+
+/*
+ * @brief A cached record can no longer be read when its TTL has passed.
+ */
+void test_FreeRTOS_mDNSLookup_Expires( void )
+{
+    MDNSRecord_t xRecord;
+
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+    ( void ) prvReceive( ucResponse, sizeof( ucResponse ) );
+
+    xTestTime += 119U * configTICK_RATE_HZ;
+    TEST_ASSERT_EQUAL( 1, FreeRTOS_mDNSLookup( TEST_SERVICE_NAME, dnsTYPE_PTR, &( xRecord ), 1 ) );
+    TEST_ASSERT_EQUAL( 1, xRecord.ulTTL );
+
+    xTestTime += configTICK_RATE_HZ;
+    TEST_ASSERT_EQUAL( 0, FreeRTOS_mDNSLookup( TEST_SERVICE_NAME, dnsTYPE_PTR, &( xRecord ), 1 ) );
+}
+
+/*
+ * @brief A query lists the answers that are already known, as long as more
+ *        than half of their TTL is left.
+ */
+void test_vMDNSCheck_KnownAnswers( void )
+{
+    ( void ) prvAddEndPoint( &( xInterfaces[ 0 ] ), pdFALSE, pdTRUE, 0x0101A8C0U );
+
+    TEST_ASSERT_EQUAL( pdPASS, FreeRTOS_mDNSQuery( TEST_SERVICE_NAME, dnsTYPE_PTR ) );
+    vMDNSHandleEvent();
+    ( void ) prvReceive( ucResponse, sizeof( ucResponse ) );
+
+    xTestTime += configTICK_RATE_HZ;
+    vMDNSCheck();
+
+    TEST_ASSERT_EQUAL( 2, uxSentCount );
+    TEST_ASSERT_EQUAL( 0, prvSentField( 0, 6 ) );
+    TEST_ASSERT_EQUAL( 1, prvSentField( 1, 6 ) );
+}
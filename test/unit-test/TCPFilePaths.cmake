@@ -13,8 +13,12 @@ set( TCP_SOURCES
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_DNS_Callback.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_DNS_Networking.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_DNS_Parser.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_DNS_Resolver.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_Happy_Eyeballs.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_ICMP.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IGMP.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IP.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IP_Checksum.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IP_Timers.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IP_Utils.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IPv4.c"
@@ -23,8 +27,11 @@ set( TCP_SOURCES
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IPv6.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IPv6_Sockets.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_IPv6_Utils.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_LRU_Hash.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_mDNS.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_ND.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_RA.c"
+     "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_Route_Table.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_Routing.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_Sockets.c"
      "${CMAKE_CURRENT_LIST_DIR}/../../source/FreeRTOS_Stream_Buffer.c"